@@ -62,6 +62,13 @@ void playSynthesizedVoiceFS3(dsd_opts* opts, dsd_state* state); // float stereo
 void playSynthesizedVoiceFS4(dsd_opts* opts, dsd_state* state); // float stereo mix 4v2 P25p2
 /** @brief Play synthesized voice (float mono). */
 void playSynthesizedVoiceFM(dsd_opts* opts, dsd_state* state); // float mono
+/**
+ * @brief Play one vocoder frame drained from a slot's lane after its call ended.
+ *
+ * The frame is staged in audio_out_temp_buf (or audio_out_temp_bufR when @p right is set), already gated by the
+ * caller and, on the short path, already gained by processAudio()/processAudioR().
+ */
+void playSynthesizedVoiceTail(dsd_opts* opts, dsd_state* state, int slot, int right);
 
 /** @brief Play synthesized voice (short mono output slot 1). */
 void playSynthesizedVoice(dsd_opts* opts, dsd_state* state); // short mono output slot 1
@@ -97,8 +104,23 @@ void analog_gain_f(const dsd_opts* opts, dsd_state* state, float* input, int len
 /** @brief Multiply float buffer by gain factor in-place. */
 void audio_apply_gain_f32(float* buf, size_t n, float gain);
 
-/** @brief Analog monitor 6x sample-repetition upsampler. */
-void upsample(dsd_state* state, float invalue);
+/** Output samples per input sample of the 8 kHz to 48 kHz voice upsampler. */
+#define DSD_UPSAMPLE_FACTOR     6
+/** Taps per polyphase branch of the voice upsampler; the history holds one fewer. */
+#define DSD_UPSAMPLE_PHASE_TAPS 16
+
+/**
+ * @brief Interpolate a block of 8 kHz voice to 48 kHz.
+ *
+ * Runs the polyphase low-pass interpolator on the SIMD FIR kernels.
+ *
+ * @param hist   Channel filter history (DSD_UPSAMPLE_PHASE_TAPS - 1 floats),
+ *               carried from block to block; zero it to start clean.
+ * @param in     `in_len` input samples.
+ * @param in_len Number of input samples.
+ * @param out    Receives `in_len * DSD_UPSAMPLE_FACTOR` samples.
+ */
+void upsample_block(float* hist, const float* in, int in_len, float* out);
 
 /**
  * @brief Rescale decoder timing/filter state between two effective PCM rates.
@@ -161,6 +183,12 @@ void audio_mix_interleave_stereo_s16(const short* left, const short* right, size
 /** @brief Mix two float channels with mute flags into mono output. */
 void audio_mix_mono_from_slots_f32(const float* left, const float* right, size_t n, int l_on, int r_on,
                                    float* mono_out);
+/** @brief Accumulate `acc[i] += in[i] * gain` (SSE2/NEON with a scalar tail). */
+void audio_mix_accumulate_f32(float* acc, const float* in, size_t n, float gain);
+/** @brief Clamp float samples to [-1.0, 1.0] in place (SSE2/NEON with a scalar tail). */
+void audio_clip_f32(float* buf, size_t n);
+/** @brief Convert float [-1.0, 1.0] samples to 16-bit (full scale 32768), saturating out-of-range values. */
+void audio_f32_to_s16(const float* in, size_t n, short* out);
 
 /** @brief Return 1 when P25p2 decode should queue audio for the slot under decrypt and media policy. */
 int dsd_p25p2_decode_audio_allowed(const dsd_opts* opts, const dsd_state* state, int slot, int alg);
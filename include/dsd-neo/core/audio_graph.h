@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief N-stream voice audio graph with a block mixer thread.
+ *
+ * Each stream carries one call (or talkgroup) as 160-sample mono float
+ * blocks. Producers queue blocks on the stream's SPSC jitter buffer and wait
+ * for the mixer when it is full; the mixer takes one block per stream every
+ * block period, applies the stream's gain, hands the result to the stream's
+ * own sink (if any) and sums every playing stream into the master mix, which
+ * goes to the master sink.
+ *
+ * A stream starts playing once its jitter buffer holds the configured
+ * number of blocks, drops back to buffering when it runs dry, and is retired
+ * after close (or after going idle) once its queued blocks have played.
+ *
+ * Streams are created, fed and closed from producer threads; all producer
+ * calls serialize on one graph lock, but each stream should be fed by a
+ * single decoder. Sinks are only ever written from the mixer, so a sink
+ * needs no locking of its own.
+ */
+
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_CORE_AUDIO_GRAPH_H_H
+#define DSD_NEO_INCLUDE_DSD_NEO_CORE_AUDIO_GRAPH_H_H
+
+#include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/core/state_fwd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Frames per block (20 ms at 8 kHz, one vocoder frame). */
+#define DSD_AUDIO_GRAPH_BLOCK 160
+/** Streams one graph can carry at once. */
+#define DSD_AUDIO_GRAPH_MAX_STREAMS 16
+/** Blocks a stream's jitter buffer holds (one P25 Phase 2 superframe plus headroom). */
+#define DSD_AUDIO_GRAPH_QUEUE_BLOCKS 32
+
+/**
+ * @brief Destination for mixed or per-stream audio.
+ *
+ * `write` receives `frames` interleaved frames of `channels` float samples in
+ * [-1.0, 1.0]. `close` (optional) releases `ctx` when the owning stream is
+ * retired or the graph is destroyed. A sink with a NULL `write` is empty.
+ */
+typedef struct dsd_audio_sink {
+    void (*write)(void* ctx, const float* samples, size_t frames, int channels);
+    void (*close)(void* ctx);
+    void* ctx;
+} dsd_audio_sink;
+
+typedef struct dsd_audio_graph dsd_audio_graph;
+
+typedef struct {
+    int channels;              /**< Master mix channels: 1 or 2. */
+    int sample_rate;           /**< Paces the mixer thread; 8000 when <= 0. */
+    int jitter_blocks;         /**< Blocks queued before a stream starts playing (1..QUEUE_BLOCKS-1). */
+    int idle_blocks;           /**< Mixer blocks without input before a stream is closed; 0 never. */
+    int threaded;              /**< Non-zero starts the mixer thread; zero leaves mixing to the caller. */
+    dsd_audio_sink master;     /**< Receives each mixed block; owned by the graph. */
+} dsd_audio_graph_config;
+
+typedef struct {
+    float gain;           /**< Linear gain applied before the stream's sink and the mix. */
+    float pan;            /**< -1 left .. 0 both channels .. +1 right; ignored for mono mixes. */
+    dsd_audio_sink sink;  /**< Optional per-stream sink (post-gain mono); owned by the stream. */
+} dsd_audio_stream_params;
+
+typedef struct {
+    uint64_t mixed_blocks; /**< Master blocks produced (only when at least one stream played). */
+    uint64_t underruns;    /**< Times a playing stream ran dry and went back to buffering. */
+    uint64_t full_waits;   /**< Submits that found a jitter buffer full and waited for the mixer. */
+    int open_streams;      /**< Streams currently allocated (open or draining). */
+} dsd_audio_graph_stats;
+
+/** @brief Unity gain, centered, no sink. */
+void dsd_audio_stream_params_default(dsd_audio_stream_params* params);
+
+/**
+ * @brief Create a graph. The master sink is owned by the graph from here on.
+ * @return Graph, or NULL on invalid configuration, allocation failure or when
+ *         the mixer thread could not be started (the master sink is closed).
+ */
+dsd_audio_graph* dsd_audio_graph_create(const dsd_audio_graph_config* cfg);
+
+/** @brief Stop the mixer, close every sink and free the graph. Queued audio is dropped. NULL is ignored. */
+void dsd_audio_graph_destroy(dsd_audio_graph* g);
+
+/**
+ * @brief Open the stream for @p key, or update gain/pan of the one already open.
+ *
+ * The sink in @p params is attached only when the stream is created; it is
+ * closed right away when the stream already exists or cannot be created.
+ * Reopening a draining stream puts it back in service with its queued audio.
+ *
+ * @return 0 on success, -1 on bad arguments or when every stream is in use.
+ */
+int dsd_audio_graph_open_stream(dsd_audio_graph* g, uint64_t key, const dsd_audio_stream_params* params);
+
+/**
+ * @brief Queue one block on the stream for @p key, opening it with default parameters if needed.
+ *
+ * When the stream's jitter buffer is full the block is not dropped: a
+ * threaded graph blocks the caller until the mixer has played a block, and a
+ * caller-mixed graph runs dsd_audio_graph_mix_block() to make room.
+ *
+ * @return 0 when queued, -1 on bad arguments, when every stream is in use or
+ *         when the graph is being destroyed.
+ */
+int dsd_audio_graph_submit(dsd_audio_graph* g, uint64_t key, const float block[DSD_AUDIO_GRAPH_BLOCK]);
+
+/** @brief Let the stream play out what it has queued, then retire it. Unknown keys are ignored. */
+void dsd_audio_graph_close_stream(dsd_audio_graph* g, uint64_t key);
+
+/**
+ * @brief Run one mixer period.
+ *
+ * Called by the mixer thread; call it directly for graphs created with
+ * `threaded = 0`, from the thread that submits, since a submit to a full
+ * jitter buffer runs it too. Never call it on a threaded graph.
+ *
+ * @return Number of streams that contributed a block.
+ */
+int dsd_audio_graph_mix_block(dsd_audio_graph* g);
+
+/** @brief Snapshot of the graph's counters. */
+void dsd_audio_graph_get_stats(dsd_audio_graph* g, dsd_audio_graph_stats* out);
+
+/**
+ * @brief Sink writing 16-bit little-endian raw PCM to @p path (truncated).
+ * @return 0 on success; -1 leaves @p out empty.
+ */
+int dsd_audio_sink_open_file(dsd_audio_sink* out, const char* path);
+
+/**
+ * @brief Sink sending each block as one datagram of 16-bit PCM to @p host:@p port.
+ * @return 0 on success; -1 leaves @p out empty.
+ */
+int dsd_audio_sink_open_udp(dsd_audio_sink* out, const char* host, int port);
+
+/**
+ * @brief Sink playing on a local output device (NULL for the default).
+ * @return 0 on success; -1 leaves @p out empty.
+ */
+int dsd_audio_sink_open_device(dsd_audio_sink* out, const char* device, int sample_rate, int channels);
+
+/**
+ * @brief Serialize writes to the decoder's configured audio output.
+ *
+ * Held around every voice write through the configured output and around
+ * closeAudioOutput()/openAudioOutput(), so the mixer thread never writes to
+ * an output that is being torn down.
+ */
+void dsd_audio_output_lock(void);
+/** @brief Release dsd_audio_output_lock(). */
+void dsd_audio_output_unlock(void);
+
+/**
+ * @brief Graph feeding the decoder's configured output.
+ *
+ * With `DSD_NEO_AUDIO_GRAPH=1` the first call attaches a threaded graph to
+ * @p state whose master sink is the configured output; the graph is rebuilt
+ * when the output channel count or sample format changes. Returns NULL when
+ * the mode is off or the graph could not be created.
+ */
+dsd_audio_graph* dsd_audio_graph_for_output(dsd_opts* opts, dsd_state* state);
+
+/** @brief Stop and detach the output graph of @p state, if any; its queued audio is dropped. */
+void dsd_audio_graph_output_stop(dsd_state* state);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_CORE_AUDIO_GRAPH_H_H */
@@ -144,6 +144,57 @@ void pack_ambe(const char* input, uint8_t* output, int len);
 /** @brief Unpack AMBE bytes back into bit form. */
 void unpack_ambe(const uint8_t* input, char* ambe);
 
+/** @brief Capacity of a dsd_bitvec: an 88-bit IMBE frame or a 49/72-bit AMBE frame with room to spare. */
+#define DSD_BITVEC_MAX_BITS 128U
+
+/**
+ * @brief Packed MSB-first bit vector for vocoder and short data payloads.
+ *
+ * Bit 0 is the most significant bit of `w[0]`, so a vector converts to and from
+ * octets in on-air order and a keystream applies as a few whole-word XORs
+ * instead of one byte per bit. Bits at and past `len` are always zero.
+ */
+typedef struct dsd_bitvec {
+    uint64_t w[DSD_BITVEC_MAX_BITS / 64U];
+    uint32_t len;
+} dsd_bitvec;
+
+/** @brief Clear @p v to @p len zero bits (clamped to DSD_BITVEC_MAX_BITS). */
+void dsd_bitvec_init(dsd_bitvec* v, uint32_t len);
+
+/** @brief Load @p len bit elements (LSB significant) into @p v. */
+void dsd_bitvec_from_bits(dsd_bitvec* v, const char* bits, uint32_t len);
+
+/** @brief Store @p v as `v->len` bit elements, each 0 or 1. */
+void dsd_bitvec_to_bits(const dsd_bitvec* v, char* bits);
+
+/** @brief Load the first @p len bits of MSB-first @p octets, reading `ceil(len / 8)` octets. */
+void dsd_bitvec_from_octets(dsd_bitvec* v, const uint8_t* octets, uint32_t len);
+
+/**
+ * @brief Store @p v as MSB-first octets, zero-padding the last one.
+ *
+ * @return Number of octets written: `ceil(v->len / 8)`, clamped to @p out_cap.
+ */
+size_t dsd_bitvec_to_octets(const dsd_bitvec* v, uint8_t* out, size_t out_cap);
+
+/** @brief Read @p width (1-64) bits starting at @p pos, MSB-first; bits past `len` read as zero. */
+uint64_t dsd_bitvec_get(const dsd_bitvec* v, uint32_t pos, uint32_t width);
+
+/** @brief Write the low @p width (1-64) bits of @p value at @p pos; bits past `len` are dropped. */
+void dsd_bitvec_set(dsd_bitvec* v, uint32_t pos, uint32_t width, uint64_t value);
+
+/** @brief XOR the first `v->len` bits of @p ks into @p v. */
+void dsd_bitvec_xor(dsd_bitvec* v, const dsd_bitvec* ks);
+
+/**
+ * @brief XOR an MSB-first octet keystream into @p v, starting @p bit_offset bits into it.
+ *
+ * Keystream bits at or past `ks_bytes * 8` count as zero, so a stale or
+ * runaway offset never reads outside the keystream buffer.
+ */
+void dsd_bitvec_xor_octets(dsd_bitvec* v, const uint8_t* ks, size_t ks_bytes, size_t bit_offset);
+
 #ifdef DSD_NEO_TEST_HOOKS
 /**
  * @brief Count of conversions that returned fewer octets than requested.
@@ -43,6 +43,8 @@ extern "C" {
 int get_dibit_and_analog_signal(dsd_opts* opts, dsd_state* state, int* out_analog_signal);
 int getDibitSoft(dsd_opts* opts, dsd_state* state, dsd_dibit_soft_t* out_soft);
 int getDibitAndSoftSymbol(dsd_opts* opts, dsd_state* state, float* out_soft_symbol);
+/* Read `count` dibits (and, when `soft` is non-NULL, their soft metrics) in one symbol block; returns `count`. */
+int getDibitSoftBlock(dsd_opts* opts, dsd_state* state, int* dibits, dsd_dibit_soft_t* soft, int count);
 void write_symbol_capture_record(dsd_opts* opts, dsd_state* state, int dibit, float symbol,
                                  const dsd_dibit_soft_t* soft);
 uint8_t dmr_compute_reliability(const dsd_state* st, float sym);
@@ -59,8 +59,16 @@ SNDFILE* close_and_rename_wav_file(SNDFILE* wav_file, const dsd_opts* opts, cons
  */
 SNDFILE* close_and_rename_wav_file_ex(SNDFILE* wav_file, const dsd_opts* opts, const char* wav_out_filename,
                                       const char* dir, const Event_History_I* event_struct, int export_call);
+/**
+ * Finalize a per-call recording that has already been closed: remove it when it holds no audio,
+ * otherwise rename it from `event_item` (may be NULL) and, with `export_call`, export it to rdio-scanner.
+ * This is the part of close_and_rename_wav_file_ex() that runs on the WAV writer thread.
+ */
+void dsd_wav_finalize_closed_file(const dsd_opts* opts, const char* wav_out_filename, const char* dir,
+                                  const Event_History* event_item, int export_call);
 void closeMbeOutFile(dsd_opts* opts, dsd_state* state);
 void closeMbeOutFileR(dsd_opts* opts, dsd_state* state);
+void closeWavOutFileRaw(dsd_opts* opts, dsd_state* state);
 void closeSymbolOutFile(dsd_opts* opts, dsd_state* state);
 void rotate_symbol_out_file(dsd_opts* opts, dsd_state* state);
 
@@ -450,6 +450,9 @@ struct dsd_state {
     float* audio_out_temp_buf_p;
     float audio_out_temp_bufR[160];
     float* audio_out_temp_buf_pR;
+    // 48 kHz upsampler filter history per channel (DSD_UPSAMPLE_PHASE_TAPS - 1)
+    float audio_upsample_hist[15];
+    float audio_upsample_histR[15];
     //analog/raw signal audio buffers (float path for better SNR, convert to int16 at output)
     float analog_out_f[960]; // float buffer for analog monitor path
     short analog_out[960];   // int16 buffer for analog monitor output
@@ -507,8 +510,10 @@ struct dsd_state {
     unsigned int symbol_replay_soft_records;
     unsigned int symbol_capture_soft_records;
 
-    /* RTL DSP direct-output cache. The RTL demod thread produces direct FSK/CQPSK
-       blocks; this lets getSymbol() consume them without one ring read per sample. */
+    /* RTL output span cache. getSymbol() pulls a span of whatever the demod
+       thread produces (audio, FSK discriminator or CQPSK symbols) and serves it
+       from the cursor, so the ring is read once per span rather than per sample.
+       dsd_rtl_stream_io_hook_read_block() drains it ahead of the stream. */
     float rtl_symbol_cache[DSD_RTL_SYMBOL_CACHE_CAP];
     int rtl_symbol_cache_pos;
     int rtl_symbol_cache_len;
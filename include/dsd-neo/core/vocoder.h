@@ -53,6 +53,12 @@ void playMbeFiles(dsd_opts* opts, dsd_state* state, int argc, char** argv);
 /** Purge queued/working audio and vocoder history for one logical voice slot. */
 void dsd_mbe_purge_slot_audio(dsd_state* state, int slot);
 
+/**
+ * Play and record the frames still queued on a slot's vocoder lane (DSD_NEO_VOCODER_THREAD) once its call has
+ * ended, so they land in that call's audio and WAV rather than the next call's.
+ */
+void dsd_mbe_drain_slot_audio(dsd_opts* opts, dsd_state* state, int slot);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Per-slot AMBE synthesis threads fed through SPSC frame queues.
+ *
+ * With `DSD_NEO_VOCODER_THREAD=1` the decoder thread keeps FEC, decryption
+ * and every audio gating decision, but hands the decoded AMBE 2450 and IMBE
+ * 4400 frames to one synthesis lane per slot. Each lane owns its mbelib
+ * parameter history and a thread that turns queued frames into 160-sample PCM
+ * blocks, so the two slots synthesize in parallel and off the symbol-timing
+ * path.
+ *
+ * dsd_vocoder_worker_exchange() posts frame N and returns frame
+ * N - DSD_VOCODER_WORKER_LAG of the same lane. DMR and P25 Phase 2 decode a
+ * burst's three or four frames back to back, so a one-frame lag would make
+ * each post wait for the frame posted just before it; with a burst of lag
+ * every frame the decoder collects was posted a burst earlier and the lane
+ * has had a whole burst period to synthesize it. Audio lags by that many
+ * vocoder frames (80 ms). The decoder's per-frame metadata travels with the
+ * frame, so the audio that comes back is reported and gated by the decisions
+ * made for it.
+ */
+
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_CORE_VOCODER_WORKER_H_H
+#define DSD_NEO_INCLUDE_DSD_NEO_CORE_VOCODER_WORKER_H_H
+
+#include <dsd-neo/core/state_fwd.h>
+#include <mbelib-neo/mbelib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Synthesis lanes: one per TDMA slot. */
+#define DSD_VOCODER_WORKER_LANES 2
+
+/** Frames a lane holds back: the most voice frames one burst carries (P25 Phase 2 4V). */
+#define DSD_VOCODER_WORKER_LAG 4
+
+/** Frame kinds a lane synthesizes. */
+typedef enum {
+    DSD_VOCODER_FRAME_ERASURE = 0, /**< undecodable frame; yields silence in its place */
+    DSD_VOCODER_FRAME_AMBE2450 = 1,
+    DSD_VOCODER_FRAME_IMBE4400 = 2,
+} dsd_vocoder_frame_kind;
+
+/**
+ * One frame's bits and the decoder-side facts about it. The lane hands the
+ * struct back untouched with the frame's audio.
+ */
+typedef struct {
+    int kind;                 /**< dsd_vocoder_frame_kind */
+    char bits[88];            /**< 49 AMBE or 88 IMBE bits, decoded and decrypted */
+    int decode_errors;        /**< FEC corrections counted when the frame was decoded */
+    unsigned int post_flags;  /**< caller's audio, recording and file-save decisions */
+} dsd_vocoder_frame_meta;
+
+typedef struct dsd_vocoder_worker dsd_vocoder_worker;
+
+/**
+ * @brief Create a worker with one synthesis lane per slot.
+ *
+ * @param threaded Non-zero to start a thread per lane; zero synthesizes
+ *                 inline on the posting thread with the same lag.
+ * @return Worker, or NULL on allocation failure or when a lane thread could
+ *         not be started.
+ */
+dsd_vocoder_worker* dsd_vocoder_worker_create(int threaded);
+
+/** @brief Stop the lane threads and free the worker. NULL is ignored. */
+void dsd_vocoder_worker_destroy(dsd_vocoder_worker* w);
+
+/**
+ * @brief Queue one frame on a lane and collect the frame queued
+ *        DSD_VOCODER_WORKER_LAG frames earlier.
+ *
+ * Each frame comes back with its own metadata, so a later call never applies
+ * its decisions to an earlier call's audio. A call's last frames are collected
+ * with dsd_vocoder_worker_collect() when the call ends.
+ *
+ * @param w       Worker.
+ * @param lane    Lane index (0 or 1).
+ * @param meta    In: the frame to queue; an erasure keeps its place in the
+ *                lane. Out: the returned frame's metadata. While the lane
+ *                holds fewer than DSD_VOCODER_WORKER_LAG earlier frames, it
+ *                comes back as an empty erasure that keeps only the caller's
+ *                post_flags.
+ * @param result  In: the decode result for the frame. Out: the synthesis
+ *                result of the returned frame.
+ * @param aout    Receives the returned frame's 160 samples.
+ * @return The returned frame's mbelib status; MBE_STATUS_INVALID_BITS with
+ *         silence for an erasure or while the lane is still filling.
+ */
+int dsd_vocoder_worker_exchange(dsd_vocoder_worker* w, int lane, dsd_vocoder_frame_meta* meta,
+                                mbe_process_result* result, float aout[160]);
+
+/** @brief Frames posted on a lane and not yet collected. */
+int dsd_vocoder_worker_pending(const dsd_vocoder_worker* w, int lane);
+
+/**
+ * @brief Collect a lane's oldest queued frame without posting one.
+ *
+ * Drains a call's last frames once the call has ended, so they play and
+ * record with that call instead of waiting for the next frame on the lane.
+ *
+ * @return The frame's mbelib status, as from dsd_vocoder_worker_exchange();
+ *         MBE_STATUS_INVALID_ARGUMENT when the lane holds no frame.
+ */
+int dsd_vocoder_worker_collect(dsd_vocoder_worker* w, int lane, dsd_vocoder_frame_meta* meta,
+                               mbe_process_result* result, float aout[160]);
+
+/** @brief Discard the frames queued on a lane; its parameter history is kept. */
+void dsd_vocoder_worker_flush_lane(dsd_vocoder_worker* w, int lane);
+
+/** @brief Discard the frames queued on a lane and restart its parameter history. */
+void dsd_vocoder_worker_reset_lane(dsd_vocoder_worker* w, int lane);
+
+/**
+ * @brief Worker attached to @p state.
+ *
+ * Attaches a threaded worker on first use when `DSD_NEO_VOCODER_THREAD` is
+ * enabled; returns NULL when the mode is off.
+ */
+dsd_vocoder_worker* dsd_vocoder_worker_for_state(dsd_state* state);
+
+/** @brief Worker already attached to @p state, or NULL; never creates one. */
+dsd_vocoder_worker* dsd_vocoder_worker_peek(const dsd_state* state);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_CORE_VOCODER_WORKER_H_H */
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Background writer for per-call WAV recordings.
+ *
+ * With `DSD_NEO_WAV_ASYNC=1` the decoder thread no longer touches the disk
+ * for per-call recordings. Sample writes are copied into batches on a bounded
+ * job queue and a single writer thread issues one sf_write_short() per batch.
+ * Closing a recording queues a finalize job behind its samples: the writer
+ * closes the file, drops it when it holds no audio, renames it from its event
+ * metadata and hands it to the rdio-scanner export.
+ *
+ * The raw audio capture (`opts->wav_out_raw`) stays out of this mode: it is
+ * written, synced and closed on the decoder thread.
+ *
+ * Jobs run in queue order, so every handle sees its writes before its close.
+ * When the queue is full, sample writes are dropped and counted; finalize
+ * jobs wait for room instead (backpressure), so a recording is never leaked.
+ */
+
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_CORE_WAV_WRITER_H_H
+#define DSD_NEO_INCLUDE_DSD_NEO_CORE_WAV_WRITER_H_H
+
+#include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/platform/sndfile_fwd.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Samples one write job holds; a batch is handed to the writer once full. */
+#define DSD_WAV_WRITER_BATCH_SAMPLES 4096
+/** Jobs the queue holds before sample writes are dropped. */
+#define DSD_WAV_WRITER_QUEUE_MAX 64U
+
+typedef struct {
+    uint64_t queued_samples;     /**< Samples accepted onto the queue. */
+    uint64_t written_samples;    /**< Samples sf_write_short() reported as written. */
+    uint64_t dropped_samples;    /**< Samples dropped because the queue was full. */
+    uint64_t batches;            /**< sf_write_short() calls made by the writer. */
+    uint64_t finalized;          /**< Recordings closed by the writer. */
+    uint64_t backpressure_waits; /**< Finalize requests that had to wait for queue room. */
+    size_t depth;                /**< Jobs currently queued. */
+} dsd_wav_writer_stats;
+
+/** @brief Non-zero when `DSD_NEO_WAV_ASYNC` routes per-call recordings through the writer. */
+int dsd_wav_writer_active(void);
+
+/**
+ * @brief Queue @p count samples for @p file, starting the writer if needed.
+ *
+ * Samples are appended to the file's open batch when it is the last job on
+ * the queue. @p context is a string literal naming the caller for short-write
+ * warnings.
+ *
+ * @return 0 when queued, 1 when dropped because the queue was full, -1 when the
+ *         writer could not be started (nothing was queued; write inline).
+ */
+int dsd_wav_writer_write(SNDFILE* file, const short* samples, int64_t count, const char* context);
+
+/**
+ * @brief Queue the close of @p file behind its pending writes.
+ *
+ * When @p temp_path is non-empty the writer then finalizes the recording as
+ * close_and_rename_wav_file_ex() does, using a copy of @p event (may be NULL)
+ * and, when @p export_call is set, a copy of the rdio settings in @p opts.
+ * Waits for queue room when the queue is full.
+ *
+ * @return 0 when queued, -1 when the writer could not be started or the job
+ *         could not be allocated (nothing was queued; close inline).
+ */
+int dsd_wav_writer_finalize(SNDFILE* file, const dsd_opts* opts, const char* temp_path, const char* dir,
+                            const Event_History* event, int export_call);
+
+/** @brief Wait until every queued job, including partial batches, has run. No-op when the writer is stopped. */
+void dsd_wav_writer_drain(void);
+
+/** @brief Snapshot of the writer's counters since it was last started. */
+void dsd_wav_writer_get_stats(dsd_wav_writer_stats* out);
+
+/**
+ * @brief Run every queued job and stop the writer thread.
+ *
+ * Call after the final recordings have been closed and before the rdio upload
+ * worker is shut down. Safe to call when the writer was never started.
+ */
+void dsd_wav_writer_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_CORE_WAV_WRITER_H_H */
@@ -27,6 +27,61 @@ typedef enum {
     DSD_AES_KEY_256 = 256,
 } dsd_aes_key_size;
 
+/** @brief Round-key blocks of the largest (AES-256) schedule. */
+#define DSD_AES_MAX_ROUND_KEYS 15
+
+/**
+ * @brief Expanded AES key.
+ *
+ * Holds the encryption schedule and the equivalent inverse-cipher schedule
+ * used by the AES-NI/ARMv8 decrypt paths, so a key is expanded once and then
+ * reused for every keystream or block operation under it.
+ */
+typedef struct dsd_aes_key_ctx {
+    uint8_t round_keys[DSD_AES_MAX_ROUND_KEYS][16];     /**< Encryption schedule, FIPS-197 byte order. */
+    uint8_t dec_round_keys[DSD_AES_MAX_ROUND_KEYS][16]; /**< Equivalent inverse-cipher schedule. */
+    int rounds;                                         /**< 10, 12 or 14; 0 when no key is loaded. */
+} dsd_aes_key_ctx;
+
+/** @brief Expand @p key into @p ctx. Returns 0, or -1 (ctx cleared) on a bad size or NULL argument. */
+int dsd_aes_key_ctx_init(dsd_aes_key_ctx* ctx, const uint8_t* key, dsd_aes_key_size key_size);
+
+/** @brief Wipe the schedule held by @p ctx. */
+void dsd_aes_key_ctx_clear(dsd_aes_key_ctx* ctx);
+
+/**
+ * @brief Expanded schedule for @p key from the calling thread's key cache.
+ *
+ * The cache is keyed by key size and key bytes, so every key ID the keyring
+ * activates is expanded once per thread and stays cached while it is in use;
+ * the least recently used of the cached schedules is replaced on a miss.
+ * The pointer is valid until the calling thread's next lookup or
+ * dsd_aes_key_cache_flush().
+ *
+ * @return Schedule, or NULL on a bad size or NULL key.
+ */
+const dsd_aes_key_ctx* dsd_aes_key_ctx_cached(const uint8_t* key, dsd_aes_key_size key_size);
+
+/**
+ * @brief Drop every cached schedule and key copy after key material changed.
+ *
+ * The calling thread's cache is wiped now; every other thread wipes its own
+ * cache on its next lookup. Evicted entries are wiped as they are replaced.
+ */
+void dsd_aes_key_cache_flush(void);
+
+/** @brief Generate @p nblocks AES OFB keystream blocks under an expanded key. */
+void dsd_aes_ctx_ofb_keystream(const dsd_aes_key_ctx* ctx, const uint8_t* iv, uint8_t* output, int nblocks);
+
+/** @brief XOR @p len bytes of AES CTR keystream (128-bit big-endian counter) into @p data. */
+void dsd_aes_ctx_ctr_xcrypt(const dsd_aes_key_ctx* ctx, const uint8_t* counter, uint8_t* data, size_t len);
+
+/** @brief Decrypt whole AES ECB blocks under an expanded key. Supports in-place buffers. */
+void dsd_aes_ctx_ecb_decrypt(const dsd_aes_key_ctx* ctx, const uint8_t* input, uint8_t* output, int nblocks);
+
+/** @brief Name of the AES implementation in use: "aesni", "armv8-ce" or "portable". */
+const char* dsd_aes_backend_name(void);
+
 /** @brief Generate AES OFB keystream blocks for the given IV/key. */
 void aes_ofb_keystream_output(const uint8_t* iv, const uint8_t* key, uint8_t* output, dsd_aes_key_size key_size,
                               int nblocks);
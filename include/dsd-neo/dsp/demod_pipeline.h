@@ -105,6 +105,37 @@ float mean_power(const float* samples, int len, int step);
  */
 void full_demod(struct demod_state* d);
 
+/**
+ * Overlap the front half of full_demod() (half-band cascade, channel LPF)
+ * with the back half (carrier/timing recovery, discrimination, audio) on the
+ * shared DSP pool.
+ *
+ * While enabled, each full_demod() call decimates the block it is given on a
+ * pool worker and, concurrently, finishes the previous block on the caller,
+ * so `result` lags the input by one block. The first call after enabling or
+ * flushing produces no output. Each half keeps its loop state sequential;
+ * the input block is fully consumed before full_demod() returns.
+ *
+ * @param d Demodulator state.
+ * @return 0 on success, -1 when the pool is not running or allocation fails.
+ */
+int demod_pipeline_enable(struct demod_state* d);
+
+/**
+ * Drop the block staged between the two halves (retune, mode reset).
+ *
+ * @param d Demodulator state; no-op when pipelining is off.
+ */
+void demod_pipeline_flush(struct demod_state* d);
+
+/**
+ * Return to single-threaded full_demod() and free the stage buffers.
+ * Call only while no thread is processing blocks.
+ *
+ * @param d Demodulator state; no-op when pipelining is off.
+ */
+void demod_pipeline_disable(struct demod_state* d);
+
 /**
  * Channel edge (Hz) that the channel low-pass protects for a profile.
  *
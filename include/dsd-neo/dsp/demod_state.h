@@ -29,6 +29,10 @@
 #define MAXIMUM_OVERSAMPLE 16
 #define MAXIMUM_BUF_LENGTH (MAXIMUM_OVERSAMPLE * DEFAULT_BUF_LENGTH)
 
+/* Work-buffer length used until the stream knows its transfer size: two
+ * default USB transfers of interleaved I/Q. */
+#define DEMOD_DEFAULT_WORK_LENGTH (2 * DEFAULT_BUF_LENGTH)
+
 /* Maximum half-band tap count used to dimension complex-decimator histories. */
 #define HB_TAPS_MAX        31
 
@@ -69,22 +73,26 @@ struct demod_state {
     demod_state() noexcept { DSD_MEMSET(this, 0, sizeof(*this)); }
 #endif
 
-    /* Large aligned buffers first to minimize padding */
-    alignas(64) float hb_i_buf[MAXIMUM_BUF_LENGTH / 2];
-    alignas(64) float hb_q_buf[MAXIMUM_BUF_LENGTH / 2];
-    alignas(64) float hb_i_out[MAXIMUM_BUF_LENGTH / 2];
-    alignas(64) float hb_q_out[MAXIMUM_BUF_LENGTH / 2];
-    alignas(64) float input_cb_buf[MAXIMUM_BUF_LENGTH];
-    alignas(64) float result[MAXIMUM_BUF_LENGTH];
-    alignas(64) float timing_buf[MAXIMUM_BUF_LENGTH];
-    alignas(64) float resamp_outbuf[MAXIMUM_BUF_LENGTH * 4];
+    /* Aligned filter state first to minimize padding */
     alignas(64) float channel_lpf_hist_i[144]; /* sized for up to 144-tap symmetric FIR (tap-1) */
     alignas(64) float channel_lpf_hist_q[144];
     alignas(64) float channel_lpf_plan_taps[144];
 
+    /* Per-block work buffers, carved from one arena by demod_buffers_reserve().
+     * Each holds work_len floats; resamp_outbuf holds resamp_out_len. */
+    float* input_cb_buf;
+    float* result;
+    float* timing_buf;
+    float* hb_workbuf;
+    float* work_arena;
+    float* resamp_outbuf; /* NULL while the resampler is disabled */
+    int work_len;         /* block capacity in floats (interleaved I/Q on input) */
+    int resamp_out_len;
+
     /* Pointers and 64-bit items next */
     dsd_thread_t thread;
     float* lowpassed;
+    struct demod_stage_pipe* stage_pipe; /* non-NULL while demod_pipeline_enable() is in effect */
     double squelch_running_power;
     float* resamp_taps; /* normalized taps as L contiguous phase blocks, length = K*L */
     float* resamp_hist; /* mirrored history window, length = 2*K */
@@ -133,6 +141,7 @@ struct demod_state {
     float squelch_env_attack;  /* attack alpha [0,1] for opening */
     float squelch_env_release; /* release alpha [0,1] for closing */
     int downsample_passes;
+    int ingest_hb_passes; /* leading half-band stages already run by the capture thread (0 or 1) */
     int custom_atan;
     int deemph;
     float deemph_a; /* deemphasis alpha [0.0, 1.0] for one-pole IIR */
@@ -146,7 +155,6 @@ struct demod_state {
     int dc_block;
     float dc_avg;
     /* Half-band decimator */
-    float hb_workbuf[MAXIMUM_BUF_LENGTH];
     float hb_hist_i[10][HB_TAPS_MAX - 1];
     float hb_hist_q[10][HB_TAPS_MAX - 1];
 
@@ -259,4 +267,35 @@ struct demod_state {
 
 // NOLINTEND(clang-analyzer-optin.performance.Padding)
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size the per-block work buffers for blocks of up to @p block_len floats.
+ *
+ * Allocates the input/result/timing/half-band buffers from one aligned arena
+ * and, when the resampler is enabled, a resampler output buffer sized for its
+ * current L/M ratio. Calling again with a different length or after a
+ * resampler ratio change re-sizes; otherwise it is a no-op. Buffer contents
+ * are not preserved, and `lowpassed` is re-pointed if it referenced the old
+ * input buffer. Call only while no thread is processing blocks.
+ *
+ * @param s         Demodulator state.
+ * @param block_len Largest input block in floats (clamped to MAXIMUM_BUF_LENGTH).
+ * @return 0 on success, -1 on invalid arguments or allocation failure (state unchanged).
+ */
+int demod_buffers_reserve(struct demod_state* s, int block_len);
+
+/**
+ * @brief Free the work buffers allocated by demod_buffers_reserve().
+ *
+ * Safe on states that never reserved buffers.
+ */
+void demod_buffers_release(struct demod_state* s);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* DSD_NEO_INCLUDE_DSD_NEO_DSP_DEMOD_STATE_H_ */
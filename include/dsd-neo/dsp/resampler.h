@@ -110,6 +110,18 @@ void resamp_design(struct demod_state* s, int L, int M);
  */
 int resamp_process_block(struct demod_state* s, const float* in, int in_len, float* out);
 
+/**
+ * @brief Largest output resamp_process_block() can produce for @p in_len inputs.
+ *
+ * Uses the demodulator's current L/M ratio; at least @p in_len so a
+ * pass-through fallback also fits.
+ *
+ * @param s      Demodulator state containing resampler state.
+ * @param in_len Number of input samples.
+ * @return Output buffer length in samples, or -1 on invalid arguments.
+ */
+int resamp_output_capacity(const struct demod_state* s, int in_len);
+
 #ifdef __cplusplus
 }
 #endif
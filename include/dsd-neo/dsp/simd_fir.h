@@ -11,6 +11,7 @@
  * - Complex half-band decimator (exploits zero-tap sparsity + symmetry)
  * - Complex general symmetric FIR (exploits symmetry only)
  * - Real half-band decimator (exploits zero-tap sparsity + symmetry)
+ * - Real polyphase interpolator (one output per phase per input sample)
  *
  * Runtime dispatch automatically selects the best available implementation:
  * - x86-64: AVX2+FMA > SSE2 > scalar
@@ -70,6 +71,24 @@ int simd_hb_decim2_complex(const float* in, int in_len, float* out, float* hist_
  */
 int simd_hb_decim2_real(const float* in, int in_len, float* out, float* hist, const float* taps, int taps_len);
 
+/**
+ * Real polyphase interpolator by `phases`.
+ * Each input sample yields `phases` outputs; output `n * phases + p` is the
+ * dot product of phase `p`'s taps with the `phase_len` most recent inputs.
+ *
+ * @param in         Real input samples.
+ * @param in_len     Number of input samples.
+ * @param out        Interpolated output (in_len * phases samples).
+ * @param hist       History buffer (phase_len - 1 elements).
+ * @param phase_taps Polyphase taps, `phases` rows of `phase_len`. Within a row,
+ *                   tap j weights input n - (phase_len - 1) + j (oldest first).
+ * @param phases     Interpolation factor (>= 1).
+ * @param phase_len  Taps per phase (>= 1).
+ * @return Number of output samples (in_len * phases), or 0 on invalid arguments.
+ */
+int simd_fir_interp_real(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                         int phase_len);
+
 /**
  * Query the active SIMD implementation name for debugging.
  * @return "scalar", "sse2", "avx2", or "neon".
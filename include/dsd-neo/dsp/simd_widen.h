@@ -5,11 +5,13 @@
 
 /**
  * @file
- * @brief u8 IQ widening and optional 90° IQ rotation API.
+ * @brief u8/s16 IQ widening and optional 90° IQ rotation API.
  *
  * Exposes wrappers that convert RTL-SDR unsigned 8-bit I/Q samples to
- * normalized float baseband in [-1.0, 1.0] with optional 90° rotation.
- * The current implementation is scalar.
+ * normalized float baseband in [-1.0, 1.0] with optional 90° rotation, and a
+ * fused variant that also runs the first half-band decimation stage. Signed
+ * 16-bit I/Q (CS16) has a plain widen as well.
+ * SSE2/AVX2/NEON kernels are selected at runtime with a scalar fallback.
  */
 #ifndef DSD_NEO_SIMD_WIDEN_H
 #define DSD_NEO_SIMD_WIDEN_H
@@ -51,6 +53,15 @@ typedef void (*dsd_neo_widen_rot_fn)(const unsigned char*, float*, uint32_t);
  */
 void widen_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len);
 
+/**
+ * @brief Widen signed 16-bit samples to float scaled by 1/32768.
+ *
+ * @param src Source buffer of int16 samples (I/Q interleaved).
+ * @param dst Destination float buffer.
+ * @param len Number of int16 samples in src to process.
+ */
+void widen_s16_to_f32(const int16_t* src, float* dst, uint32_t len);
+
 /**
  * @brief Widen CU8 bytes and accumulate their exact raw integer moments.
  *
@@ -89,6 +100,58 @@ uint32_t widen_rotate90_u8_to_f32_bias127_phase(const unsigned char* src, float*
 uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments(const unsigned char* src, float* dst, uint32_t len,
                                                         uint32_t phase, dsd_input_level_cu8_moments* moments);
 
+/** Input pairs the fused half-band decimator keeps between calls (31-tap window). */
+#define DSD_NEO_WIDEN_HB_HIST_PAIRS 30
+
+/**
+ * @brief Streaming state for widen_hb_decim2_u8_to_f32_bias127().
+ *
+ * Reset with widen_hb_decim2_state_reset() before the first call and after
+ * any discontinuity in the byte stream (retune purge, ring discard).
+ */
+typedef struct dsd_neo_widen_hb_state {
+    float hist[2 * DSD_NEO_WIDEN_HB_HIST_PAIRS]; /* last widened pairs, interleaved I/Q */
+    uint32_t next_window;                        /* first pair of the next output window */
+} dsd_neo_widen_hb_state;
+
+/** @brief Zero the history; the first output is centered on the first input pair. */
+void widen_hb_decim2_state_reset(dsd_neo_widen_hb_state* st);
+
+/**
+ * @brief Output pairs the next call produces for @p in_pairs input pairs.
+ *
+ * Independent of how the input is split across calls.
+ */
+uint32_t widen_hb_decim2_out_pairs(const dsd_neo_widen_hb_state* st, uint32_t in_pairs);
+
+/** @brief Fewest input pairs that produce exactly @p out_pairs output pairs. */
+uint32_t widen_hb_decim2_in_pairs(const dsd_neo_widen_hb_state* st, uint32_t out_pairs);
+
+/**
+ * @brief Widen CU8, optionally rotate by fs/4, and decimate by 2 with the
+ * 31-tap half-band (hb31_q15_taps) in one pass.
+ *
+ * Bytes are widened in L1-sized tiles and filtered straight out of the tile,
+ * so the full-rate float stream is never written to memory. Unlike
+ * simd_hb_decim2_complex(), which clamps its look-ahead at each block edge,
+ * this filter waits for the full window: output is delayed by 15 input pairs
+ * and is identical however the input is chunked.
+ *
+ * @param src       Source bytes (I/Q interleaved); `floor(len/2)` pairs are used.
+ * @param dst       Destination for widen_hb_decim2_out_pairs() interleaved pairs.
+ * @param len       Number of bytes in @p src.
+ * @param phase     Starting fs/4 rotation phase in [0, 3] when @p rotate is set.
+ * @param rotate    Non-zero to apply the `j^n` rotation before filtering.
+ * @param st        Streaming state.
+ * @param moments   Optional CU8 moment accumulator (same semantics as the
+ *                  `_moments` widen variants); may be NULL.
+ * @param out_pairs Optional; receives the number of output pairs written.
+ * @return Next rotation phase (unchanged when @p rotate is zero).
+ */
+uint32_t widen_hb_decim2_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len, uint32_t phase,
+                                           int rotate, dsd_neo_widen_hb_state* st,
+                                           dsd_input_level_cu8_moments* moments, uint32_t* out_pairs);
+
 #ifdef __cplusplus
 }
 #endif
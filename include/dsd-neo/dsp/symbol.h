@@ -22,6 +22,35 @@ extern "C" {
 
 float getSymbol(dsd_opts* opts, dsd_state* state, int have_sync);
 
+/**
+ * @brief Per-symbol callback for getSymbolBlock().
+ *
+ * Runs after each symbol is produced and before the next one is sliced, so
+ * slicer state it updates (min/max/center) is seen by the following symbol
+ * exactly as with back-to-back getSymbol() calls.
+ */
+typedef void (*dsd_symbol_sink_fn)(dsd_opts* opts, dsd_state* state, float symbol, void* user);
+
+/**
+ * @brief Produce `count` symbols in one call.
+ *
+ * Equivalent to `count` getSymbol() calls with the same `have_sync`, with the
+ * per-call setup (runtime config lookups, matched-filter selection) done once
+ * per block and timing state carried from symbol to symbol. Each symbol is
+ * stored to `out[k]` when `out` is non-NULL and passed to `sink` when it is
+ * non-NULL. A stopped input yields 0.0f symbols, as getSymbol() does.
+ *
+ * @param opts Decoder options.
+ * @param state Decoder state.
+ * @param have_sync Non-zero while a frame is being decoded.
+ * @param out Optional output array of at least `count` floats.
+ * @param count Number of symbols to produce.
+ * @param sink Optional per-symbol callback.
+ * @param user Opaque pointer passed to `sink`.
+ */
+void getSymbolBlock(dsd_opts* opts, dsd_state* state, int have_sync, float* out, int count, dsd_symbol_sink_fn sink,
+                    void* user);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,8 @@
 #ifndef BCH_63_16_HPP_a7b9c2d4e1f83056
 #define BCH_63_16_HPP_a7b9c2d4e1f83056
 
+#include <stdint.h>
+
 /**
  * @file
  * @brief BCH(63,16,11) decoder for P25 NID.
@@ -17,6 +19,11 @@
  * and adapted for binary BCH codes. The BCH code operates over GF(2) but uses
  * GF(2^6) for syndrome calculation and error location.
  *
+ * Codewords are handled packed in a uint64_t. A received word is checked by
+ * reducing it modulo the degree-47 generator polynomial with two table
+ * lookups, so the common error-free NID never reaches Berlekamp-Massey. All
+ * tables are generated at compile time.
+ *
  * References:
  * - Lin & Costello, "Error Control Coding"
  * - P25 TIA-102.BAAA specification
@@ -51,69 +58,134 @@ class BCH_63_16_11 {
     static const int KK = 16; // k = data bits
     static const int TT = 11; // t = error correction capability
 
-    int alpha_to[NN + 1]; // antilog table: alpha_to[i] = alpha^i
-    int index_of[NN + 1]; // log table: index_of[x] = i where alpha^i = x
+    static const int PARITY_BITS = NN - KK; // degree of the generator polynomial
 
-    void
-    generate_gf() {
+    struct Tables {
+        int alpha_to[NN + 1];            // antilog table: alpha_to[i] = alpha^i
+        int index_of[NN + 1];            // log table: index_of[x] = i where alpha^i = x
+        uint64_t generator;              // g(x), bit i = coefficient of x^i
+        uint64_t high_remainder[2][256]; // x^47 * byte (bits 47-54, then 55-62) mod g(x)
+    };
+
+    static constexpr void
+    generate_gf(Tables& t) {
         // Primitive polynomial: x^6 + x + 1 -> coefficients [1,1,0,0,0,0,1]
         // Same as used in ReedSolomon_63
         const int pp[MM + 1] = {1, 1, 0, 0, 0, 0, 1};
 
         int mask = 1;
-        alpha_to[MM] = 0;
+        t.alpha_to[MM] = 0;
         for (int i = 0; i < MM; i++) {
-            alpha_to[i] = mask;
-            index_of[alpha_to[i]] = i;
+            t.alpha_to[i] = mask;
+            t.index_of[t.alpha_to[i]] = i;
             if (pp[i] != 0) {
-                alpha_to[MM] ^= mask;
+                t.alpha_to[MM] ^= mask;
             }
             mask <<= 1;
         }
-        index_of[alpha_to[MM]] = MM;
+        t.index_of[t.alpha_to[MM]] = MM;
         mask >>= 1;
         for (int i = MM + 1; i < NN; i++) {
-            if (alpha_to[i - 1] >= mask) {
-                alpha_to[i] = alpha_to[MM] ^ ((alpha_to[i - 1] ^ mask) << 1);
+            if (t.alpha_to[i - 1] >= mask) {
+                t.alpha_to[i] = t.alpha_to[MM] ^ ((t.alpha_to[i - 1] ^ mask) << 1);
             } else {
-                alpha_to[i] = alpha_to[i - 1] << 1;
+                t.alpha_to[i] = t.alpha_to[i - 1] << 1;
             }
-            index_of[alpha_to[i]] = i;
+            t.index_of[t.alpha_to[i]] = i;
         }
-        index_of[0] = -1; // log(0) is undefined, use -1 as sentinel
+        t.index_of[0] = -1; // log(0) is undefined, use -1 as sentinel
     }
 
-    static void
-    reverse_input_bits(const char* input, int recd[NN]) {
-        // IT++ maps r[j] = rbin(n - j - 1): input[0] -> recd[62], input[62] -> recd[0]
-        for (int i = 0; i < NN; i++) {
-            recd[i] = input[NN - 1 - i] ? 1 : 0;
+    static constexpr uint64_t
+    generate_generator(const Tables& t) {
+        // g(x) is the product of (x + alpha^k) over the conjugates of alpha^1..alpha^(2t).
+        bool root[NN] = {false};
+        for (int i = 1; i <= 2 * TT; i++) {
+            for (int k = i; !root[k]; k = (2 * k) % NN) {
+                root[k] = true;
+            }
+        }
+        int g[NN + 1] = {1}; // polynomial form, g[i] = coefficient of x^i
+        int degree = 0;
+        for (int k = 0; k < NN; k++) {
+            if (!root[k]) {
+                continue;
+            }
+            // g(x) *= (x + alpha^k)
+            degree++;
+            for (int i = degree; i >= 0; i--) {
+                const int scaled = (g[i] != 0) ? t.alpha_to[(t.index_of[g[i]] + k) % NN] : 0;
+                g[i] = ((i > 0) ? g[i - 1] : 0) ^ scaled;
+            }
+        }
+        uint64_t bits = 0;
+        for (int i = 0; i <= PARITY_BITS; i++) {
+            bits |= (uint64_t)(g[i] & 1) << i;
         }
+        return bits;
     }
 
-    bool
-    compute_syndromes(const int recd[NN], int s[2 * TT + 1]) const {
-        bool has_error = false;
-
-        // For BCH, syndrome S_i = sum of r_j * alpha^(i*j) for j=0..n-1
-        for (int i = 1; i <= 2 * TT; i++) {
-            int syndrome = 0;
-            for (int j = 0; j < NN; j++) {
-                if (recd[j]) {
-                    syndrome ^= alpha_to[(i * j) % NN];
+    static constexpr Tables
+    make_tables() {
+        Tables t{};
+        generate_gf(t);
+        t.generator = generate_generator(t);
+        // x^(47 + i) mod g(x) for the 16 data positions, then folded into byte tables.
+        uint64_t bit_remainder[KK] = {0};
+        uint64_t r = t.generator ^ ((uint64_t)1 << PARITY_BITS);
+        for (int i = 0; i < KK; i++) {
+            bit_remainder[i] = r;
+            r <<= 1;
+            if ((r >> PARITY_BITS) & 1U) {
+                r ^= t.generator;
+            }
+        }
+        for (int k = 0; k < 2; k++) {
+            for (int b = 1; b < 256; b++) {
+                int low = 0;
+                while (((b >> low) & 1) == 0) {
+                    low++;
                 }
+                t.high_remainder[k][b] = t.high_remainder[k][b & (b - 1)] ^ bit_remainder[(8 * k) + low];
             }
-            has_error = has_error || (syndrome != 0);
-            s[i] = index_of[syndrome]; // convert to index form
         }
-        return has_error;
+        return t;
     }
 
-    static void
-    extract_data_bits(const int recd[NN], char* output) {
-        // Combined IT++ extraction/reversal effect is output[i] = recd[NN - 1 - i]
-        for (int i = 0; i < KK; i++) {
-            output[i] = (char)recd[NN - 1 - i];
+    static const Tables&
+    tables() {
+        static constexpr Tables k_tables = make_tables();
+        return k_tables;
+    }
+
+    const int* alpha_to; // tables().alpha_to
+    const int* index_of; // tables().index_of
+
+    static uint64_t
+    remainder(uint64_t word) {
+        const Tables& t = tables();
+        const uint64_t low_mask = ((uint64_t)1 << PARITY_BITS) - 1U;
+        return (word & low_mask) ^ t.high_remainder[0][(word >> PARITY_BITS) & 0xFFU]
+               ^ t.high_remainder[1][(word >> (PARITY_BITS + 8)) & 0xFFU];
+    }
+
+    void
+    compute_syndromes(uint64_t rem, int s[2 * TT + 1]) const {
+        // S_i = r(alpha^i) = rem(alpha^i) because g(alpha^i) = 0. For a binary
+        // code S_2i = S_i^2, so only the odd syndromes need evaluating.
+        int odd[TT] = {0};
+        for (int j = 0; j < PARITY_BITS; j++) {
+            if ((rem >> j) & 1U) {
+                for (int i = 0; i < TT; i++) {
+                    odd[i] ^= alpha_to[((2 * i + 1) * j) % NN];
+                }
+            }
+        }
+        for (int i = 0; i < TT; i++) {
+            s[2 * i + 1] = index_of[odd[i]]; // convert to index form
+        }
+        for (int i = 2; i <= 2 * TT; i += 2) {
+            s[i] = (s[i / 2] == -1) ? -1 : (2 * s[i / 2]) % NN;
         }
     }
 
@@ -263,48 +335,49 @@ class BCH_63_16_11 {
         return count;
     }
 
-    static void
-    correct_error_locations(int recd[NN], const int loc[TT], int count) {
-        for (int i = 0; i < count; i++) {
-            if (loc[i] >= 0 && loc[i] < NN) {
-                recd[loc[i]] ^= 1;
-            }
-        }
-    }
-
   public:
-    BCH_63_16_11() { generate_gf(); }
+    BCH_63_16_11() : alpha_to(tables().alpha_to), index_of(tables().index_of) {}
 
     /**
-     * @brief Decode a BCH(63,16,11) codeword with error count reporting.
+     * @brief Systematically encode 16 data bits (NAC then DUID, MSB first).
      *
-     * Computes syndromes, runs Berlekamp-Massey to find the error locator
-     * polynomial, then performs Chien search to locate and correct errors.
-     * Returns both a success flag and the number of corrected bit errors,
-     * enabling callers to assess correction confidence.
+     * @return Packed codeword in the decode_word() layout.
+     */
+    static uint64_t
+    encode_word(uint16_t data) {
+        const uint64_t shifted = (uint64_t)data << PARITY_BITS;
+        return shifted | remainder(shifted);
+    }
+
+    /**
+     * @brief Decode a packed BCH(63,16,11) codeword with error count reporting.
      *
-     * @param input  Array of 63 chars, each containing a bit (0 or 1).
-     *               Bit ordering matches IT++ systematic convention:
-     *               data bits in positions 0-15 (MSB first), parity in 16-62.
-     * @param output Array of 16 chars to receive corrected data bits.
+     * An error-free word is recognised from its remainder alone. Otherwise
+     * the syndromes are evaluated from that remainder, Berlekamp-Massey finds
+     * the error locator polynomial, and a Chien search locates and corrects
+     * the errors.
+     *
+     * @param codeword Received bits with the first transmitted bit in bit 62
+     *                 and the last in bit 0; bit 63 is ignored.
+     * @param data     Receives the 16 corrected data bits (first bit in bit 15)
+     *                 on success; left untouched on failure.
      * @return BCH_63_16_Result with success flag and error count.
      *         - success=true, error_count=0: no errors detected (all syndromes zero)
      *         - success=true, error_count=N: N errors corrected (1 <= N <= 11)
      *         - success=false, error_count=0: decoding failed (>11 errors or Chien search mismatch)
      */
     BCH_63_16_Result
-    decode_with_result(const char* input, char* output) const {
-        int recd[NN];      // received codeword (working copy)
-        int s[2 * TT + 1]; // syndromes
-
-        reverse_input_bits(input, recd);
-        if (!compute_syndromes(recd, s)) {
-            // No errors - extract data bits matching IT++ convention
-            // Same extraction as the error-corrected case
-            extract_data_bits(recd, output);
+    decode_word(uint64_t codeword, uint16_t* data) const {
+        codeword &= ((uint64_t)1 << NN) - 1U;
+        const uint64_t rem = remainder(codeword);
+        if (rem == 0) {
+            *data = (uint16_t)(codeword >> PARITY_BITS);
             return BCH_63_16_Result{true, 0};
         }
 
+        int s[2 * TT + 1]; // syndromes
+        compute_syndromes(rem, s);
+
         int elp[2 * TT + 2][2 * TT]; // error locator polynomial
         int l[2 * TT + 2];           // degree of each elp row
         int u = 0;
@@ -323,10 +396,39 @@ class BCH_63_16_11 {
             return BCH_63_16_Result{false, 0};
         }
 
-        correct_error_locations(recd, loc, count);
-        extract_data_bits(recd, output);
+        for (int i = 0; i < count; i++) {
+            codeword ^= (uint64_t)1 << loc[i];
+        }
+        *data = (uint16_t)(codeword >> PARITY_BITS);
         return BCH_63_16_Result{true, count};
     }
+
+    /**
+     * @brief Decode a BCH(63,16,11) codeword with error count reporting.
+     *
+     * Char-per-bit adapter for decode_word().
+     *
+     * @param input  Array of 63 chars, each containing a bit (0 or 1).
+     *               Bit ordering matches IT++ systematic convention:
+     *               data bits in positions 0-15 (MSB first), parity in 16-62.
+     * @param output Array of 16 chars to receive corrected data bits.
+     * @return BCH_63_16_Result, as for decode_word().
+     */
+    BCH_63_16_Result
+    decode_with_result(const char* input, char* output) const {
+        uint64_t codeword = 0;
+        for (int i = 0; i < NN; i++) {
+            codeword = (codeword << 1) | (input[i] ? 1U : 0U);
+        }
+        uint16_t data = 0;
+        const BCH_63_16_Result result = decode_word(codeword, &data);
+        if (result.success) {
+            for (int i = 0; i < KK; i++) {
+                output[i] = (char)((data >> (KK - 1 - i)) & 1U);
+            }
+        }
+        return result;
+    }
 };
 
 #endif // BCH_63_16_HPP_a7b9c2d4e1f83056
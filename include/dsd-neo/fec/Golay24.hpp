@@ -16,24 +16,89 @@
 
 class Golay24 {
   private:
-    static unsigned int
-    golay(unsigned int cw)
-    /* This function calculates [23,12] Golay codewords.
-       The format of the returned int is
-       [checkbits(11),data(12)]. */
+    /*
+     * The (23,12) code is perfect: every syndrome belongs to exactly one error
+     * pattern of weight three or less. Syndromes are linear in the received
+     * word, so both the syndrome and the correction are table lookups. The
+     * tables are generated at compile time from the bit-serial division.
+     */
+    struct Tables {
+        unsigned int syndrome[3][256]; /* syndrome of each byte of a 23-bit word, in bits 12-22 */
+        unsigned int correction[2048]; /* error pattern, plus the reported error count in bits 24-25 */
+    };
+
+    static constexpr unsigned int
+    syndrome_serial(unsigned int cw)
+    /* Bit-serial [23,12] syndrome, as used to build the lookup tables. */
     {
-        int i;
-        unsigned int c;
-        cw &= 0xfffl;
-        c = cw;                   /* save original codeword */
-        for (i = 1; i <= 12; i++) /* examine each data bit */
-        {
-            if (cw & 1) {   /* test data bit */
-                cw ^= POLY; /* XOR polynomial */
+        cw &= 0x7fffffU;
+        for (int i = 1; i <= 12; i++) {
+            if (cw & 1U) {
+                cw ^= POLY;
             }
-            cw >>= 1; /* shift intermediate result */
+            cw >>= 1;
         }
-        return ((cw << 12) | c); /* assemble codeword */
+        return (cw << 12);
+    }
+
+    static constexpr unsigned int
+    error_count(const int* pos, int weight)
+    /* Error count the earlier trial-flip corrector reported for this pattern,
+       kept so corrected-error statistics do not move. Its rotation search only
+       counted errors that fit in 11 cyclically consecutive bits; otherwise one
+       had been removed by a trial flip and was not counted. */
+    {
+        if (weight <= 1) {
+            return (unsigned int)weight;
+        }
+        int widest_gap = pos[0] + 23 - pos[weight - 1];
+        for (int i = 1; i < weight; i++) {
+            if (pos[i] - pos[i - 1] > widest_gap) {
+                widest_gap = pos[i] - pos[i - 1];
+            }
+        }
+        return (24 - widest_gap <= 11) ? (unsigned int)weight : (unsigned int)(weight - 1);
+    }
+
+    static constexpr Tables
+    make_tables() {
+        unsigned int bit_syndrome[23] = {0};
+        for (int i = 0; i < 23; i++) {
+            bit_syndrome[i] = syndrome_serial(1U << i);
+        }
+        /* Build each table from single-bit syndromes, lowest set bit first. */
+        Tables t{};
+        for (int k = 0; k < 3; k++) {
+            const unsigned int limit = (k == 2) ? 128U : 256U; /* bit 23 is the overall parity */
+            for (unsigned int b = 1; b < limit; b++) {
+                int low = 0;
+                while (((b >> low) & 1U) == 0) {
+                    low++;
+                }
+                t.syndrome[k][b] = t.syndrome[k][b & (b - 1U)] ^ bit_syndrome[(8 * k) + low];
+            }
+        }
+        int pos[3] = {0, 0, 0};
+        for (pos[0] = 0; pos[0] < 23; pos[0]++) {
+            const unsigned int s0 = bit_syndrome[pos[0]];
+            t.correction[s0 >> 12] = (1U << pos[0]) | (error_count(pos, 1) << 24);
+            for (pos[1] = pos[0] + 1; pos[1] < 23; pos[1]++) {
+                const unsigned int s1 = s0 ^ bit_syndrome[pos[1]];
+                const unsigned int e1 = (1U << pos[0]) | (1U << pos[1]);
+                t.correction[s1 >> 12] = e1 | (error_count(pos, 2) << 24);
+                for (pos[2] = pos[1] + 1; pos[2] < 23; pos[2]++) {
+                    const unsigned int s2 = s1 ^ bit_syndrome[pos[2]];
+                    t.correction[s2 >> 12] = e1 | (1U << pos[2]) | (error_count(pos, 3) << 24);
+                }
+            }
+        }
+        return t;
+    }
+
+    static const Tables&
+    tables() {
+        static constexpr Tables k_tables = make_tables();
+        return k_tables;
     }
 
     static int
@@ -60,50 +125,18 @@ class Golay24 {
     /* This function calculates and returns the syndrome
        of a [23,12] Golay codeword. */
     {
-        int i;
-        cw &= 0x7fffffl;
-        for (i = 1; i <= 12; i++) /* examine each data bit */
-        {
-            if (cw & 1) {   /* test data bit */
-                cw ^= POLY; /* XOR polynomial */
-            }
-            cw >>= 1; /* shift intermediate result */
-        }
-        return (cw << 12); /* value pairs with upper bits of cw */
+        const Tables& t = tables();
+        return t.syndrome[0][cw & 0xffU] ^ t.syndrome[1][(cw >> 8) & 0xffU] ^ t.syndrome[2][(cw >> 16) & 0x7fU];
     }
 
     static unsigned int
-    rotate_left(unsigned int cw, int n)
-    /* This function rotates 23 bit codeword cw left by n bits. */
-    {
-        if (n != 0) {
-            for (int i = 1; i <= n; i++) {
-                if ((cw & 0x400000l) != 0) {
-                    cw = (cw << 1) | 1;
-                } else {
-                    cw <<= 1;
-                }
-            }
-        }
-
-        return (cw & 0x7fffffl);
-    }
-
-    static unsigned int
-    rotate_right(unsigned int cw, int n)
-    /* This function rotates 23 bit codeword cw right by n bits. */
+    golay(unsigned int cw)
+    /* This function calculates [23,12] Golay codewords.
+       The format of the returned int is
+       [checkbits(11),data(12)]. */
     {
-        if (n != 0) {
-            for (int i = 1; i <= n; i++) {
-                if ((cw & 1) != 0) {
-                    cw = (cw >> 1) | 0x400000l;
-                } else {
-                    cw >>= 1;
-                }
-            }
-        }
-
-        return (cw & 0x7fffffl);
+        cw &= 0xfffU;
+        return syndrome(cw) | cw; /* check bits are the syndrome of the bare data */
     }
 
   public:
@@ -113,56 +146,19 @@ class Golay24 {
        corrected codeword. This function will produce the corrected codeword
        for three or fewer errors. It will produce some other valid Golay
        codeword for four or more errors, possibly not the intended
-       one. *errs is set to the number of bit errors corrected. */
+       one. *errs is set to the number of bit errors corrected.
+       *errors_detected is nonzero when cw was not a codeword. */
     {
-        unsigned char w;      /* current syndrome limit weight, 2 or 3 */
-        unsigned int mask;    /* mask for bit flipping */
-        int i, j;             /* index */
-        unsigned int cwsaver; /* saves initial value of cw */
-
-        cwsaver = cw; /* save */
-        *errs = 0;
-        *errors_detected = 0;
-
-        w = 3;  /* initial syndrome weight threshold */
-        j = -1; /* -1 = no trial bit flipping on first pass */
-        mask = 1;
-        while (j < 23) /* flip each trial bit */
-        {
-            if (j != -1) /* toggle a trial bit */
-            {
-                if (j > 0) /* restore last trial bit */
-                {
-                    mask += mask; /* point to next bit */
-                }
-                cw = cwsaver ^ mask; /* flip next trial bit */
-                w = 2;               /* lower the threshold while bit diddling */
-            }
-
-            unsigned int s = syndrome(cw); /* look for errors */
-            if (s)                         /* errors exist */
-            {
-                (*errors_detected)++;
-                for (i = 0; i < 23; i++) /* check syndrome of each cyclic shift */
-                {
-                    *errs = dsd_popcount64(s & 0x7fffffU);
-                    if (*errs <= w) /* syndrome matches error pattern */
-                    {
-                        cw = cw ^ s;              /* remove errors */
-                        cw = rotate_right(cw, i); /* unrotate data */
-                        return cw;
-                    } else {
-                        cw = rotate_left(cw, 1); /* rotate to next pattern */
-                        s = syndrome(cw);        /* calc new syndrome */
-                    }
-                }
-                j++; /* toggle next trial bit */
-            } else {
-                return (cw); /* return corrected codeword */
-            }
-        }
-
-        return (cwsaver); /* return original if no corrections */
+        const unsigned int s = syndrome(cw);
+        if (s == 0) {
+            *errs = 0;
+            *errors_detected = 0;
+            return cw;
+        }
+        const unsigned int fix = tables().correction[s >> 12];
+        *errs = (int)(fix >> 24);
+        *errors_detected = 1;
+        return (cw ^ fix) & 0x7fffffU;
     } /* correct */
 
     static unsigned int
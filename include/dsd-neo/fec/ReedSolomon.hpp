@@ -68,6 +68,7 @@ class ReedSolomon_63 {
     static const int KK = NN - 2 * TT;
     // distance = nn-kk+1 = 2*tt+1
 
+    /* alpha_to holds two periods (2 * NN entries) so sums of two logs index it without a modulo. */
     int* alpha_to;
     int* index_of;
 
@@ -76,7 +77,7 @@ class ReedSolomon_63 {
         if (a == 0 || b == 0) {
             return 0;
         }
-        return alpha_to[(index_of[a] + index_of[b]) % NN];
+        return alpha_to[index_of[a] + index_of[b]];
     }
 
     int
@@ -87,7 +88,7 @@ class ReedSolomon_63 {
         if (b == 0) {
             return 0;
         }
-        return alpha_to[(index_of[a] - index_of[b] + NN) % NN];
+        return alpha_to[index_of[a] - index_of[b] + NN];
     }
 
     int
@@ -99,23 +100,36 @@ class ReedSolomon_63 {
         return alpha_to[e];
     }
 
+    /* S_i = sum of word[j] * alpha^(i*j). Each nonzero symbol is converted to its log once and then
+       stepped by j per syndrome, so the P25 codes (39-47 zero pad symbols) cost one table read per
+       nonzero symbol and syndrome. */
     int
     compute_syndromes(const int* word, int* syndromes) const {
+        for (int i = 0; i <= NN - KK; i++) {
+            syndromes[i] = 0;
+        }
+        for (int j = 0; j < NN; j++) {
+            if (word[j] != 0) {
+                accumulate_symbol_syndromes(index_of[word[j]], j, syndromes);
+            }
+        }
         int syn_error = 0;
-        syndromes[0] = 0;
         for (int i = 1; i <= NN - KK; i++) {
-            int s = 0;
-            for (int j = 0; j < NN; j++) {
-                if (word[j] != 0) {
-                    s ^= gf_mul(word[j], gf_alpha_pow(i * j));
-                }
-            }
-            syndromes[i] = s;
-            if (s != 0) {
-                syn_error = 1;
+            syn_error |= syndromes[i];
+        }
+        return syn_error != 0;
+    }
+
+    void
+    accumulate_symbol_syndromes(int log_value, int position, int* syndromes) const {
+        int e = log_value;
+        for (int i = 1; i <= NN - KK; i++) {
+            e += position;
+            if (e >= NN) {
+                e -= NN;
             }
+            syndromes[i] ^= alpha_to[e];
         }
-        return syn_error;
     }
 
     int
@@ -352,21 +366,20 @@ class ReedSolomon_63 {
 
     int
     compute_index_syndromes(const int* recd, int* s) const {
-        int syn_error = 0;
-        s[0] = 0;
-        for (int i = 1; i <= NN - KK; i++) {
+        for (int i = 0; i <= NN - KK; i++) {
             s[i] = 0;
-            for (int j = 0; j < NN; j++) {
-                if (recd[j] != -1) {
-                    s[i] ^= alpha_to[(recd[j] + i * j) % NN];
-                }
-            }
-            if (s[i] != 0) {
-                syn_error = 1;
+        }
+        for (int j = 0; j < NN; j++) {
+            if (recd[j] != -1) {
+                accumulate_symbol_syndromes(recd[j], j, s);
             }
+        }
+        int syn_error = 0;
+        for (int i = 1; i <= NN - KK; i++) {
+            syn_error |= s[i];
             s[i] = index_of[s[i]];
         }
-        return syn_error;
+        return syn_error != 0;
     }
 
     static void
@@ -627,7 +640,14 @@ class ReedSolomon_63 {
 
         int erasure_locator[NN - KK + 1];
         build_erasure_locator(erasures, n_erasures, erasure_locator);
+        return solve_with_erasure_locator(output, syndromes, erasure_locator, erasures, n_erasures);
+    }
 
+    /* Errors-and-erasures solve for one erasure set, given the received word's syndromes and the
+       erasure locator of that set. Corrections are applied to output only when the result checks. */
+    int
+    solve_with_erasure_locator(int* output, const int* syndromes, const int* erasure_locator, const int* erasures,
+                               int n_erasures) const {
         int modified_syndromes[NN - KK];
         compute_modified_syndromes(syndromes, erasure_locator, n_erasures, modified_syndromes);
 
@@ -672,12 +692,24 @@ class ReedSolomon_63 {
         if (solve_gf_linear_system(matrix, n_locations, corrections) != 0) {
             return 1;
         }
+
+        /* The corrected word's syndromes are the received ones plus those of the correction pattern. */
+        int check[NN - KK + 1];
+        for (int i = 0; i <= NN - KK; i++) {
+            check[i] = syndromes[i];
+        }
         for (int i = 0; i < n_locations; i++) {
-            output[locations[i]] ^= corrections[i];
+            if (corrections[i] != 0) {
+                accumulate_symbol_syndromes(index_of[corrections[i]], locations[i], check);
+            }
         }
-
-        if (compute_syndromes(output, syndromes)) {
-            return 1;
+        for (int i = 1; i <= NN - KK; i++) {
+            if (check[i] != 0) {
+                return 1;
+            }
+        }
+        for (int i = 0; i < n_locations; i++) {
+            output[locations[i]] ^= corrections[i];
         }
         return 0;
     }
@@ -713,11 +745,14 @@ class ReedSolomon_63 {
             index_of[alpha_to[i]] = i;
         }
         index_of[0] = -1;
+        for (i = NN; i < 2 * NN; i++) {
+            alpha_to[i] = alpha_to[i - NN];
+        }
     }
 
   public:
     ReedSolomon_63() {
-        alpha_to = new int[NN + 1];
+        alpha_to = new int[2 * NN];
         index_of = new int[NN + 1];
 
         // Polynom used in P25 is alpha**6+alpha+1
@@ -794,7 +829,100 @@ class ReedSolomon_63 {
         return status;
     }
 
+    /**
+     * Tries the erasure sets erasures[0..n-1] for n = 1..n_ranked in order and keeps the first that
+     * decodes. Same result as calling decode_with_erasures() once per prefix, but the syndromes are
+     * computed once and each erasure locator extends the previous one by a single factor.
+     *
+     * \return 0 with the corrected word in output, or 1 with output equal to input.
+     */
+    int
+    decode_with_erasure_prefixes(const int* input, int* output, const int* erasures, int n_ranked) const {
+        if (input == NULL || output == NULL || erasures == NULL || n_ranked <= 0) {
+            return 1;
+        }
+        if (n_ranked > NN - KK) {
+            n_ranked = NN - KK;
+        }
+        copy_codeword(input, output);
+
+        /* A repeated or out-of-range position invalidates that prefix and every longer one. */
+        int seen[NN];
+        for (int i = 0; i < NN; i++) {
+            seen[i] = 0;
+        }
+        int n_valid = 0;
+        while (n_valid < n_ranked) {
+            int pos = erasures[n_valid];
+            if ((pos < 0) || (pos >= NN) || seen[pos]) {
+                break;
+            }
+            seen[pos] = 1;
+            n_valid++;
+        }
+        if (n_valid == 0) {
+            return 1;
+        }
+
+        int syndromes[NN - KK + 1];
+        if (!compute_syndromes(input, syndromes)) {
+            return 0;
+        }
+
+        int erasure_locator[NN - KK + 1];
+        for (int i = 0; i <= NN - KK; i++) {
+            erasure_locator[i] = 0;
+        }
+        erasure_locator[0] = 1;
+        for (int n = 1; n <= n_valid; n++) {
+            int factor = gf_alpha_pow(erasures[n - 1]);
+            for (int i = n - 1; i >= 0; i--) {
+                erasure_locator[i + 1] ^= gf_mul(erasure_locator[i], factor);
+            }
+            if (solve_with_erasure_locator(output, syndromes, erasure_locator, erasures, n) == 0) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+
   protected:
+    /**
+     * Shared body of the adapters' decode_soft_ranked(): packs the symbols once, runs the hard
+     * decoder once (it returns early on zero syndromes) and then the erasure prefixes in one pass.
+     * Parity symbols come first in the codeword, then data, then zero padding.
+     */
+    int
+    decode_ranked_symbols(char* hex_data, int data_symbols, const char* hex_parity, int parity_symbols,
+                          const int* erasures, int n_ranked) const {
+        if (n_ranked <= 0) {
+            return 1;
+        }
+
+        int input[NN];
+        int output[NN];
+        for (int i = 0; i < parity_symbols; i++) {
+            input[i] = bin_to_hex(hex_parity + i * 6);
+        }
+        for (int i = 0; i < data_symbols; i++) {
+            input[parity_symbols + i] = bin_to_hex(hex_data + i * 6);
+        }
+        for (int i = parity_symbols + data_symbols; i < NN; i++) {
+            input[i] = 0;
+        }
+
+        int result = decode(input, output);
+        if (result != 0) {
+            result = decode_with_erasure_prefixes(input, output, erasures, n_ranked);
+        }
+        if (result == 0) {
+            for (int i = 0; i < data_symbols; i++) {
+                hex_to_bin(output[parity_symbols + i], hex_data + i * 6);
+            }
+        }
+        return result;
+    }
+
     static int
     bin_to_hex(const char* input) {
         int output = ((input[0] != 0) ? 32 : 0) | ((input[1] != 0) ? 16 : 0) | ((input[2] != 0) ? 8 : 0)
@@ -909,6 +1037,21 @@ class DSDReedSolomon_36_20_17 : public ReedSolomon_63<8> {
         }
         return result;
     }
+
+    /**
+     * Equivalent to calling decode_soft() with erasures[0..n-1] for n = 1..n_ranked and keeping the
+     * first success, without repeating the hard decode and syndrome computation for every prefix.
+     *
+     * \param hex_data Data packed bits, char[20][6]. Corrected in place only on success.
+     * \param hex_parity Parity packed bits, char[16][6].
+     * \param erasures Weakest-first erasure positions (0-15=parity, 16-35=data).
+     * \param n_ranked Number of ranked positions (max 16).
+     * \return 1 if no prefix decodes, 0 otherwise.
+     */
+    int
+    decode_soft_ranked(char* hex_data, const char* hex_parity, const int* erasures, int n_ranked) const {
+        return decode_ranked_symbols(hex_data, 20, hex_parity, 16, erasures, n_ranked);
+    }
 };
 
 /**
@@ -1004,6 +1147,21 @@ class DSDReedSolomon_24_12_13 : public ReedSolomon_63<6> {
         }
         return result;
     }
+
+    /**
+     * Equivalent to calling decode_soft() with erasures[0..n-1] for n = 1..n_ranked and keeping the
+     * first success, without repeating the hard decode and syndrome computation for every prefix.
+     *
+     * \param hex_data Data packed bits, char[12][6]. Corrected in place only on success.
+     * \param hex_parity Parity packed bits, char[12][6].
+     * \param erasures Weakest-first erasure positions (0-11=parity, 12-23=data).
+     * \param n_ranked Number of ranked positions (max 12).
+     * \return 1 if no prefix decodes, 0 otherwise.
+     */
+    int
+    decode_soft_ranked(char* hex_data, const char* hex_parity, const int* erasures, int n_ranked) const {
+        return decode_ranked_symbols(hex_data, 12, hex_parity, 12, erasures, n_ranked);
+    }
 };
 
 /**
@@ -1099,6 +1257,21 @@ class DSDReedSolomon_24_16_9 : public ReedSolomon_63<4> {
         }
         return result;
     }
+
+    /**
+     * Equivalent to calling decode_soft() with erasures[0..n-1] for n = 1..n_ranked and keeping the
+     * first success, without repeating the hard decode and syndrome computation for every prefix.
+     *
+     * \param hex_data Data packed bits, char[16][6]. Corrected in place only on success.
+     * \param hex_parity Parity packed bits, char[8][6].
+     * \param erasures Weakest-first erasure positions (0-7=parity, 8-23=data).
+     * \param n_ranked Number of ranked positions (max 8).
+     * \return 1 if no prefix decodes, 0 otherwise.
+     */
+    int
+    decode_soft_ranked(char* hex_data, const char* hex_parity, const int* erasures, int n_ranked) const {
+        return decode_ranked_symbols(hex_data, 16, hex_parity, 8, erasures, n_ranked);
+    }
 };
 
 #endif // REEDSOLOMON_HPP_b1405fdab6374ba2a4e65e8d45ec3d80
@@ -28,6 +28,18 @@ extern "C" {
  */
 int hamming_10_6_3_decode(char* data, const char* parity);
 
+/**
+ * Packed form of hamming_10_6_3_decode(): one table lookup per codeword.
+ *
+ * @param codeword Data bits first-received-most-significant in bits 9-4, parity in bits 3-0.
+ * @param data Optional output for the six data bits, corrected when the return value is 1.
+ * @return 0 when valid, 1 when one bit was corrected or identified, and 2 when uncorrectable.
+ */
+int hamming_10_6_3_decode_word(unsigned int codeword, unsigned int* data);
+
+/** Encode six data bits into the packed codeword layout used by hamming_10_6_3_decode_word(). */
+unsigned int hamming_10_6_3_encode_word(unsigned int data);
+
 void Hamming_7_4_init(void);
 bool Hamming_7_4_decode(unsigned char* rxBits);
 
@@ -23,6 +23,11 @@ extern const uint8_t DeInterleaveReverseChannelBptcPlacement[32];
 
 void BPTCDeInterleaveDMRData(const uint8_t* Input, uint8_t* Output);
 uint32_t BPTC_196x96_Extract_Data(uint8_t InputDeInteleavedData[196], uint8_t DMRDataExtracted[96], uint8_t R[3]);
+/**
+ * Deinterleave and decode a BPTC(196,96) block in one pass.
+ * Same result as BPTCDeInterleaveDMRData() followed by BPTC_196x96_Extract_Data().
+ */
+uint32_t BPTC_196x96_Decode(const uint8_t InputInterleavedData[196], uint8_t DMRDataExtracted[96], uint8_t R[3]);
 uint32_t BPTC_128x77_Extract_Data(uint8_t InputDataMatrix[8][16], uint8_t DMRDataExtracted[77]);
 uint32_t BPTC_16x2_Extract_Data(uint8_t InputInterleavedData[32], uint8_t DMRDataExtracted[32],
                                 uint32_t ParityCheckTypeOdd);
@@ -8,6 +8,9 @@
  * @brief Viterbi decoder helpers.
  *
  * Declares the Viterbi routines implemented in `src/core/util/dsd_misc.c`.
+ * viterbi_decode() and viterbi_decode_punctured() are reentrant; the
+ * piecewise decode_bit/chainback/reset calls share one process-wide trellis.
+ * All of them run on the engine in `viterbi_k5.h`.
  */
 
 #ifndef DSD_NEO_INCLUDE_DSD_NEO_FEC_VITERBI_H_
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Reentrant Viterbi decoder for the K=5, rate 1/2 convolutional code.
+ *
+ * M17, NXDN and YSF all use the same 16-state code (generators 0x19/0x17). The
+ * decoder keeps its path metrics and decisions in a caller-owned context, so
+ * independent decodes can run on different threads. Each trellis step is one
+ * set of eight add-compare-select butterflies, done with SSE2 or NEON when the
+ * target has them.
+ *
+ * Branch metrics are supplied per step by the caller, one per coded output
+ * pair, which lets hard, soft and reliability-weighted front ends share it.
+ */
+
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_FEC_VITERBI_K5_H_
+#define DSD_NEO_INCLUDE_DSD_NEO_FEC_VITERBI_K5_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    DSD_VITERBI_K5_STATES = 16,
+    /* Longest trellis in use (NXDN FACCH2/UDCH) plus headroom. */
+    DSD_VITERBI_K5_MAX_STEPS = 320,
+    /* Largest branch_full that keeps path metrics in signed 32-bit range over MAX_STEPS. */
+    DSD_VITERBI_K5_MAX_BRANCH = 0x1FFFE,
+};
+
+typedef struct {
+    uint32_t metrics[DSD_VITERBI_K5_STATES];
+    uint32_t branch_full; /* metric of a full mismatch on both coded bits */
+    size_t steps;
+    uint16_t decisions[DSD_VITERBI_K5_MAX_STEPS]; /* bit s set: state s came from the upper predecessor */
+} dsd_viterbi_k5;
+
+/**
+ * @brief Clear path metrics and decisions.
+ *
+ * @param v Decoder context.
+ * @param branch_full Sum of a pair's branch metric and its complement's; clamped to DSD_VITERBI_K5_MAX_BRANCH.
+ */
+void dsd_viterbi_k5_reset(dsd_viterbi_k5* v, uint32_t branch_full);
+
+/**
+ * @brief Advance the trellis by one coded bit pair.
+ *
+ * `bm[p]` is the cost of receiving the pair as coded output `p` (bit 1 = first
+ * generator, bit 0 = second). Each butterfly charges its complementary
+ * branch `branch_full - bm[p]`, as the reference decoders did, so the caller
+ * controls rounding of weighted metrics. Values above branch_full are clamped.
+ *
+ * @return 0 on success, -1 when the decision buffer is full.
+ */
+int dsd_viterbi_k5_step(dsd_viterbi_k5* v, const uint32_t bm[4]);
+
+/** @brief Smallest path metric after the last step (lower is better). */
+uint32_t dsd_viterbi_k5_best_metric(const dsd_viterbi_k5* v);
+
+/**
+ * @brief Trace back from the zero state at the end of the trellis.
+ *
+ * Writes one bit per byte: `bits[j]` is the decision recovered at step
+ * `steps - count + j`. `count` is clamped to the number of steps taken.
+ *
+ * @return Number of bits written.
+ */
+size_t dsd_viterbi_k5_traceback(const dsd_viterbi_k5* v, uint8_t* bits, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_FEC_VITERBI_K5_H_ */
@@ -358,6 +358,20 @@ void rtl_device_print_offset_capability(struct rtl_device* dev);
  * @return 0 on success; negative on error.
  */
 int rtl_device_set_tcp_autotune(struct rtl_device* dev, int onoff);
+
+/**
+ * @brief Run the first half-band decimation stage in the USB capture callback.
+ *
+ * When enabled the input ring carries interleaved I/Q at half the capture
+ * rate; the demodulator must skip its first cascade stage to match. The
+ * callback picks the change up on its next buffer and restarts the filter.
+ *
+ * @param dev RTL-SDR device handle.
+ * @param on Non-zero to enable; zero to disable.
+ * @return 0 on success; DSD_ERR_NOT_SUPPORTED when enabling on a non-USB
+ *         backend or with a compact input ring; -1 on invalid handle.
+ */
+int rtl_device_set_ingest_decimation(struct rtl_device* dev, int on);
 /**
  * @brief Attach or detach an optional IQ capture writer.
  *
@@ -416,6 +430,17 @@ uint32_t rtl_device_get_capture_retune_count(struct rtl_device* dev);
  */
 int rtl_device_get_native_sample_format(const struct rtl_device* dev);
 
+/**
+ * @brief Return the native format this backend can write into a compact input ring.
+ *
+ * CU8 for USB/rtl_tcp with the combined rotation transform, CS16 for SoapySDR
+ * streams negotiated as CS16, otherwise 0 (the ring must stay float).
+ *
+ * @param dev RTL-SDR device handle.
+ * @return Sample format code or 0.
+ */
+int rtl_device_get_compact_ring_format(const struct rtl_device* dev);
+
 /**
  * @brief Set (or clear) RTL and tuner crystal reference frequencies.
  *
@@ -15,22 +15,44 @@
 #define DSD_NEO_INCLUDE_DSD_NEO_IO_RTL_STREAM_H_
 
 #include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/io/rtl_stream_fwd.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/**
+ * @brief Binds the calling thread to a pipeline for the lifetime of the scope.
+ *
+ * Restores the previous binding on destruction. A null pipeline selects the
+ * process default (see dsd_rtl_stream_bind()).
+ */
+class RtlPipelineScope {
+  public:
+    explicit RtlPipelineScope(dsd_rtl_stream* pipeline);
+    ~RtlPipelineScope();
+
+  private:
+    RtlPipelineScope(const RtlPipelineScope&) = delete;
+    RtlPipelineScope& operator=(const RtlPipelineScope&) = delete;
+
+    dsd_rtl_stream* prev_;
+};
+
 /**
  * @brief RAII-class orchestrator for RTL-SDR streaming pipeline.
  *
  * Owns a stream-options snapshot, initializes and launches the backend from
- * start(), tears it down from stop(), and auto-stops on destruction.
+ * start(), tears it down from stop(), and auto-stops on destruction. Every
+ * call runs on the orchestrator's pipeline, whatever the calling thread's
+ * own binding is.
  */
 class RtlSdrOrchestrator {
   public:
     /**
      * @brief Construct a stream with an internal snapshot mirrored to caller-owned options.
      * @param opts Mutable @ref dsd_opts used to configure the stream and receive live PPM updates.
+     * @param pipeline Pipeline from dsd_rtl_stream_create() to run on, or nullptr for the default.
      */
-    explicit RtlSdrOrchestrator(dsd_opts& opts);
+    explicit RtlSdrOrchestrator(dsd_opts& opts, dsd_rtl_stream* pipeline = nullptr);
 
     /**
      * @brief Destructor. Ensures stop() is called.
@@ -73,6 +95,12 @@ class RtlSdrOrchestrator {
      */
     int read(float* out, size_t count, int& out_got);
 
+    /** @brief Pipeline this stream runs on; nullptr is the process default. */
+    dsd_rtl_stream*
+    pipeline() const {
+        return pipeline_;
+    }
+
   private:
     // Non-copyable to avoid accidental shared lifecycle
     RtlSdrOrchestrator(const RtlSdrOrchestrator&) = delete;
@@ -81,6 +109,7 @@ class RtlSdrOrchestrator {
     // Mutable snapshot of options passed into C API
     dsd_opts* opts_;
     dsd_opts* caller_opts_;
+    dsd_rtl_stream* pipeline_;
     bool started_;
 };
 
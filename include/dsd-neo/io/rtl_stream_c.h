@@ -97,6 +97,48 @@ int rtl_stream_stop(RtlSdrContext* ctx);
  */
 int rtl_stream_destroy(RtlSdrContext* ctx);
 
+/* Independent pipelines */
+/**
+ * @brief Allocate an independent demod/controller/output pipeline.
+ *
+ * The process always has a default pipeline, which rtl_stream_create() and
+ * every context-less call below act on. Each pipeline made here has its own
+ * rings, demodulator, metrics and retune state, so one process can run several
+ * radios side by side. Attach one with rtl_stream_create_on().
+ *
+ * @return New pipeline, or NULL on allocation failure.
+ */
+dsd_rtl_stream* dsd_rtl_stream_create(void);
+/**
+ * @brief Free a pipeline from dsd_rtl_stream_create().
+ * Every context attached to it must have been destroyed first.
+ * @param stream Pipeline to free. NULL and the default pipeline are ignored.
+ */
+void dsd_rtl_stream_destroy(dsd_rtl_stream* stream);
+/**
+ * @brief Point the calling thread's context-less calls at @p stream.
+ *
+ * Getters such as rtl_stream_get_snr_c4fm() or rtl_stream_request_demod_profile()
+ * take no context; they act on the pipeline the calling thread is bound to.
+ * Threads a pipeline starts are bound to it already.
+ *
+ * @param stream Pipeline to bind, or NULL for the default pipeline.
+ * @return The previous binding (NULL for the default), for restoring it.
+ */
+dsd_rtl_stream* dsd_rtl_stream_bind(dsd_rtl_stream* stream);
+/**
+ * @brief rtl_stream_create() on a pipeline from dsd_rtl_stream_create().
+ *
+ * Calls through the returned context run on @p stream regardless of the
+ * calling thread's binding. The context does not own the pipeline.
+ *
+ * @param stream Pipeline to run on, or NULL for the default pipeline.
+ * @param opts Mutable caller-owned decoder options. Must not be NULL.
+ * @param out_ctx [out] On success, receives an opaque context pointer.
+ * @return 0 on success; otherwise <0 on error.
+ */
+int rtl_stream_create_on(dsd_rtl_stream* stream, dsd_opts* opts, RtlSdrContext** out_ctx);
+
 /* Control */
 /**
  * @brief Tune to a new center frequency.
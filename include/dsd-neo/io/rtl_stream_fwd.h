@@ -5,7 +5,7 @@
 
 /**
  * @file
- * @brief Forward declaration of the C RTL stream context type.
+ * @brief Forward declarations of the C RTL stream context and pipeline types.
  */
 
 #ifndef DSD_NEO_INCLUDE_DSD_NEO_IO_RTL_STREAM_FWD_H_
@@ -18,6 +18,7 @@ extern "C" {
 #endif
 
 typedef struct RtlSdrContext RtlSdrContext;
+typedef struct dsd_rtl_stream dsd_rtl_stream;
 
 #ifdef __cplusplus
 }
@@ -15,6 +15,7 @@
 #ifndef DSD_NEO_INCLUDE_DSD_NEO_PROTOCOL_NXDN_NXDN_CONVOLUTION_H_H
 #define DSD_NEO_INCLUDE_DSD_NEO_PROTOCOL_NXDN_NXDN_CONVOLUTION_H_H
 
+#include <dsd-neo/fec/viterbi_k5.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -27,6 +28,16 @@ void CNXDNConvolution_decode_soft(uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1
 void CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits);
 void CNXDNConvolution_init(void);
 
+/*
+ * Reentrant forms of the above on a caller-owned trellis. start_ctx clears the
+ * path metrics; the process-wide calls share one trellis and are only safe
+ * from a single decoder thread.
+ */
+void CNXDNConvolution_start_ctx(dsd_viterbi_k5* v);
+void CNXDNConvolution_decode_ctx(dsd_viterbi_k5* v, uint8_t s0, uint8_t s1);
+void CNXDNConvolution_decode_soft_ctx(dsd_viterbi_k5* v, uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1);
+void CNXDNConvolution_chainback_ctx(const dsd_viterbi_k5* v, unsigned char* out, unsigned int nBits);
+
 #ifdef __cplusplus
 }
 #endif
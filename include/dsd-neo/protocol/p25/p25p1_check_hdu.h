@@ -46,6 +46,18 @@ int check_and_fix_redsolomon_36_20_17(char* data, const char* parity);
  */
 int check_and_fix_redsolomon_36_20_17_soft(char* data, const char* parity, const int* erasures, int n_erasures);
 
+/**
+ * Tries the erasure prefixes erasures[0..n-1], n = 1..n_ranked, in order and keeps the first that
+ * decodes. Same result as one check_and_fix_redsolomon_36_20_17_soft() call per prefix, but the
+ * hard decode and syndromes are computed once.
+ * \param data The packed 20 data hex words, corrected in place on success and untouched otherwise.
+ * \param parity The corresponding 16 parity hex words.
+ * \param erasures Weakest-first RS codeword positions, 0-15 parity and 16-35 data.
+ * \param n_ranked Number of ranked positions, max 16.
+ * \return 1 if irrecoverable errors have been detected, 0 otherwise.
+ */
+int check_and_fix_redsolomon_36_20_17_ranked(char* data, const char* parity, const int* erasures, int n_ranked);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,18 @@ int check_and_fix_reedsolomon_24_12_13(char* data, const char* parity);
  */
 int check_and_fix_reedsolomon_24_12_13_soft(char* data, const char* parity, const int* erasures, int n_erasures);
 
+/**
+ * Tries the erasure prefixes erasures[0..n-1], n = 1..n_ranked, in order and keeps the first that
+ * decodes. Same result as one check_and_fix_reedsolomon_24_12_13_soft() call per prefix, but the
+ * hard decode and syndromes are computed once.
+ * \param data The packed 12 data hex words, corrected in place on success and untouched otherwise.
+ * \param parity The corresponding 12 parity hex words.
+ * \param erasures Weakest-first RS codeword positions, 0-11 parity and 12-23 data.
+ * \param n_ranked Number of ranked positions, max 12.
+ * \return 1 if irrecoverable errors have been detected, 0 otherwise.
+ */
+int check_and_fix_reedsolomon_24_12_13_ranked(char* data, const char* parity, const int* erasures, int n_ranked);
+
 /**
  * Attempts to correct 16 hex words using the Reed-Solomon(24,16,9) FEC.
  * \param data The packed 16 hex words, each of 6 chars, one after the other.
@@ -46,6 +58,15 @@ int check_and_fix_reedsolomon_24_16_9(char* data, const char* parity);
  */
 int check_and_fix_reedsolomon_24_16_9_soft(char* data, const char* parity, const int* erasures, int n_erasures);
 
+/**
+ * Ranked-prefix form of check_and_fix_reedsolomon_24_16_9_soft(); see
+ * check_and_fix_reedsolomon_24_12_13_ranked().
+ * \param erasures Weakest-first RS codeword positions, 0-7 parity and 8-23 data.
+ * \param n_ranked Number of ranked positions, max 8.
+ * \return 1 if irrecoverable errors have been detected, 0 otherwise.
+ */
+int check_and_fix_reedsolomon_24_16_9_ranked(char* data, const char* parity, const int* erasures, int n_ranked);
+
 #ifdef __cplusplus
 }
 #endif
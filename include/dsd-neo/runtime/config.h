@@ -95,6 +95,9 @@ extern "C" {
  * - DSD_NEO_RETUNE_MUTE_MS
  *     Input sample mute duration around RTL retunes. This drops tuner-settling samples before they can train
  *     CQPSK recovery state. Values: integer 10..1000. Default: 120ms.
+ * - DSD_NEO_OUTPUT_WAKE_SAMPLES
+ *     Output ring fill level (samples) that wakes a blocked decoder read. Larger values mean fewer wakeups per
+ *     block; data below it is read when the idle wait expires. Values: integer 1..16384. Default: 1.
  *
  * TCP audio input
  * - DSD_NEO_TCPIN_BACKOFF_MS
@@ -105,6 +108,10 @@ extern "C" {
  * - DSD_NEO_WINDOW_FREEZE
  *     Freeze symbol decision window selection and disable auto-centering nudges. Useful for A/B testing.
  *     Values: 1 freeze, else dynamic. Default: 0 (dynamic).
+ * - DSD_NEO_SYNC_RACE
+ *     While unsynced, also slice the raw samples at every other enabled symbol-rate profile and jump the
+ *     SPS hunt straight to the first profile whose sync pattern appears, instead of waiting out each dwell.
+ *     Values: 1 enable, else disabled. Default: 0 (round-robin hunt only).
  *
  * Intra-block multithreading
  * - DSD_NEO_MT
@@ -204,6 +211,11 @@ typedef struct dsdneoRuntimeConfig {
     int cpu_dongle;
     int cpu_demod_is_set;
     int cpu_demod;
+    int rt_prio_dsp_is_set;
+    int rt_prio_dsp;
+    int cpu_dsp_is_set;
+    int cpu_dsp;       /* first CPU of the DSP worker range */
+    int cpu_dsp_count; /* CPUs in the range; worker i pins to cpu_dsp + i % count */
 
     /* Bootstrap/system toggles */
     int ftz_daz_is_set;
@@ -379,10 +391,24 @@ typedef struct dsdneoRuntimeConfig {
     /* Intra-block multithreading */
     int mt_is_set;
     int mt_enable;
+    int mt_workers_is_set;
+    int mt_workers; /* shared DSP pool size; default derived from the host core count */
+    int demod_pipeline_is_set;
+    int demod_pipeline_enable; /* overlap full_demod() front and back halves on the pool */
+    int vocoder_thread_is_set;
+    int vocoder_thread_enable; /* synthesize slot AMBE frames on per-slot vocoder threads */
+    int audio_graph_is_set;
+    int audio_graph_enable; /* mix per-call slot streams on the audio graph's mixer thread */
+    int wav_async_is_set;
+    int wav_async_enable; /* write, close and rename per-call WAV recordings on a writer thread */
 
     /* Frontend tuning behavior */
     int combine_rot_is_set;
     int combine_rot;
+    int ingest_hb_is_set;
+    int ingest_hb; /* run the first half-band stage in the USB ingest thread */
+    int input_ring_compact_is_set;
+    int input_ring_compact; /* store native CU8/CS16 in the input ring */
     int fs4_shift_disable_is_set;
     int fs4_shift_disable;
     int output_clear_on_retune_is_set;
@@ -391,6 +417,8 @@ typedef struct dsdneoRuntimeConfig {
     int retune_drain_ms;
     int retune_mute_ms_is_set;
     int retune_mute_ms;
+    int output_wake_samples_is_set;
+    int output_wake_samples;
 
     /* TCP audio input */
     int tcpin_backoff_ms_is_set;
@@ -399,6 +427,8 @@ typedef struct dsdneoRuntimeConfig {
     /* Symbol window debug/testing */
     int window_freeze_is_set;
     int window_freeze;
+    int sync_race_is_set;
+    int sync_race_enable; /* race the other SPS profiles on the raw samples while hunting */
 
     /* Optional JSON emitter for P25 PDUs */
     int pdu_json_is_set;
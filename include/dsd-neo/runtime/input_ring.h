@@ -5,10 +5,16 @@
 
 /**
  * @file
- * @brief Input ring buffer API for interleaved I/Q float samples.
+ * @brief Input ring buffer API for interleaved I/Q samples.
  *
  * Declares the simple SPSC input ring and operations to reserve, commit,
  * and blockingly read samples with wrap-around handling.
+ *
+ * The ring normally stores float32. A compact ring stores the producer's
+ * native CU8 or CS16 scalars instead and widens them to float on the
+ * consumer side, one block at a time. Capacity, fill levels, watermarks and
+ * drop counters are always in scalar elements, so only the storage width
+ * differs between the modes.
  */
 #ifndef DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_INPUT_RING_H_
 #define DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_INPUT_RING_H_
@@ -17,17 +23,23 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <dsd-neo/io/iq_types.h>
 #include <dsd-neo/platform/threading.h>
+#include <dsd-neo/runtime/ring_wake.h>
+#include <dsd-neo/runtime/spsc_ring.h>
 
-/* Simple SPSC ring for interleaved I/Q float samples (input path) */
-struct input_ring_state {
-    float* buffer = nullptr;
-    size_t capacity = 0; /* in float elements */
-    std::atomic<size_t> head{0U};
-    std::atomic<size_t> tail{0U};
+/*
+ * SPSC ring for interleaved I/Q samples (input path); capacity counts scalar
+ * elements. `buffer` is only set for float storage; compact rings are
+ * accessed through input_ring_reserve_raw() and input_ring_read_convert().
+ */
+struct input_ring_state : spsc_ring<float> {
+    void* storage = nullptr;
+    dsd_iq_sample_format format = DSD_IQ_FORMAT_CF32; /* CF32, CU8 or CS16 */
     dsd_cond_t ready;
     dsd_mutex_t ready_m;
     dsd_cond_t space;
+    struct ring_wake wake; /* consumer wakeups; see ring_wake.h */
     std::atomic<int> space_notify_enabled{0};
     std::atomic<uint64_t> producer_drops{0U}; /* bytes dropped when full */
     std::atomic<uint64_t> read_timeouts{0U};  /* waits for data */
@@ -39,12 +51,7 @@ struct input_ring_state {
  */
 static inline size_t
 input_ring_used(const struct input_ring_state* r) {
-    size_t h = r->head.load();
-    size_t t = r->tail.load();
-    if (h >= t) {
-        return h - t;
-    }
-    return r->capacity - t + h;
+    return r->used();
 }
 
 /**
@@ -52,7 +59,7 @@ input_ring_used(const struct input_ring_state* r) {
  */
 static inline size_t
 input_ring_free(const struct input_ring_state* r) {
-    return (r->capacity - 1) - input_ring_used(r);
+    return r->free_space();
 }
 
 /**
@@ -60,7 +67,15 @@ input_ring_free(const struct input_ring_state* r) {
  */
 static inline int
 input_ring_is_empty(const struct input_ring_state* r) {
-    return r->head.load() == r->tail.load();
+    return r->empty() ? 1 : 0;
+}
+
+/**
+ * @brief Wake every consumer blocked on the input ring (exit, drain, purge).
+ */
+static inline void
+input_ring_signal_ready(struct input_ring_state* r) {
+    ring_wake_signal(&r->wake, &r->ready, &r->ready_m);
 }
 
 /**
@@ -94,6 +109,19 @@ input_ring_discard_generation_matches(const struct input_ring_state* r, uint64_t
     return input_ring_discard_generation(r) == generation;
 }
 
+/** Widen kernels for compact rings; same contracts as the DSP simd_widen API. */
+typedef void (*input_ring_widen_u8_fn)(const unsigned char* src, float* dst, uint32_t len);
+typedef void (*input_ring_widen_s16_fn)(const int16_t* src, float* dst, uint32_t len);
+
+/**
+ * @brief Install the kernels compact rings use to widen samples on read.
+ *
+ * The runtime cannot link the DSP library, so the radio frontend installs
+ * widen_u8_to_f32_bias127/widen_s16_to_f32 here before it selects a compact
+ * ring. Process-wide; a NULL kernel falls back to the scalar loop.
+ */
+void input_ring_set_widen_kernels(input_ring_widen_u8_fn u8_fn, input_ring_widen_s16_fn s16_fn);
+
 /**
  * @brief Initialize input ring storage and synchronization primitives.
  *
@@ -103,6 +131,41 @@ input_ring_discard_generation_matches(const struct input_ring_state* r, uint64_t
  */
 int input_ring_init(struct input_ring_state* r, size_t capacity);
 
+/**
+ * @brief Bytes per stored scalar element (4, 1 or 2).
+ */
+static inline size_t
+input_ring_elem_bytes(const struct input_ring_state* r) {
+    if (r && r->format == DSD_IQ_FORMAT_CU8) {
+        return 1U;
+    }
+    if (r && r->format == DSD_IQ_FORMAT_CS16) {
+        return 2U;
+    }
+    return sizeof(float);
+}
+
+/**
+ * @brief Check whether the ring stores native samples instead of float32.
+ */
+static inline int
+input_ring_is_compact(const struct input_ring_state* r) {
+    return (r && (r->format == DSD_IQ_FORMAT_CU8 || r->format == DSD_IQ_FORMAT_CS16)) ? 1 : 0;
+}
+
+/**
+ * @brief Replace the storage of an idle ring with a new capacity and format.
+ *
+ * Only valid while no producer or consumer is running (stream open). Queued
+ * samples are dropped. On failure the ring keeps its previous storage.
+ *
+ * @param r        Initialized input ring.
+ * @param capacity Number of scalar elements in the ring (must be > 0).
+ * @param format   DSD_IQ_FORMAT_CF32, DSD_IQ_FORMAT_CU8 or DSD_IQ_FORMAT_CS16.
+ * @return 0 on success, -1 on invalid args or allocation failure.
+ */
+int input_ring_resize(struct input_ring_state* r, size_t capacity, dsd_iq_sample_format format);
+
 /**
  * @brief Destroy an initialized input ring.
  *
@@ -122,9 +185,23 @@ void input_ring_destroy(struct input_ring_state* r);
  */
 void input_ring_enable_space_notify(struct input_ring_state* r, int enabled);
 
+/**
+ * @brief Set how full the ring must be before a commit wakes the consumer.
+ *
+ * Defaults to 1 (wake on any data). A consumer that always wants a full
+ * block can raise it to that block size to skip partial wakeups; data below
+ * the watermark is still read once the consumer's wait times out.
+ *
+ * @param r     Input ring state.
+ * @param level Fill level in float elements.
+ */
+void input_ring_set_wake_watermark(struct input_ring_state* r, size_t level);
+
 /**
  * @brief Reserve writable regions in the input ring buffer.
  *
+ * Float rings only; a compact ring grants nothing.
+ *
  * @param r          Input ring buffer state.
  * @param min_needed Minimum number of samples needed.
  * @param p1         [out] First writable region pointer.
@@ -135,6 +212,17 @@ void input_ring_enable_space_notify(struct input_ring_state* r, int enabled);
  */
 int input_ring_reserve(struct input_ring_state* r, size_t min_needed, float** p1, size_t* n1, float** p2, size_t* n2);
 
+/**
+ * @brief Reserve writable regions in the ring's storage format.
+ *
+ * Same grant as input_ring_reserve(), but spans point at float, uint8_t or
+ * int16_t storage according to `r->format`. Commit with input_ring_commit().
+ *
+ * @return Total writable elements granted across regions.
+ */
+int input_ring_reserve_raw(struct input_ring_state* r, size_t min_needed, void** p1, size_t* n1, void** p2,
+                           size_t* n2);
+
 /**
  * @brief Commit previously reserved writable regions to the input ring.
  *
@@ -153,12 +241,26 @@ void input_ring_commit(struct input_ring_state* r, size_t produced);
  */
 int input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count);
 
+/**
+ * @brief Read up to max_count samples as float, widening compact storage.
+ *
+ * Blocks like input_ring_read_block(). CU8 is centred on 127.5 and scaled by
+ * 1/127.5; CS16 is scaled by 1/32768. A float ring is copied unchanged.
+ *
+ * @param r         Input ring state.
+ * @param out       Destination for float samples.
+ * @param max_count Maximum number of samples to read.
+ * @return Number of samples read (>=1), 0 if max_count is 0, or -1 on exit.
+ */
+int input_ring_read_convert(struct input_ring_state* r, float* out, size_t max_count);
+
 /**
  * @brief Reserve readable regions in the input ring without copying.
  *
  * Blocks until at least one sample is available, then returns up to
  * @p max_count samples as one or two contiguous spans. The caller owns the
- * returned spans until it calls input_ring_read_commit().
+ * returned spans until it calls input_ring_read_commit(). Float rings only;
+ * a compact ring returns -1.
  *
  * @param r         Input ring state.
  * @param max_count Maximum number of samples to reserve.
@@ -187,8 +289,7 @@ void input_ring_read_commit(struct input_ring_state* r, size_t consumed);
  */
 static inline void
 input_ring_discard_all_consumer(struct input_ring_state* r) {
-    size_t h = r->head.load(std::memory_order_acquire);
-    r->tail.store(h, std::memory_order_release);
+    r->discard_all();
 }
 
 #endif /* DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_INPUT_RING_H_ */
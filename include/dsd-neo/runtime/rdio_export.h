@@ -57,6 +57,16 @@ const char* dsd_rdio_mode_to_string(int mode);
  */
 int dsd_rdio_export_call(const dsd_opts* opts, const Event_History_I* event_struct, const char* wav_path);
 
+/**
+ * As dsd_rdio_export_call(), with the call's event row passed directly.
+ *
+ * @param opts Decoder options with rdio settings.
+ * @param event Event row for this call (the staged row of the slot history), or NULL.
+ * @param wav_path Final renamed WAV file path.
+ * @return 0 when work completed (or mode disabled), -1 on export failure.
+ */
+int dsd_rdio_export_event(const dsd_opts* opts, const Event_History* event, const char* wav_path);
+
 /**
  * Drain queued rdio API uploads and stop the background worker.
  *
@@ -16,16 +16,16 @@
 #include <stdlib.h>
 
 #include <dsd-neo/platform/threading.h>
+#include <dsd-neo/runtime/ring_wake.h>
+#include <dsd-neo/runtime/spsc_ring.h>
 
-struct output_state {
+/* Demodulated output ring; indices and storage live in the spsc_ring base. */
+struct output_state : spsc_ring<float> {
     int rate = 0;
-    float* buffer = nullptr;
-    size_t capacity = 0;
-    std::atomic<size_t> head{0U};
-    std::atomic<size_t> tail{0U};
     dsd_cond_t ready;
     dsd_mutex_t ready_m;
     dsd_cond_t space;
+    struct ring_wake wake;                    /* consumer wakeups; see ring_wake.h */
     std::atomic<uint64_t> write_timeouts{0U}; /* producer waited for space */
     std::atomic<uint64_t> read_timeouts{0U};  /* consumer waited for data */
 };
@@ -38,15 +38,7 @@ struct output_state {
  */
 static inline size_t
 ring_used(const struct output_state* o) {
-    /* Atomics policy: head/tail are atomics. We use default sequential
-       consistency for simplicity. In an SPSC ring, this could be relaxed
-       to acquire/release without changing behavior. */
-    size_t h = o->head.load();
-    size_t t = o->tail.load();
-    if (h >= t) {
-        return h - t;
-    }
-    return o->capacity - t + h;
+    return o->used();
 }
 
 /**
@@ -57,7 +49,7 @@ ring_used(const struct output_state* o) {
  */
 static inline size_t
 ring_free(const struct output_state* o) {
-    return (o->capacity - 1) - ring_used(o);
+    return o->free_space();
 }
 
 /**
@@ -68,8 +60,7 @@ ring_free(const struct output_state* o) {
  */
 static inline int
 ring_is_empty(const struct output_state* o) {
-    /* See atomics note in ring_used() for ordering considerations. */
-    return o->head.load() == o->tail.load();
+    return o->empty() ? 1 : 0;
 }
 
 /**
@@ -79,9 +70,46 @@ ring_is_empty(const struct output_state* o) {
  */
 static inline void
 ring_clear(struct output_state* o) {
-    /* Clearing indices; with relaxed ordering this would be a release store. */
-    o->tail.store(0);
-    o->head.store(0);
+    o->reset();
+}
+
+/**
+ * @brief Wake a consumer blocked on the output ring if the fill level has
+ * reached its wake watermark. Call after advancing head.
+ *
+ * @param o Output ring state.
+ */
+static inline void
+ring_notify_ready(struct output_state* o) {
+    ring_wake_notify(&o->wake, &o->ready, &o->ready_m, ring_used(o));
+}
+
+/**
+ * @brief Wake every consumer blocked on the output ring (exit, drain, purge).
+ *
+ * @param o Output ring state.
+ */
+static inline void
+ring_signal_ready(struct output_state* o) {
+    ring_wake_signal(&o->wake, &o->ready, &o->ready_m);
+}
+
+/**
+ * @brief Block until the output ring has data, a wakeup arrives, or
+ * `timeout_ms` elapses.
+ *
+ * @param o          Output ring state.
+ * @param timeout_ms Upper bound on the sleep.
+ * @return 0 when data is present or a wakeup arrived, non-zero on timeout.
+ */
+static inline int
+ring_wait_ready(struct output_state* o, unsigned int timeout_ms) {
+    uint32_t token = ring_wake_prepare(&o->wake);
+    if (!ring_is_empty(o)) {
+        ring_wake_cancel(&o->wake);
+        return 0;
+    }
+    return ring_wake_wait(&o->wake, &o->ready, &o->ready_m, token, timeout_ms);
 }
 
 /**
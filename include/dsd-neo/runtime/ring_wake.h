@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Consumer wakeup primitive shared by the input and output rings.
+ *
+ * A producer that publishes data calls ring_wake_notify(); when nobody is
+ * waiting this is one atomic load. A consumer that finds its ring empty
+ * registers with ring_wake_prepare(), re-checks the ring, then sleeps in
+ * ring_wake_wait() until a notify lands or the timeout expires. Waiters are
+ * woken as soon as the ring's fill level reaches the configured watermark.
+ *
+ * On Linux the sleep is a private futex on the wake sequence word; elsewhere
+ * it falls back to the ring's existing condition variable and mutex, which
+ * callers pass in on every call.
+ */
+
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_RING_WAKE_H_
+#define DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_RING_WAKE_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <dsd-neo/platform/threading.h>
+
+/** Default bound on one consumer sleep; exit flags are re-polled at this rate. */
+#define RING_WAKE_IDLE_TIMEOUT_MS 100U
+
+struct ring_wake {
+    std::atomic<uint32_t> seq{0U};     /* bumped by every delivered wakeup */
+    std::atomic<int> waiters{0};       /* consumers between prepare and wait */
+    std::atomic<size_t> watermark{1U}; /* fill level that wakes a waiter; 0 acts as 1 */
+};
+
+/**
+ * @brief Set the fill level at which ring_wake_notify() wakes a waiter.
+ *
+ * Data below the watermark is still picked up when the waiter's timeout
+ * expires, so a large watermark trades latency for fewer wakeups.
+ *
+ * @param w     Wake state.
+ * @param level Fill level in ring elements (0 or 1 wakes on any data).
+ */
+void ring_wake_set_watermark(struct ring_wake* w, size_t level);
+
+/**
+ * @brief Producer side: wake a waiter if one is registered and `ready` has
+ * reached the watermark.
+ *
+ * Call after publishing the new head index.
+ *
+ * @param w      Wake state.
+ * @param cond   Ring condition variable (fallback path).
+ * @param mutex  Mutex paired with @p cond.
+ * @param ready  Elements readable after the publish.
+ */
+void ring_wake_notify(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex, size_t ready);
+
+/**
+ * @brief Wake every waiter regardless of fill level.
+ *
+ * For state changes a waiter must observe promptly: shutdown, drain, purge.
+ */
+void ring_wake_signal(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex);
+
+/**
+ * @brief Register as a waiter and return the token for ring_wake_wait().
+ *
+ * The caller must re-check its ring after this call and then either sleep in
+ * ring_wake_wait() or leave with ring_wake_cancel().
+ */
+uint32_t ring_wake_prepare(struct ring_wake* w);
+
+/** @brief Unregister a waiter that found data after ring_wake_prepare(). */
+void ring_wake_cancel(struct ring_wake* w);
+
+/**
+ * @brief Sleep until a wakeup newer than @p token or until the timeout.
+ *
+ * Unregisters the waiter before returning.
+ *
+ * @return 0 when woken, non-zero on timeout.
+ */
+int ring_wake_wait(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex, uint32_t token, unsigned int timeout_ms);
+
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_RING_WAKE_H_ */
@@ -30,6 +30,17 @@ extern "C" {
  */
 void maybe_set_thread_realtime_and_affinity(const char* role);
 
+/**
+ * @brief Per-worker variant for thread pools.
+ *
+ * Same as maybe_set_thread_realtime_and_affinity(), except that roles with a
+ * CPU range (`DSD_NEO_CPU_DSP=N-M`) pin worker `index` to `N + index % (M - N + 1)`.
+ *
+ * @param role Optional role label (e.g. "DSP").
+ * @param index Zero-based worker index within the role.
+ */
+void maybe_set_worker_realtime_and_affinity(const char* role, int index);
+
 #ifdef __cplusplus
 }
 #endif
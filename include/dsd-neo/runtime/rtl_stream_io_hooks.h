@@ -30,6 +30,13 @@ typedef struct {
 void dsd_rtl_stream_io_hooks_set(dsd_rtl_stream_io_hooks hooks);
 
 int dsd_rtl_stream_io_hook_read(dsd_state* state, float* out, size_t count, int* out_got);
+/*
+ * Span read for consumers that pull many samples at once. Serves whatever
+ * getSymbol() already holds in the state's RTL symbol cache before going back
+ * to the stream, so it interleaves safely with getSymbol(). Returns 0 with
+ * `*out_got` >= 1 on success, <0 on shutdown/error.
+ */
+int dsd_rtl_stream_io_hook_read_block(dsd_state* state, float* out, size_t count, int* out_got);
 double dsd_rtl_stream_io_hook_return_pwr(const dsd_state* state);
 
 #ifdef __cplusplus
@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Lock-free single-producer/single-consumer ring index core.
+ *
+ * Shared by the IQ input ring and the demodulated output ring. The producer
+ * owns `head`, the consumer owns `tail`, and each lives on its own cache line
+ * next to the owner's cached copy of the other side's index. A side only
+ * reloads the remote index when its cached view cannot satisfy a request, so
+ * a steady stream of bulk reserve/commit calls touches the shared line about
+ * once per block instead of once per call.
+ *
+ * One slot always stays empty so `head == tail` means empty. Storage is not
+ * owned here; the embedding ring allocates `buffer` and sets `capacity`.
+ *
+ * reset() may run from a third thread (retune purges, test seeding). It
+ * bumps `reset_epoch`, which both sides check before trusting their cached
+ * remote index.
+ */
+
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_SPSC_RING_H_
+#define DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_SPSC_RING_H_
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <dsd-neo/core/safe_api.h>
+
+/** Cache line size assumed when separating producer and consumer indices. */
+#define DSD_SPSC_CACHE_LINE 64
+
+template <typename T>
+struct spsc_ring {
+    T* buffer = nullptr;
+    size_t capacity = 0U; /* in elements */
+    std::atomic<uint32_t> reset_epoch{0U};
+
+    /* Producer line. */
+    alignas(DSD_SPSC_CACHE_LINE) std::atomic<size_t> head{0U};
+    size_t tail_cache = 0U;
+    uint32_t tail_cache_epoch = 0U;
+
+    /* Consumer line. */
+    alignas(DSD_SPSC_CACHE_LINE) std::atomic<size_t> tail{0U};
+    size_t head_cache = 0U;
+    uint32_t head_cache_epoch = 0U;
+
+    /** Elements between t and h. */
+    size_t
+    distance(size_t h, size_t t) const {
+        return (h >= t) ? (h - t) : (capacity - t + h);
+    }
+
+    size_t
+    advance(size_t i, size_t n) const {
+        i += n;
+        return (i >= capacity) ? (i - capacity) : i;
+    }
+
+    /** Split `grant` slots starting at `at` into the spans before and after the wrap. */
+    size_t
+    split_span(size_t at, size_t grant, size_t* start, size_t* n1, size_t* n2) const {
+        size_t to_end = capacity - at;
+        *start = at;
+        *n1 = (to_end >= grant) ? grant : to_end;
+        *n2 = grant - *n1;
+        return grant;
+    }
+
+    /**
+     * Queued elements as seen by an outside observer. Sequentially consistent
+     * so the consumer's re-check after registering with ring_wake cannot miss
+     * a producer publish.
+     */
+    size_t
+    used() const {
+        size_t h = head.load();
+        size_t t = tail.load();
+        return distance(h, t);
+    }
+
+    size_t
+    free_space() const {
+        return (capacity - 1U) - used();
+    }
+
+    bool
+    empty() const {
+        return head.load() == tail.load();
+    }
+
+    /**
+     * Set both indices. Only for moments when neither side is mid-operation
+     * or when the caller tolerates a racing reader (purges are followed by a
+     * generation bump the readers already check).
+     */
+    void
+    reset(size_t h = 0U, size_t t = 0U) {
+        tail.store(t);
+        head.store(h);
+        reset_epoch.fetch_add(1U, std::memory_order_release);
+    }
+
+    /* ----- producer side ----- */
+
+    /** Writable elements, refreshing the cached tail only when below `want`. */
+    size_t
+    write_space(size_t want) {
+        uint32_t epoch = reset_epoch.load(std::memory_order_acquire);
+        size_t h = head.load(std::memory_order_relaxed);
+        if (epoch != tail_cache_epoch) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            tail_cache_epoch = epoch;
+        }
+        size_t space = (capacity - 1U) - distance(h, tail_cache);
+        if (space < want) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            space = (capacity - 1U) - distance(h, tail_cache);
+        }
+        return space;
+    }
+
+    /**
+     * Grant up to `want` writable elements as one or two spans starting at
+     * head. Nothing is visible to the consumer until write_commit().
+     */
+    size_t
+    write_reserve(size_t want, T** p1, size_t* n1, T** p2, size_t* n2) {
+        size_t start = 0U;
+        size_t grant = write_reserve_index(want, &start, n1, n2);
+        *p1 = (*n1 > 0U) ? buffer + start : nullptr;
+        *p2 = (*n2 > 0U) ? buffer : nullptr;
+        return grant;
+    }
+
+    /**
+     * write_reserve() in slot indices: the first span starts at `*start`,
+     * the second (if any) at slot 0. For embedders whose storage is not T.
+     */
+    size_t
+    write_reserve_index(size_t want, size_t* start, size_t* n1, size_t* n2) {
+        *start = 0U;
+        *n1 = 0U;
+        *n2 = 0U;
+        if (capacity == 0U) {
+            return 0U;
+        }
+        size_t space = write_space(want);
+        size_t grant = (want < space) ? want : space;
+        if (grant == 0U) {
+            return 0U;
+        }
+        return split_span(head.load(std::memory_order_relaxed), grant, start, n1, n2);
+    }
+
+    /**
+     * Publish `n` reserved elements. The store is sequentially consistent:
+     * ring_wake_notify() loads the waiter count right after it.
+     */
+    void
+    write_commit(size_t n) {
+        if (n == 0U) {
+            return;
+        }
+        head.store(advance(head.load(std::memory_order_relaxed), n));
+    }
+
+    /** Copy up to `n` elements in and publish them; returns the count written. */
+    size_t
+    write(const T* src, size_t n) {
+        T* p1;
+        T* p2;
+        size_t n1;
+        size_t n2;
+        size_t got = write_reserve(n, &p1, &n1, &p2, &n2);
+        if (got == 0U) {
+            return 0U;
+        }
+        DSD_MEMCPY(p1, src, n1 * sizeof(T));
+        if (n2 > 0U) {
+            DSD_MEMCPY(p2, src + n1, n2 * sizeof(T));
+        }
+        write_commit(got);
+        return got;
+    }
+
+    /* ----- consumer side ----- */
+
+    /** Readable elements, refreshing the cached head only when below `want`. */
+    size_t
+    read_space(size_t want) {
+        uint32_t epoch = reset_epoch.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (epoch != head_cache_epoch) {
+            head_cache = head.load(std::memory_order_acquire);
+            head_cache_epoch = epoch;
+        }
+        size_t avail = distance(head_cache, t);
+        if (avail < want) {
+            head_cache = head.load(std::memory_order_acquire);
+            avail = distance(head_cache, t);
+        }
+        return avail;
+    }
+
+    /** Expose up to `want` readable elements as one or two spans at tail. */
+    size_t
+    read_reserve(size_t want, T** p1, size_t* n1, T** p2, size_t* n2) {
+        size_t start = 0U;
+        size_t grant = read_reserve_index(want, &start, n1, n2);
+        *p1 = (*n1 > 0U) ? buffer + start : nullptr;
+        *p2 = (*n2 > 0U) ? buffer : nullptr;
+        return grant;
+    }
+
+    /** read_reserve() in slot indices; see write_reserve_index(). */
+    size_t
+    read_reserve_index(size_t want, size_t* start, size_t* n1, size_t* n2) {
+        *start = 0U;
+        *n1 = 0U;
+        *n2 = 0U;
+        if (capacity == 0U) {
+            return 0U;
+        }
+        size_t avail = read_space(want);
+        size_t grant = (want < avail) ? want : avail;
+        if (grant == 0U) {
+            return 0U;
+        }
+        return split_span(tail.load(std::memory_order_relaxed), grant, start, n1, n2);
+    }
+
+    /** Release `n` consumed elements back to the producer. */
+    void
+    read_commit(size_t n) {
+        if (n == 0U) {
+            return;
+        }
+        tail.store(advance(tail.load(std::memory_order_relaxed), n), std::memory_order_release);
+    }
+
+    /** Copy up to `n` elements out and release them; returns the count read. */
+    size_t
+    read(T* dst, size_t n) {
+        T* p1;
+        T* p2;
+        size_t n1;
+        size_t n2;
+        size_t got = read_reserve(n, &p1, &n1, &p2, &n2);
+        if (got == 0U) {
+            return 0U;
+        }
+        DSD_MEMCPY(dst, p1, n1 * sizeof(T));
+        if (n2 > 0U) {
+            DSD_MEMCPY(dst + n1, p2, n2 * sizeof(T));
+        }
+        read_commit(got);
+        return got;
+    }
+
+    /** Consumer-side purge: drop everything published so far. */
+    void
+    discard_all() {
+        head_cache = head.load(std::memory_order_acquire);
+        tail.store(head_cache, std::memory_order_release);
+    }
+};
+
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_SPSC_RING_H_ */
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Runtime hook table for playing out an ended call's queued vocoder frames.
+ *
+ * The call event layer should not depend on the MBE decode path directly. The
+ * engine installs real hook functions at startup; the runtime provides safe
+ * wrappers that no-op when hooks are not installed.
+ */
+#ifndef DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_VOCODER_DRAIN_HOOKS_H_
+#define DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_VOCODER_DRAIN_HOOKS_H_
+
+#include <dsd-neo/core/opts_fwd.h>
+#include <dsd-neo/core/state_fwd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int (*pending)(const dsd_state* state, int slot);
+    void (*drain)(dsd_opts* opts, dsd_state* state, int slot);
+} dsd_vocoder_drain_hooks;
+
+void dsd_vocoder_drain_hooks_set(dsd_vocoder_drain_hooks hooks);
+
+/** Frames still queued on a slot's vocoder lane; 0 when no hook is installed. */
+int dsd_vocoder_drain_hook_pending(const dsd_state* state, int slot);
+void dsd_vocoder_drain_hook_drain(dsd_opts* opts, dsd_state* state, int slot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSD_NEO_INCLUDE_DSD_NEO_RUNTIME_VOCODER_DRAIN_HOOKS_H_ */
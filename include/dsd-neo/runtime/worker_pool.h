@@ -5,10 +5,13 @@
 
 /**
  * @file
- * @brief Minimal 2-thread worker pool API for intra-block demodulation tasks.
+ * @brief Shared work-stealing DSP task pool.
  *
- * Exposes functions keyed by `demod_state*` to initialize/destroy a tiny
- * env-gated pool and to run up to two tasks in parallel per processing block.
+ * One process-wide pool of N workers (`DSD_NEO_MT=1`, sized by
+ * `DSD_NEO_MT_WORKERS`) serves every demodulator pipeline and any other
+ * owner that acquires it. Each worker owns a deque; idle workers steal from
+ * the others. The `demod_mt_*` entry points keep their historical shape and
+ * map onto the shared pool.
  */
 
 #ifndef RUNTIME_WORKER_POOL_H
@@ -28,34 +31,73 @@ typedef struct demod_mt_task {
     void* arg;
 } demod_mt_task;
 
-/* Minimal 2-thread worker pool API, enabled by DSD_NEO_MT. */
+/* Shared pool, enabled by DSD_NEO_MT. */
 
 /**
- * @brief Initialize the minimal worker pool when `DSD_NEO_MT=1`.
+ * @brief Register `owner` as a user of the shared pool, starting it if needed.
+ *
+ * Idempotent per owner. The pool stays up until the last owner releases it.
+ * @param owner Any stable address identifying the user.
+ * @return Worker count, or 0 when multithreading is disabled or startup failed.
+ */
+int dsp_pool_acquire(const void* owner);
+
+/**
+ * @brief Drop `owner`'s reference; the last release joins the workers.
+ *
+ * Safe no-op for unknown owners. Must not be called from a pool task.
+ * @param owner Address previously passed to dsp_pool_acquire().
+ */
+void dsp_pool_release(const void* owner);
+
+/** @brief Worker count of the running pool, or 0 when it is not running. */
+int dsp_pool_size(void);
+
+/**
+ * @brief Run `count` tasks on the pool and wait for all of them.
+ *
+ * Tasks with a NULL `run` are skipped. Runs them in order on the caller when
+ * the pool is not running. A pool worker that calls this queues the tasks on
+ * its own deque and executes pool work while it waits, so nested fork-join
+ * from inside a task cannot deadlock.
+ * @param tasks Task array.
+ * @param count Number of entries in `tasks`.
+ */
+void dsp_pool_run(const demod_mt_task* tasks, int count);
+
+/**
+ * @brief Queue one detached task.
+ *
+ * The task runs before the pool shuts down. Runs inline on the caller when
+ * the pool is not running.
+ * @param task Task to queue.
+ */
+void dsp_pool_post(demod_mt_task task);
+
+/**
+ * @brief Attach a demodulator to the shared pool when `DSD_NEO_MT=1`.
  *
  * Safe to call multiple times per demodulator instance.
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state used as the pool owner.
  * @note No-op when multithreading is disabled via environment.
  */
 void demod_mt_init(struct demod_state* s);
 
 /**
- * @brief Tear down worker threads created by `demod_mt_init`.
+ * @brief Detach a demodulator from the shared pool.
  *
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state used as the pool owner.
  * @note Safe no-op if the pool was never enabled/initialized.
  */
 void demod_mt_destroy(struct demod_state* s);
 
 /**
- * @brief Post up to two tasks and wait for completion.
+ * @brief Run up to two tasks on the shared pool and wait for completion.
  *
  * Runs synchronously in the caller thread when the pool is disabled.
- * @param s Demodulator state key for the worker context.
- * @param f0 Function pointer for the first task (may be NULL).
- * @param a0 Argument for the first task.
- * @param f1 Function pointer for the second task (may be NULL).
- * @param a1 Argument for the second task.
+ * @param s Demodulator state (kept for API compatibility).
+ * @param task0 First task (`run` may be NULL).
+ * @param task1 Second task (`run` may be NULL).
  */
 void demod_mt_run_two_impl(struct demod_state* s, demod_mt_task task0, demod_mt_task task1);
 
@@ -23,6 +23,7 @@
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/core/talkgroup_policy.h>
 #include <dsd-neo/core/time_format.h>
+#include <dsd-neo/crypto/aes.h>
 #include <dsd-neo/crypto/dmr_keystream.h>
 #include <dsd-neo/dsp/frame_sync.h>
 #include <dsd-neo/engine/frame_processing.h>
@@ -338,6 +339,13 @@ ui_cmd_apply_handler_table(const struct dsd_app_command_handler_entry* entries,
     return 0;
 }
 
+/* Key material changed: re-verify locked-out targets and drop AES schedules expanded from the old keys. */
+static void
+ui_cmd_note_key_material_change(dsd_state* state) {
+    dsd_enc_lockout_bump_key_epoch(state);
+    dsd_aes_key_cache_flush();
+}
+
 static void
 ui_cmd_reset_key_mute_state(dsd_opts* opts, dsd_state* state) {
     if (!opts || !state) {
@@ -349,7 +357,7 @@ ui_cmd_reset_key_mute_state(dsd_opts* opts, dsd_state* state) {
     // Every direct key mutation funnels through here: invalidate the
     // encrypted-target lockout ledger so each locked target re-verifies once
     // against the new key material.
-    dsd_enc_lockout_bump_key_epoch(state);
+    ui_cmd_note_key_material_change(state);
 }
 
 static int
@@ -506,7 +514,7 @@ apply_cmd_key_management_stream_keys(const dsd_opts* opts, dsd_state* state, con
             char s[256];
             if (ui_cmd_copy_payload_string(c, s, entries[i].payload_cap)) {
                 entries[i].fn(state, s, opts->show_keys);
-                dsd_enc_lockout_bump_key_epoch(state);
+                ui_cmd_note_key_material_change(state);
             }
             return 1;
         }
@@ -1519,7 +1527,7 @@ ui_cmd_handle_import_keys_dec(dsd_opts* opts, dsd_state* state, const struct dsd
             int rc = svc_import_keys_dec(opts, state, path);
             result = ui_cmd_apply_status_from_service_rc(rc);
             if (rc == 0) {
-                dsd_enc_lockout_bump_key_epoch(state);
+                ui_cmd_note_key_material_change(state);
                 ui_set_toast(state, 3, "Applied: Keys (DEC) imported -> %s", path);
             } else {
                 ui_set_toast(state, 4, "Failed: Keys (DEC) import -> %s", path);
@@ -1538,7 +1546,7 @@ ui_cmd_handle_import_keys_hex(dsd_opts* opts, dsd_state* state, const struct dsd
             int rc = svc_import_keys_hex(opts, state, path);
             result = ui_cmd_apply_status_from_service_rc(rc);
             if (rc == 0) {
-                dsd_enc_lockout_bump_key_epoch(state);
+                ui_cmd_note_key_material_change(state);
                 ui_set_toast(state, 3, "Applied: Keys (HEX) imported -> %s", path);
             } else {
                 ui_set_toast(state, 4, "Failed: Keys (HEX) import -> %s", path);
@@ -1589,7 +1597,7 @@ ui_cmd_handle_import_keys_clear(dsd_opts* opts, dsd_state* state, const struct d
         // The lockout ledger is keyed on the key epoch, so targets skipped for
         // want of a key have to be reconsidered against the empty keyring the
         // same way they are against a newly imported one.
-        dsd_enc_lockout_bump_key_epoch(state);
+        ui_cmd_note_key_material_change(state);
         ui_set_toast(state, 3, "Applied: Keys cleared");
     } else {
         ui_set_toast(state, 4, "Failed: Keys clear");
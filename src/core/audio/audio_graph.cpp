@@ -0,0 +1,666 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * N-stream voice audio graph.
+ *
+ * Every stream slot cycles FREE -> OPEN -> DRAINING -> RETIRING -> FREE. The
+ * producer side (under ctl_m) claims FREE slots, feeds OPEN ones and moves
+ * them to DRAINING; it may also pull a DRAINING slot back to OPEN. The mixer
+ * owns the DRAINING -> RETIRING -> FREE leg, and both contested transitions
+ * out of DRAINING are compare-exchanges, so a stream is either reopened or
+ * retired, never both. A slot's key, gains and sink are written by the
+ * producer before the release store that publishes it as OPEN.
+ *
+ * Blocks reach the mixer through one SPSC ring per slot. The mixer empties
+ * the ring before freeing a slot, so a reclaimed slot starts empty.
+ *
+ * Nothing is dropped for lack of room. A producer that finds its ring full
+ * waits on space_cv, which the mixer thread signals after each period; a
+ * caller-mixed graph runs a mixer period in submit instead.
+ */
+
+#include <atomic>
+#include <dsd-neo/core/audio.h>
+#include <dsd-neo/core/audio_graph.h>
+#include <dsd-neo/platform/audio.h>
+#include <dsd-neo/platform/sockets.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/mem.h>
+#include <dsd-neo/runtime/spsc_ring.h>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#if !DSD_PLATFORM_WIN_NATIVE
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+#include "dsd-neo/core/safe_api.h"
+#include "dsd-neo/platform/platform.h"
+
+namespace {
+
+enum GraphStreamPhase { STREAM_FREE = 0, STREAM_OPEN = 1, STREAM_DRAINING = 2, STREAM_RETIRING = 3 };
+
+struct AudioBlock {
+    float s[DSD_AUDIO_GRAPH_BLOCK];
+};
+
+struct GraphStream {
+    spsc_ring<AudioBlock> queue;
+    AudioBlock storage[DSD_AUDIO_GRAPH_QUEUE_BLOCKS];
+    std::atomic<int> phase{STREAM_FREE};
+    std::atomic<float> gain{1.0f};   /* mono mix and sink */
+    std::atomic<float> gain_l{1.0f}; /* stereo mix, pan applied */
+    std::atomic<float> gain_r{1.0f};
+    dsd_audio_sink sink = {};
+    /* Producer side. */
+    uint64_t key = 0;
+    uint64_t last_input = 0; /* mixer period of the newest submit */
+    /* Mixer side. */
+    int playing = 0;
+};
+
+std::mutex g_audio_output_mutex;
+
+void
+sink_close(dsd_audio_sink* sink) {
+    if (sink->close) {
+        sink->close(sink->ctx);
+    }
+    sink->write = nullptr;
+    sink->close = nullptr;
+    sink->ctx = nullptr;
+}
+
+} // namespace
+
+struct dsd_audio_graph {
+    GraphStream streams[DSD_AUDIO_GRAPH_MAX_STREAMS];
+    dsd_audio_graph_config cfg = {};
+    dsd_mutex_t ctl_m;
+    dsd_cond_t space_cv; /* with ctl_m: a mixer period has run */
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> periods{0};
+    std::atomic<uint64_t> mixed_blocks{0};
+    std::atomic<uint64_t> underruns{0};
+    std::atomic<uint64_t> full_waits{0};
+    dsd_thread_t thread = {};
+    int started = 0;
+    /* Mixer scratch. */
+    alignas(16) float mix_l[DSD_AUDIO_GRAPH_BLOCK];
+    alignas(16) float mix_r[DSD_AUDIO_GRAPH_BLOCK];
+    alignas(16) float stream_out[DSD_AUDIO_GRAPH_BLOCK];
+    alignas(16) float master_out[2 * DSD_AUDIO_GRAPH_BLOCK];
+};
+
+void
+dsd_audio_stream_params_default(dsd_audio_stream_params* params) {
+    if (!params) {
+        return;
+    }
+    DSD_MEMSET(params, 0, sizeof(*params));
+    params->gain = 1.0f;
+}
+
+static void
+graph_stream_set_gain(GraphStream* st, float gain, float pan) {
+    if (pan < -1.0f) {
+        pan = -1.0f;
+    } else if (pan > 1.0f) {
+        pan = 1.0f;
+    }
+    st->gain.store(gain, std::memory_order_relaxed);
+    st->gain_l.store(pan > 0.0f ? gain * (1.0f - pan) : gain, std::memory_order_relaxed);
+    st->gain_r.store(pan < 0.0f ? gain * (1.0f + pan) : gain, std::memory_order_relaxed);
+}
+
+/* Producer side, ctl_m held: the OPEN or DRAINING stream for key, reopening it if draining. */
+static GraphStream*
+graph_find_stream(dsd_audio_graph* g, uint64_t key) {
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        GraphStream* st = &g->streams[i];
+        if (st->key != key) {
+            continue;
+        }
+        int phase = st->phase.load(std::memory_order_acquire);
+        if (phase == STREAM_OPEN) {
+            return st;
+        }
+        if (phase == STREAM_DRAINING && st->phase.compare_exchange_strong(phase, STREAM_OPEN)) {
+            return st;
+        }
+    }
+    return nullptr;
+}
+
+/* Producer side, ctl_m held: close streams that have gone quiet. */
+static void
+graph_sweep_idle(dsd_audio_graph* g) {
+    if (g->cfg.idle_blocks <= 0) {
+        return;
+    }
+    const uint64_t now = g->periods.load(std::memory_order_relaxed);
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        GraphStream* st = &g->streams[i];
+        if (st->phase.load(std::memory_order_relaxed) == STREAM_OPEN
+            && now - st->last_input > (uint64_t)g->cfg.idle_blocks) {
+            int phase = STREAM_OPEN;
+            (void)st->phase.compare_exchange_strong(phase, STREAM_DRAINING);
+        }
+    }
+}
+
+/* Producer side, ctl_m held: claim a free slot; takes ownership of params->sink. */
+static GraphStream*
+graph_claim_stream(dsd_audio_graph* g, uint64_t key, const dsd_audio_stream_params* params) {
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        GraphStream* st = &g->streams[i];
+        if (st->phase.load(std::memory_order_acquire) != STREAM_FREE) {
+            continue;
+        }
+        st->key = key;
+        st->last_input = g->periods.load(std::memory_order_relaxed);
+        st->sink = params->sink;
+        graph_stream_set_gain(st, params->gain, params->pan);
+        st->phase.store(STREAM_OPEN, std::memory_order_release);
+        return st;
+    }
+    return nullptr;
+}
+
+/* Mixer side: hand a drained stream's slot back unless the producer reopened it. */
+static void
+graph_retire_stream(GraphStream* st) {
+    int phase = STREAM_DRAINING;
+    if (!st->phase.compare_exchange_strong(phase, STREAM_RETIRING)) {
+        return;
+    }
+    /* A reopen/submit/close between our empty read and the exchange can leave a block behind. */
+    st->queue.discard_all();
+    sink_close(&st->sink);
+    st->playing = 0;
+    st->phase.store(STREAM_FREE, std::memory_order_release);
+}
+
+int
+dsd_audio_graph_mix_block(dsd_audio_graph* g) {
+    if (!g) {
+        return 0;
+    }
+    const int stereo = g->cfg.channels == 2;
+    const size_t jitter = (size_t)g->cfg.jitter_blocks;
+    int active = 0;
+    DSD_MEMSET(g->mix_l, 0, sizeof(g->mix_l));
+    DSD_MEMSET(g->mix_r, 0, sizeof(g->mix_r));
+
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        GraphStream* st = &g->streams[i];
+        const int phase = st->phase.load(std::memory_order_acquire);
+        if (phase != STREAM_OPEN && phase != STREAM_DRAINING) {
+            continue;
+        }
+        if (!st->playing) {
+            const size_t queued = st->queue.used();
+            if (queued >= jitter || (phase == STREAM_DRAINING && queued > 0U)) {
+                st->playing = 1;
+            } else {
+                if (phase == STREAM_DRAINING) {
+                    graph_retire_stream(st);
+                }
+                continue;
+            }
+        }
+        AudioBlock* p1 = nullptr;
+        AudioBlock* p2 = nullptr;
+        size_t n1 = 0U;
+        size_t n2 = 0U;
+        if (st->queue.read_reserve(1U, &p1, &n1, &p2, &n2) == 0U) {
+            st->playing = 0;
+            if (phase == STREAM_DRAINING) {
+                graph_retire_stream(st);
+            } else {
+                g->underruns.fetch_add(1U, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        const float* block = p1->s;
+        if (st->sink.write) {
+            DSD_MEMSET(g->stream_out, 0, sizeof(g->stream_out));
+            audio_mix_accumulate_f32(g->stream_out, block, DSD_AUDIO_GRAPH_BLOCK,
+                                     st->gain.load(std::memory_order_relaxed));
+            st->sink.write(st->sink.ctx, g->stream_out, DSD_AUDIO_GRAPH_BLOCK, 1);
+        }
+        if (stereo) {
+            audio_mix_accumulate_f32(g->mix_l, block, DSD_AUDIO_GRAPH_BLOCK,
+                                     st->gain_l.load(std::memory_order_relaxed));
+            audio_mix_accumulate_f32(g->mix_r, block, DSD_AUDIO_GRAPH_BLOCK,
+                                     st->gain_r.load(std::memory_order_relaxed));
+        } else {
+            audio_mix_accumulate_f32(g->mix_l, block, DSD_AUDIO_GRAPH_BLOCK, st->gain.load(std::memory_order_relaxed));
+        }
+        st->queue.read_commit(1U);
+        active++;
+    }
+
+    if (active > 0) {
+        audio_clip_f32(g->mix_l, DSD_AUDIO_GRAPH_BLOCK);
+        const float* out = g->mix_l;
+        if (stereo) {
+            audio_clip_f32(g->mix_r, DSD_AUDIO_GRAPH_BLOCK);
+            audio_mix_interleave_stereo_f32(g->mix_l, g->mix_r, DSD_AUDIO_GRAPH_BLOCK, 0, 0, g->master_out);
+            out = g->master_out;
+        }
+        if (g->cfg.master.write) {
+            g->cfg.master.write(g->cfg.master.ctx, out, DSD_AUDIO_GRAPH_BLOCK, g->cfg.channels);
+        }
+        g->mixed_blocks.fetch_add(1U, std::memory_order_relaxed);
+    }
+    g->periods.fetch_add(1U, std::memory_order_relaxed);
+    return active;
+}
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    audio_graph_mixer_thread(void* arg) {
+    dsd_audio_graph* g = static_cast<dsd_audio_graph*>(arg);
+    const uint64_t period_ns = (uint64_t)DSD_AUDIO_GRAPH_BLOCK * 1000000000ULL / (uint64_t)g->cfg.sample_rate;
+    uint64_t next = dsd_time_monotonic_ns() + period_ns;
+    while (!g->stop.load(std::memory_order_acquire)) {
+        uint64_t now = dsd_time_monotonic_ns();
+        if (now < next) {
+            dsd_sleep_ns(next - now);
+            continue;
+        }
+        (void)dsd_audio_graph_mix_block(g);
+        dsd_mutex_lock(&g->ctl_m);
+        dsd_cond_broadcast(&g->space_cv);
+        dsd_mutex_unlock(&g->ctl_m);
+        next += period_ns;
+        /* After a stall (suspend, debugger) restart the clock instead of mixing a burst. */
+        if (now > next + 4U * period_ns) {
+            next = now + period_ns;
+        }
+    }
+    DSD_THREAD_RETURN;
+}
+
+static void
+audio_graph_free(dsd_audio_graph* g) {
+    if (g->started) {
+        dsd_mutex_lock(&g->ctl_m);
+        g->stop.store(true, std::memory_order_release);
+        dsd_cond_broadcast(&g->space_cv);
+        dsd_mutex_unlock(&g->ctl_m);
+        (void)dsd_thread_join(g->thread);
+        g->started = 0;
+    }
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        sink_close(&g->streams[i].sink);
+    }
+    sink_close(&g->cfg.master);
+    (void)dsd_cond_destroy(&g->space_cv);
+    (void)dsd_mutex_destroy(&g->ctl_m);
+    g->~dsd_audio_graph();
+    dsd_neo_aligned_free(g);
+}
+
+dsd_audio_graph*
+dsd_audio_graph_create(const dsd_audio_graph_config* cfg) {
+    if (!cfg) {
+        return nullptr;
+    }
+    dsd_audio_sink master = cfg->master;
+    if ((cfg->channels != 1 && cfg->channels != 2) || cfg->jitter_blocks < 1
+        || cfg->jitter_blocks >= DSD_AUDIO_GRAPH_QUEUE_BLOCKS) {
+        sink_close(&master);
+        return nullptr;
+    }
+    void* mem = dsd_neo_aligned_malloc(sizeof(dsd_audio_graph));
+    if (!mem) {
+        sink_close(&master);
+        return nullptr;
+    }
+    dsd_audio_graph* g = new (mem) dsd_audio_graph;
+    g->cfg = *cfg;
+    if (g->cfg.sample_rate <= 0) {
+        g->cfg.sample_rate = 8000;
+    }
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        g->streams[i].queue.buffer = g->streams[i].storage;
+        g->streams[i].queue.capacity = DSD_AUDIO_GRAPH_QUEUE_BLOCKS;
+    }
+    if (dsd_mutex_init(&g->ctl_m) != 0) {
+        sink_close(&g->cfg.master);
+        g->~dsd_audio_graph();
+        dsd_neo_aligned_free(g);
+        return nullptr;
+    }
+    if (dsd_cond_init(&g->space_cv) != 0) {
+        sink_close(&g->cfg.master);
+        (void)dsd_mutex_destroy(&g->ctl_m);
+        g->~dsd_audio_graph();
+        dsd_neo_aligned_free(g);
+        return nullptr;
+    }
+    if (g->cfg.threaded) {
+        if (dsd_thread_create(&g->thread, audio_graph_mixer_thread, static_cast<void*>(g)) != 0) {
+            DSD_FPRINTF(stderr, "Failed to start audio mixer thread\n");
+            audio_graph_free(g);
+            return nullptr;
+        }
+        g->started = 1;
+    }
+    return g;
+}
+
+void
+dsd_audio_graph_destroy(dsd_audio_graph* g) {
+    if (!g) {
+        return;
+    }
+    audio_graph_free(g);
+}
+
+int
+dsd_audio_graph_open_stream(dsd_audio_graph* g, uint64_t key, const dsd_audio_stream_params* params) {
+    if (!g) {
+        return -1;
+    }
+    dsd_audio_stream_params p;
+    dsd_audio_stream_params_default(&p);
+    if (params) {
+        p = *params;
+    }
+    dsd_mutex_lock(&g->ctl_m);
+    graph_sweep_idle(g);
+    GraphStream* st = graph_find_stream(g, key);
+    if (st) {
+        graph_stream_set_gain(st, p.gain, p.pan);
+        sink_close(&p.sink);
+    } else {
+        st = graph_claim_stream(g, key, &p);
+        if (!st) {
+            sink_close(&p.sink);
+        }
+    }
+    dsd_mutex_unlock(&g->ctl_m);
+    return st ? 0 : -1;
+}
+
+int
+dsd_audio_graph_submit(dsd_audio_graph* g, uint64_t key, const float block[DSD_AUDIO_GRAPH_BLOCK]) {
+    if (!g || !block) {
+        return -1;
+    }
+    dsd_mutex_lock(&g->ctl_m);
+    int rc = -1;
+    int waited = 0;
+    while (!g->stop.load(std::memory_order_acquire)) {
+        /* Look the stream up on every pass: while we wait it may go idle, retire and be reclaimed. */
+        graph_sweep_idle(g);
+        GraphStream* st = graph_find_stream(g, key);
+        if (!st) {
+            dsd_audio_stream_params p;
+            dsd_audio_stream_params_default(&p);
+            st = graph_claim_stream(g, key, &p);
+        }
+        if (!st) {
+            break;
+        }
+        st->last_input = g->periods.load(std::memory_order_relaxed);
+        AudioBlock* p1 = nullptr;
+        AudioBlock* p2 = nullptr;
+        size_t n1 = 0U;
+        size_t n2 = 0U;
+        if (st->queue.write_reserve(1U, &p1, &n1, &p2, &n2) == 1U) {
+            DSD_MEMCPY(p1->s, block, sizeof(p1->s));
+            st->queue.write_commit(1U);
+            rc = 0;
+            break;
+        }
+        if (!waited) {
+            g->full_waits.fetch_add(1U, std::memory_order_relaxed);
+            waited = 1;
+        }
+        /* A full ring is a playing stream, so the next mixer period frees a block. */
+        if (g->started) {
+            (void)dsd_cond_wait(&g->space_cv, &g->ctl_m);
+        } else {
+            (void)dsd_audio_graph_mix_block(g);
+        }
+    }
+    dsd_mutex_unlock(&g->ctl_m);
+    return rc;
+}
+
+void
+dsd_audio_graph_close_stream(dsd_audio_graph* g, uint64_t key) {
+    if (!g) {
+        return;
+    }
+    dsd_mutex_lock(&g->ctl_m);
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        GraphStream* st = &g->streams[i];
+        int phase = STREAM_OPEN;
+        if (st->key == key && st->phase.compare_exchange_strong(phase, STREAM_DRAINING)) {
+            break;
+        }
+    }
+    dsd_mutex_unlock(&g->ctl_m);
+}
+
+void
+dsd_audio_graph_get_stats(dsd_audio_graph* g, dsd_audio_graph_stats* out) {
+    if (!out) {
+        return;
+    }
+    DSD_MEMSET(out, 0, sizeof(*out));
+    if (!g) {
+        return;
+    }
+    out->mixed_blocks = g->mixed_blocks.load(std::memory_order_relaxed);
+    out->underruns = g->underruns.load(std::memory_order_relaxed);
+    out->full_waits = g->full_waits.load(std::memory_order_relaxed);
+    for (int i = 0; i < DSD_AUDIO_GRAPH_MAX_STREAMS; i++) {
+        if (g->streams[i].phase.load(std::memory_order_acquire) != STREAM_FREE) {
+            out->open_streams++;
+        }
+    }
+}
+
+void
+dsd_audio_output_lock(void) {
+    g_audio_output_mutex.lock();
+}
+
+void
+dsd_audio_output_unlock(void) {
+    g_audio_output_mutex.unlock();
+}
+
+/* ---- sinks ---- */
+
+namespace {
+
+struct FileSink {
+    FILE* fp;
+    short pcm[2 * DSD_AUDIO_GRAPH_BLOCK];
+};
+
+void
+file_sink_write(void* ctx, const float* samples, size_t frames, int channels) {
+    FileSink* fs = static_cast<FileSink*>(ctx);
+    size_t n = frames * (size_t)channels;
+    if (n > sizeof(fs->pcm) / sizeof(fs->pcm[0])) {
+        n = sizeof(fs->pcm) / sizeof(fs->pcm[0]);
+    }
+    audio_f32_to_s16(samples, n, fs->pcm);
+    /* Raw PCM is little-endian regardless of the host. */
+    unsigned char bytes[sizeof(fs->pcm)];
+    for (size_t i = 0; i < n; i++) {
+        bytes[2 * i] = (unsigned char)((uint16_t)fs->pcm[i] & 0xFFU);
+        bytes[2 * i + 1] = (unsigned char)((uint16_t)fs->pcm[i] >> 8);
+    }
+    (void)fwrite(bytes, 1, 2 * n, fs->fp);
+}
+
+void
+file_sink_close(void* ctx) {
+    FileSink* fs = static_cast<FileSink*>(ctx);
+    (void)fclose(fs->fp);
+    free(fs);
+}
+
+struct UdpSink {
+    dsd_socket_t sock;
+    struct sockaddr_in addr;
+    short pcm[2 * DSD_AUDIO_GRAPH_BLOCK];
+};
+
+void
+udp_sink_write(void* ctx, const float* samples, size_t frames, int channels) {
+    UdpSink* us = static_cast<UdpSink*>(ctx);
+    size_t n = frames * (size_t)channels;
+    if (n > sizeof(us->pcm) / sizeof(us->pcm[0])) {
+        n = sizeof(us->pcm) / sizeof(us->pcm[0]);
+    }
+    audio_f32_to_s16(samples, n, us->pcm);
+    (void)dsd_socket_sendto(us->sock, us->pcm, n * sizeof(us->pcm[0]), 0, (const struct sockaddr*)&us->addr,
+                            (int)sizeof(us->addr));
+}
+
+void
+udp_sink_close(void* ctx) {
+    UdpSink* us = static_cast<UdpSink*>(ctx);
+    (void)dsd_socket_close(us->sock);
+    free(us);
+}
+
+struct DeviceSink {
+    dsd_audio_stream* stream;
+    int channels;
+    float mixed[2 * DSD_AUDIO_GRAPH_BLOCK];
+    short pcm[2 * DSD_AUDIO_GRAPH_BLOCK];
+};
+
+void
+device_sink_write(void* ctx, const float* samples, size_t frames, int channels) {
+    DeviceSink* ds = static_cast<DeviceSink*>(ctx);
+    if (frames > DSD_AUDIO_GRAPH_BLOCK) {
+        frames = DSD_AUDIO_GRAPH_BLOCK;
+    }
+    const float* src = samples;
+    if (channels == 1 && ds->channels == 2) {
+        audio_mono_to_stereo_f32(samples, ds->mixed, frames);
+        src = ds->mixed;
+    } else if (channels == 2 && ds->channels == 1) {
+        for (size_t i = 0; i < frames; i++) {
+            ds->mixed[i] = 0.5f * (samples[2 * i] + samples[2 * i + 1]);
+        }
+        src = ds->mixed;
+    }
+    audio_f32_to_s16(src, frames * (size_t)ds->channels, ds->pcm);
+    (void)dsd_audio_write(ds->stream, ds->pcm, frames);
+}
+
+void
+device_sink_close(void* ctx) {
+    DeviceSink* ds = static_cast<DeviceSink*>(ctx);
+    dsd_audio_close(ds->stream);
+    free(ds);
+}
+
+} // namespace
+
+int
+dsd_audio_sink_open_file(dsd_audio_sink* out, const char* path) {
+    if (!out) {
+        return -1;
+    }
+    DSD_MEMSET(out, 0, sizeof(*out));
+    if (!path) {
+        return -1;
+    }
+    FileSink* fs = static_cast<FileSink*>(calloc(1, sizeof(FileSink)));
+    if (!fs) {
+        return -1;
+    }
+    fs->fp = fopen(path, "wb");
+    if (!fs->fp) {
+        free(fs);
+        return -1;
+    }
+    out->write = file_sink_write;
+    out->close = file_sink_close;
+    out->ctx = fs;
+    return 0;
+}
+
+int
+dsd_audio_sink_open_udp(dsd_audio_sink* out, const char* host, int port) {
+    if (!out) {
+        return -1;
+    }
+    DSD_MEMSET(out, 0, sizeof(*out));
+    if (!host || port <= 0 || port > 65535) {
+        return -1;
+    }
+    UdpSink* us = static_cast<UdpSink*>(calloc(1, sizeof(UdpSink)));
+    if (!us) {
+        return -1;
+    }
+    if (dsd_socket_resolve(host, port, &us->addr) != 0) {
+        free(us);
+        return -1;
+    }
+    us->sock = dsd_socket_create(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (us->sock == DSD_INVALID_SOCKET) {
+        free(us);
+        return -1;
+    }
+    out->write = udp_sink_write;
+    out->close = udp_sink_close;
+    out->ctx = us;
+    return 0;
+}
+
+int
+dsd_audio_sink_open_device(dsd_audio_sink* out, const char* device, int sample_rate, int channels) {
+    if (!out) {
+        return -1;
+    }
+    DSD_MEMSET(out, 0, sizeof(*out));
+    if (channels != 1 && channels != 2) {
+        return -1;
+    }
+    DeviceSink* ds = static_cast<DeviceSink*>(calloc(1, sizeof(DeviceSink)));
+    if (!ds) {
+        return -1;
+    }
+    dsd_audio_params params;
+    DSD_MEMSET(&params, 0, sizeof(params));
+    params.sample_rate = sample_rate > 0 ? sample_rate : 8000;
+    params.channels = channels;
+    params.bits_per_sample = 16;
+    params.device = device;
+    params.app_name = "DSD-neo";
+    params.async_output = 1;
+    ds->stream = dsd_audio_open_output(&params);
+    if (!ds->stream) {
+        free(ds);
+        return -1;
+    }
+    ds->channels = channels;
+    out->write = device_sink_write;
+    out->close = device_sink_close;
+    out->ctx = ds;
+    return 0;
+}
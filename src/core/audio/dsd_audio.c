@@ -21,9 +21,11 @@
 
 #include <dsd-neo/core/audio.h>
 #include <dsd-neo/core/audio_filters.h>
+#include <dsd-neo/core/audio_graph.h>
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/string_utils.h>
+#include <dsd-neo/core/wav_writer.h>
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
 #include <dsd-neo/platform/posix_compat.h>
@@ -99,6 +101,9 @@ dsd_audio_write_wav_short_block(SNDFILE* file, const short* samples, sf_count_t
     if (file == NULL || samples == NULL || sample_count <= 0) {
         return;
     }
+    if (dsd_wav_writer_active() && dsd_wav_writer_write(file, samples, (int64_t)sample_count, context) >= 0) {
+        return;
+    }
     sf_count_t written = sf_write_short(file, samples, sample_count);
     if (written != sample_count) {
         LOG_WARN("%s: wrote %lld/%lld samples to WAV output\n", context, (long long)written, (long long)sample_count);
@@ -225,11 +230,13 @@ dsd_audio_apply_input_sample_rate(dsd_opts* opts, dsd_state* state, int old_effe
 
 void
 closeAudioOutput(dsd_opts* opts) {
-    /* Close primary audio output stream */
+    /* Close primary audio output stream; the audio graph's mixer may be writing to it */
+    dsd_audio_output_lock();
     if (opts->audio_out_stream) {
         dsd_audio_close(opts->audio_out_stream);
         opts->audio_out_stream = NULL;
     }
+    dsd_audio_output_unlock();
     /* Close secondary output stream (slot 2/right) */
     if (opts->audio_out_streamR) {
         dsd_audio_close(opts->audio_out_streamR);
@@ -289,7 +296,10 @@ openAudioOutput(dsd_opts* opts) {
         params.sample_rate = opts->pulse_digi_rate_out;
         params.channels = opts->pulse_digi_out_channels;
         params.bits_per_sample = 16;
-        opts->audio_out_stream = dsd_audio_open_output(&params);
+        dsd_audio_stream* out_stream = dsd_audio_open_output(&params);
+        dsd_audio_output_lock();
+        opts->audio_out_stream = out_stream;
+        dsd_audio_output_unlock();
         if (!opts->audio_out_stream) {
             LOG_ERROR("Failed to open audio output: %s", dsd_audio_get_error());
             if (opts->audio_raw_out) {
@@ -424,6 +434,20 @@ dsd_audio_clamp_pcm16_f32(float sample) {
     return sample;
 }
 
+_Static_assert(sizeof(((dsd_state*)0)->audio_upsample_hist) == (DSD_UPSAMPLE_PHASE_TAPS - 1) * sizeof(float),
+               "upsampler history must match the filter's taps per phase");
+
+/* Clamp a 48 kHz block in place and mirror it to the s16 output and its copy. */
+static void
+dsd_audio_clamp_upsampled_block(float* samples, short* out, short* mirror) {
+    for (int n = 0; n < 960; n++) {
+        const float v = dsd_audio_clamp_pcm16_f32(samples[n]);
+        samples[n] = v;
+        out[n] = (short)v;
+    }
+    DSD_MEMCPY(mirror, out, 960 * sizeof(short));
+}
+
 static float
 dsd_audio_detect_block_peak_left(dsd_state* state) {
     int n;
@@ -516,26 +540,15 @@ dsd_audio_apply_gain_left(const dsd_opts* opts, dsd_state* state, float gaindelt
 
 static void
 dsd_audio_emit_upsampled_left(const dsd_opts* opts, dsd_state* state) {
-    int n;
-
-    state->audio_out_temp_buf_p = state->audio_out_temp_buf;
-    for (n = 0; n < 160; n++) {
-        upsample(state, *state->audio_out_temp_buf_p);
-        state->audio_out_temp_buf_p++;
-        state->audio_out_float_buf_p += 6;
-        state->audio_out_idx += 6;
-        state->audio_out_idx2 += 6;
-    }
-
-    state->audio_out_float_buf_p -= (960 + opts->playoffset);
-    for (n = 0; n < 960; n++) {
-        *state->audio_out_float_buf_p = dsd_audio_clamp_pcm16_f32(*state->audio_out_float_buf_p);
-        *state->audio_out_buf_p = (short)*state->audio_out_float_buf_p;
-        state->s_lu[n] = (short)*state->audio_out_float_buf_p;
-        state->audio_out_buf_p++;
-        state->audio_out_float_buf_p++;
-    }
-    state->audio_out_float_buf_p += opts->playoffset;
+    upsample_block(state->audio_upsample_hist, state->audio_out_temp_buf, 160, state->audio_out_float_buf_p);
+    state->audio_out_temp_buf_p = state->audio_out_temp_buf + 160;
+    state->audio_out_idx += 960;
+    state->audio_out_idx2 += 960;
+
+    dsd_audio_clamp_upsampled_block(state->audio_out_float_buf_p - opts->playoffset, state->audio_out_buf_p,
+                                    state->s_lu);
+    state->audio_out_buf_p += 960;
+    state->audio_out_float_buf_p += 960;
 }
 
 static void
@@ -663,26 +676,15 @@ dsd_audio_apply_gain_right(const dsd_opts* opts, dsd_state* state, float gaindel
 
 static void
 dsd_audio_emit_upsampled_right(const dsd_opts* opts, dsd_state* state) {
-    int n;
-
-    state->audio_out_temp_buf_pR = state->audio_out_temp_bufR;
-    for (n = 0; n < 160; n++) {
-        upsample(state, *state->audio_out_temp_buf_pR);
-        state->audio_out_temp_buf_pR++;
-        state->audio_out_float_buf_pR += 6;
-        state->audio_out_idxR += 6;
-        state->audio_out_idx2R += 6;
-    }
-
-    state->audio_out_float_buf_pR -= (960 + opts->playoffsetR);
-    for (n = 0; n < 960; n++) {
-        *state->audio_out_float_buf_pR = dsd_audio_clamp_pcm16_f32(*state->audio_out_float_buf_pR);
-        *state->audio_out_buf_pR = (short)*state->audio_out_float_buf_pR;
-        state->s_ru[n] = (short)*state->audio_out_float_buf_pR;
-        state->audio_out_buf_pR++;
-        state->audio_out_float_buf_pR++;
-    }
-    state->audio_out_float_buf_pR += opts->playoffsetR;
+    upsample_block(state->audio_upsample_histR, state->audio_out_temp_bufR, 160, state->audio_out_float_buf_pR);
+    state->audio_out_temp_buf_pR = state->audio_out_temp_bufR + 160;
+    state->audio_out_idxR += 960;
+    state->audio_out_idx2R += 960;
+
+    dsd_audio_clamp_upsampled_block(state->audio_out_float_buf_pR - opts->playoffsetR, state->audio_out_buf_pR,
+                                    state->s_ru);
+    state->audio_out_buf_pR += 960;
+    state->audio_out_float_buf_pR += 960;
 }
 
 static void
@@ -13,21 +13,25 @@
 
 #include <dsd-neo/core/audio.h>
 #include <dsd-neo/core/audio_filters.h>
+#include <dsd-neo/core/audio_graph.h>
 #include <dsd-neo/core/call_state.h>
 #include <dsd-neo/core/constants.h>
 #include <dsd-neo/core/file_io.h>
 #include <dsd-neo/core/opts.h>
 #include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
 #include <dsd-neo/protocol/p25/p25_crypto.h>
+#include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 #include <dsd-neo/runtime/udp_audio_hooks.h>
 #include <limits.h>
 #include <math.h>
 #include <mbelib-neo/mbelib.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include "dsd-neo/core/opts_fwd.h"
@@ -176,11 +180,9 @@ dsd_audio_reset_short_lr_working_state(dsd_state* state) {
     dsd_audio_maybe_reset_output_ring_right(state);
 }
 
-DSD_AUDIO2_INTERNAL void
-dsd_output_float_block(dsd_opts* opts, dsd_state* state, const float* samples, size_t frames, int channels) {
-    if (opts->audio_out != 1 || !samples || frames == 0) {
-        return;
-    }
+/* Callers hold dsd_audio_output_lock(). */
+static void
+dsd_write_float_block_locked(dsd_opts* opts, dsd_state* state, const float* samples, size_t frames, int channels) {
     if (opts->audio_out_type == 0) {
         write_float_audio(opts, samples, frames);
     } else if (opts->audio_out_type == 8) {
@@ -190,11 +192,9 @@ dsd_output_float_block(dsd_opts* opts, dsd_state* state, const float* samples, s
     }
 }
 
-DSD_AUDIO2_INTERNAL void
-dsd_output_s16_block(dsd_opts* opts, dsd_state* state, const short* samples, size_t frames, int channels) {
-    if (opts->audio_out != 1 || !samples || frames == 0) {
-        return;
-    }
+/* Callers hold dsd_audio_output_lock(). */
+static void
+dsd_write_s16_block_locked(dsd_opts* opts, dsd_state* state, const short* samples, size_t frames, int channels) {
     if (opts->audio_out_type == 0) {
         write_s16_audio(opts, (const int16_t*)samples, frames);
     } else if (opts->audio_out_type == 8) {
@@ -204,6 +204,26 @@ dsd_output_s16_block(dsd_opts* opts, dsd_state* state, const short* samples, siz
     }
 }
 
+DSD_AUDIO2_INTERNAL void
+dsd_output_float_block(dsd_opts* opts, dsd_state* state, const float* samples, size_t frames, int channels) {
+    if (opts->audio_out != 1 || !samples || frames == 0) {
+        return;
+    }
+    dsd_audio_output_lock();
+    dsd_write_float_block_locked(opts, state, samples, frames, channels);
+    dsd_audio_output_unlock();
+}
+
+DSD_AUDIO2_INTERNAL void
+dsd_output_s16_block(dsd_opts* opts, dsd_state* state, const short* samples, size_t frames, int channels) {
+    if (opts->audio_out != 1 || !samples || frames == 0) {
+        return;
+    }
+    dsd_audio_output_lock();
+    dsd_write_s16_block_locked(opts, state, samples, frames, channels);
+    dsd_audio_output_unlock();
+}
+
 DSD_AUDIO2_INTERNAL void
 dsd_output_float_blocks(dsd_opts* opts, dsd_state* state, const float* const* blocks, size_t block_count, size_t frames,
                         int channels, int skip_silent) {
@@ -228,6 +248,165 @@ dsd_output_s16_blocks(dsd_opts* opts, dsd_state* state, const short* const* bloc
     }
 }
 
+/*
+ * DSD_NEO_AUDIO_GRAPH: the two-slot mixers hand each unmuted slot's blocks to
+ * a graph stream keyed by the slot's call, and the graph's mixer thread
+ * writes the mix to the configured output. Blocks are already gated and
+ * gained here; the graph only buffers, mixes and clips.
+ */
+typedef struct {
+    dsd_audio_graph* graph;
+    dsd_opts* opts;
+    dsd_state* state;
+    int channels;
+    int floating_point;
+    uint64_t slot_key[2]; /* stream each slot fed last, or DSD_AUDIO_GRAPH_NO_KEY */
+} dsd_audio_graph_output;
+
+#define DSD_AUDIO_GRAPH_NO_KEY UINT64_MAX
+/* Blocks queued before a stream plays: absorbs the 60 ms DMR and superframe P25p2 bursts. */
+#define DSD_AUDIO_GRAPH_OUTPUT_JITTER 3
+/* A stream that gets no blocks for a second is closed. */
+#define DSD_AUDIO_GRAPH_OUTPUT_IDLE 50
+
+static void
+dsd_audio_graph_master_write(void* ctx, const float* samples, size_t frames, int channels) {
+    dsd_audio_graph_output* out = (dsd_audio_graph_output*)ctx;
+    if (out->opts->audio_out != 1) {
+        return;
+    }
+    dsd_audio_output_lock();
+    if (out->floating_point) {
+        dsd_write_float_block_locked(out->opts, out->state, samples, frames, channels);
+    } else {
+        short pcm[2 * DSD_AUDIO_GRAPH_BLOCK];
+        size_t n = frames * (size_t)channels;
+        if (n > sizeof(pcm) / sizeof(pcm[0])) {
+            n = sizeof(pcm) / sizeof(pcm[0]);
+        }
+        audio_f32_to_s16(samples, n, pcm);
+        dsd_write_s16_block_locked(out->opts, out->state, pcm, n / (size_t)channels, channels);
+    }
+    dsd_audio_output_unlock();
+}
+
+static void
+dsd_audio_graph_output_free(void* ptr) {
+    dsd_audio_graph_output* out = (dsd_audio_graph_output*)ptr;
+    if (out) {
+        dsd_audio_graph_destroy(out->graph);
+        free(out);
+    }
+}
+
+static int
+dsd_audio_graph_output_start(dsd_audio_graph_output* out, dsd_opts* opts) {
+    dsd_audio_graph_config cfg;
+    DSD_MEMSET(&cfg, 0, sizeof(cfg));
+    cfg.channels = opts->pulse_digi_out_channels == 2 ? 2 : 1;
+    cfg.sample_rate = 8000;
+    cfg.jitter_blocks = DSD_AUDIO_GRAPH_OUTPUT_JITTER;
+    cfg.idle_blocks = DSD_AUDIO_GRAPH_OUTPUT_IDLE;
+    cfg.threaded = 1;
+    cfg.master.write = dsd_audio_graph_master_write;
+    cfg.master.ctx = out;
+    out->channels = cfg.channels;
+    out->floating_point = opts->floating_point ? 1 : 0;
+    out->slot_key[0] = DSD_AUDIO_GRAPH_NO_KEY;
+    out->slot_key[1] = DSD_AUDIO_GRAPH_NO_KEY;
+    out->graph = dsd_audio_graph_create(&cfg);
+    return out->graph ? 0 : -1;
+}
+
+dsd_audio_graph*
+dsd_audio_graph_for_output(dsd_opts* opts, dsd_state* state) {
+    if (!opts || !state) {
+        return NULL;
+    }
+    dsd_audio_graph_output* out =
+        (dsd_audio_graph_output*)dsd_state_ext_get(state, DSD_STATE_EXT_CORE_AUDIO_GRAPH);
+    if (out) {
+        const int channels = opts->pulse_digi_out_channels == 2 ? 2 : 1;
+        if (out->channels == channels && out->floating_point == (opts->floating_point ? 1 : 0)) {
+            return out->graph;
+        }
+        /* Output layout changed: rebuild the mixer for the new one. */
+        dsd_audio_graph_destroy(out->graph);
+        out->graph = NULL;
+        if (dsd_audio_graph_output_start(out, opts) != 0) {
+            dsd_audio_graph_output_stop(state);
+            return NULL;
+        }
+        return out->graph;
+    }
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg || !cfg->audio_graph_enable) {
+        return NULL;
+    }
+    out = (dsd_audio_graph_output*)calloc(1, sizeof(*out));
+    if (!out) {
+        return NULL;
+    }
+    out->opts = opts;
+    out->state = state;
+    if (dsd_audio_graph_output_start(out, opts) != 0) {
+        free(out);
+        return NULL;
+    }
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_CORE_AUDIO_GRAPH, out, dsd_audio_graph_output_free) != 0) {
+        dsd_audio_graph_output_free(out);
+        return NULL;
+    }
+    DSD_FPRINTF(stderr, "Per-call audio graph enabled (DSD_NEO_AUDIO_GRAPH=1), up to %d streams.\n",
+                DSD_AUDIO_GRAPH_MAX_STREAMS);
+    return out->graph;
+}
+
+void
+dsd_audio_graph_output_stop(dsd_state* state) {
+    if (state && dsd_state_ext_get(state, DSD_STATE_EXT_CORE_AUDIO_GRAPH)) {
+        (void)dsd_state_ext_set(state, DSD_STATE_EXT_CORE_AUDIO_GRAPH, NULL, NULL);
+    }
+}
+
+/* Queue one 160-sample slot block on the stream of the slot's current call. */
+static void
+dsd_audio_graph_route_f32(dsd_state* state, int slot, const float* block) {
+    dsd_audio_graph_output* out =
+        (dsd_audio_graph_output*)dsd_state_ext_get(state, DSD_STATE_EXT_CORE_AUDIO_GRAPH);
+    if (!out || !out->graph) {
+        return;
+    }
+    dsd_call_snapshot call;
+    uint64_t epoch = 0U;
+    if (dsd_call_state_get(state, (uint8_t)slot, &call) > 0) {
+        epoch = call.epoch;
+    }
+    /* Call epochs count per slot; without one the slot keeps a stream of its own. */
+    const uint64_t key = (epoch << 1) | (uint64_t)slot;
+    if (out->slot_key[slot] != key) {
+        if (out->slot_key[slot] != DSD_AUDIO_GRAPH_NO_KEY) {
+            dsd_audio_graph_close_stream(out->graph, out->slot_key[slot]);
+        }
+        out->slot_key[slot] = key;
+        /* Keep the slot mixers' separation in stereo: slot 1 calls left, slot 2 calls right. */
+        dsd_audio_stream_params params;
+        dsd_audio_stream_params_default(&params);
+        params.pan = (out->channels == 2) ? (slot ? 1.0f : -1.0f) : 0.0f;
+        (void)dsd_audio_graph_open_stream(out->graph, key, &params);
+    }
+    (void)dsd_audio_graph_submit(out->graph, key, block);
+}
+
+static void
+dsd_audio_graph_route_s16(dsd_state* state, int slot, const short* block) {
+    float f[DSD_AUDIO_GRAPH_BLOCK];
+    for (int i = 0; i < DSD_AUDIO_GRAPH_BLOCK; i++) {
+        f[i] = (float)block[i] / 32768.0f;
+    }
+    dsd_audio_graph_route_f32(state, slot, f);
+}
+
 static void
 dsd_load_short_mono_samples(short* dst, size_t len, const short* current_frame, short** history_ptr) {
     if (len == 160) {
@@ -985,6 +1164,18 @@ playSynthesizedVoiceFS3(dsd_opts* opts, dsd_state* state) {
         goto FS3_END;
     }
 
+    if (dsd_audio_graph_for_output(opts, state)) {
+        for (int j = 0; j < 3; j++) {
+            if (!encL) {
+                dsd_audio_graph_route_f32(state, 0, state->f_l4[j]);
+            }
+            if (!encR) {
+                dsd_audio_graph_route_f32(state, 1, state->f_r4[j]);
+            }
+        }
+        goto FS3_END;
+    }
+
     if (opts->pulse_digi_out_channels == 1) {
         float mono1[160], mono2[160], mono3[160];
         DSD_MEMSET(mono1, 0, sizeof(mono1));
@@ -1057,6 +1248,18 @@ playSynthesizedVoiceFS4(dsd_opts* opts, dsd_state* state) {
         goto END_FS4;
     }
 
+    if (dsd_audio_graph_for_output(opts, state)) {
+        for (int j = 0; j < 4; j++) {
+            if (!encL && l_ok[j]) {
+                dsd_audio_graph_route_f32(state, 0, lf[j]);
+            }
+            if (!encR && r_ok[j]) {
+                dsd_audio_graph_route_f32(state, 1, rf[j]);
+            }
+        }
+        goto END_FS4;
+    }
+
     // If output is mono, mix active channels into one buffer per frame span
     if (opts->pulse_digi_out_channels == 1) {
         float mono[4][160];
@@ -1123,6 +1326,66 @@ playSynthesizedVoiceFM(dsd_opts* opts, dsd_state* state) {
     DSD_MEMSET(state->audio_out_temp_buf, 0.0f, sizeof(state->audio_out_temp_buf));
 }
 
+//one frame left on a slot's vocoder lane when its call ended; the burst mixers above have already run for it
+void
+playSynthesizedVoiceTail(dsd_opts* opts, dsd_state* state, int slot, int right) {
+    float* staged = right ? state->audio_out_temp_bufR : state->audio_out_temp_buf;
+    const int mono = opts->pulse_digi_out_channels == 1;
+
+    if (opts->floating_point == 1) {
+        float samp[160];
+        DSD_MEMCPY(samp, staged, sizeof(samp));
+        agf(opts, state, samp, right);
+        if (dsd_audio_graph_for_output(opts, state)) {
+            dsd_audio_graph_route_f32(state, slot, samp);
+        } else if (mono) {
+            dsd_output_float_block(opts, state, samp, 160, 1);
+        } else {
+            float stereo_samp[320];
+            audio_mono_to_stereo_f32(samp, stereo_samp, 160);
+            dsd_output_float_block(opts, state, stereo_samp, 160, 2);
+        }
+        DSD_MEMSET(staged, 0, 160U * sizeof(*staged));
+        return;
+    }
+
+    short samp[160];
+    for (int i = 0; i < 160; i++) {
+        float v = staged[i];
+        if (v > 32767.0f) {
+            v = 32767.0f;
+        } else if (v < -32768.0f) {
+            v = -32768.0f;
+        }
+        samp[i] = (short)v;
+    }
+    if (opts->use_hpf_d == 1) {
+        if (right) {
+            hpf_dR(state, samp, 160);
+        } else {
+            hpf_dL(state, samp, 160);
+        }
+    }
+    if (dsd_audio_graph_for_output(opts, state)) {
+        dsd_audio_graph_route_s16(state, slot, samp);
+    } else if (mono) {
+        dsd_output_s16_block(opts, state, samp, 160, 1);
+    } else {
+        short stereo_samp[320];
+        audio_mono_to_stereo_s16(samp, stereo_samp, 160);
+        dsd_output_s16_block(opts, state, stereo_samp, 160, 2);
+    }
+    /* processAudio() also queued the frame for the mono short mixer; it has been played here. */
+    if (right) {
+        state->audio_out_idxR = 0;
+        dsd_audio_maybe_reset_output_ring_right(state);
+    } else {
+        state->audio_out_idx = 0;
+        dsd_audio_maybe_reset_output_ring_left(state);
+    }
+    DSD_MEMSET(staged, 0, 160U * sizeof(*staged));
+}
+
 //Mono - Short (SB16LE) - Drop-in replacement for playSyntesizedVoice, but easier to manipulate
 void
 playSynthesizedVoiceMS(dsd_opts* opts, dsd_state* state) {
@@ -1213,7 +1476,16 @@ playSynthesizedVoiceSS3(dsd_opts* opts, dsd_state* state) {
     audio_mix_interleave_stereo_s16(state->s_l4[1], state->s_r4[1], 160, 0, 0, stereo_samp2);
     audio_mix_interleave_stereo_s16(state->s_l4[2], state->s_r4[2], 160, 0, 0, stereo_samp3);
 
-    if (opts->pulse_digi_out_channels == 1) {
+    if (dsd_audio_graph_for_output(opts, state)) {
+        for (int j = 0; j < 3; j++) {
+            if (!encL) {
+                dsd_audio_graph_route_s16(state, 0, state->s_l4[j]);
+            }
+            if (!encR) {
+                dsd_audio_graph_route_s16(state, 1, state->s_r4[j]);
+            }
+        }
+    } else if (opts->pulse_digi_out_channels == 1) {
         short mono1[160], mono2[160], mono3[160];
         int l_on = !encL;
         int r_on = !encR;
@@ -1295,7 +1567,19 @@ playSynthesizedVoiceSS18(dsd_opts* opts, dsd_state* state) {
     }
 
     dsd_interleave_s16_18_blocks(state, stereo_sf);
-    dsd_output_s16_18_blocks(opts, state, stereo_sf, filled_blocks);
+    if (dsd_audio_graph_for_output(opts, state)) {
+        // Each slot's stream takes exactly the blocks its own voice counter filled.
+        for (int j = 0; j < 18; j++) {
+            if (!encL && j < state->voice_counter[0]) {
+                dsd_audio_graph_route_s16(state, 0, state->s_l4[j]);
+            }
+            if (!encR && j < state->voice_counter[1]) {
+                dsd_audio_graph_route_s16(state, 1, state->s_r4[j]);
+            }
+        }
+    } else {
+        dsd_output_s16_18_blocks(opts, state, stereo_sf, filled_blocks);
+    }
     dsd_write_s16_wav_18_blocks(opts, stereo_sf);
 
 SS18_END:
@@ -1,8 +1,8 @@
 // SPDX-License-Identifier: ISC
 /*-------------------------------------------------------------------------------
  * dsd_upsample.c
- * Simplified 8k to 48k Upsample Functions
- * Uses linear interpolation for smooth transitions without ringing.
+ * 8k to 48k voice upsampler
+ * Polyphase windowed-sinc interpolation, one 20 ms frame at a time.
  *
  *
  *
@@ -11,35 +11,54 @@
  *-----------------------------------------------------------------------------*/
 
 #include <dsd-neo/core/audio.h>
-#include <dsd-neo/core/state.h>
+#include <dsd-neo/dsp/simd_fir.h>
 
-#include "dsd-neo/core/state_fwd.h"
+/*
+ * 96-tap Kaiser (beta 6) low-pass at 4 kHz for 48 kHz, split into six
+ * 16-tap branches with each row in window order (oldest input first). Every
+ * branch is normalized to unity DC gain, so a constant input comes out
+ * unchanged. Flat to 3 kHz, -6 dB at 4 kHz, below -70 dB from 5 kHz; the
+ * images of the 8 kHz input are suppressed instead of repeated as the old
+ * sample-and-hold did. Group delay is 47.5 output samples (about 1 ms).
+ */
+static const float upsample_phase_taps[DSD_UPSAMPLE_FACTOR][DSD_UPSAMPLE_PHASE_TAPS] = {
+    {
+        -0.000654067491f, 0.00198338096f, -0.00460154754f, 0.00926876493f, -0.0173760977f, 0.0326207163f,
+        -0.0722400802f, 0.988424491f, 0.086635754f, -0.0365367335f, 0.0192491853f, -0.010326301f,
+        0.00521097795f, -0.0023136676f, 0.000810020745f, -0.000154796105f
+    },
+    {
+        -0.00141893471f, 0.00461340501f, -0.0110603915f, 0.022686883f, -0.0428541819f, 0.0798783947f,
+        -0.168161f, 0.898074767f, 0.292877956f, -0.112373401f, 0.0582848176f, -0.0313809148f,
+        0.0160682061f, -0.00732862147f, 0.0027029154f, -0.0006098997f
+    },
+    {
+        -0.00150717164f, 0.0053230442f, -0.0132356071f, 0.0276995f, -0.0528155919f, 0.0980637424f,
+        -0.198749595f, 0.732542257f, 0.519442801f, -0.173924637f, 0.0883035578f, -0.0476100662f,
+        0.0246932502f, -0.0115406284f, 0.00445607326f, -0.00114092774f
+    },
+    {
+        -0.00114092774f, 0.00445607326f, -0.0115406284f, 0.0246932502f, -0.0476100662f, 0.0883035578f,
+        -0.173924637f, 0.519442801f, 0.732542257f, -0.198749595f, 0.0980637424f, -0.0528155919f,
+        0.0276995f, -0.0132356071f, 0.0053230442f, -0.00150717164f
+    },
+    {
+        -0.0006098997f, 0.0027029154f, -0.00732862147f, 0.0160682061f, -0.0313809148f, 0.0582848176f,
+        -0.112373401f, 0.292877956f, 0.898074767f, -0.168161f, 0.0798783947f, -0.0428541819f,
+        0.022686883f, -0.0110603915f, 0.00461340501f, -0.00141893471f
+    },
+    {
+        -0.000154796105f, 0.000810020745f, -0.0023136676f, 0.00521097795f, -0.010326301f, 0.0192491853f,
+        -0.0365367335f, 0.086635754f, 0.988424491f, -0.0722400802f, 0.0326207163f, -0.0173760977f,
+        0.00926876493f, -0.00460154754f, 0.00198338096f, -0.000654067491f
+    }
+};
 
-// Six-fold sample repetition for the analog-monitor float buffer.
 void
-upsample(dsd_state* state, float invalue) {
-
-    if (!state) {
+upsample_block(float* hist, const float* in, int in_len, float* out) {
+    if (!hist || !in || !out || in_len <= 0) {
         return;
     }
-
-    float* outbuf1 = state->audio_out_float_buf_p;
-    if (state->dmr_stereo == 1) {
-        outbuf1 = (state->currentslot == 1) ? state->audio_out_float_buf_pR : state->audio_out_float_buf_p;
-    }
-    if (!outbuf1) {
-        return; // nothing to write to
-    }
-
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
-    outbuf1++;
-    *outbuf1 = invalue;
+    (void)simd_fir_interp_real(in, in_len, out, hist, &upsample_phase_taps[0][0], DSD_UPSAMPLE_FACTOR,
+                               DSD_UPSAMPLE_PHASE_TAPS);
 }
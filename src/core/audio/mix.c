@@ -8,13 +8,23 @@
  *
  * These helpers encapsulate common slot→stereo/mono mixing patterns so
  * that the higher-level mixers in dsd_audio2.c can delegate the inner
- * loops here.
+ * loops here. The accumulate/clip kernels behind the audio graph's mixer use
+ * SSE2 (baseline on x86-64) or NEON (baseline on AArch64) without runtime
+ * dispatch.
  */
 
 #include <dsd-neo/core/audio.h>
 
 #include <stddef.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSD_AUDIO_MIX_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DSD_AUDIO_MIX_NEON 1
+#include <arm_neon.h>
+#endif
+
 void
 audio_mix_interleave_stereo_f32(const float* left, const float* right, size_t n, int encL, int encR,
                                 float* stereo_out) {
@@ -56,3 +66,75 @@ audio_mix_mono_from_slots_f32(const float* left, const float* right, size_t n, i
         }
     }
 }
+
+void
+audio_mix_accumulate_f32(float* acc, const float* in, size_t n, float gain) {
+    if (!acc || !in) {
+        return;
+    }
+    size_t i = 0;
+#if defined(DSD_AUDIO_MIX_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= n; i += 4) {
+        __m128 a = _mm_loadu_ps(acc + i);
+        a = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(in + i), g));
+        _mm_storeu_ps(acc + i, a);
+    }
+#elif defined(DSD_AUDIO_MIX_NEON)
+    const float32x4_t g = vdupq_n_f32(gain);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t a = vld1q_f32(acc + i);
+        a = vaddq_f32(a, vmulq_f32(vld1q_f32(in + i), g));
+        vst1q_f32(acc + i, a);
+    }
+#endif
+    for (; i < n; i++) {
+        acc[i] = acc[i] + in[i] * gain;
+    }
+}
+
+void
+audio_clip_f32(float* buf, size_t n) {
+    if (!buf) {
+        return;
+    }
+    size_t i = 0;
+#if defined(DSD_AUDIO_MIX_SSE2)
+    const __m128 hi = _mm_set1_ps(1.0f);
+    const __m128 lo = _mm_set1_ps(-1.0f);
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(buf + i, _mm_max_ps(_mm_min_ps(_mm_loadu_ps(buf + i), hi), lo));
+    }
+#elif defined(DSD_AUDIO_MIX_NEON)
+    const float32x4_t hi = vdupq_n_f32(1.0f);
+    const float32x4_t lo = vdupq_n_f32(-1.0f);
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(buf + i, vmaxq_f32(vminq_f32(vld1q_f32(buf + i), hi), lo));
+    }
+#endif
+    for (; i < n; i++) {
+        float v = buf[i];
+        if (v > 1.0f) {
+            v = 1.0f;
+        } else if (v < -1.0f) {
+            v = -1.0f;
+        }
+        buf[i] = v;
+    }
+}
+
+void
+audio_f32_to_s16(const float* in, size_t n, short* out) {
+    if (!in || !out) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        float v = in[i] * 32768.0f;
+        if (v > 32767.0f) {
+            v = 32767.0f;
+        } else if (v < -32768.0f) {
+            v = -32768.0f;
+        }
+        out[i] = (short)v;
+    }
+}
@@ -34,6 +34,7 @@
 #include <dsd-neo/core/string_utils.h>
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/core/time_format.h>
+#include <dsd-neo/core/wav_writer.h>
 #include <dsd-neo/crypto/aes.h>
 #include <dsd-neo/crypto/des.h>
 #include <dsd-neo/crypto/dmr_keystream.h>
@@ -61,71 +62,43 @@
 #include "dsd-neo/core/safe_api.h"
 #include "dsd-neo/core/state_fwd.h"
 
-void
-saveImbe4400Data(dsd_opts* opts, const dsd_state* state, const char* imbe_d) {
-    int i, j, k;
-    unsigned char err;
-
-    err = (unsigned char)state->errs2;
-    fputc(err, opts->mbe_out_f);
+/* One .mbe record: the error byte, then the frame octets. */
+static void
+write_mbe_record(FILE* out, int errs2, const uint8_t* octets, size_t count) {
+    fputc((unsigned char)errs2, out);
+    for (size_t i = 0; i < count; i++) {
+        fputc(octets[i], out);
+    }
+}
 
-    k = 0;
-    for (i = 0; i < 11; i++) {
-        unsigned char b = 0;
+/* AMBE records keep the 49th bit on its own, in the low bit of the seventh octet. */
+static void
+save_ambe2450_record(FILE* out, int errs2, const char* ambe_d) {
+    dsd_bitvec frame;
+    uint8_t octets[7];
+    dsd_bitvec_from_bits(&frame, ambe_d, 49U);
+    (void)dsd_bitvec_to_octets(&frame, octets, sizeof(octets));
+    octets[6] = (uint8_t)(octets[6] >> 7);
+    write_mbe_record(out, errs2, octets, sizeof(octets));
+}
 
-        for (j = 0; j < 8; j++) {
-            b = b << 1;
-            b = b + imbe_d[k];
-            k++;
-        }
-        fputc(b, opts->mbe_out_f);
-    }
+void
+saveImbe4400Data(dsd_opts* opts, const dsd_state* state, const char* imbe_d) {
+    dsd_bitvec frame;
+    uint8_t octets[11];
+    dsd_bitvec_from_bits(&frame, imbe_d, 88U);
+    (void)dsd_bitvec_to_octets(&frame, octets, sizeof(octets));
+    write_mbe_record(opts->mbe_out_f, state->errs2, octets, sizeof(octets));
 }
 
 void
 saveAmbe2450Data(dsd_opts* opts, const dsd_state* state, const char* ambe_d) {
-    int i, j, k;
-    unsigned char b;
-    unsigned char err;
-
-    err = (unsigned char)state->errs2;
-    fputc(err, opts->mbe_out_f);
-
-    k = 0;
-    for (i = 0; i < 6; i++) {
-        b = 0;
-        for (j = 0; j < 8; j++) {
-            b = b << 1;
-            b = b + ambe_d[k];
-            k++;
-        }
-        fputc(b, opts->mbe_out_f);
-    }
-    b = ambe_d[48];
-    fputc(b, opts->mbe_out_f);
+    save_ambe2450_record(opts->mbe_out_f, state->errs2, ambe_d);
 }
 
 void
 saveAmbe2450DataR(dsd_opts* opts, const dsd_state* state, const char* ambe_d) {
-    int i, j, k;
-    unsigned char b;
-    unsigned char err;
-
-    err = (unsigned char)state->errs2R;
-    fputc(err, opts->mbe_out_fR);
-
-    k = 0;
-    for (i = 0; i < 6; i++) {
-        b = 0;
-        for (j = 0; j < 8; j++) {
-            b = b << 1;
-            b = b + ambe_d[k];
-            k++;
-        }
-        fputc(b, opts->mbe_out_fR);
-    }
-    b = ambe_d[48];
-    fputc(b, opts->mbe_out_fR);
+    save_ambe2450_record(opts->mbe_out_fR, state->errs2R, ambe_d);
 }
 
 static int
@@ -311,59 +284,49 @@ PrintAMBEData(dsd_opts* opts, const dsd_state* state, const char* ambe_d) {
     dsd_frame_logf(opts, "FRAME AMBE slot=%d data=%014llX err=[%X] [%X]", state->currentslot + 1, ambe, errs, errs2);
 }
 
+/* Read @p count frame octets, echoing each with --payload; nonzero on a short file. */
+static int
+read_mbe_octets(dsd_opts* opts, uint8_t* octets, size_t count, int echo) {
+    for (size_t i = 0; i < count; i++) {
+        const int c = fgetc(opts->mbe_in_f);
+        if (c == EOF) {
+            return 1;
+        }
+        octets[i] = (uint8_t)c;
+        if (echo && opts->payload == 1) {
+            DSD_FPRINTF(stderr, "%02X", octets[i]);
+        }
+    }
+    return 0;
+}
+
 int
 readImbe4400Data(dsd_opts* opts, dsd_state* state, char* imbe_d) {
-
-    int i, j, k;
-    unsigned char x;
-    int c;
-
-    c = fgetc(opts->mbe_in_f);
+    int c = fgetc(opts->mbe_in_f);
     if (c == EOF) {
         return (1);
     }
     state->errs2 = c;
     state->errs = state->errs2;
 
-    k = 0;
     if (opts->payload == 1) {
         DSD_FPRINTF(stderr, "\n IMBE ");
     }
-    x = 0;
-    for (i = 0; i < 11; i++) {
-        c = fgetc(opts->mbe_in_f);
-        if (c == EOF) {
-            return (1);
-        }
-        unsigned char b = (unsigned char)c;
-        for (j = 0; j < 8; j++) {
-            imbe_d[k] = (b & 128) >> 7;
-
-            x = x << 1;
-            x |= ((b & 0x80) >> 7);
-
-            b = b << 1;
-            b = b & 255;
-            k++;
-        }
-
-        if (opts->payload == 1) {
-            DSD_FPRINTF(stderr, "%02X", x);
-        }
+    uint8_t octets[11];
+    if (read_mbe_octets(opts, octets, sizeof(octets), 1) != 0) {
+        return (1);
     }
+    dsd_bitvec frame;
+    dsd_bitvec_from_octets(&frame, octets, 88U);
+    dsd_bitvec_to_bits(&frame, imbe_d);
+
     if (opts->payload == 1) {
         DSD_FPRINTF(stderr, " err = [%X] [%X] ", state->errs, state->errs2); //not sure that errs here are legit values
     }
     if (dsd_frame_log_enabled(opts)) {
         char imbe_hex[23];
-        size_t hex_off = 0;
-        imbe_hex[0] = '\0';
-        for (i = 0; i < 11; i++) {
-            uint8_t oct = convert_bits_into_output((uint8_t*)imbe_d + ((size_t)i * 8u), 8);
-            if (hex_off + 2 < sizeof(imbe_hex)) {
-                (void)DSD_SNPRINTF(imbe_hex + hex_off, sizeof(imbe_hex) - hex_off, "%02X", oct);
-                hex_off += 2;
-            }
+        for (size_t i = 0; i < sizeof(octets); i++) {
+            (void)DSD_SNPRINTF(imbe_hex + (i * 2U), sizeof(imbe_hex) - (i * 2U), "%02X", octets[i]);
         }
         imbe_hex[sizeof(imbe_hex) - 1] = '\0';
         dsd_frame_logf(opts, "FRAME IMBE slot=%d data=%s err=[%X] [%X] source=mbe-file", state->currentslot + 1,
@@ -374,57 +337,33 @@ readImbe4400Data(dsd_opts* opts, dsd_state* state, char* imbe_d) {
 
 int
 readAmbe2450Data(dsd_opts* opts, dsd_state* state, char* ambe_d) {
-
-    int i, j, k;
-    unsigned char b, x;
-    int c;
-
-    c = fgetc(opts->mbe_in_f);
+    int c = fgetc(opts->mbe_in_f);
     if (c == EOF) {
         return (1);
     }
     state->errs2 = c;
     state->errs = state->errs2;
 
-    k = 0;
     if (opts->payload == 1) {
         DSD_FPRINTF(stderr, "\n AMBE ");
     }
-
-    x = 0;
-    for (i = 0; i < 6; i++) // AMBE payload occupies six bytes
-    {
-        c = fgetc(opts->mbe_in_f);
-        if (c == EOF) {
-            return (1);
-        }
-        b = (unsigned char)c;
-        for (j = 0; j < 8; j++) {
-            ambe_d[k] = (b & 128) >> 7;
-
-            x = x << 1;
-            x |= ((b & 0x80) >> 7);
-
-            b = b << 1;
-            b = b & 255;
-            k++;
-        }
-        if (opts->payload == 1) {
-            DSD_FPRINTF(stderr, "%02X", x);
-        }
+    // AMBE payload occupies six octets, then the 49th bit alone in the low bit of the seventh
+    uint8_t octets[7];
+    if (read_mbe_octets(opts, octets, 6U, 1) != 0) {
+        return (1);
     }
     if (opts->payload == 1) {
         DSD_FPRINTF(stderr, " err = [%X] [%X] ", state->errs, state->errs2);
     }
-    c = fgetc(opts->mbe_in_f);
-    if (c == EOF) {
+    if (read_mbe_octets(opts, &octets[6], 1U, 0) != 0) {
         return (1);
     }
-    b = (unsigned char)c;
-    ambe_d[48] = (b & 1);
+    octets[6] = (uint8_t)(octets[6] << 7);
+    dsd_bitvec frame;
+    dsd_bitvec_from_octets(&frame, octets, 49U);
+    dsd_bitvec_to_bits(&frame, ambe_d);
     if (dsd_frame_log_enabled(opts)) {
-        unsigned long long ambe = convert_bits_into_output((uint8_t*)ambe_d, 49);
-        ambe = ambe << 7;
+        const unsigned long long ambe = dsd_bitvec_get(&frame, 0U, 49U) << 7;
         dsd_frame_logf(opts, "FRAME AMBE slot=%d data=%014llX err=[%X] [%X] source=mbe-file", state->currentslot + 1,
                        ambe, state->errs, state->errs2);
     }
@@ -690,6 +629,10 @@ open_wav_file(char* dir, char* temp_filename, size_t temp_filename_size, uint16_
 
 SNDFILE*
 close_wav_file(SNDFILE* wav_file) {
+    if (wav_file != NULL && dsd_wav_writer_active()
+        && dsd_wav_writer_finalize(wav_file, NULL, NULL, NULL, NULL, 0) == 0) {
+        return NULL;
+    }
     sf_close(wav_file);
     wav_file = NULL;
     return wav_file;
@@ -787,18 +730,13 @@ wav_file_get_size_or_negative(const char* filename) {
     return size;
 }
 
-SNDFILE*
-close_and_rename_wav_file_ex(SNDFILE* wav_file, const dsd_opts* opts, const char* wav_out_filename, const char* dir,
-                             const Event_History_I* event_struct, int export_call) {
-    if (wav_file != NULL) {
-        sf_close(wav_file);
-    }
-
+void
+dsd_wav_finalize_closed_file(const dsd_opts* opts, const char* wav_out_filename, const char* dir,
+                             const Event_History* event_item, int export_call) {
     if (wav_out_filename == NULL || wav_out_filename[0] == '\0') {
-        return NULL;
+        return;
     }
 
-    const Event_History* event_item = wav_rename_get_event_item(event_struct);
     wav_rename_metadata metadata;
     DSD_MEMSET(&metadata, 0, sizeof(metadata));
     wav_rename_build_metadata(event_item, &metadata);
@@ -810,30 +748,41 @@ close_and_rename_wav_file_ex(SNDFILE* wav_file, const dsd_opts* opts, const char
     long size = wav_file_get_size_or_negative(wav_out_filename);
     if (size == 44) {
         remove(wav_out_filename);
-        wav_file = NULL;
-        return wav_file;
+        return;
     }
 
     if (rename(wav_out_filename, new_filename) != 0) {
         LOG_ERROR("Error - could not rename wav file %s -> %s\n", wav_out_filename, new_filename);
-        return NULL;
+        return;
     }
 
     long final_size = wav_file_get_size_or_negative(new_filename);
     if (final_size == 44) {
         remove(new_filename);
-        wav_file = NULL;
-        return wav_file;
+        return;
     }
 
     if (export_call && opts && final_size > 44) {
-        if (dsd_rdio_export_call(opts, event_struct, new_filename) != 0) {
+        if (dsd_rdio_export_event(opts, event_item, new_filename) != 0) {
             LOG_WARN("Rdio export failed for %s\n", new_filename);
         }
     }
+}
 
-    wav_file = NULL;
-    return wav_file;
+SNDFILE*
+close_and_rename_wav_file_ex(SNDFILE* wav_file, const dsd_opts* opts, const char* wav_out_filename, const char* dir,
+                             const Event_History_I* event_struct, int export_call) {
+    const Event_History* event_item = wav_rename_get_event_item(event_struct);
+    if (dsd_wav_writer_active()
+        && dsd_wav_writer_finalize(wav_file, opts, wav_out_filename, dir, event_item, export_call) == 0) {
+        return NULL;
+    }
+
+    if (wav_file != NULL) {
+        sf_close(wav_file);
+    }
+    dsd_wav_finalize_closed_file(opts, wav_out_filename, dir, event_item, export_call);
+    return NULL;
 }
 
 SNDFILE*
@@ -873,6 +822,17 @@ openWavOutFileRaw(dsd_opts* opts, dsd_state* state) {
     }
 }
 
+/* The raw capture is written and synced on the decoder thread, so it is closed there too, never by the WAV writer. */
+void
+closeWavOutFileRaw(dsd_opts* opts, dsd_state* state) {
+    UNUSED(state);
+
+    if (opts->wav_out_raw != NULL) {
+        sf_close(opts->wav_out_raw);
+        opts->wav_out_raw = NULL;
+    }
+}
+
 void
 openSymbolOutFile(dsd_opts* opts, dsd_state* state) {
     closeSymbolOutFile(opts, state);
@@ -924,29 +884,6 @@ rotate_symbol_out_file(dsd_opts* opts, dsd_state* state) {
     }
 }
 
-//take len amount of bits and pack into x amount of bytes (asymmetrical)
-void
-pack_ambe(const char* input, uint8_t* output, int len) {
-    int i = 0;
-    int k = len % 8;
-    for (i = 0; i < len; i++) {
-        output[i / 8] <<= 1;
-        output[i / 8] |= (uint8_t)input[i];
-    }
-    // If any leftover bits that don't flush the last byte fully packed, shift them over left
-    if (k) {
-        output[i / 8] <<= 8 - k;
-    }
-}
-
-//unpack byte array with ambe data into a 49-bit bitwise array
-void
-unpack_ambe(const uint8_t* input, char* ambe) {
-    // Contract: input spans at least 7 octets, ambe at least 49 bit elements.
-    dsd_unpack_bytes_to_bits(input, 7U, (uint8_t*)ambe, 49U, 6U);
-    ambe[48] = input[6] >> 7;
-}
-
 //recover previous IV for SDRTrunk .mbe files when P25p1
 static uint64_t
 reverse_lfsr_64_to_len(const dsd_opts* opts, uint8_t* iv, int16_t len) {
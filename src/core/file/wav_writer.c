@@ -0,0 +1,441 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Background writer for per-call WAV recordings.
+ *
+ * One FIFO of jobs feeds one thread. A write job is a batch of samples for
+ * one handle; producers keep appending to the tail batch until it is full or
+ * another job is queued behind it, and the writer only takes a partial batch
+ * once it is no longer the tail (or on drain/shutdown). A finalize job closes
+ * a handle and renames the recording after every write queued before it.
+ */
+
+#include <dsd-neo/core/file_io.h>
+#include <dsd-neo/core/opts.h>
+#include <dsd-neo/core/wav_writer.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/platform/timing.h>
+#include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/log.h>
+#include <sndfile.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+#include "dsd-neo/platform/platform.h"
+
+enum { DSD_WAV_JOB_WRITE = 0, DSD_WAV_JOB_FINALIZE = 1 };
+
+typedef struct {
+    dsd_opts* opts; /* rdio settings snapshot, or NULL when the call is not exported */
+    int export_call;
+    int has_event;
+    char temp_path[1024];
+    char dir[1024];
+    Event_History event;
+} dsd_wav_finalize_job;
+
+typedef struct dsd_wav_job {
+    int kind;
+    SNDFILE* file;
+    const char* context;
+    int count;
+    dsd_wav_finalize_job* finalize;
+    struct dsd_wav_job* next;
+    short samples[DSD_WAV_WRITER_BATCH_SAMPLES];
+} dsd_wav_job;
+
+static dsd_mutex_t g_wav_mutex;
+static dsd_cond_t g_wav_work_cond;  /* a job became ready, or stop */
+static dsd_cond_t g_wav_space_cond; /* a job left the queue */
+static dsd_cond_t g_wav_idle_cond;  /* the queue ran empty with the writer idle */
+static dsd_thread_t g_wav_worker;
+static dsd_wav_job* g_wav_head = NULL;
+static dsd_wav_job* g_wav_tail = NULL;
+static size_t g_wav_depth = 0;
+static int g_wav_busy = 0;
+static int g_wav_drain_requests = 0;
+static int g_wav_stop_requested = 0;
+static int g_wav_drop_warned = 0;
+static dsd_wav_writer_stats g_wav_stats;
+static atomic_int g_wav_state = 0; // 0=uninitialized, 1=initializing, 2=ready, 3=failed, 4=stopping
+
+int
+dsd_wav_writer_active(void) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    return (cfg && cfg->wav_async_enable) ? 1 : 0;
+}
+
+/* Whether the head job may run now; a partial tail batch waits for more samples. */
+static int
+dsd_wav_head_ready_locked(void) {
+    const dsd_wav_job* head = g_wav_head;
+    if (head == NULL) {
+        return 0;
+    }
+    return head != g_wav_tail || head->kind != DSD_WAV_JOB_WRITE || head->count == DSD_WAV_WRITER_BATCH_SAMPLES
+           || g_wav_drain_requests > 0 || g_wav_stop_requested;
+}
+
+static void
+dsd_wav_free_job(dsd_wav_job* job) {
+    if (job->finalize) {
+        free(job->finalize->opts);
+        free(job->finalize);
+    }
+    free(job);
+}
+
+static void
+dsd_wav_run_job(dsd_wav_job* job, int64_t* written) {
+    if (job->kind == DSD_WAV_JOB_WRITE) {
+        sf_count_t n = sf_write_short(job->file, job->samples, (sf_count_t)job->count);
+        if (n != (sf_count_t)job->count) {
+            LOG_WARN("%s: wrote %lld/%d samples to WAV output\n", job->context ? job->context : "WAV writer",
+                     (long long)n, job->count);
+        }
+        *written = (n > 0) ? (int64_t)n : 0;
+        return;
+    }
+
+    dsd_wav_finalize_job* fin = job->finalize;
+    if (job->file != NULL) {
+        sf_close(job->file);
+    }
+    if (fin && fin->temp_path[0] != '\0') {
+        dsd_wav_finalize_closed_file(fin->opts, fin->temp_path, fin->dir, fin->has_event ? &fin->event : NULL,
+                                     fin->export_call);
+    }
+}
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    dsd_wav_writer_thread(void* arg) {
+    (void)arg;
+
+    dsd_mutex_lock(&g_wav_mutex);
+    for (;;) {
+        while (!dsd_wav_head_ready_locked() && !(g_wav_head == NULL && g_wav_stop_requested)) {
+            if (g_wav_head == NULL) {
+                dsd_cond_broadcast(&g_wav_idle_cond);
+            }
+            dsd_cond_wait(&g_wav_work_cond, &g_wav_mutex);
+        }
+        if (g_wav_head == NULL) {
+            break;
+        }
+
+        dsd_wav_job* job = g_wav_head;
+        g_wav_head = job->next;
+        if (g_wav_head == NULL) {
+            g_wav_tail = NULL;
+        }
+        g_wav_depth--;
+        g_wav_busy = 1;
+        dsd_cond_broadcast(&g_wav_space_cond);
+        dsd_mutex_unlock(&g_wav_mutex);
+
+        int64_t written = 0;
+        dsd_wav_run_job(job, &written);
+        const int kind = job->kind;
+        dsd_wav_free_job(job);
+
+        dsd_mutex_lock(&g_wav_mutex);
+        g_wav_busy = 0;
+        if (kind == DSD_WAV_JOB_WRITE) {
+            g_wav_stats.batches++;
+            g_wav_stats.written_samples += (uint64_t)written;
+        } else {
+            g_wav_stats.finalized++;
+        }
+        if (g_wav_head == NULL) {
+            dsd_cond_broadcast(&g_wav_idle_cond);
+        }
+    }
+    dsd_cond_broadcast(&g_wav_idle_cond);
+    dsd_mutex_unlock(&g_wav_mutex);
+
+    DSD_THREAD_RETURN;
+}
+
+static int
+dsd_wav_writer_init(void) {
+    int state = atomic_load(&g_wav_state);
+    if (state == 2) {
+        return 0;
+    }
+    if (state == 3 || state == 4) {
+        return -1;
+    }
+
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&g_wav_state, &expected, 1)) {
+        if (dsd_mutex_init(&g_wav_mutex) != 0) {
+            atomic_store(&g_wav_state, 3);
+            return -1;
+        }
+        if (dsd_cond_init(&g_wav_work_cond) != 0) {
+            (void)dsd_mutex_destroy(&g_wav_mutex);
+            atomic_store(&g_wav_state, 3);
+            return -1;
+        }
+        if (dsd_cond_init(&g_wav_space_cond) != 0) {
+            (void)dsd_cond_destroy(&g_wav_work_cond);
+            (void)dsd_mutex_destroy(&g_wav_mutex);
+            atomic_store(&g_wav_state, 3);
+            return -1;
+        }
+        if (dsd_cond_init(&g_wav_idle_cond) != 0) {
+            (void)dsd_cond_destroy(&g_wav_space_cond);
+            (void)dsd_cond_destroy(&g_wav_work_cond);
+            (void)dsd_mutex_destroy(&g_wav_mutex);
+            atomic_store(&g_wav_state, 3);
+            return -1;
+        }
+
+        g_wav_head = NULL;
+        g_wav_tail = NULL;
+        g_wav_depth = 0;
+        g_wav_busy = 0;
+        g_wav_drain_requests = 0;
+        g_wav_stop_requested = 0;
+        g_wav_drop_warned = 0;
+        DSD_MEMSET(&g_wav_stats, 0, sizeof(g_wav_stats));
+
+        if (dsd_thread_create(&g_wav_worker, dsd_wav_writer_thread, NULL) != 0) {
+            (void)dsd_cond_destroy(&g_wav_idle_cond);
+            (void)dsd_cond_destroy(&g_wav_space_cond);
+            (void)dsd_cond_destroy(&g_wav_work_cond);
+            (void)dsd_mutex_destroy(&g_wav_mutex);
+            atomic_store(&g_wav_state, 3);
+            return -1;
+        }
+
+        atomic_store(&g_wav_state, 2);
+        return 0;
+    }
+
+    for (;;) {
+        state = atomic_load(&g_wav_state);
+        if (state == 2) {
+            return 0;
+        }
+        if (state == 3 || state == 4) {
+            return -1;
+        }
+        dsd_sleep_ms(1U);
+    }
+}
+
+static void
+dsd_wav_append_locked(dsd_wav_job* job) {
+    job->next = NULL;
+    if (g_wav_tail) {
+        g_wav_tail->next = job;
+    } else {
+        g_wav_head = job;
+    }
+    g_wav_tail = job;
+    g_wav_depth++;
+}
+
+int
+dsd_wav_writer_write(SNDFILE* file, const short* samples, int64_t count, const char* context) {
+    if (file == NULL || samples == NULL || count <= 0) {
+        return 0;
+    }
+    if (dsd_wav_writer_init() != 0) {
+        return -1;
+    }
+
+    int dropped = 0;
+    dsd_mutex_lock(&g_wav_mutex);
+    while (count > 0) {
+        dsd_wav_job* job = g_wav_tail;
+        if (job == NULL || job->kind != DSD_WAV_JOB_WRITE || job->file != file
+            || job->count == DSD_WAV_WRITER_BATCH_SAMPLES) {
+            job = NULL;
+            if (g_wav_depth < DSD_WAV_WRITER_QUEUE_MAX) {
+                job = (dsd_wav_job*)malloc(sizeof(*job));
+            }
+            if (job == NULL) {
+                g_wav_stats.dropped_samples += (uint64_t)count;
+                dropped = 1;
+                break;
+            }
+            job->kind = DSD_WAV_JOB_WRITE;
+            job->file = file;
+            job->context = context;
+            job->count = 0;
+            job->finalize = NULL;
+            const int had_tail = (g_wav_tail != NULL);
+            dsd_wav_append_locked(job);
+            if (had_tail) {
+                dsd_cond_signal(&g_wav_work_cond);
+            }
+        }
+
+        int room = DSD_WAV_WRITER_BATCH_SAMPLES - job->count;
+        int n = (count < (int64_t)room) ? (int)count : room;
+        DSD_MEMCPY(&job->samples[job->count], samples, (size_t)n * sizeof(short));
+        job->count += n;
+        samples += n;
+        count -= n;
+        g_wav_stats.queued_samples += (uint64_t)n;
+        if (job->count == DSD_WAV_WRITER_BATCH_SAMPLES) {
+            dsd_cond_signal(&g_wav_work_cond);
+        }
+    }
+    const int warn = dropped && !g_wav_drop_warned;
+    g_wav_drop_warned = dropped;
+    dsd_mutex_unlock(&g_wav_mutex);
+
+    if (warn) {
+        LOG_WARN("WAV writer: queue full, dropping recorded audio (%s)\n", context ? context : "WAV output");
+    }
+    return dropped;
+}
+
+static void
+dsd_wav_copy_rdio_settings(dsd_opts* out, const dsd_opts* opts) {
+    out->rdio_mode = opts->rdio_mode;
+    out->rdio_system_id = opts->rdio_system_id;
+    out->rdio_upload_timeout_ms = opts->rdio_upload_timeout_ms;
+    out->rdio_upload_retries = opts->rdio_upload_retries;
+    out->rdio_api_delete_after_upload = opts->rdio_api_delete_after_upload;
+    DSD_MEMCPY(out->rdio_api_key, opts->rdio_api_key, sizeof(out->rdio_api_key));
+    DSD_MEMCPY(out->rdio_api_url, opts->rdio_api_url, sizeof(out->rdio_api_url));
+}
+
+int
+dsd_wav_writer_finalize(SNDFILE* file, const dsd_opts* opts, const char* temp_path, const char* dir,
+                        const Event_History* event, int export_call) {
+    const int has_path = (temp_path != NULL && temp_path[0] != '\0');
+    if (file == NULL && !has_path) {
+        return 0;
+    }
+    if (dsd_wav_writer_init() != 0) {
+        return -1;
+    }
+
+    dsd_wav_job* job = (dsd_wav_job*)calloc(1, sizeof(*job));
+    dsd_wav_finalize_job* fin = (dsd_wav_finalize_job*)calloc(1, sizeof(*fin));
+    const int export_wanted = has_path && export_call && opts != NULL && opts->rdio_mode != 0;
+    dsd_opts* rdio = export_wanted ? (dsd_opts*)calloc(1, sizeof(dsd_opts)) : NULL;
+    if (job == NULL || fin == NULL || (export_wanted && rdio == NULL)) {
+        free(rdio);
+        free(fin);
+        free(job);
+        /* Inline close is only safe once the queued writes to this handle have run. */
+        dsd_wav_writer_drain();
+        return -1;
+    }
+
+    if (rdio) {
+        dsd_wav_copy_rdio_settings(rdio, opts);
+    }
+    fin->opts = rdio;
+    fin->export_call = export_wanted;
+    if (has_path) {
+        DSD_SNPRINTF(fin->temp_path, sizeof(fin->temp_path), "%s", temp_path);
+        DSD_SNPRINTF(fin->dir, sizeof(fin->dir), "%s", dir ? dir : "");
+    }
+    if (event) {
+        DSD_MEMCPY(&fin->event, event, sizeof(fin->event));
+        fin->has_event = 1;
+    }
+    job->kind = DSD_WAV_JOB_FINALIZE;
+    job->file = file;
+    job->finalize = fin;
+
+    dsd_mutex_lock(&g_wav_mutex);
+    if (g_wav_depth >= DSD_WAV_WRITER_QUEUE_MAX) {
+        g_wav_stats.backpressure_waits++;
+        while (g_wav_depth >= DSD_WAV_WRITER_QUEUE_MAX) {
+            dsd_cond_wait(&g_wav_space_cond, &g_wav_mutex);
+        }
+    }
+    dsd_wav_append_locked(job);
+    dsd_cond_signal(&g_wav_work_cond);
+    dsd_mutex_unlock(&g_wav_mutex);
+    return 0;
+}
+
+void
+dsd_wav_writer_drain(void) {
+    if (atomic_load(&g_wav_state) != 2) {
+        return;
+    }
+    dsd_mutex_lock(&g_wav_mutex);
+    g_wav_drain_requests++;
+    dsd_cond_signal(&g_wav_work_cond);
+    while (g_wav_head != NULL || g_wav_busy) {
+        dsd_cond_wait(&g_wav_idle_cond, &g_wav_mutex);
+    }
+    g_wav_drain_requests--;
+    dsd_mutex_unlock(&g_wav_mutex);
+}
+
+void
+dsd_wav_writer_get_stats(dsd_wav_writer_stats* out) {
+    if (!out) {
+        return;
+    }
+    DSD_MEMSET(out, 0, sizeof(*out));
+    if (atomic_load(&g_wav_state) != 2) {
+        return;
+    }
+    dsd_mutex_lock(&g_wav_mutex);
+    *out = g_wav_stats;
+    out->depth = g_wav_depth;
+    dsd_mutex_unlock(&g_wav_mutex);
+}
+
+void
+dsd_wav_writer_shutdown(void) {
+    for (;;) {
+        int state = atomic_load(&g_wav_state);
+        if (state == 0 || state == 3) {
+            return;
+        }
+        if (state == 1 || state == 4) {
+            dsd_sleep_ms(1U);
+            continue;
+        }
+
+        int expected = 2;
+        if (atomic_compare_exchange_strong(&g_wav_state, &expected, 4)) {
+            break;
+        }
+    }
+
+    dsd_mutex_lock(&g_wav_mutex);
+    g_wav_stop_requested = 1;
+    dsd_cond_broadcast(&g_wav_work_cond);
+    dsd_mutex_unlock(&g_wav_mutex);
+
+    if (dsd_thread_join(g_wav_worker) != 0) {
+        LOG_ERROR("WAV writer: failed to join writer thread during shutdown\n");
+        atomic_store(&g_wav_state, 3);
+        return;
+    }
+
+    if (g_wav_stats.dropped_samples > 0) {
+        LOG_WARN("WAV writer: dropped %llu of %llu recorded samples (queue full)\n",
+                 (unsigned long long)g_wav_stats.dropped_samples,
+                 (unsigned long long)(g_wav_stats.queued_samples + g_wav_stats.dropped_samples));
+    }
+
+    (void)dsd_cond_destroy(&g_wav_idle_cond);
+    (void)dsd_cond_destroy(&g_wav_space_cond);
+    (void)dsd_cond_destroy(&g_wav_work_cond);
+    (void)dsd_mutex_destroy(&g_wav_mutex);
+
+    atomic_store(&g_wav_state, 0);
+}
@@ -1040,23 +1040,12 @@ digitize(const dsd_opts* opts, dsd_state* state, float symbol) {
     return dibit;
 }
 
-int
-get_dibit_and_analog_signal(dsd_opts* opts, dsd_state* state, int* out_analog_signal) {
-    if (opts == NULL || state == NULL) {
-        return -1;
-    }
-
-    float symbol;
+static int
+dibit_from_symbol(dsd_opts* opts, dsd_state* state, float symbol) {
     int dibit;
 
-    symbol = getSymbol(opts, state, 1);
-
     state->sbuf[state->sidx] = symbol;
 
-    if (out_analog_signal != NULL) {
-        *out_analog_signal = (int)lrintf(symbol);
-    }
-
     use_symbol(opts, state, symbol);
 
     dibit = digitize(opts, state, symbol);
@@ -1075,6 +1064,50 @@ get_dibit_and_analog_signal(dsd_opts* opts, dsd_state* state, int* out_analog_si
     return dibit;
 }
 
+int
+get_dibit_and_analog_signal(dsd_opts* opts, dsd_state* state, int* out_analog_signal) {
+    if (opts == NULL || state == NULL) {
+        return -1;
+    }
+
+    float symbol = getSymbol(opts, state, 1);
+
+    if (out_analog_signal != NULL) {
+        *out_analog_signal = (int)lrintf(symbol);
+    }
+
+    return dibit_from_symbol(opts, state, symbol);
+}
+
+typedef struct {
+    int* dibits;
+    dsd_dibit_soft_t* soft;
+    int next;
+} dibit_block_sink_ctx;
+
+static void
+dibit_block_sink(dsd_opts* opts, dsd_state* state, float symbol, void* user) {
+    dibit_block_sink_ctx* ctx = (dibit_block_sink_ctx*)user;
+    const int dibit = dibit_from_symbol(opts, state, symbol);
+    if (ctx->dibits != NULL) {
+        ctx->dibits[ctx->next] = dibit;
+    }
+    if (ctx->soft != NULL && !read_previous_dibit_soft(state, &ctx->soft[ctx->next])) {
+        fallback_soft_from_dibit(dibit, 255, &ctx->soft[ctx->next]);
+    }
+    ctx->next++;
+}
+
+int
+getDibitSoftBlock(dsd_opts* opts, dsd_state* state, int* dibits, dsd_dibit_soft_t* soft, int count) {
+    if (opts == NULL || state == NULL || count <= 0) {
+        return 0;
+    }
+    dibit_block_sink_ctx ctx = {dibits, soft, 0};
+    getSymbolBlock(opts, state, 1, NULL, count, dibit_block_sink, &ctx);
+    return ctx.next;
+}
+
 int
 getDibitSoft(dsd_opts* opts, dsd_state* state, dsd_dibit_soft_t* out_soft) {
     int dibit = get_dibit_and_analog_signal(opts, state, NULL);
@@ -1282,9 +1315,5 @@ gmsk_soft_symbol_to_viterbi_cost(float symbol, const dsd_state* state) {
 
 void
 skipDibit(dsd_opts* opts, dsd_state* state, int count) {
-
-    int i;
-    for (i = 0; i < (count); i++) {
-        (void)get_dibit_and_analog_signal(opts, state, NULL);
-    }
+    (void)getDibitSoftBlock(opts, state, NULL, NULL, count);
 }
@@ -153,3 +153,163 @@ dsd_crc_ccitt16_bits(const uint8_t* input, size_t bit_count) {
     }
     return (uint16_t)(crc ^ 0xFFFFU);
 }
+
+#define BITVEC_WORDS (DSD_BITVEC_MAX_BITS / 64U)
+
+/* Bits of word @p i that lie below @p len, MSB-first. */
+static uint64_t
+bitvec_word_mask(uint32_t len, uint32_t i) {
+    const uint32_t start = i * 64U;
+    if (len <= start) {
+        return 0ULL;
+    }
+    if (len - start >= 64U) {
+        return ~0ULL;
+    }
+    return ~0ULL << (64U - (len - start));
+}
+
+static void
+bitvec_trim(dsd_bitvec* v) {
+    for (uint32_t i = 0U; i < BITVEC_WORDS; i++) {
+        v->w[i] &= bitvec_word_mask(v->len, i);
+    }
+}
+
+/* The 64 bits starting at @p pos; positions past the capacity read as zero. */
+static uint64_t
+bitvec_window(const dsd_bitvec* v, uint32_t pos) {
+    const uint32_t i = pos >> 6U;
+    const uint32_t sh = pos & 63U;
+    const uint64_t hi = (i < BITVEC_WORDS) ? v->w[i] : 0ULL;
+    const uint64_t lo = (i + 1U < BITVEC_WORDS) ? v->w[i + 1U] : 0ULL;
+    return (sh != 0U) ? ((hi << sh) | (lo >> (64U - sh))) : hi;
+}
+
+/* The 64 keystream bits starting at @p bit_pos; octets past @p ks_bytes read as zero. */
+static uint64_t
+octet_window(const uint8_t* ks, size_t ks_bytes, size_t bit_pos) {
+    const size_t first = bit_pos >> 3U;
+    const unsigned int sh = (unsigned int)(bit_pos & 7U);
+    uint64_t acc = 0ULL;
+    for (size_t b = first; b < first + 8U; b++) {
+        acc = (acc << 8U) | ((b < ks_bytes) ? ks[b] : 0U);
+    }
+    if (sh != 0U) {
+        const uint64_t next = (first + 8U < ks_bytes) ? ks[first + 8U] : 0U;
+        acc = (acc << sh) | (next >> (8U - sh));
+    }
+    return acc;
+}
+
+void
+dsd_bitvec_init(dsd_bitvec* v, uint32_t len) {
+    for (uint32_t i = 0U; i < BITVEC_WORDS; i++) {
+        v->w[i] = 0ULL;
+    }
+    v->len = (len > DSD_BITVEC_MAX_BITS) ? DSD_BITVEC_MAX_BITS : len;
+}
+
+void
+dsd_bitvec_from_bits(dsd_bitvec* v, const char* bits, uint32_t len) {
+    dsd_bitvec_init(v, len);
+    const uint8_t* in = (const uint8_t*)bits;
+    uint32_t i = 0U;
+    for (; i + 8U <= v->len; i += 8U) {
+        v->w[i >> 6U] |= pack_8_bits_msb(&in[i]) << (56U - (i & 63U));
+    }
+    for (; i < v->len; i++) {
+        v->w[i >> 6U] |= (uint64_t)(in[i] & 1U) << (63U - (i & 63U));
+    }
+}
+
+void
+dsd_bitvec_to_bits(const dsd_bitvec* v, char* bits) {
+    for (uint32_t i = 0U; i < v->len; i++) {
+        bits[i] = (char)((v->w[i >> 6U] >> (63U - (i & 63U))) & 1U);
+    }
+}
+
+void
+dsd_bitvec_from_octets(dsd_bitvec* v, const uint8_t* octets, uint32_t len) {
+    dsd_bitvec_init(v, len);
+    const uint32_t count = (v->len + 7U) / 8U;
+    for (uint32_t b = 0U; b < count; b++) {
+        v->w[b >> 3U] |= (uint64_t)octets[b] << (56U - (8U * (b & 7U)));
+    }
+    bitvec_trim(v);
+}
+
+size_t
+dsd_bitvec_to_octets(const dsd_bitvec* v, uint8_t* out, size_t out_cap) {
+    size_t count = ((size_t)v->len + 7U) / 8U;
+    if (count > out_cap) {
+        count = out_cap;
+    }
+    for (size_t b = 0U; b < count; b++) {
+        out[b] = (uint8_t)(v->w[b >> 3U] >> (56U - (8U * (b & 7U))));
+    }
+    return count;
+}
+
+uint64_t
+dsd_bitvec_get(const dsd_bitvec* v, uint32_t pos, uint32_t width) {
+    if (width == 0U || width > 64U) {
+        return 0ULL;
+    }
+    return bitvec_window(v, pos) >> (64U - width);
+}
+
+void
+dsd_bitvec_set(dsd_bitvec* v, uint32_t pos, uint32_t width, uint64_t value) {
+    if (width == 0U || width > 64U) {
+        return;
+    }
+    const uint64_t field_mask = ~0ULL << (64U - width);
+    const uint64_t field = (value << (64U - width)) & field_mask;
+    const uint32_t i = pos >> 6U;
+    const uint32_t sh = pos & 63U;
+    if (i < BITVEC_WORDS) {
+        v->w[i] = (v->w[i] & ~(field_mask >> sh)) | (field >> sh);
+    }
+    if (sh != 0U && i + 1U < BITVEC_WORDS) {
+        v->w[i + 1U] = (v->w[i + 1U] & ~(field_mask << (64U - sh))) | (field << (64U - sh));
+    }
+    bitvec_trim(v);
+}
+
+void
+dsd_bitvec_xor(dsd_bitvec* v, const dsd_bitvec* ks) {
+    for (uint32_t i = 0U; i < BITVEC_WORDS; i++) {
+        v->w[i] ^= ks->w[i] & bitvec_word_mask(v->len, i);
+    }
+}
+
+void
+dsd_bitvec_xor_octets(dsd_bitvec* v, const uint8_t* ks, size_t ks_bytes, size_t bit_offset) {
+    if (ks == NULL) {
+        return;
+    }
+    for (uint32_t i = 0U; i < BITVEC_WORDS && i * 64U < v->len; i++) {
+        v->w[i] ^= octet_window(ks, ks_bytes, bit_offset + ((size_t)i * 64U)) & bitvec_word_mask(v->len, i);
+    }
+}
+
+//take len amount of bits and pack into x amount of bytes (asymmetrical)
+void
+pack_ambe(const char* input, uint8_t* output, int len) {
+    dsd_bitvec v;
+    for (int off = 0; off < len; off += (int)DSD_BITVEC_MAX_BITS) {
+        const int n = (len - off < (int)DSD_BITVEC_MAX_BITS) ? (len - off) : (int)DSD_BITVEC_MAX_BITS;
+        dsd_bitvec_from_bits(&v, input + off, (uint32_t)n);
+        (void)dsd_bitvec_to_octets(&v, output + (off / 8), ((size_t)n + 7U) / 8U);
+    }
+}
+
+//unpack byte array with ambe data into a 49-bit bitwise array
+void
+unpack_ambe(const uint8_t* input, char* ambe) {
+    dsd_bitvec v;
+    dsd_bitvec_from_octets(&v, input, 49U);
+    dsd_bitvec_to_bits(&v, ambe);
+}
@@ -24,6 +24,7 @@
 #include <dsd-neo/core/time_format.h>
 #include <dsd-neo/platform/file_compat.h>
 #include <dsd-neo/protocol/edacs/edacs_afs.h>
+#include <dsd-neo/runtime/vocoder_drain_hooks.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -893,12 +894,28 @@ watchdog_event_history_impl(dsd_opts* opts, dsd_state* state, uint8_t slot, cons
     }
 }
 
+// With DSD_NEO_VOCODER_THREAD the slot's vocoder lane still holds the last frames of a call that
+// has ended. They are played and recorded before the call's row is committed -- which closes and
+// renames its WAV -- so they land in that call's recording instead of leading the next one. Runs
+// before the call-state lock is taken: routing the frames to the audio graph reads the slot's call.
+static void
+watchdog_event_drain_ended_voice(dsd_opts* opts, dsd_state* state, uint8_t slot) {
+    if (dsd_vocoder_drain_hook_pending(state, slot) == 0) {
+        return;
+    }
+    dsd_call_snapshot call;
+    if (dsd_call_state_get(state, slot, &call) > 0 && call.phase == DSD_CALL_PHASE_ENDED) {
+        dsd_vocoder_drain_hook_drain(opts, state, slot);
+    }
+}
+
 // run once per loop to check for and push and update event history
 void
 watchdog_event_history(dsd_opts* opts, dsd_state* state, uint8_t slot) {
     if (!opts || !state || !state->event_history_s || slot > 1U) {
         return;
     }
+    watchdog_event_drain_ended_voice(opts, state, slot);
     dsd_call_state_ext* ext = dsd_call_state_ext_get(state, 0);
     if (!ext) {
         return;
@@ -1826,6 +1843,7 @@ watchdog_event_current(const dsd_opts* opts, dsd_state* state, uint8_t slot) {
     if (!opts || !state || !state->event_history_s || slot > 1U) {
         return;
     }
+    watchdog_event_drain_ended_voice((dsd_opts*)opts, state, slot);
     dsd_call_state_ext* ext = dsd_call_state_ext_get(state, 0);
     if (!ext) {
         return;
@@ -1840,6 +1858,7 @@ dsd_event_sync_slot(dsd_opts* opts, dsd_state* state, uint8_t slot) {
     if (!opts || !state || !state->event_history_s || slot > 1U) {
         return;
     }
+    watchdog_event_drain_ended_voice(opts, state, slot);
     dsd_call_state_ext* ext = dsd_call_state_ext_get(state, 0);
     if (!ext) {
         return;
@@ -1950,6 +1969,9 @@ dsd_event_emit_call_notice_impl(dsd_opts* opts, dsd_state* state, uint8_t slot,
     if (!opts || !state || !state->event_history_s || !call || call->epoch == 0U || !detail || slot > 1U) {
         return -1;
     }
+    if (finalize_call) {
+        watchdog_event_drain_ended_voice(opts, state, slot);
+    }
     dsd_call_state_ext* ext = dsd_call_state_ext_get(state, 0);
     watchdog_event_lock_if_present(ext);
     dsd_call_event_lifecycle* lifecycle = ext ? &ext->events[slot] : NULL;
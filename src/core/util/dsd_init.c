@@ -512,6 +512,8 @@ init_state_audio_output_buffers(dsd_state* state) {
     state->audio_out_idx2R = 0;
     state->audio_out_temp_buf_p = state->audio_out_temp_buf;
     state->audio_out_temp_buf_pR = state->audio_out_temp_bufR;
+    DSD_MEMSET(state->audio_upsample_hist, 0, sizeof(state->audio_upsample_hist));
+    DSD_MEMSET(state->audio_upsample_histR, 0, sizeof(state->audio_upsample_histR));
 }
 
 static void
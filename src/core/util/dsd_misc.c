@@ -15,6 +15,7 @@
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/fec/trellis.h>
 #include <dsd-neo/fec/viterbi.h>
+#include <dsd-neo/fec/viterbi_k5.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -97,19 +98,47 @@ trellis_decode(uint8_t result[], const uint8_t source[], int result_len) {
  * Boston, MA 02110-1301, USA.
  */
 
-//Ripped from libM17
-#define K          5              //constraint length
-#define NUM_STATES (1 << (K - 1)) //number of states
+//Ripped from libM17; the trellis itself now lives in fec/viterbi_k5.c
+enum { VITERBI_HISTORY_STEPS = 244, VITERBI_BRANCH_FULL = 0x1FFFE };
 
-static uint32_t prevMetrics[NUM_STATES];
-static uint32_t currMetrics[NUM_STATES];
-static uint32_t prevMetricsData[NUM_STATES];
-static uint32_t currMetricsData[NUM_STATES];
-static uint16_t viterbi_history[244];
+/* Context behind the piecewise viterbi_decode_bit()/viterbi_chainback() API. */
+static dsd_viterbi_k5 g_viterbi_legacy;
+
+static void
+viterbi_step_soft(dsd_viterbi_k5* v, uint16_t s0, uint16_t s1) {
+    uint32_t bm[4];
+    for (unsigned int p = 0; p < 4U; p++) {
+        bm[p] = (uint32_t)q_abs_diff((p & 2U) ? 0xFFFF : 0, s0) + q_abs_diff((p & 1U) ? 0xFFFF : 0, s1);
+    }
+    (void)dsd_viterbi_k5_step(v, bm);
+}
+
+static uint32_t
+viterbi_finish(const dsd_viterbi_k5* v, uint8_t* out, uint16_t len) {
+    /* This decoder path assumes a terminated trellis (tail bits), whose final
+     * encoder state is zero. The last decision lands at bit len + 3. */
+    uint8_t bits[DSD_VITERBI_K5_MAX_STEPS];
+    const size_t n = dsd_viterbi_k5_traceback(v, bits, v->steps);
+
+    DSD_MEMSET(out, 0, (len - 1) / 8 + 1);
+    for (size_t j = 0; j < n; j++) {
+        if (!bits[j] || (size_t)len + 4U < n - j) {
+            continue;
+        }
+        const size_t bitPos = (size_t)len + 4U - (n - j);
+        out[bitPos / 8] |= (uint8_t)(1U << (7 - (bitPos % 8)));
+    }
+
+    //debug
+
+    return dsd_viterbi_k5_best_metric(v);
+}
 
 /**
 * @brief Decode unpunctured convolutionally encoded data.
 *
+* Reentrant: the trellis state lives on the caller's stack.
+*
 * @param out Destination array where decoded data is written.
 * @param in Input data.
 * @param len Input length in bits.
@@ -117,25 +146,16 @@ static uint16_t viterbi_history[244];
 */
 uint32_t
 viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len) {
-    if (len > 244 * 2) {
+    if (len > VITERBI_HISTORY_STEPS * 2) {
         DSD_FPRINTF(stderr, "Input size exceeds max history\n");
     }
 
-    viterbi_reset();
-
-    size_t pos = 0;
+    dsd_viterbi_k5 v;
+    dsd_viterbi_k5_reset(&v, VITERBI_BRANCH_FULL);
     for (size_t i = 0; i + 1 < len; i += 2) {
-        uint16_t s0 = in[i];
-        uint16_t s1 = in[i + 1];
-
-        viterbi_decode_bit(s0, s1, pos);
-        pos++;
+        viterbi_step_soft(&v, in[i], in[i + 1]);
     }
-    uint32_t err = viterbi_chainback(out, pos, len / 2);
-
-    //debug
-
-    return err;
+    return viterbi_finish(&v, out, len / 2);
 }
 
 /**
@@ -151,14 +171,14 @@ viterbi_decode(uint8_t* out, const uint16_t* in, const uint16_t len) {
 uint32_t
 viterbi_decode_punctured(uint8_t* out, const uint16_t* in, const uint8_t* punct, const uint16_t in_len,
                          const uint16_t p_len) {
-    if (in_len > 244 * 2) {
+    if (in_len > VITERBI_HISTORY_STEPS * 2) {
         DSD_FPRINTF(stderr, "Input size exceeds max history\n");
     }
 
-    uint16_t umsg[244 * 2] = {0}; //unpunctured message
-    uint8_t p = 0;                //puncturer matrix entry
-    uint16_t u = 0;               //bits count - unpunctured message
-    uint16_t i = 0;               //bits read from the input message
+    uint16_t umsg[VITERBI_HISTORY_STEPS * 2] = {0}; //unpunctured message
+    uint8_t p = 0;                                  //puncturer matrix entry
+    uint16_t u = 0;                                 //bits count - unpunctured message
+    uint16_t i = 0;                                 //bits read from the input message
 
     while (i < in_len) {
         if (punct[p]) {
@@ -181,53 +201,20 @@ viterbi_decode_punctured(uint8_t* out, const uint16_t* in, const uint8_t* punct,
 /**
 * @brief Decode one bit and update trellis.
 *
+* Shares one process-wide context; use viterbi_decode() or the dsd_viterbi_k5
+* API from concurrent decoders.
+*
 * @param s0 Cost of the first symbol.
 * @param s1 Cost of the second symbol.
 * @param pos Bit position in history.
 */
 void
 viterbi_decode_bit(uint16_t s0, uint16_t s1, const size_t pos) {
-    static const uint16_t COST_TABLE_0[] = {0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
-    static const uint16_t COST_TABLE_1[] = {0, 0xFFFF, 0xFFFF, 0, 0, 0xFFFF, 0xFFFF, 0};
-
-    for (int i = 0; i < NUM_STATES / 2; i++) {
-        uint32_t metric = q_abs_diff(COST_TABLE_0[i], s0) + q_abs_diff(COST_TABLE_1[i], s1);
-
-        uint32_t m0 = prevMetrics[i] + metric;
-        uint32_t m1 = prevMetrics[i + NUM_STATES / 2] + (0x1FFFE - metric);
-
-        uint32_t m2 = prevMetrics[i] + (0x1FFFE - metric);
-        uint32_t m3 = prevMetrics[i + NUM_STATES / 2] + metric;
-
-        int i0 = 2 * i;
-        int i1 = i0 + 1;
-
-        if (m0 >= m1) {
-            viterbi_history[pos] |= (1 << i0);
-            currMetrics[i0] = m1;
-        } else {
-            viterbi_history[pos] &= ~(1 << i0);
-            currMetrics[i0] = m0;
-        }
-
-        if (m2 >= m3) {
-            viterbi_history[pos] |= (1 << i1);
-            currMetrics[i1] = m3;
-        } else {
-            viterbi_history[pos] &= ~(1 << i1);
-            currMetrics[i1] = m2;
-        }
-    }
-
-    //swap
-    uint32_t tmp[NUM_STATES];
-    for (int i = 0; i < NUM_STATES; i++) {
-        tmp[i] = currMetrics[i];
-    }
-    for (int i = 0; i < NUM_STATES; i++) {
-        currMetrics[i] = prevMetrics[i];
-        prevMetrics[i] = tmp[i];
+    if (pos >= (size_t)DSD_VITERBI_K5_MAX_STEPS) {
+        return;
     }
+    g_viterbi_legacy.steps = pos;
+    viterbi_step_soft(&g_viterbi_legacy, s0, s1);
 }
 
 /**
@@ -240,33 +227,8 @@ viterbi_decode_bit(uint16_t s0, uint16_t s1, const size_t pos) {
 */
 uint32_t
 viterbi_chainback(uint8_t* out, size_t pos, uint16_t len) {
-    /* This decoder path assumes a terminated trellis (tail bits), whose final
-     * encoder state is zero. */
-    uint8_t state = 0;
-    size_t bitPos = len + 4;
-
-    DSD_MEMSET(out, 0, (len - 1) / 8 + 1);
-
-    while (pos > 0) {
-        bitPos--;
-        pos--;
-        uint16_t bit = viterbi_history[pos] & ((1 << (state >> (9 - K))));
-        state >>= 1;
-        if (bit) {
-            state |= 0x80;
-            out[bitPos / 8] |= 1 << (7 - (bitPos % 8));
-        }
-    }
-
-    //debug
-
-    uint32_t best_cost = prevMetrics[0];
-    for (size_t i = 1; i < NUM_STATES; i++) {
-        if (prevMetrics[i] < best_cost) {
-            best_cost = prevMetrics[i];
-        }
-    }
-    return best_cost;
+    g_viterbi_legacy.steps = (pos > (size_t)DSD_VITERBI_K5_MAX_STEPS) ? (size_t)DSD_VITERBI_K5_MAX_STEPS : pos;
+    return viterbi_finish(&g_viterbi_legacy, out, len);
 }
 
 /**
@@ -275,11 +237,8 @@ viterbi_chainback(uint8_t* out, size_t pos, uint16_t len) {
  */
 void
 viterbi_reset(void) {
-    DSD_MEMSET((uint8_t*)viterbi_history, 0, sizeof(viterbi_history));
-    DSD_MEMSET((uint8_t*)currMetrics, 0, sizeof(currMetrics));
-    DSD_MEMSET((uint8_t*)prevMetrics, 0, sizeof(prevMetrics));
-    DSD_MEMSET((uint8_t*)currMetricsData, 0, sizeof(currMetricsData));
-    DSD_MEMSET((uint8_t*)prevMetricsData, 0, sizeof(prevMetricsData));
+    dsd_viterbi_k5_reset(&g_viterbi_legacy, VITERBI_BRANCH_FULL);
+    DSD_MEMSET(g_viterbi_legacy.decisions, 0, sizeof(g_viterbi_legacy.decisions));
 }
 
 uint16_t
@@ -30,6 +30,7 @@
 #include <dsd-neo/core/string_utils.h>
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/core/vocoder.h>
+#include <dsd-neo/core/vocoder_worker.h>
 #include <dsd-neo/crypto/aes.h>
 #include <dsd-neo/crypto/des.h>
 #include <dsd-neo/crypto/dmr_keystream.h>
@@ -322,14 +323,124 @@ typedef struct {
     char ambe_d[49];
     int vertex_ks_applied_l;
     int vertex_ks_applied_r;
+    unsigned int post_flags; /* post-stage plan of the audio in hand, when post_planned */
+    int post_planned;
 } mbe_frame_ctx_t;
 
+/*
+ * Post-stage decisions for one frame. They are made while the frame's call state is current and ride through
+ * the vocoder lane with it, so the audio that comes back is played, recorded and saved by its own decisions.
+ */
+enum {
+    MBE_POST_MONO_LEFT = 1U << 0,       /* X2-TDMA and D-STAR mono staging */
+    MBE_POST_MONO_LEFT_ERRS_R = 1U << 1, /* X2-TDMA slot 2 counts the right slot's errors */
+    MBE_POST_LEFT = 1U << 2,            /* stereo or DMR mono left slot path */
+    MBE_POST_LEFT_PLAY = 1U << 3,
+    MBE_POST_RIGHT = 1U << 4,
+    MBE_POST_RIGHT_PLAY = 1U << 5,
+    MBE_POST_OTHER = 1U << 6, /* single-output path */
+    MBE_POST_OTHER_PLAY = 1U << 7,
+    MBE_POST_OTHER_RIGHT = 1U << 8, /* P25p2 slot 2 output buffers */
+    MBE_POST_WAV_LEFT = 1U << 9,
+    MBE_POST_WAV_RIGHT = 1U << 10,
+    MBE_POST_SAVE_BITS = 1U << 11, /* the frame's bits go to the .amb/.imb file */
+};
+
+static unsigned int mbe_post_plan_frame(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx);
+
+static void
+mbe_frame_meta_init(dsd_vocoder_frame_meta* meta, int kind, const char* bits, size_t nbits) {
+    DSD_MEMSET(meta, 0, sizeof(*meta));
+    meta->kind = kind;
+    if (bits != NULL) {
+        DSD_MEMCPY(meta->bits, bits, nbits);
+    }
+}
+
+/* Add the post-stage plan to a frame's metadata before it is synthesized. */
+static void
+mbe_frame_meta_plan(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx, dsd_vocoder_frame_meta* meta) {
+    meta->post_flags |= mbe_post_plan_frame(opts, state, frame_ctx);
+}
+
+/*
+ * Synthesize a frame on its slot's parameter history. With DSD_NEO_VOCODER_THREAD the frame is queued on the
+ * slot's vocoder lane and a frame the lane queued a burst earlier comes back instead: meta, result and aout_buf
+ * then describe that frame.
+ */
+static int
+mbe_synthesize_frame(dsd_state* state, int slot, dsd_vocoder_frame_meta* meta, float* aout_buf,
+                     mbe_process_result* result) {
+    dsd_vocoder_worker* worker = dsd_vocoder_worker_for_state(state);
+    if (worker != NULL) {
+        return dsd_vocoder_worker_exchange(worker, slot, meta, result, aout_buf);
+    }
+    mbe_parms* cur_mp = (slot == 1) ? state->cur_mp2 : state->cur_mp;
+    mbe_parms* prev_mp = (slot == 1) ? state->prev_mp2 : state->prev_mp;
+    mbe_parms* prev_mp_enhanced = (slot == 1) ? state->prev_mp_enhanced2 : state->prev_mp_enhanced;
+    if (meta->kind == DSD_VOCODER_FRAME_AMBE2450) {
+        return mbe_processAmbe2450Dataf(aout_buf, result, meta->bits, cur_mp, prev_mp, prev_mp_enhanced);
+    }
+    if (meta->kind == DSD_VOCODER_FRAME_IMBE4400) {
+        return mbe_processImbe4400Dataf(aout_buf, result, meta->bits, cur_mp, prev_mp, prev_mp_enhanced);
+    }
+    return MBE_STATUS_INVALID_BITS;
+}
+
+static void
+mbe_frame_ctx_take_plan(mbe_frame_ctx_t* frame_ctx, const dsd_vocoder_frame_meta* meta) {
+    frame_ctx->post_flags = meta->post_flags;
+    frame_ctx->post_planned = 1;
+}
+
+static void
+mbe_save_x2_frame(dsd_opts* opts, dsd_state* state, int slot, char ambe_d[49]) {
+    /* X2 records both timeslots in one interleaved .amb stream. */
+    int saved_errs2 = state->errs2;
+
+    if (slot == 1) {
+        state->errs2 = state->errs2R;
+    }
+    saveAmbe2450Data(opts, state, ambe_d);
+    state->errs2 = saved_errs2;
+}
+
+/* The .amb/.imb record of a frame whose audio came back, when its decoder asked for one. */
+static void
+mbe_save_frame_bits(dsd_opts* opts, dsd_state* state, int slot, dsd_vocoder_frame_meta* meta) {
+    if ((meta->post_flags & MBE_POST_SAVE_BITS) == 0U) {
+        return;
+    }
+    if (meta->kind == DSD_VOCODER_FRAME_IMBE4400) {
+        if (opts->mbe_out_f != NULL) {
+            saveImbe4400Data(opts, state, meta->bits);
+        }
+        return;
+    }
+    if (meta->kind != DSD_VOCODER_FRAME_AMBE2450) {
+        return;
+    }
+    if ((meta->post_flags & MBE_POST_MONO_LEFT) != 0U) {
+        if (opts->mbe_out_f != NULL) {
+            mbe_save_x2_frame(opts, state, slot, meta->bits);
+        }
+    } else if (slot == 1) {
+        if (opts->mbe_out_fR != NULL) {
+            saveAmbe2450DataR(opts, state, meta->bits);
+        }
+    } else if (opts->mbe_out_f != NULL) {
+        saveAmbe2450Data(opts, state, meta->bits);
+    }
+}
+
 static void
 mbe_prepare_frame_state(dsd_state* state, mbe_frame_ctx_t* frame_ctx, dsd_vocoder_soft_bit imbe7100_soft_fr[7][24],
                         const dsd_call_snapshot* call) {
     (void)imbe7100_soft_fr;
     frame_ctx->vertex_ks_applied_l = 0;
     frame_ctx->vertex_ks_applied_r = 0;
+    frame_ctx->post_flags = 0U;
+    frame_ctx->post_planned = 0;
 
     (void)dsd_dmr_apply_forced_algid(state);
 
@@ -396,48 +507,26 @@ mbe_init_p25p1_multicrypt_keystream(dsd_state* state, const uint8_t aes_key[32])
     }
 }
 
-static void
-mbe_pack_imbe_bits(char imbe_d[88], uint8_t packed[11]) {
-    int z = 0;
-    for (int i = 0; i < 11; i++) {
-        packed[i] = 0;
-        for (int j = 0; j < 8; j++) {
-            packed[i] = (uint8_t)((packed[i] << 1) + imbe_d[z]);
-            imbe_d[z] = 0;
-            z++;
-        }
-    }
-}
-
-static void
-mbe_unpack_imbe_bits(char imbe_d[88], uint8_t packed[11]) {
-    int z = 0;
-    for (int i = 0; i < 11; i++) {
-        for (int j = 0; j < 8; j++) {
-            imbe_d[z++] = (packed[i] & 0x80) >> 7;
-            packed[i] = (uint8_t)(packed[i] << 1);
-        }
-    }
+/* Offset of the next keystream octet, or the buffer size when it runs past the end. */
+static size_t
+mbe_ks_octet_offset(int octet_counter, size_t ks_size) {
+    return (octet_counter < 0 || (size_t)octet_counter > ks_size) ? ks_size : (size_t)octet_counter;
 }
 
 static void
 mbe_apply_p25p1_multicrypt(dsd_state* state, char imbe_d[88]) {
-    uint8_t cipher[11];
-    uint8_t plain[11];
-    DSD_MEMSET(cipher, 0, sizeof(cipher));
-    DSD_MEMSET(plain, 0, sizeof(plain));
-
     uint8_t aes_key[32];
     DSD_MEMSET(aes_key, 0, sizeof(aes_key));
 
     mbe_load_aes_key_slot0(state, aes_key);
     mbe_init_p25p1_multicrypt_keystream(state, aes_key);
-    mbe_pack_imbe_bits(imbe_d, cipher);
 
-    for (int i = 0; i < 11; i++) {
-        plain[i] = cipher[i] ^ state->ks_octetL[state->octet_counter++];
-    }
-    mbe_unpack_imbe_bits(imbe_d, plain);
+    dsd_bitvec frame;
+    dsd_bitvec_from_bits(&frame, imbe_d, 88U);
+    const size_t offset = mbe_ks_octet_offset(state->octet_counter, sizeof(state->ks_octetL));
+    dsd_bitvec_xor_octets(&frame, state->ks_octetL + offset, sizeof(state->ks_octetL) - offset, 0U);
+    state->octet_counter += 11;
+    dsd_bitvec_to_bits(&frame, imbe_d);
 }
 
 static void
@@ -465,30 +554,15 @@ mbe_apply_p25p1_rc4(dsd_state* state, char imbe_d[88]) {
     rckey[11] = ((state->payload_miP & 0xFF00) >> 8);
     rckey[12] = ((state->payload_miP & 0xFF) >> 0);
 
-    //load imbe_d into imbe_cipher octets
-    int z = 0;
-    for (int i = 0; i < 11; i++) {
-        cipher[i] = 0;
-        plain[i] = 0;
-        for (short int j = 0; j < 8; j++) {
-            cipher[i] = cipher[i] << 1;
-            cipher[i] = cipher[i] + imbe_d[z];
-            imbe_d[z] = 0;
-            z++;
-        }
-    }
+    dsd_bitvec frame;
+    dsd_bitvec_from_bits(&frame, imbe_d, 88U);
+    (void)dsd_bitvec_to_octets(&frame, cipher, sizeof(cipher));
 
     rc4_voice_decrypt(state->dropL, 13, 11, rckey, cipher, plain);
     state->dropL += 11;
 
-    z = 0;
-    for (short p = 0; p < 11; p++) {
-        for (short o = 0; o < 8; o++) {
-            imbe_d[z] = (plain[p] & 0x80) >> 7;
-            plain[p] = plain[p] << 1;
-            z++;
-        }
-    }
+    dsd_bitvec_from_octets(&frame, plain, 88U);
+    dsd_bitvec_to_bits(&frame, imbe_d);
 }
 
 static int
@@ -537,14 +611,42 @@ mbe_p25p1_record_accepted_frame(dsd_state* state, int corrections, unsigned proc
     }
 }
 
+/* Synthesize a P25p1 frame (or its erasure) and report the frame whose audio comes back. */
+static void
+mbe_finish_p25p1_frame(dsd_opts* opts, dsd_state* state, mbe_frame_ctx_t* frame_ctx, dsd_vocoder_frame_meta* meta,
+                       mbe_process_result* imbe_result) {
+    mbe_frame_meta_plan(opts, state, frame_ctx, meta);
+    int process_ret = mbe_synthesize_frame(state, 0, meta, state->audio_out_temp_buf, imbe_result);
+    (void)store_process_result(process_ret, state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
+                               sizeof(state->err_str), imbe_result);
+    mbe_frame_ctx_take_plan(frame_ctx, meta);
+    if (meta->kind != DSD_VOCODER_FRAME_IMBE4400) {
+        return;
+    }
+    mbe_p25p1_record_accepted_frame(state, meta->decode_errors, imbe_result->flags);
+    update_p25_p1_voice_err_hist(state);
+
+    if (dsd_frame_detail_enabled(opts)) {
+        PrintIMBEData(opts, state, meta->bits);
+    }
+}
+
+static void
+mbe_store_undecodable_p25p1(dsd_opts* opts, dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
+    dsd_vocoder_frame_meta meta;
+    mbe_process_result result;
+    mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_ERASURE, NULL, 0U);
+    DSD_MEMSET(&result, 0, sizeof(result));
+    mbe_finish_p25p1_frame(opts, state, frame_ctx, &meta, &result);
+}
+
 static void
 mbe_process_p25p1(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], dsd_vocoder_soft_bit imbe_soft_fr[8][23],
                   mbe_frame_ctx_t* frame_ctx) {
     mbe_process_result imbe_result;
     int have_imbe_result = decode_imbe7200_frame(state, imbe_fr, imbe_soft_fr, frame_ctx->imbe_d, &imbe_result);
     if (!have_imbe_result) {
-        store_process_result(MBE_STATUS_INVALID_BITS, state->audio_out_temp_buf, &state->errs, &state->errs2,
-                             state->err_str, sizeof(state->err_str), NULL);
+        mbe_store_undecodable_p25p1(opts, state, frame_ctx);
         return;
     }
 
@@ -555,10 +657,9 @@ mbe_process_p25p1(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], dsd_voc
         }
         dsd_frame_logf(opts, "FRAME EVENT slot=1 type=P25P1_TAIL_ERASURE action=mute excluded_corrections=%d",
                        decoded_corrections);
-        mbe_synthesizeSilencef(state->audio_out_temp_buf);
         state->p25_p1_suppressed_tail_frames++;
         state->p25_p1_excluded_tail_corrections += (uint64_t)decoded_corrections;
-        clear_mbe_status(&state->errs, &state->errs2, state->err_str, sizeof(state->err_str));
+        mbe_store_undecodable_p25p1(opts, state, frame_ctx);
         state->p25vc++;
         return;
     }
@@ -578,23 +679,16 @@ mbe_process_p25p1(dsd_opts* opts, dsd_state* state, char imbe_fr[8][23], dsd_voc
 
     (void)dsd_mbe_strip_imbe_context_if_changed(decoded_imbe_d, frame_ctx->imbe_d, &imbe_result);
 
-    int process_ret = mbe_processImbe4400Dataf(state->audio_out_temp_buf, &imbe_result, frame_ctx->imbe_d,
-                                               state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
-    (void)store_process_result(process_ret, state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
-                               sizeof(state->err_str), &imbe_result);
-    mbe_p25p1_record_accepted_frame(state, decoded_corrections, imbe_result.flags);
-    update_p25_p1_voice_err_hist(state);
-
-    if (dsd_frame_detail_enabled(opts)) {
-        PrintIMBEData(opts, state, frame_ctx->imbe_d);
-    }
+    dsd_vocoder_frame_meta meta;
+    mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_IMBE4400, frame_ctx->imbe_d, sizeof(frame_ctx->imbe_d));
+    meta.decode_errors = decoded_corrections;
+    meta.post_flags = MBE_POST_SAVE_BITS;
+    mbe_finish_p25p1_frame(opts, state, frame_ctx, &meta, &imbe_result);
 
     //increment vc counter by one.
     state->p25vc++;
 
-    if (opts->mbe_out_f != NULL) {
-        saveImbe4400Data(opts, state, frame_ctx->imbe_d);
-    }
+    mbe_save_frame_bits(opts, state, 0, &meta);
 }
 
 static void
@@ -642,57 +736,39 @@ mbe_process_dstar(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], mbe_fra
     }
 }
 
-static void
-mbe_save_x2_frame(dsd_opts* opts, dsd_state* state, char ambe_d[49]) {
-    /* X2 records both timeslots in one interleaved .amb stream. */
-    int saved_errs2 = state->errs2;
-
-    if (state->currentslot == 1) {
-        state->errs2 = state->errs2R;
-    }
-    saveAmbe2450Data(opts, state, ambe_d);
-    state->errs2 = saved_errs2;
-}
-
 static void
 mbe_process_x2(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd_vocoder_soft_bit ambe_soft_fr[4][24],
                mbe_frame_ctx_t* frame_ctx) {
-    int* errs = &state->errs;
-    int* errs2 = &state->errs2;
-    char* err_str = state->err_str;
-    mbe_parms* cur_mp = state->cur_mp;
-    mbe_parms* prev_mp = state->prev_mp;
-    mbe_parms* prev_mp_enhanced = state->prev_mp_enhanced;
-
-    if (state->currentslot == 1) {
-        errs = &state->errsR;
-        errs2 = &state->errs2R;
-        err_str = state->err_strR;
-        cur_mp = state->cur_mp2;
-        prev_mp = state->prev_mp2;
-        prev_mp_enhanced = state->prev_mp_enhanced2;
-    }
+    const int slot = (state->currentslot == 1) ? 1 : 0;
+    int* errs = (slot == 1) ? &state->errsR : &state->errs;
+    int* errs2 = (slot == 1) ? &state->errs2R : &state->errs2;
+    char* err_str = (slot == 1) ? state->err_strR : state->err_str;
 
     mbe_process_result ambe_result;
+    dsd_vocoder_frame_meta meta;
     int have_ambe_result = decode_ambe2450_frame(errs, errs2, ambe_fr, ambe_soft_fr, frame_ctx->ambe_d, &ambe_result);
-    if (!have_ambe_result) {
-        store_process_result(MBE_STATUS_INVALID_BITS, state->audio_out_temp_buf, errs, errs2, err_str,
-                             sizeof(state->err_str), NULL);
-        return;
+    if (have_ambe_result) {
+        mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_AMBE2450, frame_ctx->ambe_d, sizeof(frame_ctx->ambe_d));
+        meta.post_flags = MBE_POST_SAVE_BITS;
+    } else {
+        mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_ERASURE, NULL, 0U);
+        DSD_MEMSET(&ambe_result, 0, sizeof(ambe_result));
     }
 
     /* X2 is a mono output mode even though each timeslot keeps independent decoder history. */
-    int process_ret = mbe_processAmbe2450Dataf(state->audio_out_temp_buf, &ambe_result, frame_ctx->ambe_d, cur_mp,
-                                               prev_mp, prev_mp_enhanced);
+    mbe_frame_meta_plan(opts, state, frame_ctx, &meta);
+    int process_ret = mbe_synthesize_frame(state, slot, &meta, state->audio_out_temp_buf, &ambe_result);
     (void)store_process_result(process_ret, state->audio_out_temp_buf, errs, errs2, err_str, sizeof(state->err_str),
                                &ambe_result);
+    mbe_frame_ctx_take_plan(frame_ctx, &meta);
+    if (meta.kind != DSD_VOCODER_FRAME_AMBE2450) {
+        return;
+    }
 
     if (dsd_frame_detail_enabled(opts)) {
-        PrintAMBEData(opts, state, frame_ctx->ambe_d);
-    }
-    if (opts->mbe_out_f != NULL) {
-        mbe_save_x2_frame(opts, state, frame_ctx->ambe_d);
+        PrintAMBEData(opts, state, meta.bits);
     }
+    mbe_save_frame_bits(opts, state, slot, &meta);
 }
 
 static void
@@ -828,36 +904,65 @@ mbe_dmr_output_slot_enabled(const dsd_opts* opts, const dsd_state* state, int sl
     return state->dmr_mono_slot == slot;
 }
 
+/*
+ * Synthesize a slot or NXDN AMBE 2450 frame (or its erasure) and report the frame whose audio comes back: its
+ * errors, its bits and, when its decoder asked for it, its .amb record.
+ */
 static void
-mbe_finalize_slot_left(dsd_opts* opts, dsd_state* state, char ambe_d[49], mbe_process_result* ambe_result) {
-    int ret = mbe_processAmbe2450Dataf(state->audio_out_temp_buf, ambe_result, ambe_d, state->cur_mp, state->prev_mp,
-                                       state->prev_mp_enhanced);
-    (void)store_process_result(ret, state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
-                               sizeof(state->err_str), ambe_result);
-    p25p2_record_voice_err(state, state->errs2);
-    if (dsd_frame_detail_enabled(opts)) {
-        PrintAMBEData(opts, state, ambe_d);
+mbe_finish_ambe2450_slot_frame(dsd_opts* opts, dsd_state* state, int slot, mbe_frame_ctx_t* frame_ctx,
+                               dsd_vocoder_frame_meta* meta, mbe_process_result* ambe_result) {
+    mbe_frame_meta_plan(opts, state, frame_ctx, meta);
+    if (slot == 1) {
+        int ret = mbe_synthesize_frame(state, 1, meta, state->audio_out_temp_bufR, ambe_result);
+        (void)store_process_result(ret, state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR,
+                                   sizeof(state->err_strR), ambe_result);
+    } else {
+        int ret = mbe_synthesize_frame(state, 0, meta, state->audio_out_temp_buf, ambe_result);
+        (void)store_process_result(ret, state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
+                                   sizeof(state->err_str), ambe_result);
     }
-    if (mbe_dmr_output_slot_enabled(opts, state, 0) && opts->mbe_out_f != NULL
-        && (state->dmr_encL == 0 || opts->dmr_mute_encL == 0)) {
-        saveAmbe2450Data(opts, state, ambe_d);
+    mbe_frame_ctx_take_plan(frame_ctx, meta);
+    if (meta->kind != DSD_VOCODER_FRAME_AMBE2450) {
+        return;
     }
+
+    p25p2_record_voice_err(state, (slot == 1) ? state->errs2R : state->errs2);
+    if (dsd_frame_detail_enabled(opts)) {
+        PrintAMBEData(opts, state, meta->bits);
+    }
+    mbe_save_frame_bits(opts, state, slot, meta);
 }
 
+/* An undecodable frame: silence, or an earlier frame of the lane when synthesis is queued. */
 static void
-mbe_finalize_slot_right(dsd_opts* opts, dsd_state* state, char ambe_d[49], mbe_process_result* ambe_result) {
-    int ret = mbe_processAmbe2450Dataf(state->audio_out_temp_bufR, ambe_result, ambe_d, state->cur_mp2, state->prev_mp2,
-                                       state->prev_mp_enhanced2);
-    (void)store_process_result(ret, state->audio_out_temp_bufR, &state->errsR, &state->errs2R, state->err_strR,
-                               sizeof(state->err_strR), ambe_result);
-    p25p2_record_voice_err(state, state->errs2R);
-    if (dsd_frame_detail_enabled(opts)) {
-        PrintAMBEData(opts, state, ambe_d);
+mbe_store_undecodable_ambe2450(dsd_opts* opts, dsd_state* state, int slot, mbe_frame_ctx_t* frame_ctx) {
+    dsd_vocoder_frame_meta meta;
+    mbe_process_result result;
+    mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_ERASURE, NULL, 0U);
+    DSD_MEMSET(&result, 0, sizeof(result));
+    mbe_finish_ambe2450_slot_frame(opts, state, slot, frame_ctx, &meta, &result);
+}
+
+/* The .amb gate reads the slot's encryption state from before this frame's post-stage decisions. */
+static void
+mbe_finalize_slot_left(dsd_opts* opts, dsd_state* state, mbe_frame_ctx_t* frame_ctx, mbe_process_result* ambe_result) {
+    dsd_vocoder_frame_meta meta;
+    mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_AMBE2450, frame_ctx->ambe_d, sizeof(frame_ctx->ambe_d));
+    if (mbe_dmr_output_slot_enabled(opts, state, 0) && (state->dmr_encL == 0 || opts->dmr_mute_encL == 0)) {
+        meta.post_flags |= MBE_POST_SAVE_BITS;
     }
-    if (mbe_dmr_output_slot_enabled(opts, state, 1) && opts->mbe_out_fR != NULL
-        && (state->dmr_encR == 0 || opts->dmr_mute_encR == 0)) {
-        saveAmbe2450DataR(opts, state, ambe_d);
+    mbe_finish_ambe2450_slot_frame(opts, state, 0, frame_ctx, &meta, ambe_result);
+}
+
+static void
+mbe_finalize_slot_right(dsd_opts* opts, dsd_state* state, mbe_frame_ctx_t* frame_ctx,
+                        mbe_process_result* ambe_result) {
+    dsd_vocoder_frame_meta meta;
+    mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_AMBE2450, frame_ctx->ambe_d, sizeof(frame_ctx->ambe_d));
+    if (mbe_dmr_output_slot_enabled(opts, state, 1) && (state->dmr_encR == 0 || opts->dmr_mute_encR == 0)) {
+        meta.post_flags |= MBE_POST_SAVE_BITS;
     }
+    mbe_finish_ambe2450_slot_frame(opts, state, 1, frame_ctx, &meta, ambe_result);
 }
 
 static void
@@ -867,8 +972,7 @@ mbe_process_nxdn(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd_voco
     int have_ambe_result =
         decode_ambe2450_frame(&state->errs, &state->errs2, ambe_fr, ambe_soft_fr, frame_ctx->ambe_d, &ambe_result);
     if (!have_ambe_result) {
-        store_process_result(MBE_STATUS_INVALID_BITS, state->audio_out_temp_buf, &state->errs, &state->errs2,
-                             state->err_str, sizeof(state->err_str), NULL);
+        mbe_store_undecodable_ambe2450(opts, state, 0, frame_ctx);
         return;
     }
 
@@ -887,19 +991,12 @@ mbe_process_nxdn(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd_voco
 
     (void)dsd_mbe_strip_ambe_context_if_changed(decoded_ambe_d, frame_ctx->ambe_d, &ambe_result);
 
-    int process_ret = mbe_processAmbe2450Dataf(state->audio_out_temp_buf, &ambe_result, frame_ctx->ambe_d,
-                                               state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
-    (void)store_process_result(process_ret, state->audio_out_temp_buf, &state->errs, &state->errs2, state->err_str,
-                               sizeof(state->err_str), &ambe_result);
-    p25p2_record_voice_err(state, state->errs2);
-
-    if (dsd_frame_detail_enabled(opts)) {
-        PrintAMBEData(opts, state, frame_ctx->ambe_d);
-    }
-
-    if (opts->mbe_out_f != NULL && (state->dmr_encL == 0 || opts->dmr_mute_encL == 0)) {
-        saveAmbe2450Data(opts, state, frame_ctx->ambe_d);
+    dsd_vocoder_frame_meta meta;
+    mbe_frame_meta_init(&meta, DSD_VOCODER_FRAME_AMBE2450, frame_ctx->ambe_d, sizeof(frame_ctx->ambe_d));
+    if (state->dmr_encL == 0 || opts->dmr_mute_encL == 0) {
+        meta.post_flags |= MBE_POST_SAVE_BITS;
     }
+    mbe_finish_ambe2450_slot_frame(opts, state, 0, frame_ctx, &meta, &ambe_result);
 }
 
 static void
@@ -1004,32 +1101,20 @@ mbeslot_left_apply_des(dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
         state->DMRvcL = 17;
     }
 
-    int z = 0;
     if (state->DMRvcL == 0) {
-        int n = 8;
         DSD_MEMSET(state->ks_octetL, 0, sizeof(state->ks_octetL));
-        DSD_MEMSET(state->ks_bitstreamL, 0, sizeof(state->ks_bitstreamL));
         state->bit_counterL = 0;
         des_ofb_keystream_output(state->payload_miP, state->R, state->ks_octetL, 19); //18 + 1
-
-        for (int i = 0; i < 18 * 8; i++) //19 blocks minus 1 discard block at 8 bits each
-        {
-            for (int j = 0; j < 8; j++) {
-                uint8_t b = (((state->ks_octetL[n] << j) & 0x80) >> 7);
-                state->ks_bitstreamL[z++] = b;
-            }
-            n++;
-        }
     }
 
-    z = 0;
-    for (int i = 0; i < 6; i++) {
-        for (int j = 0; j < 8; j++) {
-            frame_ctx->ambe_d[z++] ^= state->ks_bitstreamL[state->bit_counterL++];
-        }
+    // 49 bits per frame from the 18 blocks after the discard block, skipping 7 between frames
+    dsd_bitvec frame;
+    dsd_bitvec_from_bits(&frame, frame_ctx->ambe_d, 49U);
+    if (state->bit_counterL >= 0) {
+        dsd_bitvec_xor_octets(&frame, state->ks_octetL + 8, sizeof(state->ks_octetL) - 8U, (size_t)state->bit_counterL);
     }
-    frame_ctx->ambe_d[48] ^= state->ks_bitstreamL[state->bit_counterL++];
-    state->bit_counterL += 7;
+    dsd_bitvec_to_bits(&frame, frame_ctx->ambe_d);
+    state->bit_counterL += 56;
     state->DMRvcL++;
 }
 
@@ -1043,30 +1128,20 @@ mbeslot_right_apply_des(dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
         state->DMRvcR = 17;
     }
 
-    int z = 0;
     if (state->DMRvcR == 0) {
-        int n = 8;
         DSD_MEMSET(state->ks_octetR, 0, sizeof(state->ks_octetR));
-        DSD_MEMSET(state->ks_bitstreamR, 0, sizeof(state->ks_bitstreamR));
         state->bit_counterR = 0;
         des_ofb_keystream_output(state->payload_miN, state->RR, state->ks_octetR, 19);
-        for (int i = 0; i < 18 * 8; i++) {
-            for (int j = 0; j < 8; j++) {
-                uint8_t b = (((state->ks_octetR[n] << j) & 0x80) >> 7);
-                state->ks_bitstreamR[z++] = b;
-            }
-            n++;
-        }
     }
 
-    z = 0;
-    for (int i = 0; i < 6; i++) {
-        for (int j = 0; j < 8; j++) {
-            frame_ctx->ambe_d[z++] ^= state->ks_bitstreamR[state->bit_counterR++];
-        }
+    // 49 bits per frame from the 18 blocks after the discard block, skipping 7 between frames
+    dsd_bitvec frame;
+    dsd_bitvec_from_bits(&frame, frame_ctx->ambe_d, 49U);
+    if (state->bit_counterR >= 0) {
+        dsd_bitvec_xor_octets(&frame, state->ks_octetR + 8, sizeof(state->ks_octetR) - 8U, (size_t)state->bit_counterR);
     }
-    frame_ctx->ambe_d[48] ^= state->ks_bitstreamR[state->bit_counterR++];
-    state->bit_counterR += 7;
+    dsd_bitvec_to_bits(&frame, frame_ctx->ambe_d);
+    state->bit_counterR += 56;
     state->DMRvcR++;
 }
 
@@ -1300,7 +1375,6 @@ mbeslot_left_apply_rc4(dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
         DSD_MEMCPY(plain, cipher, sizeof(plain));
     }
     state->dropL += 7;
-    DSD_MEMSET(frame_ctx->ambe_d, 0, 49 * sizeof(char));
     unpack_ambe(plain, frame_ctx->ambe_d);
 }
 
@@ -1337,7 +1411,6 @@ mbeslot_right_apply_rc4(dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
         DSD_MEMCPY(plain, cipher, sizeof(plain));
     }
     state->dropR += 7;
-    DSD_MEMSET(frame_ctx->ambe_d, 0, 49 * sizeof(char));
     unpack_ambe(plain, frame_ctx->ambe_d);
 }
 
@@ -1370,7 +1443,6 @@ mbeslot_left_apply_p25p2_rc4(dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
     pack_ambe(frame_ctx->ambe_d, cipher, 49);
     rc4_voice_decrypt(state->dropL, 13, 7, rckey, cipher, plain);
     state->dropL += 7;
-    DSD_MEMSET(frame_ctx->ambe_d, 0, 49 * sizeof(char));
     unpack_ambe(plain, frame_ctx->ambe_d);
 }
 
@@ -1403,7 +1475,6 @@ mbeslot_right_apply_p25p2_rc4(dsd_state* state, mbe_frame_ctx_t* frame_ctx) {
     pack_ambe(frame_ctx->ambe_d, cipher, 49);
     rc4_voice_decrypt(state->dropR, 13, 7, rckey, cipher, plain);
     state->dropR += 7;
-    DSD_MEMSET(frame_ctx->ambe_d, 0, 49 * sizeof(char));
     unpack_ambe(plain, frame_ctx->ambe_d);
 }
 
@@ -1414,8 +1485,7 @@ mbeslot_process_left(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd_
     int have_ambe_result =
         decode_ambe2450_frame(&state->errs, &state->errs2, ambe_fr, ambe_soft_fr, frame_ctx->ambe_d, &ambe_result);
     if (!have_ambe_result) {
-        store_process_result(MBE_STATUS_INVALID_BITS, state->audio_out_temp_buf, &state->errs, &state->errs2,
-                             state->err_str, sizeof(state->err_str), NULL);
+        mbe_store_undecodable_ambe2450(opts, state, 0, frame_ctx);
         return;
     }
 
@@ -1432,7 +1502,7 @@ mbeslot_process_left(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd_
     mbe_apply_vendor_overlays(state, frame_ctx->ambe_d);
     mbe_slot_apply_straight_ks_left(state, frame_ctx->ambe_d);
     (void)dsd_mbe_strip_ambe_context_if_changed(decoded_ambe_d, frame_ctx->ambe_d, &ambe_result);
-    mbe_finalize_slot_left(opts, state, frame_ctx->ambe_d, &ambe_result);
+    mbe_finalize_slot_left(opts, state, frame_ctx, &ambe_result);
 }
 
 static void
@@ -1442,8 +1512,7 @@ mbeslot_process_right(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd
     int have_ambe_result =
         decode_ambe2450_frame(&state->errsR, &state->errs2R, ambe_fr, ambe_soft_fr, frame_ctx->ambe_d, &ambe_result);
     if (!have_ambe_result) {
-        store_process_result(MBE_STATUS_INVALID_BITS, state->audio_out_temp_bufR, &state->errsR, &state->errs2R,
-                             state->err_strR, sizeof(state->err_strR), NULL);
+        mbe_store_undecodable_ambe2450(opts, state, 1, frame_ctx);
         return;
     }
 
@@ -1460,7 +1529,7 @@ mbeslot_process_right(dsd_opts* opts, dsd_state* state, char ambe_fr[4][24], dsd
     mbe_apply_vendor_overlays(state, frame_ctx->ambe_d);
     mbe_slot_apply_straight_ks_right(state, frame_ctx->ambe_d);
     (void)dsd_mbe_strip_ambe_context_if_changed(decoded_ambe_d, frame_ctx->ambe_d, &ambe_result);
-    mbe_finalize_slot_right(opts, state, frame_ctx->ambe_d, &ambe_result);
+    mbe_finalize_slot_right(opts, state, frame_ctx, &ambe_result);
 }
 
 static void
@@ -1525,15 +1594,16 @@ mbe_post_stereo_active(const dsd_opts* opts, const dsd_state* state) {
     return opts->dmr_stereo == 1 || (DSD_SYNC_IS_DMR(state->synctype) && state->dmr_stereo == 1);
 }
 
-static void
-mbe_post_left_audio(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
+/* Decide the left slot's encryption gate; updates dmr_encL as the slot's current state. */
+static unsigned int
+mbe_post_left_plan(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
     const int dmr_mono_active = mbe_post_dmr_mono_active(opts, state);
     if (dmr_mono_active && !mbe_dmr_output_slot_enabled(opts, state, 0)) {
         state->dmr_encL = 1;
-        return;
+        return 0U;
     }
     if ((!dmr_mono_active && !mbe_post_stereo_active(opts, state)) || state->currentslot != 0) {
-        return;
+        return 0U;
     }
 
     int enc_bit = (state->dmr_so >> 6) & 0x1;
@@ -1544,8 +1614,17 @@ mbe_post_left_audio(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* fra
     mbe_post_apply_forced_clear_gate(state, &state->dmr_encL);
     mbe_post_apply_reverse_mute(opts, &state->dmr_encL, &opts->dmr_mute_encL);
 
+    unsigned int flags = MBE_POST_LEFT;
+    if (state->dmr_encL == 0 || opts->dmr_mute_encL == 0) {
+        flags |= MBE_POST_LEFT_PLAY;
+    }
+    return flags;
+}
+
+static void
+mbe_post_left_audio(dsd_opts* opts, dsd_state* state, unsigned int flags) {
     state->debug_audio_errors += state->errs2;
-    if ((state->dmr_encL == 0 || opts->dmr_mute_encL == 0) && opts->floating_point == 0) {
+    if ((flags & MBE_POST_LEFT_PLAY) != 0U && opts->floating_point == 0) {
         processAudio(opts, state);
     }
     DSD_MEMCPY(state->f_l, state->audio_out_temp_buf, sizeof(state->f_l));
@@ -1566,15 +1645,16 @@ mbe_post_right_apply_decryptability(dsd_state* state, const mbe_frame_ctx_t* fra
     }
 }
 
-static void
-mbe_post_right_audio(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
+/* Decide the right slot's encryption gate; updates dmr_encR as the slot's current state. */
+static unsigned int
+mbe_post_right_plan(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
     const int dmr_mono_active = mbe_post_dmr_mono_active(opts, state);
     if (dmr_mono_active && !mbe_dmr_output_slot_enabled(opts, state, 1)) {
         state->dmr_encR = 1;
-        return;
+        return 0U;
     }
     if ((!dmr_mono_active && !mbe_post_stereo_active(opts, state)) || state->currentslot != 1) {
-        return;
+        return 0U;
     }
 
     int enc_bit = (state->dmr_soR >> 6) & 0x1;
@@ -1585,25 +1665,20 @@ mbe_post_right_audio(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* fr
     mbe_post_apply_forced_clear_gate(state, &state->dmr_encR);
     mbe_post_apply_reverse_mute(opts, &state->dmr_encR, &opts->dmr_mute_encR);
 
-    state->debug_audio_errorsR += state->errs2R;
-    if ((state->dmr_encR == 0 || opts->dmr_mute_encR == 0) && opts->floating_point == 0) {
-        processAudioR(opts, state);
+    unsigned int flags = MBE_POST_RIGHT;
+    if (state->dmr_encR == 0 || opts->dmr_mute_encR == 0) {
+        flags |= MBE_POST_RIGHT_PLAY;
     }
-    DSD_MEMCPY(state->f_r, state->audio_out_temp_bufR, sizeof(state->f_r));
+    return flags;
 }
 
 static void
-mbe_post_other_process_audio(const dsd_opts* opts, dsd_state* state, int is_p25p2) {
-    state->debug_audio_errors += state->errs2;
-    if ((opts->audio_out != 1 && !(opts->wav_out_f != NULL && opts->static_wav_file == 1))
-        || opts->floating_point != 0) {
-        return;
-    }
-    if (is_p25p2 && state->currentslot == 1) {
+mbe_post_right_audio(dsd_opts* opts, dsd_state* state, unsigned int flags) {
+    state->debug_audio_errorsR += state->errs2R;
+    if ((flags & MBE_POST_RIGHT_PLAY) != 0U && opts->floating_point == 0) {
         processAudioR(opts, state);
-    } else {
-        processAudio(opts, state);
     }
+    DSD_MEMCPY(state->f_r, state->audio_out_temp_bufR, sizeof(state->f_r));
 }
 
 static int
@@ -1624,27 +1699,43 @@ mbe_post_other_is_allowed(const dsd_opts* opts, const dsd_state* state, int is_p
     return state->p25_p2_audio_allowed[state->currentslot] != 0;
 }
 
-static void
-mbe_post_other_copy_float_buffer(dsd_state* state, int is_p25p2) {
+static unsigned int
+mbe_post_other_plan(const dsd_opts* opts, const dsd_state* state) {
+    if (mbe_post_dmr_mono_active(opts, state) || mbe_post_stereo_active(opts, state)) {
+        return 0U;
+    }
+
+    int is_p25p2 = DSD_SYNC_IS_P25P2(state->synctype);
+    unsigned int flags = MBE_POST_OTHER;
+    if (mbe_post_other_is_allowed(opts, state, is_p25p2)) {
+        flags |= MBE_POST_OTHER_PLAY;
+    }
     if (is_p25p2 && state->currentslot == 1) {
-        DSD_MEMCPY(state->f_l, state->audio_out_temp_bufR, sizeof(state->audio_out_temp_bufR));
-    } else {
-        DSD_MEMCPY(state->f_l, state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf)); //P25p1 FDMA 8k/1
+        flags |= MBE_POST_OTHER_RIGHT;
     }
+    return flags;
 }
 
 static void
-mbe_post_other_audio(const dsd_opts* opts, dsd_state* state) {
-    if (mbe_post_dmr_mono_active(opts, state) || mbe_post_stereo_active(opts, state)) {
-        return;
+mbe_post_other_audio(const dsd_opts* opts, dsd_state* state, unsigned int flags) {
+    const int right = (flags & MBE_POST_OTHER_RIGHT) != 0U;
+    if ((flags & MBE_POST_OTHER_PLAY) != 0U) {
+        state->debug_audio_errors += state->errs2;
+        if ((opts->audio_out == 1 || (opts->wav_out_f != NULL && opts->static_wav_file == 1))
+            && opts->floating_point == 0) {
+            if (right) {
+                processAudioR(opts, state);
+            } else {
+                processAudio(opts, state);
+            }
+        }
     }
 
-    int is_p25p2 = DSD_SYNC_IS_P25P2(state->synctype);
-    if (mbe_post_other_is_allowed(opts, state, is_p25p2)) {
-        mbe_post_other_process_audio(opts, state, is_p25p2);
+    if (right) {
+        DSD_MEMCPY(state->f_l, state->audio_out_temp_bufR, sizeof(state->audio_out_temp_bufR));
+    } else {
+        DSD_MEMCPY(state->f_l, state->audio_out_temp_buf, sizeof(state->audio_out_temp_buf)); //P25p1 FDMA 8k/1
     }
-
-    mbe_post_other_copy_float_buffer(state, is_p25p2);
 }
 
 static int
@@ -1653,11 +1744,8 @@ mbe_post_uses_mono_left_staging(const dsd_state* state) {
 }
 
 static void
-mbe_post_mono_left_audio(const dsd_opts* opts, dsd_state* state) {
-    int frame_errors = state->errs2;
-    if (DSD_SYNC_IS_X2TDMA(state->synctype) && state->currentslot == 1) {
-        frame_errors = state->errs2R;
-    }
+mbe_post_mono_left_audio(const dsd_opts* opts, dsd_state* state, unsigned int flags) {
+    int frame_errors = ((flags & MBE_POST_MONO_LEFT_ERRS_R) != 0U) ? state->errs2R : state->errs2;
     state->debug_audio_errors += frame_errors;
 
     if (opts->floating_point == 1) {
@@ -1698,52 +1786,120 @@ mbe_post_allow_stereo_slot_wav(const dsd_opts* opts, const dsd_state* state, int
     return (dsd_audio_record_gate_mono(opts, state, &allow_wav) == 0 && allow_wav) ? 1 : 0;
 }
 
-static void
-mbe_post_wav_outputs(dsd_opts* opts, dsd_state* state) {
+static unsigned int
+mbe_post_wav_plan(const dsd_opts* opts, const dsd_state* state) {
     if (DSD_SYNC_IS_X2TDMA(state->synctype)) {
-        if (opts->wav_out_f != NULL) {
-            writeSynthesizedVoice(opts, state);
-        }
-        return;
+        return (opts->wav_out_f != NULL) ? MBE_POST_WAV_LEFT : 0U;
     }
     if (DSD_SYNC_IS_DSTAR(state->synctype)) {
-        if (opts->wav_out_f != NULL && opts->dmr_stereo_wav == 1) {
-            writeSynthesizedVoice(opts, state);
-        }
-        return;
+        return (opts->wav_out_f != NULL && opts->dmr_stereo_wav == 1) ? MBE_POST_WAV_LEFT : 0U;
     }
 
+    unsigned int flags = 0U;
     if (mbe_post_allow_mono_wav(opts, state)) {
         if (mbe_post_dmr_mono_active(opts, state) && state->dmr_mono_slot == 1) {
-            writeSynthesizedVoiceR(opts, state);
+            flags |= MBE_POST_WAV_RIGHT;
         } else {
-            writeSynthesizedVoice(opts, state);
+            flags |= MBE_POST_WAV_LEFT;
         }
     }
     if (mbe_post_allow_stereo_slot_wav(opts, state, 0)) {
-        writeSynthesizedVoice(opts, state);
+        flags |= MBE_POST_WAV_LEFT;
     }
     if (mbe_post_allow_stereo_slot_wav(opts, state, 1)) {
-        writeSynthesizedVoiceR(opts, state);
+        flags |= MBE_POST_WAV_RIGHT;
     }
+    return flags;
 }
 
 static void
-mbe_post_audio_and_recording(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
+mbe_post_wav_outputs(dsd_opts* opts, dsd_state* state, unsigned int flags) {
+    if ((flags & MBE_POST_WAV_LEFT) != 0U) {
+        writeSynthesizedVoice(opts, state);
+    }
+    if ((flags & MBE_POST_WAV_RIGHT) != 0U) {
+        writeSynthesizedVoiceR(opts, state);
+    }
+}
+
+static unsigned int
+mbe_post_plan_frame(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
+    unsigned int flags = 0U;
     if (mbe_post_uses_mono_left_staging(state)) {
-        mbe_post_mono_left_audio(opts, state);
+        flags |= MBE_POST_MONO_LEFT;
+        if (DSD_SYNC_IS_X2TDMA(state->synctype) && state->currentslot == 1) {
+            flags |= MBE_POST_MONO_LEFT_ERRS_R;
+        }
     } else {
-        mbe_post_left_audio(opts, state, frame_ctx);
-        mbe_post_right_audio(opts, state, frame_ctx);
-        mbe_post_other_audio(opts, state);
+        flags |= mbe_post_left_plan(opts, state, frame_ctx);
+        flags |= mbe_post_right_plan(opts, state, frame_ctx);
+        flags |= mbe_post_other_plan(opts, state);
+    }
+    return flags | mbe_post_wav_plan(opts, state);
+}
+
+/* Play and record the audio in hand with the plan made for its frame. */
+static void
+mbe_post_audio_and_recording(dsd_opts* opts, dsd_state* state, const mbe_frame_ctx_t* frame_ctx) {
+    const unsigned int flags =
+        frame_ctx->post_planned ? frame_ctx->post_flags : mbe_post_plan_frame(opts, state, frame_ctx);
+    if ((flags & MBE_POST_MONO_LEFT) != 0U) {
+        mbe_post_mono_left_audio(opts, state, flags);
+    }
+    if ((flags & MBE_POST_LEFT) != 0U) {
+        mbe_post_left_audio(opts, state, flags);
+    }
+    if ((flags & MBE_POST_RIGHT) != 0U) {
+        mbe_post_right_audio(opts, state, flags);
+    }
+    if ((flags & MBE_POST_OTHER) != 0U) {
+        mbe_post_other_audio(opts, state, flags);
     }
-    mbe_post_wav_outputs(opts, state);
+    mbe_post_wav_outputs(opts, state, flags);
 
     if (opts->audio_out_type == 9) {
         opts->audio_out = 0;
     }
 }
 
+void
+dsd_mbe_drain_slot_audio(dsd_opts* opts, dsd_state* state, int slot) {
+    if (!opts || !state || slot < 0 || slot > 1) {
+        return;
+    }
+    dsd_vocoder_worker* worker = dsd_vocoder_worker_peek(state);
+    int* errs = (slot == 1) ? &state->errsR : &state->errs;
+    int* errs2 = (slot == 1) ? &state->errs2R : &state->errs2;
+    char* err_str = (slot == 1) ? state->err_strR : state->err_str;
+    while (dsd_vocoder_worker_pending(worker, slot) > 0) {
+        dsd_vocoder_frame_meta meta;
+        mbe_process_result result;
+        float pcm[160];
+        const int ret = dsd_vocoder_worker_collect(worker, slot, &meta, &result, pcm);
+
+        /* Stage the frame where its decoder synthesized it: X2 keeps both timeslots on the left buffer. */
+        const int right = (slot == 1 && (meta.post_flags & MBE_POST_MONO_LEFT) == 0U) ? 1 : 0;
+        float* aout_buf = right ? state->audio_out_temp_bufR : state->audio_out_temp_buf;
+        DSD_MEMCPY(aout_buf, pcm, sizeof(pcm));
+        (void)store_process_result(ret, aout_buf, errs, errs2, err_str, sizeof(state->err_str), &result);
+        mbe_save_frame_bits(opts, state, slot, &meta);
+
+        mbe_frame_ctx_t frame_ctx;
+        DSD_MEMSET(&frame_ctx, 0, sizeof(frame_ctx));
+        mbe_frame_ctx_take_plan(&frame_ctx, &meta);
+        mbe_post_audio_and_recording(opts, state, &frame_ctx);
+
+        /*
+         * The protocol's burst mixer has already run for the call, so the frame is played on its own. The gate is
+         * the one its post-stage plan recorded, not the decoder's state after the call ended.
+         */
+        const unsigned int play = MBE_POST_MONO_LEFT | MBE_POST_LEFT_PLAY | MBE_POST_RIGHT_PLAY | MBE_POST_OTHER_PLAY;
+        if ((meta.post_flags & play) != 0U) {
+            playSynthesizedVoiceTail(opts, state, slot, right);
+        }
+    }
+}
+
 void
 playMbeFiles(dsd_opts* opts, dsd_state* state, int argc, char** argv) {
 
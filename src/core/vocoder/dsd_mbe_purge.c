@@ -5,6 +5,7 @@
 
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/vocoder.h>
+#include <dsd-neo/core/vocoder_worker.h>
 #include <dsd-neo/runtime/p25_p2_audio_ring.h>
 #include <mbelib-neo/mbelib.h>
 
@@ -13,6 +14,7 @@
 
 static void
 dsd_mbe_reset_slot_parameters(dsd_state* state, int slot) {
+    dsd_vocoder_worker_reset_lane(dsd_vocoder_worker_peek(state), slot);
     if (slot == 0) {
         if (state->cur_mp && state->prev_mp && state->prev_mp_enhanced) {
             mbe_initMbeParms(state->cur_mp, state->prev_mp, state->prev_mp_enhanced);
@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Per-slot AMBE synthesis lanes.
+ *
+ * Each lane is a pair of SPSC rings between the decoder thread and the lane
+ * thread: decoded frames go in on `jobs`, synthesized frames come back on
+ * `done` in the same order. The decoder thread is the only producer of jobs
+ * and the only consumer of results, and it never has more than
+ * DSD_VOCODER_WORKER_LAG + 1 frames in flight per lane, so neither ring can
+ * fill and neither side ever blocks on space. A burst's frames are decoded
+ * back to back, so the frame collected with each post is one from an earlier
+ * burst; the decoder only sleeps if the lane is a whole burst behind.
+ *
+ * A lane's parameter history is touched by its thread while frames are in
+ * flight and by the decoder thread (reset) only after every result has been
+ * collected, so the ring's publish/acquire pairs are the only ordering needed.
+ */
+
+#include <atomic>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/core/vocoder_worker.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/mem.h>
+#include <dsd-neo/runtime/ring_wake.h>
+#include <dsd-neo/runtime/spsc_ring.h>
+#include <mbelib-neo/mbelib.h>
+#include <new>
+#include <stdio.h>
+#include "dsd-neo/core/safe_api.h"
+#include "dsd-neo/core/state_fwd.h"
+#include "dsd-neo/platform/platform.h"
+
+namespace {
+
+/* Frames per lane ring; at most DSD_VOCODER_WORKER_LAG + 1 are ever in flight. */
+constexpr size_t kLaneDepth = 8U;
+static_assert(kLaneDepth > DSD_VOCODER_WORKER_LAG, "lane ring must hold the lag plus the frame being posted");
+
+struct VocoderFrame {
+    int ret;
+    mbe_process_result result;
+    dsd_vocoder_frame_meta meta;
+    float pcm[160];
+};
+
+struct VocoderLane {
+    spsc_ring<VocoderFrame> jobs;
+    spsc_ring<VocoderFrame> done;
+    VocoderFrame job_storage[kLaneDepth];
+    VocoderFrame done_storage[kLaneDepth];
+    struct ring_wake job_wake;
+    struct ring_wake done_wake;
+    dsd_mutex_t job_m;
+    dsd_cond_t job_cv;
+    dsd_mutex_t done_m;
+    dsd_cond_t done_cv;
+    std::atomic<bool> stop{false};
+    dsd_thread_t thread = {};
+    int started = 0;
+    int in_flight = 0; /* decoder side: posted but not yet collected */
+    mbe_parms cur_mp;
+    mbe_parms prev_mp;
+    mbe_parms prev_mp_enhanced;
+};
+
+} // namespace
+
+struct dsd_vocoder_worker {
+    VocoderLane lanes[DSD_VOCODER_WORKER_LANES];
+    int threaded = 0;
+};
+
+static void
+vocoder_lane_synthesize(VocoderLane* lane, VocoderFrame* f) {
+    if (f->meta.kind == DSD_VOCODER_FRAME_AMBE2450) {
+        f->ret = mbe_processAmbe2450Dataf(f->pcm, &f->result, f->meta.bits, &lane->cur_mp, &lane->prev_mp,
+                                          &lane->prev_mp_enhanced);
+        return;
+    }
+    if (f->meta.kind == DSD_VOCODER_FRAME_IMBE4400) {
+        f->ret = mbe_processImbe4400Dataf(f->pcm, &f->result, f->meta.bits, &lane->cur_mp, &lane->prev_mp,
+                                          &lane->prev_mp_enhanced);
+        return;
+    }
+    mbe_synthesizeSilencef(f->pcm);
+    f->ret = MBE_STATUS_INVALID_BITS;
+}
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    vocoder_lane_thread(void* arg) {
+    VocoderLane* lane = static_cast<VocoderLane*>(arg);
+    VocoderFrame f;
+    for (;;) {
+        if (lane->jobs.read(&f, 1U) == 1U) {
+            vocoder_lane_synthesize(lane, &f);
+            (void)lane->done.write(&f, 1U);
+            ring_wake_notify(&lane->done_wake, &lane->done_cv, &lane->done_m, lane->done.used());
+            continue;
+        }
+        if (lane->stop.load(std::memory_order_acquire)) {
+            break;
+        }
+        uint32_t token = ring_wake_prepare(&lane->job_wake);
+        if (!lane->jobs.empty() || lane->stop.load(std::memory_order_acquire)) {
+            ring_wake_cancel(&lane->job_wake);
+            continue;
+        }
+        (void)ring_wake_wait(&lane->job_wake, &lane->job_cv, &lane->job_m, token, RING_WAKE_IDLE_TIMEOUT_MS);
+    }
+    DSD_THREAD_RETURN;
+}
+
+static void
+vocoder_lane_post(const dsd_vocoder_worker* w, VocoderLane* lane, VocoderFrame* f) {
+    lane->in_flight++;
+    if (!w->threaded) {
+        vocoder_lane_synthesize(lane, f);
+        (void)lane->done.write(f, 1U);
+        return;
+    }
+    (void)lane->jobs.write(f, 1U);
+    ring_wake_notify(&lane->job_wake, &lane->job_cv, &lane->job_m, lane->jobs.used());
+}
+
+/* Oldest in-flight result; sleeps until the lane thread publishes it. */
+static void
+vocoder_lane_collect(VocoderLane* lane, VocoderFrame* out) {
+    while (lane->done.read(out, 1U) == 0U) {
+        uint32_t token = ring_wake_prepare(&lane->done_wake);
+        if (!lane->done.empty()) {
+            ring_wake_cancel(&lane->done_wake);
+            continue;
+        }
+        (void)ring_wake_wait(&lane->done_wake, &lane->done_cv, &lane->done_m, token, RING_WAKE_IDLE_TIMEOUT_MS);
+    }
+    lane->in_flight--;
+}
+
+static int
+vocoder_lane_init(VocoderLane* lane) {
+    lane->jobs.buffer = lane->job_storage;
+    lane->jobs.capacity = kLaneDepth;
+    lane->done.buffer = lane->done_storage;
+    lane->done.capacity = kLaneDepth;
+    mbe_initMbeParms(&lane->cur_mp, &lane->prev_mp, &lane->prev_mp_enhanced);
+    if (dsd_mutex_init(&lane->job_m) != 0) {
+        return -1;
+    }
+    if (dsd_cond_init(&lane->job_cv) != 0) {
+        (void)dsd_mutex_destroy(&lane->job_m);
+        return -1;
+    }
+    if (dsd_mutex_init(&lane->done_m) != 0) {
+        (void)dsd_cond_destroy(&lane->job_cv);
+        (void)dsd_mutex_destroy(&lane->job_m);
+        return -1;
+    }
+    if (dsd_cond_init(&lane->done_cv) != 0) {
+        (void)dsd_mutex_destroy(&lane->done_m);
+        (void)dsd_cond_destroy(&lane->job_cv);
+        (void)dsd_mutex_destroy(&lane->job_m);
+        return -1;
+    }
+    return 0;
+}
+
+static void
+vocoder_lane_shutdown(VocoderLane* lane) {
+    if (lane->started) {
+        lane->stop.store(true, std::memory_order_release);
+        ring_wake_signal(&lane->job_wake, &lane->job_cv, &lane->job_m);
+        (void)dsd_thread_join(lane->thread);
+        lane->started = 0;
+    }
+    (void)dsd_cond_destroy(&lane->done_cv);
+    (void)dsd_mutex_destroy(&lane->done_m);
+    (void)dsd_cond_destroy(&lane->job_cv);
+    (void)dsd_mutex_destroy(&lane->job_m);
+}
+
+static void
+vocoder_worker_free(dsd_vocoder_worker* w, int lanes_ready) {
+    for (int i = 0; i < lanes_ready; i++) {
+        vocoder_lane_shutdown(&w->lanes[i]);
+    }
+    w->~dsd_vocoder_worker();
+    dsd_neo_aligned_free(w);
+}
+
+dsd_vocoder_worker*
+dsd_vocoder_worker_create(int threaded) {
+    void* mem = dsd_neo_aligned_malloc(sizeof(dsd_vocoder_worker));
+    if (!mem) {
+        return nullptr;
+    }
+    dsd_vocoder_worker* w = new (mem) dsd_vocoder_worker;
+    w->threaded = threaded ? 1 : 0;
+    for (int i = 0; i < DSD_VOCODER_WORKER_LANES; i++) {
+        if (vocoder_lane_init(&w->lanes[i]) != 0) {
+            vocoder_worker_free(w, i);
+            return nullptr;
+        }
+    }
+    if (!w->threaded) {
+        return w;
+    }
+    for (int i = 0; i < DSD_VOCODER_WORKER_LANES; i++) {
+        VocoderLane* lane = &w->lanes[i];
+        if (dsd_thread_create(&lane->thread, vocoder_lane_thread, static_cast<void*>(lane)) != 0) {
+            DSD_FPRINTF(stderr, "Failed to start vocoder lane %d\n", i);
+            vocoder_worker_free(w, DSD_VOCODER_WORKER_LANES);
+            return nullptr;
+        }
+        lane->started = 1;
+    }
+    return w;
+}
+
+void
+dsd_vocoder_worker_destroy(dsd_vocoder_worker* w) {
+    if (!w) {
+        return;
+    }
+    vocoder_worker_free(w, DSD_VOCODER_WORKER_LANES);
+}
+
+int
+dsd_vocoder_worker_exchange(dsd_vocoder_worker* w, int lane, dsd_vocoder_frame_meta* meta,
+                            mbe_process_result* result, float aout[160]) {
+    if (!w || lane < 0 || lane >= DSD_VOCODER_WORKER_LANES || !meta || !result || !aout) {
+        return MBE_STATUS_INVALID_ARGUMENT;
+    }
+    VocoderLane* l = &w->lanes[lane];
+    VocoderFrame f;
+    f.ret = 0;
+    f.result = *result;
+    f.meta = *meta;
+    vocoder_lane_post(w, l, &f);
+
+    if (l->in_flight <= DSD_VOCODER_WORKER_LAG) {
+        /* Lane still filling since it was flushed: nothing to hand back yet. */
+        mbe_synthesizeSilencef(aout);
+        DSD_MEMSET(result, 0, sizeof(*result));
+        const unsigned int post_flags = meta->post_flags;
+        DSD_MEMSET(meta, 0, sizeof(*meta));
+        meta->kind = DSD_VOCODER_FRAME_ERASURE;
+        meta->post_flags = post_flags;
+        return MBE_STATUS_INVALID_BITS;
+    }
+    vocoder_lane_collect(l, &f);
+    DSD_MEMCPY(aout, f.pcm, sizeof(f.pcm));
+    *result = f.result;
+    *meta = f.meta;
+    return f.ret;
+}
+
+int
+dsd_vocoder_worker_pending(const dsd_vocoder_worker* w, int lane) {
+    if (!w || lane < 0 || lane >= DSD_VOCODER_WORKER_LANES) {
+        return 0;
+    }
+    return w->lanes[lane].in_flight;
+}
+
+int
+dsd_vocoder_worker_collect(dsd_vocoder_worker* w, int lane, dsd_vocoder_frame_meta* meta, mbe_process_result* result,
+                           float aout[160]) {
+    if (!w || lane < 0 || lane >= DSD_VOCODER_WORKER_LANES || !meta || !result || !aout
+        || w->lanes[lane].in_flight == 0) {
+        return MBE_STATUS_INVALID_ARGUMENT;
+    }
+    VocoderFrame f;
+    vocoder_lane_collect(&w->lanes[lane], &f);
+    DSD_MEMCPY(aout, f.pcm, sizeof(f.pcm));
+    *result = f.result;
+    *meta = f.meta;
+    return f.ret;
+}
+
+void
+dsd_vocoder_worker_flush_lane(dsd_vocoder_worker* w, int lane) {
+    if (!w || lane < 0 || lane >= DSD_VOCODER_WORKER_LANES) {
+        return;
+    }
+    VocoderLane* l = &w->lanes[lane];
+    VocoderFrame f;
+    while (l->in_flight > 0) {
+        vocoder_lane_collect(l, &f);
+    }
+}
+
+void
+dsd_vocoder_worker_reset_lane(dsd_vocoder_worker* w, int lane) {
+    if (!w || lane < 0 || lane >= DSD_VOCODER_WORKER_LANES) {
+        return;
+    }
+    dsd_vocoder_worker_flush_lane(w, lane);
+    /* The lane thread is idle until the next post. */
+    VocoderLane* l = &w->lanes[lane];
+    mbe_initMbeParms(&l->cur_mp, &l->prev_mp, &l->prev_mp_enhanced);
+}
+
+static void
+vocoder_worker_ext_cleanup(void* ptr) {
+    dsd_vocoder_worker_destroy(static_cast<dsd_vocoder_worker*>(ptr));
+}
+
+dsd_vocoder_worker*
+dsd_vocoder_worker_peek(const dsd_state* state) {
+    return static_cast<dsd_vocoder_worker*>(
+        const_cast<void*>(dsd_state_ext_get_const(state, DSD_STATE_EXT_CORE_VOCODER_WORKER)));
+}
+
+dsd_vocoder_worker*
+dsd_vocoder_worker_for_state(dsd_state* state) {
+    if (!state) {
+        return nullptr;
+    }
+    dsd_vocoder_worker* w = dsd_vocoder_worker_peek(state);
+    if (w) {
+        return w;
+    }
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg || !cfg->vocoder_thread_enable) {
+        return nullptr;
+    }
+    w = dsd_vocoder_worker_create(1);
+    if (!w) {
+        /* Keep the lane ordering (and its lag) rather than retrying every frame. */
+        DSD_FPRINTF(stderr, "Vocoder threads unavailable; synthesizing queued frames inline.\n");
+        w = dsd_vocoder_worker_create(0);
+        if (!w) {
+            return nullptr;
+        }
+    }
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_CORE_VOCODER_WORKER, w, vocoder_worker_ext_cleanup) != 0) {
+        dsd_vocoder_worker_destroy(w);
+        return nullptr;
+    }
+    DSD_FPRINTF(stderr, "Vocoder synthesis threads enabled (DSD_NEO_VOCODER_THREAD=1), lanes: %d.\n",
+                DSD_VOCODER_WORKER_LANES);
+    return w;
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * AES implementations behind the dsd_aes_ctx_* entry points.
+ *
+ * Each backend works from a dsd_aes_key_ctx expanded by the portable key
+ * schedule. Hardware backends are compiled only when the toolchain accepts
+ * the instruction set (DSD_NEO_CRYPTO_HAVE_AESNI / _ARMCE) and selected only
+ * when the CPU reports it.
+ */
+
+#ifndef DSD_NEO_SRC_CRYPTO_AES_INTERNAL_H
+#define DSD_NEO_SRC_CRYPTO_AES_INTERNAL_H
+
+#include <dsd-neo/crypto/aes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char* name;
+    void (*ofb)(const dsd_aes_key_ctx* ctx, const uint8_t iv[16], uint8_t* output, int nblocks);
+    void (*ctr)(const dsd_aes_key_ctx* ctx, const uint8_t counter[16], uint8_t* data, size_t len);
+    void (*ecb_decrypt)(const dsd_aes_key_ctx* ctx, const uint8_t* input, uint8_t* output, int nblocks);
+} dsd_aes_backend;
+
+extern const dsd_aes_backend dsd_aes_backend_portable;
+
+#if defined(DSD_NEO_CRYPTO_HAVE_AESNI)
+extern const dsd_aes_backend dsd_aes_backend_aesni;
+/** CPUID reports AES-NI. */
+int dsd_aes_cpu_has_aesni(void);
+#endif
+
+#if defined(DSD_NEO_CRYPTO_HAVE_ARMCE)
+extern const dsd_aes_backend dsd_aes_backend_armce;
+/** The OS reports the ARMv8 AES instructions. */
+int dsd_aes_cpu_has_armce(void);
+#endif
+
+/** Backend used by the public entry points; chosen once per process. */
+const dsd_aes_backend* dsd_aes_backend_active(void);
+
+/**
+ * Fill @p out with the portable backend followed by each hardware backend this
+ * CPU supports; lets tests check every backend against the portable one.
+ * @return Number of entries written (at most @p cap).
+ */
+int dsd_aes_available_backends(const dsd_aes_backend** out, int cap);
+
+/**
+ * Overwrite key material. Volatile stores, so the wipe is not dropped as a
+ * dead store when the buffer goes out of scope right after.
+ */
+static inline void
+dsd_aes_wipe(void* p, size_t n) {
+    volatile uint8_t* v = (volatile uint8_t*)p;
+    for (size_t i = 0U; i < n; i++) {
+        v[i] = 0U;
+    }
+}
+
+/** Increment a 128-bit big-endian counter block. */
+static inline void
+dsd_aes_counter_increment(uint8_t counter[16]) {
+    for (int i = 15; i >= 0; i--) {
+        counter[i]++;
+        if (counter[i] != 0U) {
+            break;
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* DSD_NEO_SRC_CRYPTO_AES_INTERNAL_H */
@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * ARMv8 Cryptography Extension backend. Compiled with +crypto and only
+ * selected when the OS reports the AES instructions.
+ *
+ * AESE/AESD fold the round-key XOR in before SubBytes/ShiftRows, so the
+ * schedule is applied one key early and the last key is a plain XOR.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "aes_internal.h"
+
+#include <arm_neon.h>
+
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_AES
+#define HWCAP_AES (1UL << 3)
+#endif
+#elif defined(__FreeBSD__)
+#include <sys/auxv.h>
+#ifndef HWCAP_AES
+#define HWCAP_AES (1UL << 3)
+#endif
+#elif defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+#define ARMCE_LANES 4
+
+int
+dsd_aes_cpu_has_armce(void) {
+#if defined(__APPLE__)
+    return 1; // every Apple arm64 core has the AES instructions
+#elif defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_AES) != 0UL;
+#elif defined(__FreeBSD__)
+    unsigned long hwcap = 0UL;
+    if (elf_aux_info(AT_HWCAP, &hwcap, sizeof(hwcap)) != 0) {
+        return 0;
+    }
+    return (hwcap & HWCAP_AES) != 0UL;
+#elif defined(_WIN32)
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+static void
+armce_load_schedule(const uint8_t (*keys)[16], int nr, uint8x16_t* out) {
+    for (int r = 0; r <= nr; r++) {
+        out[r] = vld1q_u8(keys[r]);
+    }
+}
+
+static inline uint8x16_t
+armce_encrypt(uint8x16_t s, const uint8x16_t* rk, int nr) {
+    for (int r = 0; r < nr - 1; r++) {
+        s = vaesmcq_u8(vaeseq_u8(s, rk[r]));
+    }
+    s = vaeseq_u8(s, rk[nr - 1]);
+    return veorq_u8(s, rk[nr]);
+}
+
+static inline void
+armce_encrypt4(uint8x16_t b[ARMCE_LANES], const uint8x16_t* rk, int nr) {
+    for (int r = 0; r < nr - 1; r++) {
+        for (int j = 0; j < ARMCE_LANES; j++) {
+            b[j] = vaesmcq_u8(vaeseq_u8(b[j], rk[r]));
+        }
+    }
+    for (int j = 0; j < ARMCE_LANES; j++) {
+        b[j] = veorq_u8(vaeseq_u8(b[j], rk[nr - 1]), rk[nr]);
+    }
+}
+
+// dk is the equivalent inverse schedule: AESD then AESIMC matches aesdec.
+static inline uint8x16_t
+armce_decrypt(uint8x16_t s, const uint8x16_t* dk, int nr) {
+    for (int r = 0; r < nr - 1; r++) {
+        s = vaesimcq_u8(vaesdq_u8(s, dk[r]));
+    }
+    s = vaesdq_u8(s, dk[nr - 1]);
+    return veorq_u8(s, dk[nr]);
+}
+
+static inline void
+armce_decrypt4(uint8x16_t b[ARMCE_LANES], const uint8x16_t* dk, int nr) {
+    for (int r = 0; r < nr - 1; r++) {
+        for (int j = 0; j < ARMCE_LANES; j++) {
+            b[j] = vaesimcq_u8(vaesdq_u8(b[j], dk[r]));
+        }
+    }
+    for (int j = 0; j < ARMCE_LANES; j++) {
+        b[j] = veorq_u8(vaesdq_u8(b[j], dk[nr - 1]), dk[nr]);
+    }
+}
+
+static void
+armce_ofb(const dsd_aes_key_ctx* ctx, const uint8_t iv[16], uint8_t* output, int nblocks) {
+    uint8x16_t rk[DSD_AES_MAX_ROUND_KEYS];
+    armce_load_schedule(ctx->round_keys, ctx->rounds, rk);
+
+    uint8x16_t s = vld1q_u8(iv);
+    for (int i = 0; i < nblocks; i++) {
+        s = armce_encrypt(s, rk, ctx->rounds);
+        vst1q_u8(output + ((size_t)i * 16U), s);
+    }
+    dsd_aes_wipe(rk, sizeof(rk));
+}
+
+static void
+armce_ctr(const dsd_aes_key_ctx* ctx, const uint8_t counter[16], uint8_t* data, size_t len) {
+    uint8x16_t rk[DSD_AES_MAX_ROUND_KEYS];
+    armce_load_schedule(ctx->round_keys, ctx->rounds, rk);
+
+    uint8_t next[16];
+    memcpy(next, counter, sizeof(next));
+
+    size_t offset = 0U;
+    while (len - offset >= (size_t)ARMCE_LANES * 16U) {
+        uint8x16_t b[ARMCE_LANES];
+        for (int j = 0; j < ARMCE_LANES; j++) {
+            b[j] = vld1q_u8(next);
+            dsd_aes_counter_increment(next);
+        }
+        armce_encrypt4(b, rk, ctx->rounds);
+        for (int j = 0; j < ARMCE_LANES; j++) {
+            uint8_t* p = data + offset + ((size_t)j * 16U);
+            vst1q_u8(p, veorq_u8(vld1q_u8(p), b[j]));
+        }
+        offset += (size_t)ARMCE_LANES * 16U;
+    }
+
+    while (offset < len) {
+        uint8_t stream[16];
+        vst1q_u8(stream, armce_encrypt(vld1q_u8(next), rk, ctx->rounds));
+        dsd_aes_counter_increment(next);
+
+        size_t block_len = len - offset;
+        if (block_len > 16U) {
+            block_len = 16U;
+        }
+        for (size_t i = 0U; i < block_len; i++) {
+            data[offset + i] ^= stream[i];
+        }
+        offset += block_len;
+    }
+    dsd_aes_wipe(rk, sizeof(rk));
+}
+
+static void
+armce_ecb_decrypt(const dsd_aes_key_ctx* ctx, const uint8_t* input, uint8_t* output, int nblocks) {
+    uint8x16_t dk[DSD_AES_MAX_ROUND_KEYS];
+    armce_load_schedule(ctx->dec_round_keys, ctx->rounds, dk);
+
+    int i = 0;
+    for (; i + ARMCE_LANES <= nblocks; i += ARMCE_LANES) {
+        uint8x16_t b[ARMCE_LANES];
+        for (int j = 0; j < ARMCE_LANES; j++) {
+            b[j] = vld1q_u8(input + ((size_t)(i + j) * 16U));
+        }
+        armce_decrypt4(b, dk, ctx->rounds);
+        for (int j = 0; j < ARMCE_LANES; j++) {
+            vst1q_u8(output + ((size_t)(i + j) * 16U), b[j]);
+        }
+    }
+    for (; i < nblocks; i++) {
+        vst1q_u8(output + ((size_t)i * 16U), armce_decrypt(vld1q_u8(input + ((size_t)i * 16U)), dk, ctx->rounds));
+    }
+    dsd_aes_wipe(dk, sizeof(dk));
+}
+
+const dsd_aes_backend dsd_aes_backend_armce = {
+    "armv8-ce",
+    armce_ofb,
+    armce_ctr,
+    armce_ecb_decrypt,
+};
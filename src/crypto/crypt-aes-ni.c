@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * AES-NI backend. Compiled with -maes on GCC/Clang and only selected when
+ * CPUID reports the instructions, so the rest of the library stays baseline.
+ *
+ * OFB feeds each block into the next and runs serially; CTR and ECB decrypt
+ * keep four independent blocks in flight to cover the aesenc/aesdec latency.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "aes_internal.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#define AESNI_LANES 4
+
+int
+dsd_aes_cpu_has_aesni(void) {
+#if defined(_MSC_VER)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 25)) != 0;
+#else
+    unsigned int eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+    if (!__get_cpuid(1U, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+    return (ecx & (1U << 25)) != 0U;
+#endif
+}
+
+static void
+aesni_load_schedule(const uint8_t (*keys)[16], int nr, __m128i* out) {
+    for (int r = 0; r <= nr; r++) {
+        out[r] = _mm_loadu_si128((const __m128i*)keys[r]);
+    }
+}
+
+static inline __m128i
+aesni_encrypt(__m128i s, const __m128i* rk, int nr) {
+    s = _mm_xor_si128(s, rk[0]);
+    for (int r = 1; r < nr; r++) {
+        s = _mm_aesenc_si128(s, rk[r]);
+    }
+    return _mm_aesenclast_si128(s, rk[nr]);
+}
+
+static inline void
+aesni_encrypt4(__m128i b[AESNI_LANES], const __m128i* rk, int nr) {
+    for (int j = 0; j < AESNI_LANES; j++) {
+        b[j] = _mm_xor_si128(b[j], rk[0]);
+    }
+    for (int r = 1; r < nr; r++) {
+        for (int j = 0; j < AESNI_LANES; j++) {
+            b[j] = _mm_aesenc_si128(b[j], rk[r]);
+        }
+    }
+    for (int j = 0; j < AESNI_LANES; j++) {
+        b[j] = _mm_aesenclast_si128(b[j], rk[nr]);
+    }
+}
+
+// dk is the equivalent inverse schedule, which is the order aesdec expects.
+static inline __m128i
+aesni_decrypt(__m128i s, const __m128i* dk, int nr) {
+    s = _mm_xor_si128(s, dk[0]);
+    for (int r = 1; r < nr; r++) {
+        s = _mm_aesdec_si128(s, dk[r]);
+    }
+    return _mm_aesdeclast_si128(s, dk[nr]);
+}
+
+static inline void
+aesni_decrypt4(__m128i b[AESNI_LANES], const __m128i* dk, int nr) {
+    for (int j = 0; j < AESNI_LANES; j++) {
+        b[j] = _mm_xor_si128(b[j], dk[0]);
+    }
+    for (int r = 1; r < nr; r++) {
+        for (int j = 0; j < AESNI_LANES; j++) {
+            b[j] = _mm_aesdec_si128(b[j], dk[r]);
+        }
+    }
+    for (int j = 0; j < AESNI_LANES; j++) {
+        b[j] = _mm_aesdeclast_si128(b[j], dk[nr]);
+    }
+}
+
+static void
+aesni_ofb(const dsd_aes_key_ctx* ctx, const uint8_t iv[16], uint8_t* output, int nblocks) {
+    __m128i rk[DSD_AES_MAX_ROUND_KEYS];
+    aesni_load_schedule(ctx->round_keys, ctx->rounds, rk);
+
+    __m128i s = _mm_loadu_si128((const __m128i*)iv);
+    for (int i = 0; i < nblocks; i++) {
+        s = aesni_encrypt(s, rk, ctx->rounds);
+        _mm_storeu_si128((__m128i*)(output + ((size_t)i * 16U)), s);
+    }
+    dsd_aes_wipe(rk, sizeof(rk));
+}
+
+static void
+aesni_ctr(const dsd_aes_key_ctx* ctx, const uint8_t counter[16], uint8_t* data, size_t len) {
+    __m128i rk[DSD_AES_MAX_ROUND_KEYS];
+    aesni_load_schedule(ctx->round_keys, ctx->rounds, rk);
+
+    uint8_t next[16];
+    memcpy(next, counter, sizeof(next));
+
+    size_t offset = 0U;
+    while (len - offset >= (size_t)AESNI_LANES * 16U) {
+        __m128i b[AESNI_LANES];
+        for (int j = 0; j < AESNI_LANES; j++) {
+            b[j] = _mm_loadu_si128((const __m128i*)next);
+            dsd_aes_counter_increment(next);
+        }
+        aesni_encrypt4(b, rk, ctx->rounds);
+        for (int j = 0; j < AESNI_LANES; j++) {
+            __m128i* p = (__m128i*)(data + offset + ((size_t)j * 16U));
+            _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), b[j]));
+        }
+        offset += (size_t)AESNI_LANES * 16U;
+    }
+
+    while (offset < len) {
+        uint8_t stream[16];
+        _mm_storeu_si128((__m128i*)stream, aesni_encrypt(_mm_loadu_si128((const __m128i*)next), rk, ctx->rounds));
+        dsd_aes_counter_increment(next);
+
+        size_t block_len = len - offset;
+        if (block_len > 16U) {
+            block_len = 16U;
+        }
+        for (size_t i = 0U; i < block_len; i++) {
+            data[offset + i] ^= stream[i];
+        }
+        offset += block_len;
+    }
+    dsd_aes_wipe(rk, sizeof(rk));
+}
+
+static void
+aesni_ecb_decrypt(const dsd_aes_key_ctx* ctx, const uint8_t* input, uint8_t* output, int nblocks) {
+    __m128i dk[DSD_AES_MAX_ROUND_KEYS];
+    aesni_load_schedule(ctx->dec_round_keys, ctx->rounds, dk);
+
+    int i = 0;
+    for (; i + AESNI_LANES <= nblocks; i += AESNI_LANES) {
+        __m128i b[AESNI_LANES];
+        for (int j = 0; j < AESNI_LANES; j++) {
+            b[j] = _mm_loadu_si128((const __m128i*)(input + ((size_t)(i + j) * 16U)));
+        }
+        aesni_decrypt4(b, dk, ctx->rounds);
+        for (int j = 0; j < AESNI_LANES; j++) {
+            _mm_storeu_si128((__m128i*)(output + ((size_t)(i + j) * 16U)), b[j]);
+        }
+    }
+    for (; i < nblocks; i++) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(input + ((size_t)i * 16U)));
+        _mm_storeu_si128((__m128i*)(output + ((size_t)i * 16U)), aesni_decrypt(s, dk, ctx->rounds));
+    }
+    dsd_aes_wipe(dk, sizeof(dk));
+}
+
+const dsd_aes_backend dsd_aes_backend_aesni = {
+    "aesni",
+    aesni_ofb,
+    aesni_ctr,
+    aesni_ecb_decrypt,
+};
@@ -36,22 +36,32 @@
 */
 
 #include <dsd-neo/crypto/aes.h>
+#include <dsd-neo/platform/atomic_compat.h>
 #include <stdint.h>
 #include <string.h>
+#include "aes_internal.h"
 #include "dsd-neo/core/safe_api.h"
 
 #define AES_BLOCKLEN        16
 #define AES_NB              4U
 #define AES_ROUND_KEY_BYTES 240U
 
+// Schedules cached per thread; a decoder only cycles through the keys of its active calls.
+#define AES_KEY_CACHE_SLOTS 16
+
+#if defined(_MSC_VER)
+#define AES_TLS __declspec(thread)
+#else
+#define AES_TLS _Thread_local
+#endif
+
 typedef struct {
     unsigned nk;
     uint8_t nr;
 } aes_params_t;
 
-struct AES_ctx {
-    uint8_t RoundKey[AES_ROUND_KEY_BYTES];
-};
+_Static_assert(sizeof(((dsd_aes_key_ctx*)0)->round_keys) == AES_ROUND_KEY_BYTES,
+               "dsd_aes_key_ctx must hold a full AES-256 schedule");
 
 typedef uint8_t state_t[4][4];
 
@@ -353,20 +363,6 @@ Cipher(state_t* state, const uint8_t* RoundKey, uint8_t Nr) {
     AddRoundKey(Nr, state, RoundKey);
 }
 
-static void
-aes_increment_counter_be(uint8_t counter[AES_BLOCKLEN]) {
-    if (counter == NULL) {
-        return;
-    }
-
-    for (int i = AES_BLOCKLEN - 1; i >= 0; i--) {
-        counter[i]++;
-        if (counter[i] != 0U) {
-            break;
-        }
-    }
-}
-
 static void
 InvCipher(state_t* state, const uint8_t* RoundKey, uint8_t Nr) {
     AddRoundKey(Nr, state, RoundKey);
@@ -382,27 +378,27 @@ InvCipher(state_t* state, const uint8_t* RoundKey, uint8_t Nr) {
     }
 }
 
-void
-aes_ctr_xcrypt_bytes(const uint8_t* counter, const uint8_t* key, uint8_t* data, dsd_aes_key_size key_size, size_t len) {
-    if (counter == NULL || key == NULL || data == NULL || len == 0U) {
-        return;
-    }
+static void
+aes_portable_ofb(const dsd_aes_key_ctx* ctx, const uint8_t iv[16], uint8_t* output, int nblocks) {
+    uint8_t input_register[AES_BLOCKLEN]; //OFB Input Register
+    DSD_MEMCPY(input_register, iv, sizeof(input_register));
 
-    aes_params_t params;
-    if (!aes_params_for_key_size(key_size, &params)) {
-        return;
+    //input_register is returned as output, and is put back in as object feedback
+    for (int i = 0; i < nblocks; i++) {
+        Cipher((state_t*)input_register, &ctx->round_keys[0][0], (uint8_t)ctx->rounds);
+        DSD_MEMCPY(output + ((size_t)i * AES_BLOCKLEN), input_register, sizeof(input_register));
     }
-    struct AES_ctx ctx;
-    uint8_t counter_block[AES_BLOCKLEN];
+}
 
-    DSD_MEMSET(ctx.RoundKey, 0, ((size_t)AES_ROUND_KEY_BYTES) * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key, params.nk, params.nr);
+static void
+aes_portable_ctr(const dsd_aes_key_ctx* ctx, const uint8_t counter[16], uint8_t* data, size_t len) {
+    uint8_t counter_block[AES_BLOCKLEN];
     DSD_MEMCPY(counter_block, counter, sizeof(counter_block));
 
     for (size_t offset = 0U; offset < len; offset += AES_BLOCKLEN) {
         uint8_t stream[AES_BLOCKLEN];
         DSD_MEMCPY(stream, counter_block, sizeof(stream));
-        Cipher((state_t*)stream, ctx.RoundKey, params.nr);
+        Cipher((state_t*)stream, &ctx->round_keys[0][0], (uint8_t)ctx->rounds);
 
         size_t block_len = len - offset;
         if (block_len > AES_BLOCKLEN) {
@@ -411,71 +407,255 @@ aes_ctr_xcrypt_bytes(const uint8_t* counter, const uint8_t* key, uint8_t* data,
         for (size_t i = 0U; i < block_len; i++) {
             data[offset + i] ^= stream[i];
         }
-        aes_increment_counter_be(counter_block);
+        dsd_aes_counter_increment(counter_block);
     }
 }
 
-//byte-wise output of AES OFB Keystream
-//input iv is a 16-byte uint8_t array of initialization vector
-//input key is up to 32-byte uint8_t array of key value
-//input key_size is the AES key length
-//input nblocks is the number of rounds of 16-byte keystream output blocks requried
-//output is a uint8_t bytewise array, each round filled with 16-bytes from aes keystream output
-void
-aes_ofb_keystream_output(const uint8_t* iv, const uint8_t* key, uint8_t* output, dsd_aes_key_size key_size,
-                         int nblocks) {
+static void
+aes_portable_ecb_decrypt(const dsd_aes_key_ctx* ctx, const uint8_t* input, uint8_t* output, int nblocks) {
+    for (int i = 0; i < nblocks; i++) {
+        uint8_t block[AES_BLOCKLEN];
+        const size_t offset = (size_t)i * AES_BLOCKLEN;
+        DSD_MEMCPY(block, input + offset, sizeof(block));
+        InvCipher((state_t*)block, &ctx->round_keys[0][0], (uint8_t)ctx->rounds);
+        DSD_MEMCPY(output + offset, block, sizeof(block));
+    }
+}
 
-    if (iv == NULL || key == NULL || output == NULL || nblocks <= 0) {
-        return;
+const dsd_aes_backend dsd_aes_backend_portable = {
+    "portable",
+    aes_portable_ofb,
+    aes_portable_ctr,
+    aes_portable_ecb_decrypt,
+};
+
+enum { AES_BACKEND_UNSET = 0, AES_BACKEND_PORTABLE = 1, AES_BACKEND_AESNI = 2, AES_BACKEND_ARMCE = 3 };
+
+static atomic_int g_aes_backend_id = AES_BACKEND_UNSET;
+
+static int
+aes_backend_probe(void) {
+#if defined(DSD_NEO_CRYPTO_HAVE_AESNI)
+    if (dsd_aes_cpu_has_aesni()) {
+        return AES_BACKEND_AESNI;
     }
+#endif
+#if defined(DSD_NEO_CRYPTO_HAVE_ARMCE)
+    if (dsd_aes_cpu_has_armce()) {
+        return AES_BACKEND_ARMCE;
+    }
+#endif
+    return AES_BACKEND_PORTABLE;
+}
 
-    int i;
-    uint8_t input_register[16]; //OFB Input Register
-    DSD_MEMSET(input_register, 0, sizeof(input_register));
+static const dsd_aes_backend*
+aes_backend_for_id(int id) {
+    switch (id) {
+#if defined(DSD_NEO_CRYPTO_HAVE_AESNI)
+        case AES_BACKEND_AESNI: return &dsd_aes_backend_aesni;
+#endif
+#if defined(DSD_NEO_CRYPTO_HAVE_ARMCE)
+        case AES_BACKEND_ARMCE: return &dsd_aes_backend_armce;
+#endif
+        default: return &dsd_aes_backend_portable;
+    }
+}
+
+const dsd_aes_backend*
+dsd_aes_backend_active(void) {
+    int id = atomic_load(&g_aes_backend_id);
+    if (id == AES_BACKEND_UNSET) {
+        // Probing is idempotent, so racing first calls simply agree.
+        id = aes_backend_probe();
+        atomic_store(&g_aes_backend_id, id);
+    }
+    return aes_backend_for_id(id);
+}
+
+int
+dsd_aes_available_backends(const dsd_aes_backend** out, int cap) {
+    int n = 0;
+    if (out == NULL || cap <= 0) {
+        return 0;
+    }
+    out[n++] = &dsd_aes_backend_portable;
+#if defined(DSD_NEO_CRYPTO_HAVE_AESNI)
+    if (n < cap && dsd_aes_cpu_has_aesni()) {
+        out[n++] = &dsd_aes_backend_aesni;
+    }
+#endif
+#if defined(DSD_NEO_CRYPTO_HAVE_ARMCE)
+    if (n < cap && dsd_aes_cpu_has_armce()) {
+        out[n++] = &dsd_aes_backend_armce;
+    }
+#endif
+    return n;
+}
+
+const char*
+dsd_aes_backend_name(void) {
+    return dsd_aes_backend_active()->name;
+}
+
+int
+dsd_aes_key_ctx_init(dsd_aes_key_ctx* ctx, const uint8_t* key, dsd_aes_key_size key_size) {
+    if (ctx == NULL) {
+        return -1;
+    }
+    DSD_MEMSET(ctx, 0, sizeof(*ctx));
 
     aes_params_t params;
-    if (!aes_params_for_key_size(key_size, &params)) {
+    if (key == NULL || !aes_params_for_key_size(key_size, &params)) {
+        return -1;
+    }
+    KeyExpansion(&ctx->round_keys[0][0], key, params.nk, params.nr);
+
+    // Equivalent inverse cipher (FIPS-197 5.3.5): reversed schedule, InvMixColumns on the inner round keys.
+    const unsigned nr = params.nr;
+    DSD_MEMCPY(ctx->dec_round_keys[0], ctx->round_keys[nr], AES_BLOCKLEN);
+    for (unsigned r = 1U; r < nr; r++) {
+        DSD_MEMCPY(ctx->dec_round_keys[r], ctx->round_keys[nr - r], AES_BLOCKLEN);
+        InvMixColumns((state_t*)ctx->dec_round_keys[r]);
+    }
+    DSD_MEMCPY(ctx->dec_round_keys[nr], ctx->round_keys[0], AES_BLOCKLEN);
+    ctx->rounds = (int)nr;
+    return 0;
+}
+
+void
+dsd_aes_key_ctx_clear(dsd_aes_key_ctx* ctx) {
+    if (ctx == NULL) {
         return;
     }
+    dsd_aes_wipe(ctx, sizeof(*ctx));
+}
 
-    struct AES_ctx ctx;
+typedef struct {
+    uint64_t last_use; // 0 = empty
+    dsd_aes_key_size key_size;
+    uint8_t key[32];
+    dsd_aes_key_ctx ctx;
+} aes_key_cache_entry;
 
-    //load first round of input_register with received IV (OFB First Input Register)
-    DSD_MEMCPY(input_register, iv, ((size_t)16) * sizeof(uint8_t));
+typedef struct {
+    uint64_t clock;
+    int generation; // g_aes_key_cache_generation the entries were filled under
+    aes_key_cache_entry entries[AES_KEY_CACHE_SLOTS];
+} aes_key_cache;
 
-    //initialize the key variable for the Cipher function
-    DSD_MEMSET(ctx.RoundKey, 0, ((size_t)AES_ROUND_KEY_BYTES) * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key, params.nk, params.nr);
+static AES_TLS aes_key_cache t_aes_key_cache;
+// Bumped by dsd_aes_key_cache_flush(); every thread's cache wipes itself on its next lookup after a bump.
+static atomic_int g_aes_key_cache_generation = 0;
 
-    //execute the cipher function, and copy ciphered input_register to output for required number of rounds
-    for (i = 0; i < nblocks; i++) {
-        Cipher((state_t*)input_register, ctx.RoundKey,
-               params.nr); //input_register is returned as output, and is put back in as object feedback
-        DSD_MEMCPY(output + ((size_t)i * 16), input_register,
-                   ((size_t)16) * sizeof(uint8_t)); //copy ciphered input_register to output
+static void
+aes_key_cache_entry_wipe(aes_key_cache_entry* e) {
+    dsd_aes_key_ctx_clear(&e->ctx);
+    dsd_aes_wipe(e->key, sizeof(e->key));
+    e->key_size = (dsd_aes_key_size)0;
+    e->last_use = 0U;
+}
+
+static void
+aes_key_cache_wipe(aes_key_cache* cache, int generation) {
+    for (int i = 0; i < AES_KEY_CACHE_SLOTS; i++) {
+        aes_key_cache_entry_wipe(&cache->entries[i]);
     }
+    cache->clock = 0U;
+    cache->generation = generation;
 }
 
 void
-aes_ecb_decrypt_blocks(const uint8_t* input, const uint8_t* key, uint8_t* output, dsd_aes_key_size key_size,
-                       int nblocks) {
-    if (input == NULL || key == NULL || output == NULL || nblocks <= 0) {
+dsd_aes_key_cache_flush(void) {
+    const int generation = atomic_fetch_add(&g_aes_key_cache_generation, 1) + 1;
+    aes_key_cache_wipe(&t_aes_key_cache, generation);
+}
+
+const dsd_aes_key_ctx*
+dsd_aes_key_ctx_cached(const uint8_t* key, dsd_aes_key_size key_size) {
+    aes_params_t params;
+    if (key == NULL || !aes_params_for_key_size(key_size, &params)) {
+        return NULL;
+    }
+    const size_t key_bytes = (size_t)params.nk * 4U;
+
+    aes_key_cache* cache = &t_aes_key_cache;
+    const int generation = atomic_load(&g_aes_key_cache_generation);
+    if (cache->generation != generation) {
+        aes_key_cache_wipe(cache, generation);
+    }
+    aes_key_cache_entry* victim = &cache->entries[0];
+    cache->clock++;
+    for (int i = 0; i < AES_KEY_CACHE_SLOTS; i++) {
+        aes_key_cache_entry* e = &cache->entries[i];
+        if (e->last_use != 0U && e->key_size == key_size && memcmp(e->key, key, key_bytes) == 0) {
+            e->last_use = cache->clock;
+            return &e->ctx;
+        }
+        if (e->last_use < victim->last_use) {
+            victim = e;
+        }
+    }
+
+    aes_key_cache_entry_wipe(victim);
+    (void)dsd_aes_key_ctx_init(&victim->ctx, key, key_size);
+    DSD_MEMCPY(victim->key, key, key_bytes);
+    victim->key_size = key_size;
+    victim->last_use = cache->clock;
+    return &victim->ctx;
+}
+
+void
+dsd_aes_ctx_ofb_keystream(const dsd_aes_key_ctx* ctx, const uint8_t* iv, uint8_t* output, int nblocks) {
+    if (ctx == NULL || ctx->rounds == 0 || iv == NULL || output == NULL || nblocks <= 0) {
         return;
     }
+    dsd_aes_backend_active()->ofb(ctx, iv, output, nblocks);
+}
 
-    aes_params_t params;
-    if (!aes_params_for_key_size(key_size, &params)) {
+void
+dsd_aes_ctx_ctr_xcrypt(const dsd_aes_key_ctx* ctx, const uint8_t* counter, uint8_t* data, size_t len) {
+    if (ctx == NULL || ctx->rounds == 0 || counter == NULL || data == NULL || len == 0U) {
         return;
     }
-    struct AES_ctx ctx;
-    DSD_MEMSET(ctx.RoundKey, 0, ((size_t)AES_ROUND_KEY_BYTES) * sizeof(uint8_t));
-    KeyExpansion(ctx.RoundKey, key, params.nk, params.nr);
+    dsd_aes_backend_active()->ctr(ctx, counter, data, len);
+}
 
-    for (int i = 0; i < nblocks; i++) {
-        uint8_t block[AES_BLOCKLEN];
-        const size_t offset = (size_t)i * AES_BLOCKLEN;
-        DSD_MEMCPY(block, input + offset, sizeof(block));
-        InvCipher((state_t*)block, ctx.RoundKey, params.nr);
-        DSD_MEMCPY(output + offset, block, sizeof(block));
+void
+dsd_aes_ctx_ecb_decrypt(const dsd_aes_key_ctx* ctx, const uint8_t* input, uint8_t* output, int nblocks) {
+    if (ctx == NULL || ctx->rounds == 0 || input == NULL || output == NULL || nblocks <= 0) {
+        return;
+    }
+    dsd_aes_backend_active()->ecb_decrypt(ctx, input, output, nblocks);
+}
+
+void
+aes_ctr_xcrypt_bytes(const uint8_t* counter, const uint8_t* key, uint8_t* data, dsd_aes_key_size key_size, size_t len) {
+    if (counter == NULL || key == NULL || data == NULL || len == 0U) {
+        return;
+    }
+    dsd_aes_ctx_ctr_xcrypt(dsd_aes_key_ctx_cached(key, key_size), counter, data, len);
+}
+
+//byte-wise output of AES OFB Keystream
+//input iv is a 16-byte uint8_t array of initialization vector
+//input key is up to 32-byte uint8_t array of key value
+//input key_size is the AES key length
+//input nblocks is the number of rounds of 16-byte keystream output blocks requried
+//output is a uint8_t bytewise array, each round filled with 16-bytes from aes keystream output
+void
+aes_ofb_keystream_output(const uint8_t* iv, const uint8_t* key, uint8_t* output, dsd_aes_key_size key_size,
+                         int nblocks) {
+    if (iv == NULL || key == NULL || output == NULL || nblocks <= 0) {
+        return;
+    }
+    dsd_aes_ctx_ofb_keystream(dsd_aes_key_ctx_cached(key, key_size), iv, output, nblocks);
+}
+
+void
+aes_ecb_decrypt_blocks(const uint8_t* input, const uint8_t* key, uint8_t* output, dsd_aes_key_size key_size,
+                       int nblocks) {
+    if (input == NULL || key == NULL || output == NULL || nblocks <= 0) {
+        return;
     }
+    dsd_aes_ctx_ecb_decrypt(dsd_aes_key_ctx_cached(key, key_size), input, output, nblocks);
 }
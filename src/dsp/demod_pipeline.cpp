@@ -19,10 +19,13 @@
 #include <dsd-neo/dsp/math_utils.h>
 #include <dsd-neo/dsp/simd_fir.h>
 #include <dsd-neo/dsp/ted.h>
+#include <dsd-neo/platform/threading.h>
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/mem.h>
 #include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
+#include <dsd-neo/runtime/worker_pool.h>
 #include <math.h>
+#include <new>
 #include <stdio.h>
 #include "dsd-neo/core/safe_api.h"
 #include "dsd-neo/dsp/fsk_modem.h"
@@ -523,35 +526,42 @@ channel_lpf_ensure_plan(struct demod_state* d) {
     d->channel_lpf_plan_taps_len = taps_len;
 }
 
-static void
-channel_lpf_apply(struct demod_state* d) {
-    if (!d || !d->channel_lpf_enable || d->lp_len < 2) {
-        return;
-    }
-
+/* Filter `len` interleaved floats from `in` into `out`; returns the output length. */
+static int
+channel_lpf_run(struct demod_state* d, const float* in, int len, float* out) {
     channel_lpf_ensure_plan(d);
     const float* taps = d->channel_lpf_plan_taps;
     int taps_len = d->channel_lpf_plan_taps_len;
     if (!taps || taps_len < 3) {
-        return;
+        return -1;
     }
 
     const int hist_len = taps_len - 1;
-    const int N = d->lp_len >> 1; /* complex samples */
+    const int N = len >> 1; /* complex samples */
     if (hist_len > d->channel_lpf_hist_len) {
         d->channel_lpf_hist_len = hist_len;
     }
 
-    const float* in = assume_aligned_ptr(d->lowpassed, DSD_NEO_ALIGN);
-    float* out = (d->lowpassed == d->hb_workbuf) ? d->timing_buf : d->hb_workbuf;
     float* hi = assume_aligned_ptr(d->channel_lpf_hist_i, DSD_NEO_ALIGN);
     float* hq = assume_aligned_ptr(d->channel_lpf_hist_q, DSD_NEO_ALIGN);
 
     /* Use SIMD-dispatched complex symmetric FIR */
-    simd_fir_complex_apply(in, d->lp_len, out, hi, hq, taps, taps_len);
+    simd_fir_complex_apply(assume_aligned_ptr(in, DSD_NEO_ALIGN), len, out, hi, hq, taps, taps_len);
+    return N << 1;
+}
 
+static void
+channel_lpf_apply(struct demod_state* d) {
+    if (!d || !d->channel_lpf_enable || d->lp_len < 2) {
+        return;
+    }
+    float* out = (d->lowpassed == d->hb_workbuf) ? d->timing_buf : d->hb_workbuf;
+    int out_len = channel_lpf_run(d, d->lowpassed, d->lp_len, out);
+    if (out_len < 0) {
+        return;
+    }
     d->lowpassed = out;
-    d->lp_len = N << 1;
+    d->lp_len = out_len;
 }
 
 /**
@@ -978,31 +988,48 @@ iq_dc_block(struct demod_state* d) {
 }
 
 /**
- * @brief Apply stage-wise half-band decimation for complex baseband.
+ * @brief Run the remaining half-band stages on `src`.
+ *
+ * Stages the capture thread already ran (`ingest_hb_passes`) are skipped; the
+ * remaining stages keep their own history slots. Stage outputs alternate
+ * between `dst_a` and `dst_b`, starting with `dst_a`.
+ *
+ * @return Buffer holding the output (`src` when no stage ran); `*len` is updated.
  */
-static void
-full_demod_apply_halfband_decimation(struct demod_state* d) {
-    if (!d || d->downsample_passes <= 0) {
-        return;
-    }
-    int in_len = d->lp_len;
-    float* src = d->lowpassed;
-    float* dst = d->hb_workbuf;
-    for (int i = 0; i < d->downsample_passes; i++) {
+static float*
+halfband_cascade(struct demod_state* d, float* src, int* len, float* dst_a, float* dst_b) {
+    int in_len = *len;
+    float* dst = dst_a;
+    int first = (d->ingest_hb_passes > 0) ? d->ingest_hb_passes : 0;
+    for (int i = first; i < d->downsample_passes; i++) {
         const float* taps = (i == 0) ? hb31_q15_taps : hb_q15_taps;
         int taps_len = (i == 0) ? 31 : HB_TAPS;
         int out_len = simd_hb_decim2_complex(src, in_len, dst, d->hb_hist_i[i], d->hb_hist_q[i], taps, taps_len);
         src = dst;
         in_len = out_len;
-        dst = (src == d->hb_workbuf) ? d->lowpassed : d->hb_workbuf;
+        dst = (src == dst_a) ? dst_b : dst_a;
     }
-    d->lowpassed = src;
-    d->lp_len = in_len;
+    *len = in_len;
+    return src;
+}
+
+/**
+ * @brief Apply stage-wise half-band decimation for complex baseband.
+ *
+ * Ping-pongs between `hb_workbuf` and the input buffer.
+ */
+static void
+full_demod_apply_halfband_decimation(struct demod_state* d) {
+    if (!d || d->downsample_passes <= 0) {
+        return;
+    }
+    int len = d->lp_len;
+    d->lowpassed = halfband_cascade(d, d->lowpassed, &len, d->hb_workbuf, d->lowpassed);
+    d->lp_len = len;
 }
 
 static void
 full_demod_update_channel_state(struct demod_state* d) {
-    channel_lpf_apply(d);
     if (d->lowpassed && d->lp_len >= 2) {
         int n = (d->lp_len > 512) ? 512 : d->lp_len;
         d->channel_pwr = mean_power(d->lowpassed, n, 1);
@@ -1029,8 +1056,8 @@ full_demod_emit_zero_cqpsk_symbols(struct demod_state* d) {
     int out_syms = (in_pairs + sps - 1) / sps;
     if (out_syms < 1) {
         out_syms = 1;
-    } else if (out_syms > MAXIMUM_BUF_LENGTH) {
-        out_syms = MAXIMUM_BUF_LENGTH;
+    } else if (out_syms > d->work_len) {
+        out_syms = d->work_len;
     }
     for (int k = 0; k < out_syms; k++) {
         d->result[k] = 0.0f;
@@ -1178,13 +1205,13 @@ full_demod_handle_fsk_output(struct demod_state* d) {
     int in_pairs = d->lp_len >> 1;
     if (d->channel_squelched) {
         dsd_fsk_modem_reset(&d->fsk_modem_state);
-        d->result_len = in_pairs < MAXIMUM_BUF_LENGTH ? in_pairs : MAXIMUM_BUF_LENGTH;
+        d->result_len = in_pairs < d->work_len ? in_pairs : d->work_len;
         for (int i = 0; i < d->result_len; i++) {
             d->result[i] = 0.0f;
         }
     } else {
         d->result_len = dsd_fsk_modem_discriminator_process(&d->fsk_modem_state, d->lowpassed, d->lp_len, d->result,
-                                                            MAXIMUM_BUF_LENGTH);
+                                                            d->work_len);
     }
     return 1;
 }
@@ -1324,12 +1351,21 @@ full_demod_apply_squelch_envelope(struct demod_state* d) {
     }
 }
 
-/**
- * @brief Full demodulation pipeline for one block.
+/*
+ * Block pipeline split. The front half (half-band cascade and channel LPF)
+ * runs at the capture rate and owns only its filter histories; the back half
+ * (squelch, carrier/timing recovery, discrimination, audio filters) runs at
+ * the narrow rate and owns everything else. Neither touches the other's loop
+ * state, which is what lets demod_pipeline_enable() overlap them.
  */
-void
-full_demod(struct demod_state* d) {
+static void
+full_demod_front(struct demod_state* d) {
     full_demod_apply_halfband_decimation(d);
+    channel_lpf_apply(d);
+}
+
+static void
+full_demod_back(struct demod_state* d) {
     full_demod_update_channel_state(d);
     if (full_demod_emit_zero_cqpsk_symbols(d)) {
         return;
@@ -1348,3 +1384,194 @@ full_demod(struct demod_state* d) {
     full_demod_apply_audio_post_filters(d);
     full_demod_apply_squelch_envelope(d);
 }
+
+/*
+ * Two-stage block pipeline. Each full_demod() call posts the front half of
+ * block N to the shared DSP pool and runs the back half of block N-1 on the
+ * caller, then waits for the front so the caller may release its input span.
+ * Front output lands in one of two slots; the slot the back half reads stays
+ * untouched until the following call, so post-demod consumers of `lowpassed`
+ * (metrics, scope views) still see a stable block.
+ */
+struct DemodStageSlot {
+    float* buf_a;
+    float* buf_b;
+    float* data; /* buf_a or buf_b once filled */
+    int len;
+    int valid;
+};
+
+struct demod_stage_pipe {
+    float* storage; /* 4 x slot_len floats */
+    int slot_len;
+    DemodStageSlot slots[2];
+    int fill; /* slot the next front half writes */
+
+    /* Front job handoff: a depth-1 queue in each direction. */
+    struct demod_state* d;
+    float* in;
+    int in_len;
+    int front_busy; /* guarded by m */
+    dsd_mutex_t m;
+    dsd_cond_t cv;
+};
+
+static void
+demod_stage_front_task(void* arg) {
+    struct demod_stage_pipe* p = static_cast<struct demod_stage_pipe*>(arg);
+    struct demod_state* d = p->d;
+    DemodStageSlot* slot = &p->slots[p->fill];
+    int len = p->in_len;
+    float* out = p->in;
+    if (d->downsample_passes > 0) {
+        out = halfband_cascade(d, out, &len, slot->buf_a, slot->buf_b);
+    }
+    if (d->channel_lpf_enable && len >= 2) {
+        float* dst = (out == slot->buf_a) ? slot->buf_b : slot->buf_a;
+        int lpf_len = channel_lpf_run(d, out, len, dst);
+        if (lpf_len >= 0) {
+            out = dst;
+            len = lpf_len;
+        }
+    }
+    if (out == p->in) {
+        /* Nothing ran; the input span is released before the back half sees it. */
+        DSD_MEMCPY(slot->buf_a, p->in, (size_t)len * sizeof(float));
+        out = slot->buf_a;
+    }
+    slot->data = out;
+    slot->len = len;
+    slot->valid = 1;
+
+    dsd_mutex_lock(&p->m);
+    p->front_busy = 0;
+    dsd_cond_signal(&p->cv);
+    dsd_mutex_unlock(&p->m);
+}
+
+static int
+demod_stage_pipe_reserve(struct demod_stage_pipe* p, int work_len) {
+    if (p->storage && p->slot_len >= work_len) {
+        return 0;
+    }
+    float* storage = static_cast<float*>(dsd_neo_aligned_malloc((size_t)4 * (size_t)work_len * sizeof(float)));
+    if (!storage) {
+        return -1;
+    }
+    if (p->storage) {
+        dsd_neo_aligned_free(p->storage);
+    }
+    p->storage = storage;
+    p->slot_len = work_len;
+    for (int i = 0; i < 2; i++) {
+        p->slots[i].buf_a = storage + (size_t)(2 * i) * (size_t)work_len;
+        p->slots[i].buf_b = storage + (size_t)(2 * i + 1) * (size_t)work_len;
+        p->slots[i].data = NULL;
+        p->slots[i].len = 0;
+        p->slots[i].valid = 0;
+    }
+    return 0;
+}
+
+static void
+full_demod_pipelined(struct demod_state* d, struct demod_stage_pipe* p) {
+    const int fill = p->fill;
+    const int drain = fill ^ 1;
+    const int post_front = (d->lowpassed && d->lp_len > 0) ? 1 : 0;
+    if (post_front) {
+        p->d = d;
+        p->in = d->lowpassed;
+        p->in_len = d->lp_len;
+        p->slots[fill].valid = 0;
+        p->front_busy = 1;
+        dsp_pool_post(demod_mt_task{demod_stage_front_task, p});
+    }
+
+    DemodStageSlot* ready = &p->slots[drain];
+    if (ready->valid) {
+        d->lowpassed = ready->data;
+        d->lp_len = ready->len;
+        ready->valid = 0;
+        full_demod_back(d);
+    } else {
+        /* Pipeline still filling (first block, or after a flush). */
+        d->lp_len = 0;
+        d->result_len = 0;
+    }
+
+    if (post_front) {
+        dsd_mutex_lock(&p->m);
+        while (p->front_busy) {
+            dsd_cond_wait(&p->cv, &p->m);
+        }
+        dsd_mutex_unlock(&p->m);
+        p->fill = drain;
+    }
+}
+
+/**
+ * @brief Full demodulation pipeline for one block.
+ */
+void
+full_demod(struct demod_state* d) {
+    struct demod_stage_pipe* p = d->stage_pipe;
+    if (p && dsp_pool_size() > 0 && d->work_len > 0 && demod_stage_pipe_reserve(p, d->work_len) == 0) {
+        full_demod_pipelined(d, p);
+        return;
+    }
+    full_demod_front(d);
+    full_demod_back(d);
+}
+
+int
+demod_pipeline_enable(struct demod_state* d) {
+    if (!d) {
+        return -1;
+    }
+    if (d->stage_pipe) {
+        return 0;
+    }
+    if (dsp_pool_size() <= 0) {
+        return -1;
+    }
+    struct demod_stage_pipe* p = new (std::nothrow) demod_stage_pipe();
+    if (!p) {
+        return -1;
+    }
+    if (d->work_len > 0 && demod_stage_pipe_reserve(p, d->work_len) != 0) {
+        delete p;
+        return -1;
+    }
+    dsd_mutex_init(&p->m);
+    dsd_cond_init(&p->cv);
+    d->stage_pipe = p;
+    return 0;
+}
+
+void
+demod_pipeline_flush(struct demod_state* d) {
+    if (!d || !d->stage_pipe) {
+        return;
+    }
+    d->stage_pipe->slots[0].valid = 0;
+    d->stage_pipe->slots[1].valid = 0;
+}
+
+void
+demod_pipeline_disable(struct demod_state* d) {
+    if (!d || !d->stage_pipe) {
+        return;
+    }
+    struct demod_stage_pipe* p = d->stage_pipe;
+    d->stage_pipe = NULL;
+    if (p->storage && d->lowpassed >= p->storage && d->lowpassed < p->storage + (size_t)4 * (size_t)p->slot_len) {
+        d->lowpassed = d->input_cb_buf;
+        d->lp_len = 0;
+    }
+    dsd_cond_destroy(&p->cv);
+    dsd_mutex_destroy(&p->m);
+    if (p->storage) {
+        dsd_neo_aligned_free(p->storage);
+    }
+    delete p;
+}
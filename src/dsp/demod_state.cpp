@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Work-buffer arena for the demodulator state.
+ *
+ * The four full-length block buffers share one aligned allocation sized to
+ * the configured block length, so a typical stream touches a few hundred KiB
+ * per block instead of fixed worst-case arrays. The resampler output buffer
+ * depends on the L/M ratio and is allocated separately.
+ */
+
+#include <dsd-neo/dsp/demod_state.h>
+#include <dsd-neo/dsp/resampler.h>
+#include <dsd-neo/runtime/mem.h>
+#include <stddef.h>
+
+namespace {
+
+/* Work buffers carved from the arena, in order. */
+constexpr int kArenaBuffers = 4;
+
+int
+round_work_len(int block_len) {
+    if (block_len > MAXIMUM_BUF_LENGTH) {
+        block_len = MAXIMUM_BUF_LENGTH;
+    }
+    /* Whole 64-byte lines per buffer keep every carved pointer aligned. */
+    return (block_len + 15) & ~15;
+}
+
+/* Whether `lowpassed` points into the current arena (or nowhere yet). */
+int
+lowpassed_in_arena(const struct demod_state* s) {
+    if (!s->lowpassed) {
+        return 1;
+    }
+    return (s->work_arena && s->lowpassed >= s->work_arena
+            && s->lowpassed < s->work_arena + (size_t)kArenaBuffers * (size_t)s->work_len)
+               ? 1
+               : 0;
+}
+
+int
+resamp_len_for(const struct demod_state* s, int work_len) {
+    if (!s->resamp_enabled || s->resamp_L < 1 || s->resamp_M < 1) {
+        return 0;
+    }
+    return (resamp_output_capacity(s, work_len) + 15) & ~15;
+}
+
+} // namespace
+
+int
+demod_buffers_reserve(struct demod_state* s, int block_len) {
+    if (!s || block_len <= 0) {
+        return -1;
+    }
+    const int work_len = round_work_len(block_len);
+    const int resamp_len = resamp_len_for(s, work_len);
+
+    float* arena = s->work_arena;
+    if (!arena || work_len != s->work_len) {
+        arena = static_cast<float*>(
+            dsd_neo_aligned_malloc((size_t)kArenaBuffers * (size_t)work_len * sizeof(float)));
+        if (!arena) {
+            return -1;
+        }
+    }
+    float* resamp = s->resamp_outbuf;
+    if (resamp_len != s->resamp_out_len || (resamp_len > 0 && !resamp)) {
+        resamp = NULL;
+        if (resamp_len > 0) {
+            resamp = static_cast<float*>(dsd_neo_aligned_malloc((size_t)resamp_len * sizeof(float)));
+            if (!resamp) {
+                if (arena != s->work_arena) {
+                    dsd_neo_aligned_free(arena);
+                }
+                return -1;
+            }
+        }
+        if (s->resamp_outbuf) {
+            dsd_neo_aligned_free(s->resamp_outbuf);
+        }
+        s->resamp_outbuf = resamp;
+        s->resamp_out_len = resamp_len;
+    }
+
+    if (arena != s->work_arena) {
+        const int repoint_lowpassed = lowpassed_in_arena(s);
+        if (s->work_arena) {
+            dsd_neo_aligned_free(s->work_arena);
+        }
+        s->work_arena = arena;
+        s->work_len = work_len;
+        s->input_cb_buf = arena;
+        s->result = arena + work_len;
+        s->timing_buf = arena + (size_t)2 * (size_t)work_len;
+        s->hb_workbuf = arena + (size_t)3 * (size_t)work_len;
+        if (repoint_lowpassed) {
+            s->lowpassed = s->input_cb_buf;
+        }
+    }
+    return 0;
+}
+
+void
+demod_buffers_release(struct demod_state* s) {
+    if (!s) {
+        return;
+    }
+    if (lowpassed_in_arena(s)) {
+        s->lowpassed = NULL;
+    }
+    if (s->work_arena) {
+        dsd_neo_aligned_free(s->work_arena);
+    }
+    if (s->resamp_outbuf) {
+        dsd_neo_aligned_free(s->resamp_outbuf);
+    }
+    s->work_arena = NULL;
+    s->input_cb_buf = NULL;
+    s->result = NULL;
+    s->timing_buf = NULL;
+    s->hb_workbuf = NULL;
+    s->resamp_outbuf = NULL;
+    s->work_len = 0;
+    s->resamp_out_len = 0;
+}
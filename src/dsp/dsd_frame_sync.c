@@ -34,7 +34,6 @@
 #include <dsd-neo/dsp/frame_sync.h>
 #include <dsd-neo/dsp/symbol.h>
 #include <dsd-neo/dsp/sync_calibration.h>
-#include <dsd-neo/dsp/sync_hamming.h>
 #include <dsd-neo/platform/atomic_compat.h>
 #include <dsd-neo/runtime/colors.h>
 #include <dsd-neo/runtime/config.h>
@@ -53,8 +52,10 @@
 #include "dsd-neo/core/safe_api.h"
 #include "dsd-neo/core/state_fwd.h"
 #include "dsd-neo/platform/timing.h"
+#include "frame_sync_corr.h"
 #include "frame_sync_internal.h"
 #include "frame_sync_level.h"
+#include "frame_sync_race.h"
 #ifdef DSD_NEO_TEST_HOOKS
 #include "frame_sync_test_support.h"
 #endif
@@ -313,6 +314,273 @@ enum {
     FRAME_SYNC_WINDOW_48 = 1u << 7,
 };
 
+/* Every pattern the hunt tests, in the order of k_frame_sync_pattern_specs. */
+typedef enum {
+    FRAME_SYNC_PAT_P25P1 = 0,
+    FRAME_SYNC_PAT_P25P1_INV,
+    FRAME_SYNC_PAT_P25P1_ROT,     /* three CQPSK rotation maps, see k_frame_sync_cqpsk_rotation_maps */
+    FRAME_SYNC_PAT_P25P1_INV_ROT = FRAME_SYNC_PAT_P25P1_ROT + 3,
+    FRAME_SYNC_PAT_P25P2 = FRAME_SYNC_PAT_P25P1_INV_ROT + 3,
+    FRAME_SYNC_PAT_P25P2_INV,
+    FRAME_SYNC_PAT_P25P2_ROT,
+    FRAME_SYNC_PAT_P25P2_INV_ROT = FRAME_SYNC_PAT_P25P2_ROT + 3,
+    FRAME_SYNC_PAT_X2TDMA_BS_DATA = FRAME_SYNC_PAT_P25P2_INV_ROT + 3,
+    FRAME_SYNC_PAT_X2TDMA_MS_DATA,
+    FRAME_SYNC_PAT_X2TDMA_BS_VOICE,
+    FRAME_SYNC_PAT_X2TDMA_MS_VOICE,
+    FRAME_SYNC_PAT_YSF,
+    FRAME_SYNC_PAT_YSF_INV,
+    FRAME_SYNC_PAT_DPMR_FS1,
+    FRAME_SYNC_PAT_DPMR_FS4,
+    FRAME_SYNC_PAT_DPMR_FS1_INV,
+    FRAME_SYNC_PAT_DPMR_FS4_INV,
+    FRAME_SYNC_PAT_DPMR_FS2,
+    FRAME_SYNC_PAT_DPMR_FS2_INV,
+    FRAME_SYNC_PAT_M17_PRE,
+    FRAME_SYNC_PAT_M17_PIV,
+    FRAME_SYNC_PAT_M17_LSF,
+    FRAME_SYNC_PAT_M17_STR,
+    FRAME_SYNC_PAT_M17_PKT,
+    FRAME_SYNC_PAT_M17_BRT,
+    FRAME_SYNC_PAT_M17_EOT,
+    FRAME_SYNC_PAT_M17_EOT_INV,
+    FRAME_SYNC_PAT_M17_PRE_REPEAT, /* first 8 of the 16-symbol window */
+    FRAME_SYNC_PAT_M17_PIV_REPEAT,
+    FRAME_SYNC_PAT_DMR_BS_DATA,
+    FRAME_SYNC_PAT_DMR_BS_VOICE,
+    FRAME_SYNC_PAT_DMR_MS_DATA,
+    FRAME_SYNC_PAT_DMR_MS_VOICE,
+    FRAME_SYNC_PAT_DMR_DM_TS1_DATA,
+    FRAME_SYNC_PAT_DMR_DM_TS2_DATA,
+    FRAME_SYNC_PAT_DMR_DM_TS1_VOICE,
+    FRAME_SYNC_PAT_DMR_DM_TS2_VOICE,
+    FRAME_SYNC_PAT_DMR_MS_RC,
+    FRAME_SYNC_PAT_DMR_MS_RC_INV,
+    FRAME_SYNC_PAT_PROVOICE,
+    FRAME_SYNC_PAT_PROVOICE_EA,
+    FRAME_SYNC_PAT_PROVOICE_INV,
+    FRAME_SYNC_PAT_PROVOICE_EA_INV,
+    FRAME_SYNC_PAT_PROVOICE_CONV,     /* first 16 of the 32-symbol window */
+    FRAME_SYNC_PAT_PROVOICE_CONV_INV, /* first 16 of the 32-symbol window */
+    FRAME_SYNC_PAT_EDACS,
+    FRAME_SYNC_PAT_EDACS_INV,
+    FRAME_SYNC_PAT_DOTTING_A,
+    FRAME_SYNC_PAT_DOTTING_B,
+    FRAME_SYNC_PAT_DSTAR,
+    FRAME_SYNC_PAT_DSTAR_INV,
+    FRAME_SYNC_PAT_DSTAR_HD,
+    FRAME_SYNC_PAT_DSTAR_HD_INV,
+    FRAME_SYNC_PAT_NXDN_POS,       /* five accepted positive variants */
+    FRAME_SYNC_PAT_NXDN_NEG = FRAME_SYNC_PAT_NXDN_POS + 5,
+    FRAME_SYNC_PAT_COUNT = FRAME_SYNC_PAT_NXDN_NEG + 5,
+} frame_sync_pattern_id;
+
+enum {
+    FRAME_SYNC_NXDN_VARIANTS = 5,
+    FRAME_SYNC_CQPSK_ROTATIONS = 3,
+};
+
+/* CQPSK slicer rotations tried after the identity map, in preference order. */
+static const uint8_t k_frame_sync_cqpsk_rotation_maps[FRAME_SYNC_CQPSK_ROTATIONS] = {
+    DSD_P25_CQPSK_DIBIT_MAP_X2400,
+    DSD_P25_CQPSK_DIBIT_MAP_N1200,
+    DSD_P25_CQPSK_DIBIT_MAP_P1200,
+};
+
+typedef struct {
+    const char* text;
+    int window_len;
+    int cqpsk_rotation; /* index into k_frame_sync_cqpsk_rotation_maps, or -1 */
+} frame_sync_pattern_spec;
+
+static const frame_sync_pattern_spec k_frame_sync_pattern_specs[FRAME_SYNC_PAT_COUNT] = {
+    [FRAME_SYNC_PAT_P25P1] = {P25P1_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_P25P1_INV] = {INV_P25P1_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_P25P1_ROT + 0] = {P25P1_SYNC, 24, 0},
+    [FRAME_SYNC_PAT_P25P1_ROT + 1] = {P25P1_SYNC, 24, 1},
+    [FRAME_SYNC_PAT_P25P1_ROT + 2] = {P25P1_SYNC, 24, 2},
+    [FRAME_SYNC_PAT_P25P1_INV_ROT + 0] = {INV_P25P1_SYNC, 24, 0},
+    [FRAME_SYNC_PAT_P25P1_INV_ROT + 1] = {INV_P25P1_SYNC, 24, 1},
+    [FRAME_SYNC_PAT_P25P1_INV_ROT + 2] = {INV_P25P1_SYNC, 24, 2},
+    [FRAME_SYNC_PAT_P25P2] = {P25P2_SYNC, 20, -1},
+    [FRAME_SYNC_PAT_P25P2_INV] = {INV_P25P2_SYNC, 20, -1},
+    [FRAME_SYNC_PAT_P25P2_ROT + 0] = {P25P2_SYNC, 20, 0},
+    [FRAME_SYNC_PAT_P25P2_ROT + 1] = {P25P2_SYNC, 20, 1},
+    [FRAME_SYNC_PAT_P25P2_ROT + 2] = {P25P2_SYNC, 20, 2},
+    [FRAME_SYNC_PAT_P25P2_INV_ROT + 0] = {INV_P25P2_SYNC, 20, 0},
+    [FRAME_SYNC_PAT_P25P2_INV_ROT + 1] = {INV_P25P2_SYNC, 20, 1},
+    [FRAME_SYNC_PAT_P25P2_INV_ROT + 2] = {INV_P25P2_SYNC, 20, 2},
+    [FRAME_SYNC_PAT_X2TDMA_BS_DATA] = {X2TDMA_BS_DATA_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_X2TDMA_MS_DATA] = {X2TDMA_MS_DATA_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_X2TDMA_BS_VOICE] = {X2TDMA_BS_VOICE_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_X2TDMA_MS_VOICE] = {X2TDMA_MS_VOICE_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_YSF] = {FUSION_SYNC, 20, -1},
+    [FRAME_SYNC_PAT_YSF_INV] = {INV_FUSION_SYNC, 20, -1},
+    [FRAME_SYNC_PAT_DPMR_FS1] = {DPMR_FRAME_SYNC_1, 24, -1},
+    [FRAME_SYNC_PAT_DPMR_FS4] = {DPMR_FRAME_SYNC_4, 24, -1},
+    [FRAME_SYNC_PAT_DPMR_FS1_INV] = {INV_DPMR_FRAME_SYNC_1, 24, -1},
+    [FRAME_SYNC_PAT_DPMR_FS4_INV] = {INV_DPMR_FRAME_SYNC_4, 24, -1},
+    [FRAME_SYNC_PAT_DPMR_FS2] = {DPMR_FRAME_SYNC_2, 12, -1},
+    [FRAME_SYNC_PAT_DPMR_FS2_INV] = {INV_DPMR_FRAME_SYNC_2, 12, -1},
+    [FRAME_SYNC_PAT_M17_PRE] = {M17_PRE, 8, -1},
+    [FRAME_SYNC_PAT_M17_PIV] = {M17_PIV, 8, -1},
+    [FRAME_SYNC_PAT_M17_LSF] = {M17_LSF, 8, -1},
+    [FRAME_SYNC_PAT_M17_STR] = {M17_STR, 8, -1},
+    [FRAME_SYNC_PAT_M17_PKT] = {M17_PKT, 8, -1},
+    [FRAME_SYNC_PAT_M17_BRT] = {M17_BRT, 8, -1},
+    [FRAME_SYNC_PAT_M17_EOT] = {M17_EOT, 8, -1},
+    [FRAME_SYNC_PAT_M17_EOT_INV] = {M17_EOT_INV, 8, -1},
+    [FRAME_SYNC_PAT_M17_PRE_REPEAT] = {M17_PRE, 16, -1},
+    [FRAME_SYNC_PAT_M17_PIV_REPEAT] = {M17_PIV, 16, -1},
+    [FRAME_SYNC_PAT_DMR_BS_DATA] = {DMR_BS_DATA_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_BS_VOICE] = {DMR_BS_VOICE_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_MS_DATA] = {DMR_MS_DATA_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_MS_VOICE] = {DMR_MS_VOICE_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_DM_TS1_DATA] = {DMR_DIRECT_MODE_TS1_DATA_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_DM_TS2_DATA] = {DMR_DIRECT_MODE_TS2_DATA_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_DM_TS1_VOICE] = {DMR_DIRECT_MODE_TS1_VOICE_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_DM_TS2_VOICE] = {DMR_DIRECT_MODE_TS2_VOICE_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_MS_RC] = {DMR_MS_RC_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DMR_MS_RC_INV] = {DMR_MS_RC_SYNC_INV, 24, -1},
+    [FRAME_SYNC_PAT_PROVOICE] = {PROVOICE_SYNC, 32, -1},
+    [FRAME_SYNC_PAT_PROVOICE_EA] = {PROVOICE_EA_SYNC, 32, -1},
+    [FRAME_SYNC_PAT_PROVOICE_INV] = {INV_PROVOICE_SYNC, 32, -1},
+    [FRAME_SYNC_PAT_PROVOICE_EA_INV] = {INV_PROVOICE_EA_SYNC, 32, -1},
+    [FRAME_SYNC_PAT_PROVOICE_CONV] = {PROVOICE_CONV_SHORT, 32, -1},
+    [FRAME_SYNC_PAT_PROVOICE_CONV_INV] = {INV_PROVOICE_CONV_SHORT, 32, -1},
+    [FRAME_SYNC_PAT_EDACS] = {EDACS_SYNC, 48, -1},
+    [FRAME_SYNC_PAT_EDACS_INV] = {INV_EDACS_SYNC, 48, -1},
+    [FRAME_SYNC_PAT_DOTTING_A] = {DOTTING_SEQUENCE_A, 48, -1},
+    [FRAME_SYNC_PAT_DOTTING_B] = {DOTTING_SEQUENCE_B, 48, -1},
+    [FRAME_SYNC_PAT_DSTAR] = {DSTAR_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DSTAR_INV] = {INV_DSTAR_SYNC, 24, -1},
+    [FRAME_SYNC_PAT_DSTAR_HD] = {DSTAR_HD, 24, -1},
+    [FRAME_SYNC_PAT_DSTAR_HD_INV] = {INV_DSTAR_HD, 24, -1},
+    [FRAME_SYNC_PAT_NXDN_POS + 0] = {"3131331131", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_POS + 1] = {"3331331131", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_POS + 2] = {"3131331111", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_POS + 3] = {"3331331111", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_POS + 4] = {"3131311131", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_NEG + 0] = {"1313113313", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_NEG + 1] = {"1113113313", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_NEG + 2] = {"1313113333", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_NEG + 3] = {"1113113333", 10, -1},
+    [FRAME_SYNC_PAT_NXDN_NEG + 4] = {"1313133313", 10, -1},
+};
+
+static frame_sync_corr_pattern g_frame_sync_patterns[FRAME_SYNC_PAT_COUNT];
+static atomic_int g_frame_sync_patterns_state = 0; /* 0 unpacked, 1 packing, 2 ready */
+
+static void
+frame_sync_pack_patterns(void) {
+    for (int id = 0; id < FRAME_SYNC_PAT_COUNT; id++) {
+        const frame_sync_pattern_spec* spec = &k_frame_sync_pattern_specs[id];
+        uint8_t raw_for_expected[4];
+        const uint8_t* map = NULL;
+        if (spec->cqpsk_rotation >= 0) {
+            /* The rotated matchers accept a raw window that corrects to the pattern. */
+            const uint8_t map_idx = k_frame_sync_cqpsk_rotation_maps[spec->cqpsk_rotation];
+            for (uint8_t d = 0; d < 4u; d++) {
+                raw_for_expected[d] = dsd_p25_cqpsk_raw_dibit_for_corrected(map_idx, d);
+            }
+            map = raw_for_expected;
+        }
+        (void)frame_sync_corr_pattern_init(&g_frame_sync_patterns[id], spec->text, spec->window_len, map);
+    }
+}
+
+/* Packed pattern table, built by whichever decoder thread gets here first. */
+static const frame_sync_corr_pattern*
+frame_sync_patterns(void) {
+    if (atomic_load(&g_frame_sync_patterns_state) == 2) {
+        return g_frame_sync_patterns;
+    }
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&g_frame_sync_patterns_state, &expected, 1)) {
+        frame_sync_pack_patterns();
+        atomic_store(&g_frame_sync_patterns_state, 2);
+    } else {
+        while (atomic_load(&g_frame_sync_patterns_state) != 2) {
+            /* Another thread is packing; that takes microseconds. */
+        }
+    }
+    return g_frame_sync_patterns;
+}
+
+/*
+ * Recent symbols of the hunt. The packed correlator answers every pattern
+ * test; the character ring only backs the windows a lock path or debug print
+ * needs spelled out. All windows are suffixes of the newest 48 symbols, so
+ * one lazily built string serves every length until the next push.
+ */
+typedef struct {
+    frame_sync_corr corr;
+    const frame_sync_corr_pattern* patterns;
+    int history_head;
+    int text_valid;
+    char symbol_history[FRAME_SYNC_HISTORY_CAPACITY];
+    char text[FRAME_SYNC_HISTORY_CAPACITY + 1];
+} frame_sync_windows;
+
+static void
+frame_sync_windows_push(frame_sync_windows* win, char symbol) {
+    win->symbol_history[win->history_head] = symbol;
+    win->history_head = (win->history_head + 1) % FRAME_SYNC_HISTORY_CAPACITY;
+    frame_sync_corr_push(&win->corr, symbol);
+    win->text_valid = 0;
+}
+
+/* The newest `length` symbols as a C string, or NULL before that many arrived. */
+static const char*
+frame_sync_windows_text(frame_sync_windows* win, int length) {
+    const int count = win->corr.count;
+    if (length <= 0 || length > count) {
+        return NULL;
+    }
+    if (!win->text_valid) {
+        int index = win->history_head - count;
+        if (index < 0) {
+            index += FRAME_SYNC_HISTORY_CAPACITY;
+        }
+        for (int i = 0; i < count; i++) {
+            win->text[i] = win->symbol_history[index];
+            index = (index + 1) % FRAME_SYNC_HISTORY_CAPACITY;
+        }
+        win->text[count] = '\0';
+        win->text_valid = 1;
+    }
+    return win->text + (count - length);
+}
+
+static unsigned int
+frame_sync_windows_ready(const frame_sync_windows* win) {
+    static const int lengths[] = {8, 10, 12, 16, 20, 24, 32, 48};
+    unsigned int ready = 0;
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        if (frame_sync_corr_ready(&win->corr, lengths[i])) {
+            ready |= 1u << i;
+        }
+    }
+    return ready;
+}
+
+static int
+frame_sync_windows_ham(const frame_sync_windows* win, int id) {
+    return frame_sync_corr_hamming(&win->corr, &win->patterns[id]);
+}
+
+static int
+frame_sync_windows_best_ham(const frame_sync_windows* win, const int ids[], int count, int best_start) {
+    int best = best_start;
+    for (int i = 0; i < count; i++) {
+        const int ham = frame_sync_windows_ham(win, ids[i]);
+        if (ham < best) {
+            best = ham;
+        }
+    }
+    return best;
+}
+
 typedef struct {
     dsd_opts* opts;
     dsd_state* state;
@@ -323,16 +591,29 @@ typedef struct {
     float lmin;
     unsigned int ready_windows;
     char* modulation;
-    char* synctest;
-    char* synctest8;
-    char* synctest10;
-    char* synctest12;
-    char* synctest16;
-    char* synctest20;
-    char* synctest32;
-    char* synctest48;
+    frame_sync_windows* win;
 } frame_sync_match_ctx;
 
+static int
+frame_sync_match_is(const frame_sync_match_ctx* ctx, int id) {
+    return frame_sync_corr_match(&ctx->win->corr, &ctx->win->patterns[id]);
+}
+
+static int
+frame_sync_match_either(const frame_sync_match_ctx* ctx, int pattern_a, int pattern_b) {
+    return frame_sync_match_is(ctx, pattern_a) || frame_sync_match_is(ctx, pattern_b);
+}
+
+static int
+frame_sync_match_ham(const frame_sync_match_ctx* ctx, int id) {
+    return frame_sync_windows_ham(ctx->win, id);
+}
+
+static const char*
+frame_sync_match_text(const frame_sync_match_ctx* ctx, int length) {
+    return frame_sync_windows_text(ctx->win, length);
+}
+
 static unsigned int
 frame_sync_window_flag(int length) {
     switch (length) {
@@ -553,37 +834,13 @@ frame_sync_p25_cqpsk_map_requires_center_fit(uint8_t map_idx) {
     return map_idx == DSD_P25_CQPSK_DIBIT_MAP_N1200 || map_idx == DSD_P25_CQPSK_DIBIT_MAP_P1200;
 }
 
+/* Pattern ids `first_rotated` .. +2 hold the pattern packed for each rotation map. */
 static int
-frame_sync_cqpsk_window_matches_map(const char* raw_window, const char* expected, uint8_t map_idx) {
-    if (!raw_window || !expected) {
-        return 0;
-    }
-
-    size_t expected_len = strlen(expected);
-    for (size_t i = 0; i < expected_len; i++) {
-        if (raw_window[i] < '0' || raw_window[i] > '3') {
-            return 0;
-        }
-        uint8_t raw_dibit = (uint8_t)(raw_window[i] - '0');
-        uint8_t corrected = dsd_p25_cqpsk_correct_dibit(map_idx, raw_dibit);
-        if ((char)('0' + corrected) != expected[i]) {
-            return 0;
-        }
-    }
-    return raw_window[expected_len] == '\0';
-}
-
-static int
-frame_sync_find_rotated_p25_cqpsk_map(const char* raw_window, const char* expected, uint8_t* out_map_idx) {
-    static const uint8_t rotation_maps[] = {
-        DSD_P25_CQPSK_DIBIT_MAP_X2400,
-        DSD_P25_CQPSK_DIBIT_MAP_N1200,
-        DSD_P25_CQPSK_DIBIT_MAP_P1200,
-    };
-    for (size_t i = 0; i < sizeof(rotation_maps) / sizeof(rotation_maps[0]); i++) {
-        if (frame_sync_cqpsk_window_matches_map(raw_window, expected, rotation_maps[i])) {
+frame_sync_find_rotated_p25_cqpsk_map(const frame_sync_match_ctx* ctx, int first_rotated, uint8_t* out_map_idx) {
+    for (int i = 0; i < FRAME_SYNC_CQPSK_ROTATIONS; i++) {
+        if (frame_sync_match_is(ctx, first_rotated + i)) {
             if (out_map_idx) {
-                *out_map_idx = rotation_maps[i];
+                *out_map_idx = k_frame_sync_cqpsk_rotation_maps[i];
             }
             return 1;
         }
@@ -665,18 +922,19 @@ frame_sync_accept_p25p2(frame_sync_match_ctx* ctx, int synctype, int inverted, c
 
 #ifdef USE_RADIO
 static int
-frame_sync_try_rotated_p25(frame_sync_match_ctx* ctx, const char* symbols, const char* pattern, int pattern_len,
-                           int synctype, int inverted, const char* label, int phase2, int set_last_before_info) {
+frame_sync_try_rotated_p25(frame_sync_match_ctx* ctx, int first_rotated, int pattern_len, int synctype, int inverted,
+                           const char* label, int phase2, int set_last_before_info) {
     const dsd_opts* opts = ctx->opts;
     const dsd_state* state = ctx->state;
     uint8_t map_idx = DSD_P25_CQPSK_DIBIT_MAP_IDENTITY;
     if (!frame_sync_cqpsk_4level_enabled(opts, state)
-        || !frame_sync_find_rotated_p25_cqpsk_map(symbols, pattern, &map_idx)) {
+        || !frame_sync_find_rotated_p25_cqpsk_map(ctx, first_rotated, &map_idx)) {
         return DSD_SYNC_NONE;
     }
 
     frame_sync_p25_cqpsk_raw_fit_t fit = {0.0f, 0.0f};
-    dsd_warm_start_result_t center_result = frame_sync_fit_p25_cqpsk_raw_sync(ctx, symbols, pattern_len, &fit);
+    dsd_warm_start_result_t center_result =
+        frame_sync_fit_p25_cqpsk_raw_sync(ctx, frame_sync_match_text(ctx, pattern_len), pattern_len, &fit);
     if (frame_sync_p25_cqpsk_map_requires_center_fit(map_idx) && center_result != DSD_WARM_START_OK) {
         return DSD_SYNC_NONE;
     }
@@ -701,13 +959,13 @@ frame_sync_try_p25p1(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (strcmp(ctx->synctest, P25P1_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_P25P1)) {
         frame_sync_set_p25_cqpsk_dibit_map(ctx, DSD_P25_CQPSK_DIBIT_MAP_IDENTITY);
         frame_sync_accept_p25p1(ctx, DSD_SYNC_P25P1_POS, "+P25p1", FRAME_SYNC_P25_CENTER_AUTO);
         return DSD_SYNC_P25P1_POS;
     }
 
-    if (strcmp(ctx->synctest, INV_P25P1_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_P25P1_INV)) {
         frame_sync_set_p25_cqpsk_dibit_map(ctx, DSD_P25_CQPSK_DIBIT_MAP_IDENTITY);
         frame_sync_accept_p25p1(ctx, DSD_SYNC_P25P1_NEG, "-P25p1 ", FRAME_SYNC_P25_CENTER_AUTO);
         return DSD_SYNC_P25P1_NEG;
@@ -715,11 +973,11 @@ frame_sync_try_p25p1(frame_sync_match_ctx* ctx) {
 
 #ifdef USE_RADIO
     int sync_type =
-        frame_sync_try_rotated_p25(ctx, ctx->synctest, P25P1_SYNC, 24, DSD_SYNC_P25P1_POS, 0, "+P25p1", 0, 0);
+        frame_sync_try_rotated_p25(ctx, FRAME_SYNC_PAT_P25P1_ROT, 24, DSD_SYNC_P25P1_POS, 0, "+P25p1", 0, 0);
     if (sync_type != DSD_SYNC_NONE) {
         return sync_type;
     }
-    return frame_sync_try_rotated_p25(ctx, ctx->synctest, INV_P25P1_SYNC, 24, DSD_SYNC_P25P1_NEG, 0, "-P25p1 ", 0, 0);
+    return frame_sync_try_rotated_p25(ctx, FRAME_SYNC_PAT_P25P1_INV_ROT, 24, DSD_SYNC_P25P1_NEG, 0, "-P25p1 ", 0, 0);
 #else
     return DSD_SYNC_NONE;
 #endif
@@ -750,14 +1008,14 @@ frame_sync_try_x2tdma(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if ((strcmp(ctx->synctest, X2TDMA_BS_DATA_SYNC) == 0) || (strcmp(ctx->synctest, X2TDMA_MS_DATA_SYNC) == 0)) {
+    if (frame_sync_match_either(ctx, FRAME_SYNC_PAT_X2TDMA_BS_DATA, FRAME_SYNC_PAT_X2TDMA_MS_DATA)) {
         if (opts->inverted_x2tdma == 0) {
             return frame_sync_accept_x2tdma(ctx, DSD_SYNC_X2TDMA_DATA_POS, "+X2-TDMA ", 0);
         }
         return frame_sync_accept_x2tdma(ctx, DSD_SYNC_X2TDMA_VOICE_NEG, "-X2-TDMA ", 1);
     }
 
-    if ((strcmp(ctx->synctest, X2TDMA_BS_VOICE_SYNC) == 0) || (strcmp(ctx->synctest, X2TDMA_MS_VOICE_SYNC) == 0)) {
+    if (frame_sync_match_either(ctx, FRAME_SYNC_PAT_X2TDMA_BS_VOICE, FRAME_SYNC_PAT_X2TDMA_MS_VOICE)) {
         if (opts->inverted_x2tdma == 0) {
             return frame_sync_accept_x2tdma(ctx, DSD_SYNC_X2TDMA_VOICE_POS, "+X2-TDMA ", 1);
         }
@@ -776,7 +1034,7 @@ frame_sync_try_ysf(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (strcmp(ctx->synctest20, FUSION_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_YSF)) {
         printFrameSync(opts, state, "+YSF ", ctx->synctest_pos + 1, ctx->modulation);
         frame_sync_set_basic_lock(ctx);
         opts->inverted_ysf = 0;
@@ -785,7 +1043,7 @@ frame_sync_try_ysf(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_YSF_POS;
     }
 
-    if (strcmp(ctx->synctest20, INV_FUSION_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_YSF_INV)) {
         printFrameSync(opts, state, "-YSF ", ctx->synctest_pos + 1, ctx->modulation);
         frame_sync_set_basic_lock(ctx);
         opts->inverted_ysf = 1;
@@ -804,13 +1062,13 @@ frame_sync_try_p25p2(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (strcmp(ctx->synctest20, P25P2_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_P25P2)) {
         frame_sync_set_p25_cqpsk_dibit_map(ctx, DSD_P25_CQPSK_DIBIT_MAP_IDENTITY);
         frame_sync_accept_p25p2(ctx, DSD_SYNC_P25P2_POS, 0, "+P25p2", 1, FRAME_SYNC_P25_CENTER_AUTO);
         return DSD_SYNC_P25P2_POS;
     }
 
-    if (strcmp(ctx->synctest20, INV_P25P2_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_P25P2_INV)) {
         frame_sync_set_p25_cqpsk_dibit_map(ctx, DSD_P25_CQPSK_DIBIT_MAP_IDENTITY);
         frame_sync_accept_p25p2(ctx, DSD_SYNC_P25P2_NEG, 1, "-P25p2", 0, FRAME_SYNC_P25_CENTER_AUTO);
         return DSD_SYNC_P25P2_NEG;
@@ -818,11 +1076,11 @@ frame_sync_try_p25p2(frame_sync_match_ctx* ctx) {
 
 #ifdef USE_RADIO
     int sync_type =
-        frame_sync_try_rotated_p25(ctx, ctx->synctest20, P25P2_SYNC, 20, DSD_SYNC_P25P2_POS, 0, "+P25p2", 1, 1);
+        frame_sync_try_rotated_p25(ctx, FRAME_SYNC_PAT_P25P2_ROT, 20, DSD_SYNC_P25P2_POS, 0, "+P25p2", 1, 1);
     if (sync_type != DSD_SYNC_NONE) {
         return sync_type;
     }
-    return frame_sync_try_rotated_p25(ctx, ctx->synctest20, INV_P25P2_SYNC, 20, DSD_SYNC_P25P2_NEG, 1, "-P25p2", 1, 0);
+    return frame_sync_try_rotated_p25(ctx, FRAME_SYNC_PAT_P25P2_INV_ROT, 20, DSD_SYNC_P25P2_NEG, 1, "-P25p2", 1, 0);
 #else
     return DSD_SYNC_NONE;
 #endif
@@ -837,7 +1095,7 @@ frame_sync_try_dpmr(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (opts->inverted_dpmr == 0 && strcmp(ctx->synctest12, DPMR_FRAME_SYNC_2) == 0) {
+    if (opts->inverted_dpmr == 0 && frame_sync_match_is(ctx, FRAME_SYNC_PAT_DPMR_FS2)) {
         frame_sync_set_basic_lock(ctx);
         DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "dPMR ");
         if (opts->errorbars == 1) {
@@ -848,7 +1106,7 @@ frame_sync_try_dpmr(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_DPMR_FS2_POS;
     }
 
-    if (opts->inverted_dpmr == 1 && strcmp(ctx->synctest12, INV_DPMR_FRAME_SYNC_2) == 0) {
+    if (opts->inverted_dpmr == 1 && frame_sync_match_is(ctx, FRAME_SYNC_PAT_DPMR_FS2_INV)) {
         frame_sync_set_basic_lock(ctx);
         DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "dPMR ");
         if (opts->errorbars == 1) {
@@ -876,10 +1134,10 @@ frame_sync_try_m17_preamble(frame_sync_match_ctx* ctx, int ham_pre, int ham_piv)
     const int require_repeated_marker = opts->frame_dstar == 1;
     const int repeated_pre = !require_repeated_marker
                              || (frame_sync_match_window_ready(ctx, 16)
-                                 && dsd_sync_hamming_distance(ctx->synctest16, M17_PRE, 8) <= max_hamming);
+                                 && frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_PRE_REPEAT) <= max_hamming);
     const int repeated_piv = !require_repeated_marker
                              || (frame_sync_match_window_ready(ctx, 16)
-                                 && dsd_sync_hamming_distance(ctx->synctest16, M17_PIV, 8) <= max_hamming);
+                                 && frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_PIV_REPEAT) <= max_hamming);
 
     if (ham_pre <= max_hamming && repeated_pre) {
         state->m17_polarity = 1;
@@ -1066,14 +1324,14 @@ frame_sync_try_m17(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    int ham_pre = dsd_sync_hamming_distance(ctx->synctest8, M17_PRE, 8);
-    int ham_piv = dsd_sync_hamming_distance(ctx->synctest8, M17_PIV, 8);
-    int ham_lsf = dsd_sync_hamming_distance(ctx->synctest8, M17_LSF, 8);
-    int ham_str = dsd_sync_hamming_distance(ctx->synctest8, M17_STR, 8);
-    int ham_pkt = dsd_sync_hamming_distance(ctx->synctest8, M17_PKT, 8);
-    int ham_brt = dsd_sync_hamming_distance(ctx->synctest8, M17_BRT, 8);
-    int ham_eot = dsd_sync_hamming_distance(ctx->synctest8, M17_EOT, 8);
-    int ham_eot_inv = dsd_sync_hamming_distance(ctx->synctest8, M17_EOT_INV, 8);
+    int ham_pre = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_PRE);
+    int ham_piv = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_PIV);
+    int ham_lsf = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_LSF);
+    int ham_str = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_STR);
+    int ham_pkt = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_PKT);
+    int ham_brt = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_BRT);
+    int ham_eot = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_EOT);
+    int ham_eot_inv = frame_sync_match_ham(ctx, FRAME_SYNC_PAT_M17_EOT_INV);
     int is_inverted = opts->inverted_m17;
     if (!opts->inverted_m17 && state->m17_polarity == 2) {
         is_inverted = 1;
@@ -1109,7 +1367,7 @@ static int
 frame_sync_try_dmr_ms_data(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_MS_DATA_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_MS_DATA)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1130,7 +1388,7 @@ static int
 frame_sync_try_dmr_ms_voice(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_MS_VOICE_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_MS_VOICE)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1151,7 +1409,7 @@ static int
 frame_sync_try_dmr_bs_data(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_BS_DATA_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_BS_DATA)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1181,7 +1439,7 @@ static int
 frame_sync_try_dmr_dm_ts1_data(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_DIRECT_MODE_TS1_DATA_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_DM_TS1_DATA)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1208,7 +1466,7 @@ static int
 frame_sync_try_dmr_dm_ts2_data(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_DIRECT_MODE_TS2_DATA_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_DM_TS2_DATA)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1235,7 +1493,7 @@ static int
 frame_sync_try_dmr_bs_voice(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_BS_VOICE_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_BS_VOICE)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1265,7 +1523,7 @@ static int
 frame_sync_try_dmr_dm_ts1_voice(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_DIRECT_MODE_TS1_VOICE_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_DM_TS1_VOICE)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1291,7 +1549,7 @@ static int
 frame_sync_try_dmr_dm_ts2_voice(frame_sync_match_ctx* ctx) {
     dsd_opts* opts = ctx->opts;
     dsd_state* state = ctx->state;
-    if (strcmp(ctx->synctest, DMR_DIRECT_MODE_TS2_VOICE_SYNC) != 0) {
+    if (!frame_sync_match_is(ctx, FRAME_SYNC_PAT_DMR_DM_TS2_VOICE)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1321,8 +1579,8 @@ frame_sync_try_dmr_rc_data(frame_sync_match_ctx* ctx) {
     /* The RC sync has no voice/data complement partner: its symbol-wise
      * complement is the ETSI-reserved pattern, so it maps to RC only when the
      * input polarity is inverted and is never claimed at normal polarity. */
-    const char* pattern = (opts->inverted_dmr == 0) ? DMR_MS_RC_SYNC : DMR_MS_RC_SYNC_INV;
-    if (strcmp(ctx->synctest, pattern) != 0) {
+    const int pattern = (opts->inverted_dmr == 0) ? FRAME_SYNC_PAT_DMR_MS_RC : FRAME_SYNC_PAT_DMR_MS_RC_INV;
+    if (!frame_sync_match_is(ctx, pattern)) {
         return DSD_SYNC_NONE;
     }
 
@@ -1375,11 +1633,6 @@ frame_sync_try_dmr(frame_sync_match_ctx* ctx) {
     return frame_sync_try_dmr_rc_data(ctx);
 }
 
-static int
-frame_sync_symbols_match_either(const char* symbols, const char* pattern_a, const char* pattern_b) {
-    return strcmp(symbols, pattern_a) == 0 || strcmp(symbols, pattern_b) == 0;
-}
-
 static int
 frame_sync_accept_provoice(frame_sync_match_ctx* ctx, int synctype, const char* label, int always_print) {
     const dsd_opts* opts = ctx->opts;
@@ -1425,22 +1678,22 @@ frame_sync_try_provoice(frame_sync_match_ctx* ctx) {
     }
 
     if (frame_sync_match_window_ready(ctx, 32)) {
-        if (frame_sync_symbols_match_either(ctx->synctest32, PROVOICE_SYNC, PROVOICE_EA_SYNC)) {
+        if (frame_sync_match_either(ctx, FRAME_SYNC_PAT_PROVOICE, FRAME_SYNC_PAT_PROVOICE_EA)) {
             return frame_sync_accept_provoice(ctx, DSD_SYNC_PROVOICE_POS, "+PV   ", 0);
         }
-        if (frame_sync_symbols_match_either(ctx->synctest32, INV_PROVOICE_SYNC, INV_PROVOICE_EA_SYNC)) {
+        if (frame_sync_match_either(ctx, FRAME_SYNC_PAT_PROVOICE_INV, FRAME_SYNC_PAT_PROVOICE_EA_INV)) {
             return frame_sync_accept_provoice(ctx, DSD_SYNC_PROVOICE_NEG, "-PV   ", 1);
         }
     }
 
     if (frame_sync_match_window_ready(ctx, 48)) {
-        if (strcmp(ctx->synctest48, EDACS_SYNC) == 0) {
+        if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_EDACS)) {
             return frame_sync_accept_edacs(ctx, DSD_SYNC_EDACS_NEG, "-EDACS");
         }
-        if (strcmp(ctx->synctest48, INV_EDACS_SYNC) == 0) {
+        if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_EDACS_INV)) {
             return frame_sync_accept_edacs(ctx, DSD_SYNC_EDACS_POS, "+EDACS");
         }
-        if (frame_sync_symbols_match_either(ctx->synctest48, DOTTING_SEQUENCE_A, DOTTING_SEQUENCE_B)) {
+        if (frame_sync_match_either(ctx, FRAME_SYNC_PAT_DOTTING_A, FRAME_SYNC_PAT_DOTTING_B)) {
             frame_sync_handle_edacs_dotting(ctx);
         }
     }
@@ -1457,7 +1710,7 @@ frame_sync_try_dstar(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (strcmp(ctx->synctest, DSTAR_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_DSTAR)) {
         frame_sync_set_basic_lock(ctx);
         DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "DSTAR ");
         if (opts->errorbars == 1) {
@@ -1468,7 +1721,7 @@ frame_sync_try_dstar(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_DSTAR_VOICE_POS;
     }
 
-    if (strcmp(ctx->synctest, INV_DSTAR_SYNC) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_DSTAR_INV)) {
         frame_sync_set_basic_lock(ctx);
         DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "DSTAR ");
         if (opts->errorbars == 1) {
@@ -1479,7 +1732,7 @@ frame_sync_try_dstar(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_DSTAR_VOICE_NEG;
     }
 
-    if (strcmp(ctx->synctest, DSTAR_HD) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_DSTAR_HD)) {
         frame_sync_set_basic_lock(ctx);
         DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "DSTAR_HD ");
         if (opts->errorbars == 1) {
@@ -1490,7 +1743,7 @@ frame_sync_try_dstar(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_DSTAR_HD_POS;
     }
 
-    if (strcmp(ctx->synctest, INV_DSTAR_HD) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_DSTAR_HD_INV)) {
         frame_sync_set_basic_lock(ctx);
         DSD_SNPRINTF(state->ftype, sizeof(state->ftype), " DSTAR_HD");
         if (opts->errorbars == 1) {
@@ -1505,16 +1758,12 @@ frame_sync_try_dstar(frame_sync_match_ctx* ctx) {
 }
 
 static int
-frame_sync_nxdn_sync_type(const char* symbols) {
-    static const char* const positive_patterns[] = {"3131331131", "3331331131", "3131331111", "3331331111",
-                                                    "3131311131"};
-    static const char* const negative_patterns[] = {"1313113313", "1113113313", "1313113333", "1113113333",
-                                                    "1313133313"};
-    for (size_t i = 0; i < sizeof(positive_patterns) / sizeof(positive_patterns[0]); i++) {
-        if (strcmp(symbols, positive_patterns[i]) == 0) {
+frame_sync_nxdn_sync_type(const frame_sync_match_ctx* ctx) {
+    for (int i = 0; i < FRAME_SYNC_NXDN_VARIANTS; i++) {
+        if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_NXDN_POS + i)) {
             return DSD_SYNC_NXDN_POS;
         }
-        if (strcmp(symbols, negative_patterns[i]) == 0) {
+        if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_NXDN_NEG + i)) {
             return DSD_SYNC_NXDN_NEG;
         }
     }
@@ -1538,7 +1787,7 @@ frame_sync_try_nxdn(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    const int synctype = frame_sync_nxdn_sync_type(ctx->synctest10);
+    const int synctype = frame_sync_nxdn_sync_type(ctx);
     if (synctype == DSD_SYNC_NONE) {
         return DSD_SYNC_NONE;
     }
@@ -1558,15 +1807,16 @@ frame_sync_try_nxdn(frame_sync_match_ctx* ctx) {
 #ifdef PVCONVENTIONAL
 static void
 frame_sync_pvconv_decode_addrs(const frame_sync_match_ctx* ctx, char one_symbol, uint8_t* tx_addr, uint8_t* rx_addr) {
+    const char* symbols16 = frame_sync_match_text(ctx, 16);
     *tx_addr = 0;
     *rx_addr = 0;
     for (int bit = 0; bit < 8; bit++) {
         *tx_addr = (uint8_t)(*tx_addr << 1);
         *rx_addr = (uint8_t)(*rx_addr << 1);
-        if (ctx->synctest16[bit] == one_symbol) {
+        if (symbols16[bit] == one_symbol) {
             *tx_addr = (uint8_t)(*tx_addr + 1);
         }
-        if (ctx->synctest16[8 + bit] == one_symbol) {
+        if (symbols16[8 + bit] == one_symbol) {
             *rx_addr = (uint8_t)(*rx_addr + 1);
         }
     }
@@ -1581,7 +1831,7 @@ frame_sync_try_provoice_conventional(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (strncmp(ctx->synctest32, INV_PROVOICE_CONV_SHORT, 16) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_PROVOICE_CONV_INV)) {
         if (state->lastsynctype == DSD_SYNC_PROVOICE_NEG) {
             frame_sync_set_basic_lock(ctx);
             DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "ProVoice ");
@@ -1602,7 +1852,7 @@ frame_sync_try_provoice_conventional(frame_sync_match_ctx* ctx) {
         return DSD_SYNC_NONE;
     }
 
-    if (strncmp(ctx->synctest32, PROVOICE_CONV_SHORT, 16) == 0) {
+    if (frame_sync_match_is(ctx, FRAME_SYNC_PAT_PROVOICE_CONV)) {
         if (state->lastsynctype == DSD_SYNC_PROVOICE_POS) {
             frame_sync_set_basic_lock(ctx);
             DSD_SNPRINTF(state->ftype, sizeof(state->ftype), "ProVoice ");
@@ -2211,22 +2461,12 @@ typedef struct {
     int lidx;
     int level_count;
     int t_max;
-    int history_head;
-    int history_count;
     unsigned int ready_windows;
     float symbol;
     float lmin;
     float lmax;
-    char synctest[25];
-    char synctest12[13];
-    char synctest10[11];
-    char synctest32[33];
-    char synctest20[21];
-    char synctest48[49];
-    char synctest8[9];
-    char synctest16[17];
     char modulation[8];
-    char symbol_history[FRAME_SYNC_HISTORY_CAPACITY];
+    frame_sync_windows win;
     float lbuf[48];
     float lbuf2[48];
 } frame_sync_runtime_ctx;
@@ -2240,72 +2480,13 @@ frame_sync_runtime_init(frame_sync_runtime_ctx* rt, const dsd_opts* opts, const
     }
     rt->lmin = state->min;
     rt->lmax = state->max;
-    rt->synctest[24] = 0;
-    rt->synctest12[12] = 0;
-    rt->synctest10[10] = 0;
-    rt->synctest32[32] = 0;
-    rt->synctest20[20] = 0;
-    rt->synctest48[48] = 0;
-    rt->synctest8[8] = 0;
-    rt->synctest16[16] = 0;
     rt->modulation[7] = 0;
+    rt->win.patterns = frame_sync_patterns();
 }
 
 static void
 frame_sync_history_push(frame_sync_runtime_ctx* rt, char symbol) {
-    rt->symbol_history[rt->history_head] = symbol;
-    rt->history_head = (rt->history_head + 1) % FRAME_SYNC_HISTORY_CAPACITY;
-    if (rt->history_count < FRAME_SYNC_HISTORY_CAPACITY) {
-        rt->history_count++;
-    }
-}
-
-static int
-frame_sync_history_materialize(const frame_sync_runtime_ctx* rt, int length, char* out, size_t out_size) {
-    if (!rt || !out || length <= 0 || length > FRAME_SYNC_HISTORY_CAPACITY || out_size <= (size_t)length
-        || rt->history_count < length) {
-        return 0;
-    }
-
-    int index = rt->history_head - length;
-    if (index < 0) {
-        index += FRAME_SYNC_HISTORY_CAPACITY;
-    }
-    for (int i = 0; i < length; i++) {
-        out[i] = rt->symbol_history[index];
-        index = (index + 1) % FRAME_SYNC_HISTORY_CAPACITY;
-    }
-    out[length] = '\0';
-    return 1;
-}
-
-static void
-frame_sync_materialize_ready_windows(frame_sync_runtime_ctx* rt) {
-    rt->ready_windows = 0;
-    if (frame_sync_history_materialize(rt, 8, rt->synctest8, sizeof(rt->synctest8))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_8;
-    }
-    if (frame_sync_history_materialize(rt, 10, rt->synctest10, sizeof(rt->synctest10))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_10;
-    }
-    if (frame_sync_history_materialize(rt, 12, rt->synctest12, sizeof(rt->synctest12))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_12;
-    }
-    if (frame_sync_history_materialize(rt, 16, rt->synctest16, sizeof(rt->synctest16))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_16;
-    }
-    if (frame_sync_history_materialize(rt, 20, rt->synctest20, sizeof(rt->synctest20))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_20;
-    }
-    if (frame_sync_history_materialize(rt, 24, rt->synctest, sizeof(rt->synctest))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_24;
-    }
-    if (frame_sync_history_materialize(rt, 32, rt->synctest32, sizeof(rt->synctest32))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_32;
-    }
-    if (frame_sync_history_materialize(rt, 48, rt->synctest48, sizeof(rt->synctest48))) {
-        rt->ready_windows |= FRAME_SYNC_WINDOW_48;
-    }
+    frame_sync_windows_push(&rt->win, symbol);
 }
 
 static int
@@ -2423,19 +2604,8 @@ frame_sync_update_c4fm_hamming(const dsd_opts* opts, const dsd_state* state, con
         || (rt->ready_windows & FRAME_SYNC_WINDOW_24) == 0) {
         return;
     }
-    int ham_norm = 0;
-    int ham_inv = 0;
-    for (int k = 0; k < 24; k++) {
-        int d = (unsigned char)rt->synctest[k] - '0';
-        int expect_n = P25P1_SYNC[k] - '0';
-        int expect_i = INV_P25P1_SYNC[k] - '0';
-        if (d != expect_n) {
-            ham_norm++;
-        }
-        if (d != expect_i) {
-            ham_inv++;
-        }
-    }
+    int ham_norm = frame_sync_windows_ham(&rt->win, FRAME_SYNC_PAT_P25P1);
+    int ham_inv = frame_sync_windows_ham(&rt->win, FRAME_SYNC_PAT_P25P1_INV);
     int c4fm_ham = (ham_norm < ham_inv) ? ham_norm : ham_inv;
     int ham_c4fm_cur = atomic_load(&g_ham_c4fm_recent);
     if (c4fm_ham < ham_c4fm_cur) {
@@ -2453,12 +2623,14 @@ frame_sync_update_qpsk_hamming(const dsd_opts* opts, const dsd_state* state, con
     int compared = 0;
     if (state->sps_hunt_idx == DSD_FRAME_SYNC_SPS_PROFILE_4800_4 && opts->frame_p25p1 == 1
         && (rt->ready_windows & FRAME_SYNC_WINDOW_24) != 0) {
-        best_qpsk_ham = dsd_qpsk_sync_hamming_with_remaps(rt->synctest, P25P1_SYNC, INV_P25P1_SYNC, 24);
+        best_qpsk_ham = frame_sync_corr_qpsk_hamming(&rt->win.corr, &rt->win.patterns[FRAME_SYNC_PAT_P25P1],
+                                                     &rt->win.patterns[FRAME_SYNC_PAT_P25P1_INV]);
         compared = 1;
     }
     if (state->sps_hunt_idx == DSD_FRAME_SYNC_SPS_PROFILE_6000_4 && opts->frame_p25p2 == 1
         && (rt->ready_windows & FRAME_SYNC_WINDOW_20) != 0) {
-        int ham_p2 = dsd_qpsk_sync_hamming_with_remaps(rt->synctest20, P25P2_SYNC, INV_P25P2_SYNC, 20);
+        int ham_p2 = frame_sync_corr_qpsk_hamming(&rt->win.corr, &rt->win.patterns[FRAME_SYNC_PAT_P25P2],
+                                                  &rt->win.patterns[FRAME_SYNC_PAT_P25P2_INV]);
         int ham_p2_scaled = (ham_p2 * 24 + 19) / 20;
         if (ham_p2_scaled < best_qpsk_ham || !compared) {
             best_qpsk_ham = ham_p2_scaled;
@@ -2507,8 +2679,9 @@ frame_sync_dmr_gfsk_ham(const dsd_opts* opts, const dsd_state* state, const fram
         || (rt->ready_windows & FRAME_SYNC_WINDOW_24) == 0) {
         return 24;
     }
-    const char* dmr_patterns[] = {DMR_BS_DATA_SYNC, DMR_BS_VOICE_SYNC, DMR_MS_DATA_SYNC, DMR_MS_VOICE_SYNC};
-    return frame_sync_best_ham_for_patterns(rt->synctest, dmr_patterns, 4, 24, 24);
+    static const int dmr_patterns[] = {FRAME_SYNC_PAT_DMR_BS_DATA, FRAME_SYNC_PAT_DMR_BS_VOICE,
+                                       FRAME_SYNC_PAT_DMR_MS_DATA, FRAME_SYNC_PAT_DMR_MS_VOICE};
+    return frame_sync_windows_best_ham(&rt->win, dmr_patterns, 4, 24);
 }
 
 static int
@@ -2517,8 +2690,23 @@ frame_sync_dpmr_gfsk_ham(const dsd_opts* opts, const dsd_state* state, const fra
         || (rt->ready_windows & FRAME_SYNC_WINDOW_24) == 0) {
         return 24;
     }
-    const char* dpmr_patterns[] = {DPMR_FRAME_SYNC_1, DPMR_FRAME_SYNC_4, INV_DPMR_FRAME_SYNC_1, INV_DPMR_FRAME_SYNC_4};
-    return frame_sync_best_ham_for_patterns(rt->synctest, dpmr_patterns, 4, 24, 24);
+    static const int dpmr_patterns[] = {FRAME_SYNC_PAT_DPMR_FS1, FRAME_SYNC_PAT_DPMR_FS4, FRAME_SYNC_PAT_DPMR_FS1_INV,
+                                        FRAME_SYNC_PAT_DPMR_FS4_INV};
+    return frame_sync_windows_best_ham(&rt->win, dpmr_patterns, 4, 24);
+}
+
+/* frame_sync_best_nxdn_scaled_ham() on the packed window: base NXDN sync in either polarity. */
+static int
+frame_sync_nxdn_corr_scaled_ham(const frame_sync_windows* win) {
+    static const int nxdn_patterns[] = {FRAME_SYNC_PAT_NXDN_POS, FRAME_SYNC_PAT_NXDN_NEG};
+    int best = 24;
+    for (int p = 0; p < 2; p++) {
+        int scaled_ham = (frame_sync_windows_ham(win, nxdn_patterns[p]) * 24 + 9) / 10;
+        if (scaled_ham < best) {
+            best = scaled_ham;
+        }
+    }
+    return best;
 }
 
 static int
@@ -2527,10 +2715,10 @@ frame_sync_nxdn_gfsk_ham(const dsd_opts* opts, const dsd_state* state, const fra
         return 24;
     }
     if (state->sps_hunt_idx == DSD_FRAME_SYNC_SPS_PROFILE_4800_4 && opts->frame_nxdn96 == 1) {
-        return frame_sync_best_nxdn_scaled_ham(rt->synctest10, 24);
+        return frame_sync_nxdn_corr_scaled_ham(&rt->win);
     }
     if (state->sps_hunt_idx == DSD_FRAME_SYNC_SPS_PROFILE_2400_4 && opts->frame_nxdn48 == 1) {
-        return frame_sync_best_nxdn_scaled_ham(rt->synctest10, 24);
+        return frame_sync_nxdn_corr_scaled_ham(&rt->win);
     }
     return 24;
 }
@@ -2558,14 +2746,15 @@ frame_sync_update_gfsk_hamming(const dsd_opts* opts, const dsd_state* state, con
 
 #ifdef USE_RADIO
 static void
-frame_sync_debug_sync_dmr(dsd_opts* opts, dsd_state* state, const frame_sync_runtime_ctx* rt) {
-    DSD_FPRINTF(stderr, "[SYNC] pattern=%s expect=%s\n", rt->synctest, P25P1_SYNC);
+frame_sync_debug_sync_dmr(dsd_opts* opts, dsd_state* state, frame_sync_runtime_ctx* rt) {
+    const char* window = frame_sync_windows_text(&rt->win, 24);
+    DSD_FPRINTF(stderr, "[SYNC] pattern=%s expect=%s\n", window, P25P1_SYNC);
     if (opts->frame_dmr != 1) {
         return;
     }
 
     const char* best_name = NULL;
-    int best_ham = dmr_best_sync_hamming(rt->synctest, &best_name);
+    int best_ham = dmr_best_sync_hamming(window, &best_name);
     int rtl_sym_rate = 0;
     int rtl_levels = 0;
     (void)dsd_rtl_stream_metrics_hook_symbol_profile(&rtl_sym_rate, &rtl_levels, NULL);
@@ -2575,15 +2764,16 @@ frame_sync_debug_sync_dmr(dsd_opts* opts, dsd_state* state, const frame_sync_run
                 "rtl_profile=%d/%d pwr=%.1fdB sql=%.1fdB snr_gfsk=%.1fdB win=%.*s\n",
                 best_name ? best_name : "none", best_ham, state->rf_mod, opts->mod_cli_lock, opts->mod_c4fm,
                 opts->mod_qpsk, opts->mod_gfsk, rtl_sym_rate, rtl_levels, pwr_to_dB(opts->rtl_pwr),
-                pwr_to_dB(opts->rtl_squelch_level), snr_gfsk, 24, rt->synctest);
+                pwr_to_dB(opts->rtl_squelch_level), snr_gfsk, 24, window);
 }
 
 static void
-frame_sync_debug_sync_cqpsk(const frame_sync_runtime_ctx* rt) {
+frame_sync_debug_sync_cqpsk(frame_sync_runtime_ctx* rt) {
+    const char* window = frame_sync_windows_text(&rt->win, 24);
     static const int d_rot_map[4] = {1, 3, 0, 2};
     int ham_norm = 0, ham_inv = 0, ham_ident = 0, ham_invert = 0, ham_swap = 0, ham_xor3 = 0, ham_rot = 0;
     for (int k = 0; k < 24; k++) {
-        int d = (unsigned char)rt->synctest[k];
+        int d = (unsigned char)window[k];
         if (d >= '0' && d <= '3') {
             d -= '0';
         }
@@ -2604,13 +2794,13 @@ frame_sync_debug_sync_cqpsk(const frame_sync_runtime_ctx* rt) {
     static int dbg_win = 0;
     if ((++dbg_win % 1200) == 0) {
         DSD_FPRINTF(stderr, "[SYNCDBG] ham(norm=%d inv=%d ident=%d inv2=%d swap=%d xor3=%d rot=%d) win=%.*s\n",
-                    ham_norm, ham_inv, ham_ident, ham_invert, ham_swap, ham_xor3, ham_rot, 24, rt->synctest);
+                    ham_norm, ham_inv, ham_ident, ham_invert, ham_swap, ham_xor3, ham_rot, 24, window);
     }
 }
 #endif
 
 static void
-frame_sync_debug_sync_window(dsd_opts* opts, dsd_state* state, const frame_sync_runtime_ctx* rt) {
+frame_sync_debug_sync_window(dsd_opts* opts, dsd_state* state, frame_sync_runtime_ctx* rt) {
 #ifdef USE_RADIO
     static int debug_count = 0;
     const dsdneoRuntimeConfig* cfg_dbg = dsd_neo_get_config();
@@ -2641,7 +2831,7 @@ frame_sync_eval_window(dsd_opts* opts, dsd_state* state, frame_sync_runtime_ctx*
     if (rt->level_count > 0) {
         frame_sync_window_levels(opts, state, rt);
     }
-    frame_sync_materialize_ready_windows(rt);
+    rt->ready_windows = frame_sync_windows_ready(&rt->win);
     if (frame_sync_should_skip_snr_or_power_gate(opts, state)) {
         return DSD_SYNC_NONE;
     }
@@ -2663,14 +2853,7 @@ frame_sync_eval_window(dsd_opts* opts, dsd_state* state, frame_sync_runtime_ctx*
         .lmin = rt->lmin,
         .ready_windows = rt->ready_windows,
         .modulation = rt->modulation,
-        .synctest = rt->synctest,
-        .synctest8 = rt->synctest8,
-        .synctest10 = rt->synctest10,
-        .synctest12 = rt->synctest12,
-        .synctest16 = rt->synctest16,
-        .synctest20 = rt->synctest20,
-        .synctest32 = rt->synctest32,
-        .synctest48 = rt->synctest48,
+        .win = &rt->win,
     };
     return frame_sync_try_protocol_matches(&match_ctx);
 }
@@ -2690,7 +2873,12 @@ dsd_frame_sync_test_history_window(const char* symbols, int symbol_count, int wi
     for (int i = 0; i < symbol_count; i++) {
         frame_sync_history_push(&rt, symbols[i]);
     }
-    return frame_sync_history_materialize(&rt, window_length, out, (size_t)out_size);
+    const char* window = frame_sync_windows_text(&rt.win, window_length);
+    if (!window || out_size <= window_length) {
+        return 0;
+    }
+    DSD_MEMCPY(out, window, (size_t)window_length + 1U);
+    return 1;
 }
 
 int
@@ -2703,7 +2891,7 @@ dsd_frame_sync_test_try_protocol_matches(dsd_opts* opts, dsd_state* state, const
     for (int i = 0; i < symbol_count; i++) {
         frame_sync_history_push(&rt, symbols[i]);
     }
-    frame_sync_materialize_ready_windows(&rt);
+    rt.ready_windows = frame_sync_windows_ready(&rt.win);
     frame_sync_match_ctx match_ctx = {
         .opts = opts,
         .state = state,
@@ -2714,14 +2902,7 @@ dsd_frame_sync_test_try_protocol_matches(dsd_opts* opts, dsd_state* state, const
         .lmin = state->min,
         .ready_windows = rt.ready_windows,
         .modulation = rt.modulation,
-        .synctest = rt.synctest,
-        .synctest8 = rt.synctest8,
-        .synctest10 = rt.synctest10,
-        .synctest12 = rt.synctest12,
-        .synctest16 = rt.synctest16,
-        .synctest20 = rt.synctest20,
-        .synctest32 = rt.synctest32,
-        .synctest48 = rt.synctest48,
+        .win = &rt.win,
     };
     return frame_sync_try_protocol_matches(&match_ctx);
 }
@@ -2975,6 +3156,108 @@ frame_sync_no_sync_sps_hunt(const dsd_opts* opts, dsd_state* state) {
     frame_sync_apply_sps_hunt_profile(opts, state, next_idx, preserve_modulation);
 }
 
+static int
+frame_sync_race_append(const char* out[], int count, const char* const patterns[], int pattern_count) {
+    for (int p = 0; p < pattern_count && count < FRAME_SYNC_RACE_MAX_PATTERNS; p++) {
+        out[count++] = patterns[p];
+    }
+    return count;
+}
+
+/*
+ * Outer-symbol syncs long enough to race on that repeat within a transmission, so a lane can confirm its first
+ * match on the next frame. M17, dPMR and NXDN are left to the dwell: their long syncs (dPMR FS1/FS4, the NXDN
+ * preamble plus FSW) open or close a transmission only once, and the ones that repeat are too short.
+ */
+static int
+frame_sync_race_profile_patterns(const dsd_opts* opts, int profile_index, const char* out[]) {
+    static const char* const p25p1[] = {P25P1_SYNC, INV_P25P1_SYNC};
+    static const char* const dmr[] = {DMR_BS_DATA_SYNC, DMR_BS_VOICE_SYNC, DMR_MS_DATA_SYNC, DMR_MS_VOICE_SYNC};
+    static const char* const ysf[] = {FUSION_SYNC, INV_FUSION_SYNC};
+    static const char* const provoice[] = {PROVOICE_SYNC, INV_PROVOICE_SYNC, PROVOICE_EA_SYNC, INV_PROVOICE_EA_SYNC};
+    static const char* const p25p2[] = {P25P2_SYNC, INV_P25P2_SYNC};
+    static const char* const x2tdma[] = {X2TDMA_BS_VOICE_SYNC, X2TDMA_BS_DATA_SYNC, X2TDMA_MS_DATA_SYNC,
+                                         X2TDMA_MS_VOICE_SYNC};
+    static const char* const dstar[] = {DSTAR_SYNC, INV_DSTAR_SYNC, DSTAR_HD, INV_DSTAR_HD};
+    int n = 0;
+    switch (profile_index) {
+        case DSD_FRAME_SYNC_SPS_PROFILE_4800_4:
+            n = (opts->frame_p25p1 == 1) ? frame_sync_race_append(out, n, p25p1, 2) : n;
+            n = (opts->frame_dmr == 1) ? frame_sync_race_append(out, n, dmr, 4) : n;
+            n = (opts->frame_ysf == 1) ? frame_sync_race_append(out, n, ysf, 2) : n;
+            break;
+        case DSD_FRAME_SYNC_SPS_PROFILE_9600_2:
+            n = (opts->frame_provoice == 1) ? frame_sync_race_append(out, n, provoice, 4) : n;
+            break;
+        case DSD_FRAME_SYNC_SPS_PROFILE_6000_4:
+            n = (opts->frame_p25p2 == 1) ? frame_sync_race_append(out, n, p25p2, 2) : n;
+            n = (opts->frame_x2tdma == 1) ? frame_sync_race_append(out, n, x2tdma, 4) : n;
+            break;
+        case DSD_FRAME_SYNC_SPS_PROFILE_4800_2:
+            n = (opts->frame_dstar == 1) ? frame_sync_race_append(out, n, dstar, 4) : n;
+            break;
+        default: break;
+    }
+    return n;
+}
+
+static int
+frame_sync_race_allowed(const dsd_opts* opts) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg || !cfg->sync_race_enable) {
+        return 0;
+    }
+    /* A modulation lock pins the hunt to equal-timing profiles; symbol replays carry no raw samples. */
+    return !opts->mod_cli_lock && opts->audio_in_type != AUDIO_IN_SYMBOL_BIN
+           && opts->audio_in_type != AUDIO_IN_SYMBOL_FLT;
+}
+
+/* Give every other enabled profile a lane at its own timing; the active profile is the main slicer's job. */
+static void
+frame_sync_race_arm(const dsd_opts* opts, dsd_state* state) {
+    frame_sync_race_set_armed(state, 0);
+    if (!frame_sync_race_allowed(opts)) {
+        return;
+    }
+    frame_sync_race* race = frame_sync_race_for_state(state);
+    if (!race) {
+        return;
+    }
+    frame_sync_race_reset(race);
+    const int demod_rate = frame_sync_current_demod_rate(opts, state);
+    for (int profile_index = 0; profile_index < DSD_FRAME_SYNC_SPS_PROFILE_COUNT; profile_index++) {
+        if (profile_index == state->sps_hunt_idx || !frame_sync_sps_profile_has_candidate(opts, profile_index)) {
+            continue;
+        }
+        const char* patterns[FRAME_SYNC_RACE_MAX_PATTERNS];
+        const int pattern_count = frame_sync_race_profile_patterns(opts, profile_index, patterns);
+        const int sym_rate = frame_sync_sps_profile_for_index(profile_index)->symbol_rate_hz;
+        const int sps = dsd_opts_compute_sps_rate(opts, sym_rate, demod_rate);
+        (void)frame_sync_race_add_lane(race, profile_index, sps, patterns, pattern_count);
+    }
+    frame_sync_race_set_armed(state, race->lane_count > 0);
+}
+
+/* Commit to the first raced profile that confirmed a sync, skipping the rest of the round-robin dwell. */
+static void
+frame_sync_race_maybe_commit(const dsd_opts* opts, dsd_state* state) {
+    const frame_sync_race* race = frame_sync_race_peek(state);
+    if (!race || race->winner < 0) {
+        return;
+    }
+    const int winner = race->winner;
+    if (state->carrier == 0) {
+        if (opts->verbose > 1 && !dsd_frame_sync_suppress_tcp_no_signal_console(opts, state)) {
+            const frame_sync_sps_profile* profile = frame_sync_sps_profile_for_index(winner);
+            DSD_FPRINTF(stderr, "Sync race: %d sym/s %d-level profile matched; switching\n", profile->symbol_rate_hz,
+                        profile->levels);
+        }
+        frame_sync_apply_sps_hunt_profile(opts, state, winner, 0);
+        state->sps_hunt_counter = 0;
+    }
+    frame_sync_race_arm(opts, state);
+}
+
 double
 frame_sync_elapsed_seconds(double nowm, time_t now, double mono_stamp, time_t wall_stamp) {
     if (mono_stamp > 0.0) {
@@ -3095,17 +3378,14 @@ frame_sync_maybe_dump_unsynced_dmr(const dsd_opts* opts, const dsd_state* state)
     }
 }
 
-int
-getFrameSync(dsd_opts* opts, dsd_state* state) {
-    if (!opts || !state) {
-        return -1;
-    }
-
+static int
+frame_sync_hunt(dsd_opts* opts, dsd_state* state) {
     const time_t now = time(NULL);
     const double nowm = dsd_time_now_monotonic_s();
     frame_sync_maybe_tick_p25_trunk_sm(opts, state, now);
     frame_sync_apply_cli_mod_lock(opts, state);
     frame_sync_ensure_enabled_sps_profile(opts, state);
+    frame_sync_race_arm(opts, state);
 
     frame_sync_runtime_ctx rt;
     frame_sync_runtime_init(&rt, opts, state);
@@ -3121,12 +3401,13 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
         }
 
         rt.symbol = getSymbol(opts, state, 0);
+        frame_sync_race_maybe_commit(opts, state);
         frame_sync_update_symbol_ring(opts, state, rt.symbol, rt.lbuf, &rt.lidx, &rt.level_count, rt.t_max);
         frame_sync_maybe_auto_switch_modulation(opts, state, rt.t_max, &rt.lastt);
         rt.dibit = frame_sync_process_dibit_and_payload(opts, state, rt.symbol);
         frame_sync_history_push(&rt, (char)('0' + (rt.dibit & 0x3)));
 
-        if (rt.history_count >= 8) {
+        if (rt.win.corr.count >= 8) {
             int sync_type = frame_sync_eval_window(opts, state, &rt, now, nowm);
             if (sync_type != DSD_SYNC_NONE) {
                 g_unsynced_dmr_dump_symbols = 0;
@@ -3146,3 +3427,13 @@ getFrameSync(dsd_opts* opts, dsd_state* state) {
         }
     }
 }
+
+int
+getFrameSync(dsd_opts* opts, dsd_state* state) {
+    if (!opts || !state) {
+        return -1;
+    }
+    const int sync_type = frame_sync_hunt(opts, state);
+    frame_sync_race_set_armed(state, 0);
+    return sync_type;
+}
@@ -52,6 +52,7 @@
 #include "dsd-neo/core/safe_api.h"
 #include "dsd-neo/core/state_fwd.h"
 #include "dsd-neo/platform/sockets.h"
+#include "frame_sync_race.h"
 #include "pcm_input_staging.h"
 
 #ifdef USE_RADIO
@@ -95,6 +96,7 @@ float_to_int16_clip(float v) {
     return (short)lrintf(v);
 }
 
+/* Only the raw capture is written here; it stays on the decoder thread even with DSD_NEO_WAV_ASYNC. */
 static inline void
 symbol_write_wav_short_block(SNDFILE* file, const short* samples, sf_count_t sample_count, const char* context) {
     if (file == NULL || samples == NULL || sample_count <= 0) {
@@ -239,6 +241,14 @@ clamp_symbol_center_to_margin(int* center, int samples_per_symbol) {
 
 #endif
 
+/* Matched filter for the active protocol; NULL passes samples through. */
+typedef float (*symbol_filter_fn)(float sample, int samples_per_symbol);
+
+/*
+ * Work context for one getSymbolBlock() call. The accumulators at the top are
+ * reset per symbol; everything else is set up once and carried across the
+ * block's symbols.
+ */
 typedef struct {
     float sample;
     float sum;
@@ -246,8 +256,14 @@ typedef struct {
     int symbol_span;
     int l_edge_pre;
     int r_edge_pre;
+    int freeze_window;
     unsigned int analog_out_cap;
+    symbol_filter_fn filter;
+    int filter_sps;      /* samplesPerSymbol the filter was selected for */
+    int filter_synctype; /* lastsynctype it was selected for */
+    int filter_flags;    /* symbol-rate bypass flags it was selected for, -1 before the first pick */
 #ifdef USE_RADIO
+    int dsp_cqpsk_timing; /* CQPSK symbol timing runs in the DSP; sampled once per block */
     int rtl_output_kind;
     int rtl_direct_output;
     int rtl_symbol_rate_output;
@@ -261,13 +277,20 @@ typedef struct {
 #endif
 } symbol_work_ctx;
 
+typedef struct {
+    int have_sync;
+    symbol_work_ctx work;
+} symbol_block_ctx;
+
 static inline void
-symbol_work_ctx_init(symbol_work_ctx* work, const dsd_state* state) {
+symbol_work_ctx_init(symbol_work_ctx* work, const dsd_state* state, int freeze_window) {
     if (!work) {
         return;
     }
     *work = (symbol_work_ctx){0};
     work->symbol_span = 1;
+    work->filter_flags = -1;
+    work->freeze_window = freeze_window;
 #ifdef USE_RADIO
     work->rtl_symbol_levels = 4;
 #endif
@@ -277,6 +300,21 @@ symbol_work_ctx_init(symbol_work_ctx* work, const dsd_state* state) {
     work->analog_out_cap = (unsigned int)(sizeof(state->analog_out) / sizeof(state->analog_out[0]));
 }
 
+/* Clear the per-symbol fields once a symbol is done. */
+static inline void
+symbol_work_ctx_end_symbol(symbol_work_ctx* work) {
+    work->sample = 0.0f;
+    work->sum = 0.0f;
+    work->count = 0;
+    work->symbol_span = 1;
+    work->l_edge_pre = 0;
+    work->r_edge_pre = 0;
+#ifdef USE_RADIO
+    work->rtl_profile_changed = 0;
+    work->cqpsk_symbol_rate = 0;
+#endif
+}
+
 static inline int
 symbol_timing_debug_enabled(const dsd_opts* opts, const dsd_state* state, int have_sync) {
     return opts->symboltiming == 1 && have_sync == 0 && state->lastsynctype != DSD_SYNC_NONE;
@@ -298,42 +336,62 @@ symbol_is_m17_sync(int lastsynctype) {
            || lastsynctype == DSD_SYNC_M17_EOT_POS || lastsynctype == DSD_SYNC_M17_EOT_NEG;
 }
 
-static inline float
-symbol_apply_matched_filter(const dsd_opts* opts, const dsd_state* state, float sample, int rtl_symbol_rate_output,
-                            int cqpsk_symbol_rate) {
+static inline symbol_filter_fn
+symbol_select_matched_filter(const dsd_opts* opts, const dsd_state* state, int rtl_symbol_rate_output,
+                             int cqpsk_symbol_rate) {
     if (!opts->use_cosine_filter || rtl_symbol_rate_output || cqpsk_symbol_rate) {
-        return sample;
+        return NULL;
     }
     if (DSD_SYNC_IS_DMR_BS(state->lastsynctype) || DSD_SYNC_IS_DMR_MS(state->lastsynctype)
         || DSD_SYNC_IS_YSF(state->lastsynctype)) {
-        return dmr_filter(sample, state->samplesPerSymbol);
+        return dmr_filter;
     }
     if (symbol_is_m17_sync(state->lastsynctype)) {
-        return m17_filter(sample, state->samplesPerSymbol);
+        return m17_filter;
     }
     if (DSD_SYNC_IS_P25P1(state->lastsynctype)) {
-        return p25_filter(sample, state->samplesPerSymbol);
+        return p25_filter;
     }
     if (DSD_SYNC_IS_DPMR(state->lastsynctype)) {
-        if (opts->frame_dpmr == 1) {
-            return dpmr_filter(sample, state->samplesPerSymbol);
-        }
-        return sample;
+        return (opts->frame_dpmr == 1) ? dpmr_filter : NULL;
     }
     if (DSD_SYNC_IS_NXDN(state->lastsynctype)) {
         const dsd_nxdn_variant variant = dsd_frame_sync_active_nxdn_variant(opts, state);
         if (variant == DSD_NXDN_VARIANT_48) {
-            return nxdn_filter(sample, state->samplesPerSymbol);
-        }
-        if (variant != DSD_NXDN_VARIANT_96) {
-            return sample;
+            return nxdn_filter;
         }
-        if (state->samplesPerSymbol == 8) {
-            return sample;
+        if (variant != DSD_NXDN_VARIANT_96 || state->samplesPerSymbol == 8) {
+            return NULL;
         }
-        return dmr_filter(sample, state->samplesPerSymbol);
+        return dmr_filter;
     }
-    return sample;
+    return NULL;
+}
+
+static inline float
+symbol_apply_matched_filter(const dsd_opts* opts, const dsd_state* state, float sample, int rtl_symbol_rate_output,
+                            int cqpsk_symbol_rate) {
+    symbol_filter_fn filter = symbol_select_matched_filter(opts, state, rtl_symbol_rate_output, cqpsk_symbol_rate);
+    return filter ? filter(sample, state->samplesPerSymbol) : sample;
+}
+
+/*
+ * The filter choice depends on the sync type and on the bypass flags and SPS,
+ * which an RTL profile refresh can change between samples. The choice is kept
+ * for the whole block and re-selected only when one of those moved.
+ */
+static inline float
+symbol_apply_cached_matched_filter(const dsd_opts* opts, const dsd_state* state, symbol_work_ctx* work, float sample,
+                                   int rtl_symbol_rate_output, int cqpsk_symbol_rate) {
+    const int flags = (rtl_symbol_rate_output ? 1 : 0) | (cqpsk_symbol_rate ? 2 : 0);
+    if (flags != work->filter_flags || state->samplesPerSymbol != work->filter_sps
+        || state->lastsynctype != work->filter_synctype) {
+        work->filter = symbol_select_matched_filter(opts, state, rtl_symbol_rate_output, cqpsk_symbol_rate);
+        work->filter_flags = flags;
+        work->filter_sps = state->samplesPerSymbol;
+        work->filter_synctype = state->lastsynctype;
+    }
+    return work->filter ? work->filter(sample, state->samplesPerSymbol) : sample;
 }
 
 #ifdef DSD_NEO_TEST_HOOKS
@@ -569,9 +627,7 @@ dsd_symbol_test_is_m17_sync(int lastsynctype) {
  *  - Only for C4FM path (rf_mod == 0) to avoid QPSK perturbations
  */
 static inline int
-maybe_auto_center_allowed(const dsd_opts* opts, const dsd_state* state, int have_sync) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    int freeze_window = (cfg && cfg->window_freeze_is_set) ? (cfg->window_freeze != 0) : 0;
+maybe_auto_center_allowed(const dsd_opts* opts, const dsd_state* state, int have_sync, int freeze_window) {
     if (freeze_window) {
         return 0; // explicit freeze requested
     }
@@ -610,8 +666,8 @@ maybe_auto_center_step_direction(int e_ema, int deadband, int* run_dir, int* run
 }
 
 static inline void
-maybe_auto_center(const dsd_opts* opts, dsd_state* state, int have_sync) {
-    if (!maybe_auto_center_allowed(opts, state, have_sync)) {
+maybe_auto_center(const dsd_opts* opts, dsd_state* state, int have_sync, int freeze_window) {
+    if (!maybe_auto_center_allowed(opts, state, have_sync, freeze_window)) {
         return;
     }
     /* Cooldown to avoid rapid flips */
@@ -1281,13 +1337,11 @@ symbol_refresh_rtl_profile(dsd_state* state, symbol_work_ctx* work) {
         (work->rtl_direct_output && rtl_symbol_rate_output_active(work->rtl_output_kind)) ? 1 : 0;
     work->rtl_fsk_discriminator_output =
         (work->rtl_direct_output && rtl_fsk_discriminator_output_active(work->rtl_output_kind)) ? 1 : 0;
-    if (work->rtl_direct_output) {
-        work->rtl_profile_changed |=
-            rtl_symbol_cache_profile(state, work->rtl_output_kind, work->rtl_channel_profile, work->rtl_symbol_rate_hz,
-                                     work->rtl_symbol_levels, work->rtl_stream_generation);
-    } else {
-        rtl_symbol_cache_clear(state);
-    }
+    /* Audio output shares the cache too; its profile is all-zero, so a switch
+     * into or out of a direct mode still drops the samples of the old kind. */
+    work->rtl_profile_changed |=
+        rtl_symbol_cache_profile(state, work->rtl_output_kind, work->rtl_channel_profile, work->rtl_symbol_rate_hz,
+                                 work->rtl_symbol_levels, work->rtl_stream_generation);
     return work->rtl_direct_output;
 }
 
@@ -1401,6 +1455,10 @@ symbol_read_cached_rtl_sample(dsd_opts* opts, dsd_state* state, float* sample_ou
         }
         symbol_refresh_rtl_profile(state, work);
         if (!work->rtl_fsk_discriminator_output) {
+            /* Audio output has no timing to re-derive; just pull from the new stream. */
+            if (!work->rtl_direct_output) {
+                continue;
+            }
             return 0;
         }
         if (work->rtl_profile_changed || state->samplesPerSymbol <= 1) {
@@ -1415,16 +1473,9 @@ symbol_read_sample_rtl(dsd_opts* opts, dsd_state* state, float* sample_out, symb
         dsd_request_shutdown(opts, state);
         return 0;
     }
-    if (work->rtl_fsk_discriminator_output) {
-        if (!symbol_read_cached_rtl_sample(opts, state, sample_out, work)) {
-            return 0;
-        }
-        opts->rtl_pwr = dsd_rtl_stream_io_hook_return_pwr(state);
-        return 1;
-    }
-    int got = 0;
-    if (dsd_rtl_stream_io_hook_read(state, sample_out, 1, &got) < 0 || got != 1) {
-        dsd_request_shutdown(opts, state);
+    /* Every RTL output kind goes through the span cache: one ring read fills it
+     * and later calls pop from the local cursor. */
+    if (!symbol_read_cached_rtl_sample(opts, state, sample_out, work)) {
         return 0;
     }
     opts->rtl_pwr = dsd_rtl_stream_io_hook_return_pwr(state);
@@ -1572,11 +1623,22 @@ symbol_take_sample(dsd_opts* opts, dsd_state* state, symbol_work_ctx* work) {
 }
 
 #ifdef USE_RADIO
+/*
+ * Read the RTL output profile and the DSP CQPSK status once per block. A
+ * profile change inside the block surfaces as a cache retry on the next
+ * sample read, which refreshes the profile there.
+ */
 static inline void
 symbol_init_rtl_profile(const dsd_opts* opts, dsd_state* state, symbol_work_ctx* work) {
-    (void)opts;
-    if (opts->audio_in_type == AUDIO_IN_RTL) {
-        (void)symbol_refresh_rtl_profile(state, work);
+    if (opts->audio_in_type != AUDIO_IN_RTL) {
+        return;
+    }
+    (void)symbol_refresh_rtl_profile(state, work);
+    if (!work->rtl_direct_output) {
+        int dsp_cqpsk = 0;
+        int dsp_timing = 0;
+        dsd_rtl_stream_metrics_hook_cqpsk_status(&dsp_cqpsk, &dsp_timing);
+        work->dsp_cqpsk_timing = (dsp_cqpsk && dsp_timing) ? 1 : 0;
     }
 }
 
@@ -1629,7 +1691,7 @@ symbol_prepare_span(const dsd_opts* opts, dsd_state* state, symbol_work_ctx* wor
     if (work->rtl_fsk_discriminator_output) {
         symbol_apply_rtl_fsk_discriminator_timing(opts, state, work);
     } else if (!work->rtl_symbol_rate_output) {
-        maybe_auto_center(opts, state, have_sync);
+        maybe_auto_center(opts, state, have_sync, work->freeze_window);
         maybe_adjust_sps_for_output_rate(opts, state);
     } else {
         state->samplesPerSymbol = 1;
@@ -1638,14 +1700,12 @@ symbol_prepare_span(const dsd_opts* opts, dsd_state* state, symbol_work_ctx* wor
         apply_rtl_symbol_thresholds(state, work->rtl_symbol_levels);
     }
 
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    int freeze_window = (cfg && cfg->window_freeze_is_set) ? (cfg->window_freeze != 0) : 0;
     if (state->rf_mod == 0) {
-        select_window_c4fm(state, &work->l_edge_pre, &work->r_edge_pre, freeze_window);
+        select_window_c4fm(state, &work->l_edge_pre, &work->r_edge_pre, work->freeze_window);
     } else if (state->rf_mod == 1) {
-        select_window_qpsk(&work->l_edge_pre, &work->r_edge_pre, freeze_window);
+        select_window_qpsk(&work->l_edge_pre, &work->r_edge_pre, work->freeze_window);
     } else {
-        select_window_gfsk(&work->l_edge_pre, &work->r_edge_pre, freeze_window);
+        select_window_gfsk(&work->l_edge_pre, &work->r_edge_pre, work->freeze_window);
     }
 
     work->symbol_span = state->samplesPerSymbol;
@@ -1655,14 +1715,10 @@ symbol_prepare_span(const dsd_opts* opts, dsd_state* state, symbol_work_ctx* wor
     if (work->rtl_symbol_rate_output) {
         work->symbol_span = 1;
     }
-    if (!work->rtl_direct_output && opts->audio_in_type == AUDIO_IN_RTL && state->rf_mod == 1) {
-        int dsp_cqpsk = 0;
-        int dsp_timing = 0;
-        dsd_rtl_stream_metrics_hook_cqpsk_status(&dsp_cqpsk, &dsp_timing);
-        if (dsp_cqpsk && dsp_timing) {
-            work->cqpsk_symbol_rate = 1;
-            work->symbol_span = 1;
-        }
+    if (!work->rtl_direct_output && opts->audio_in_type == AUDIO_IN_RTL && state->rf_mod == 1
+        && work->dsp_cqpsk_timing) {
+        work->cqpsk_symbol_rate = 1;
+        work->symbol_span = 1;
     }
     if (work->symbol_span <= 1) {
         state->jitter = -1;
@@ -1781,8 +1837,11 @@ symbol_process_live_samples(dsd_opts* opts, dsd_state* state, int have_sync, sym
         int rtl_symbol_rate_output = 0;
         int cqpsk_symbol_rate = 0;
 #endif
-        work->sample =
-            symbol_apply_matched_filter(opts, state, work->sample, rtl_symbol_rate_output, cqpsk_symbol_rate);
+        if (!have_sync && !rtl_symbol_rate_output && !cqpsk_symbol_rate) {
+            frame_sync_race_tap(state, work->sample);
+        }
+        work->sample = symbol_apply_cached_matched_filter(opts, state, work, work->sample, rtl_symbol_rate_output,
+                                                          cqpsk_symbol_rate);
         work->sample = symbol_apply_sync_clip(state, have_sync, work->sample);
         symbol_update_jitter(opts, state, have_sync, i, work->sample);
         symbol_accumulate_sample(state, work, i, work->sample);
@@ -1806,14 +1865,12 @@ symbol_finalize_live_symbol(const dsd_opts* opts, dsd_state* state, int have_syn
 #ifndef USE_RADIO
 static inline void
 symbol_prepare_span_no_radio(dsd_state* state, symbol_work_ctx* work) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    int freeze_window = (cfg && cfg->window_freeze_is_set) ? (cfg->window_freeze != 0) : 0;
     if (state->rf_mod == 0) {
-        select_window_c4fm(state, &work->l_edge_pre, &work->r_edge_pre, freeze_window);
+        select_window_c4fm(state, &work->l_edge_pre, &work->r_edge_pre, work->freeze_window);
     } else if (state->rf_mod == 1) {
-        select_window_qpsk(&work->l_edge_pre, &work->r_edge_pre, freeze_window);
+        select_window_qpsk(&work->l_edge_pre, &work->r_edge_pre, work->freeze_window);
     } else {
-        select_window_gfsk(&work->l_edge_pre, &work->r_edge_pre, freeze_window);
+        select_window_gfsk(&work->l_edge_pre, &work->r_edge_pre, work->freeze_window);
     }
     work->symbol_span = state->samplesPerSymbol;
     if (work->symbol_span < 1) {
@@ -1850,31 +1907,76 @@ symbol_commit_symbol(dsd_opts* opts, dsd_state* state, int have_sync, const symb
     return symbol;
 }
 
-float
-getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
-    symbol_work_ctx work;
-    symbol_work_ctx_init(&work, state);
+static inline void
+symbol_block_begin(const dsd_opts* opts, dsd_state* state, symbol_block_ctx* blk, int have_sync) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    blk->have_sync = have_sync;
+    symbol_work_ctx_init(&blk->work, state, (cfg && cfg->window_freeze_is_set) ? (cfg->window_freeze != 0) : 0);
+#ifdef USE_RADIO
+    symbol_init_rtl_profile(opts, state, &blk->work);
+#else
+    (void)opts;
+#endif
+}
 
+/*
+ * Timing (auto-center, jitter, SPS) still runs per symbol: it reads the slicer
+ * thresholds that the dibit layer updates between symbols.
+ */
+static float
+symbol_block_produce(dsd_opts* opts, dsd_state* state, int have_sync, symbol_work_ctx* work) {
 #ifdef USE_RADIO
-    symbol_init_rtl_profile(opts, state, &work);
-    int fast_status = symbol_try_rtl_symbol_rate_fast_path(opts, state, &work);
+    int fast_status = symbol_try_rtl_symbol_rate_fast_path(opts, state, work);
     if (fast_status < 0) {
         return 0.0f;
     }
     if (fast_status > 0) {
-        return work.sample;
+        return work->sample;
     }
-    symbol_prepare_span(opts, state, &work, have_sync);
+    symbol_prepare_span(opts, state, work, have_sync);
 #else
-    symbol_prepare_span_no_radio(state, &work);
+    symbol_prepare_span_no_radio(state, work);
 #endif
 
-    if (!symbol_process_live_samples(opts, state, have_sync, &work)) {
+    if (!symbol_process_live_samples(opts, state, have_sync, work)) {
         return 0.0f;
     }
 
-    float symbol = symbol_finalize_live_symbol(opts, state, have_sync, &work);
+    float symbol = symbol_finalize_live_symbol(opts, state, have_sync, work);
 
     symbol_apply_replay_overrides(opts, state, &symbol);
-    return symbol_commit_symbol(opts, state, have_sync, &work, symbol);
+    return symbol_commit_symbol(opts, state, have_sync, work, symbol);
+}
+
+static inline float
+symbol_block_next(dsd_opts* opts, dsd_state* state, symbol_block_ctx* blk) {
+    const float symbol = symbol_block_produce(opts, state, blk->have_sync, &blk->work);
+    symbol_work_ctx_end_symbol(&blk->work);
+    return symbol;
+}
+
+float
+getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
+    symbol_block_ctx blk;
+    symbol_block_begin(opts, state, &blk, have_sync);
+    return symbol_block_next(opts, state, &blk);
+}
+
+void
+getSymbolBlock(dsd_opts* opts, dsd_state* state, int have_sync, float* out, int count, dsd_symbol_sink_fn sink,
+               void* user) {
+    if (!opts || !state || count <= 0) {
+        return;
+    }
+    symbol_block_ctx blk;
+    symbol_block_begin(opts, state, &blk, have_sync);
+    for (int k = 0; k < count; k++) {
+        const float symbol = symbol_block_next(opts, state, &blk);
+        if (out) {
+            out[k] = symbol;
+        }
+        if (sink) {
+            sink(opts, state, symbol, user);
+        }
+    }
 }
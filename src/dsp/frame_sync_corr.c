@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include "frame_sync_corr.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+
+void
+frame_sync_corr_reset(frame_sync_corr* corr) {
+    if (corr) {
+        DSD_MEMSET(corr, 0, sizeof(*corr));
+    }
+}
+
+int
+frame_sync_corr_pattern_init(frame_sync_corr_pattern* pattern, const char* text, int window_len,
+                             const uint8_t dibit_map[4]) {
+    if (!pattern || !text || window_len <= 0 || window_len > FRAME_SYNC_CORR_CAPACITY) {
+        return -1;
+    }
+    DSD_MEMSET(pattern, 0, sizeof(*pattern));
+    const size_t text_len = strlen(text);
+    if (text_len == 0U || text_len > (size_t)window_len) {
+        return -1;
+    }
+    for (size_t i = 0; i < text_len; i++) {
+        const unsigned int d = (unsigned int)((unsigned char)text[i] - '0');
+        if (d > 3U) {
+            return -1;
+        }
+        const uint64_t stored = dibit_map ? (uint64_t)(dibit_map[d] & 0x3U) : (uint64_t)d;
+        const int back = window_len - 1 - (int)i;
+        const int word = back / 32;
+        const int shift = 2 * (back % 32);
+        pattern->sym[word] |= stored << shift;
+        pattern->care[word] |= 1ULL << shift;
+    }
+    pattern->window_len = window_len;
+    return 0;
+}
+
+static int
+frame_sync_corr_remap_hamming(uint64_t sym0, uint64_t sym1, const frame_sync_corr* corr,
+                              const frame_sync_corr_pattern* pattern) {
+    return dsd_popcount64(frame_sync_corr_diff_slots(sym0, corr->bad[0], pattern->sym[0], pattern->care[0]))
+           + dsd_popcount64(frame_sync_corr_diff_slots(sym1, corr->bad[1], pattern->sym[1], pattern->care[1]));
+}
+
+int
+frame_sync_corr_qpsk_hamming(const frame_sync_corr* corr, const frame_sync_corr_pattern* norm,
+                             const frame_sync_corr_pattern* inv) {
+    enum { REMAPS = 5 };
+    const uint64_t lsb = FRAME_SYNC_CORR_SLOT_LSB;
+    uint64_t remapped[REMAPS][2];
+    for (int w = 0; w < 2; w++) {
+        const uint64_t s = corr->sym[w];
+        remapped[0][w] = s;
+        remapped[1][w] = s ^ (lsb << 1);                       /* invert: 0<->2, 1<->3 */
+        remapped[2][w] = ((s & lsb) << 1) | ((s >> 1) & lsb);  /* swap bit order */
+        remapped[3][w] = ~s;                                   /* xor 3 */
+        remapped[4][w] = ((s & lsb) << 1) | ((~s >> 1) & lsb); /* rotate 0->1->3->2->0 */
+    }
+
+    int best = frame_sync_corr_remap_hamming(remapped[0][0], remapped[0][1], corr, norm);
+    for (int r = 0; r < REMAPS; r++) {
+        int ham = frame_sync_corr_remap_hamming(remapped[r][0], remapped[r][1], corr, norm);
+        if (ham < best) {
+            best = ham;
+        }
+        ham = frame_sync_corr_remap_hamming(remapped[r][0], remapped[r][1], corr, inv);
+        if (ham < best) {
+            best = ham;
+        }
+    }
+    return best;
+}
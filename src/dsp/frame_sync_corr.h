@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Packed dibit correlator for the frame-sync hunt.
+ *
+ * The newest 48 dibits live in two 64-bit shift registers, two bits per
+ * symbol: word 0 holds the newest 32 with the newest in bits 1:0, and the low
+ * half of word 1 holds the 16 before those. A sync pattern is packed to the
+ * same layout for the window length it is tested against, so the dibit
+ * Hamming distance of any window is an XOR, a fold of each slot's two bits
+ * onto its low bit, and a popcount. Exact matches are distance zero.
+ *
+ * Symbols outside '0'..'3' are remembered in a parallel mask and count as a
+ * mismatch against every pattern, which is what strcmp() and the character
+ * loops in the frame-sync matchers did with them.
+ */
+
+#ifndef DSD_NEO_SRC_DSP_FRAME_SYNC_CORR_H_
+#define DSD_NEO_SRC_DSP_FRAME_SYNC_CORR_H_
+
+#include <dsd-neo/platform/posix_compat.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    FRAME_SYNC_CORR_CAPACITY = 48,
+};
+
+/* Low bit of every dibit slot. */
+#define FRAME_SYNC_CORR_SLOT_LSB 0x5555555555555555ULL
+
+typedef struct {
+    uint64_t sym[2];
+    uint64_t bad[2]; /* slot low bit set when that symbol was not '0'..'3' */
+    int count;       /* symbols held, saturating at FRAME_SYNC_CORR_CAPACITY */
+} frame_sync_corr;
+
+typedef struct {
+    uint64_t sym[2];
+    uint64_t care[2]; /* slot low bit set for every compared position */
+    int window_len;
+} frame_sync_corr_pattern;
+
+static inline void
+frame_sync_corr_push(frame_sync_corr* corr, char symbol) {
+    const unsigned int d = (unsigned int)((unsigned char)symbol - '0');
+    const uint64_t valid = (d <= 3U) ? 1U : 0U;
+    corr->sym[1] = ((corr->sym[1] << 2) | (corr->sym[0] >> 62)) & 0xFFFFFFFFULL;
+    corr->sym[0] = (corr->sym[0] << 2) | (valid ? (uint64_t)d : 0U);
+    corr->bad[1] = ((corr->bad[1] << 2) | (corr->bad[0] >> 62)) & 0xFFFFFFFFULL;
+    corr->bad[0] = (corr->bad[0] << 2) | (valid ^ 1U);
+    if (corr->count < FRAME_SYNC_CORR_CAPACITY) {
+        corr->count++;
+    }
+}
+
+static inline int
+frame_sync_corr_ready(const frame_sync_corr* corr, int window_len) {
+    return window_len > 0 && corr->count >= window_len;
+}
+
+/* Mismatched-dibit mask for one word: any differing bit in a slot, or a bad symbol. */
+static inline uint64_t
+frame_sync_corr_diff_slots(uint64_t sym, uint64_t bad, uint64_t pattern, uint64_t care) {
+    const uint64_t x = sym ^ pattern;
+    return ((x | (x >> 1)) | bad) & care;
+}
+
+/* Dibit Hamming distance between the newest window and `pattern`. */
+static inline int
+frame_sync_corr_hamming(const frame_sync_corr* corr, const frame_sync_corr_pattern* pattern) {
+    return dsd_popcount64(frame_sync_corr_diff_slots(corr->sym[0], corr->bad[0], pattern->sym[0], pattern->care[0]))
+           + dsd_popcount64(frame_sync_corr_diff_slots(corr->sym[1], corr->bad[1], pattern->sym[1], pattern->care[1]));
+}
+
+/* Whether the window is full and every compared dibit equals the pattern. */
+static inline int
+frame_sync_corr_match(const frame_sync_corr* corr, const frame_sync_corr_pattern* pattern) {
+    return frame_sync_corr_ready(corr, pattern->window_len)
+           && (frame_sync_corr_diff_slots(corr->sym[0], corr->bad[0], pattern->sym[0], pattern->care[0])
+               | frame_sync_corr_diff_slots(corr->sym[1], corr->bad[1], pattern->sym[1], pattern->care[1]))
+                  == 0U;
+}
+
+void frame_sync_corr_reset(frame_sync_corr* corr);
+
+/*
+ * Pack ASCII '0'..'3' `text` for a window of `window_len` dibits. A shorter
+ * text is compared against the oldest strlen(text) dibits of the window only
+ * (strncmp semantics). `dibit_map`, when non-NULL, replaces each expected
+ * dibit d with dibit_map[d], so one pass can test a remapped constellation.
+ * Returns 0 on success, -1 for a bad length or character.
+ */
+int frame_sync_corr_pattern_init(frame_sync_corr_pattern* pattern, const char* text, int window_len,
+                                 const uint8_t dibit_map[4]);
+
+/*
+ * Best CQPSK distance across the slicer remaps of sync_hamming.c (identity,
+ * invert, bit swap, xor 3, 90 degree rotation), each against the normal and
+ * inverted reference. The remaps run on the packed words directly.
+ */
+int frame_sync_corr_qpsk_hamming(const frame_sync_corr* corr, const frame_sync_corr_pattern* norm,
+                                 const frame_sync_corr_pattern* inv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSD_NEO_SRC_DSP_FRAME_SYNC_CORR_H_ */
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include "frame_sync_race.h"
+
+#include <dsd-neo/core/state_ext.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* DC tracker time constant in samples; long against any sync pattern. */
+static const float k_frame_sync_race_dc_alpha = 1.0f / 2048.0f;
+
+void
+frame_sync_race_reset(frame_sync_race* race) {
+    if (!race) {
+        return;
+    }
+    race->armed = 0;
+    race->lane_count = 0;
+    race->winner = -1;
+    race->winner_pattern = -1;
+    race->dc = 0.0f;
+}
+
+static int
+frame_sync_race_pattern_is_outer(const char* text, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (text[i] != '1' && text[i] != '3') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int
+frame_sync_race_add_lane(frame_sync_race* race, int profile, int sps, const char* const patterns[],
+                         int pattern_count) {
+    if (!race || !patterns || race->lane_count >= FRAME_SYNC_RACE_MAX_LANES || sps < 2
+        || sps > FRAME_SYNC_RACE_MAX_SPS) {
+        return -1;
+    }
+    frame_sync_race_lane* lane = &race->lanes[race->lane_count];
+    lane->pattern_count = 0;
+    for (int p = 0; p < pattern_count && lane->pattern_count < FRAME_SYNC_RACE_MAX_PATTERNS; p++) {
+        const char* text = patterns[p];
+        const size_t len = text ? strlen(text) : 0U;
+        if (len < (size_t)FRAME_SYNC_RACE_MIN_PATTERN_LEN || len > (size_t)FRAME_SYNC_CORR_CAPACITY
+            || !frame_sync_race_pattern_is_outer(text, len)) {
+            continue;
+        }
+        if (frame_sync_corr_pattern_init(&lane->patterns[lane->pattern_count], text, (int)len, NULL) == 0) {
+            lane->pattern_count++;
+        }
+    }
+    if (lane->pattern_count == 0) {
+        return -1;
+    }
+    lane->profile = profile;
+    lane->sps = sps;
+    lane->phase = 0;
+    for (int k = 0; k < sps; k++) {
+        frame_sync_corr_reset(&lane->slicers[k]);
+        lane->confirm[k] = 0;
+    }
+    race->lane_count++;
+    return 0;
+}
+
+void
+frame_sync_race_feed(frame_sync_race* race, float sample) {
+    if (!race || race->winner >= 0) {
+        return;
+    }
+    race->dc += (sample - race->dc) * k_frame_sync_race_dc_alpha;
+    const char symbol = (sample > race->dc) ? '1' : '3';
+    for (int l = 0; l < race->lane_count; l++) {
+        frame_sync_race_lane* lane = &race->lanes[l];
+        const int phase = lane->phase;
+        if (++lane->phase >= lane->sps) {
+            lane->phase = 0;
+        }
+        frame_sync_corr* slicer = &lane->slicers[phase];
+        frame_sync_corr_push(slicer, symbol);
+        if (lane->confirm[phase] > 0) {
+            lane->confirm[phase]--;
+        }
+        for (int p = 0; p < lane->pattern_count; p++) {
+            if (!frame_sync_corr_match(slicer, &lane->patterns[p])) {
+                continue;
+            }
+            if (lane->confirm[phase] > 0) {
+                race->winner = lane->profile;
+                race->winner_pattern = p;
+                return;
+            }
+            lane->confirm[phase] = FRAME_SYNC_RACE_CONFIRM_SYMBOLS;
+            break;
+        }
+    }
+}
+
+static void
+frame_sync_race_ext_cleanup(void* ptr) {
+    free(ptr);
+}
+
+frame_sync_race*
+frame_sync_race_peek(const dsd_state* state) {
+    return (frame_sync_race*)dsd_state_ext_get(state, DSD_STATE_EXT_DSP_FRAME_SYNC_RACE);
+}
+
+frame_sync_race*
+frame_sync_race_for_state(dsd_state* state) {
+    if (!state) {
+        return NULL;
+    }
+    frame_sync_race* race = frame_sync_race_peek(state);
+    if (race) {
+        return race;
+    }
+    race = (frame_sync_race*)calloc(1, sizeof(*race));
+    if (!race) {
+        return NULL;
+    }
+    frame_sync_race_reset(race);
+    if (dsd_state_ext_set(state, DSD_STATE_EXT_DSP_FRAME_SYNC_RACE, race, frame_sync_race_ext_cleanup) != 0) {
+        free(race);
+        return NULL;
+    }
+    return race;
+}
+
+void
+frame_sync_race_set_armed(dsd_state* state, int armed) {
+    frame_sync_race* race = frame_sync_race_peek(state);
+    if (race) {
+        race->armed = armed ? 1 : 0;
+    }
+}
+
+void
+frame_sync_race_tap(dsd_state* state, float sample) {
+    frame_sync_race* race = frame_sync_race_peek(state);
+    if (race && race->armed) {
+        frame_sync_race_feed(race, sample);
+    }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Parallel symbol-rate hypotheses for the unsynced frame-sync hunt.
+ *
+ * The SPS hunt only slices at the active profile and only moves on after a
+ * dwell of several no-sync timeouts. A race holds one lane per other enabled
+ * profile. Every lane sees each raw discriminator sample the hunt consumes and
+ * runs one sign slicer per sampling phase at that profile's samples-per-symbol,
+ * so symbol timing does not have to be recovered first. Every frame-sync
+ * pattern is a sequence of outer symbols ('1'/'3'), so a sign decision against
+ * a slow DC estimate is all a lane needs to spot one. A single exact match of
+ * an 18-24 symbol pattern turns up in noise about once a second across all
+ * lanes and phases, so it only opens a confirmation window on its phase; a
+ * second match of one of the lane's patterns on that same phase within
+ * FRAME_SYNC_RACE_CONFIRM_SYMBOLS -- the next frame's sync -- names the
+ * winning profile, and the hunt then switches straight to it.
+ *
+ * The work is interleaved on the decode thread: one slicer push per lane per
+ * sample, and pattern tests only for the phase that just completed a symbol.
+ */
+
+#ifndef DSD_NEO_SRC_DSP_FRAME_SYNC_RACE_H_
+#define DSD_NEO_SRC_DSP_FRAME_SYNC_RACE_H_
+
+#include <dsd-neo/core/state_fwd.h>
+
+#include "frame_sync_corr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    FRAME_SYNC_RACE_MAX_LANES = 5,
+    FRAME_SYNC_RACE_MAX_PATTERNS = 12,
+    FRAME_SYNC_RACE_MAX_SPS = 64,
+    /* Shorter patterns fire on noise too often to justify a profile switch. */
+    FRAME_SYNC_RACE_MIN_PATTERN_LEN = 18,
+    /* Symbols a first match waits for its confirming one: the longest sync repeat raced on, a P25 Phase 2
+       superframe (2160), plus margin. */
+    FRAME_SYNC_RACE_CONFIRM_SYMBOLS = 2400,
+};
+
+typedef struct {
+    int profile;
+    int sps;
+    int phase; /* sampling phase the next sample belongs to */
+    int pattern_count;
+    frame_sync_corr_pattern patterns[FRAME_SYNC_RACE_MAX_PATTERNS];
+    frame_sync_corr slicers[FRAME_SYNC_RACE_MAX_SPS]; /* one per sampling phase */
+    int confirm[FRAME_SYNC_RACE_MAX_SPS];             /* symbols left in each phase's confirmation window */
+} frame_sync_race_lane;
+
+typedef struct {
+    int armed;          /* frame_sync_race_tap() feeds the race */
+    int lane_count;
+    int winner;         /* profile of the first lane to confirm a match, -1 while racing */
+    int winner_pattern; /* index of the confirming pattern within its lane */
+    float dc;           /* slow DC estimate the sign slicers decide against */
+    frame_sync_race_lane lanes[FRAME_SYNC_RACE_MAX_LANES];
+} frame_sync_race;
+
+void frame_sync_race_reset(frame_sync_race* race);
+
+/*
+ * Add a lane for `profile` slicing at `sps` samples per symbol. Patterns that
+ * are shorter than FRAME_SYNC_RACE_MIN_PATTERN_LEN, or that contain anything
+ * but '1' and '3', are skipped. Returns 0 when the lane was added, -1 when it
+ * has no usable pattern, the sps is out of range or the race is full.
+ */
+int frame_sync_race_add_lane(frame_sync_race* race, int profile, int sps, const char* const patterns[],
+                             int pattern_count);
+
+/* Feed one raw sample to every lane. A no-op once a winner is known. */
+void frame_sync_race_feed(frame_sync_race* race, float sample);
+
+/*
+ * Per-state race used by the frame-sync hunt, so every decoder instance races
+ * its own stream. The hunt arms it with fresh lanes on entry and disarms it on
+ * exit; getSymbol() taps its raw samples into it while unsynced. Only the
+ * state's decode thread touches it.
+ *
+ * frame_sync_race_for_state() allocates the race on first use and returns
+ * NULL when that fails; frame_sync_race_peek() never allocates. Arming and
+ * tapping a state without a race are no-ops.
+ */
+frame_sync_race* frame_sync_race_for_state(dsd_state* state);
+frame_sync_race* frame_sync_race_peek(const dsd_state* state);
+void frame_sync_race_set_armed(dsd_state* state, int armed);
+void frame_sync_race_tap(dsd_state* state, float sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSD_NEO_SRC_DSP_FRAME_SYNC_RACE_H_ */
@@ -407,7 +407,7 @@ resamp_process_block(struct demod_state* s, const float* DSD_NEO_RESTRICT in, in
         return -1;
     }
     dsd_resampler_state state = demod_resampler_state_copy_in(s);
-    int out_len = dsd_resampler_process_block(&state, in, in_len, out, MAXIMUM_BUF_LENGTH * 4);
+    int out_len = dsd_resampler_process_block(&state, in, in_len, out, resamp_output_capacity(s, in_len));
     demod_resampler_state_copy_out(s, &state);
     if (out_len >= 0) {
         return out_len;
@@ -417,3 +417,17 @@ resamp_process_block(struct demod_state* s, const float* DSD_NEO_RESTRICT in, in
     }
     return in_len;
 }
+
+int
+resamp_output_capacity(const struct demod_state* s, int in_len) {
+    if (!s || in_len < 0) {
+        return -1;
+    }
+    int L = (s->resamp_L > 0) ? s->resamp_L : 1;
+    int M = (s->resamp_M > 0) ? s->resamp_M : 1;
+    int need = dsd_resampler_required_out_len(in_len, L, M, 0);
+    if (need < 0) {
+        return -1;
+    }
+    return (need > in_len) ? need : in_len;
+}
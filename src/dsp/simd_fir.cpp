@@ -25,6 +25,8 @@ extern "C" int simd_hb_decim2_complex_sse2(const float* in, int in_len, float* o
                                            const float* taps, int taps_len);
 extern "C" int simd_hb_decim2_real_sse2(const float* in, int in_len, float* out, float* hist, const float* taps,
                                         int taps_len);
+extern "C" int simd_fir_interp_real_sse2(const float* in, int in_len, float* out, float* hist,
+                                          const float* phase_taps, int phases, int phase_len);
 #if defined(DSD_NEO_DSP_HAVE_AVX2_IMPL) && DSD_NEO_X86_AVX2_RUNTIME_PROBE_SUPPORTED
 extern "C" void simd_fir_complex_apply_avx2(const float* in, int in_len, float* out, float* hist_i, float* hist_q,
                                             const float* taps, int taps_len);
@@ -32,6 +34,8 @@ extern "C" int simd_hb_decim2_complex_avx2(const float* in, int in_len, float* o
                                            const float* taps, int taps_len);
 extern "C" int simd_hb_decim2_real_avx2(const float* in, int in_len, float* out, float* hist, const float* taps,
                                         int taps_len);
+extern "C" int simd_fir_interp_real_avx2(const float* in, int in_len, float* out, float* hist,
+                                          const float* phase_taps, int phases, int phase_len);
 #endif
 #endif
 
@@ -42,6 +46,8 @@ extern "C" int simd_hb_decim2_complex_neon(const float* in, int in_len, float* o
                                            const float* taps, int taps_len);
 extern "C" int simd_hb_decim2_real_neon(const float* in, int in_len, float* out, float* hist, const float* taps,
                                         int taps_len);
+extern "C" int simd_fir_interp_real_neon(const float* in, int in_len, float* out, float* hist,
+                                          const float* phase_taps, int phases, int phase_len);
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -283,6 +289,46 @@ simd_hb_decim2_real_scalar(const float* in, int in_len, float* out, float* hist,
     return out_len;
 }
 
+/**
+ * Scalar real polyphase interpolator.
+ * Output n * phases + p = sum_j phase_taps[p][j] * x[n - (phase_len - 1) + j].
+ */
+int
+simd_fir_interp_real_scalar(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                            int phase_len) {
+    if (phases < 1 || phase_len < 1 || in_len <= 0) {
+        return 0;
+    }
+
+    const int hist_len = phase_len - 1;
+
+    auto get_sample = [&](int src_idx) -> float {
+        return (src_idx < hist_len) ? hist[src_idx] : in[src_idx - hist_len];
+    };
+
+    for (int n = 0; n < in_len; n++) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            float acc = 0.0f;
+            for (int j = 0; j < phase_len; j++) {
+                acc += taps[j] * get_sample(n + j);
+            }
+            out[(size_t)n * (size_t)phases + (size_t)p] = acc;
+        }
+    }
+
+    /* Update history */
+    if (in_len >= hist_len) {
+        DSD_MEMCPY(hist, in + (in_len - hist_len), (size_t)hist_len * sizeof(float));
+    } else {
+        int need = hist_len - in_len;
+        DSD_MEMMOVE(hist, hist + in_len, (size_t)need * sizeof(float));
+        DSD_MEMCPY(hist + need, in, (size_t)in_len * sizeof(float));
+    }
+
+    return in_len * phases;
+}
+
 /* -------------------------------------------------------------------------- */
 /* Function Pointer Dispatch                                                  */
 /* -------------------------------------------------------------------------- */
@@ -290,10 +336,12 @@ simd_hb_decim2_real_scalar(const float* in, int in_len, float* out, float* hist,
 using fir_complex_fn = void (*)(const float*, int, float*, float*, float*, const float*, int);
 using hb_decim2_complex_fn = int (*)(const float*, int, float*, float*, float*, const float*, int);
 using hb_decim2_real_fn = int (*)(const float*, int, float*, float*, const float*, int);
+using interp_real_fn = int (*)(const float*, int, float*, float*, const float*, int, int);
 
 static fir_complex_fn g_fir_complex_impl = simd_fir_complex_apply_scalar;
 static hb_decim2_complex_fn g_hb_decim2_complex_impl = simd_hb_decim2_complex_scalar;
 static hb_decim2_real_fn g_hb_decim2_real_impl = simd_hb_decim2_real_scalar;
+static interp_real_fn g_interp_real_impl = simd_fir_interp_real_scalar;
 static const char* g_impl_name = "scalar";
 
 /* Dispatch init state: 0 = not started, 1 = in progress, 2 = done */
@@ -322,6 +370,7 @@ simd_fir_init_dispatch() {
         g_fir_complex_impl = simd_fir_complex_apply_avx2;
         g_hb_decim2_complex_impl = simd_hb_decim2_complex_avx2;
         g_hb_decim2_real_impl = simd_hb_decim2_real_avx2;
+        g_interp_real_impl = simd_fir_interp_real_avx2;
         g_impl_name = "avx2";
     } else
 #endif
@@ -329,12 +378,14 @@ simd_fir_init_dispatch() {
         g_fir_complex_impl = simd_fir_complex_apply_sse2;
         g_hb_decim2_complex_impl = simd_hb_decim2_complex_sse2;
         g_hb_decim2_real_impl = simd_hb_decim2_real_sse2;
+        g_interp_real_impl = simd_fir_interp_real_sse2;
         g_impl_name = "sse2";
     }
 #elif defined(__aarch64__) || defined(__arm64) || defined(_M_ARM64) || defined(_M_ARM64EC)
     g_fir_complex_impl = simd_fir_complex_apply_neon;
     g_hb_decim2_complex_impl = simd_hb_decim2_complex_neon;
     g_hb_decim2_real_impl = simd_hb_decim2_real_neon;
+    g_interp_real_impl = simd_fir_interp_real_neon;
     g_impl_name = "neon";
 #else
     /* Already set to scalar */
@@ -383,6 +434,18 @@ simd_hb_decim2_real(const float* in, int in_len, float* out, float* hist, const
     return g_hb_decim2_real_impl(in, in_len, out, hist, taps, taps_len);
 }
 
+extern "C" int
+simd_fir_interp_real(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                     int phase_len) {
+    if (simd_fir_prefer_scalar_for_block(in_len, phase_len)) {
+        return simd_fir_interp_real_scalar(in, in_len, out, hist, phase_taps, phases, phase_len);
+    }
+    if (g_fir_init_done.load(std::memory_order_acquire) != 2) {
+        simd_fir_init_dispatch();
+    }
+    return g_interp_real_impl(in, in_len, out, hist, phase_taps, phases, phase_len);
+}
+
 extern "C" const char*
 simd_fir_get_impl_name(void) {
     if (g_fir_init_done.load(std::memory_order_acquire) != 2) {
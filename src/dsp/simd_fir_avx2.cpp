@@ -48,6 +48,19 @@ simd_hb_decim2_real_avx2(const float* in, int in_len, float* out, float* hist, c
     (void)taps_len;
     return 0;
 }
+
+extern "C" int
+simd_fir_interp_real_avx2(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                          int phase_len) {
+    (void)in;
+    (void)in_len;
+    (void)out;
+    (void)hist;
+    (void)phase_taps;
+    (void)phases;
+    (void)phase_len;
+    return 0;
+}
 #else
 
 #include <cstring>
@@ -609,6 +622,63 @@ simd_hb_decim2_real_avx2(const float* in, int in_len, float* out, float* hist, c
     return out_len;
 }
 
+/**
+ * AVX2+FMA real polyphase interpolator.
+ * Computes one phase for 8 consecutive inputs per vector; each tap is a
+ * broadcast FMA against an unaligned window load.
+ */
+extern "C" int
+simd_fir_interp_real_avx2(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                          int phase_len) {
+    if (phases < 1 || phase_len < 1 || in_len <= 0) {
+        return 0;
+    }
+
+    const int hist_len = phase_len - 1;
+    const int scratch_len = hist_len + in_len;
+    if (tls_scratch_real.size() < (size_t)scratch_len) {
+        tls_scratch_real.resize((size_t)scratch_len);
+    }
+    float* scratch = tls_scratch_real.data();
+    DSD_MEMCPY(scratch, hist, (size_t)hist_len * sizeof(float));
+    DSD_MEMCPY(scratch + hist_len, in, (size_t)in_len * sizeof(float));
+    const size_t stride = (size_t)phases;
+
+    int n = 0;
+    for (; n + 7 < in_len; n += 8) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            __m256 acc = _mm256_setzero_ps();
+            for (int j = 0; j < phase_len; j++) {
+                acc = _mm256_fmadd_ps(_mm256_set1_ps(taps[j]), _mm256_loadu_ps(scratch + n + j), acc);
+            }
+
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, acc);
+            float* dst = out + (size_t)n * stride + (size_t)p;
+            for (int k = 0; k < 8; k++) {
+                dst[(size_t)k * stride] = lanes[k];
+            }
+        }
+    }
+
+    /* Scalar epilogue */
+    for (; n < in_len; n++) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            float acc = 0.0f;
+            for (int j = 0; j < phase_len; j++) {
+                acc += taps[j] * scratch[n + j];
+            }
+            out[(size_t)n * stride + (size_t)p] = acc;
+        }
+    }
+
+    update_real_history(in, in_len, hist, hist_len);
+
+    return in_len * phases;
+}
+
 // NOLINTEND(portability-simd-intrinsics)
 
 #endif
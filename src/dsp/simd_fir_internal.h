@@ -8,5 +8,7 @@ void simd_fir_complex_apply_scalar(const float* in, int in_len, float* out, floa
 int simd_hb_decim2_complex_scalar(const float* in, int in_len, float* out, float* hist_i, float* hist_q,
                                   const float* taps, int taps_len);
 int simd_hb_decim2_real_scalar(const float* in, int in_len, float* out, float* hist, const float* taps, int taps_len);
+int simd_fir_interp_real_scalar(const float* in, int in_len, float* out, float* hist, const float* phase_taps,
+                                int phases, int phase_len);
 
 #endif /* DSD_NEO_SRC_DSP_SIMD_FIR_INTERNAL_H_ */
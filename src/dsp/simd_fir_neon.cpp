@@ -529,3 +529,53 @@ simd_hb_decim2_real_neon(const float* in, int in_len, float* out, float* hist, c
 
     return out_len;
 }
+
+/**
+ * NEON real polyphase interpolator.
+ * Computes one phase for 4 consecutive inputs per vector; each tap is a
+ * broadcast FMA against an unaligned window load.
+ */
+extern "C" int
+simd_fir_interp_real_neon(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                          int phase_len) {
+    if (phases < 1 || phase_len < 1 || in_len <= 0) {
+        return 0;
+    }
+
+    const int hist_len = phase_len - 1;
+    const float* scratch = prepare_real_scratch(in, in_len, hist, hist_len, 0);
+    const size_t stride = (size_t)phases;
+
+    int n = 0;
+    for (; n + 3 < in_len; n += 4) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            for (int j = 0; j < phase_len; j++) {
+                acc = vfmaq_f32(acc, vdupq_n_f32(taps[j]), vld1q_f32(scratch + n + j));
+            }
+
+            float* dst = out + (size_t)n * stride + (size_t)p;
+            dst[0] = vgetq_lane_f32(acc, 0);
+            dst[stride] = vgetq_lane_f32(acc, 1);
+            dst[2 * stride] = vgetq_lane_f32(acc, 2);
+            dst[3 * stride] = vgetq_lane_f32(acc, 3);
+        }
+    }
+
+    /* Scalar epilogue */
+    for (; n < in_len; n++) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            float acc = 0.0f;
+            for (int j = 0; j < phase_len; j++) {
+                acc += taps[j] * scratch[n + j];
+            }
+            out[(size_t)n * stride + (size_t)p] = acc;
+        }
+    }
+
+    update_real_history(in, in_len, hist, hist_len);
+
+    return in_len * phases;
+}
@@ -531,4 +531,56 @@ simd_hb_decim2_real_sse2(const float* in, int in_len, float* out, float* hist, c
     return out_len;
 }
 
+/**
+ * SSE2 real polyphase interpolator.
+ * Computes one phase for 4 consecutive inputs per vector, so each tap is a
+ * broadcast multiply against an unaligned window load; no horizontal sums.
+ */
+extern "C" int
+simd_fir_interp_real_sse2(const float* in, int in_len, float* out, float* hist, const float* phase_taps, int phases,
+                          int phase_len) {
+    if (phases < 1 || phase_len < 1 || in_len <= 0) {
+        return 0;
+    }
+
+    const int hist_len = phase_len - 1;
+    const float* scratch = prepare_real_scratch(in, in_len, hist, hist_len, 0);
+    const size_t stride = (size_t)phases;
+
+    int n = 0;
+    for (; n + 3 < in_len; n += 4) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            __m128 acc = _mm_setzero_ps();
+            for (int j = 0; j < phase_len; j++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(taps[j]), _mm_loadu_ps(scratch + n + j)));
+            }
+
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, acc);
+            float* dst = out + (size_t)n * stride + (size_t)p;
+            dst[0] = lanes[0];
+            dst[stride] = lanes[1];
+            dst[2 * stride] = lanes[2];
+            dst[3 * stride] = lanes[3];
+        }
+    }
+
+    /* Scalar epilogue */
+    for (; n < in_len; n++) {
+        for (int p = 0; p < phases; p++) {
+            const float* taps = phase_taps + (size_t)p * (size_t)phase_len;
+            float acc = 0.0f;
+            for (int j = 0; j < phase_len; j++) {
+                acc += taps[j] * scratch[n + j];
+            }
+            out[(size_t)n * stride + (size_t)p] = acc;
+        }
+    }
+
+    update_real_history(in, in_len, hist, hist_len);
+
+    return in_len * phases;
+}
+
 // NOLINTEND(portability-simd-intrinsics)
@@ -10,9 +10,15 @@
  * Converts unsigned 8-bit I/Q into centered float in [-1.0, 1.0] with an
  * unbiased midpoint at 127.5. No clamping is applied so headroom is retained
  * for downstream float processing.
+ *
+ * The fused widen + half-band path keeps a small tile of widened pairs (plus
+ * the filter history) on the stack and decimates straight out of it, so the
+ * full-rate float stream stays in L1.
  */
 
 #include <dsd-neo/core/input_level.h>
+#include <dsd-neo/core/safe_api.h>
+#include <dsd-neo/dsp/halfband.h>
 #include <dsd-neo/dsp/simd_widen.h>
 
 #include <atomic>
@@ -42,12 +48,17 @@ apply_j4_rotation_f32(float in_i, float in_q, uint32_t phase, float* out_i, floa
     }
 }
 
+using widen_fn = void (*)(const unsigned char*, float*, uint32_t);
+using widen_s16_fn = void (*)(const int16_t*, float*, uint32_t);
 using widen_rot_phase_fn = uint32_t (*)(const unsigned char*, float*, uint32_t, uint32_t);
 using widen_moments_fn = void (*)(const unsigned char*, float*, uint32_t, dsd_input_level_cu8_moments*);
 using widen_rot_phase_moments_fn = uint32_t (*)(const unsigned char*, float*, uint32_t, uint32_t,
                                                 dsd_input_level_cu8_moments*);
+using hb31_decim2_iq_fn = void (*)(const float*, uint32_t, const float*, float*);
 
 #if defined(__x86_64__) || defined(_M_X64)
+extern "C" void widen_u8_to_f32_bias127_sse2(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void widen_s16_to_f32_sse2(const int16_t* src, float* dst, uint32_t len);
 extern "C" void widen_u8_to_f32_bias127_moments_sse2(const unsigned char* src, float* dst, uint32_t len,
                                                      dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_sse2(const unsigned char* src, float* dst, uint32_t len,
@@ -55,7 +66,10 @@ extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_sse2(const unsigned c
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_sse2(const unsigned char* src, float* dst,
                                                                         uint32_t len, uint32_t phase,
                                                                         dsd_input_level_cu8_moments* moments);
+extern "C" void hb31_decim2_iq_sse2(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 #if defined(DSD_NEO_DSP_HAVE_AVX2_IMPL) && DSD_NEO_X86_AVX2_RUNTIME_PROBE_SUPPORTED
+extern "C" void widen_u8_to_f32_bias127_avx2(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void widen_s16_to_f32_avx2(const int16_t* src, float* dst, uint32_t len);
 extern "C" void widen_u8_to_f32_bias127_moments_avx2(const unsigned char* src, float* dst, uint32_t len,
                                                      dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_avx2(const unsigned char* src, float* dst, uint32_t len,
@@ -63,10 +77,13 @@ extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_avx2(const unsigned c
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_avx2(const unsigned char* src, float* dst,
                                                                         uint32_t len, uint32_t phase,
                                                                         dsd_input_level_cu8_moments* moments);
+extern "C" void hb31_decim2_iq_avx2(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 #endif
 #endif
 
 #if defined(__aarch64__) || defined(__arm64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+extern "C" void widen_u8_to_f32_bias127_neon(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void widen_s16_to_f32_neon(const int16_t* src, float* dst, uint32_t len);
 extern "C" void widen_u8_to_f32_bias127_moments_neon(const unsigned char* src, float* dst, uint32_t len,
                                                      dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_neon(const unsigned char* src, float* dst, uint32_t len,
@@ -74,8 +91,11 @@ extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_neon(const unsigned c
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_neon(const unsigned char* src, float* dst,
                                                                         uint32_t len, uint32_t phase,
                                                                         dsd_input_level_cu8_moments* moments);
+extern "C" void hb31_decim2_iq_neon(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 #endif
 
+static void widen_u8_to_f32_bias127_scalar(const unsigned char* src, float* dst, uint32_t len);
+static void widen_s16_to_f32_scalar(const int16_t* src, float* dst, uint32_t len);
 static void widen_u8_to_f32_bias127_moments_scalar(const unsigned char* src, float* dst, uint32_t len,
                                                    dsd_input_level_cu8_moments* moments);
 static uint32_t widen_rotate90_u8_to_f32_bias127_phase_scalar(const unsigned char* src, float* dst, uint32_t len,
@@ -83,11 +103,15 @@ static uint32_t widen_rotate90_u8_to_f32_bias127_phase_scalar(const unsigned cha
 static uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_scalar(const unsigned char* src, float* dst,
                                                                       uint32_t len, uint32_t phase,
                                                                       dsd_input_level_cu8_moments* moments);
+static void hb31_decim2_iq_scalar(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 
+static widen_fn g_widen_impl = widen_u8_to_f32_bias127_scalar;
+static widen_s16_fn g_widen_s16_impl = widen_s16_to_f32_scalar;
 static widen_rot_phase_fn g_widen_rot_phase_impl = widen_rotate90_u8_to_f32_bias127_phase_scalar;
 static widen_moments_fn g_widen_moments_impl = widen_u8_to_f32_bias127_moments_scalar;
 static widen_rot_phase_moments_fn g_widen_rot_phase_moments_impl =
     widen_rotate90_u8_to_f32_bias127_phase_moments_scalar;
+static hb31_decim2_iq_fn g_hb31_decim2_iq_impl = hb31_decim2_iq_scalar;
 static std::atomic<int> g_widen_init_done{0};
 
 static void
@@ -103,20 +127,29 @@ simd_widen_init_dispatch(void) {
 #if defined(__x86_64__) || defined(_M_X64)
 #if defined(DSD_NEO_DSP_HAVE_AVX2_IMPL) && DSD_NEO_X86_AVX2_RUNTIME_PROBE_SUPPORTED
     if (dsd_neo_cpu_has_avx2_with_os_support()) {
+        g_widen_impl = widen_u8_to_f32_bias127_avx2;
+        g_widen_s16_impl = widen_s16_to_f32_avx2;
         g_widen_rot_phase_impl = widen_rotate90_u8_to_f32_bias127_phase_avx2;
         g_widen_moments_impl = widen_u8_to_f32_bias127_moments_avx2;
         g_widen_rot_phase_moments_impl = widen_rotate90_u8_to_f32_bias127_phase_moments_avx2;
+        g_hb31_decim2_iq_impl = hb31_decim2_iq_avx2;
     } else
 #endif
     {
+        g_widen_impl = widen_u8_to_f32_bias127_sse2;
+        g_widen_s16_impl = widen_s16_to_f32_sse2;
         g_widen_rot_phase_impl = widen_rotate90_u8_to_f32_bias127_phase_sse2;
         g_widen_moments_impl = widen_u8_to_f32_bias127_moments_sse2;
         g_widen_rot_phase_moments_impl = widen_rotate90_u8_to_f32_bias127_phase_moments_sse2;
+        g_hb31_decim2_iq_impl = hb31_decim2_iq_sse2;
     }
 #elif defined(__aarch64__) || defined(__arm64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+    g_widen_impl = widen_u8_to_f32_bias127_neon;
+    g_widen_s16_impl = widen_s16_to_f32_neon;
     g_widen_rot_phase_impl = widen_rotate90_u8_to_f32_bias127_phase_neon;
     g_widen_moments_impl = widen_u8_to_f32_bias127_moments_neon;
     g_widen_rot_phase_moments_impl = widen_rotate90_u8_to_f32_bias127_phase_moments_neon;
+    g_hb31_decim2_iq_impl = hb31_decim2_iq_neon;
 #endif
 
     g_widen_init_done.store(2, std::memory_order_release);
@@ -135,8 +168,8 @@ accumulate_cu8_local(dsd_input_level_cu8_moments* local, unsigned char sample) {
     }
 }
 
-void
-widen_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len) {
+static void
+widen_u8_to_f32_bias127_scalar(const unsigned char* src, float* dst, uint32_t len) {
     if (!src || !dst || len == 0U) {
         return;
     }
@@ -146,6 +179,17 @@ widen_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len) {
     }
 }
 
+static void
+widen_s16_to_f32_scalar(const int16_t* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    const float scale = 1.0f / 32768.0f;
+    for (uint32_t i = 0; i < len; i++) {
+        dst[i] = (float)src[i] * scale;
+    }
+}
+
 static void
 widen_u8_to_f32_bias127_moments_scalar(const unsigned char* src, float* dst, uint32_t len,
                                        dsd_input_level_cu8_moments* moments) {
@@ -203,7 +247,46 @@ widen_rotate90_u8_to_f32_bias127_phase_scalar(const unsigned char* src, float* d
     return widen_rotate90_u8_to_f32_bias127_phase_moments_scalar(src, dst, len, phase, nullptr);
 }
 
+/*
+ * 31-tap symmetric decimate-by-2 over interleaved I/Q. Output n uses the
+ * window starting at pair 2n: x[2n .. 2n+30], centered on pair 2n+15. The
+ * vector kernels may read one pair past the last window.
+ */
+static void
+hb31_decim2_iq_scalar(const float* x, uint32_t out_pairs, const float* taps, float* dst) {
+    for (uint32_t n = 0; n < out_pairs; n++) {
+        const float* w = x + (size_t)n * 4U;
+        float acc_i = taps[15] * w[30];
+        float acc_q = taps[15] * w[31];
+        for (uint32_t e = 0; e < 15U; e++) {
+            if (taps[e] == 0.0f) {
+                continue;
+            }
+            const uint32_t mirror = 30U - e;
+            acc_i += taps[e] * (w[2U * e] + w[2U * mirror]);
+            acc_q += taps[e] * (w[2U * e + 1U] + w[2U * mirror + 1U]);
+        }
+        dst[2U * n] = acc_i;
+        dst[2U * n + 1U] = acc_q;
+    }
+}
+
 #ifdef DSD_NEO_TEST_HOOKS
+extern "C" void
+dsd_test_widen_u8_to_f32_bias127_scalar(const unsigned char* src, float* dst, uint32_t len) {
+    widen_u8_to_f32_bias127_scalar(src, dst, len);
+}
+
+extern "C" void
+dsd_test_widen_s16_to_f32_scalar(const int16_t* src, float* dst, uint32_t len) {
+    widen_s16_to_f32_scalar(src, dst, len);
+}
+
+extern "C" void
+dsd_test_hb31_decim2_iq_scalar(const float* x, uint32_t out_pairs, const float* taps, float* dst) {
+    hb31_decim2_iq_scalar(x, out_pairs, taps, dst);
+}
+
 extern "C" void
 dsd_test_widen_u8_to_f32_bias127_moments_scalar(const unsigned char* src, float* dst, uint32_t len,
                                                 dsd_input_level_cu8_moments* moments) {
@@ -223,6 +306,22 @@ dsd_test_widen_rotate90_u8_to_f32_bias127_phase_moments_scalar(const unsigned ch
 }
 #endif
 
+void
+widen_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len) {
+    if (g_widen_init_done.load(std::memory_order_acquire) != 2) {
+        simd_widen_init_dispatch();
+    }
+    g_widen_impl(src, dst, len);
+}
+
+void
+widen_s16_to_f32(const int16_t* src, float* dst, uint32_t len) {
+    if (g_widen_init_done.load(std::memory_order_acquire) != 2) {
+        simd_widen_init_dispatch();
+    }
+    g_widen_s16_impl(src, dst, len);
+}
+
 void
 widen_u8_to_f32_bias127_moments(const unsigned char* src, float* dst, uint32_t len,
                                 dsd_input_level_cu8_moments* moments) {
@@ -248,3 +347,89 @@ widen_rotate90_u8_to_f32_bias127_phase_moments(const unsigned char* src, float*
     }
     return g_widen_rot_phase_moments_impl(src, dst, len, phase, moments);
 }
+
+/* Widened pairs per tile; with the history this is ~8 KiB of stack. */
+static const uint32_t kWidenHbTilePairs = 1024U;
+
+void
+widen_hb_decim2_state_reset(dsd_neo_widen_hb_state* st) {
+    if (!st) {
+        return;
+    }
+    DSD_MEMSET(st->hist, 0, sizeof(st->hist));
+    st->next_window = DSD_NEO_WIDEN_HB_HIST_PAIRS / 2U;
+}
+
+uint32_t
+widen_hb_decim2_out_pairs(const dsd_neo_widen_hb_state* st, uint32_t in_pairs) {
+    if (!st || in_pairs < st->next_window + 1U) {
+        return 0U;
+    }
+    return (in_pairs - 1U - st->next_window) / 2U + 1U;
+}
+
+uint32_t
+widen_hb_decim2_in_pairs(const dsd_neo_widen_hb_state* st, uint32_t out_pairs) {
+    if (!st || out_pairs == 0U) {
+        return 0U;
+    }
+    return st->next_window + 2U * out_pairs - 1U;
+}
+
+uint32_t
+widen_hb_decim2_u8_to_f32_bias127(const unsigned char* src, float* dst, uint32_t len, uint32_t phase, int rotate,
+                                  dsd_neo_widen_hb_state* st, dsd_input_level_cu8_moments* moments,
+                                  uint32_t* out_pairs) {
+    uint32_t cur_phase = phase & 3U;
+    if (out_pairs) {
+        *out_pairs = 0U;
+    }
+    if (!src || !dst || !st || len < 2U) {
+        return cur_phase;
+    }
+    if (g_widen_init_done.load(std::memory_order_acquire) != 2) {
+        simd_widen_init_dispatch();
+    }
+
+    const uint32_t hist = DSD_NEO_WIDEN_HB_HIST_PAIRS;
+    /* History, one tile, and the spare pair the vector kernels may read past the last window. */
+    alignas(32) float scratch[2U * (DSD_NEO_WIDEN_HB_HIST_PAIRS + kWidenHbTilePairs + 1U)];
+    float* tile = scratch + 2U * hist;
+    DSD_MEMCPY(scratch, st->hist, sizeof(st->hist));
+    scratch[2U * (hist + kWidenHbTilePairs)] = 0.0f;
+    scratch[2U * (hist + kWidenHbTilePairs) + 1U] = 0.0f;
+
+    const uint32_t pairs = len >> 1;
+    uint32_t window = st->next_window;
+    uint32_t done = 0U;
+    uint32_t written = 0U;
+    while (done < pairs) {
+        const uint32_t n = (pairs - done < kWidenHbTilePairs) ? (pairs - done) : kWidenHbTilePairs;
+        const unsigned char* in = src + (size_t)done * 2U;
+        if (rotate) {
+            cur_phase = moments ? g_widen_rot_phase_moments_impl(in, tile, 2U * n, cur_phase, moments)
+                                : g_widen_rot_phase_impl(in, tile, 2U * n, cur_phase);
+        } else if (moments) {
+            g_widen_moments_impl(in, tile, 2U * n, moments);
+        } else {
+            widen_u8_to_f32_bias127(in, tile, 2U * n);
+        }
+
+        /* Windows starting at pair w need pairs w..w+30 of hist + tile. */
+        const uint32_t count = (n >= window + 1U) ? (n - 1U - window) / 2U + 1U : 0U;
+        if (count > 0U) {
+            g_hb31_decim2_iq_impl(scratch + 2U * window, count, hb31_q15_taps, dst + 2U * written);
+            written += count;
+        }
+        window = window + 2U * count - n;
+        DSD_MEMMOVE(scratch, scratch + 2U * n, sizeof(st->hist));
+        done += n;
+    }
+
+    DSD_MEMCPY(st->hist, scratch, sizeof(st->hist));
+    st->next_window = window;
+    if (out_pairs) {
+        *out_pairs = written;
+    }
+    return cur_phase;
+}
@@ -3,11 +3,26 @@
  * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
  */
 
+#include <cstddef>
 #include <cstdint>
 #include "dsd-neo/core/input_level.h"
 #include "dsd-neo/core/safe_api.h"
 
 #if defined(__clang_analyzer__)
+extern "C" void
+widen_u8_to_f32_bias127_avx2(const unsigned char* src, float* dst, uint32_t len) {
+    (void)src;
+    (void)dst;
+    (void)len;
+}
+
+extern "C" void
+widen_s16_to_f32_avx2(const int16_t* src, float* dst, uint32_t len) {
+    (void)src;
+    (void)dst;
+    (void)len;
+}
+
 extern "C" void
 widen_u8_to_f32_bias127_moments_avx2(const unsigned char* src, float* dst, uint32_t len,
                                      dsd_input_level_cu8_moments* moments) {
@@ -34,6 +49,14 @@ widen_rotate90_u8_to_f32_bias127_phase_moments_avx2(const unsigned char* src, fl
     (void)moments;
     return phase & 3U;
 }
+
+extern "C" void
+hb31_decim2_iq_avx2(const float* x, uint32_t out_pairs, const float* taps, float* dst) {
+    (void)x;
+    (void)out_pairs;
+    (void)taps;
+    (void)dst;
+}
 #else
 
 #include <emmintrin.h>
@@ -213,8 +236,92 @@ rotate8_store_avx2(const unsigned char* src, float* dst, uint32_t phase) {
     _mm256_storeu_ps(dst, rotated);
 }
 
+/*
+ * Pairs p, p+2, p+4, p+6 in lane order (p, p+4 | p+2, p+6). Two contiguous
+ * loads cover pairs p..p+7, so one pair past p+6 must be readable. The
+ * accumulators stay in this order and are permuted once at the store.
+ */
+static inline __m256
+load_pair4_split_avx2(const float* p) {
+    const __m256 lo = _mm256_loadu_ps(p);
+    const __m256 hi = _mm256_loadu_ps(p + 8);
+    return _mm256_shuffle_ps(lo, hi, _MM_SHUFFLE(1, 0, 1, 0));
+}
+
+static inline void
+store_pair4_split_avx2(float* dst, __m256 acc) {
+    _mm256_storeu_ps(dst, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(acc), 0xD8)));
+}
+
+/* Non-zero outer taps of a 31-tap symmetric filter as (coefficient, offset) pairs. */
+static inline uint32_t
+hb31_collect_taps(const float* taps, float* coef, uint32_t* off) {
+    uint32_t nc = 0U;
+    for (uint32_t e = 0; e < 15U; e++) {
+        if (taps[e] != 0.0f) {
+            coef[nc] = taps[e];
+            off[nc] = e;
+            nc++;
+        }
+    }
+    return nc;
+}
+
+static inline void
+hb31_decim2_iq_tail(const float* x, uint32_t n, uint32_t out_pairs, const float* taps, const float* coef,
+                    const uint32_t* off, uint32_t nc, float* dst) {
+    for (; n < out_pairs; n++) {
+        const float* w = x + (size_t)n * 4U;
+        float acc_i = taps[15] * w[30];
+        float acc_q = taps[15] * w[31];
+        for (uint32_t k = 0; k < nc; k++) {
+            const uint32_t mirror = 30U - off[k];
+            acc_i += coef[k] * (w[2U * off[k]] + w[2U * mirror]);
+            acc_q += coef[k] * (w[2U * off[k] + 1U] + w[2U * mirror + 1U]);
+        }
+        dst[2U * n] = acc_i;
+        dst[2U * n + 1U] = acc_q;
+    }
+}
+
 } /* namespace */
 
+extern "C" void
+widen_u8_to_f32_bias127_avx2(const unsigned char* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    uint32_t i = 0U;
+    for (; i + 31U < len; i += 32U) {
+        _mm256_storeu_ps(dst + i + 0U, widen8_u8_to_f32_bias127_avx2(src + i + 0U));
+        _mm256_storeu_ps(dst + i + 8U, widen8_u8_to_f32_bias127_avx2(src + i + 8U));
+        _mm256_storeu_ps(dst + i + 16U, widen8_u8_to_f32_bias127_avx2(src + i + 16U));
+        _mm256_storeu_ps(dst + i + 24U, widen8_u8_to_f32_bias127_avx2(src + i + 24U));
+    }
+    const float inv = 1.0f / 127.5f;
+    for (; i < len; i++) {
+        dst[i] = ((float)src[i] - 127.5f) * inv;
+    }
+}
+
+extern "C" void
+widen_s16_to_f32_avx2(const int16_t* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+    uint32_t i = 0U;
+    for (; i + 15U < len; i += 16U) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8U));
+        _mm256_storeu_ps(dst + i + 0U, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)), scale));
+        _mm256_storeu_ps(dst + i + 8U, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)), scale));
+    }
+    for (; i < len; i++) {
+        dst[i] = (float)src[i] * (1.0f / 32768.0f);
+    }
+}
+
 extern "C" void
 widen_u8_to_f32_bias127_moments_avx2(const unsigned char* src, float* dst, uint32_t len,
                                      dsd_input_level_cu8_moments* moments) {
@@ -338,6 +445,35 @@ widen_rotate90_u8_to_f32_bias127_phase_moments_avx2(const unsigned char* src, fl
     return cur_phase;
 }
 
+extern "C" void
+hb31_decim2_iq_avx2(const float* x, uint32_t out_pairs, const float* taps, float* dst) {
+    float coef[15];
+    uint32_t off[15];
+    const uint32_t nc = hb31_collect_taps(taps, coef, off);
+    const __m256 center = _mm256_set1_ps(taps[15]);
+
+    /* Eight outputs per step in two accumulators; the +1 pair keeps the last load in bounds. */
+    uint32_t n = 0U;
+    for (; n + 8U <= out_pairs; n += 8U) {
+        const float* w = x + (size_t)n * 4U;
+        __m256 acc0 = _mm256_mul_ps(center, load_pair4_split_avx2(w + 30));
+        __m256 acc1 = _mm256_mul_ps(center, load_pair4_split_avx2(w + 46));
+        for (uint32_t k = 0; k < nc; k++) {
+            const float* minus = w + 2U * off[k];
+            const float* plus = w + 2U * (30U - off[k]);
+            const __m256 tap = _mm256_set1_ps(coef[k]);
+            const __m256 sum0 = _mm256_add_ps(load_pair4_split_avx2(minus), load_pair4_split_avx2(plus));
+            const __m256 sum1 = _mm256_add_ps(load_pair4_split_avx2(minus + 16), load_pair4_split_avx2(plus + 16));
+            acc0 = _mm256_fmadd_ps(tap, sum0, acc0);
+            acc1 = _mm256_fmadd_ps(tap, sum1, acc1);
+        }
+        store_pair4_split_avx2(dst + 2U * n, acc0);
+        store_pair4_split_avx2(dst + 2U * n + 8U, acc1);
+    }
+    _mm256_zeroupper();
+    hb31_decim2_iq_tail(x, n, out_pairs, taps, coef, off, nc, dst);
+}
+
 // NOLINTEND(portability-simd-intrinsics)
 
 #endif
@@ -4,6 +4,7 @@
  */
 
 #include <arm_neon.h>
+#include <cstddef>
 #include <cstdint>
 #include "dsd-neo/core/input_level.h"
 #include "dsd-neo/core/safe_api.h"
@@ -102,8 +103,80 @@ reduce16_u8_neon(uint8x16_t bytes, dsd_input_level_cu8_moments* local, uint8x16_
     *max_bytes = vmaxq_u8(*max_bytes, bytes);
 }
 
+/* Pair p and pair p+2 (outputs n and n+1 step two pairs apart). */
+static inline float32x4_t
+load_pair2_neon(const float* p) {
+    return vcombine_f32(vld1_f32(p), vld1_f32(p + 4));
+}
+
+/* Non-zero outer taps of a 31-tap symmetric filter as (coefficient, offset) pairs. */
+static inline uint32_t
+hb31_collect_taps(const float* taps, float* coef, uint32_t* off) {
+    uint32_t nc = 0U;
+    for (uint32_t e = 0; e < 15U; e++) {
+        if (taps[e] != 0.0f) {
+            coef[nc] = taps[e];
+            off[nc] = e;
+            nc++;
+        }
+    }
+    return nc;
+}
+
+static inline void
+hb31_decim2_iq_tail(const float* x, uint32_t n, uint32_t out_pairs, const float* taps, const float* coef,
+                    const uint32_t* off, uint32_t nc, float* dst) {
+    for (; n < out_pairs; n++) {
+        const float* w = x + (size_t)n * 4U;
+        float acc_i = taps[15] * w[30];
+        float acc_q = taps[15] * w[31];
+        for (uint32_t k = 0; k < nc; k++) {
+            const uint32_t mirror = 30U - off[k];
+            acc_i += coef[k] * (w[2U * off[k]] + w[2U * mirror]);
+            acc_q += coef[k] * (w[2U * off[k] + 1U] + w[2U * mirror + 1U]);
+        }
+        dst[2U * n] = acc_i;
+        dst[2U * n + 1U] = acc_q;
+    }
+}
+
 } /* namespace */
 
+extern "C" void
+widen_u8_to_f32_bias127_neon(const unsigned char* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    uint32_t i = 0U;
+    for (; i + 15U < len; i += 16U) {
+        vst1q_f32(dst + i + 0U, widen4_u8_to_f32_bias127_neon(src + i + 0U));
+        vst1q_f32(dst + i + 4U, widen4_u8_to_f32_bias127_neon(src + i + 4U));
+        vst1q_f32(dst + i + 8U, widen4_u8_to_f32_bias127_neon(src + i + 8U));
+        vst1q_f32(dst + i + 12U, widen4_u8_to_f32_bias127_neon(src + i + 12U));
+    }
+    const float inv = 1.0f / 127.5f;
+    for (; i < len; i++) {
+        dst[i] = ((float)src[i] - 127.5f) * inv;
+    }
+}
+
+extern "C" void
+widen_s16_to_f32_neon(const int16_t* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    const float scale = 1.0f / 32768.0f;
+    uint32_t i = 0U;
+    for (; i + 7U < len; i += 8U) {
+        const int16x8_t words = vld1q_s16(src + i);
+        vst1q_f32(dst + i + 0U, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(words))), scale));
+        vst1q_f32(dst + i + 4U, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(words))), scale));
+    }
+    for (; i < len; i++) {
+        dst[i] = (float)src[i] * scale;
+    }
+}
+
 extern "C" void
 widen_u8_to_f32_bias127_moments_neon(const unsigned char* src, float* dst, uint32_t len,
                                      dsd_input_level_cu8_moments* moments) {
@@ -215,3 +288,24 @@ widen_rotate90_u8_to_f32_bias127_phase_moments_neon(const unsigned char* src, fl
     (void)dsd_input_level_cu8_moments_merge(moments, &local);
     return cur_phase;
 }
+
+extern "C" void
+hb31_decim2_iq_neon(const float* x, uint32_t out_pairs, const float* taps, float* dst) {
+    float coef[15];
+    uint32_t off[15];
+    const uint32_t nc = hb31_collect_taps(taps, coef, off);
+    const float32x4_t center = vdupq_n_f32(taps[15]);
+
+    uint32_t n = 0U;
+    for (; n + 2U <= out_pairs; n += 2U) {
+        const float* w = x + (size_t)n * 4U;
+        float32x4_t acc = vmulq_f32(center, load_pair2_neon(w + 30));
+        for (uint32_t k = 0; k < nc; k++) {
+            const float32x4_t sum =
+                vaddq_f32(load_pair2_neon(w + 2U * off[k]), load_pair2_neon(w + 2U * (30U - off[k])));
+            acc = vmlaq_n_f32(acc, sum, coef[k]);
+        }
+        vst1q_f32(dst + 2U * n, acc);
+    }
+    hb31_decim2_iq_tail(x, n, out_pairs, taps, coef, off, nc, dst);
+}
@@ -3,6 +3,7 @@
  * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
  */
 
+#include <cstddef>
 #include <cstdint>
 #include <emmintrin.h>
 #include <mmintrin.h>
@@ -153,8 +154,84 @@ merge_vector_extrema(__m128i min_bytes, __m128i max_bytes, dsd_input_level_cu8_m
     }
 }
 
+/* Pair p and pair p+2 (outputs n and n+1 step two pairs apart). */
+static inline __m128
+load_pair2_sse2(const float* p) {
+    __m128 v = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+    return _mm_loadh_pi(v, reinterpret_cast<const __m64*>(p + 4));
+}
+
+/* Non-zero outer taps of a 31-tap symmetric filter as (coefficient, offset) pairs. */
+static inline uint32_t
+hb31_collect_taps(const float* taps, float* coef, uint32_t* off) {
+    uint32_t nc = 0U;
+    for (uint32_t e = 0; e < 15U; e++) {
+        if (taps[e] != 0.0f) {
+            coef[nc] = taps[e];
+            off[nc] = e;
+            nc++;
+        }
+    }
+    return nc;
+}
+
+static inline void
+hb31_decim2_iq_tail(const float* x, uint32_t n, uint32_t out_pairs, const float* taps, const float* coef,
+                    const uint32_t* off, uint32_t nc, float* dst) {
+    for (; n < out_pairs; n++) {
+        const float* w = x + (size_t)n * 4U;
+        float acc_i = taps[15] * w[30];
+        float acc_q = taps[15] * w[31];
+        for (uint32_t k = 0; k < nc; k++) {
+            const uint32_t mirror = 30U - off[k];
+            acc_i += coef[k] * (w[2U * off[k]] + w[2U * mirror]);
+            acc_q += coef[k] * (w[2U * off[k] + 1U] + w[2U * mirror + 1U]);
+        }
+        dst[2U * n] = acc_i;
+        dst[2U * n + 1U] = acc_q;
+    }
+}
+
 } /* namespace */
 
+extern "C" void
+widen_u8_to_f32_bias127_sse2(const unsigned char* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    uint32_t i = 0U;
+    for (; i + 15U < len; i += 16U) {
+        _mm_storeu_ps(dst + i + 0U, widen4_u8_to_f32_bias127_sse2(src + i + 0U));
+        _mm_storeu_ps(dst + i + 4U, widen4_u8_to_f32_bias127_sse2(src + i + 4U));
+        _mm_storeu_ps(dst + i + 8U, widen4_u8_to_f32_bias127_sse2(src + i + 8U));
+        _mm_storeu_ps(dst + i + 12U, widen4_u8_to_f32_bias127_sse2(src + i + 12U));
+    }
+    const float inv = 1.0f / 127.5f;
+    for (; i < len; i++) {
+        dst[i] = ((float)src[i] - 127.5f) * inv;
+    }
+}
+
+extern "C" void
+widen_s16_to_f32_sse2(const int16_t* src, float* dst, uint32_t len) {
+    if (!src || !dst || len == 0U) {
+        return;
+    }
+    const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+    uint32_t i = 0U;
+    for (; i + 7U < len; i += 8U) {
+        const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        /* Interleave each word with itself, then shift right to sign-extend. */
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+        _mm_storeu_ps(dst + i + 0U, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4U, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    for (; i < len; i++) {
+        dst[i] = (float)src[i] * (1.0f / 32768.0f);
+    }
+}
+
 extern "C" void
 widen_u8_to_f32_bias127_moments_sse2(const unsigned char* src, float* dst, uint32_t len,
                                      dsd_input_level_cu8_moments* moments) {
@@ -265,4 +342,24 @@ widen_rotate90_u8_to_f32_bias127_phase_moments_sse2(const unsigned char* src, fl
     return cur_phase;
 }
 
+extern "C" void
+hb31_decim2_iq_sse2(const float* x, uint32_t out_pairs, const float* taps, float* dst) {
+    float coef[15];
+    uint32_t off[15];
+    const uint32_t nc = hb31_collect_taps(taps, coef, off);
+    const __m128 center = _mm_set1_ps(taps[15]);
+
+    uint32_t n = 0U;
+    for (; n + 2U <= out_pairs; n += 2U) {
+        const float* w = x + (size_t)n * 4U;
+        __m128 acc = _mm_mul_ps(center, load_pair2_sse2(w + 30));
+        for (uint32_t k = 0; k < nc; k++) {
+            const __m128 sum = _mm_add_ps(load_pair2_sse2(w + 2U * off[k]), load_pair2_sse2(w + 2U * (30U - off[k])));
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(coef[k]), sum));
+        }
+        _mm_storeu_ps(dst + 2U * n, acc);
+    }
+    hb31_decim2_iq_tail(x, n, out_pairs, taps, coef, off, nc, dst);
+}
+
 // NOLINTEND(portability-simd-intrinsics)
@@ -5,6 +5,7 @@
 
 #include <dsd-neo/core/audio.h>
 #include <dsd-neo/core/audio_filters.h>
+#include <dsd-neo/core/audio_graph.h>
 #include <dsd-neo/core/call_state.h>
 #include <dsd-neo/core/constants.h>
 #include <dsd-neo/core/csv_import.h>
@@ -19,6 +20,7 @@
 #include <dsd-neo/core/talkgroup_policy.h>
 #include <dsd-neo/core/time_format.h>
 #include <dsd-neo/core/vocoder.h>
+#include <dsd-neo/core/wav_writer.h>
 #include <dsd-neo/dsp/frame_sync.h>
 #include <dsd-neo/dsp/sps_filters.h>
 #include <dsd-neo/engine/engine.h>
@@ -2593,11 +2595,13 @@ dsd_engine_cleanup(dsd_opts* opts, dsd_state* state) {
     // calls may still be active.
     dsd_event_flush_pending_alerts(opts, state);
     dsd_engine_cleanup_close_wavs(opts, state);
+    closeWavOutFileRaw(opts, state);
+    // Finalizing the last calls may queue rdio uploads, so the WAV writer stops first.
+    dsd_wav_writer_shutdown();
     dsd_rdio_upload_shutdown();
 
-    if (opts->wav_out_raw != NULL) {
-        opts->wav_out_raw = close_wav_file(opts->wav_out_raw);
-    }
+    // The audio graph's mixer writes to the UDP and local outputs closed below.
+    dsd_audio_graph_output_stop(state);
 
     closeSymbolOutFile(opts, state);
     dsd_frame_log_close(opts);
@@ -2640,6 +2644,7 @@ dsd_engine_run_install_hooks(void) {
     dsd_engine_udp_audio_hooks_install();
     dsd_engine_m17_udp_hooks_install();
     dsd_engine_p25_optional_hooks_install();
+    dsd_engine_vocoder_drain_hooks_install();
 }
 
 static int
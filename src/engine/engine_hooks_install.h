@@ -17,5 +17,6 @@ void dsd_engine_net_audio_input_hooks_install(void);
 void dsd_engine_udp_audio_hooks_install(void);
 void dsd_engine_m17_udp_hooks_install(void);
 void dsd_engine_p25_optional_hooks_install(void);
+void dsd_engine_vocoder_drain_hooks_install(void);
 
 #endif
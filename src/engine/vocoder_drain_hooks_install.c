@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include <dsd-neo/core/vocoder.h>
+#include <dsd-neo/core/vocoder_worker.h>
+#include <dsd-neo/runtime/vocoder_drain_hooks.h>
+
+#include "dsd-neo/core/opts_fwd.h"
+#include "dsd-neo/core/state_fwd.h"
+#include "engine_hooks_install.h"
+
+static int
+vocoder_lane_pending(const dsd_state* state, int slot) {
+    return dsd_vocoder_worker_pending(dsd_vocoder_worker_peek(state), slot);
+}
+
+void
+dsd_engine_vocoder_drain_hooks_install(void) {
+    dsd_vocoder_drain_hooks hooks = {0};
+    hooks.pending = vocoder_lane_pending;
+    hooks.drain = dsd_mbe_drain_slot_audio;
+    dsd_vocoder_drain_hooks_set(hooks);
+}
@@ -58,69 +58,110 @@ BPTCDeInterleaveDMRData(const uint8_t* Input, uint8_t* Output) {
     }
 } /* End BPTCDeInterleaveDMRData() */
 
-static void
-bptc_196x96_fill_matrix(const uint8_t input[196], uint8_t matrix[13][15]) {
-    uint32_t k = 1;
-    for (uint32_t i = 0; i < 13; i++) {
-        for (uint32_t j = 0; j < 15; j++) {
-            matrix[i][j] = (input[k] & 1);
-            k++;
-        }
-    }
+/*
+ * The 13x15 product code is held as one 15-bit word per row, column 0 in bit
+ * 14. Bit k of a row's Hamming(15,11) syndrome is the parity of the row under
+ * mask k; the column Hamming(13,9) syndromes are computed for all 15 columns
+ * at once by XOR-ing whole rows, so neither pass walks the matrix bit by bit.
+ */
+#define BPTC_196X96_ROW_DATA_MASK 0x7FF0U
+
+/* Row parity masks, syndrome bit 0 first (Hamming(15,11) columns 9,D,F,E,7,A,5,B,C,6,3,8,4,2,1). */
+static const uint16_t bptc_196x96_row_syndrome_mask[4] = {0x7591U, 0x1EB2U, 0x3D64U, 0x7AC8U};
+
+/* Row bit to flip for each Hamming(15,11) syndrome; every nonzero syndrome is a single error. */
+static const uint16_t bptc_196x96_row_flip[16] = {
+    0x0000U, 0x0001U, 0x0002U, 0x0010U, 0x0004U, 0x0100U, 0x0020U, 0x0400U,
+    0x0008U, 0x4000U, 0x0200U, 0x0080U, 0x0040U, 0x2000U, 0x0800U, 0x1000U,
+};
+
+/* Hamming(13,9) parity check columns, one per matrix row. */
+static const uint8_t bptc_196x96_col_check[13] = {0xF, 0xE, 0x7, 0xA, 0x5, 0xB, 0xC, 0x6, 0x3, 0x8, 0x4, 0x2, 0x1};
+
+/* Matrix row in error for each nonzero Hamming(13,9) syndrome, 0xFF when uncorrectable. */
+static const uint8_t bptc_196x96_col_error_row[16] = {
+    0xFE, 12, 11, 8, 10, 4, 7, 2, 9, 0xFF, 3, 5, 6, 0xFF, 1, 0,
+};
+
+/* Interleaved bit feeding each matrix position 1..195: the inverse of BPTCDeInterleavingIndex. */
+static const uint8_t bptc_196x96_source_index[195] = {
+    181, 166, 151, 136, 121, 106,  91,  76,  61,  46,  31,  16,   1, 182, 167, 152, 137, 122, 107,  92,  77,  62,
+     47,  32,  17,   2, 183, 168, 153, 138, 123, 108,  93,  78,  63,  48,  33,  18,   3, 184, 169, 154, 139, 124,
+    109,  94,  79,  64,  49,  34,  19,   4, 185, 170, 155, 140, 125, 110,  95,  80,  65,  50,  35,  20,   5, 186,
+    171, 156, 141, 126, 111,  96,  81,  66,  51,  36,  21,   6, 187, 172, 157, 142, 127, 112,  97,  82,  67,  52,
+     37,  22,   7, 188, 173, 158, 143, 128, 113,  98,  83,  68,  53,  38,  23,   8, 189, 174, 159, 144, 129, 114,
+     99,  84,  69,  54,  39,  24,   9, 190, 175, 160, 145, 130, 115, 100,  85,  70,  55,  40,  25,  10, 191, 176,
+    161, 146, 131, 116, 101,  86,  71,  56,  41,  26,  11, 192, 177, 162, 147, 132, 117, 102,  87,  72,  57,  42,
+     27,  12, 193, 178, 163, 148, 133, 118, 103,  88,  73,  58,  43,  28,  13, 194, 179, 164, 149, 134, 119, 104,
+     89,  74,  59,  44,  29,  14, 195, 180, 165, 150, 135, 120, 105,  90,  75,  60,  45,  30,  15,
+};
+
+static unsigned int
+bptc_parity15(unsigned int v) {
+    v ^= v >> 8;
+    v ^= v >> 4;
+    return (0x6996U >> (v & 0xFU)) & 1U;
 }
 
-static uint32_t
-bptc_196x96_decode_rows(uint8_t matrix[13][15]) {
-    uint8_t line_uncorrected[15];
-    uint8_t line_corrected[11];
-    uint32_t errors = 0;
+/* Only the data bits of rows 0-8 are written back, matching the per-line decoders this replaced. */
+static void
+bptc_196x96_decode_rows(uint16_t rows[13]) {
     for (uint32_t i = 0; i < 9; i++) {
-        for (uint32_t j = 0; j < 15; j++) {
-            line_uncorrected[j] = matrix[i][j];
-        }
-        if (Hamming_15_11_decode(line_uncorrected, line_corrected, 1) == false) {
-            errors++;
-        }
-        for (uint32_t j = 0; j < 11; j++) {
-            matrix[i][j] = line_corrected[j];
+        const unsigned int word = rows[i];
+        unsigned int syndrome = 0;
+        for (uint32_t k = 0; k < 4; k++) {
+            syndrome |= bptc_parity15(word & bptc_196x96_row_syndrome_mask[k]) << k;
         }
+        rows[i] = (uint16_t)(word ^ (bptc_196x96_row_flip[syndrome] & BPTC_196X96_ROW_DATA_MASK));
     }
-    return errors;
 }
 
 static uint32_t
-bptc_196x96_decode_cols(uint8_t matrix[13][15]) {
-    uint8_t col_uncorrected[13];
-    uint8_t col_corrected[9];
+bptc_196x96_decode_cols(uint16_t rows[13]) {
+    unsigned int s[4] = {0, 0, 0, 0};
+    for (uint32_t i = 0; i < 13; i++) {
+        const unsigned int check = bptc_196x96_col_check[i];
+        for (uint32_t k = 0; k < 4; k++) {
+            s[k] ^= rows[i] & (0U - ((check >> k) & 1U));
+        }
+    }
     uint32_t errors = 0;
-    for (uint32_t i = 0; i < 15; i++) {
-        for (uint32_t j = 0; j < 13; j++) {
-            col_uncorrected[j] = matrix[j][i];
+    for (unsigned int pending = s[0] | s[1] | s[2] | s[3]; pending != 0U; pending &= pending - 1U) {
+        const unsigned int bit = pending & (0U - pending);
+        unsigned int syndrome = 0;
+        for (uint32_t k = 0; k < 4; k++) {
+            syndrome |= ((s[k] & bit) != 0U) ? (1U << k) : 0U;
         }
-        if (Hamming_13_9_decode(col_uncorrected, col_corrected, 1) == false) {
+        const uint8_t row = bptc_196x96_col_error_row[syndrome];
+        if (row == 0xFF) {
             errors++;
-        }
-        for (uint32_t j = 0; j < 9; j++) {
-            matrix[j][i] = col_corrected[j];
+        } else if (row < 9) {
+            rows[row] = (uint16_t)(rows[row] ^ bit);
         }
     }
     return errors;
 }
 
-static void
-bptc_196x96_extract_payload_and_r(uint8_t matrix[13][15], uint8_t extracted[96], uint8_t r_bits[3]) {
+static uint32_t
+bptc_196x96_decode_packed(uint16_t rows[13], uint8_t DMRDataExtracted[96], uint8_t R[3]) {
+    bptc_196x96_decode_rows(rows);
+    (void)bptc_196x96_decode_cols(rows);
+    bptc_196x96_decode_rows(rows);
+    const uint32_t hamming_irrecoverable_error_nb = bptc_196x96_decode_cols(rows);
+
     uint32_t k = 0;
-    for (uint32_t i = 3; i < 11; i++) {
-        extracted[k++] = matrix[0][i];
+    for (int j = 11; j >= 4; j--) {
+        DMRDataExtracted[k++] = (uint8_t)((rows[0] >> j) & 1U);
     }
     for (uint32_t i = 1; i < 9; i++) {
-        for (uint32_t j = 0; j < 11; j++) {
-            extracted[k++] = matrix[i][j];
+        for (int j = 14; j >= 4; j--) {
+            DMRDataExtracted[k++] = (uint8_t)((rows[i] >> j) & 1U);
         }
     }
-    r_bits[0] = matrix[0][2];
-    r_bits[1] = matrix[0][1];
-    r_bits[2] = matrix[0][0];
+    R[0] = (uint8_t)((rows[0] >> 12) & 1U);
+    R[1] = (uint8_t)((rows[0] >> 13) & 1U);
+    R[2] = (uint8_t)((rows[0] >> 14) & 1U);
+    return hamming_irrecoverable_error_nb;
 }
 
 /*
@@ -135,19 +176,42 @@ bptc_196x96_extract_payload_and_r(uint8_t matrix[13][15], uint8_t extracted[96],
  */
 uint32_t
 BPTC_196x96_Extract_Data(uint8_t InputDeInteleavedData[196], uint8_t DMRDataExtracted[96], uint8_t R[3]) {
-    uint8_t DataMatrix[13][15];
-    bptc_196x96_fill_matrix(InputDeInteleavedData, DataMatrix);
-    (void)bptc_196x96_decode_rows(DataMatrix);
-    (void)bptc_196x96_decode_cols(DataMatrix);
-
-    uint32_t hamming_irrecoverable_error_nb = 0;
-    hamming_irrecoverable_error_nb += bptc_196x96_decode_rows(DataMatrix);
-    hamming_irrecoverable_error_nb += bptc_196x96_decode_cols(DataMatrix);
-
-    bptc_196x96_extract_payload_and_r(DataMatrix, DMRDataExtracted, R);
-    return hamming_irrecoverable_error_nb;
+    uint16_t rows[13];
+    uint32_t k = 1;
+    for (uint32_t i = 0; i < 13; i++) {
+        unsigned int word = 0;
+        for (uint32_t j = 0; j < 15; j++) {
+            word = (word << 1) | (InputDeInteleavedData[k++] & 1U);
+        }
+        rows[i] = (uint16_t)word;
+    }
+    return bptc_196x96_decode_packed(rows, DMRDataExtracted, R);
 } /* End BPTC_196x96_Extract_Data() */
 
+/*
+ * @brief : Deinterleave and decode a BPTC (196,96) block in one pass, reading
+ *          the interleaved bits straight into the packed matrix
+ *
+ * @param InputInterleavedData : Pointer of DMR input data interleaved (196 bytes)
+ *
+ * @param DMRDataExtracted : Pointer where the DMR data will be written (96 bytes)
+ *
+ * @return The total number of irrecoverable Hamming check errors
+ */
+uint32_t
+BPTC_196x96_Decode(const uint8_t InputInterleavedData[196], uint8_t DMRDataExtracted[96], uint8_t R[3]) {
+    uint16_t rows[13];
+    const uint8_t* source = bptc_196x96_source_index;
+    for (uint32_t i = 0; i < 13; i++) {
+        unsigned int word = 0;
+        for (uint32_t j = 0; j < 15; j++) {
+            word = (word << 1) | (InputInterleavedData[*source++] & 1U);
+        }
+        rows[i] = (uint16_t)word;
+    }
+    return bptc_196x96_decode_packed(rows, DMRDataExtracted, R);
+} /* End BPTC_196x96_Decode() */
+
 /*
  * @brief : This function extract the 77 bits of a deinteleaved 128 bits
  *          buffer using BPTC (128,77).
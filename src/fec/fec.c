@@ -17,74 +17,65 @@
 
 #include <dsd-neo/fec/block_codes.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include "dsd-neo/core/safe_api.h"
 
+// Syndromes are the XOR of the parity check columns of the set bits, first row in the most significant bit.
+static unsigned int
+fec_syndrome(const unsigned char* bits, const uint16_t* columns, int n) {
+    unsigned int syndrome = 0;
+    for (int i = 0; i < n; i++) {
+        syndrome ^= columns[i] & (0U - (unsigned int)(bits[i] & 1U));
+    }
+    return syndrome;
+}
+
 static unsigned char Hamming_7_4_m_corr[8]; //!< single bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char Hamming_7_4_m_H[7 * 3] = {
-    1, 1, 1, 0, 1, 0, 0, 0, 1, 1, 1,
-    0, 1, 0, 1, 1, 0, 1, 0, 0, 1
-    //      0  1  2  3 <- correctable bit positions
-};
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Hamming_7_4_m_Hcol[7] = {0x5, 0x7, 0x6, 0x3, 0x4, 0x2, 0x1};
 
 // ========================================================================================
 
 static unsigned char Hamming_12_8_m_corr[16]; //!< single bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char Hamming_12_8_m_H[12 * 4] = {
-    1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 1,
-    1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1
-    //      0  1  2  3  4  5  6  7 <- correctable bit positions
-};
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Hamming_12_8_m_Hcol[12] = {0xE, 0x7, 0xA, 0x5, 0xB, 0xC, 0x6, 0x3, 0x8, 0x4, 0x2, 0x1};
 
 // ========================================================================================
 
 static unsigned char Hamming_13_9_m_corr[16]; //!< single bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char Hamming_13_9_m_H[13 * 4] = {
-    1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0,
-    1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1,
-    //      0  1  2  3  4  5  6  7  8  <- correctable bit positions
-};
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Hamming_13_9_m_Hcol[13] = {0xF, 0xE, 0x7, 0xA, 0x5, 0xB, 0xC, 0x6, 0x3, 0x8, 0x4, 0x2, 0x1};
 
 // ========================================================================================
 
 static unsigned char Hamming_15_11_m_corr[16]; //!< single bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char Hamming_15_11_m_H[15 * 4] = {
-    1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0,
-    0, 0, 1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 1,
-    //      0  1  2  3  4  5  6  7  8  9 10  <- correctable bit positions
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Hamming_15_11_m_Hcol[15] = {
+    0x9, 0xD, 0xF, 0xE, 0x7, 0xA, 0x5, 0xB, 0xC, 0x6, 0x3, 0x8, 0x4, 0x2, 0x1,
 };
 
 // ========================================================================================
 
 static unsigned char Hamming_16_11_4_m_corr[32]; //!< single bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char Hamming_16_11_4_m_H[16 * 5] = {1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 1,
-                                                          1, 0, 1, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1,
-                                                          0, 1, 1, 0, 0, 1, 0, 0, 1, 1, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
-                                                          0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1};
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Hamming_16_11_4_m_Hcol[16] = {
+    0x13, 0x1A, 0x1F, 0x1C, 0x0E, 0x15, 0x0B, 0x16, 0x19, 0x0D, 0x07, 0x10, 0x08, 0x04, 0x02, 0x01,
+};
 
 // ========================================================================================
 
 static unsigned char Golay_20_8_m_corr[4096][3]; //!< up to 3 bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char Golay_20_8_m_H[20 * 12] = {
-    0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0,
-    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1,
-    0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
-    1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0,
-    0, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Golay_20_8_m_Hcol[20] = {
+    0x3DA, 0xD99, 0x6CD, 0x367, 0xDC6, 0xA97, 0x93E, 0x8EB, 0x800, 0x400,
+    0x200, 0x100, 0x080, 0x040, 0x020, 0x010, 0x008, 0x004, 0x002, 0x001,
 };
 
 // ========================================================================================
@@ -103,28 +94,20 @@ static const unsigned char Golay_24_12_m_G[24 * 12] = {
     1, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 1,
 };
 
-//!< Parity check matrix of bits
-static const unsigned char Golay_24_12_m_H[24 * 12] = {
-    1, 0, 1, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0,
-    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 1, 1, 0, 1,
-    0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
-    1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0,
-    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0,
-    1, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1, 1, 1, 1,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t Golay_24_12_m_Hcol[24] = {
+    0xC75, 0x63B, 0xF68, 0x7B4, 0x3DA, 0xD99, 0x6CD, 0x367, 0xDC6, 0xA97, 0x93E, 0x8EB,
+    0x800, 0x400, 0x200, 0x100, 0x080, 0x040, 0x020, 0x010, 0x008, 0x004, 0x002, 0x001,
 };
 
 // ========================================================================================
 
 static unsigned char QR_16_7_6_m_corr[512][2]; //!< up to 2 bit error correction by syndrome index
 
-//!< Parity check matrix of bits
-static const unsigned char QR_16_7_6_m_H[16 * 9] = {
-    0, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1,
-    1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 1, 0,
-    0, 0, 0, 1, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0,
-    0, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+//!< Parity check matrix, one column (syndrome contribution) per codeword bit
+static const uint16_t QR_16_7_6_m_Hcol[16] = {
+    0x04F, 0x11E, 0x1B7, 0x1E2, 0x1C9, 0x0E5, 0x073, 0x100,
+    0x080, 0x040, 0x020, 0x010, 0x008, 0x004, 0x002, 0x001,
 };
 
 // ========================================================================================
@@ -145,16 +128,7 @@ Hamming_7_4_init(void) {
 bool
 Hamming_7_4_decode(unsigned char* rxBits) // corrects in place
 {
-    unsigned int syndromeI = 0; // syndrome index
-
-    for (int is = 0; is < 3; is++) {
-        syndromeI += (((rxBits[0] * Hamming_7_4_m_H[7 * is + 0]) + (rxBits[1] * Hamming_7_4_m_H[7 * is + 1])
-                       + (rxBits[2] * Hamming_7_4_m_H[7 * is + 2]) + (rxBits[3] * Hamming_7_4_m_H[7 * is + 3])
-                       + (rxBits[4] * Hamming_7_4_m_H[7 * is + 4]) + (rxBits[5] * Hamming_7_4_m_H[7 * is + 5])
-                       + (rxBits[6] * Hamming_7_4_m_H[7 * is + 6]))
-                      % 2)
-                     << (2 - is);
-    }
+    unsigned int syndromeI = fec_syndrome(rxBits, Hamming_7_4_m_Hcol, 7); // syndrome index
 
     if (syndromeI > 0) {
         if (Hamming_7_4_m_corr[syndromeI] == 0xFF) {
@@ -193,24 +167,7 @@ Hamming_12_8_decode(unsigned char* rxBits, unsigned char* decodedBits, int nbCod
     for (int ic = 0; ic < nbCodewords; ic++) {
         // calculate syndrome
 
-        int syndromeI = 0; // syndrome index
-
-        for (int is = 0; is < 4; is++) {
-            syndromeI += (((rxBits[12 * ic + 0] * Hamming_12_8_m_H[12 * is + 0])
-                           + (rxBits[12 * ic + 1] * Hamming_12_8_m_H[12 * is + 1])
-                           + (rxBits[12 * ic + 2] * Hamming_12_8_m_H[12 * is + 2])
-                           + (rxBits[12 * ic + 3] * Hamming_12_8_m_H[12 * is + 3])
-                           + (rxBits[12 * ic + 4] * Hamming_12_8_m_H[12 * is + 4])
-                           + (rxBits[12 * ic + 5] * Hamming_12_8_m_H[12 * is + 5])
-                           + (rxBits[12 * ic + 6] * Hamming_12_8_m_H[12 * is + 6])
-                           + (rxBits[12 * ic + 7] * Hamming_12_8_m_H[12 * is + 7])
-                           + (rxBits[12 * ic + 8] * Hamming_12_8_m_H[12 * is + 8])
-                           + (rxBits[12 * ic + 9] * Hamming_12_8_m_H[12 * is + 9])
-                           + (rxBits[12 * ic + 10] * Hamming_12_8_m_H[12 * is + 10])
-                           + (rxBits[12 * ic + 11] * Hamming_12_8_m_H[12 * is + 11]))
-                          % 2)
-                         << (3 - is);
-        }
+        unsigned int syndromeI = fec_syndrome(&rxBits[12 * ic], Hamming_12_8_m_Hcol, 12); // syndrome index
 
         // correct bit
 
@@ -259,25 +216,7 @@ Hamming_13_9_decode(unsigned char* rxBits, unsigned char* decodedBits, int nbCod
     for (int ic = 0; ic < nbCodewords; ic++) {
         // calculate syndrome
 
-        int syndromeI = 0; // syndrome index
-
-        for (int is = 0; is < 4; is++) {
-            syndromeI += (((rxBits[13 * ic + 0] * Hamming_13_9_m_H[13 * is + 0])
-                           + (rxBits[13 * ic + 1] * Hamming_13_9_m_H[13 * is + 1])
-                           + (rxBits[13 * ic + 2] * Hamming_13_9_m_H[13 * is + 2])
-                           + (rxBits[13 * ic + 3] * Hamming_13_9_m_H[13 * is + 3])
-                           + (rxBits[13 * ic + 4] * Hamming_13_9_m_H[13 * is + 4])
-                           + (rxBits[13 * ic + 5] * Hamming_13_9_m_H[13 * is + 5])
-                           + (rxBits[13 * ic + 6] * Hamming_13_9_m_H[13 * is + 6])
-                           + (rxBits[13 * ic + 7] * Hamming_13_9_m_H[13 * is + 7])
-                           + (rxBits[13 * ic + 8] * Hamming_13_9_m_H[13 * is + 8])
-                           + (rxBits[13 * ic + 9] * Hamming_13_9_m_H[13 * is + 9])
-                           + (rxBits[13 * ic + 10] * Hamming_13_9_m_H[13 * is + 10])
-                           + (rxBits[13 * ic + 11] * Hamming_13_9_m_H[13 * is + 11])
-                           + (rxBits[13 * ic + 12] * Hamming_13_9_m_H[13 * is + 12]))
-                          % 2)
-                         << (3 - is);
-        }
+        unsigned int syndromeI = fec_syndrome(&rxBits[13 * ic], Hamming_13_9_m_Hcol, 13); // syndrome index
 
         // correct bit
 
@@ -331,27 +270,7 @@ Hamming_15_11_decode(unsigned char* rxBits, unsigned char* decodedBits, int nbCo
     for (int ic = 0; ic < nbCodewords; ic++) {
         // calculate syndrome
 
-        int syndromeI = 0; // syndrome index
-
-        for (int is = 0; is < 4; is++) {
-            syndromeI += (((rxBits[15 * ic + 0] * Hamming_15_11_m_H[15 * is + 0])
-                           + (rxBits[15 * ic + 1] * Hamming_15_11_m_H[15 * is + 1])
-                           + (rxBits[15 * ic + 2] * Hamming_15_11_m_H[15 * is + 2])
-                           + (rxBits[15 * ic + 3] * Hamming_15_11_m_H[15 * is + 3])
-                           + (rxBits[15 * ic + 4] * Hamming_15_11_m_H[15 * is + 4])
-                           + (rxBits[15 * ic + 5] * Hamming_15_11_m_H[15 * is + 5])
-                           + (rxBits[15 * ic + 6] * Hamming_15_11_m_H[15 * is + 6])
-                           + (rxBits[15 * ic + 7] * Hamming_15_11_m_H[15 * is + 7])
-                           + (rxBits[15 * ic + 8] * Hamming_15_11_m_H[15 * is + 8])
-                           + (rxBits[15 * ic + 9] * Hamming_15_11_m_H[15 * is + 9])
-                           + (rxBits[15 * ic + 10] * Hamming_15_11_m_H[15 * is + 10])
-                           + (rxBits[15 * ic + 11] * Hamming_15_11_m_H[15 * is + 11])
-                           + (rxBits[15 * ic + 12] * Hamming_15_11_m_H[15 * is + 12])
-                           + (rxBits[15 * ic + 13] * Hamming_15_11_m_H[15 * is + 13])
-                           + (rxBits[15 * ic + 14] * Hamming_15_11_m_H[15 * is + 14]))
-                          % 2)
-                         << (3 - is);
-        }
+        unsigned int syndromeI = fec_syndrome(&rxBits[15 * ic], Hamming_15_11_m_Hcol, 15); // syndrome index
 
         // correct bit
 
@@ -405,27 +324,7 @@ Hamming_16_11_4_decode(unsigned char* rxBits, unsigned char* decodedBits, int nb
 
     for (int ic = 0; ic < nbCodewords; ic++) {
         // calculate syndrome
-        int syndromeI = 0; // syndrome index
-        for (int is = 0; is < 5; is++) {
-            syndromeI += (((rxBits[16 * ic + 0] * Hamming_16_11_4_m_H[16 * is + 0])
-                           + (rxBits[16 * ic + 1] * Hamming_16_11_4_m_H[16 * is + 1])
-                           + (rxBits[16 * ic + 2] * Hamming_16_11_4_m_H[16 * is + 2])
-                           + (rxBits[16 * ic + 3] * Hamming_16_11_4_m_H[16 * is + 3])
-                           + (rxBits[16 * ic + 4] * Hamming_16_11_4_m_H[16 * is + 4])
-                           + (rxBits[16 * ic + 5] * Hamming_16_11_4_m_H[16 * is + 5])
-                           + (rxBits[16 * ic + 6] * Hamming_16_11_4_m_H[16 * is + 6])
-                           + (rxBits[16 * ic + 7] * Hamming_16_11_4_m_H[16 * is + 7])
-                           + (rxBits[16 * ic + 8] * Hamming_16_11_4_m_H[16 * is + 8])
-                           + (rxBits[16 * ic + 9] * Hamming_16_11_4_m_H[16 * is + 9])
-                           + (rxBits[16 * ic + 10] * Hamming_16_11_4_m_H[16 * is + 10])
-                           + (rxBits[16 * ic + 11] * Hamming_16_11_4_m_H[16 * is + 11])
-                           + (rxBits[16 * ic + 12] * Hamming_16_11_4_m_H[16 * is + 12])
-                           + (rxBits[16 * ic + 13] * Hamming_16_11_4_m_H[16 * is + 13])
-                           + (rxBits[16 * ic + 14] * Hamming_16_11_4_m_H[16 * is + 14])
-                           + (rxBits[16 * ic + 15] * Hamming_16_11_4_m_H[16 * is + 15]))
-                          % 2)
-                         << (4 - is);
-        }
+        unsigned int syndromeI = fec_syndrome(&rxBits[16 * ic], Hamming_16_11_4_m_Hcol, 16); // syndrome index
 
         // correct bit
 
@@ -457,14 +356,7 @@ Golay_20_8_init(void) {
         for (int i2 = i1 + 1; i2 < 8; i2++) {
             for (int i3 = i2 + 1; i3 < 8; i3++) {
                 // 3 bit patterns
-                int syndromeI = 0;
-
-                for (int ir = 0; ir < 12; ir++) {
-                    syndromeI +=
-                        ((Golay_20_8_m_H[20 * ir + i1] + Golay_20_8_m_H[20 * ir + i2] + Golay_20_8_m_H[20 * ir + i3])
-                         % 2)
-                        << (11 - ir);
-                }
+                unsigned int syndromeI = Golay_20_8_m_Hcol[i1] ^ Golay_20_8_m_Hcol[i2] ^ Golay_20_8_m_Hcol[i3];
 
                 Golay_20_8_m_corr[syndromeI][0] = i1;
                 Golay_20_8_m_corr[syndromeI][1] = i2;
@@ -472,11 +364,7 @@ Golay_20_8_init(void) {
             }
 
             // 2 bit patterns
-            int syndromeI = 0;
-
-            for (int ir = 0; ir < 12; ir++) {
-                syndromeI += ((Golay_20_8_m_H[20 * ir + i1] + Golay_20_8_m_H[20 * ir + i2]) % 2) << (11 - ir);
-            }
+            unsigned int syndromeI = Golay_20_8_m_Hcol[i1] ^ Golay_20_8_m_Hcol[i2];
 
             Golay_20_8_m_corr[syndromeI][0] = i1;
             Golay_20_8_m_corr[syndromeI][1] = i2;
@@ -491,11 +379,7 @@ Golay_20_8_init(void) {
         }
 
         // single bit patterns
-        int syndromeI = 0;
-
-        for (int ir = 0; ir < 12; ir++) {
-            syndromeI += Golay_20_8_m_H[20 * ir + i1] << (11 - ir);
-        }
+        unsigned int syndromeI = Golay_20_8_m_Hcol[i1];
 
         Golay_20_8_m_corr[syndromeI][0] = i1;
 
@@ -541,22 +425,7 @@ Golay_20_8_init(void) {
 // Golay (20,8) has Hamming weight 6 and reliably corrects at most two bit errors.
 bool
 Golay_20_8_decode(unsigned char* rxBits) {
-    unsigned int syndromeI = 0; // syndrome index
-
-    for (int is = 0; is < 12; is++) {
-        syndromeI += (((rxBits[0] * Golay_20_8_m_H[20 * is + 0]) + (rxBits[1] * Golay_20_8_m_H[20 * is + 1])
-                       + (rxBits[2] * Golay_20_8_m_H[20 * is + 2]) + (rxBits[3] * Golay_20_8_m_H[20 * is + 3])
-                       + (rxBits[4] * Golay_20_8_m_H[20 * is + 4]) + (rxBits[5] * Golay_20_8_m_H[20 * is + 5])
-                       + (rxBits[6] * Golay_20_8_m_H[20 * is + 6]) + (rxBits[7] * Golay_20_8_m_H[20 * is + 7])
-                       + (rxBits[8] * Golay_20_8_m_H[20 * is + 8]) + (rxBits[9] * Golay_20_8_m_H[20 * is + 9])
-                       + (rxBits[10] * Golay_20_8_m_H[20 * is + 10]) + (rxBits[11] * Golay_20_8_m_H[20 * is + 11])
-                       + (rxBits[12] * Golay_20_8_m_H[20 * is + 12]) + (rxBits[13] * Golay_20_8_m_H[20 * is + 13])
-                       + (rxBits[14] * Golay_20_8_m_H[20 * is + 14]) + (rxBits[15] * Golay_20_8_m_H[20 * is + 15])
-                       + (rxBits[16] * Golay_20_8_m_H[20 * is + 16]) + (rxBits[17] * Golay_20_8_m_H[20 * is + 17])
-                       + (rxBits[18] * Golay_20_8_m_H[20 * is + 18]) + (rxBits[19] * Golay_20_8_m_H[20 * is + 19]))
-                      % 2)
-                     << (11 - is);
-    }
+    unsigned int syndromeI = fec_syndrome(rxBits, Golay_20_8_m_Hcol, 20); // syndrome index
 
     if (syndromeI > 0) {
         int i = 0;
@@ -596,14 +465,7 @@ Golay_24_12_init(void) {
         for (int i2 = i1 + 1; i2 < 12; i2++) {
             for (int i3 = i2 + 1; i3 < 12; i3++) {
                 // 3 bit patterns
-                int syndromeI = 0;
-
-                for (int ir = 0; ir < 12; ir++) {
-                    syndromeI +=
-                        ((Golay_24_12_m_H[24 * ir + i1] + Golay_24_12_m_H[24 * ir + i2] + Golay_24_12_m_H[24 * ir + i3])
-                         % 2)
-                        << (11 - ir);
-                }
+                unsigned int syndromeI = Golay_24_12_m_Hcol[i1] ^ Golay_24_12_m_Hcol[i2] ^ Golay_24_12_m_Hcol[i3];
 
                 Golay_24_12_m_corr[syndromeI][0] = i1;
                 Golay_24_12_m_corr[syndromeI][1] = i2;
@@ -611,11 +473,7 @@ Golay_24_12_init(void) {
             }
 
             // 2 bit patterns
-            int syndromeI = 0;
-
-            for (int ir = 0; ir < 12; ir++) {
-                syndromeI += ((Golay_24_12_m_H[24 * ir + i1] + Golay_24_12_m_H[24 * ir + i2]) % 2) << (11 - ir);
-            }
+            unsigned int syndromeI = Golay_24_12_m_Hcol[i1] ^ Golay_24_12_m_Hcol[i2];
 
             Golay_24_12_m_corr[syndromeI][0] = i1;
             Golay_24_12_m_corr[syndromeI][1] = i2;
@@ -630,11 +488,7 @@ Golay_24_12_init(void) {
         }
 
         // single bit patterns
-        int syndromeI = 0;
-
-        for (int ir = 0; ir < 12; ir++) {
-            syndromeI += Golay_24_12_m_H[24 * ir + i1] << (11 - ir);
-        }
+        unsigned int syndromeI = Golay_24_12_m_Hcol[i1];
 
         Golay_24_12_m_corr[syndromeI][0] = i1;
 
@@ -694,24 +548,7 @@ Golay_24_12_encode(const unsigned char* origBits, unsigned char* encodedBits) {
 
 bool
 Golay_24_12_decode(unsigned char* rxBits) {
-    unsigned int syndromeI = 0; // syndrome index
-
-    for (int is = 0; is < 12; is++) {
-        syndromeI += (((rxBits[0] * Golay_24_12_m_H[24 * is + 0]) + (rxBits[1] * Golay_24_12_m_H[24 * is + 1])
-                       + (rxBits[2] * Golay_24_12_m_H[24 * is + 2]) + (rxBits[3] * Golay_24_12_m_H[24 * is + 3])
-                       + (rxBits[4] * Golay_24_12_m_H[24 * is + 4]) + (rxBits[5] * Golay_24_12_m_H[24 * is + 5])
-                       + (rxBits[6] * Golay_24_12_m_H[24 * is + 6]) + (rxBits[7] * Golay_24_12_m_H[24 * is + 7])
-                       + (rxBits[8] * Golay_24_12_m_H[24 * is + 8]) + (rxBits[9] * Golay_24_12_m_H[24 * is + 9])
-                       + (rxBits[10] * Golay_24_12_m_H[24 * is + 10]) + (rxBits[11] * Golay_24_12_m_H[24 * is + 11])
-                       + (rxBits[12] * Golay_24_12_m_H[24 * is + 12]) + (rxBits[13] * Golay_24_12_m_H[24 * is + 13])
-                       + (rxBits[14] * Golay_24_12_m_H[24 * is + 14]) + (rxBits[15] * Golay_24_12_m_H[24 * is + 15])
-                       + (rxBits[16] * Golay_24_12_m_H[24 * is + 16]) + (rxBits[17] * Golay_24_12_m_H[24 * is + 17])
-                       + (rxBits[18] * Golay_24_12_m_H[24 * is + 18]) + (rxBits[19] * Golay_24_12_m_H[24 * is + 19])
-                       + (rxBits[20] * Golay_24_12_m_H[24 * is + 20]) + (rxBits[21] * Golay_24_12_m_H[24 * is + 21])
-                       + (rxBits[22] * Golay_24_12_m_H[24 * is + 22]) + (rxBits[23] * Golay_24_12_m_H[24 * is + 23]))
-                      % 2)
-                     << (11 - is);
-    }
+    unsigned int syndromeI = fec_syndrome(rxBits, Golay_24_12_m_Hcol, 24); // syndrome index
 
     if (syndromeI > 0) {
         int i = 0;
@@ -741,22 +578,14 @@ QR_16_7_6_init(void) {
     for (int i1 = 0; i1 < 7; i1++) {
         for (int i2 = i1 + 1; i2 < 7; i2++) {
             // 2 bit patterns
-            int syndromeI = 0;
-
-            for (int ir = 0; ir < 9; ir++) {
-                syndromeI += ((QR_16_7_6_m_H[16 * ir + i1] + QR_16_7_6_m_H[16 * ir + i2]) % 2) << (8 - ir);
-            }
+            unsigned int syndromeI = QR_16_7_6_m_Hcol[i1] ^ QR_16_7_6_m_Hcol[i2];
 
             QR_16_7_6_m_corr[syndromeI][0] = i1;
             QR_16_7_6_m_corr[syndromeI][1] = i2;
         }
 
         // single bit patterns
-        int syndromeI = 0;
-
-        for (int ir = 0; ir < 9; ir++) {
-            syndromeI += QR_16_7_6_m_H[16 * ir + i1] << (8 - ir);
-        }
+        unsigned int syndromeI = QR_16_7_6_m_Hcol[i1];
 
         QR_16_7_6_m_corr[syndromeI][0] = i1;
 
@@ -788,18 +617,7 @@ QR_16_7_6_decode(unsigned char* rxBits) {
     //2 bit errors or less
     unsigned int syndromeI = 0; // syndrome index
     int corrections = 0;
-    for (int is = 0; is < 9; is++) {
-        syndromeI += (((rxBits[0] * QR_16_7_6_m_H[16 * is + 0]) + (rxBits[1] * QR_16_7_6_m_H[16 * is + 1])
-                       + (rxBits[2] * QR_16_7_6_m_H[16 * is + 2]) + (rxBits[3] * QR_16_7_6_m_H[16 * is + 3])
-                       + (rxBits[4] * QR_16_7_6_m_H[16 * is + 4]) + (rxBits[5] * QR_16_7_6_m_H[16 * is + 5])
-                       + (rxBits[6] * QR_16_7_6_m_H[16 * is + 6]) + (rxBits[7] * QR_16_7_6_m_H[16 * is + 7])
-                       + (rxBits[8] * QR_16_7_6_m_H[16 * is + 8]) + (rxBits[9] * QR_16_7_6_m_H[16 * is + 9])
-                       + (rxBits[10] * QR_16_7_6_m_H[16 * is + 10]) + (rxBits[11] * QR_16_7_6_m_H[16 * is + 11])
-                       + (rxBits[12] * QR_16_7_6_m_H[16 * is + 12]) + (rxBits[13] * QR_16_7_6_m_H[16 * is + 13])
-                       + (rxBits[14] * QR_16_7_6_m_H[16 * is + 14]) + (rxBits[15] * QR_16_7_6_m_H[16 * is + 15]))
-                      % 2)
-                     << (8 - is);
-    }
+    syndromeI = fec_syndrome(rxBits, QR_16_7_6_m_Hcol, 16);
 
     if (syndromeI > 0) {
         int i = 0;
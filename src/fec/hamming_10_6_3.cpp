@@ -3,14 +3,16 @@
 
 namespace {
 
+/* Decode results for every 10-bit word, generated at compile time. */
 struct HammingTables {
-    int fixed_values[1024];
-    int error_counts[1024];
-
-    HammingTables();
+    unsigned char fixed_values[1024];
+    unsigned char error_counts[1024];
+    unsigned short codewords[64];
 };
 
-static int
+constexpr int k_bad_bit_table[16] = {-2, 0, 1, 5, 2, -1, -1, 6, 3, -1, -1, 7, 4, 8, 9, -1};
+
+constexpr int
 bit_parity(unsigned int value) {
     value ^= value >> 16U;
     value ^= value >> 8U;
@@ -19,45 +21,44 @@ bit_parity(unsigned int value) {
     return (int)((0x6996U >> value) & 1U);
 }
 
-static int
-compute_decode_result(int input, int* output) {
-    static const int bad_bit_table[16] = {-2, 0, 1, 5, 2, -1, -1, 6, 3, -1, -1, 7, 4, 8, 9, -1};
-    const unsigned int value = (unsigned int)input;
+constexpr int
+syndrome_of(unsigned int value) {
     const int s0 = bit_parity(value & 0x398U) << 3; // 1110011000
     const int s1 = bit_parity(value & 0x354U) << 2; // 1101010100
     const int s2 = bit_parity(value & 0x2E2U) << 1; // 1011100010
     const int s3 = bit_parity(value & 0x1E1U);      // 0111100001
-    const int syndrome = s0 | s1 | s2 | s3;
+    return s0 | s1 | s2 | s3;
+}
 
-    int corrected = input;
-    int error_count = 0;
-    if (syndrome != 0) {
-        const int bad_bit_index = bad_bit_table[syndrome];
-        if (bad_bit_index < 0) {
-            error_count = 2;
-        } else {
-            error_count = 1;
-            if (bad_bit_index >= 4) {
-                corrected ^= 1 << bad_bit_index;
+constexpr HammingTables
+make_hamming_tables() {
+    HammingTables t{};
+    for (unsigned int input = 0; input < 1024U; input++) {
+        const int syndrome = syndrome_of(input);
+        unsigned int corrected = input;
+        int error_count = 0;
+        if (syndrome != 0) {
+            const int bad_bit_index = k_bad_bit_table[syndrome];
+            if (bad_bit_index < 0) {
+                error_count = 2;
+            } else {
+                error_count = 1;
+                if (bad_bit_index >= 4) {
+                    corrected ^= 1U << bad_bit_index;
+                }
             }
         }
+        t.fixed_values[input] = (unsigned char)(corrected >> 4);
+        t.error_counts[input] = (unsigned char)error_count;
     }
-
-    *output = corrected >> 4;
-    return error_count;
-}
-
-HammingTables::HammingTables() {
-    for (int input = 0; input < 1024; input++) {
-        error_counts[input] = compute_decode_result(input, &fixed_values[input]);
+    /* The parity nibble is the syndrome of the data bits alone. */
+    for (unsigned int data = 0; data < 64U; data++) {
+        t.codewords[data] = (unsigned short)((data << 4) | (unsigned int)syndrome_of(data << 4));
     }
+    return t;
 }
 
-static const HammingTables&
-hamming_tables() {
-    static const HammingTables tables;
-    return tables;
-}
+constexpr HammingTables k_hamming_tables = make_hamming_tables();
 
 static int
 bits_to_int(const char* bits, int count) {
@@ -86,6 +87,20 @@ int_to_six_bits(int value, char* bits) {
 
 } // namespace
 
+extern "C" int
+hamming_10_6_3_decode_word(unsigned int codeword, unsigned int* data) {
+    codeword &= 0x3FFU;
+    if (data) {
+        *data = k_hamming_tables.fixed_values[codeword];
+    }
+    return k_hamming_tables.error_counts[codeword];
+}
+
+extern "C" unsigned int
+hamming_10_6_3_encode_word(unsigned int data) {
+    return k_hamming_tables.codewords[data & 0x3FU];
+}
+
 extern "C" int
 hamming_10_6_3_decode(char* data, const char* parity) {
     const int data_value = bits_to_int(data, 6);
@@ -94,12 +109,10 @@ hamming_10_6_3_decode(char* data, const char* parity) {
         return 2;
     }
 
-    const int input = (data_value << 4) | check;
-    const HammingTables& tables = hamming_tables();
-    const int fixed = tables.fixed_values[input];
-    const int error_count = tables.error_counts[input];
+    unsigned int fixed = 0;
+    const int error_count = hamming_10_6_3_decode_word(((unsigned int)data_value << 4) | (unsigned int)check, &fixed);
     if (error_count == 1) {
-        int_to_six_bits(fixed, data);
+        int_to_six_bits((int)fixed, data);
     }
     return error_count;
 }
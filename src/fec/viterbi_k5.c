@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * K=5 rate 1/2 Viterbi decoder with caller-owned state.
+ *
+ * Butterfly i joins predecessors i and i + 8 into successors 2i and 2i + 1.
+ * With only 16 states a whole trellis step is two 4-lane halves of 32-bit
+ * metrics, so SSE2 (baseline on x86-64) and NEON (baseline on AArch64) cover
+ * it without runtime dispatch. Ties resolve to the upper predecessor, like the
+ * scalar decoders this replaces, so decisions match them bit for bit.
+ */
+
+#include <dsd-neo/fec/viterbi_k5.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dsd-neo/core/safe_api.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSD_VITERBI_K5_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DSD_VITERBI_K5_NEON 1
+#include <arm_neon.h>
+#endif
+
+void
+dsd_viterbi_k5_reset(dsd_viterbi_k5* v, uint32_t branch_full) {
+    if (!v) {
+        return;
+    }
+    DSD_MEMSET(v->metrics, 0, sizeof(v->metrics));
+    v->branch_full = (branch_full > DSD_VITERBI_K5_MAX_BRANCH) ? DSD_VITERBI_K5_MAX_BRANCH : branch_full;
+    v->steps = 0;
+}
+
+#if !defined(DSD_VITERBI_K5_SSE2) && !defined(DSD_VITERBI_K5_NEON)
+/* Coded output (G1 << 1 | G2) on the input-0 branch leaving state i. */
+static const uint8_t k_viterbi_k5_output[DSD_VITERBI_K5_STATES / 2] = {0, 1, 1, 0, 2, 3, 3, 2};
+
+static uint16_t
+viterbi_k5_acs(uint32_t metrics[DSD_VITERBI_K5_STATES], const uint32_t bm[4], uint32_t full) {
+    uint32_t old[DSD_VITERBI_K5_STATES];
+    uint16_t decision = 0;
+    DSD_MEMCPY(old, metrics, sizeof(old));
+    for (int i = 0; i < DSD_VITERBI_K5_STATES / 2; i++) {
+        const uint32_t b = bm[k_viterbi_k5_output[i]];
+        const uint32_t c = full - b;
+        const uint32_t m0 = old[i] + b;
+        const uint32_t m1 = old[i + 8] + c;
+        const uint32_t m2 = old[i] + c;
+        const uint32_t m3 = old[i + 8] + b;
+        const uint16_t d0 = (m0 >= m1) ? 1U : 0U;
+        const uint16_t d1 = (m2 >= m3) ? 1U : 0U;
+        metrics[2 * i] = d0 ? m1 : m0;
+        metrics[(2 * i) + 1] = d1 ? m3 : m2;
+        decision |= (uint16_t)((d0 << (2 * i)) | (d1 << ((2 * i) + 1)));
+    }
+    return decision;
+}
+#elif defined(DSD_VITERBI_K5_SSE2)
+// NOLINTBEGIN(portability-simd-intrinsics)
+static inline __m128i
+viterbi_k5_select(__m128i take_first, __m128i first, __m128i second) {
+    return _mm_or_si128(_mm_and_si128(take_first, first), _mm_andnot_si128(take_first, second));
+}
+
+static uint16_t
+viterbi_k5_acs(uint32_t metrics[DSD_VITERBI_K5_STATES], const uint32_t bm[4], uint32_t full) {
+    /* Lanes follow the coded outputs of butterflies 0-3 and 4-7: {0, 1, 1, 0} and {2, 3, 3, 2}.
+     * Path metrics stay below 2^31, so the signed compare is exact. */
+    const __m128i b[2] = {_mm_setr_epi32((int)bm[0], (int)bm[1], (int)bm[1], (int)bm[0]),
+                          _mm_setr_epi32((int)bm[2], (int)bm[3], (int)bm[3], (int)bm[2])};
+    const __m128i fullv = _mm_set1_epi32((int)full);
+    const __m128i up[2] = {_mm_loadu_si128((const __m128i*)(const void*)&metrics[0]),
+                           _mm_loadu_si128((const __m128i*)(const void*)&metrics[4])};
+    const __m128i dn[2] = {_mm_loadu_si128((const __m128i*)(const void*)&metrics[8]),
+                           _mm_loadu_si128((const __m128i*)(const void*)&metrics[12])};
+    unsigned int survivors_low = 0U;
+    for (int h = 0; h < 2; h++) {
+        const __m128i c = _mm_sub_epi32(fullv, b[h]);
+        const __m128i m0 = _mm_add_epi32(up[h], b[h]);
+        const __m128i m1 = _mm_add_epi32(dn[h], c);
+        const __m128i m2 = _mm_add_epi32(up[h], c);
+        const __m128i m3 = _mm_add_epi32(dn[h], b[h]);
+        const __m128i keep0 = _mm_cmpgt_epi32(m1, m0);
+        const __m128i keep1 = _mm_cmpgt_epi32(m3, m2);
+        const __m128i even = viterbi_k5_select(keep0, m0, m1);
+        const __m128i odd = viterbi_k5_select(keep1, m2, m3);
+        _mm_storeu_si128((__m128i*)(void*)&metrics[8 * h], _mm_unpacklo_epi32(even, odd));
+        _mm_storeu_si128((__m128i*)(void*)&metrics[(8 * h) + 4], _mm_unpackhi_epi32(even, odd));
+        const int lo = _mm_movemask_ps(_mm_castsi128_ps(_mm_unpacklo_epi32(keep0, keep1)));
+        const int hi = _mm_movemask_ps(_mm_castsi128_ps(_mm_unpackhi_epi32(keep0, keep1)));
+        survivors_low |= ((unsigned int)lo | ((unsigned int)hi << 4)) << (8 * h);
+    }
+    return (uint16_t)(~survivors_low & 0xFFFFU);
+}
+// NOLINTEND(portability-simd-intrinsics)
+#else
+// NOLINTBEGIN(portability-simd-intrinsics)
+static uint16_t
+viterbi_k5_acs(uint32_t metrics[DSD_VITERBI_K5_STATES], const uint32_t bm[4], uint32_t full) {
+    static const uint32_t k_lane_bits[4] = {1U, 2U, 4U, 8U};
+    const uint32_t b_lanes[2][4] = {{bm[0], bm[1], bm[1], bm[0]}, {bm[2], bm[3], bm[3], bm[2]}};
+    const uint32x4_t lane_bits = vld1q_u32(k_lane_bits);
+    const uint32x4_t fullv = vdupq_n_u32(full);
+    const uint32x4_t up[2] = {vld1q_u32(&metrics[0]), vld1q_u32(&metrics[4])};
+    const uint32x4_t dn[2] = {vld1q_u32(&metrics[8]), vld1q_u32(&metrics[12])};
+    uint16_t decision = 0;
+    for (int h = 0; h < 2; h++) {
+        const uint32x4_t b = vld1q_u32(b_lanes[h]);
+        const uint32x4_t c = vsubq_u32(fullv, b);
+        const uint32x4_t m0 = vaddq_u32(up[h], b);
+        const uint32x4_t m1 = vaddq_u32(dn[h], c);
+        const uint32x4_t m2 = vaddq_u32(up[h], c);
+        const uint32x4_t m3 = vaddq_u32(dn[h], b);
+        const uint32x4_t take1 = vcgeq_u32(m0, m1);
+        const uint32x4_t take3 = vcgeq_u32(m2, m3);
+        const uint32x4x2_t next = vzipq_u32(vbslq_u32(take1, m1, m0), vbslq_u32(take3, m3, m2));
+        const uint32x4x2_t taken = vzipq_u32(take1, take3);
+        vst1q_u32(&metrics[8 * h], next.val[0]);
+        vst1q_u32(&metrics[(8 * h) + 4], next.val[1]);
+        const uint32_t lo = vaddvq_u32(vandq_u32(taken.val[0], lane_bits));
+        const uint32_t hi = vaddvq_u32(vandq_u32(taken.val[1], lane_bits));
+        decision |= (uint16_t)((lo | (hi << 4)) << (8 * h));
+    }
+    return decision;
+}
+// NOLINTEND(portability-simd-intrinsics)
+#endif
+
+int
+dsd_viterbi_k5_step(dsd_viterbi_k5* v, const uint32_t bm[4]) {
+    if (!v || !bm || v->steps >= (size_t)DSD_VITERBI_K5_MAX_STEPS) {
+        return -1;
+    }
+    const uint32_t full = v->branch_full;
+    uint32_t clamped[4];
+    for (int p = 0; p < 4; p++) {
+        clamped[p] = (bm[p] > full) ? full : bm[p];
+    }
+    v->decisions[v->steps++] = viterbi_k5_acs(v->metrics, clamped, full);
+    return 0;
+}
+
+uint32_t
+dsd_viterbi_k5_best_metric(const dsd_viterbi_k5* v) {
+    if (!v) {
+        return UINT32_MAX;
+    }
+    uint32_t best = v->metrics[0];
+    for (int s = 1; s < DSD_VITERBI_K5_STATES; s++) {
+        if (v->metrics[s] < best) {
+            best = v->metrics[s];
+        }
+    }
+    return best;
+}
+
+size_t
+dsd_viterbi_k5_traceback(const dsd_viterbi_k5* v, uint8_t* bits, size_t count) {
+    if (!v || !bits) {
+        return 0;
+    }
+    if (count > v->steps) {
+        count = v->steps;
+    }
+    /* The top four bits of the 8-bit register hold the 16-state index. */
+    unsigned int state = 0U;
+    size_t step = v->steps;
+    for (size_t j = count; j-- > 0;) {
+        step--;
+        const unsigned int bit = ((unsigned int)v->decisions[step] >> (state >> 4)) & 1U;
+        state = (bit << 7) | (state >> 1);
+        bits[j] = (uint8_t)bit;
+    }
+    return count;
+}
@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Polyphase channelizer filterbank.
+ *
+ * The bank knows nothing about the stream; it turns capture-rate I/Q into the
+ * requested bank channels and leaves it to its owner where they go.
+ */
+
+#include <cmath>
+#include <dsd-neo/dsp/firdes.h>
+#include <dsd-neo/runtime/mem.h>
+#include <initializer_list>
+#include <stdint.h>
+#include <string.h>
+
+#include "rtl_channelizer.h"
+
+namespace dsd_io {
+
+namespace {
+
+constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+/* Pairs the delay line holds beyond one prototype length. Larger means fewer
+ * compactions (one memmove of a prototype's worth of history per chunk). */
+constexpr int kHistChunkPairs = 8192;
+
+/* Prototype cutoff, in channel spacings. The passband has to reach past half a
+ * spacing: a channel up to half a spacing off the grid is shifted to DC only
+ * after the bank, so its far edge arrives at about 0.85 of a spacing. The
+ * transition width then follows from the prototype length, and has to close
+ * before the first image of that edge folds back in at the 2x-oversampled
+ * output rate. */
+constexpr double kCutoffSpacings = 1.0;
+
+bool
+fft_size_ok(int n) {
+    if (n < 16 || (n % 16) != 0) {
+        return false;
+    }
+    int r = n / 16;
+    for (int p : {2, 3, 5}) {
+        while (r % p == 0) {
+            r /= p;
+        }
+    }
+    return r == 1;
+}
+
+float*
+alloc_floats(size_t n) {
+    float* p = static_cast<float*>(dsd_neo_aligned_malloc(n * sizeof(float)));
+    if (p != nullptr) {
+        memset(p, 0, n * sizeof(float));
+    }
+    return p;
+}
+
+} // namespace
+
+PolyphaseChannelizer::~PolyphaseChannelizer() { release(); }
+
+void
+PolyphaseChannelizer::release() {
+    dsd_neo_aligned_free(m_taps);
+    dsd_neo_aligned_free(m_hist);
+    dsd_neo_aligned_free(m_work);
+    dsd_neo_aligned_free(m_twiddle);
+    m_taps = nullptr;
+    m_hist = nullptr;
+    m_work = nullptr;
+    m_twiddle = nullptr;
+    m_m = 0;
+    m_taps_per_branch = 0;
+    m_hist_cap = 0;
+    m_hist_end = 0;
+}
+
+bool
+PolyphaseChannelizer::configure(int num_channels, int taps_per_branch) {
+    if (m_m != 0 && m_m == num_channels && m_taps_per_branch == taps_per_branch) {
+        return true;
+    }
+    release();
+    if (!fft_size_ok(num_channels) || taps_per_branch < 1 || taps_per_branch > 64) {
+        return false;
+    }
+    const int m = num_channels;
+    const int len = m * taps_per_branch;
+    m_taps = alloc_floats(static_cast<size_t>(len));
+    m_work = alloc_floats(static_cast<size_t>(2 * m));
+    m_twiddle = alloc_floats(static_cast<size_t>(2 * m));
+    m_hist_cap = len + kHistChunkPairs;
+    m_hist = alloc_floats(static_cast<size_t>(2 * m_hist_cap));
+    float* proto = alloc_floats(static_cast<size_t>(len));
+    if (m_taps == nullptr || m_work == nullptr || m_twiddle == nullptr || m_hist == nullptr || proto == nullptr) {
+        dsd_neo_aligned_free(proto);
+        release();
+        return false;
+    }
+
+    /* Windowed sinc in units of one channel spacing (sample rate == M). Built
+     * here rather than through dsd_firdes_low_pass(): the prototype spans the
+     * whole bank, which is far longer than that helper's stack window allows. */
+    const int ntaps = len - 1; /* odd, so the sinc is centred on a sample */
+    dsd_window_build(DSD_WIN_BLACKMAN, ntaps, proto);
+    const double fc = kCutoffSpacings / static_cast<double>(m);
+    const int mid = (ntaps - 1) / 2;
+    double sum = 0.0;
+    for (int n = 0; n < ntaps; n++) {
+        const int k = n - mid;
+        const double sinc = (k == 0) ? (2.0 * fc) : (std::sin(kTwoPi * fc * k) / (M_PI * k));
+        proto[n] = static_cast<float>(sinc * proto[n]);
+        sum += proto[n];
+    }
+    proto[len - 1] = 0.0f;
+    const float norm = (sum != 0.0) ? static_cast<float>(1.0 / sum) : 1.0f;
+
+    /* Branch m of tap t is proto[t*M + m]. Stored reversed within each branch
+     * so run_step() walks taps and history in the same direction, which is what
+     * lets the inner loop vectorise. */
+    for (int t = 0; t < taps_per_branch; t++) {
+        for (int j = 0; j < m; j++) {
+            m_taps[t * m + j] = proto[t * m + (m - 1 - j)] * norm;
+        }
+    }
+    dsd_neo_aligned_free(proto);
+
+    for (int p = 0; p < m; p++) {
+        const double w = -kTwoPi * static_cast<double>(p) / static_cast<double>(m);
+        m_twiddle[2 * p] = static_cast<float>(std::cos(w));
+        m_twiddle[2 * p + 1] = static_cast<float>(std::sin(w));
+    }
+    m_m = m;
+    m_taps_per_branch = taps_per_branch;
+    reset();
+    return true;
+}
+
+void
+PolyphaseChannelizer::reset() {
+    if (m_hist == nullptr) {
+        return;
+    }
+    const int len = m_m * m_taps_per_branch;
+    memset(m_hist, 0, static_cast<size_t>(2 * m_hist_cap) * sizeof(float));
+    /* Start with a prototype's worth of zeros so the first step has history. */
+    m_hist_end = len;
+    m_phase = 0;
+    m_time_mod = 0;
+}
+
+/*
+ * One output sample for every requested channel.
+ *
+ * Channel k at time N (N = samples consumed so far) is
+ *   z_k = sum_l h[l] x[N-1-l] e^{-j 2 pi k (N-1-l) / M},
+ * the input mixed down by k spacings and low-passed. Splitting l = m + t*M
+ * turns that into M branch sums y[m] followed by one M-point DFT; keeping the
+ * branches reversed (y'[j] = y[M-1-j]) makes that a forward transform, and the
+ * leftover e^{-j 2 pi k N / M} keeps every channel's phase continuous from one
+ * step to the next.
+ */
+void
+PolyphaseChannelizer::run_step(const int* channels, int n_channels, float* const* out, int out_index) {
+    const int m = m_m;
+    float* y = m_work;
+    memset(y, 0, static_cast<size_t>(2 * m) * sizeof(float));
+    for (int t = 0; t < m_taps_per_branch; t++) {
+        const float* h = m_taps + static_cast<size_t>(t) * m;
+        const float* x = m_hist + static_cast<size_t>(2) * (m_hist_end - (t + 1) * m);
+        for (int j = 0; j < m; j++) {
+            y[2 * j] += h[j] * x[2 * j];
+            y[2 * j + 1] += h[j] * x[2 * j + 1];
+        }
+    }
+    if (!m_fft.forward(m, y)) {
+        return;
+    }
+    for (int c = 0; c < n_channels; c++) {
+        const int k = channels[c];
+        const int p = static_cast<int>((static_cast<int64_t>(k) * m_time_mod) % m);
+        const float yr = y[2 * k];
+        const float yi = y[2 * k + 1];
+        const float tr = m_twiddle[2 * p];
+        const float ti = m_twiddle[2 * p + 1];
+        float* o = out[c] + static_cast<size_t>(2) * out_index;
+        o[0] = yr * tr - yi * ti;
+        o[1] = yr * ti + yi * tr;
+    }
+}
+
+int
+PolyphaseChannelizer::process(const float* iq_interleaved, int pairs, const int* channels, int n_channels,
+                              float* const* out, int out_capacity_pairs) {
+    if (m_m == 0 || iq_interleaved == nullptr || pairs < 0 || n_channels < 0 || n_channels > kMaxOutputs
+        || (n_channels > 0 && (channels == nullptr || out == nullptr)) || out_capacity_pairs < 0) {
+        return -1;
+    }
+    for (int c = 0; c < n_channels; c++) {
+        if (channels[c] < 0 || channels[c] >= m_m || out[c] == nullptr) {
+            return -1;
+        }
+    }
+    const int d = decimation();
+    const int len = m_m * m_taps_per_branch;
+    int produced = 0;
+    int consumed = 0;
+    while (consumed < pairs) {
+        int take = d - m_phase;
+        if (take > pairs - consumed) {
+            take = pairs - consumed;
+        }
+        if (m_phase + take == d && produced >= out_capacity_pairs) {
+            break; /* the step this would complete has nowhere to go */
+        }
+        if (m_hist_end + take > m_hist_cap) {
+            /* Keep the newest prototype length; everything older is dead. */
+            memmove(m_hist, m_hist + static_cast<size_t>(2) * (m_hist_end - len),
+                    static_cast<size_t>(2 * len) * sizeof(float));
+            m_hist_end = len;
+        }
+        memcpy(m_hist + static_cast<size_t>(2) * m_hist_end, iq_interleaved + static_cast<size_t>(2) * consumed,
+               static_cast<size_t>(2 * take) * sizeof(float));
+        m_hist_end += take;
+        consumed += take;
+        m_phase += take;
+        m_time_mod = (m_time_mod + take) % m_m;
+        if (m_phase == d) {
+            m_phase = 0;
+            run_step(channels, n_channels, out, produced);
+            produced++;
+        }
+    }
+    return produced;
+}
+
+int
+rtl_channelizer_pick_num_channels(uint32_t capture_rate_hz, uint32_t spacing_hz) {
+    if (capture_rate_hz == 0U || spacing_hz == 0U) {
+        return 0;
+    }
+    const uint32_t max_m = capture_rate_hz / spacing_hz;
+    for (int m = static_cast<int>(max_m - (max_m % 16U)); m >= 16; m -= 16) {
+        if (fft_size_ok(m)) {
+            return m;
+        }
+    }
+    return 0;
+}
+
+} // namespace dsd_io
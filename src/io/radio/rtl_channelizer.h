@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Polyphase FFT channelizer that splits a capture block into narrowband channels.
+ *
+ * One tuner covers a whole site's span, yet the demod chain only ever follows
+ * one channel of it. The channelizer is the stage between the two: it turns a
+ * capture-rate block into M equally spaced baseband channels in one pass, so a
+ * control channel and every voice grant inside the span can be followed at once
+ * without retuning.
+ *
+ * The filterbank is oversampled by two (decimation M/2), so each channel comes
+ * out at twice its spacing. That headroom is what lets a channel sitting up to
+ * half a spacing off the grid be shifted to DC afterwards without the shift
+ * walking it into the alias band — channel rasters are rarely a clean divisor of
+ * the capture rate, and a critically sampled bank would clip every off-grid
+ * channel at one edge.
+ *
+ * The transform goes through the same FftSetupCache the spectrum taps use, so
+ * this header does not name pffft either.
+ *
+ * No stream consumes the bank yet, so it is not part of dsd-neo_io_radio: only
+ * its unit test and the RTL bench compile it.
+ */
+
+#ifndef DSD_NEO_SRC_IO_RADIO_RTL_CHANNELIZER_H_
+#define DSD_NEO_SRC_IO_RADIO_RTL_CHANNELIZER_H_
+
+#include <stdint.h>
+
+#include "rtl_fft_cache.h"
+
+namespace dsd_io {
+
+/**
+ * @brief M-channel, 2x-oversampled polyphase analysis filterbank.
+ *
+ * Channel k is centred on k * rate / M (channels above M/2 are the negative
+ * offsets) and comes out at 2 * rate / M. Every channel carries a continuous
+ * phase reference across calls, so a consumer can demodulate it directly.
+ *
+ * Owned by one thread: process() keeps filter history between calls.
+ */
+class PolyphaseChannelizer {
+  public:
+    /** Most channels one process() call will extract. */
+    static constexpr int kMaxOutputs = 16;
+
+    PolyphaseChannelizer() = default;
+    ~PolyphaseChannelizer();
+    /* Owns aligned buffers and an FFT setup; a copy would double-free both. */
+    PolyphaseChannelizer(const PolyphaseChannelizer&) = delete;
+    PolyphaseChannelizer& operator=(const PolyphaseChannelizer&) = delete;
+
+    /**
+     * @brief Size the bank for @p num_channels channels.
+     *
+     * Designs the prototype low-pass, allocates the history, and clears all
+     * state. Cheap to call again with the same arguments (nothing is rebuilt).
+     *
+     * @param num_channels M; must be even and a size the FFT accepts
+     *                     (see rtl_channelizer_pick_num_channels()).
+     * @param taps_per_branch Prototype length divided by M.
+     * @return false when the size is rejected or allocation fails; the bank is
+     *         then unconfigured and process() produces nothing.
+     */
+    bool configure(int num_channels, int taps_per_branch);
+
+    /** @brief Drop filter history and restart the phase reference. */
+    void reset();
+
+    /** @brief Configured channel count, or 0 when unconfigured. */
+    int
+    num_channels() const {
+        return m_m;
+    }
+
+    /** @brief Input samples consumed per output sample (M/2). */
+    int
+    decimation() const {
+        return m_m >> 1;
+    }
+
+    /**
+     * @brief Channelize @p pairs complex samples.
+     *
+     * @param iq_interleaved Interleaved float I/Q at the capture rate.
+     * @param pairs Number of complex samples in @p iq_interleaved.
+     * @param channels Channel indices to extract, each in [0, M).
+     * @param n_channels Number of entries in @p channels (<= kMaxOutputs).
+     * @param out One interleaved complex buffer per requested channel.
+     * @param out_capacity_pairs Capacity of every @p out buffer in pairs. Input
+     *                           that would overflow it is left unconsumed.
+     * @return Output pairs written to each buffer (the same for all), or -1 on
+     *         invalid arguments or an unconfigured bank.
+     */
+    int process(const float* iq_interleaved, int pairs, const int* channels, int n_channels, float* const* out,
+                int out_capacity_pairs);
+
+  private:
+    void run_step(const int* channels, int n_channels, float* const* out, int out_index);
+    void release();
+
+    FftSetupCache m_fft;
+    float* m_taps = nullptr;    /* M*T reversed per branch, see configure() */
+    float* m_hist = nullptr;    /* interleaved complex delay line */
+    float* m_work = nullptr;    /* 2*M floats, FFT in/out */
+    float* m_twiddle = nullptr; /* 2*M floats, e^{-j2 pi p/M} */
+    int m_m = 0;
+    int m_taps_per_branch = 0;
+    int m_hist_cap = 0; /* pairs */
+    int m_hist_end = 0; /* pairs; newest sample is m_hist_end - 1 */
+    int m_phase = 0;    /* samples since the last output step */
+    int m_time_mod = 0; /* samples consumed, mod M */
+};
+
+/**
+ * @brief Largest usable channel count whose spacing is at least @p spacing_hz.
+ *
+ * The FFT only takes sizes that are a multiple of 16 with no prime factor above
+ * 5, so the count is the largest such size not exceeding rate / spacing.
+ *
+ * @return 0 when no usable size fits (rate too low for the spacing).
+ */
+int rtl_channelizer_pick_num_channels(uint32_t capture_rate_hz, uint32_t spacing_hz);
+
+} // namespace dsd_io
+
+#endif /* DSD_NEO_SRC_IO_RADIO_RTL_CHANNELIZER_H_ */
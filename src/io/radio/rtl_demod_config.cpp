@@ -282,7 +282,7 @@ demod_init_common_defaults(struct demod_state* s, int rtl_dsp_bw_hz, struct outp
         s->channel_lpf_hist_q[k] = 0;
     }
     s->channel_pwr = 0.0f;
-    g_channel_pwr.store(0.0f, std::memory_order_relaxed);
+    rtl_stream_channel_pwr().store(0.0f, std::memory_order_relaxed);
     s->channel_squelch_level = 0.0f;
     s->channel_squelched = 0;
     s->audio_lpf_enable = 0;
@@ -328,6 +328,10 @@ demod_init_common_defaults(struct demod_state* s, int rtl_dsp_bw_hz, struct outp
         DSD_MEMSET(s->hb_hist_i[st], 0, sizeof(s->hb_hist_i[st]));
         DSD_MEMSET(s->hb_hist_q[st], 0, sizeof(s->hb_hist_q[st]));
     }
+    /* Default-sized work buffers; stream open re-sizes them to the transfer length. */
+    if (demod_buffers_reserve(s, s->work_len > 0 ? s->work_len : DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        LOG_WARN("WARNING: Failed to allocate demodulator work buffers.\n");
+    }
     s->lowpassed = s->input_cb_buf;
     s->lp_len = 0;
     s->iqbal_alpha_ema_r = 0.0f;
@@ -385,6 +389,18 @@ demod_apply_mode_defaults(struct demod_state* s, DemodMode mode, const DemodInit
     s->rate_out2 = rtl_dsp_bw_hz;
 }
 
+/* Front/back block pipeline on the shared pool (DSD_NEO_DEMOD_PIPELINE=1). */
+static void
+demod_maybe_enable_stage_pipeline(struct demod_state* s) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg || !cfg->demod_pipeline_enable) {
+        return;
+    }
+    if (demod_pipeline_enable(s) != 0) {
+        LOG_WARN("WARNING: DSD_NEO_DEMOD_PIPELINE=1 needs the DSP pool (DSD_NEO_MT=1); demod stays single-stage.\n");
+    }
+}
+
 static void
 demod_init_mode(struct demod_state* s, DemodMode mode, const DemodInitParams* p, int rtl_dsp_bw_hz,
                 struct output_state* output) {
@@ -393,8 +409,9 @@ demod_init_mode(struct demod_state* s, DemodMode mode, const DemodInitParams* p,
     demod_init_cqpsk_defaults(s);
     demod_apply_mode_defaults(s, mode, p, rtl_dsp_bw_hz);
 
-    /* Initialize minimal worker pool (env-gated via DSD_NEO_MT). */
+    /* Attach to the shared DSP pool (env-gated via DSD_NEO_MT). */
     demod_mt_init(s);
+    demod_maybe_enable_stage_pipeline(s);
 
     /* Generic IQ balance defaults (image suppression); mode-aware guards in DSP pipeline.
        Start disabled so the UI/DSP menu fully controls this DSP block. */
@@ -904,6 +921,7 @@ rtl_demod_cleanup(struct demod_state* demod) {
     }
     dsd_cond_destroy(&demod->ready);
     dsd_mutex_destroy(&demod->ready_m);
+    demod_pipeline_disable(demod);
     demod_mt_destroy(demod);
     dsd_fsk_modem_release(&demod->fsk_modem_state);
     if (demod->resamp_taps) {
@@ -922,4 +940,5 @@ rtl_demod_cleanup(struct demod_state* demod) {
         dsd_neo_aligned_free(demod->post_polydecim_hist);
         demod->post_polydecim_hist = NULL;
     }
+    demod_buffers_release(demod);
 }
@@ -396,6 +396,11 @@ struct rtl_device {
     uint32_t tuner_xtal_hz = 0U;
     int if_gain_count = 0;
     struct rtl_capture_u8_byte_carry iq_byte_carry{}; /* one buffered raw byte when a chunk ends mid-I/Q sample */
+    /* Capture-side first half-band stage (USB only). The control thread sets the
+     * request; the callback thread owns the filter state and notices changes. */
+    std::atomic<int> ingest_decim_request{0};
+    int ingest_decim_active = 0;
+    dsd_neo_widen_hb_state ingest_hb{};
 
     struct {
         int stage = 0;
@@ -518,11 +523,15 @@ rtl_cu8_moments_add_sample(dsd_input_level_cu8_moments* moments, unsigned char s
     }
 }
 
+/*
+ * fs/4 rotation in the CU8 byte domain; 255 - x negates about 127.5. `dst`
+ * may alias `src` (the two-pass transform rotates in place).
+ */
 static uint32_t
-rtl_apply_two_pass_cu8_rotation(unsigned char* buf, uint32_t len, uint32_t phase,
-                                dsd_input_level_cu8_moments* moments) {
+rtl_rotate_cu8_bytes(const unsigned char* src, unsigned char* dst, uint32_t len, uint32_t phase,
+                     dsd_input_level_cu8_moments* moments) {
     uint32_t cur_phase = phase & 3U;
-    if (!buf || len < 2U) {
+    if (!src || !dst || len < 2U) {
         return cur_phase;
     }
     dsd_input_level_cu8_moments local;
@@ -532,31 +541,34 @@ rtl_apply_two_pass_cu8_rotation(unsigned char* buf, uint32_t len, uint32_t phase
     const uint32_t pairs = len >> 1;
     for (uint32_t n = 0; n < pairs; n++) {
         const uint32_t idx = n << 1;
-        const unsigned char in_i = buf[idx];
-        const unsigned char in_q = buf[idx + 1U];
+        const unsigned char in_i = src[idx];
+        const unsigned char in_q = src[idx + 1U];
         if (moments) {
             rtl_cu8_moments_add_sample(&local, in_i);
             rtl_cu8_moments_add_sample(&local, in_q);
         }
         switch (cur_phase) {
-            case 0: break;
+            case 0:
+                dst[idx] = in_i;
+                dst[idx + 1U] = in_q;
+                break;
             case 1:
-                buf[idx] = (unsigned char)(255U - (uint32_t)in_q);
-                buf[idx + 1U] = in_i;
+                dst[idx] = (unsigned char)(255U - (uint32_t)in_q);
+                dst[idx + 1U] = in_i;
                 break;
             case 2:
-                buf[idx] = (unsigned char)(255U - (uint32_t)in_i);
-                buf[idx + 1U] = (unsigned char)(255U - (uint32_t)in_q);
+                dst[idx] = (unsigned char)(255U - (uint32_t)in_i);
+                dst[idx + 1U] = (unsigned char)(255U - (uint32_t)in_q);
                 break;
             default:
-                buf[idx] = in_q;
-                buf[idx + 1U] = (unsigned char)(255U - (uint32_t)in_i);
+                dst[idx] = in_q;
+                dst[idx + 1U] = (unsigned char)(255U - (uint32_t)in_i);
                 break;
         }
         cur_phase = (cur_phase + 1U) & 3U;
     }
     if (moments && (len & 1U) != 0U) {
-        rtl_cu8_moments_add_sample(&local, buf[len - 1U]);
+        rtl_cu8_moments_add_sample(&local, src[len - 1U]);
     }
     if (moments) {
         (void)dsd_input_level_cu8_moments_merge(moments, &local);
@@ -587,7 +599,7 @@ rtl_process_u8_chunk(const struct rtl_device* s, unsigned char* src, float* dst,
                                                                                   (uint32_t)cur_phase, moments)
                             : (int)widen_rotate90_u8_to_f32_bias127_phase(src, dst, (uint32_t)len, (uint32_t)cur_phase);
     } else if (use_two_pass) {
-        cur_phase = (int)rtl_apply_two_pass_cu8_rotation(src, (uint32_t)len, (uint32_t)cur_phase, moments);
+        cur_phase = (int)rtl_rotate_cu8_bytes(src, src, (uint32_t)len, (uint32_t)cur_phase, moments);
         rtl_widen_two_pass_cu8(src, dst, (uint32_t)len);
     } else if (moments) {
         widen_u8_to_f32_bias127_moments(src, dst, (uint32_t)len, moments);
@@ -600,6 +612,31 @@ rtl_process_u8_chunk(const struct rtl_device* s, unsigned char* src, float* dst,
     return cur_phase;
 }
 
+/*
+ * Compact CU8 ring: keep the bytes and apply fs/4 in the byte domain. The
+ * ring's 127.5-centred widen then reproduces the combined transform exactly.
+ */
+static inline int
+rtl_process_u8_chunk_native(const unsigned char* src, unsigned char* dst, size_t len, int fs4_shift_active,
+                            int* phase, dsd_input_level_cu8_moments* moments) {
+    if (!src || !dst || len == 0) {
+        return phase ? *phase : 0;
+    }
+    int cur_phase = phase ? (*phase & 3) : 0;
+    if (fs4_shift_active) {
+        cur_phase = (int)rtl_rotate_cu8_bytes(src, dst, (uint32_t)len, (uint32_t)cur_phase, moments);
+    } else {
+        DSD_MEMCPY(dst, src, len);
+        if (moments) {
+            (void)dsd_input_level_cu8_moments_accumulate(moments, src, len);
+        }
+    }
+    if (phase) {
+        *phase = cur_phase;
+    }
+    return cur_phase;
+}
+
 static inline size_t
 rtl_drop_u8_bytes_preserve_alignment(const unsigned char* src, size_t byte_count,
                                      struct rtl_capture_u8_byte_carry* carry, int* phase, int fs4_shift_active) {
@@ -736,6 +773,7 @@ struct rtl_u8_write_cursor {
     int fs4_shift_active;
     int combine_rotate_active;
     int use_two_pass;
+    int native_u8; /* ring stores CU8; see rtl_process_u8_chunk_native() */
     dsd_input_level_cu8_moments* moments;
 };
 
@@ -745,8 +783,21 @@ struct rtl_u8_write_cursor {
 static std::atomic<int> g_rtl_test_force_u8_generation_stale{0};
 #endif
 
+/* Convert `len` bytes into ring span `dst` at element offset `at`, in the ring's storage format. */
+static inline void
+rtl_write_u8_span(const struct rtl_device* s, const rtl_u8_write_cursor* cursor, unsigned char* src, void* dst,
+                  size_t at, size_t len, dsd_input_level_cu8_moments* moments) {
+    if (cursor->native_u8) {
+        rtl_process_u8_chunk_native(src, static_cast<unsigned char*>(dst) + at, len, cursor->fs4_shift_active,
+                                    cursor->phase, moments);
+        return;
+    }
+    rtl_process_u8_chunk(s, src, static_cast<float*>(dst) + at, len, cursor->fs4_shift_active,
+                         cursor->combine_rotate_active, cursor->use_two_pass, cursor->phase, moments);
+}
+
 static inline void
-rtl_write_u8_reserved_segment(const struct rtl_device* s, const rtl_u8_write_cursor* cursor, float* dst,
+rtl_write_u8_reserved_segment(const struct rtl_device* s, const rtl_u8_write_cursor* cursor, void* dst,
                               size_t produced_bytes) {
     if (!s || !cursor || !cursor->src || !cursor->done || !cursor->need || !cursor->carry || !dst || !cursor->phase
         || produced_bytes == 0U) {
@@ -758,8 +809,7 @@ rtl_write_u8_reserved_segment(const struct rtl_device* s, const rtl_u8_write_cur
         rtl_capture_u8_byte_carry_consume_prefix(cursor->src + *cursor->done, *cursor->need, cursor->carry, pair);
     size_t from_prefix = 0U;
     if (prefix != 0U) {
-        rtl_process_u8_chunk(s, pair, dst, 2U, cursor->fs4_shift_active, cursor->combine_rotate_active,
-                             cursor->use_two_pass, cursor->phase, NULL);
+        rtl_write_u8_span(s, cursor, pair, dst, 0U, 2U, NULL);
         if (cursor->moments) {
             (void)dsd_input_level_cu8_moments_accumulate(cursor->moments, cursor->src + *cursor->done, prefix);
         }
@@ -769,8 +819,7 @@ rtl_write_u8_reserved_segment(const struct rtl_device* s, const rtl_u8_write_cur
     }
     if (produced_bytes > from_prefix) {
         size_t body = produced_bytes - from_prefix;
-        rtl_process_u8_chunk(s, cursor->src + *cursor->done, dst + from_prefix, body, cursor->fs4_shift_active,
-                             cursor->combine_rotate_active, cursor->use_two_pass, cursor->phase, cursor->moments);
+        rtl_write_u8_span(s, cursor, cursor->src + *cursor->done, dst, from_prefix, body, cursor->moments);
         *cursor->done += body;
         *cursor->need -= body;
     }
@@ -900,13 +949,14 @@ rtl_write_u8_to_ring(struct rtl_device* s, unsigned char* src, size_t len, int f
     struct rtl_capture_u8_byte_carry carry = s->iq_byte_carry;
     int ring_exhausted = 0;
     int generation_stale = 0;
+    const int native_u8 = (s->input_ring->format == DSD_IQ_FORMAT_CU8) ? 1 : 0;
 
     while (rtl_capture_u8_byte_carry_ready_bytes(need, &carry) >= 2U) {
         uint64_t discard_generation = input_ring_discard_generation(s->input_ring);
-        float *p1 = NULL, *p2 = NULL;
+        void *p1 = NULL, *p2 = NULL;
         size_t n1 = 0, n2 = 0;
         size_t ready = rtl_capture_u8_byte_carry_ready_bytes(need, &carry);
-        input_ring_reserve(s->input_ring, ready, &p1, &n1, &p2, &n2);
+        input_ring_reserve_raw(s->input_ring, ready, &p1, &n1, &p2, &n2);
         if (n1 == 0 && n2 == 0) {
             ring_exhausted = 1;
             break;
@@ -922,7 +972,8 @@ rtl_write_u8_to_ring(struct rtl_device* s, unsigned char* src, size_t len, int f
         }
 
         rtl_u8_write_cursor cursor = {
-            src, &done, &need, &carry, &phase, fs4_shift_active, combine_rotate_active, use_two_pass, moments};
+            src,          &done,     &need,  &carry, &phase, fs4_shift_active, combine_rotate_active,
+            use_two_pass, native_u8, moments};
         rtl_write_u8_reserved_segment(s, &cursor, p1, w1);
         rtl_write_u8_reserved_segment(s, &cursor, p2, w2);
 
@@ -950,6 +1001,169 @@ rtl_write_u8_to_ring(struct rtl_device* s, unsigned char* src, size_t len, int f
     return rtl_u8_write_result(ring_exhausted, generation_stale);
 }
 
+/* Filter outputs are written straight into ring spans; this bounds one fused call. */
+static const size_t kRtlIngestDecimMaxPairs = 1U << 20;
+
+static inline void
+rtl_ingest_decim_drop_pairs(struct rtl_device* s, size_t pairs, uint32_t* phase, int fs4_shift_active) {
+    if (pairs == 0U) {
+        return;
+    }
+    if (fs4_shift_active) {
+        *phase = (uint32_t)rtl_capture_phase_advance_pairs((int)(*phase & 3U), pairs);
+    }
+    /* Account in ring elements: one half-rate output pair per two input pairs. */
+    rtl_accumulate_ring_drops(s->input_ring, pairs);
+}
+
+/*
+ * Push whole CU8 pairs through the fused widen/rotate/half-band kernel into the
+ * input ring. Each ring span is filled with exactly the outputs its input slice
+ * produces, so nothing is staged outside the ring.
+ */
+static size_t
+rtl_ingest_decim_pairs_to_ring(struct rtl_device* s, const unsigned char* src, size_t pairs, uint32_t* phase,
+                               int fs4_shift_active, dsd_input_level_cu8_moments* moments, int* ring_exhausted,
+                               int* generation_stale) {
+    size_t done = 0U;
+    while (done < pairs) {
+        size_t chunk = pairs - done;
+        if (chunk > kRtlIngestDecimMaxPairs) {
+            chunk = kRtlIngestDecimMaxPairs;
+        }
+        const uint32_t out_pairs = widen_hb_decim2_out_pairs(&s->ingest_hb, (uint32_t)chunk);
+        if (out_pairs == 0U) {
+            /* Still filling the filter window; nothing to publish yet. */
+            float unused[2];
+            *phase = widen_hb_decim2_u8_to_f32_bias127(src + done * 2U, unused, (uint32_t)(chunk * 2U), *phase,
+                                                       fs4_shift_active, &s->ingest_hb, moments, NULL);
+            done += chunk;
+            continue;
+        }
+
+        uint64_t discard_generation = input_ring_discard_generation(s->input_ring);
+        float *p1 = NULL, *p2 = NULL;
+        size_t n1 = 0, n2 = 0;
+        const size_t want = (size_t)out_pairs * 2U;
+        input_ring_reserve(s->input_ring, want, &p1, &n1, &p2, &n2);
+        size_t w1 = 0U;
+        size_t w2 = 0U;
+        rtl_even_split_ring_reserve(want, n1, n2, &w1, &w2);
+        if (w1 + w2 == 0U) {
+            *ring_exhausted = 1;
+            break;
+        }
+
+        float* spans[2] = {p1, p2};
+        const size_t lens[2] = {w1, w2};
+        for (int k = 0; k < 2; k++) {
+            if (lens[k] == 0U) {
+                continue;
+            }
+            const uint32_t in_pairs = widen_hb_decim2_in_pairs(&s->ingest_hb, (uint32_t)(lens[k] / 2U));
+            *phase = widen_hb_decim2_u8_to_f32_bias127(src + done * 2U, spans[k], in_pairs * 2U, *phase,
+                                                       fs4_shift_active, &s->ingest_hb, moments, NULL);
+            done += in_pairs;
+        }
+
+        if (!input_ring_discard_generation_matches(s->input_ring, discard_generation)) {
+            rtl_accumulate_ring_drops(s->input_ring, w1 + w2);
+            *generation_stale = 1;
+            break;
+        }
+        input_ring_commit(s->input_ring, w1 + w2);
+        if (w1 + w2 < want) {
+            *ring_exhausted = 1;
+            break;
+        }
+    }
+    return done;
+}
+
+/**
+ * @brief USB ingest with the first half-band stage fused in.
+ *
+ * Same contract as rtl_write_u8_to_ring() for the combined transform, except
+ * the ring receives interleaved I/Q at half the capture rate.
+ */
+static int
+rtl_write_u8_decim_to_ring(struct rtl_device* s, unsigned char* src, size_t len, int fs4_shift_active,
+                           dsd_input_level_cu8_moments* moments) {
+    if (!s || !s->input_ring || !src || len == 0) {
+        return 0;
+    }
+
+    rtl_u8_perf_state perf = rtl_u8_perf_begin(s);
+    uint32_t phase = (uint32_t)(s->rot_phase & 3);
+    struct rtl_capture_u8_byte_carry carry = s->iq_byte_carry;
+    int ring_exhausted = 0;
+    int generation_stale = 0;
+    size_t done = 0U;
+
+    /* A pair split across callbacks goes through the filter like any other. */
+    unsigned char pair[2];
+    size_t prefix = rtl_capture_u8_byte_carry_consume_prefix(src, len, &carry, pair);
+    if (prefix != 0U) {
+        if (moments) {
+            (void)dsd_input_level_cu8_moments_accumulate(moments, src, prefix);
+        }
+        if (rtl_ingest_decim_pairs_to_ring(s, pair, 1U, &phase, fs4_shift_active, NULL, &ring_exhausted,
+                                           &generation_stale)
+            == 0U) {
+            rtl_ingest_decim_drop_pairs(s, 1U, &phase, fs4_shift_active);
+        }
+        done = prefix;
+    }
+
+    const size_t pairs = (len - done) / 2U;
+    size_t used_pairs = 0U;
+    if (!ring_exhausted && !generation_stale) {
+        used_pairs = rtl_ingest_decim_pairs_to_ring(s, src + done, pairs, &phase, fs4_shift_active, moments,
+                                                    &ring_exhausted, &generation_stale);
+    }
+    const size_t rest = pairs - used_pairs;
+    if (moments && rest > 0U) {
+        (void)dsd_input_level_cu8_moments_accumulate(moments, src + done + used_pairs * 2U, rest * 2U);
+    }
+    rtl_ingest_decim_drop_pairs(s, rest, &phase, fs4_shift_active);
+    done += pairs * 2U;
+
+    if (generation_stale) {
+        widen_hb_decim2_state_reset(&s->ingest_hb);
+        rtl_clear_capture_alignment_after_discard(s, &carry);
+    } else {
+        if (ring_exhausted) {
+            s->reserve_full_events++;
+        }
+        if (done < len) {
+            if (moments) {
+                (void)dsd_input_level_cu8_moments_accumulate(moments, src + done, 1U);
+            }
+            rtl_capture_u8_byte_carry_save(&carry, src[done]);
+        }
+        s->iq_byte_carry = carry;
+        if (fs4_shift_active) {
+            s->rot_phase = (int)phase;
+        }
+    }
+    rtl_u8_perf_end(s, &perf, len);
+    return rtl_u8_write_result(ring_exhausted, generation_stale);
+}
+
+/* Pick up a request change from the control thread; runs on the callback thread. */
+static inline int
+rtl_ingest_decim_active(struct rtl_device* s, int use_two_pass) {
+    int want = (s->ingest_decim_request.load(std::memory_order_acquire) && !use_two_pass
+                && !input_ring_is_compact(s->input_ring))
+                   ? 1
+                   : 0;
+    if (want != s->ingest_decim_active) {
+        widen_hb_decim2_state_reset(&s->ingest_hb);
+        s->ingest_decim_active = want;
+    }
+    return want;
+}
+
 static inline void
 rtl_submit_capture_bytes(struct rtl_device* s, const void* data, size_t bytes) {
     if (!s || !s->iq_capture_writer || !data || bytes == 0) {
@@ -1190,14 +1404,14 @@ rtl_apply_j4_rotation(float in_i, float in_q, int phase, float* out_i, float* ou
 
 #ifdef USE_SOAPYSDR
 static inline size_t
-soapy_reserve_even_ring_segments(struct input_ring_state* ring, size_t need, float** p1, size_t* w1, float** p2,
+soapy_reserve_even_ring_segments(struct input_ring_state* ring, size_t need, void** p1, size_t* w1, void** p2,
                                  size_t* w2) {
     if (!ring || !p1 || !w1 || !p2 || !w2) {
         return 0U;
     }
     size_t n1 = 0U;
     size_t n2 = 0U;
-    input_ring_reserve(ring, need, p1, &n1, p2, &n2);
+    input_ring_reserve_raw(ring, need, p1, &n1, p2, &n2);
     rtl_even_split_ring_reserve(need, n1, n2, w1, w2);
     return *w1 + *w2;
 }
@@ -1263,6 +1477,89 @@ soapy_copy_cs16_samples(float* dst, const int16_t* src_iq, size_t elem_count, fl
     }
 }
 
+static inline int16_t
+soapy_negate_cs16(int16_t v) {
+    return (v == INT16_MIN) ? INT16_MAX : (int16_t)-v;
+}
+
+/* Compact CS16 ring: fs/4 rotation on the integers; only -32768 saturates. */
+static inline void
+soapy_copy_cs16_native(int16_t* dst, const int16_t* src_iq, size_t elem_count, int apply_rot, int* phase) {
+    if (!dst || !src_iq || elem_count == 0U) {
+        return;
+    }
+    if (!apply_rot || !phase) {
+        DSD_MEMCPY(dst, src_iq, elem_count * 2U * sizeof(int16_t));
+        return;
+    }
+    for (size_t i = 0U; i < elem_count; i++) {
+        const int16_t in_i = src_iq[(i * 2U) + 0U];
+        const int16_t in_q = src_iq[(i * 2U) + 1U];
+        int16_t out_i = in_i;
+        int16_t out_q = in_q;
+        switch (*phase & 3) {
+            case 0: break;
+            case 1:
+                out_i = soapy_negate_cs16(in_q);
+                out_q = in_i;
+                break;
+            case 2:
+                out_i = soapy_negate_cs16(in_i);
+                out_q = soapy_negate_cs16(in_q);
+                break;
+            default:
+                out_i = in_q;
+                out_q = soapy_negate_cs16(in_i);
+                break;
+        }
+        dst[(i * 2U) + 0U] = out_i;
+        dst[(i * 2U) + 1U] = out_q;
+        *phase = (*phase + 1) & 3;
+    }
+}
+
+static inline int16_t
+soapy_quantize_cs16(float v) {
+    float scaled = v * 32768.0f;
+    if (scaled >= 32767.0f) {
+        return INT16_MAX;
+    }
+    if (scaled <= -32768.0f) {
+        return INT16_MIN;
+    }
+    return (int16_t)lrintf(scaled);
+}
+
+/*
+ * A CS16 ring is chosen from the format cached when the device opened; if
+ * the stream later negotiates CF32 the samples are quantized to fit it.
+ */
+static inline void
+soapy_store_cf32_span(const struct input_ring_state* ring, void* dst, const std::complex<float>* src,
+                      size_t elem_count, int apply_rot, int* phase) {
+    if (ring->format != DSD_IQ_FORMAT_CS16) {
+        soapy_copy_cf32_samples(static_cast<float*>(dst), src, elem_count, apply_rot, phase);
+        return;
+    }
+    int16_t* out = static_cast<int16_t*>(dst);
+    for (size_t i = 0U; i < elem_count; i++) {
+        float tmp[2];
+        soapy_copy_cf32_samples(tmp, src + i, 1U, apply_rot, phase);
+        out[(i * 2U) + 0U] = soapy_quantize_cs16(tmp[0]);
+        out[(i * 2U) + 1U] = soapy_quantize_cs16(tmp[1]);
+    }
+}
+
+static inline void
+soapy_store_cs16_span(const struct input_ring_state* ring, void* dst, const int16_t* src_iq, size_t elem_count,
+                      int apply_rot, int* phase) {
+    if (ring->format == DSD_IQ_FORMAT_CS16) {
+        soapy_copy_cs16_native(static_cast<int16_t*>(dst), src_iq, elem_count, apply_rot, phase);
+        return;
+    }
+    soapy_copy_cs16_samples(static_cast<float*>(dst), src_iq, elem_count, 1.0f / 32768.0f, apply_rot, phase);
+}
+
 static size_t
 soapy_write_cf32_to_ring(struct rtl_device* s, const std::complex<float>* src, size_t num_elems, int apply_rot) {
     if (!s || !s->input_ring || !src || num_elems == 0) {
@@ -1276,7 +1573,7 @@ soapy_write_cf32_to_ring(struct rtl_device* s, const std::complex<float>* src, s
     int phase = s->rot_phase & 3;
     while (need > 0) {
         uint64_t discard_generation = input_ring_discard_generation(s->input_ring);
-        float *p1 = NULL, *p2 = NULL;
+        void *p1 = NULL, *p2 = NULL;
         size_t w1 = 0U;
         size_t w2 = 0U;
         size_t produced = soapy_reserve_even_ring_segments(s->input_ring, need, &p1, &w1, &p2, &w2);
@@ -1285,9 +1582,9 @@ soapy_write_cf32_to_ring(struct rtl_device* s, const std::complex<float>* src, s
             break;
         }
         size_t src_idx = done / 2U;
-        soapy_copy_cf32_samples(p1, src + src_idx, w1 / 2U, apply_rot, &phase);
+        soapy_store_cf32_span(s->input_ring, p1, src + src_idx, w1 / 2U, apply_rot, &phase);
         src_idx += w1 / 2U;
-        soapy_copy_cf32_samples(p2, src + src_idx, w2 / 2U, apply_rot, &phase);
+        soapy_store_cf32_span(s->input_ring, p2, src + src_idx, w2 / 2U, apply_rot, &phase);
         if (soapy_finalize_generation(s->input_ring, discard_generation, produced)) {
             break;
         }
@@ -1313,13 +1610,12 @@ soapy_write_cs16_to_ring(struct rtl_device* s, const int16_t* src, size_t num_el
     int perf_on = rtl_perf_enabled();
     uint64_t perf_t0 = perf_on ? dsd_time_monotonic_ns() : 0ULL;
     uint64_t perf_drops_before = perf_on ? s->input_ring->producer_drops.load(std::memory_order_relaxed) : 0ULL;
-    const float scale = 1.0f / 32768.0f;
     size_t need = num_elems * 2;
     size_t done = 0;
     int phase = s->rot_phase & 3;
     while (need > 0) {
         uint64_t discard_generation = input_ring_discard_generation(s->input_ring);
-        float *p1 = NULL, *p2 = NULL;
+        void *p1 = NULL, *p2 = NULL;
         size_t w1 = 0U;
         size_t w2 = 0U;
         size_t produced = soapy_reserve_even_ring_segments(s->input_ring, need, &p1, &w1, &p2, &w2);
@@ -1328,9 +1624,9 @@ soapy_write_cs16_to_ring(struct rtl_device* s, const int16_t* src, size_t num_el
             break;
         }
         size_t src_idx = done / 2U;
-        soapy_copy_cs16_samples(p1, src + (src_idx * 2U), w1 / 2U, scale, apply_rot, &phase);
+        soapy_store_cs16_span(s->input_ring, p1, src + (src_idx * 2U), w1 / 2U, apply_rot, &phase);
         src_idx += w1 / 2U;
-        soapy_copy_cs16_samples(p2, src + (src_idx * 2U), w2 / 2U, scale, apply_rot, &phase);
+        soapy_store_cs16_span(s->input_ring, p2, src + (src_idx * 2U), w2 / 2U, apply_rot, &phase);
         if (soapy_finalize_generation(s->input_ring, discard_generation, produced)) {
             break;
         }
@@ -1374,9 +1670,9 @@ replay_signal_input_waiters(struct rtl_device* s) {
         return;
     }
     dsd_mutex_lock(&s->input_ring->ready_m);
-    dsd_cond_broadcast(&s->input_ring->ready);
     dsd_cond_broadcast(&s->input_ring->space);
     dsd_mutex_unlock(&s->input_ring->ready_m);
+    input_ring_signal_ready(s->input_ring);
 }
 
 static int
@@ -1462,8 +1758,7 @@ rtl_device_test_replay_event_boundary_drained(size_t ring_used, uint64_t submitt
     float buffer[8] = {0};
     ring.buffer = buffer;
     ring.capacity = sizeof(buffer) / sizeof(buffer[0]);
-    ring.tail.store(0, std::memory_order_relaxed);
-    ring.head.store(ring_used < ring.capacity ? ring_used : (ring.capacity - 1U), std::memory_order_relaxed);
+    ring.reset(ring_used < ring.capacity ? ring_used : (ring.capacity - 1U));
 
     std::atomic<uint64_t> submitted{submitted_gen};
     std::atomic<uint64_t> consumed{consumed_gen};
@@ -2407,7 +2702,11 @@ rtlsdr_callback(unsigned char* buf, uint32_t len, void* ctx) {
     dsd_input_level_cu8_moments moments;
     dsd_input_level_cu8_moments_reset(&moments);
     /* Convert incoming u8 I/Q and write directly into input ring without extra copy. */
-    rtl_write_u8_to_ring(s, buf, len, fs4_shift_active, use_two_pass, combine_rotate_active, 0, &moments);
+    if (rtl_ingest_decim_active(s, use_two_pass)) {
+        rtl_write_u8_decim_to_ring(s, buf, len, fs4_shift_active, &moments);
+    } else {
+        rtl_write_u8_to_ring(s, buf, len, fs4_shift_active, use_two_pass, combine_rotate_active, 0, &moments);
+    }
     rtl_publish_cu8_input_level_moments(s, &moments);
 }
 
@@ -4856,6 +5155,9 @@ rtl_device_init_common_state(struct rtl_device* dev) {
     dev->capture_reconfigure_hold.store(RTL_CAPTURE_RECONFIGURE_INACTIVE, std::memory_order_relaxed);
     const dsdneoRuntimeConfig* runtime_config = dsd_neo_get_config();
     dev->live_combine_rotate_enabled = runtime_config ? (runtime_config->combine_rot != 0) : 1;
+    dev->ingest_decim_request.store(0, std::memory_order_relaxed);
+    dev->ingest_decim_active = 0;
+    widen_hb_decim2_state_reset(&dev->ingest_hb);
     dev->replay_fs4_shift_enabled = 0;
     dev->replay_historical_cu8_two_pass = 0;
     DSD_MEMSET(&dev->replay_cfg, 0, sizeof(dev->replay_cfg));
@@ -6262,24 +6564,24 @@ rtl_device_start_async(struct rtl_device* dev, uint32_t buf_len) {
             dev->thread_started = 0;
             return -1;
         }
-        r = dsd_thread_create(&dev->thread, dongle_thread_fn, dev);
+        r = rtl_stream_thread_create(&dev->thread, dongle_thread_fn, dev);
     } else if (dev->backend == RTL_BACKEND_TCP) {
         dev->run.store(1);
-        r = dsd_thread_create(&dev->thread, tcp_thread_fn, dev);
+        r = rtl_stream_thread_create(&dev->thread, tcp_thread_fn, dev);
     } else if (dev->backend == RTL_BACKEND_IQ_REPLAY) {
         if (!dev->replay_src) {
             dev->thread_started = 0;
             return -1;
         }
         dev->run.store(1, std::memory_order_release);
-        r = dsd_thread_create(&dev->thread, replay_thread_fn, dev);
+        r = rtl_stream_thread_create(&dev->thread, replay_thread_fn, dev);
     } else if (dev->backend == RTL_BACKEND_SOAPY) {
         if (!dev->soapy_dev) {
             dev->thread_started = 0;
             return -1;
         }
         dev->run.store(1);
-        r = dsd_thread_create(&dev->thread, soapy_thread_fn, dev);
+        r = rtl_stream_thread_create(&dev->thread, soapy_thread_fn, dev);
     } else {
         dev->thread_started = 0;
         return -1;
@@ -6424,6 +6726,18 @@ rtl_device_set_tcp_autotune(struct rtl_device* dev, int onoff) {
     return 0;
 }
 
+int
+rtl_device_set_ingest_decimation(struct rtl_device* dev, int on) {
+    if (!dev) {
+        return -1;
+    }
+    if (dev->backend != RTL_BACKEND_USB || (dev->input_ring && input_ring_is_compact(dev->input_ring))) {
+        return on ? DSD_ERR_NOT_SUPPORTED : 0;
+    }
+    dev->ingest_decim_request.store(on ? 1 : 0, std::memory_order_release);
+    return 0;
+}
+
 int
 rtl_device_set_xtal_freq(struct rtl_device* dev, uint32_t rtl_xtal_hz, uint32_t tuner_xtal_hz) {
     if (!dev) {
@@ -6647,6 +6961,113 @@ rtl_device_test_usb_reconfigure_discards_samples(size_t input_bytes, size_t* out
     return 0;
 }
 
+/*
+ * Feed `input` through the USB callback in two pieces (split at `split`, which
+ * may be odd) with capture-side decimation on, then drain the ring.
+ */
+extern "C" int
+rtl_device_test_u8_ingest_decim(const unsigned char* input, size_t input_bytes, size_t split, size_t ring_cap,
+                                float* out, size_t out_cap, size_t* out_used, uint64_t* out_drops, int* out_phase) {
+    if (!input || input_bytes == 0U || split > input_bytes || !out || !out_used || !out_drops || !out_phase) {
+        return -1;
+    }
+    input_ring_state ring{};
+    if (input_ring_init(&ring, ring_cap) != 0) {
+        return -2;
+    }
+
+    rtl_device dev{};
+    rtl_device_init_common_state(&dev);
+    dev.input_ring = &ring;
+    dev.backend = RTL_BACKEND_USB;
+    dev.live_combine_rotate_enabled = 1;
+    int rc = rtl_device_set_ingest_decimation(&dev, 1);
+    if (rc == 0) {
+        unsigned char* buf = static_cast<unsigned char*>(malloc(input_bytes));
+        if (!buf) {
+            rc = -3;
+        } else {
+            DSD_MEMCPY(buf, input, input_bytes);
+            if (split > 0U) {
+                rtlsdr_callback(buf, (uint32_t)split, &dev);
+            }
+            if (input_bytes > split) {
+                rtlsdr_callback(buf + split, (uint32_t)(input_bytes - split), &dev);
+            }
+            free(buf);
+        }
+    }
+    *out_used = ring.read(out, out_cap);
+    *out_drops = ring.producer_drops.load(std::memory_order_acquire);
+    *out_phase = dev.rot_phase;
+    rtl_device_cleanup_common_state(&dev);
+    input_ring_destroy(&ring);
+    return rc;
+}
+
+/*
+ * Feed CU8 through the USB callback into a float or compact CU8 ring, then
+ * drain it through the consumer-side widen. Also reports whether capture-side
+ * decimation could be enabled on that ring.
+ */
+extern "C" int
+rtl_device_test_u8_compact_ring(const unsigned char* input, size_t input_bytes, size_t split, size_t ring_cap,
+                                int compact, float* out, size_t out_cap, size_t* out_used, uint64_t* out_drops,
+                                int* out_phase, int* out_decim_rc) {
+    if (!input || input_bytes == 0U || split > input_bytes || !out || !out_used || !out_drops || !out_phase
+        || !out_decim_rc) {
+        return -1;
+    }
+    input_ring_state ring{};
+    if (input_ring_init(&ring, ring_cap) != 0) {
+        return -2;
+    }
+    if (compact) {
+        input_ring_set_widen_kernels(widen_u8_to_f32_bias127, widen_s16_to_f32);
+    }
+    if (compact && input_ring_resize(&ring, ring_cap, DSD_IQ_FORMAT_CU8) != 0) {
+        input_ring_destroy(&ring);
+        return -2;
+    }
+
+    rtl_device dev{};
+    rtl_device_init_common_state(&dev);
+    dev.input_ring = &ring;
+    dev.backend = RTL_BACKEND_USB;
+    dev.live_combine_rotate_enabled = 1;
+    *out_decim_rc = rtl_device_set_ingest_decimation(&dev, 1);
+    (void)rtl_device_set_ingest_decimation(&dev, 0);
+    int rc = 0;
+    unsigned char* buf = static_cast<unsigned char*>(malloc(input_bytes));
+    if (!buf) {
+        rc = -3;
+    } else {
+        DSD_MEMCPY(buf, input, input_bytes);
+        if (split > 0U) {
+            rtlsdr_callback(buf, (uint32_t)split, &dev);
+        }
+        if (input_bytes > split) {
+            rtlsdr_callback(buf + split, (uint32_t)(input_bytes - split), &dev);
+        }
+        free(buf);
+    }
+    *out_used = 0U;
+    while (*out_used < out_cap && input_ring_used(&ring) > 0U) {
+        /* Small chunks so the drain crosses the ring's wrap point in pieces. */
+        size_t want = out_cap - *out_used;
+        int got = input_ring_read_convert(&ring, out + *out_used, want < 7U ? want : 7U);
+        if (got <= 0) {
+            break;
+        }
+        *out_used += (size_t)got;
+    }
+    *out_drops = ring.producer_drops.load(std::memory_order_acquire);
+    *out_phase = dev.rot_phase;
+    rtl_device_cleanup_common_state(&dev);
+    input_ring_destroy(&ring);
+    return rc;
+}
+
 extern "C" int
 rtl_device_test_u8_odd_carry_bridge(size_t* out_used, int* out_phase, int* out_carry_valid, uint8_t* out_carry_byte,
                                     int* out_first_status, int* out_second_status) {
@@ -6753,8 +7174,7 @@ rtl_device_test_collect_write_moments(unsigned char* input, size_t input_len, si
     if (input_ring_init(&ring, ring_capacity) != 0) {
         return -2;
     }
-    ring.head.store(start_index, std::memory_order_relaxed);
-    ring.tail.store(start_index, std::memory_order_relaxed);
+    ring.reset(start_index, start_index);
 
     rtl_device dev{};
     dev.input_ring = &ring;
@@ -6926,6 +7346,21 @@ rtl_device_get_native_sample_format(const struct rtl_device* dev) {
     return 0;
 }
 
+int
+rtl_device_get_compact_ring_format(const struct rtl_device* dev) {
+    if (!dev) {
+        return 0;
+    }
+    /* The two-pass CU8 transform centres on 128, which the ring's 127.5 widen cannot reproduce. */
+    if ((dev->backend == RTL_BACKEND_USB || dev->backend == RTL_BACKEND_TCP) && dev->live_combine_rotate_enabled) {
+        return DSD_IQ_FORMAT_CU8;
+    }
+    if (dev->backend == RTL_BACKEND_SOAPY && dev->soapy_format == SOAPY_FMT_CS16) {
+        return DSD_IQ_FORMAT_CS16;
+    }
+    return 0;
+}
+
 #ifdef DSD_NEO_ENABLE_INTERNAL_TEST_HOOKS
 extern "C" int
 rtl_device_test_public_capture_policy(int* out_formats, size_t out_formats_len, uint32_t* out_counts,
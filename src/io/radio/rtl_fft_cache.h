@@ -29,10 +29,11 @@ namespace dsd_io {
 /**
  * @brief A pffft complex setup, rebuilt only when the transform size changes.
  *
- * Never frees the setup it holds. The instances are file-scope and outlive
- * every caller, and destroying one at static-destruction time could race a
- * demod thread that has not been joined yet — the same reason the
- * function-local statics this replaces were also never torn down.
+ * Never frees the setup it holds on its own. The default pipeline's instances
+ * outlive every caller, and destroying one at static-destruction time could
+ * race a demod thread that has not been joined yet — the same reason the
+ * function-local statics this replaces were also never torn down. Owners that
+ * are torn down after their threads are joined call release().
  *
  * The transform is a method rather than a setup handed back to the caller, so
  * this header is the one place in the project that names pffft — which is what
@@ -66,6 +67,16 @@ class FftSetupCache {
         return true;
     }
 
+    /** @brief Free the held setup; the next forward() rebuilds it. */
+    void
+    release() {
+        if (m_setup != nullptr) {
+            pffft_destroy_setup(m_setup);
+            m_setup = nullptr;
+        }
+        m_n = 0;
+    }
+
   private:
     /** @brief Setup for @p n points, or nullptr when pffft rejects the size. */
     PFFFT_Setup*
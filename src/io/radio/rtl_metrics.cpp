@@ -24,49 +24,13 @@
 #include "rtl_spectrum_kernels.h"
 #include "rtl_stream_shared.hpp"
 
-/* Spectrum capture and carrier diagnostics shared with RTL orchestrator. */
-static const int kSpecMaxN = 1024; /* Max FFT size (power of two) */
-static float g_spec_db[kSpecMaxN];
-static std::atomic<int> g_spec_rate_hz{0};
-static std::atomic<int> g_spec_ready{0};
-static std::atomic<int> g_spec_N{256}; /* default N */
-std::atomic<double> g_spec_peak_db{-100.0};
-std::atomic<double> g_spec_snr_db{-100.0};
-/* Carrier diagnostics (updated alongside spectrum) */
-static std::atomic<double> g_cfo_nco_hz{0.0};
-std::atomic<double> g_resid_cfo_phase_hz{0.0};
-static std::atomic<int> g_carrier_lock{0};
-static std::atomic<int> g_nco_q15{0};
-static std::atomic<int> g_demod_rate_hz{0};
-static std::atomic<int> g_costas_err_avg_q14{0};
-static std::atomic<int> g_costas_err_raw_avg_q14{0};
-static std::atomic<int> g_costas_conf_avg_q14{0};
-static std::atomic<int> g_costas_zero_conf_pct{0};
-static std::atomic<double> g_fll_band_edge_freq_rad{0.0}; /* FLL band-edge NCO freq (rad/sample) */
-
-/* Supervisory tuner autogain gate (0/1), controlled via env/UI. */
-std::atomic<int> g_tuner_autogain_on{0};
-
-/* Auto-PPM status. */
-std::atomic<int> g_auto_ppm_enabled{0};
-/* User override for auto-PPM: -1 = follow env/opts; 0 = force off; 1 = force on. */
-std::atomic<int> g_auto_ppm_user_en{-1};
-std::atomic<int> g_auto_ppm_locked{0};
-std::atomic<int> g_auto_ppm_training{0};
-std::atomic<int> g_auto_ppm_lock_ppm{0};
-std::atomic<double> g_auto_ppm_lock_snr_db{-100.0};
-std::atomic<double> g_auto_ppm_lock_df_hz{0.0};
-std::atomic<double> g_auto_ppm_snr_db{-100.0};
-std::atomic<double> g_auto_ppm_df_hz{0.0};
-std::atomic<double> g_auto_ppm_est_ppm{0.0};
-std::atomic<int> g_auto_ppm_last_dir{0};
-std::atomic<int> g_auto_ppm_cooldown{0};
-
 static int
 cqpsk_loop_lock_heuristic(float total_freq_rad, int out_rate_hz) {
-    static int prev_valid = 0;
-    static float prev_total_freq_rad = 0.0f;
-    static int freq_stable_blocks = 0;
+    const demod_state& demod = rtl_stream_demod();
+    RtlStreamShared& sh = rtl_stream_shared();
+    int& prev_valid = sh.lock_prev_valid;
+    float& prev_total_freq_rad = sh.lock_prev_total_freq_rad;
+    int& freq_stable_blocks = sh.lock_freq_stable_blocks;
 
     if (!demod.cqpsk_enable || out_rate_hz <= 0) {
         prev_valid = 0;
@@ -109,12 +73,6 @@ cqpsk_loop_lock_heuristic(float total_freq_rad, int out_rate_hz) {
     return (freq_stable_blocks >= 2 && ted_lock > 0.25f && costas_err < 0.65f && fll_abs < fll_lock_limit) ? 1 : 0;
 }
 
-/* This tap's own caches. Kept separate from the wideband tap's by construction:
- * the two analyse different sizes on this same thread, so one shared cache
- * would rebuild the pffft setup on every alternating call. */
-static dsd_io::FftSetupCache g_spec_fft_setup;
-static dsd_io::HannWindowCache<kSpecMaxN> g_spec_hann;
-
 namespace {
 
 struct rtl_metrics_fft_frame {
@@ -140,12 +98,12 @@ struct rtl_metrics_nco_metrics {
 
 static int
 rtl_metrics_fft_size(void) {
-    int N = g_spec_N.load(std::memory_order_relaxed);
+    int N = rtl_stream_shared().spec_N.load(std::memory_order_relaxed);
     if (N < 64) {
         N = 64;
     }
-    if (N > kSpecMaxN) {
-        N = kSpecMaxN;
+    if (N > kRtlSpecMaxN) {
+        N = kRtlSpecMaxN;
     }
     return N;
 }
@@ -167,9 +125,9 @@ rtl_metrics_prepare_fft_input(const float* iq_interleaved, int pairs, int N, flo
         }
     }
 
-    const float* hann = g_spec_hann.get(N);
+    const float* hann = rtl_stream_shared().spec_hann.get(N);
     if (hann == nullptr) {
-        /* N is clamped to [64, kSpecMaxN] upstream, so this is unreachable in
+        /* N is clamped to [64, kRtlSpecMaxN] upstream, so this is unreachable in
          * practice. Hand back a silent frame rather than transforming whatever
          * the buffer happened to hold. */
         for (int n = 0; n < (N << 1); n++) {
@@ -220,10 +178,11 @@ static const float kSpecEmaNewWeight = 0.2f;
 
 static void
 rtl_metrics_smooth_spectrum_bins(int N, int out_rate_hz, const float* z) {
-    const bool first = (g_spec_ready.load(std::memory_order_relaxed) == 0);
-    dsd_io::spectrum_fold_db(z, N, kSpecEmaNewWeight, first, g_spec_db);
-    g_spec_rate_hz.store(out_rate_hz, std::memory_order_relaxed);
-    g_spec_ready.store(1, std::memory_order_release);
+    RtlStreamShared& sh = rtl_stream_shared();
+    const bool first = (sh.spec_ready.load(std::memory_order_relaxed) == 0);
+    dsd_io::spectrum_fold_db(z, N, kSpecEmaNewWeight, first, sh.spec_db);
+    sh.spec_rate_hz.store(out_rate_hz, std::memory_order_relaxed);
+    sh.spec_ready.store(1, std::memory_order_release);
 }
 
 static void
@@ -245,11 +204,12 @@ rtl_metrics_peak_search_bounds(int N, int* k_center_i, int* i_lo, int* i_hi) {
 
 static void
 rtl_metrics_peak_find_bin(int i_lo, int i_hi, int* i_max, float* p_max) {
+    RtlStreamShared& sh = rtl_stream_shared();
     *i_max = i_lo;
-    *p_max = g_spec_db[i_lo];
+    *p_max = sh.spec_db[i_lo];
     for (int k = i_lo + 1; k <= i_hi; k++) {
-        if (g_spec_db[k] > *p_max) {
-            *p_max = g_spec_db[k];
+        if (sh.spec_db[k] > *p_max) {
+            *p_max = sh.spec_db[k];
             *i_max = k;
         }
     }
@@ -257,11 +217,11 @@ rtl_metrics_peak_find_bin(int i_lo, int i_hi, int* i_max, float* p_max) {
 
 static float
 rtl_metrics_peak_noise_snr(int i_lo, int i_hi, int i_max, float p_max) {
-    alignas(16) float noise_bins[kSpecMaxN];
+    alignas(16) float noise_bins[kRtlSpecMaxN];
     int noise_count = 0;
     for (int k = i_lo; k <= i_hi; k++) {
         if (k < i_max - 2 || k > i_max + 2) {
-            noise_bins[noise_count++] = g_spec_db[k];
+            noise_bins[noise_count++] = rtl_stream_shared().spec_db[k];
         }
     }
     if (noise_count < 16) {
@@ -274,10 +234,11 @@ rtl_metrics_peak_noise_snr(int i_lo, int i_hi, int i_max, float p_max) {
 
 static float
 rtl_metrics_peak_center_tone_filter(int N, int k_center_i, int i_max, float p_max, float spec_snr_db) {
+    RtlStreamShared& sh = rtl_stream_shared();
     if (N < 3 || i_max <= 0 || i_max + 1 >= N || i_max != k_center_i) {
         return spec_snr_db;
     }
-    float side_max = (g_spec_db[i_max - 1] > g_spec_db[i_max + 1]) ? g_spec_db[i_max - 1] : g_spec_db[i_max + 1];
+    float side_max = (sh.spec_db[i_max - 1] > sh.spec_db[i_max + 1]) ? sh.spec_db[i_max - 1] : sh.spec_db[i_max + 1];
     if ((p_max - side_max) > 12.0f) {
         return -100.0f;
     }
@@ -299,6 +260,7 @@ rtl_metrics_compute_peak_metrics(int N) {
 
 static rtl_metrics_nco_metrics
 rtl_metrics_compute_nco_metrics(int out_rate_hz) {
+    const demod_state& demod = rtl_stream_demod();
     rtl_metrics_nco_metrics nco = {};
     if (out_rate_hz <= 0) {
         return nco;
@@ -318,14 +280,16 @@ rtl_metrics_compute_nco_metrics(int out_rate_hz) {
 
 static void
 rtl_metrics_store_nco_metrics(const rtl_metrics_nco_metrics& nco, int out_rate_hz) {
-    g_cfo_nco_hz.store(nco.cfo_hz, std::memory_order_relaxed);
+    const demod_state& demod = rtl_stream_demod();
+    RtlStreamShared& sh = rtl_stream_shared();
+    sh.cfo_nco_hz.store(nco.cfo_hz, std::memory_order_relaxed);
     int nco_freq_q15 = static_cast<int>(lrint(nco.total_freq_rad * (32768.0 / (2.0 * M_PI))));
-    g_nco_q15.store(nco_freq_q15, std::memory_order_relaxed);
-    g_demod_rate_hz.store(out_rate_hz, std::memory_order_relaxed);
-    g_costas_err_avg_q14.store(demod.costas_err_avg_q14, std::memory_order_relaxed);
-    g_costas_err_raw_avg_q14.store(demod.costas_err_raw_avg_q14, std::memory_order_relaxed);
-    g_costas_conf_avg_q14.store(demod.costas_conf_avg_q14, std::memory_order_relaxed);
-    g_costas_zero_conf_pct.store(demod.costas_zero_conf_pct, std::memory_order_relaxed);
+    sh.nco_q15.store(nco_freq_q15, std::memory_order_relaxed);
+    sh.demod_rate_hz.store(out_rate_hz, std::memory_order_relaxed);
+    sh.costas_err_avg_q14.store(demod.costas_err_avg_q14, std::memory_order_relaxed);
+    sh.costas_err_raw_avg_q14.store(demod.costas_err_raw_avg_q14, std::memory_order_relaxed);
+    sh.costas_conf_avg_q14.store(demod.costas_conf_avg_q14, std::memory_order_relaxed);
+    sh.costas_zero_conf_pct.store(demod.costas_zero_conf_pct, std::memory_order_relaxed);
 }
 
 /**
@@ -340,22 +304,25 @@ rtl_metrics_store_nco_metrics(const rtl_metrics_nco_metrics& nco, int out_rate_h
  */
 void
 rtl_metrics_update_spectrum_from_iq(const float* iq_interleaved, int len_interleaved, int out_rate_hz) {
+    const demod_state& demod = rtl_stream_demod();
+    RtlStreamShared& sh = rtl_stream_shared();
     if (!iq_interleaved || len_interleaved < 2) {
         return;
     }
     const int pairs = len_interleaved >> 1;
     int N = rtl_metrics_fft_size();
-    alignas(16) static float z[2 * kSpecMaxN];
+    /* Per thread: every pipeline's demod thread runs this on its own block. */
+    alignas(16) static thread_local float z[2 * kRtlSpecMaxN];
     rtl_metrics_fft_frame frame = rtl_metrics_prepare_fft_input(iq_interleaved, pairs, N, z);
     double phase_cfo_hz = rtl_metrics_phase_cfo_hz(iq_interleaved, frame, out_rate_hz);
-    g_resid_cfo_phase_hz.store(phase_cfo_hz, std::memory_order_relaxed);
+    sh.resid_cfo_phase_hz.store(phase_cfo_hz, std::memory_order_relaxed);
 
-    if (g_spec_fft_setup.forward(N, z)) {
+    if (sh.spec_fft_setup.forward(N, z)) {
         rtl_metrics_smooth_spectrum_bins(N, out_rate_hz, z);
     }
     rtl_metrics_peak_metrics peak = rtl_metrics_compute_peak_metrics(N);
-    g_spec_peak_db.store(peak.p_max, std::memory_order_relaxed);
-    g_spec_snr_db.store(peak.spec_snr_db, std::memory_order_relaxed);
+    sh.spec_peak_db.store(peak.p_max, std::memory_order_relaxed);
+    sh.spec_snr_db.store(peak.spec_snr_db, std::memory_order_relaxed);
 
     /* NCO CFO from CQPSK band-edge/Costas recovery (native float freq in rad/sample, scaled by Fs/(2π))
      *
@@ -370,13 +337,13 @@ rtl_metrics_update_spectrum_from_iq(const float* iq_interleaved, int len_interle
     rtl_metrics_store_nco_metrics(nco, out_rate_hz);
 
     /* Store FLL band-edge freq for UI access. */
-    g_fll_band_edge_freq_rad.store(static_cast<double>(demod.fll_band_edge_state.freq), std::memory_order_relaxed);
+    sh.fll_band_edge_freq_rad.store(static_cast<double>(demod.fll_band_edge_state.freq), std::memory_order_relaxed);
 
     /* CQPSK lock is loop-health based, not an SNR proxy: require the carrier NCO
      * to be stable, the Gardner TED eye metric to be positive, and Costas phase
      * error to be bounded. */
     int locked = cqpsk_loop_lock_heuristic(nco.total_freq_rad, out_rate_hz);
-    g_carrier_lock.store(locked, std::memory_order_relaxed);
+    sh.carrier_lock.store(locked, std::memory_order_relaxed);
 }
 
 /* Spectrum and carrier diagnostics query helpers. */
@@ -393,25 +360,26 @@ rtl_metrics_update_spectrum_from_iq(const float* iq_interleaved, int len_interle
  */
 extern "C" int
 rtl_stream_spectrum_get(float* out_db, int max_bins, int* out_rate) {
+    RtlStreamShared& sh = rtl_stream_shared();
     if (!out_db || max_bins <= 0) {
         return 0;
     }
-    if (g_spec_ready.load(std::memory_order_acquire) == 0) {
+    if (sh.spec_ready.load(std::memory_order_acquire) == 0) {
         return 0;
     }
-    int N = g_spec_N.load(std::memory_order_relaxed);
+    int N = sh.spec_N.load(std::memory_order_relaxed);
     if (N < 64) {
         N = 64;
     }
-    if (N > kSpecMaxN) {
-        N = kSpecMaxN;
+    if (N > kRtlSpecMaxN) {
+        N = kRtlSpecMaxN;
     }
     int n = (max_bins < N) ? max_bins : N;
     for (int i = 0; i < n; i++) {
-        out_db[i] = g_spec_db[i];
+        out_db[i] = sh.spec_db[i];
     }
     if (out_rate) {
-        *out_rate = g_spec_rate_hz.load(std::memory_order_relaxed);
+        *out_rate = sh.spec_rate_hz.load(std::memory_order_relaxed);
     }
     return n;
 }
@@ -419,7 +387,7 @@ rtl_stream_spectrum_get(float* out_db, int max_bins, int* out_rate) {
 /**
  * @brief Configure the FFT size used for spectrum exports.
  *
- * The size is clamped to [64, kSpecMaxN] and rounded up to the next power of
+ * The size is clamped to [64, kRtlSpecMaxN] and rounded up to the next power of
  * two for the pffft complex transform.
  *
  * @param n Requested FFT length (bins).
@@ -430,17 +398,17 @@ rtl_stream_spectrum_set_size(int n) {
     if (n < 64) {
         n = 64;
     }
-    if (n > kSpecMaxN) {
-        n = kSpecMaxN;
+    if (n > kRtlSpecMaxN) {
+        n = kRtlSpecMaxN;
     }
     int p = 64;
     while (p < n) {
         p <<= 1;
     }
-    if (p > kSpecMaxN) {
-        p = kSpecMaxN;
+    if (p > kRtlSpecMaxN) {
+        p = kRtlSpecMaxN;
     }
-    g_spec_N.store(p, std::memory_order_relaxed);
+    rtl_stream_shared().spec_N.store(p, std::memory_order_relaxed);
     return p;
 }
 
@@ -450,12 +418,12 @@ rtl_stream_spectrum_set_size(int n) {
  */
 extern "C" int
 rtl_stream_spectrum_get_size(void) {
-    int N = g_spec_N.load(std::memory_order_relaxed);
+    int N = rtl_stream_shared().spec_N.load(std::memory_order_relaxed);
     if (N < 64) {
         N = 64;
     }
-    if (N > kSpecMaxN) {
-        N = kSpecMaxN;
+    if (N > kRtlSpecMaxN) {
+        N = kRtlSpecMaxN;
     }
     return N;
 }
@@ -463,56 +431,58 @@ rtl_stream_spectrum_get_size(void) {
 /** @brief Return the current NCO CFO estimate in Hz derived from Costas/FLL. */
 extern "C" double
 rtl_stream_get_cfo_hz(void) {
-    return g_cfo_nco_hz.load(std::memory_order_relaxed);
+    return rtl_stream_shared().cfo_nco_hz.load(std::memory_order_relaxed);
 }
 
 /** @brief Return 1 when the CQPSK carrier lock heuristic is satisfied. */
 extern "C" int
 rtl_stream_get_carrier_lock(void) {
-    return g_carrier_lock.load(std::memory_order_relaxed) ? 1 : 0;
+    return rtl_stream_shared().carrier_lock.load(std::memory_order_relaxed) ? 1 : 0;
 }
 
 /** @brief Get the current FLL/Costas NCO frequency in Q15 cycles/sample. */
 extern "C" int
 rtl_stream_get_nco_q15(void) {
-    return g_nco_q15.load(std::memory_order_relaxed);
+    return rtl_stream_shared().nco_q15.load(std::memory_order_relaxed);
 }
 
 /** @brief Get the demodulator sample rate (Hz) used for CFO scaling. */
 extern "C" int
 rtl_stream_get_demod_rate_hz(void) {
-    return g_demod_rate_hz.load(std::memory_order_relaxed);
+    return rtl_stream_shared().demod_rate_hz.load(std::memory_order_relaxed);
 }
 
 /** @brief Get the smoothed Costas error term (Q14). */
 extern "C" int
 rtl_stream_get_costas_err_q14(void) {
-    return g_costas_err_avg_q14.load(std::memory_order_relaxed);
+    return rtl_stream_shared().costas_err_avg_q14.load(std::memory_order_relaxed);
 }
 
 /** @brief Get Costas discriminator health metrics for the latest DSP block. */
 extern "C" int
 rtl_stream_get_costas_metrics(rtl_stream_costas_metrics* out) {
+    RtlStreamShared& sh = rtl_stream_shared();
     if (!out) {
         return -1;
     }
-    out->err_smooth_avg_q14 = g_costas_err_avg_q14.load(std::memory_order_relaxed);
-    out->err_raw_avg_q14 = g_costas_err_raw_avg_q14.load(std::memory_order_relaxed);
-    out->confidence_avg_q14 = g_costas_conf_avg_q14.load(std::memory_order_relaxed);
-    out->zero_conf_pct = g_costas_zero_conf_pct.load(std::memory_order_relaxed);
+    out->err_smooth_avg_q14 = sh.costas_err_avg_q14.load(std::memory_order_relaxed);
+    out->err_raw_avg_q14 = sh.costas_err_raw_avg_q14.load(std::memory_order_relaxed);
+    out->confidence_avg_q14 = sh.costas_conf_avg_q14.load(std::memory_order_relaxed);
+    out->zero_conf_pct = sh.costas_zero_conf_pct.load(std::memory_order_relaxed);
     return 0;
 }
 
 /** @brief Return the FLL band-edge frequency estimate in Hz. */
 extern "C" double
 rtl_stream_get_fll_band_edge_freq_hz(void) {
-    int Fs = g_demod_rate_hz.load(std::memory_order_relaxed);
+    RtlStreamShared& sh = rtl_stream_shared();
+    int Fs = sh.demod_rate_hz.load(std::memory_order_relaxed);
     if (Fs <= 0) {
         return 0.0;
     }
     /* FLL band-edge freq is in rad/sample; convert to Hz: f_hz = freq * Fs / (2π).
      * Read from atomic to avoid data race with demod thread. */
-    double freq_rad = g_fll_band_edge_freq_rad.load(std::memory_order_relaxed);
+    double freq_rad = sh.fll_band_edge_freq_rad.load(std::memory_order_relaxed);
     return freq_rad * static_cast<double>(Fs) / (2.0 * M_PI);
 }
 
@@ -520,32 +490,32 @@ rtl_stream_get_fll_band_edge_freq_hz(void) {
 /** @brief Get the smoothed C4FM SNR estimate in dB (negative when unavailable). */
 extern "C" double
 rtl_stream_get_snr_c4fm(void) {
-    return g_snr_c4fm_db.load(std::memory_order_relaxed);
+    return rtl_stream_shared().snr_c4fm_db.load(std::memory_order_relaxed);
 }
 
 /** @brief Get the smoothed CQPSK SNR estimate in dB (negative when unavailable). */
 extern "C" double
 rtl_stream_get_snr_cqpsk(void) {
-    return g_snr_qpsk_db.load(std::memory_order_relaxed);
+    return rtl_stream_shared().snr_qpsk_db.load(std::memory_order_relaxed);
 }
 
 /** @brief Get the smoothed GFSK SNR estimate in dB (negative when unavailable). */
 extern "C" double
 rtl_stream_get_snr_gfsk(void) {
-    return g_snr_gfsk_db.load(std::memory_order_relaxed);
+    return rtl_stream_shared().snr_gfsk_db.load(std::memory_order_relaxed);
 }
 
 /* Supervisory tuner autogain runtime control */
 /** @brief Return the supervisory tuner auto-gain flag (1=enabled). */
 extern "C" int
 rtl_stream_get_tuner_autogain(void) {
-    return g_tuner_autogain_on.load(std::memory_order_relaxed) ? 1 : 0;
+    return rtl_stream_shared().tuner_autogain_on.load(std::memory_order_relaxed) ? 1 : 0;
 }
 
 /** @brief Enable or disable supervisory tuner auto-gain (atomic flag). */
 extern "C" void
 rtl_stream_set_tuner_autogain(int onoff) {
-    g_tuner_autogain_on.store(onoff ? 1 : 0, std::memory_order_relaxed);
+    rtl_stream_shared().tuner_autogain_on.store(onoff ? 1 : 0, std::memory_order_relaxed);
 }
 
 /**
@@ -566,26 +536,27 @@ rtl_stream_set_tuner_autogain(int onoff) {
 int
 rtl_stream_auto_ppm_get_status(int* enabled, double* snr_db, double* df_hz, double* est_ppm, int* last_dir,
                                int* cooldown, int* locked) {
+    RtlStreamShared& sh = rtl_stream_shared();
     if (enabled) {
-        *enabled = g_auto_ppm_enabled.load(std::memory_order_relaxed);
+        *enabled = sh.auto_ppm_enabled.load(std::memory_order_relaxed);
     }
     if (snr_db) {
-        *snr_db = g_auto_ppm_snr_db.load(std::memory_order_relaxed);
+        *snr_db = sh.auto_ppm_snr_db.load(std::memory_order_relaxed);
     }
     if (df_hz) {
-        *df_hz = g_auto_ppm_df_hz.load(std::memory_order_relaxed);
+        *df_hz = sh.auto_ppm_df_hz.load(std::memory_order_relaxed);
     }
     if (est_ppm) {
-        *est_ppm = g_auto_ppm_est_ppm.load(std::memory_order_relaxed);
+        *est_ppm = sh.auto_ppm_est_ppm.load(std::memory_order_relaxed);
     }
     if (last_dir) {
-        *last_dir = g_auto_ppm_last_dir.load(std::memory_order_relaxed);
+        *last_dir = sh.auto_ppm_last_dir.load(std::memory_order_relaxed);
     }
     if (cooldown) {
-        *cooldown = g_auto_ppm_cooldown.load(std::memory_order_relaxed);
+        *cooldown = sh.auto_ppm_cooldown.load(std::memory_order_relaxed);
     }
     if (locked) {
-        *locked = g_auto_ppm_locked.load(std::memory_order_relaxed);
+        *locked = sh.auto_ppm_locked.load(std::memory_order_relaxed);
     }
     return 0;
 }
@@ -593,7 +564,7 @@ rtl_stream_auto_ppm_get_status(int* enabled, double* snr_db, double* df_hz, doub
 /** @brief Return 1 if auto-PPM training is active. */
 int
 dsd_rtl_stream_auto_ppm_training_active(void) {
-    return g_auto_ppm_training.load(std::memory_order_relaxed) ? 1 : 0;
+    return rtl_stream_shared().auto_ppm_training.load(std::memory_order_relaxed) ? 1 : 0;
 }
 
 /**
@@ -606,14 +577,15 @@ dsd_rtl_stream_auto_ppm_training_active(void) {
  */
 int
 rtl_stream_auto_ppm_get_lock(int* ppm, double* snr_db, double* df_hz) {
+    RtlStreamShared& sh = rtl_stream_shared();
     if (ppm) {
-        *ppm = g_auto_ppm_lock_ppm.load(std::memory_order_relaxed);
+        *ppm = sh.auto_ppm_lock_ppm.load(std::memory_order_relaxed);
     }
     if (snr_db) {
-        *snr_db = g_auto_ppm_lock_snr_db.load(std::memory_order_relaxed);
+        *snr_db = sh.auto_ppm_lock_snr_db.load(std::memory_order_relaxed);
     }
     if (df_hz) {
-        *df_hz = g_auto_ppm_lock_df_hz.load(std::memory_order_relaxed);
+        *df_hz = sh.auto_ppm_lock_df_hz.load(std::memory_order_relaxed);
     }
     return 0;
 }
@@ -624,7 +596,7 @@ rtl_stream_auto_ppm_get_lock(int* ppm, double* snr_db, double* df_hz) {
  */
 void
 rtl_stream_set_auto_ppm(int onoff) {
-    g_auto_ppm_user_en.store(onoff ? 1 : 0, std::memory_order_relaxed);
+    rtl_stream_shared().auto_ppm_user_en.store(onoff ? 1 : 0, std::memory_order_relaxed);
 }
 
 /**
@@ -633,12 +605,13 @@ rtl_stream_set_auto_ppm(int onoff) {
  */
 int
 rtl_stream_get_auto_ppm(void) {
-    int u = g_auto_ppm_user_en.load(std::memory_order_relaxed);
+    RtlStreamShared& sh = rtl_stream_shared();
+    int u = sh.auto_ppm_user_en.load(std::memory_order_relaxed);
     if (u == 0) {
         return 0;
     }
     if (u == 1) {
         return 1;
     }
-    return g_auto_ppm_enabled.load(std::memory_order_relaxed) ? 1 : 0;
+    return sh.auto_ppm_enabled.load(std::memory_order_relaxed) ? 1 : 0;
 }
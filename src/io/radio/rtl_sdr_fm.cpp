@@ -30,6 +30,7 @@
 #include <dsd-neo/dsp/demod_state.h>
 #include <dsd-neo/dsp/math_utils.h>
 #include <dsd-neo/dsp/resampler.h>
+#include <dsd-neo/dsp/simd_widen.h>
 #include <dsd-neo/dsp/snr_bias.h>
 #include <dsd-neo/dsp/snr_estimator.h>
 #include <dsd-neo/dsp/ted.h>
@@ -54,9 +55,12 @@
 #include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #include <dsd-neo/runtime/threading.h>
 #include <dsd-neo/runtime/unicode.h>
+#include <dsd-neo/runtime/worker_pool.h>
+#include <errno.h>
 #include <limits.h>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -102,7 +106,6 @@ static inline void eye_ring_append_i_chan(const float* iq_interleaved, int len_i
 #define FREQUENCIES_LIMIT   1000
 
 static int lcm_post[17] = {1, 1, 1, 3, 1, 5, 3, 7, 1, 9, 5, 11, 3, 13, 7, 15, 1};
-static int ACTUAL_BUF_LENGTH;
 
 static const double kPi = 3.14159265358979323846;
 
@@ -167,15 +170,6 @@ assume_aligned_ptr(const T* p, size_t /*align_unused*/) {
 #define DSD_NEO_RESTRICT
 #endif
 
-// UDP control handle
-static struct udp_control* g_udp_ctrl = NULL;
-
-/* DSP baseband for RTL path in Hz (derived from opts->rtl_dsp_bw_khz). */
-static int rtl_dsp_bw_hz;
-static short int volume_multiplier;
-static uint16_t port;
-static char udp_control_bindaddr[64] = "127.0.0.1";
-
 namespace {
 
 static const size_t kRetuneCompletionResultSlots = 256U;
@@ -291,12 +285,6 @@ struct controller_state {
 
 } // namespace
 
-struct demod_state demod;
-static struct rtl_device* rtl_device_handle = NULL;
-static struct dongle_state dongle;
-static struct output_state output;
-static struct controller_state controller;
-
 namespace {
 struct RtlTuneCompletionRegistration {
     RtlTuneCompletionRegistration(rtl_stream_tune_completion_callback callback_in, void* user_data_in)
@@ -315,36 +303,319 @@ static std::mutex g_tune_completion_callback_update_mutex;
 static std::shared_ptr<RtlTuneCompletionRegistration> g_tune_completion_registration;
 static thread_local const RtlTuneCompletionRegistration* g_active_tune_completion_registration = nullptr;
 
-static struct input_ring_state input_ring;
-static dsd_iq_capture_writer* g_iq_capture_writer = NULL;
-/* Controller can request a ring purge; consumer/demod performs the discard safely. */
-static std::atomic<int> g_ring_purge_pending{0};
-static std::atomic<uint32_t> g_retune_diag_seq{0};
-static std::atomic<uint32_t> g_retune_diag_freq_hz{0};
-static std::atomic<int> g_retune_diag_reason{0};
-static std::atomic<int> g_retune_diag_blocks_remaining{0};
-static std::atomic<uint32_t> g_retune_settle_seq{0};
-static std::atomic<int> g_retune_settle_blocks_remaining{0};
-static std::atomic<uint32_t> g_rtl_output_generation{1};
-static std::atomic<int> g_fsk_reacquire_pending{0};
-static std::atomic<int> g_cqpsk_reacquire_pending{0};
-static std::atomic<int> g_fsk_modem_reset_pending{0};
-static std::atomic<int> g_fsk_modem_config_pending{0};
-static std::atomic<int> g_fsk_modem_config_symbol_rate_hz{4800};
-static std::atomic<int> g_fsk_modem_config_levels{4};
-static std::atomic<int> g_fsk_modem_config_channel_profile{DSD_CH_LPF_PROFILE_WIDE};
-static std::atomic<int> g_fsk_phase_cfo_valid{0};
-static std::atomic<double> g_fsk_phase_cfo_hz{0.0};
-static std::mutex g_pending_retune_profile_mutex;
-static RtlRetuneProfile g_pending_retune_profile;
-static std::atomic<uint32_t> g_replay_event_retune_count{0};
-static std::atomic<uint32_t> g_replay_event_mute_count{0};
-static std::atomic<uint32_t> g_replay_event_reset_count{0};
-static std::atomic<uint32_t> g_replay_event_last_frequency_hz{0};
-static std::atomic<uint64_t> g_replay_event_last_mute_bytes{0};
-static std::atomic<int> g_replay_event_last_reset_reason{0};
-static std::atomic<uint32_t> g_replay_loop_restart_count{0};
-static std::atomic<uint32_t> g_replay_loop_restart_last_frequency_hz{0};
+namespace {
+
+struct RtlSdrInternals {
+    struct rtl_device* device = nullptr;
+    struct dongle_state* dongle = nullptr;
+    struct demod_state* demod = nullptr;
+    struct output_state* output = nullptr;
+    struct controller_state* controller = nullptr;
+    struct input_ring_state* input_ring = nullptr;
+    struct udp_control** udp_ctrl_ptr = nullptr;
+    const dsd_opts* opts = nullptr; /* snapshot for mode hints (P25p1/2, etc.) */
+    /* Cooperative shutdown flag for threads launched by this stream */
+    std::atomic<int> should_exit{0};
+    std::atomic<int> controller_thread_started{0};
+    std::atomic<int> demod_thread_started{0};
+    std::atomic<int> async_started{0};
+
+    /* Replay EOF State Machine. See "Replay EOF State Machine" section. */
+    std::atomic<int> replay_input_eof{0};
+    std::atomic<int> replay_input_drained{0};
+    std::atomic<int> replay_demod_drained{0};
+    std::atomic<int> replay_output_drained{0};
+    std::atomic<int> replay_forced_stop{0};
+    std::atomic<uint64_t> replay_last_submit_gen{0U};
+    std::atomic<uint64_t> replay_last_submit_gen_at_eof{0U};
+    std::atomic<uint64_t> replay_last_consume_gen{0U};
+    dsd_mutex_t replay_eof_m{};
+    dsd_cond_t replay_eof_cond{};
+    int replay_eof_sync_inited = 0;
+
+    /* Watermark-based flow control for TCP lag resilience */
+    struct input_ring_watermark watermark{};
+};
+
+struct RtlRequestedPpmMirrors {
+    dsd_opts* active_opts = NULL;
+    dsd_opts* caller_opts = NULL;
+};
+
+struct RetuneSettleWindowState {
+    uint32_t active_seq;
+    int block_index;
+    int stable_run;
+    float prev_mean_abs;
+};
+
+struct DemodAutogainState {
+    int initialized = 0;
+    int blocks = 0;
+    int high = 0;
+    int low = 0;
+    int manual_target = 180;
+    int target_initialized = 0;
+    std::chrono::steady_clock::time_point next_allowed = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point hold_until{};
+    std::chrono::steady_clock::time_point probe_until{};
+    uint32_t last_freq = 0U;
+    uint32_t last_reconfigure_seq = 0U;
+    int probe_ms = 3000;
+    int seed_gain_db10 = 300;
+    double spec_snr_db = 6.0;
+    double inband_ratio = 0.60;
+    int up_step_db10 = 30;
+    int up_persist = 2;
+    int spec_pass = 0;
+};
+
+struct DemodMetricsState {
+    unsigned int dsp_metrics_block;
+    int c4fm_missed;
+    int qpsk_missed;
+    int gfsk_missed;
+    float qpsk_acc_i[256];
+    float qpsk_acc_q[256];
+    int qpsk_acc_n;
+};
+
+static const int kConstMaxPairs = 8192;
+static const int kEyeMax = 16384;
+
+} // namespace
+
+/*
+ * One demod/controller/output pipeline. The process always has a default
+ * instance for the classic single-stream path; dsd_rtl_stream_create() adds
+ * more, each with its own rings, metrics and retune state. Code in this file
+ * reaches the pipeline it runs for through rtl_cur(), which follows the
+ * calling thread's binding (dsd_rtl_stream_bind()). Threads started by a
+ * pipeline inherit the binding of the thread that started them.
+ */
+struct dsd_rtl_stream {
+    struct demod_state demod;
+    struct rtl_device* device = NULL;
+    struct dongle_state dongle;
+    struct output_state output;
+    struct controller_state controller;
+    struct input_ring_state input_ring;
+    /* Per-open state of the running stream; NULL while closed. */
+    struct RtlSdrInternals* internals = NULL;
+
+    struct udp_control* udp_ctrl = NULL;
+    /* DSP baseband for RTL path in Hz (derived from opts->rtl_dsp_bw_khz). */
+    int dsp_bw_hz = 0;
+    short int volume_multiplier = 0;
+    uint16_t udp_port = 0;
+    char udp_bindaddr[64] = "127.0.0.1";
+    int actual_buf_length = 0;
+    dsd_iq_capture_writer* iq_capture_writer = NULL;
+
+    /* Controller can request a ring purge; consumer/demod performs the discard safely. */
+    std::atomic<int> ring_purge_pending{0};
+    std::atomic<uint32_t> retune_diag_seq{0};
+    std::atomic<uint32_t> retune_diag_freq_hz{0};
+    std::atomic<int> retune_diag_reason{0};
+    std::atomic<int> retune_diag_blocks_remaining{0};
+    std::atomic<uint32_t> retune_settle_seq{0};
+    std::atomic<int> retune_settle_blocks_remaining{0};
+    std::atomic<uint32_t> output_generation{1};
+    std::atomic<int> fsk_reacquire_pending{0};
+    std::atomic<int> cqpsk_reacquire_pending{0};
+    std::atomic<int> fsk_modem_reset_pending{0};
+    std::atomic<int> fsk_modem_config_pending{0};
+    std::atomic<int> fsk_modem_config_symbol_rate_hz{4800};
+    std::atomic<int> fsk_modem_config_levels{4};
+    std::atomic<int> fsk_modem_config_channel_profile{DSD_CH_LPF_PROFILE_WIDE};
+    std::atomic<int> fsk_phase_cfo_valid{0};
+    std::atomic<double> fsk_phase_cfo_hz{0.0};
+    std::mutex pending_retune_profile_mutex;
+    RtlRetuneProfile pending_retune_profile;
+    std::atomic<uint32_t> replay_event_retune_count{0};
+    std::atomic<uint32_t> replay_event_mute_count{0};
+    std::atomic<uint32_t> replay_event_reset_count{0};
+    std::atomic<uint32_t> replay_event_last_frequency_hz{0};
+    std::atomic<uint64_t> replay_event_last_mute_bytes{0};
+    std::atomic<int> replay_event_last_reset_reason{0};
+    std::atomic<uint32_t> replay_loop_restart_count{0};
+    std::atomic<uint32_t> replay_loop_restart_last_frequency_hz{0};
+
+    dsd::io::radio::RtlAutoPpmController auto_ppm_controller;
+    /* Cleared at stream open when the backend cannot apply a frequency correction, so auto-PPM
+     * does not keep estimating an offset the device will silently discard. */
+    std::atomic<int> ppm_control_supported{1};
+
+    /* Keep the requested PPM value and its logical request generation paired so
+     * UI and read-thread activity cannot observe mixed snapshots. */
+    std::mutex requested_ppm_state_mutex;
+    RtlRequestedPpmMirrors requested_ppm_mirrors;
+
+    /* Cross-thread mirrors of the demod profile fields consumed by main-thread
+     * getters (output kind, symbol profile, TED SPS). The demod thread republishes
+     * them once per block; setters that run pre-start or under the demod-family
+     * gate publish immediately after writing. */
+    std::atomic<int> pub_output_kind{0};
+    std::atomic<int> pub_symbol_rate{4800};
+    std::atomic<int> pub_symbol_levels{4};
+    std::atomic<int> pub_channel_profile{0};
+    std::atomic<int> pub_ted_sps{10};
+    std::atomic<int> pub_ted_sps_override{0};
+    std::atomic<int> pub_cqpsk_enable{0};
+    std::atomic<int> pub_ted_bias_q14{0};
+    std::atomic<int> pub_rate_out{48000};
+
+    /* Track recency and source of SNR updates: src 1=direct (symbols), 2=fallback (eye/constellation) */
+    std::atomic<long long> snr_c4fm_last_ms{0};
+    std::atomic<int> snr_c4fm_src{0};
+    std::atomic<long long> snr_qpsk_last_ms{0};
+    std::atomic<int> snr_qpsk_src{0};
+    std::atomic<long long> snr_gfsk_last_ms{0};
+    std::atomic<int> snr_gfsk_src{0};
+    /* EMA state for direct SNR estimation (reset on retune for fast acquisition).
+     * These are atomic because snr_ema_reset() is called from the controller thread
+     * while the demod thread reads/writes them during SNR computation. */
+    std::atomic<double> snr_ema_c4fm{-100.0};
+    std::atomic<double> snr_ema_qpsk{-100.0};
+    std::atomic<double> snr_ema_gfsk{-100.0};
+    /* QPSK accumulator reset flag (actual buffer is in demod loop) */
+    std::atomic<int> snr_qpsk_acc_reset{0};
+
+    std::atomic<int> input_level_valid{0};
+    std::atomic<int> input_level_status{DSD_INPUT_LEVEL_UNKNOWN};
+    std::atomic<int> input_level_source{DSD_INPUT_LEVEL_SOURCE_UNKNOWN};
+    std::atomic<double> input_level_rms_dbfs{-120.0};
+    std::atomic<double> input_level_peak_dbfs{-120.0};
+    std::atomic<double> input_level_clip_pct{0.0};
+    std::atomic<uint64_t> input_level_sample_count{0U};
+    std::atomic<long long> input_level_updated{0};
+
+    std::atomic<int> decode_health_valid{0};
+    std::atomic<uint32_t> decode_health_generation{0};
+    std::atomic<unsigned int> decode_p25p1_fec_ok{0};
+    std::atomic<unsigned int> decode_p25p1_fec_err{0};
+    std::atomic<unsigned int> decode_p25p2_facch_ok{0};
+    std::atomic<unsigned int> decode_p25p2_facch_err{0};
+    std::atomic<unsigned int> decode_p25p2_sacch_ok{0};
+    std::atomic<unsigned int> decode_p25p2_sacch_err{0};
+    std::atomic<unsigned int> decode_p25p2_voice_err{0};
+
+    /* Demod-thread-only state carried across blocks. */
+    int sps_prev_ted_sps = 0;
+    RetuneSettleWindowState retune_settle_window = {};
+    DemodAutogainState autogain;
+    DemodMetricsState metrics = {};
+
+    /* Relaxed atomics: single demod-thread writer, main-thread reader. Tearing
+     * across samples is acceptable for display/estimation; atomics keep the
+     * unsynchronized access well-defined. Relaxed ops compile to plain moves. */
+    std::atomic<float> const_xy[kConstMaxPairs * 2]{};
+    std::atomic<int> const_head{0}; /* pairs written [0..kConstMaxPairs-1], wraps */
+    std::atomic<float> eye_buf[kEyeMax]{};
+    std::atomic<int> eye_head{0}; /* samples written [0..kEyeMax-1], wraps */
+
+    /* Deferred demod-profile request (see rtl_stream_consume_demod_profile_request). */
+    std::mutex profile_req_m;
+    std::atomic<int> profile_req_pending{0};
+    /* Guarded by profile_req_m: */
+    int profile_req_cqpsk = -1;   /* -1 = leave unchanged */
+    int profile_req_sym_rate = 0; /* <=0 = leave symbol profile unchanged */
+    int profile_req_levels = 0;
+    int profile_req_chan = -1;
+    int profile_req_ted_sps = -1; /* <0 = leave timing untouched, 0 = clear override only */
+    int profile_req_ted_sps_is_override = 0;
+
+    RtlStreamShared shared;
+};
+
+static dsd_rtl_stream g_default_rtl_stream;
+static thread_local dsd_rtl_stream* g_bound_rtl_stream = NULL;
+
+/* The pipeline the calling thread works for: its binding, else the default. */
+static inline dsd_rtl_stream&
+rtl_cur(void) {
+    dsd_rtl_stream* s = g_bound_rtl_stream;
+    return s ? *s : g_default_rtl_stream;
+}
+
+RtlStreamShared&
+rtl_stream_shared(void) {
+    return rtl_cur().shared;
+}
+
+demod_state&
+rtl_stream_demod(void) {
+    return rtl_cur().demod;
+}
+
+std::atomic<float>&
+rtl_stream_channel_pwr(void) {
+    return rtl_cur().shared.channel_pwr;
+}
+
+int
+rtl_stream_on_default_pipeline(void) {
+    return (&rtl_cur() == &g_default_rtl_stream) ? 1 : 0;
+}
+
+namespace {
+struct RtlBoundThreadStart {
+    dsd_rtl_stream* pipeline;
+    dsd_thread_fn fn;
+    void* arg;
+};
+} // namespace
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    rtl_bound_thread_entry(void* arg) {
+    RtlBoundThreadStart start = *static_cast<RtlBoundThreadStart*>(arg);
+    delete static_cast<RtlBoundThreadStart*>(arg);
+    g_bound_rtl_stream = start.pipeline;
+    return start.fn(start.arg);
+}
+
+int
+rtl_stream_thread_create(dsd_thread_t* thread, dsd_thread_fn fn, void* arg) {
+    if (!thread || !fn) {
+        return EINVAL;
+    }
+    RtlBoundThreadStart* start = new (std::nothrow) RtlBoundThreadStart{g_bound_rtl_stream, fn, arg};
+    if (!start) {
+        return ENOMEM;
+    }
+    int rc = dsd_thread_create(thread, rtl_bound_thread_entry, start);
+    if (rc != 0) {
+        delete start;
+    }
+    return rc;
+}
+
+extern "C" dsd_rtl_stream*
+dsd_rtl_stream_create(void) {
+    return new (std::nothrow) dsd_rtl_stream();
+}
+
+extern "C" void
+dsd_rtl_stream_destroy(dsd_rtl_stream* stream) {
+    if (!stream || stream == &g_default_rtl_stream) {
+        return;
+    }
+    if (g_bound_rtl_stream == stream) {
+        g_bound_rtl_stream = NULL;
+    }
+    stream->shared.spec_fft_setup.release();
+    delete stream;
+}
+
+extern "C" dsd_rtl_stream*
+dsd_rtl_stream_bind(dsd_rtl_stream* stream) {
+    dsd_rtl_stream* prev = g_bound_rtl_stream;
+    g_bound_rtl_stream = (stream == &g_default_rtl_stream) ? NULL : stream;
+    return prev;
+}
 
 static void rtl_stream_consume_demod_profile_request(void);
 static void rtl_stream_clear_demod_profile_request(void);
@@ -385,30 +656,24 @@ static const int kRetuneSettleMaxBlocks = 1;
 static const float kRetuneSettleStableRel = 0.055f;
 static const float kRetuneSettleMinMeanAbs = 0.015f;
 
-static dsd::io::radio::RtlAutoPpmController g_auto_ppm_controller;
-
-/* Cleared at stream open when the backend cannot apply a frequency correction, so auto-PPM
- * does not keep estimating an offset the device will silently discard. */
-static std::atomic<int> g_ppm_control_supported{1};
-
 static inline uint32_t
 load_dongle_frequency(void) {
-    return dongle.freq.load(std::memory_order_acquire);
+    return rtl_cur().dongle.freq.load(std::memory_order_acquire);
 }
 
 static inline void
 store_dongle_frequency(uint32_t frequency_hz) {
-    dongle.freq.store(frequency_hz, std::memory_order_release);
+    rtl_cur().dongle.freq.store(frequency_hz, std::memory_order_release);
 }
 
 static inline uint32_t
 load_dongle_rate(void) {
-    return dongle.rate.load(std::memory_order_acquire);
+    return rtl_cur().dongle.rate.load(std::memory_order_acquire);
 }
 
 static inline void
 store_dongle_rate(uint32_t sample_rate_hz) {
-    dongle.rate.store(sample_rate_hz, std::memory_order_release);
+    rtl_cur().dongle.rate.store(sample_rate_hz, std::memory_order_release);
 }
 
 static uint32_t
@@ -424,24 +689,26 @@ clamp_capture_frequency_hz(int64_t frequency_hz) {
 
 static uint32_t
 capture_frequency_for_rate(int64_t center_freq_hz, uint32_t capture_rate_hz) {
+    dsd_rtl_stream& rtl = rtl_cur();
     int64_t capture_freq_hz = center_freq_hz;
-    if (!dongle.offset_tuning && !disable_fs4_shift) {
+    if (!rtl.dongle.offset_tuning && !disable_fs4_shift) {
         capture_freq_hz += (int64_t)(capture_rate_hz / 4U);
     }
-    capture_freq_hz += ((int64_t)controller.edge * (int64_t)demod.rate_in) / 2;
+    capture_freq_hz += ((int64_t)rtl.controller.edge * (int64_t)rtl.demod.rate_in) / 2;
     return clamp_capture_frequency_hz(capture_freq_hz);
 }
 
 static int
 demod_output_rate_for_capture_rate(uint32_t capture_rate_hz) {
-    int base_decim = (demod.downsample_passes > 0) ? (1 << demod.downsample_passes) : 1;
+    dsd_rtl_stream& rtl = rtl_cur();
+    int base_decim = (rtl.demod.downsample_passes > 0) ? (1 << rtl.demod.downsample_passes) : 1;
     if (base_decim < 1) {
         base_decim = 1;
     }
 
     int out_rate = (int)(capture_rate_hz / (uint32_t)base_decim);
-    if (demod.post_downsample > 1) {
-        out_rate /= demod.post_downsample;
+    if (rtl.demod.post_downsample > 1) {
+        out_rate /= rtl.demod.post_downsample;
         if (out_rate < 1) {
             out_rate = 1;
         }
@@ -457,7 +724,7 @@ retune_capture_frequency_for_actual_rate(uint32_t center_freq_hz, uint32_t reque
         return;
     }
 
-    int rc = rtl_device_set_frequency(rtl_device_handle, actual_capture_freq_hz);
+    int rc = rtl_device_set_frequency(rtl_cur().device, actual_capture_freq_hz);
     if (rc == 0) {
         store_dongle_frequency(actual_capture_freq_hz);
         LOG_INFO("Adjusted fs/4 capture center for actual device rate: center=%u, capture=%u Hz.\n", center_freq_hz,
@@ -472,16 +739,17 @@ retune_capture_frequency_for_actual_rate(uint32_t center_freq_hz, uint32_t reque
 static uint32_t
 apply_actual_capture_rate(uint32_t center_freq_hz, uint32_t requested_capture_freq_hz,
                           uint32_t requested_capture_rate_hz, uint32_t actual_capture_rate_hz) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (actual_capture_rate_hz == 0 || actual_capture_rate_hz == requested_capture_rate_hz) {
         return requested_capture_rate_hz;
     }
 
     store_dongle_rate(actual_capture_rate_hz);
-    demod.rate_out = demod_output_rate_for_capture_rate(actual_capture_rate_hz);
-    demod.capture_rate_device_forced = 1;
+    rtl.demod.rate_out = demod_output_rate_for_capture_rate(actual_capture_rate_hz);
+    rtl.demod.capture_rate_device_forced = 1;
     retune_capture_frequency_for_actual_rate(center_freq_hz, requested_capture_freq_hz, actual_capture_rate_hz);
     LOG_INFO("Adjusted to actual device rate: requested=%u, actual=%u, demod_out=%d Hz.\n", requested_capture_rate_hz,
-             actual_capture_rate_hz, demod.rate_out);
+             actual_capture_rate_hz, rtl.demod.rate_out);
     return actual_capture_rate_hz;
 }
 
@@ -497,10 +765,11 @@ struct CaptureSettingsSnapshot {
 
 static CaptureSettingsSnapshot
 capture_settings_snapshot(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     CaptureSettingsSnapshot snapshot{};
-    snapshot.downsample_passes = demod.downsample_passes;
-    snapshot.output_scale = demod.output_scale;
-    snapshot.rate_out = demod.rate_out;
+    snapshot.downsample_passes = rtl.demod.downsample_passes;
+    snapshot.output_scale = rtl.demod.output_scale;
+    snapshot.rate_out = rtl.demod.rate_out;
     snapshot.dongle_frequency_hz = load_dongle_frequency();
     snapshot.dongle_rate_hz = load_dongle_rate();
     return snapshot;
@@ -517,12 +786,13 @@ capture_settings_snapshot_for_center(uint32_t center_freq_hz) {
 
 static void
 restore_capture_rate_settings(const CaptureSettingsSnapshot* snapshot) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!snapshot) {
         return;
     }
-    demod.downsample_passes = snapshot->downsample_passes;
-    demod.output_scale = snapshot->output_scale;
-    demod.rate_out = snapshot->rate_out;
+    rtl.demod.downsample_passes = snapshot->downsample_passes;
+    rtl.demod.output_scale = snapshot->output_scale;
+    rtl.demod.rate_out = snapshot->rate_out;
     store_dongle_rate(snapshot->dongle_rate_hz);
 }
 
@@ -539,47 +809,11 @@ restore_capture_settings(const CaptureSettingsSnapshot* snapshot) {
 
 static void
 controller_request_input_purge(void) {
-    input_ring_request_discard(&input_ring);
-    g_ring_purge_pending.store(1, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    input_ring_request_discard(&rtl.input_ring);
+    rtl.ring_purge_pending.store(1, std::memory_order_release);
 }
 
-namespace {
-
-struct RtlSdrInternals {
-    struct rtl_device* device = nullptr;
-    struct dongle_state* dongle = nullptr;
-    struct demod_state* demod = nullptr;
-    struct output_state* output = nullptr;
-    struct controller_state* controller = nullptr;
-    struct input_ring_state* input_ring = nullptr;
-    struct udp_control** udp_ctrl_ptr = nullptr;
-    const dsd_opts* opts = nullptr; /* snapshot for mode hints (P25p1/2, etc.) */
-    /* Cooperative shutdown flag for threads launched by this stream */
-    std::atomic<int> should_exit{0};
-    std::atomic<int> controller_thread_started{0};
-    std::atomic<int> demod_thread_started{0};
-    std::atomic<int> async_started{0};
-
-    /* Replay EOF State Machine. See "Replay EOF State Machine" section. */
-    std::atomic<int> replay_input_eof{0};
-    std::atomic<int> replay_input_drained{0};
-    std::atomic<int> replay_demod_drained{0};
-    std::atomic<int> replay_output_drained{0};
-    std::atomic<int> replay_forced_stop{0};
-    std::atomic<uint64_t> replay_last_submit_gen{0U};
-    std::atomic<uint64_t> replay_last_submit_gen_at_eof{0U};
-    std::atomic<uint64_t> replay_last_consume_gen{0U};
-    dsd_mutex_t replay_eof_m{};
-    dsd_cond_t replay_eof_cond{};
-    int replay_eof_sync_inited = 0;
-
-    /* Watermark-based flow control for TCP lag resilience */
-    struct input_ring_watermark watermark{};
-};
-
-} // namespace
-
-static struct RtlSdrInternals* g_stream = NULL;
 #if defined(DSD_NEO_ENABLE_INTERNAL_TEST_HOOKS)
 static struct RtlSdrInternals g_cqpsk_toggle_test_stream;
 #endif
@@ -588,37 +822,24 @@ ring_read_available(struct output_state* o, float* out, size_t count) {
     if (!o || !o->buffer || !out || count == 0) {
         return 0;
     }
-    size_t got = 0;
-    size_t tail = o->tail.load();
-    const size_t head = o->head.load();
-    while (got < count && tail != head) {
-        out[got++] = o->buffer[tail];
-        tail++;
-        if (tail >= o->capacity) {
-            tail = 0;
-        }
-    }
+    size_t got = o->read(out, count);
     if (got > 0) {
-        o->tail.store(tail);
         safe_cond_signal(&o->space, &o->ready_m);
     }
     return (int)got;
 }
 
-/* Keep the requested PPM value and its logical request generation paired so
- * UI and read-thread activity cannot observe mixed snapshots. */
-static std::mutex g_requested_ppm_state_mutex;
-
 static int radio_source_is_iq_replay(const dsd_opts* opts);
 
 static inline int
 stream_is_replay_active(void) {
-    return (g_stream && g_stream->opts && radio_source_is_iq_replay(g_stream->opts)) ? 1 : 0;
+    dsd_rtl_stream& rtl = rtl_cur();
+    return (rtl.internals && rtl.internals->opts && radio_source_is_iq_replay(rtl.internals->opts)) ? 1 : 0;
 }
 
 static inline int
 rtl_stream_context_active(void) {
-    struct RtlSdrInternals* s = g_stream;
+    struct RtlSdrInternals* s = rtl_cur().internals;
     if (!s || s->should_exit.load(std::memory_order_acquire)) {
         return 0;
     }
@@ -630,6 +851,7 @@ rtl_stream_context_active(void) {
 
 static void
 stream_reset_replay_eof_state(struct RtlSdrInternals* s) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s) {
         return;
     }
@@ -641,18 +863,19 @@ stream_reset_replay_eof_state(struct RtlSdrInternals* s) {
     s->replay_last_submit_gen.store(0, std::memory_order_release);
     s->replay_last_submit_gen_at_eof.store(0, std::memory_order_release);
     s->replay_last_consume_gen.store(0, std::memory_order_release);
-    g_replay_event_retune_count.store(0, std::memory_order_release);
-    g_replay_event_mute_count.store(0, std::memory_order_release);
-    g_replay_event_reset_count.store(0, std::memory_order_release);
-    g_replay_event_last_frequency_hz.store(0, std::memory_order_release);
-    g_replay_event_last_mute_bytes.store(0, std::memory_order_release);
-    g_replay_event_last_reset_reason.store(0, std::memory_order_release);
-    g_replay_loop_restart_count.store(0, std::memory_order_release);
-    g_replay_loop_restart_last_frequency_hz.store(0, std::memory_order_release);
+    rtl.replay_event_retune_count.store(0, std::memory_order_release);
+    rtl.replay_event_mute_count.store(0, std::memory_order_release);
+    rtl.replay_event_reset_count.store(0, std::memory_order_release);
+    rtl.replay_event_last_frequency_hz.store(0, std::memory_order_release);
+    rtl.replay_event_last_mute_bytes.store(0, std::memory_order_release);
+    rtl.replay_event_last_reset_reason.store(0, std::memory_order_release);
+    rtl.replay_loop_restart_count.store(0, std::memory_order_release);
+    rtl.replay_loop_restart_last_frequency_hz.store(0, std::memory_order_release);
 }
 
 static void
 rtl_replay_on_input_drained(void* user) {
+    dsd_rtl_stream& rtl = rtl_cur();
     struct RtlSdrInternals* s = static_cast<RtlSdrInternals*>(user);
     if (!s) {
         return;
@@ -660,7 +883,7 @@ rtl_replay_on_input_drained(void* user) {
     dsd_mutex_lock(&s->replay_eof_m);
     dsd_cond_broadcast(&s->replay_eof_cond);
     dsd_mutex_unlock(&s->replay_eof_m);
-    safe_cond_signal(&output.ready, &output.ready_m);
+    ring_signal_ready(&rtl.output);
 }
 
 static uint64_t
@@ -686,26 +909,28 @@ rtl_stream_test_replay_acknowledge_discarded_span(uint64_t submitted_gen, uint64
 
 static void
 replay_note_input_purge_consumed(void) {
-    if (!stream_is_replay_active() || !g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!stream_is_replay_active() || !rtl.internals) {
         return;
     }
 
-    uint64_t submitted_gen = g_stream->replay_last_submit_gen.load(std::memory_order_acquire);
-    uint64_t consumed_gen = replay_acknowledge_consumed_generation(&g_stream->replay_last_consume_gen, submitted_gen);
-    if (!g_stream->replay_input_eof.load(std::memory_order_acquire) || input_ring_used(&input_ring) != 0U) {
+    uint64_t submitted_gen = rtl.internals->replay_last_submit_gen.load(std::memory_order_acquire);
+    uint64_t consumed_gen =
+        replay_acknowledge_consumed_generation(&rtl.internals->replay_last_consume_gen, submitted_gen);
+    if (!rtl.internals->replay_input_eof.load(std::memory_order_acquire) || input_ring_used(&rtl.input_ring) != 0U) {
         return;
     }
 
-    g_stream->replay_input_drained.store(1, std::memory_order_release);
-    uint64_t eof_gen = g_stream->replay_last_submit_gen_at_eof.load(std::memory_order_acquire);
-    if (consumed_gen >= eof_gen && !g_stream->replay_demod_drained.load(std::memory_order_acquire)) {
-        g_stream->replay_demod_drained.store(1, std::memory_order_release);
-        safe_cond_signal(&output.ready, &output.ready_m);
+    rtl.internals->replay_input_drained.store(1, std::memory_order_release);
+    uint64_t eof_gen = rtl.internals->replay_last_submit_gen_at_eof.load(std::memory_order_acquire);
+    if (consumed_gen >= eof_gen && !rtl.internals->replay_demod_drained.load(std::memory_order_acquire)) {
+        rtl.internals->replay_demod_drained.store(1, std::memory_order_release);
+        ring_signal_ready(&rtl.output);
     }
-    if (g_stream->replay_eof_sync_inited) {
-        dsd_mutex_lock(&g_stream->replay_eof_m);
-        dsd_cond_broadcast(&g_stream->replay_eof_cond);
-        dsd_mutex_unlock(&g_stream->replay_eof_m);
+    if (rtl.internals->replay_eof_sync_inited) {
+        dsd_mutex_lock(&rtl.internals->replay_eof_m);
+        dsd_cond_broadcast(&rtl.internals->replay_eof_cond);
+        dsd_mutex_unlock(&rtl.internals->replay_eof_m);
     }
 }
 
@@ -716,13 +941,6 @@ static void rtl_replay_on_loop_restart(const dsd_iq_replay_config* cfg, void* us
 
 namespace {
 
-struct RtlRequestedPpmMirrors {
-    dsd_opts* active_opts = NULL;
-    dsd_opts* caller_opts = NULL;
-};
-
-static RtlRequestedPpmMirrors g_requested_ppm_mirrors = {};
-
 enum RadioSourceKind : uint8_t {
     RADIO_SOURCE_RTL_USB = 0,
     RADIO_SOURCE_RTL_TCP = 1,
@@ -790,7 +1008,8 @@ stream_steady_state_watermark_enabled(const dsd_opts* opts) {
 
 static const char*
 rtl_perf_source_name(void) {
-    const dsd_opts* opts = (g_stream && g_stream->opts) ? g_stream->opts : NULL;
+    dsd_rtl_stream& rtl = rtl_cur();
+    const dsd_opts* opts = (rtl.internals && rtl.internals->opts) ? rtl.internals->opts : NULL;
     switch (detect_radio_source(opts)) {
         case RADIO_SOURCE_RTL_TCP: return "rtltcp";
         case RADIO_SOURCE_SOAPY: return "soapy";
@@ -872,9 +1091,10 @@ rtl_stream_fsk_profile_for_symbol_rate(int sym_rate, int levels) {
 
 static int
 rtl_stream_fsk_channel_profile_for_current_mode(void) {
-    const dsd_opts* opts = (g_stream && g_stream->opts) ? g_stream->opts : NULL;
-    const int sym_rate = demod.symbol_rate_hz > 0 ? demod.symbol_rate_hz : 4800;
-    const int levels = demod.symbol_levels == 2 ? 2 : 4;
+    dsd_rtl_stream& rtl = rtl_cur();
+    const dsd_opts* opts = (rtl.internals && rtl.internals->opts) ? rtl.internals->opts : NULL;
+    const int sym_rate = rtl.demod.symbol_rate_hz > 0 ? rtl.demod.symbol_rate_hz : 4800;
+    const int levels = rtl.demod.symbol_levels == 2 ? 2 : 4;
     int profile = rtl_stream_fsk_profile_for_opts_by_sym_rate(opts, sym_rate);
     if (profile >= 0) {
         return profile;
@@ -886,12 +1106,46 @@ rtl_stream_fsk_channel_profile_for_current_mode(void) {
     return rtl_stream_fsk_profile_for_symbol_rate(sym_rate, levels);
 }
 
+/**
+ * @brief Sample rate of the interleaved I/Q in the input ring.
+ *
+ * The capture rate, halved when the USB callback already ran the first
+ * half-band stage (see stream_sync_ingest_decimation()).
+ */
+static uint32_t
+input_ring_rate_hz(void) {
+    return load_dongle_rate() >> (rtl_cur().demod.ingest_hb_passes > 0 ? 1 : 0);
+}
+
 static void
 stream_refresh_watermark_for_current_rate(void) {
-    if (!g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals) {
         return;
     }
-    watermark_init(&g_stream->watermark, stream_steady_state_watermark_enabled(g_stream->opts), load_dongle_rate());
+    watermark_init(&rtl.internals->watermark, stream_steady_state_watermark_enabled(rtl.internals->opts),
+                   input_ring_rate_hz());
+}
+
+/**
+ * @brief Hand the first half-band stage to the USB capture callback when
+ * `DSD_NEO_INGEST_HB` asks for it and the cascade has a stage to give.
+ *
+ * Called wherever the decimation plan is (re)computed. Other backends refuse
+ * the request and keep the full cascade on the demod thread.
+ */
+static void
+stream_sync_ingest_decimation(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    int want = (cfg && cfg->ingest_hb && rtl.demod.downsample_passes >= 1) ? 1 : 0;
+    if (!rtl.device || rtl_device_set_ingest_decimation(rtl.device, want) != 0) {
+        want = 0;
+    }
+    if (want != rtl.demod.ingest_hb_passes) {
+        rtl.demod.ingest_hb_passes = want;
+        stream_refresh_watermark_for_current_rate();
+    }
 }
 
 static const char*
@@ -931,19 +1185,19 @@ log_unsupported_control_if_needed(const char* control_name, int rc) {
 
 static int
 apply_ppm_setting(int ppm_error) {
-    int rc = rtl_device_set_ppm(rtl_device_handle, ppm_error);
+    int rc = rtl_device_set_ppm(rtl_cur().device, ppm_error);
     log_unsupported_control_if_needed("PPM correction control", rc);
     return rc;
 }
 
 static inline int
 load_dongle_ppm_error(void) {
-    return dongle.ppm_error.load(std::memory_order_acquire);
+    return rtl_cur().dongle.ppm_error.load(std::memory_order_acquire);
 }
 
 static inline void
 store_dongle_ppm_error(int ppm_error) {
-    dongle.ppm_error.store(ppm_error, std::memory_order_release);
+    rtl_cur().dongle.ppm_error.store(ppm_error, std::memory_order_release);
 }
 
 static inline void
@@ -966,54 +1220,58 @@ clamp_requested_ppm(int ppm_error) {
 
 static const dsd_opts*
 requested_ppm_source_opts_locked(const dsd_opts* fallback_opts) {
-    if (g_requested_ppm_mirrors.active_opts) {
-        return g_requested_ppm_mirrors.active_opts;
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (rtl.requested_ppm_mirrors.active_opts) {
+        return rtl.requested_ppm_mirrors.active_opts;
     }
-    if (g_requested_ppm_mirrors.caller_opts) {
-        return g_requested_ppm_mirrors.caller_opts;
+    if (rtl.requested_ppm_mirrors.caller_opts) {
+        return rtl.requested_ppm_mirrors.caller_opts;
     }
     return fallback_opts;
 }
 
 static void
 sync_requested_ppm_snapshots_locked(dsd_opts* touched_opts, int ppm_error) {
+    dsd_rtl_stream& rtl = rtl_cur();
     int clamped_ppm = clamp_requested_ppm(ppm_error);
-    if (g_requested_ppm_mirrors.active_opts) {
-        g_requested_ppm_mirrors.active_opts->rtlsdr_ppm_error = clamped_ppm;
+    if (rtl.requested_ppm_mirrors.active_opts) {
+        rtl.requested_ppm_mirrors.active_opts->rtlsdr_ppm_error = clamped_ppm;
     }
-    if (g_requested_ppm_mirrors.caller_opts
-        && g_requested_ppm_mirrors.caller_opts != g_requested_ppm_mirrors.active_opts) {
-        g_requested_ppm_mirrors.caller_opts->rtlsdr_ppm_error = clamped_ppm;
+    if (rtl.requested_ppm_mirrors.caller_opts
+        && rtl.requested_ppm_mirrors.caller_opts != rtl.requested_ppm_mirrors.active_opts) {
+        rtl.requested_ppm_mirrors.caller_opts->rtlsdr_ppm_error = clamped_ppm;
     }
-    if (touched_opts && touched_opts != g_requested_ppm_mirrors.active_opts
-        && touched_opts != g_requested_ppm_mirrors.caller_opts) {
+    if (touched_opts && touched_opts != rtl.requested_ppm_mirrors.active_opts
+        && touched_opts != rtl.requested_ppm_mirrors.caller_opts) {
         touched_opts->rtlsdr_ppm_error = clamped_ppm;
     }
 }
 
 extern "C" void
 dsd_rtl_stream_register_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* caller_opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!active_opts) {
         return;
     }
-    std::lock_guard<std::mutex> lock(g_requested_ppm_state_mutex);
-    g_requested_ppm_mirrors.active_opts = active_opts;
-    g_requested_ppm_mirrors.caller_opts = caller_opts ? caller_opts : active_opts;
+    std::lock_guard<std::mutex> lock(rtl.requested_ppm_state_mutex);
+    rtl.requested_ppm_mirrors.active_opts = active_opts;
+    rtl.requested_ppm_mirrors.caller_opts = caller_opts ? caller_opts : active_opts;
     int initial_ppm = caller_opts ? caller_opts->rtlsdr_ppm_error : active_opts->rtlsdr_ppm_error;
     sync_requested_ppm_snapshots_locked(active_opts, initial_ppm);
 }
 
 extern "C" void
 dsd_rtl_stream_unregister_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* caller_opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!active_opts) {
         return;
     }
-    std::lock_guard<std::mutex> lock(g_requested_ppm_state_mutex);
+    std::lock_guard<std::mutex> lock(rtl.requested_ppm_state_mutex);
     const dsd_opts* expected_caller_opts = caller_opts ? caller_opts : active_opts;
-    if (g_requested_ppm_mirrors.active_opts == active_opts
-        && g_requested_ppm_mirrors.caller_opts == expected_caller_opts) {
-        g_requested_ppm_mirrors.active_opts = NULL;
-        g_requested_ppm_mirrors.caller_opts = NULL;
+    if (rtl.requested_ppm_mirrors.active_opts == active_opts
+        && rtl.requested_ppm_mirrors.caller_opts == expected_caller_opts) {
+        rtl.requested_ppm_mirrors.active_opts = NULL;
+        rtl.requested_ppm_mirrors.caller_opts = NULL;
     }
 }
 
@@ -1028,76 +1286,82 @@ struct RtlRequestedPpmState {
 
 static RtlRequestedPpmState
 snapshot_requested_ppm_state(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     RtlRequestedPpmState snapshot = {};
-    std::lock_guard<std::mutex> lock(g_requested_ppm_state_mutex);
+    std::lock_guard<std::mutex> lock(rtl.requested_ppm_state_mutex);
     const dsd_opts* source_opts = requested_ppm_source_opts_locked(opts);
     if (!source_opts) {
         return snapshot;
     }
     snapshot.ppm = source_opts->rtlsdr_ppm_error;
-    snapshot.request_id = controller.ppm_request_publish_seq.load(std::memory_order_relaxed);
+    snapshot.request_id = rtl.controller.ppm_request_publish_seq.load(std::memory_order_relaxed);
     return snapshot;
 }
 
 static uint32_t
 publish_requested_ppm(dsd_opts* opts, int ppm_error) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return 0;
     }
-    std::lock_guard<std::mutex> lock(g_requested_ppm_state_mutex);
+    std::lock_guard<std::mutex> lock(rtl.requested_ppm_state_mutex);
     sync_requested_ppm_snapshots_locked(opts, ppm_error);
-    uint32_t request_id = controller.ppm_request_publish_seq.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    uint32_t request_id = rtl.controller.ppm_request_publish_seq.fetch_add(1U, std::memory_order_relaxed) + 1U;
     return request_id;
 }
 
 static uint32_t
 publish_requested_ppm_delta(dsd_opts* opts, int delta) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return 0;
     }
-    std::lock_guard<std::mutex> lock(g_requested_ppm_state_mutex);
+    std::lock_guard<std::mutex> lock(rtl.requested_ppm_state_mutex);
     const dsd_opts* source_opts = requested_ppm_source_opts_locked(opts);
     int requested_ppm = source_opts ? source_opts->rtlsdr_ppm_error : 0;
     sync_requested_ppm_snapshots_locked(opts, requested_ppm + delta);
-    uint32_t request_id = controller.ppm_request_publish_seq.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    uint32_t request_id = rtl.controller.ppm_request_publish_seq.fetch_add(1U, std::memory_order_relaxed) + 1U;
     return request_id;
 }
 
 static int
 rollback_requested_ppm_if_latest(dsd_opts* opts, int applied_ppm, uint32_t failed_request_id) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return 0;
     }
-    std::lock_guard<std::mutex> lock(g_requested_ppm_state_mutex);
-    if (controller.ppm_request_publish_seq.load(std::memory_order_relaxed) != failed_request_id) {
+    std::lock_guard<std::mutex> lock(rtl.requested_ppm_state_mutex);
+    if (rtl.controller.ppm_request_publish_seq.load(std::memory_order_relaxed) != failed_request_id) {
         return 0;
     }
     sync_requested_ppm_snapshots_locked(opts, applied_ppm);
-    controller.ppm_request_publish_seq.store(failed_request_id + 1U, std::memory_order_relaxed);
+    rtl.controller.ppm_request_publish_seq.store(failed_request_id + 1U, std::memory_order_relaxed);
     return 1;
 }
 
 static void
 note_failed_ppm_request(int requested_ppm, uint32_t request_id, int applied_ppm, int rc) {
-    controller.failed_ppm_error.store(requested_ppm, std::memory_order_release);
-    controller.failed_ppm_request_seq.store(request_id, std::memory_order_release);
-    controller.ppm_apply_failure_pending.store(1, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.controller.failed_ppm_error.store(requested_ppm, std::memory_order_release);
+    rtl.controller.failed_ppm_request_seq.store(request_id, std::memory_order_release);
+    rtl.controller.ppm_apply_failure_pending.store(1, std::memory_order_release);
     LOG_INFO("NOTICE: PPM correction request %d failed (rc=%d); keeping applied value %d.\n", requested_ppm, rc,
              applied_ppm);
 }
 
 static void
 sync_requested_ppm_after_failed_apply(dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return;
     }
-    if (!controller.ppm_apply_failure_pending.exchange(0, std::memory_order_acq_rel)) {
+    if (!rtl.controller.ppm_apply_failure_pending.exchange(0, std::memory_order_acq_rel)) {
         return;
     }
 
     int applied_ppm = load_dongle_ppm_error();
     RtlRequestedPpmState requested = snapshot_requested_ppm_state(opts);
-    uint32_t failed_request_id = controller.failed_ppm_request_seq.load(std::memory_order_acquire);
+    uint32_t failed_request_id = rtl.controller.failed_ppm_request_seq.load(std::memory_order_acquire);
     dsd::io::radio::RtlPpmRejectedRequestResolution resolution = dsd::io::radio::rtl_ppm_resolve_rejected_request(
         applied_ppm, requested.ppm, requested.request_id, failed_request_id);
     if (resolution.rolled_back) {
@@ -1107,19 +1371,20 @@ sync_requested_ppm_after_failed_apply(dsd_opts* opts) {
 
 static dsd::io::radio::RtlPpmControllerRequestsSnapshot
 snapshot_controller_ppm_request_state(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     dsd::io::radio::RtlPpmControllerRequestsSnapshot snapshot = {};
-    dsd_mutex_lock(&controller.hop_m);
-    snapshot.active_request.pending = controller.ppm_apply_in_progress.load(std::memory_order_acquire);
+    dsd_mutex_lock(&rtl.controller.hop_m);
+    snapshot.active_request.pending = rtl.controller.ppm_apply_in_progress.load(std::memory_order_acquire);
     if (snapshot.active_request.pending) {
-        snapshot.active_request.ppm = controller.active_ppm_error.load(std::memory_order_acquire);
-        snapshot.active_request.request_id = controller.active_ppm_request_seq.load(std::memory_order_acquire);
+        snapshot.active_request.ppm = rtl.controller.active_ppm_error.load(std::memory_order_acquire);
+        snapshot.active_request.request_id = rtl.controller.active_ppm_request_seq.load(std::memory_order_acquire);
     }
-    snapshot.queued_request.pending = controller.ppm_change_pending.load(std::memory_order_acquire);
+    snapshot.queued_request.pending = rtl.controller.ppm_change_pending.load(std::memory_order_acquire);
     if (snapshot.queued_request.pending) {
-        snapshot.queued_request.ppm = controller.pending_ppm_error.load(std::memory_order_acquire);
-        snapshot.queued_request.request_id = controller.pending_ppm_request_seq.load(std::memory_order_acquire);
+        snapshot.queued_request.ppm = rtl.controller.pending_ppm_error.load(std::memory_order_acquire);
+        snapshot.queued_request.request_id = rtl.controller.pending_ppm_request_seq.load(std::memory_order_acquire);
     }
-    dsd_mutex_unlock(&controller.hop_m);
+    dsd_mutex_unlock(&rtl.controller.hop_m);
     return snapshot;
 }
 
@@ -1167,8 +1432,9 @@ soapy_bandwidth_request_is_explicit(const dsd_opts* opts) {
 
 static int
 apply_capture_tuner_bandwidth(uint32_t capture_rate_hz, const dsd_opts* opts, int fail_explicit_soapy) {
+    dsd_rtl_stream& rtl = rtl_cur();
     int rc =
-        rtl_device_set_tuner_bandwidth(rtl_device_handle, choose_tuner_bw_hz(capture_rate_hz, (uint32_t)rtl_dsp_bw_hz));
+        rtl_device_set_tuner_bandwidth(rtl.device, choose_tuner_bw_hz(capture_rate_hz, (uint32_t)rtl.dsp_bw_hz));
     if (rc == 0) {
         return 0;
     }
@@ -1302,12 +1568,14 @@ demod_retune_reset_plan(DemodRetuneResetReason requested_reason, uint32_t previo
 
 static void
 fll_retune_seed_cache_clear(void) {
-    std::fill_n(controller.fll_retune_seeds, kFllRetuneSeedSlots, FllRetuneSeed{});
-    controller.fll_retune_seed_clock = 0U;
+    dsd_rtl_stream& rtl = rtl_cur();
+    std::fill_n(rtl.controller.fll_retune_seeds, kFllRetuneSeedSlots, FllRetuneSeed{});
+    rtl.controller.fll_retune_seed_clock = 0U;
 }
 
 static void
 fll_retune_seed_cache_store(uint32_t center_freq_hz, int rate_out_hz, float normalized_freq) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (center_freq_hz == 0U || rate_out_hz <= 0 || !std::isfinite(normalized_freq)) {
         return;
     }
@@ -1317,7 +1585,7 @@ fll_retune_seed_cache_store(uint32_t center_freq_hz, int rate_out_hz, float norm
     }
 
     FllRetuneSeed* destination = nullptr;
-    for (FllRetuneSeed& seed : controller.fll_retune_seeds) {
+    for (FllRetuneSeed& seed : rtl.controller.fll_retune_seeds) {
         if (seed.center_freq_hz == center_freq_hz) {
             destination = &seed;
             break;
@@ -1331,20 +1599,21 @@ fll_retune_seed_cache_store(uint32_t center_freq_hz, int rate_out_hz, float norm
     }
     destination->center_freq_hz = center_freq_hz;
     destination->offset_hz = offset_hz;
-    destination->last_used = ++controller.fll_retune_seed_clock;
+    destination->last_used = ++rtl.controller.fll_retune_seed_clock;
 }
 
 static int
 fll_retune_seed_cache_lookup(uint32_t center_freq_hz, int rate_out_hz, float* out_normalized_freq) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (center_freq_hz == 0U || rate_out_hz <= 0 || !out_normalized_freq) {
         return 0;
     }
-    for (FllRetuneSeed& seed : controller.fll_retune_seeds) {
+    for (FllRetuneSeed& seed : rtl.controller.fll_retune_seeds) {
         if (seed.center_freq_hz != center_freq_hz || !std::isfinite(seed.offset_hz)) {
             continue;
         }
         *out_normalized_freq = seed.offset_hz * (6.28318530717958647692f / (float)rate_out_hz);
-        seed.last_used = ++controller.fll_retune_seed_clock;
+        seed.last_used = ++rtl.controller.fll_retune_seed_clock;
         return std::isfinite(*out_normalized_freq) ? 1 : 0;
     }
     return 0;
@@ -1438,9 +1707,10 @@ retune_output_drained(const struct output_state* outp) {
 
 static void
 drain_output_on_retune(void) {
-    const struct output_state* outp = &output;
-    if (g_stream && g_stream->output) {
-        outp = g_stream->output;
+    dsd_rtl_stream& rtl = rtl_cur();
+    const struct output_state* outp = &rtl.output;
+    if (rtl.internals && rtl.internals->output) {
+        outp = rtl.internals->output;
     }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     int force_clear = 0;
@@ -1488,25 +1758,27 @@ drain_output_on_retune(void) {
    librtlsdr API when available. Returns 0 on success; negative on error. */
 extern "C" int
 rtl_stream_set_bias_tee(int on) {
-    if (!rtl_device_handle) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.device) {
         return -1;
     }
-    return rtl_device_set_bias_tee(rtl_device_handle, on ? 1 : 0);
+    return rtl_device_set_bias_tee(rtl.device, on ? 1 : 0);
 }
 
 /* Export applied tuner gain for UI without exposing internals. */
 extern "C" int
 rtl_stream_get_gain(int* out_tenth_db, int* out_is_auto) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (out_tenth_db) {
         *out_tenth_db = 0;
     }
     if (out_is_auto) {
         *out_is_auto = 1;
     }
-    if (!rtl_device_handle) {
+    if (!rtl.device) {
         return -1;
     }
-    int is_auto = rtl_device_is_auto_gain(rtl_device_handle);
+    int is_auto = rtl_device_is_auto_gain(rtl.device);
     if (out_is_auto) {
         *out_is_auto = (is_auto > 0) ? 1 : 0;
     }
@@ -1514,7 +1786,7 @@ rtl_stream_get_gain(int* out_tenth_db, int* out_is_auto) {
         /* In auto mode, report AGC without a specific gain value. */
         return 0;
     }
-    int g = rtl_device_get_tuner_gain(rtl_device_handle);
+    int g = rtl_device_get_tuner_gain(rtl.device);
     if (g < 0) {
         return -1;
     }
@@ -1579,7 +1851,7 @@ demod_reset_for_sps_change(struct demod_state* s) {
 
 static void
 demod_handle_sps_transition_reset(struct demod_state* s, DemodRetuneResetReason reason) {
-    static int prev_ted_sps = 0;
+    int& prev_ted_sps = rtl_cur().sps_prev_ted_sps;
     if (reason == DemodRetuneResetReason::FreshStream) {
         prev_ted_sps = 0;
     }
@@ -1593,13 +1865,16 @@ demod_handle_sps_transition_reset(struct demod_state* s, DemodRetuneResetReason
 
 static void
 demod_reset_common_state_for_retune(struct demod_state* s) {
+    demod_pipeline_flush(s);
     s->squelch_hits = 0;
     s->squelch_running_power = 0;
     s->squelch_decim_phase = 0;
     s->prev_lpr_index = 0;
     s->now_lpr = 0;
     s->lp_len = 0;
-    DSD_MEMSET(s->input_cb_buf, 0, sizeof(s->input_cb_buf));
+    if (s->input_cb_buf) {
+        DSD_MEMSET(s->input_cb_buf, 0, (size_t)s->work_len * sizeof(float));
+    }
 
     s->fm_demod_history_valid = 0;
     s->pre_r = 0.0f;
@@ -1729,24 +2004,6 @@ demod_reset_on_retune(struct demod_state* s, DemodRetuneResetPlan plan) {
     return plan;
 }
 
-/* Cross-thread mirror of demod.channel_pwr: written by the demod thread after
- * each block, read by the main thread via dsd_rtl_stream_return_pwr(). */
-std::atomic<float> g_channel_pwr{0.0f};
-
-/* Cross-thread mirrors of the demod profile fields consumed by main-thread
- * getters (output kind, symbol profile, TED SPS). The demod thread republishes
- * them once per block; setters that run pre-start or under the demod-family
- * gate publish immediately after writing. */
-static std::atomic<int> g_pub_output_kind{0};
-static std::atomic<int> g_pub_symbol_rate{4800};
-static std::atomic<int> g_pub_symbol_levels{4};
-static std::atomic<int> g_pub_channel_profile{0};
-static std::atomic<int> g_pub_ted_sps{10};
-static std::atomic<int> g_pub_ted_sps_override{0};
-static std::atomic<int> g_pub_cqpsk_enable{0};
-static std::atomic<int> g_pub_ted_bias_q14{0};
-static std::atomic<int> g_pub_rate_out{48000};
-
 static void rtl_stream_publish_demod_profile_snapshot(void);
 static void rtl_stream_publish_ted_bias(void);
 
@@ -1755,135 +2012,93 @@ static void rtl_stream_publish_ted_bias(void);
  * by the deferred profile consume and retune reconfigure). */
 static void
 rtl_stream_load_snr_bias_inputs(int* rate_out, int* ted_sps, int* channel_profile) {
-    *rate_out = g_pub_rate_out.load(std::memory_order_relaxed);
-    *ted_sps = g_pub_ted_sps.load(std::memory_order_relaxed);
-    *channel_profile = g_pub_channel_profile.load(std::memory_order_relaxed);
-}
-
-std::atomic<double> g_snr_c4fm_db{-100.0};
-std::atomic<double> g_snr_qpsk_db{-100.0};
-std::atomic<double> g_snr_gfsk_db{-100.0};
-/* Track recency and source of SNR updates: src 1=direct (symbols), 2=fallback (eye/constellation) */
-static std::atomic<long long> g_snr_c4fm_last_ms{0};
-static std::atomic<int> g_snr_c4fm_src{0};
-static std::atomic<long long> g_snr_qpsk_last_ms{0};
-static std::atomic<int> g_snr_qpsk_src{0};
-static std::atomic<long long> g_snr_gfsk_last_ms{0};
-static std::atomic<int> g_snr_gfsk_src{0};
-/* EMA state for direct SNR estimation (reset on retune for fast acquisition).
- * These are atomic because snr_ema_reset() is called from the controller thread
- * while the demod thread reads/writes them during SNR computation. */
-static std::atomic<double> g_snr_ema_c4fm{-100.0};
-static std::atomic<double> g_snr_ema_qpsk{-100.0};
-static std::atomic<double> g_snr_ema_gfsk{-100.0};
-/* QPSK accumulator reset flag (actual buffer is in demod loop) */
-static std::atomic<int> g_snr_qpsk_acc_reset{0};
-
-static std::atomic<int> g_input_level_valid{0};
-static std::atomic<int> g_input_level_status{DSD_INPUT_LEVEL_UNKNOWN};
-static std::atomic<int> g_input_level_source{DSD_INPUT_LEVEL_SOURCE_UNKNOWN};
-static std::atomic<double> g_input_level_rms_dbfs{-120.0};
-static std::atomic<double> g_input_level_peak_dbfs{-120.0};
-static std::atomic<double> g_input_level_clip_pct{0.0};
-static std::atomic<uint64_t> g_input_level_sample_count{0U};
-static std::atomic<long long> g_input_level_updated{0};
-
-static std::atomic<int> g_decode_health_valid{0};
-static std::atomic<uint32_t> g_decode_health_generation{0};
-static std::atomic<unsigned int> g_decode_p25p1_fec_ok{0};
-static std::atomic<unsigned int> g_decode_p25p1_fec_err{0};
-static std::atomic<unsigned int> g_decode_p25p2_facch_ok{0};
-static std::atomic<unsigned int> g_decode_p25p2_facch_err{0};
-static std::atomic<unsigned int> g_decode_p25p2_sacch_ok{0};
-static std::atomic<unsigned int> g_decode_p25p2_sacch_err{0};
-static std::atomic<unsigned int> g_decode_p25p2_voice_err{0};
+    dsd_rtl_stream& rtl = rtl_cur();
+    *rate_out = rtl.pub_rate_out.load(std::memory_order_relaxed);
+    *ted_sps = rtl.pub_ted_sps.load(std::memory_order_relaxed);
+    *channel_profile = rtl.pub_channel_profile.load(std::memory_order_relaxed);
+}
 
 void
 rtl_stream_input_level_reset(void) {
-    g_input_level_valid.store(0, std::memory_order_release);
-    g_input_level_status.store(DSD_INPUT_LEVEL_UNKNOWN, std::memory_order_relaxed);
-    g_input_level_source.store(DSD_INPUT_LEVEL_SOURCE_UNKNOWN, std::memory_order_relaxed);
-    g_input_level_rms_dbfs.store(-120.0, std::memory_order_relaxed);
-    g_input_level_peak_dbfs.store(-120.0, std::memory_order_relaxed);
-    g_input_level_clip_pct.store(0.0, std::memory_order_relaxed);
-    g_input_level_sample_count.store(0U, std::memory_order_relaxed);
-    g_input_level_updated.store(0, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.input_level_valid.store(0, std::memory_order_release);
+    rtl.input_level_status.store(DSD_INPUT_LEVEL_UNKNOWN, std::memory_order_relaxed);
+    rtl.input_level_source.store(DSD_INPUT_LEVEL_SOURCE_UNKNOWN, std::memory_order_relaxed);
+    rtl.input_level_rms_dbfs.store(-120.0, std::memory_order_relaxed);
+    rtl.input_level_peak_dbfs.store(-120.0, std::memory_order_relaxed);
+    rtl.input_level_clip_pct.store(0.0, std::memory_order_relaxed);
+    rtl.input_level_sample_count.store(0U, std::memory_order_relaxed);
+    rtl.input_level_updated.store(0, std::memory_order_relaxed);
 }
 
 void
 rtl_stream_input_level_publish(const dsd_input_level_snapshot* snapshot) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!snapshot || snapshot->sample_count == 0U) {
         rtl_stream_input_level_reset();
         return;
     }
-    g_input_level_valid.store(0, std::memory_order_release);
-    g_input_level_status.store((int)snapshot->status, std::memory_order_relaxed);
-    g_input_level_source.store((int)snapshot->source, std::memory_order_relaxed);
-    g_input_level_rms_dbfs.store(snapshot->rms_dbfs, std::memory_order_relaxed);
-    g_input_level_peak_dbfs.store(snapshot->peak_dbfs, std::memory_order_relaxed);
-    g_input_level_clip_pct.store(snapshot->clip_pct, std::memory_order_relaxed);
-    g_input_level_sample_count.store(snapshot->sample_count, std::memory_order_relaxed);
-    g_input_level_updated.store((long long)snapshot->updated, std::memory_order_relaxed);
-    g_input_level_valid.store(1, std::memory_order_release);
+    rtl.input_level_valid.store(0, std::memory_order_release);
+    rtl.input_level_status.store((int)snapshot->status, std::memory_order_relaxed);
+    rtl.input_level_source.store((int)snapshot->source, std::memory_order_relaxed);
+    rtl.input_level_rms_dbfs.store(snapshot->rms_dbfs, std::memory_order_relaxed);
+    rtl.input_level_peak_dbfs.store(snapshot->peak_dbfs, std::memory_order_relaxed);
+    rtl.input_level_clip_pct.store(snapshot->clip_pct, std::memory_order_relaxed);
+    rtl.input_level_sample_count.store(snapshot->sample_count, std::memory_order_relaxed);
+    rtl.input_level_updated.store((long long)snapshot->updated, std::memory_order_relaxed);
+    rtl.input_level_valid.store(1, std::memory_order_release);
 }
 
 static void
 rtl_decode_health_reset(void) {
-    g_decode_health_valid.store(0, std::memory_order_release);
-    g_decode_health_generation.store(g_rtl_output_generation.load(std::memory_order_acquire),
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.decode_health_valid.store(0, std::memory_order_release);
+    rtl.decode_health_generation.store(rtl.output_generation.load(std::memory_order_acquire),
                                      std::memory_order_release);
-    g_decode_p25p1_fec_ok.store(0, std::memory_order_relaxed);
-    g_decode_p25p1_fec_err.store(0, std::memory_order_relaxed);
-    g_decode_p25p2_facch_ok.store(0, std::memory_order_relaxed);
-    g_decode_p25p2_facch_err.store(0, std::memory_order_relaxed);
-    g_decode_p25p2_sacch_ok.store(0, std::memory_order_relaxed);
-    g_decode_p25p2_sacch_err.store(0, std::memory_order_relaxed);
-    g_decode_p25p2_voice_err.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p1_fec_ok.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p1_fec_err.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p2_facch_ok.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p2_facch_err.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p2_sacch_ok.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p2_sacch_err.store(0, std::memory_order_relaxed);
+    rtl.decode_p25p2_voice_err.store(0, std::memory_order_relaxed);
 }
 
 static int
 rtl_decode_health_prepare_update(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!rtl_stream_context_active()) {
         rtl_decode_health_reset();
         return 0;
     }
-    uint32_t gen = g_rtl_output_generation.load(std::memory_order_acquire);
-    if (g_decode_health_generation.load(std::memory_order_acquire) != gen) {
+    uint32_t gen = rtl.output_generation.load(std::memory_order_acquire);
+    if (rtl.decode_health_generation.load(std::memory_order_acquire) != gen) {
         rtl_decode_health_reset();
-        g_decode_health_generation.store(gen, std::memory_order_release);
+        rtl.decode_health_generation.store(gen, std::memory_order_release);
     }
     return 1;
 }
 
 static void
 snr_ema_reset(void) {
-    g_snr_ema_c4fm.store(-100.0, std::memory_order_relaxed);
-    g_snr_ema_qpsk.store(-100.0, std::memory_order_relaxed);
-    g_snr_ema_gfsk.store(-100.0, std::memory_order_relaxed);
-    g_snr_c4fm_db.store(-100.0, std::memory_order_relaxed);
-    g_snr_qpsk_db.store(-100.0, std::memory_order_relaxed);
-    g_snr_gfsk_db.store(-100.0, std::memory_order_relaxed);
-    g_snr_c4fm_src.store(0, std::memory_order_relaxed);
-    g_snr_qpsk_src.store(0, std::memory_order_relaxed);
-    g_snr_gfsk_src.store(0, std::memory_order_relaxed);
-    g_snr_qpsk_acc_reset.store(1, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.snr_ema_c4fm.store(-100.0, std::memory_order_relaxed);
+    rtl.snr_ema_qpsk.store(-100.0, std::memory_order_relaxed);
+    rtl.snr_ema_gfsk.store(-100.0, std::memory_order_relaxed);
+    rtl.shared.snr_c4fm_db.store(-100.0, std::memory_order_relaxed);
+    rtl.shared.snr_qpsk_db.store(-100.0, std::memory_order_relaxed);
+    rtl.shared.snr_gfsk_db.store(-100.0, std::memory_order_relaxed);
+    rtl.snr_c4fm_src.store(0, std::memory_order_relaxed);
+    rtl.snr_qpsk_src.store(0, std::memory_order_relaxed);
+    rtl.snr_gfsk_src.store(0, std::memory_order_relaxed);
+    rtl.snr_qpsk_acc_reset.store(1, std::memory_order_relaxed);
     rtl_stream_input_level_reset();
     rtl_decode_health_reset();
 }
 
-namespace {
-struct RetuneSettleWindowState {
-    uint32_t active_seq;
-    int block_index;
-    int stable_run;
-    float prev_mean_abs;
-};
-} // namespace
-
 static RetuneSettleWindowState&
 retune_settle_window_state(void) {
-    static RetuneSettleWindowState state = {};
-    return state;
+    return rtl_cur().retune_settle_window;
 }
 
 static void
@@ -1919,7 +2134,8 @@ retune_settle_log_release(uint32_t seq, int block_index, int remaining, float me
                 "[RETUNE-SETTLE] seq=%u action=release block=%d remaining=%d reason=%s mean_abs=%.4f "
                 "max_abs=%.4f rel_delta=%.4f stable=%d timeout=%d\n",
                 seq, block_index, remaining,
-                retune_reset_reason_name((DemodRetuneResetReason)g_retune_diag_reason.load(std::memory_order_acquire)),
+                retune_reset_reason_name(
+                    (DemodRetuneResetReason)rtl_cur().retune_diag_reason.load(std::memory_order_acquire)),
                 mean_abs, max_abs, rel_delta, stable_run, timed_out);
 }
 
@@ -1933,27 +2149,29 @@ retune_settle_log_drop(uint32_t seq, int block_index, int remaining, float mean_
                 "[RETUNE-SETTLE] seq=%u action=drop block=%d remaining=%d reason=%s mean_abs=%.4f max_abs=%.4f "
                 "rel_delta=%.4f stable=%d\n",
                 seq, block_index, remaining,
-                retune_reset_reason_name((DemodRetuneResetReason)g_retune_diag_reason.load(std::memory_order_acquire)),
+                retune_reset_reason_name(
+                    (DemodRetuneResetReason)rtl_cur().retune_diag_reason.load(std::memory_order_acquire)),
                 mean_abs, max_abs, rel_delta, stable_run);
 }
 
 static int
 retune_settle_should_discard(const struct demod_state* d, float mean_abs, float max_abs, int pairs) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d || !d->cqpsk_enable || pairs <= 0) {
-        g_retune_settle_blocks_remaining.store(0, std::memory_order_release);
+        rtl.retune_settle_blocks_remaining.store(0, std::memory_order_release);
         return 0;
     }
 
-    int remaining = g_retune_settle_blocks_remaining.load(std::memory_order_acquire);
+    int remaining = rtl.retune_settle_blocks_remaining.load(std::memory_order_acquire);
     if (remaining <= 0) {
         return 0;
     }
 
-    uint32_t seq = g_retune_settle_seq.load(std::memory_order_acquire);
+    uint32_t seq = rtl.retune_settle_seq.load(std::memory_order_acquire);
     RetuneSettleWindowState& state = retune_settle_window_state();
     retune_settle_reset_window_for_seq(&state, seq);
 
-    int before = g_retune_settle_blocks_remaining.fetch_sub(1, std::memory_order_acq_rel);
+    int before = rtl.retune_settle_blocks_remaining.fetch_sub(1, std::memory_order_acq_rel);
     if (before <= 0) {
         return 0;
     }
@@ -1972,8 +2190,8 @@ retune_settle_should_discard(const struct demod_state* d, float mean_abs, float
     bool timed_out = (before <= 1);
     bool settled = (state.stable_run >= kRetuneSettleStableBlocks);
     if (settled || timed_out) {
-        g_retune_settle_blocks_remaining.store(0, std::memory_order_release);
-        g_snr_qpsk_acc_reset.store(1, std::memory_order_relaxed);
+        rtl.retune_settle_blocks_remaining.store(0, std::memory_order_release);
+        rtl.snr_qpsk_acc_reset.store(1, std::memory_order_relaxed);
         retune_settle_log_release(seq, state.block_index, before - 1, mean_abs, max_abs, rel_delta, state.stable_run,
                                   timed_out ? 1 : 0);
         return 0;
@@ -2066,11 +2284,12 @@ demod_leave_processing_block(struct controller_state* s) {
 
 static void
 controller_wait_for_demod_idle(struct controller_state* s) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s) {
         return;
     }
     while (s->demod_processing_active.load(std::memory_order_acquire) && !dsd_exitflag_load()
-           && !(g_stream && g_stream->should_exit.load(std::memory_order_acquire))) {
+           && !(rtl.internals && rtl.internals->should_exit.load(std::memory_order_acquire))) {
         dsd_sleep_ms(1);
     }
 }
@@ -2085,6 +2304,7 @@ struct DemodInputSpan {
     size_t reserved_count;
     int got;
     int direct_input_span;
+    int converted; /* compact ring: samples already widened into input_cb_buf */
     float* input_block;
 };
 
@@ -2100,37 +2320,6 @@ struct DemodRetuneDiagBlock {
     size_t ring_used;
 };
 
-struct DemodAutogainState {
-    int initialized = 0;
-    int blocks = 0;
-    int high = 0;
-    int low = 0;
-    int manual_target = 180;
-    int target_initialized = 0;
-    std::chrono::steady_clock::time_point next_allowed = std::chrono::steady_clock::now();
-    std::chrono::steady_clock::time_point hold_until{};
-    std::chrono::steady_clock::time_point probe_until{};
-    uint32_t last_freq = 0U;
-    uint32_t last_reconfigure_seq = 0U;
-    int probe_ms = 3000;
-    int seed_gain_db10 = 300;
-    double spec_snr_db = 6.0;
-    double inband_ratio = 0.60;
-    int up_step_db10 = 30;
-    int up_persist = 2;
-    int spec_pass = 0;
-};
-
-struct DemodMetricsState {
-    unsigned int dsp_metrics_block;
-    int c4fm_missed;
-    int qpsk_missed;
-    int gfsk_missed;
-    float qpsk_acc_i[256];
-    float qpsk_acc_q[256];
-    int qpsk_acc_n;
-};
-
 struct DemodSnrUpdateFlags {
     bool qpsk_updated;
     bool c4fm_updated;
@@ -2141,25 +2330,27 @@ struct DemodSnrUpdateFlags {
 
 static inline int
 demod_should_exit_requested(void) {
-    return dsd_exitflag_load() || (g_stream && g_stream->should_exit.load(std::memory_order_acquire));
+    dsd_rtl_stream& rtl = rtl_cur();
+    return dsd_exitflag_load() || (rtl.internals && rtl.internals->should_exit.load(std::memory_order_acquire));
 }
 
 static int
 demod_wait_for_watermark_if_needed(void) {
-    if (!g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals) {
         return 0;
     }
-    struct input_ring_watermark* wm = &g_stream->watermark;
+    struct input_ring_watermark* wm = &rtl.internals->watermark;
     watermark_periodic_adjust(wm, dsd_time_monotonic_ns());
     int control_work_pending = 0;
     while (1) {
-        if (g_ring_purge_pending.load(std::memory_order_acquire)
-            || controller.retune_in_progress.load(std::memory_order_acquire)) {
+        if (rtl.ring_purge_pending.load(std::memory_order_acquire)
+            || rtl.controller.retune_in_progress.load(std::memory_order_acquire)) {
             control_work_pending = 1;
             break;
         }
         int was_paused = wm->paused;
-        int can_consume = watermark_should_consume(wm, input_ring_used(&input_ring), input_ring.capacity);
+        int can_consume = watermark_should_consume(wm, input_ring_used(&rtl.input_ring), rtl.input_ring.capacity);
         if (can_consume) {
             break;
         }
@@ -2170,8 +2361,8 @@ demod_wait_for_watermark_if_needed(void) {
         if (demod_should_exit_requested()) {
             break;
         }
-        if (g_ring_purge_pending.load(std::memory_order_acquire)
-            || controller.retune_in_progress.load(std::memory_order_acquire)) {
+        if (rtl.ring_purge_pending.load(std::memory_order_acquire)
+            || rtl.controller.retune_in_progress.load(std::memory_order_acquire)) {
             control_work_pending = 1;
             break;
         }
@@ -2185,16 +2376,17 @@ demod_wait_for_watermark_if_needed(void) {
 
 static int
 demod_should_pause_before_read(int is_rtltcp_input) {
-    if (is_rtltcp_input && !controller.cold_start_ready.load(std::memory_order_acquire)) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (is_rtltcp_input && !rtl.controller.cold_start_ready.load(std::memory_order_acquire)) {
         dsd_sleep_ms(1);
         return 1;
     }
-    if (g_ring_purge_pending.exchange(0, std::memory_order_acq_rel)) {
-        input_ring_discard_all_consumer(&input_ring);
+    if (rtl.ring_purge_pending.exchange(0, std::memory_order_acq_rel)) {
+        input_ring_discard_all_consumer(&rtl.input_ring);
         replay_note_input_purge_consumed();
         return 1;
     }
-    if (controller.retune_in_progress.load(std::memory_order_acquire)) {
+    if (rtl.controller.retune_in_progress.load(std::memory_order_acquire)) {
         dsd_sleep_ms(1);
         return 1;
     }
@@ -2216,6 +2408,7 @@ demod_input_span_init(DemodInputSpan* span) {
     span->reserved_count = 0U;
     span->got = 0;
     span->direct_input_span = 0;
+    span->converted = 0;
     span->input_block = NULL;
 }
 
@@ -2224,7 +2417,7 @@ demod_input_span_commit_direct(DemodInputSpan* span) {
     if (!span || !span->direct_input_span) {
         return;
     }
-    input_ring_read_commit(&input_ring, span->reserved_count);
+    input_ring_read_commit(&rtl_cur().input_ring, span->reserved_count);
     span->reserved_count = 0U;
     span->direct_input_span = 0;
 }
@@ -2234,7 +2427,7 @@ demod_input_span_commit_reserved(DemodInputSpan* span) {
     if (!span || span->reserved_count == 0U) {
         return;
     }
-    input_ring_read_commit(&input_ring, span->reserved_count);
+    input_ring_read_commit(&rtl_cur().input_ring, span->reserved_count);
     span->reserved_count = 0U;
     span->direct_input_span = 0;
 }
@@ -2254,8 +2447,8 @@ demod_input_span_stabilize_direct_lowpassed(struct demod_state* d, const DemodIn
     if (stable_len > span->got) {
         stable_len = span->got;
     }
-    if (stable_len > MAXIMUM_BUF_LENGTH) {
-        stable_len = MAXIMUM_BUF_LENGTH;
+    if (stable_len > d->work_len) {
+        stable_len = d->work_len;
     }
     DSD_MEMCPY(d->input_cb_buf, d->lowpassed, (size_t)stable_len * sizeof(float));
     d->lowpassed = d->input_cb_buf;
@@ -2278,8 +2471,8 @@ demod_copy_wrapped_input_block(struct demod_state* d, const DemodInputSpan* span
         DSD_MEMCPY(d->input_cb_buf, span->ring_p1, span->ring_n1 * sizeof(float));
         copied += span->ring_n1;
     }
-    if (span->ring_p2 && span->ring_n2 > 0 && copied < static_cast<size_t>(MAXIMUM_BUF_LENGTH)) {
-        size_t room = static_cast<size_t>(MAXIMUM_BUF_LENGTH) - copied;
+    if (span->ring_p2 && span->ring_n2 > 0 && copied < static_cast<size_t>(d->work_len)) {
+        size_t room = static_cast<size_t>(d->work_len) - copied;
         size_t n2 = (span->ring_n2 < room) ? span->ring_n2 : room;
         DSD_MEMCPY(d->input_cb_buf + copied, span->ring_p2, n2 * sizeof(float));
         copied += n2;
@@ -2293,7 +2486,14 @@ demod_read_input_block(const struct demod_state* d, DemodInputSpan* span) {
     if (!d || !span) {
         return 0;
     }
-    span->got = input_ring_read_reserve(&input_ring, static_cast<size_t>(MAXIMUM_BUF_LENGTH), &span->ring_p1,
+    /* Never hand the pipeline more than its work buffers hold. */
+    if (input_ring_is_compact(&rtl_cur().input_ring)) {
+        span->got =
+            input_ring_read_convert(&rtl_cur().input_ring, d->input_cb_buf, static_cast<size_t>(d->work_len));
+        span->converted = (span->got > 0) ? 1 : 0;
+        return span->converted;
+    }
+    span->got = input_ring_read_reserve(&rtl_cur().input_ring, static_cast<size_t>(d->work_len), &span->ring_p1,
                                         &span->ring_n1, &span->ring_p2, &span->ring_n2);
     if (span->got <= 0) {
         return 0;
@@ -2309,6 +2509,10 @@ demod_prepare_input_block(struct demod_state* d, DemodInputSpan* span) {
     if (!d || !span) {
         return 0;
     }
+    if (span->converted) {
+        span->input_block = d->input_cb_buf;
+        return 1;
+    }
     if (!span->direct_input_span) {
         int copied = demod_copy_wrapped_input_block(d, span);
         demod_input_span_commit_reserved(span);
@@ -2323,24 +2527,25 @@ demod_prepare_input_block(struct demod_state* d, DemodInputSpan* span) {
 
 static DemodRetuneDiagBlock
 demod_capture_retune_diag(float input_mean_abs, float input_max_abs, int input_pairs) {
+    dsd_rtl_stream& rtl = rtl_cur();
     DemodRetuneDiagBlock diag = {};
     if (!debug_cqpsk_enabled()) {
         return diag;
     }
-    int remaining = g_retune_diag_blocks_remaining.load(std::memory_order_acquire);
+    int remaining = rtl.retune_diag_blocks_remaining.load(std::memory_order_acquire);
     if (remaining <= 0) {
         return diag;
     }
-    int before = g_retune_diag_blocks_remaining.fetch_sub(1, std::memory_order_acq_rel);
+    int before = rtl.retune_diag_blocks_remaining.fetch_sub(1, std::memory_order_acq_rel);
     if (before <= 0) {
         return diag;
     }
     diag.block = kRetuneDiagBlocks - before + 1;
-    diag.seq = g_retune_diag_seq.load(std::memory_order_acquire);
-    diag.freq_hz = g_retune_diag_freq_hz.load(std::memory_order_acquire);
-    diag.reason = g_retune_diag_reason.load(std::memory_order_acquire);
-    diag.reconfigure_seq = controller.reconfigure_seq.load(std::memory_order_acquire);
-    diag.ring_used = input_ring_used(&input_ring);
+    diag.seq = rtl.retune_diag_seq.load(std::memory_order_acquire);
+    diag.freq_hz = rtl.retune_diag_freq_hz.load(std::memory_order_acquire);
+    diag.reason = rtl.retune_diag_reason.load(std::memory_order_acquire);
+    diag.reconfigure_seq = rtl.controller.reconfigure_seq.load(std::memory_order_acquire);
+    diag.ring_used = input_ring_used(&rtl.input_ring);
     diag.mean_abs = input_mean_abs;
     diag.max_abs = input_max_abs;
     diag.pairs = input_pairs;
@@ -2355,7 +2560,7 @@ demod_log_retune_diag_block(const struct demod_state* d, int got, const DemodRet
     float fll_be_freq_hz = d->fll_band_edge_state.freq * ((float)d->rate_out / 6.28318530717958647692f);
     float symbol_rate_hz = (float)d->rate_out / (float)(d->ted_sps > 0 ? d->ted_sps : 5);
     float costas_freq_hz = d->costas_state.freq * (symbol_rate_hz / 6.28318530717958647692f);
-    double snr_qpsk = g_snr_qpsk_db.load(std::memory_order_relaxed);
+    double snr_qpsk = rtl_cur().shared.snr_qpsk_db.load(std::memory_order_relaxed);
     DSD_FPRINTF(stderr,
                 "[RETUNE-BLOCK] seq=%u block=%d freq=%u reason=%s reconfig=%u ring=%zu got=%d pairs=%d "
                 "mean_abs=%.4f max_abs=%.4f snr=%.1f fll_be=%.1fHz costas=%.1fHz costas_err=%.4f "
@@ -2368,25 +2573,7 @@ demod_log_retune_diag_block(const struct demod_state* d, int got, const DemodRet
 
 static DemodAutogainState&
 demod_autogain_state(void) {
-    static DemodAutogainState state = {0,
-                                       0,
-                                       0,
-                                       0,
-                                       180,
-                                       0,
-                                       std::chrono::steady_clock::now(),
-                                       std::chrono::steady_clock::time_point{},
-                                       std::chrono::steady_clock::time_point{},
-                                       0U,
-                                       0U,
-                                       3000,
-                                       300,
-                                       6.0,
-                                       0.60,
-                                       30,
-                                       2,
-                                       0};
-    return state;
+    return rtl_cur().autogain;
 }
 
 static inline int
@@ -2424,7 +2611,7 @@ demod_autogain_init_once(DemodAutogainState* st) {
     }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     if (cfg) {
-        g_tuner_autogain_on.store(cfg->tuner_autogain_enable ? 1 : 0, std::memory_order_relaxed);
+        rtl_cur().shared.tuner_autogain_on.store(cfg->tuner_autogain_enable ? 1 : 0, std::memory_order_relaxed);
         st->probe_ms = cfg->tuner_autogain_probe_ms;
         st->seed_gain_db10 = (int)lrint(cfg->tuner_autogain_seed_db * 10.0);
         st->spec_snr_db = cfg->tuner_autogain_spec_snr_db;
@@ -2437,11 +2624,12 @@ demod_autogain_init_once(DemodAutogainState* st) {
 
 static void
 demod_autogain_latch_manual_target(DemodAutogainState* st) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || st->target_initialized) {
         return;
     }
-    int cg = rtl_device_get_tuner_gain(rtl_device_handle);
-    int is_auto_boot = rtl_device_is_auto_gain(rtl_device_handle);
+    int cg = rtl_device_get_tuner_gain(rtl.device);
+    int is_auto_boot = rtl_device_is_auto_gain(rtl.device);
     if (!is_auto_boot && cg >= 0) {
         st->manual_target = cg;
     }
@@ -2552,13 +2740,14 @@ demod_autogain_spectral_gate_ok(DemodAutogainState* st, const struct demod_state
 
 static void
 demod_autogain_probe_handle(DemodAutogainState* st, const std::chrono::steady_clock::time_point& now) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || st->high < 3) {
         return;
     }
     int seed = demod_autogain_clamp_db10(st->seed_gain_db10);
     st->manual_target = demod_autogain_clamp_db10(seed - 50);
-    rtl_device_set_gain_nearest(rtl_device_handle, st->manual_target);
-    dongle.gain = st->manual_target;
+    rtl_device_set_gain_nearest(rtl.device, st->manual_target);
+    rtl.dongle.gain = st->manual_target;
     st->next_allowed = now + std::chrono::milliseconds(1500);
     LOG_INFO("AUTOGAIN: exiting probe due to clipping; set ~%d.%d dB.\n", st->manual_target / 10,
              st->manual_target % 10);
@@ -2566,12 +2755,13 @@ demod_autogain_probe_handle(DemodAutogainState* st, const std::chrono::steady_cl
 
 static void
 demod_autogain_bootstrap_if_low(DemodAutogainState* st, int is_auto, const std::chrono::steady_clock::time_point& now) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || is_auto <= 0 || st->high != 0 || st->low < (st->blocks * 3) / 4) {
         return;
     }
     int kick = demod_autogain_clamp_db10(st->seed_gain_db10);
-    rtl_device_set_gain_nearest(rtl_device_handle, kick);
-    dongle.gain = kick;
+    rtl_device_set_gain_nearest(rtl.device, kick);
+    rtl.dongle.gain = kick;
     st->manual_target = kick;
     st->next_allowed = now + std::chrono::milliseconds(1500);
     LOG_INFO("AUTOGAIN: bootstrapping from device auto to ~%d.%d dB due to low input level.\n", kick / 10, kick % 10);
@@ -2580,10 +2770,11 @@ demod_autogain_bootstrap_if_low(DemodAutogainState* st, int is_auto, const std::
 static void
 demod_autogain_adjust_manual(DemodAutogainState* st, const struct demod_state* d,
                              const std::chrono::steady_clock::time_point& now) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || !d) {
         return;
     }
-    int is_auto = rtl_device_is_auto_gain(rtl_device_handle);
+    int is_auto = rtl_device_is_auto_gain(rtl.device);
     bool changed = false;
     demod_autogain_bootstrap_if_low(st, is_auto, now);
     if (st->high >= 3) {
@@ -2596,8 +2787,8 @@ demod_autogain_adjust_manual(DemodAutogainState* st, const struct demod_state* d
     if (!changed) {
         return;
     }
-    rtl_device_set_gain_nearest(rtl_device_handle, st->manual_target);
-    dongle.gain = st->manual_target;
+    rtl_device_set_gain_nearest(rtl.device, st->manual_target);
+    rtl.dongle.gain = st->manual_target;
     st->next_allowed = now + std::chrono::milliseconds(1500);
     st->spec_pass = 0;
     if (is_auto > 0) {
@@ -2617,7 +2808,7 @@ demod_autogain_maybe_adjust(DemodAutogainState* st, const struct demod_state* d)
     auto now = std::chrono::steady_clock::now();
     bool in_hold = (st->hold_until.time_since_epoch().count() != 0) && (now < st->hold_until);
     bool in_probe = (st->probe_until.time_since_epoch().count() != 0) && (now < st->probe_until)
-                    && (rtl_device_is_auto_gain(rtl_device_handle) > 0);
+                    && (rtl_device_is_auto_gain(rtl_cur().device) > 0);
     bool throttled = now < st->next_allowed;
     if (!in_hold && !throttled) {
         if (in_probe) {
@@ -2631,13 +2822,14 @@ demod_autogain_maybe_adjust(DemodAutogainState* st, const struct demod_state* d)
 
 static void
 demod_autogain_update(const struct demod_state* d, float input_mean_abs, float input_max_abs) {
+    dsd_rtl_stream& rtl = rtl_cur();
     DemodAutogainState& st = demod_autogain_state();
     demod_autogain_init_once(&st);
-    if (!g_tuner_autogain_on.load(std::memory_order_relaxed)) {
+    if (!rtl.shared.tuner_autogain_on.load(std::memory_order_relaxed)) {
         return;
     }
     uint32_t current_freq_hz = load_dongle_frequency();
-    uint32_t current_reconfigure_seq = controller.reconfigure_seq.load(std::memory_order_acquire);
+    uint32_t current_reconfigure_seq = rtl.controller.reconfigure_seq.load(std::memory_order_acquire);
     if (st.last_freq != current_freq_hz || st.last_reconfigure_seq != current_reconfigure_seq) {
         demod_autogain_reset_window(&st, current_freq_hz, current_reconfigure_seq);
     }
@@ -2659,8 +2851,7 @@ demod_now_ms(void) {
 
 static DemodMetricsState&
 demod_metrics_state(void) {
-    static DemodMetricsState state = {};
-    return state;
+    return rtl_cur().metrics;
 }
 
 static int
@@ -2673,14 +2864,46 @@ demod_metrics_due_for_block(DemodMetricsState* st, const struct demod_state* d)
     return (!rtl_direct_output || ((++st->dsp_metrics_block & 1U) == 0U)) ? 1 : 0;
 }
 
+namespace {
+/* One block's view capture, run on a DSP pool worker bound to the pipeline. */
+struct DemodViewTask {
+    dsd_rtl_stream* pipeline;
+    const struct demod_state* d;
+};
+} // namespace
+
+static void
+demod_views_scatter_task(void* arg) {
+    const DemodViewTask* t = static_cast<const DemodViewTask*>(arg);
+    dsd_rtl_stream* prev = g_bound_rtl_stream;
+    g_bound_rtl_stream = t->pipeline;
+    constellation_ring_append(t->d->lowpassed, t->d->lp_len, t->d->cqpsk_enable ? 1 : t->d->ted_sps);
+    eye_ring_append_i_chan(t->d->lowpassed, t->d->lp_len);
+    g_bound_rtl_stream = prev;
+}
+
+static void
+demod_views_spectrum_task(void* arg) {
+    const DemodViewTask* t = static_cast<const DemodViewTask*>(arg);
+    dsd_rtl_stream* prev = g_bound_rtl_stream;
+    g_bound_rtl_stream = t->pipeline;
+    rtl_metrics_update_spectrum_from_iq(t->d->lowpassed, t->d->lp_len, t->d->rate_out);
+    g_bound_rtl_stream = prev;
+}
+
+/*
+ * The scatter/eye rings and the spectrum FFT read the same finished block and
+ * write disjoint exports, so with the shared DSP pool running they go out as
+ * one fork-join pair; otherwise they run inline in the same order.
+ */
 static void
 demod_metrics_capture_views(const struct demod_state* d) {
     if (!d) {
         return;
     }
-    constellation_ring_append(d->lowpassed, d->lp_len, d->cqpsk_enable ? 1 : d->ted_sps);
-    eye_ring_append_i_chan(d->lowpassed, d->lp_len);
-    rtl_metrics_update_spectrum_from_iq(d->lowpassed, d->lp_len, d->rate_out);
+    DemodViewTask view = {g_bound_rtl_stream, d};
+    const demod_mt_task tasks[2] = {{demod_views_scatter_task, &view}, {demod_views_spectrum_task, &view}};
+    dsp_pool_run(tasks, 2);
 }
 
 static void
@@ -2740,18 +2963,19 @@ demod_snr_qpsk_error_ratio(const DemodMetricsState* st, int m, double aI, double
 
 static void
 demod_snr_qpsk_publish(const struct demod_state* d, double ratio, DemodSnrUpdateFlags* flags) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d || !flags) {
         return;
     }
     double snr_raw = 10.0 * log10(ratio);
     double bias = dsd_snr_bias_evm_db(d->rate_out, d->ted_sps, d->channel_lpf_profile);
     double snr = snr_raw - bias;
-    double ema = g_snr_ema_qpsk.load(std::memory_order_relaxed);
+    double ema = rtl.snr_ema_qpsk.load(std::memory_order_relaxed);
     ema = (ema < -50.0) ? snr : (0.5 * ema + 0.5 * snr);
-    g_snr_ema_qpsk.store(ema, std::memory_order_relaxed);
-    g_snr_qpsk_db.store(ema, std::memory_order_relaxed);
-    g_snr_qpsk_src.store(1, std::memory_order_relaxed);
-    g_snr_qpsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
+    rtl.snr_ema_qpsk.store(ema, std::memory_order_relaxed);
+    rtl.shared.snr_qpsk_db.store(ema, std::memory_order_relaxed);
+    rtl.snr_qpsk_src.store(1, std::memory_order_relaxed);
+    rtl.snr_qpsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
     flags->qpsk_updated = true;
 }
 
@@ -2762,29 +2986,31 @@ demod_snr_valid(double snr_db) {
 
 static void
 demod_snr_publish_c4fm_direct(double snr, DemodSnrUpdateFlags* flags) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!flags || !demod_snr_valid(snr)) {
         return;
     }
-    double ema = g_snr_ema_c4fm.load(std::memory_order_relaxed);
+    double ema = rtl.snr_ema_c4fm.load(std::memory_order_relaxed);
     ema = (ema < -50.0) ? snr : (0.5 * ema + 0.5 * snr);
-    g_snr_ema_c4fm.store(ema, std::memory_order_relaxed);
-    g_snr_c4fm_db.store(ema, std::memory_order_relaxed);
-    g_snr_c4fm_src.store(1, std::memory_order_relaxed);
-    g_snr_c4fm_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
+    rtl.snr_ema_c4fm.store(ema, std::memory_order_relaxed);
+    rtl.shared.snr_c4fm_db.store(ema, std::memory_order_relaxed);
+    rtl.snr_c4fm_src.store(1, std::memory_order_relaxed);
+    rtl.snr_c4fm_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
     flags->c4fm_updated = true;
 }
 
 static void
 demod_snr_publish_gfsk_direct(double snr, DemodSnrUpdateFlags* flags) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!flags || !demod_snr_valid(snr)) {
         return;
     }
-    double ema = g_snr_ema_gfsk.load(std::memory_order_relaxed);
+    double ema = rtl.snr_ema_gfsk.load(std::memory_order_relaxed);
     ema = (ema < -50.0) ? snr : (0.5 * ema + 0.5 * snr);
-    g_snr_ema_gfsk.store(ema, std::memory_order_relaxed);
-    g_snr_gfsk_db.store(ema, std::memory_order_relaxed);
-    g_snr_gfsk_src.store(1, std::memory_order_relaxed);
-    g_snr_gfsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
+    rtl.snr_ema_gfsk.store(ema, std::memory_order_relaxed);
+    rtl.shared.snr_gfsk_db.store(ema, std::memory_order_relaxed);
+    rtl.snr_gfsk_src.store(1, std::memory_order_relaxed);
+    rtl.snr_gfsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
     flags->gfsk_updated = true;
 }
 
@@ -2794,7 +3020,7 @@ demod_snr_update_qpsk_direct(const struct demod_state* d, const float* iq, int p
     if (!d || !iq || !st || !flags || sps < 2 || sps > 12) {
         return;
     }
-    if (g_snr_qpsk_acc_reset.exchange(0, std::memory_order_relaxed)) {
+    if (rtl_cur().snr_qpsk_acc_reset.exchange(0, std::memory_order_relaxed)) {
         st->qpsk_acc_n = 0;
     }
     demod_snr_qpsk_accumulate(d, iq, pairs, sps, mid, win, st);
@@ -3050,6 +3276,7 @@ demod_snr_update_fsk_discriminator_direct(const struct demod_state* d, DemodSnrU
 
 static void
 demod_snr_fallback_c4fm(DemodMetricsState* st, const DemodSnrUpdateFlags* flags) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || !flags) {
         return;
     }
@@ -3062,17 +3289,18 @@ demod_snr_fallback_c4fm(DemodMetricsState* st, const DemodSnrUpdateFlags* flags)
     }
     double fb = rtl_stream_estimate_snr_c4fm_eye();
     if (fb > -50.0) {
-        double prev = g_snr_c4fm_db.load(std::memory_order_relaxed);
+        double prev = rtl.shared.snr_c4fm_db.load(std::memory_order_relaxed);
         double blended = (prev < -50.0) ? fb : (0.8 * prev + 0.2 * fb);
-        g_snr_c4fm_db.store(blended, std::memory_order_relaxed);
-        g_snr_c4fm_src.store(2, std::memory_order_relaxed);
-        g_snr_c4fm_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
+        rtl.shared.snr_c4fm_db.store(blended, std::memory_order_relaxed);
+        rtl.snr_c4fm_src.store(2, std::memory_order_relaxed);
+        rtl.snr_c4fm_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
     }
     st->c4fm_missed = 0;
 }
 
 static void
 demod_snr_fallback_qpsk(DemodMetricsState* st, const DemodSnrUpdateFlags* flags) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || !flags) {
         return;
     }
@@ -3085,18 +3313,19 @@ demod_snr_fallback_qpsk(DemodMetricsState* st, const DemodSnrUpdateFlags* flags)
     }
     double fb = rtl_stream_estimate_snr_qpsk_const();
     if (fb > -50.0) {
-        double prev = g_snr_qpsk_db.load(std::memory_order_relaxed);
+        double prev = rtl.shared.snr_qpsk_db.load(std::memory_order_relaxed);
         double alpha = (prev < -50.0) ? 1.0 : 0.5;
         double blended = alpha * fb + (1.0 - alpha) * prev;
-        g_snr_qpsk_db.store(blended, std::memory_order_relaxed);
-        g_snr_qpsk_src.store(2, std::memory_order_relaxed);
-        g_snr_qpsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
+        rtl.shared.snr_qpsk_db.store(blended, std::memory_order_relaxed);
+        rtl.snr_qpsk_src.store(2, std::memory_order_relaxed);
+        rtl.snr_qpsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
     }
     st->qpsk_missed = 0;
 }
 
 static void
 demod_snr_fallback_gfsk(DemodMetricsState* st, const DemodSnrUpdateFlags* flags) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!st || !flags) {
         return;
     }
@@ -3109,11 +3338,11 @@ demod_snr_fallback_gfsk(DemodMetricsState* st, const DemodSnrUpdateFlags* flags)
     }
     double fb = rtl_stream_estimate_snr_gfsk_eye();
     if (fb > -50.0) {
-        double prev = g_snr_gfsk_db.load(std::memory_order_relaxed);
+        double prev = rtl.shared.snr_gfsk_db.load(std::memory_order_relaxed);
         double blended = (prev < -50.0) ? fb : (0.8 * prev + 0.2 * fb);
-        g_snr_gfsk_db.store(blended, std::memory_order_relaxed);
-        g_snr_gfsk_src.store(2, std::memory_order_relaxed);
-        g_snr_gfsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
+        rtl.shared.snr_gfsk_db.store(blended, std::memory_order_relaxed);
+        rtl.snr_gfsk_src.store(2, std::memory_order_relaxed);
+        rtl.snr_gfsk_last_ms.store(demod_now_ms(), std::memory_order_relaxed);
     }
     st->gfsk_missed = 0;
 }
@@ -3166,40 +3395,43 @@ demod_metrics_process(const struct demod_state* d, int perf_on) {
 
 static void
 demod_update_replay_drain_state(int replay_active, uint64_t consumed_gen) {
-    if (!replay_active || !g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!replay_active || !rtl.internals) {
         return;
     }
-    uint64_t consumed_at = replay_acknowledge_consumed_generation(&g_stream->replay_last_consume_gen, consumed_gen);
-    if (g_stream->replay_demod_drained.load(std::memory_order_acquire)) {
+    uint64_t consumed_at =
+        replay_acknowledge_consumed_generation(&rtl.internals->replay_last_consume_gen, consumed_gen);
+    if (rtl.internals->replay_demod_drained.load(std::memory_order_acquire)) {
         return;
     }
-    int input_drained = g_stream->replay_input_drained.load(std::memory_order_acquire);
-    if (!input_drained && g_stream->replay_input_eof.load(std::memory_order_acquire)
-        && input_ring_used(&input_ring) == 0U) {
-        g_stream->replay_input_drained.store(1, std::memory_order_release);
+    int input_drained = rtl.internals->replay_input_drained.load(std::memory_order_acquire);
+    if (!input_drained && rtl.internals->replay_input_eof.load(std::memory_order_acquire)
+        && input_ring_used(&rtl.input_ring) == 0U) {
+        rtl.internals->replay_input_drained.store(1, std::memory_order_release);
         input_drained = 1;
-        if (g_stream->replay_eof_sync_inited) {
-            dsd_mutex_lock(&g_stream->replay_eof_m);
-            dsd_cond_broadcast(&g_stream->replay_eof_cond);
-            dsd_mutex_unlock(&g_stream->replay_eof_m);
+        if (rtl.internals->replay_eof_sync_inited) {
+            dsd_mutex_lock(&rtl.internals->replay_eof_m);
+            dsd_cond_broadcast(&rtl.internals->replay_eof_cond);
+            dsd_mutex_unlock(&rtl.internals->replay_eof_m);
         }
     }
-    uint64_t eof_gen = g_stream->replay_last_submit_gen_at_eof.load(std::memory_order_acquire);
+    uint64_t eof_gen = rtl.internals->replay_last_submit_gen_at_eof.load(std::memory_order_acquire);
     if (input_drained && consumed_at >= eof_gen) {
-        g_stream->replay_demod_drained.store(1, std::memory_order_release);
-        if (g_stream->replay_eof_sync_inited) {
-            dsd_mutex_lock(&g_stream->replay_eof_m);
-            dsd_cond_broadcast(&g_stream->replay_eof_cond);
-            dsd_mutex_unlock(&g_stream->replay_eof_m);
+        rtl.internals->replay_demod_drained.store(1, std::memory_order_release);
+        if (rtl.internals->replay_eof_sync_inited) {
+            dsd_mutex_lock(&rtl.internals->replay_eof_m);
+            dsd_cond_broadcast(&rtl.internals->replay_eof_cond);
+            dsd_mutex_unlock(&rtl.internals->replay_eof_m);
         }
-        safe_cond_signal(&output.ready, &output.ready_m);
+        ring_signal_ready(&rtl.output);
     }
 }
 
 static void
 demod_discard_iteration_input(DemodInputSpan* span) {
+    dsd_rtl_stream& rtl = rtl_cur();
     demod_input_span_commit_reserved(span);
-    if (!stream_is_replay_active() || !g_stream) {
+    if (!stream_is_replay_active() || !rtl.internals) {
         return;
     }
 
@@ -3207,12 +3439,13 @@ demod_discard_iteration_input(DemodInputSpan* span) {
      * generation to be acknowledged. A controller gate can discard the final
      * reserved span, so publish that consumption even though it produced no
      * demodulated output. */
-    uint64_t submitted_gen = g_stream->replay_last_submit_gen.load(std::memory_order_acquire);
+    uint64_t submitted_gen = rtl.internals->replay_last_submit_gen.load(std::memory_order_acquire);
     demod_update_replay_drain_state(1, submitted_gen);
 }
 
 static void
 demod_maybe_signal_squelch_hop(struct demod_state* d) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d) {
         return;
     }
@@ -3220,7 +3453,7 @@ demod_maybe_signal_squelch_hop(struct demod_state* d) {
         d->squelch_hits++;
         if (d->squelch_hits > d->conseq_squelch) {
             d->squelch_hits = d->conseq_squelch + 1;
-            safe_cond_signal(&controller.hop, &controller.hop_m);
+            safe_cond_signal(&rtl.controller.hop, &rtl.controller.hop_m);
         }
     } else {
         d->squelch_hits = 0;
@@ -3229,7 +3462,7 @@ demod_maybe_signal_squelch_hop(struct demod_state* d) {
 
 static int
 demod_output_write_cancelled(void) {
-    return (dsd_exitflag_load() || controller.retune_in_progress.load(std::memory_order_acquire)) ? 1 : 0;
+    return (dsd_exitflag_load() || rtl_cur().controller.retune_in_progress.load(std::memory_order_acquire)) ? 1 : 0;
 }
 
 static int
@@ -3247,51 +3480,26 @@ demod_wait_for_output_space(struct output_state* o) {
     return 1;
 }
 
-static size_t
-demod_copy_output_chunk(struct output_state* o, const float* data, size_t count, size_t free_sp) {
-    size_t write_now = (count < free_sp) ? count : free_sp;
-    size_t h = o->head.load();
-    size_t to_end = o->capacity - h;
-    if (to_end >= write_now) {
-        DSD_MEMCPY(o->buffer + h, data, write_now * sizeof(float));
-        h += write_now;
-        if (h >= o->capacity) {
-            h = 0U;
-        }
-        o->head.store(h);
-        return write_now;
-    }
-    if (to_end > 0U) {
-        DSD_MEMCPY(o->buffer + h, data, to_end * sizeof(float));
-    }
-    size_t remaining = write_now - to_end;
-    DSD_MEMCPY(o->buffer, data + to_end, remaining * sizeof(float));
-    o->head.store(remaining);
-    return write_now;
-}
-
 static size_t
 demod_write_output_samples_interruptible(struct output_state* o, const float* data, size_t count) {
     if (!o || !o->buffer || !data || count == 0U) {
         return 0U;
     }
-    int need_signal = ring_is_empty(o);
     size_t written = 0U;
     while (count > 0U && !demod_output_write_cancelled()) {
-        size_t free_sp = ring_free(o);
-        if (free_sp == 0U) {
+        size_t write_now = o->write(data, count);
+        if (write_now == 0U) {
             if (!demod_wait_for_output_space(o)) {
                 break;
             }
             continue;
         }
-        size_t write_now = demod_copy_output_chunk(o, data, count, free_sp);
         data += write_now;
         count -= write_now;
         written += write_now;
     }
-    if (need_signal && written > 0U) {
-        safe_cond_signal(&o->ready, &o->ready_m);
+    if (written > 0U) {
+        ring_notify_ready(o);
     }
     return written;
 }
@@ -3310,6 +3518,11 @@ demod_write_output_block(struct demod_state* d, struct output_state* o) {
         (d->output_kind == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK || d->output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR);
     const int resample = d->resamp_enabled && (d->output_kind != DSD_DEMOD_OUTPUT_SYMBOL_CQPSK);
     if (resample) {
+        /* A rate change re-designed the resampler; grow its output buffer to the new ratio. */
+        if (d->resamp_out_len < resamp_output_capacity(d, d->result_len)
+            && demod_buffers_reserve(d, d->work_len) != 0) {
+            return 0U;
+        }
         int out_n = resamp_process_block(d, d->result, d->result_len, d->resamp_outbuf);
         if (out_n <= 0) {
             return 0U;
@@ -3327,14 +3540,15 @@ demod_write_output_block(struct demod_state* d, struct output_state* o) {
 
 static double
 demod_perf_pick_snr_db(const struct demod_state* d) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d) {
-        return g_snr_c4fm_db.load(std::memory_order_relaxed);
+        return rtl.shared.snr_c4fm_db.load(std::memory_order_relaxed);
     }
-    double snr_db = g_snr_c4fm_db.load(std::memory_order_relaxed);
+    double snr_db = rtl.shared.snr_c4fm_db.load(std::memory_order_relaxed);
     if (d->cqpsk_enable) {
-        return g_snr_qpsk_db.load(std::memory_order_relaxed);
+        return rtl.shared.snr_qpsk_db.load(std::memory_order_relaxed);
     }
-    double gfsk_snr = g_snr_gfsk_db.load(std::memory_order_relaxed);
+    double gfsk_snr = rtl.shared.snr_gfsk_db.load(std::memory_order_relaxed);
     if (gfsk_snr > -50.0 && (snr_db <= -50.0 || gfsk_snr > snr_db)) {
         snr_db = gfsk_snr;
     }
@@ -3344,6 +3558,7 @@ demod_perf_pick_snr_db(const struct demod_state* d) {
 static void
 demod_perf_log_block(int perf_on, uint64_t perf_output_start_ns, uint64_t perf_full_demod_ns, uint64_t perf_metrics_ns,
                      int got, size_t perf_output_samples, const struct demod_state* d) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!perf_on || !d) {
         return;
     }
@@ -3355,11 +3570,11 @@ demod_perf_log_block(int perf_on, uint64_t perf_output_start_ns, uint64_t perf_f
         rtl_perf_source_name(),
         load_dongle_rate(),
         d->output_kind,
-        input_ring_used(&input_ring),
-        input_ring.capacity,
-        input_ring.producer_drops.load(std::memory_order_relaxed),
-        ring_used(&output),
-        output.capacity,
+        input_ring_used(&rtl.input_ring),
+        rtl.input_ring.capacity,
+        rtl.input_ring.producer_drops.load(std::memory_order_relaxed),
+        ring_used(&rtl.output),
+        rtl.output.capacity,
         -1,
         snr_db,
         rtl_stream_get_cfo_hz(),
@@ -3371,6 +3586,7 @@ demod_perf_log_block(int perf_on, uint64_t perf_output_start_ns, uint64_t perf_f
 static int
 demod_prepare_iteration_input(struct demod_state* d, int is_rtltcp_input, DemodInputSpan* span,
                               DemodRetuneDiagBlock* retune_diag) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d || !span || !retune_diag) {
         return 0;
     }
@@ -3380,19 +3596,19 @@ demod_prepare_iteration_input(struct demod_state* d, int is_rtltcp_input, DemodI
     if (!demod_read_input_block(d, span)) {
         return 0;
     }
-    if (!demod_enter_processing_block(&controller)) {
+    if (!demod_enter_processing_block(&rtl.controller)) {
         demod_discard_iteration_input(span);
         return 0;
     }
     if (!demod_prepare_input_block(d, span)) {
         demod_discard_iteration_input(span);
-        demod_leave_processing_block(&controller);
+        demod_leave_processing_block(&rtl.controller);
         return 0;
     }
-    if (controller.retune_in_progress.load(std::memory_order_acquire)
-        || g_ring_purge_pending.load(std::memory_order_acquire)) {
+    if (rtl.controller.retune_in_progress.load(std::memory_order_acquire)
+        || rtl.ring_purge_pending.load(std::memory_order_acquire)) {
         demod_discard_iteration_input(span);
-        demod_leave_processing_block(&controller);
+        demod_leave_processing_block(&rtl.controller);
         return 0;
     }
     int input_pairs = 0;
@@ -3401,19 +3617,19 @@ demod_prepare_iteration_input(struct demod_state* d, int is_rtltcp_input, DemodI
     iq_block_abs_stats(span->input_block, span->got, &input_mean_abs, &input_max_abs, &input_pairs);
     if (retune_settle_should_discard(d, input_mean_abs, input_max_abs, input_pairs)) {
         demod_discard_iteration_input(span);
-        demod_leave_processing_block(&controller);
+        demod_leave_processing_block(&rtl.controller);
         return 0;
     }
     *retune_diag = demod_capture_retune_diag(input_mean_abs, input_max_abs, input_pairs);
     demod_autogain_update(d, input_mean_abs, input_max_abs);
-    if (!controller.cold_start_ready.load(std::memory_order_acquire)) {
+    if (!rtl.controller.cold_start_ready.load(std::memory_order_acquire)) {
         demod_discard_iteration_input(span);
-        demod_leave_processing_block(&controller);
+        demod_leave_processing_block(&rtl.controller);
         return 0;
     }
-    if (controller.retune_in_progress.load(std::memory_order_acquire)) {
+    if (rtl.controller.retune_in_progress.load(std::memory_order_acquire)) {
         demod_discard_iteration_input(span);
-        demod_leave_processing_block(&controller);
+        demod_leave_processing_block(&rtl.controller);
         return 0;
     }
     d->lowpassed = span->input_block;
@@ -3424,13 +3640,14 @@ demod_prepare_iteration_input(struct demod_state* d, int is_rtltcp_input, DemodI
 static int
 demod_prepare_iteration_processing(const struct demod_state* d, const DemodInputSpan* span, int* replay_active,
                                    uint64_t* consumed_gen) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d || !span || !replay_active || !consumed_gen) {
         return 0;
     }
     *consumed_gen = 0ULL;
     *replay_active = stream_is_replay_active();
-    if (*replay_active && g_stream) {
-        *consumed_gen = g_stream->replay_last_submit_gen.load(std::memory_order_acquire);
+    if (*replay_active && rtl.internals) {
+        *consumed_gen = rtl.internals->replay_last_submit_gen.load(std::memory_order_acquire);
     }
     return 1;
 }
@@ -3447,8 +3664,8 @@ demod_prepare_iteration_processing(const struct demod_state* d, const DemodInput
  */
 static inline void
 demod_feed_wideband_spectrum(const struct demod_state* d) {
-    rtl_wideband_spectrum_maybe_update(d->lowpassed, d->lp_len, load_dongle_rate(),
-                                       controller.last_applied_freq_hz.load(std::memory_order_acquire));
+    rtl_wideband_spectrum_maybe_update(d->lowpassed, d->lp_len, input_ring_rate_hz(),
+                                       rtl_cur().controller.last_applied_freq_hz.load(std::memory_order_acquire));
 }
 
 static DSD_THREAD_RETURN_TYPE
@@ -3456,10 +3673,11 @@ static DSD_THREAD_RETURN_TYPE
     __stdcall
 #endif
     demod_thread_fn(void* arg) {
+    dsd_rtl_stream& rtl = rtl_cur();
     struct demod_state* d = static_cast<demod_state*>(arg);
-    struct output_state* o = &output;
+    struct output_state* o = &rtl.output;
     maybe_set_thread_realtime_and_affinity("DEMOD");
-    const int is_rtltcp_input = (g_stream && radio_source_is_rtltcp(g_stream->opts)) ? 1 : 0;
+    const int is_rtltcp_input = (rtl.internals && radio_source_is_rtltcp(rtl.internals->opts)) ? 1 : 0;
     while (!demod_should_exit_requested()) {
         DemodInputSpan span = {};
         DemodRetuneDiagBlock retune_diag = {};
@@ -3470,7 +3688,7 @@ static DSD_THREAD_RETURN_TYPE
         uint64_t consumed_gen = 0ULL;
         if (!demod_prepare_iteration_processing(d, &span, &replay_active, &consumed_gen)) {
             demod_input_span_release_direct(d, &span);
-            demod_leave_processing_block(&controller);
+            demod_leave_processing_block(&rtl.controller);
             continue;
         }
         int perf_on = rtl_perf_enabled();
@@ -3482,9 +3700,12 @@ static DSD_THREAD_RETURN_TYPE
         if (!consumed_fsk_reacquire) {
             (void)rtl_stream_consume_fsk_modem_reset_pending(d);
         }
-        demod_feed_wideband_spectrum(d);
+        /* The wideband tap is a process-wide endpoint; it follows the default pipeline. */
+        if (rtl_stream_on_default_pipeline()) {
+            demod_feed_wideband_spectrum(d);
+        }
         full_demod(d);
-        g_channel_pwr.store(d->channel_pwr, std::memory_order_relaxed);
+        rtl.shared.channel_pwr.store(d->channel_pwr, std::memory_order_relaxed);
         rtl_stream_publish_demod_profile_snapshot();
         rtl_stream_publish_ted_bias();
         rtl_stream_publish_fsk_phase_cfo_snapshot(d);
@@ -3498,7 +3719,7 @@ static DSD_THREAD_RETURN_TYPE
         demod_maybe_signal_squelch_hop(d);
         uint64_t perf_output_start_ns = perf_on ? dsd_time_monotonic_ns() : 0ULL;
         size_t perf_output_samples =
-            controller.retune_in_progress.load(std::memory_order_acquire) ? 0U : demod_write_output_block(d, o);
+            rtl.controller.retune_in_progress.load(std::memory_order_acquire) ? 0U : demod_write_output_block(d, o);
         /* A replay generation is consumed only after its demodulated output is
          * committed. RESET/rewind boundaries use this generation to avoid
          * entering the reconfigure gate between DSP processing and the output
@@ -3506,7 +3727,7 @@ static DSD_THREAD_RETURN_TYPE
         demod_update_replay_drain_state(replay_active, consumed_gen);
         demod_perf_log_block(perf_on, perf_output_start_ns, perf_full_demod_ns, perf_metrics_ns, span.got,
                              perf_output_samples, d);
-        demod_leave_processing_block(&controller);
+        demod_leave_processing_block(&rtl.controller);
     }
     DSD_THREAD_RETURN;
 }
@@ -3607,9 +3828,10 @@ rtl_choose_passes_for_actual_rate(uint32_t actual_rate_hz, int rate_in_hz) {
  */
 static void
 optimal_settings(int freq, int rate) {
+    dsd_rtl_stream& rtl = rtl_cur();
     UNUSED(rate);
 
-    struct demod_state* dm = &demod;
+    struct demod_state* dm = &rtl.demod;
     dm->downsample_passes = rtl_downsample_passes_for_rate_in(dm->rate_in);
     int downsample_factor = 1 << dm->downsample_passes;
     int capture_rate = downsample_factor * dm->rate_in;
@@ -3620,7 +3842,7 @@ optimal_settings(int freq, int rate) {
     uint32_t deliverable_hz = capture_rate_hz;
     dm->capture_rate_device_forced = 0;
     if (capture_rate_hz > 0U
-        && rtl_device_nearest_supported_rate(rtl_device_handle, capture_rate_hz, &deliverable_hz) == 0
+        && rtl_device_nearest_supported_rate(rtl.device, capture_rate_hz, &deliverable_hz) == 0
         && deliverable_hz > 0U && deliverable_hz != capture_rate_hz) {
         dm->downsample_passes = rtl_choose_passes_for_actual_rate(deliverable_hz, dm->rate_in);
         capture_rate_hz = deliverable_hz;
@@ -3645,15 +3867,17 @@ optimal_settings(int freq, int rate) {
 static int
 program_capture_frequency_and_rate(uint32_t center_freq_hz, const CaptureSettingsSnapshot* restore_on_frequency_failure,
                                    int* out_hardware_changed) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (out_hardware_changed) {
         *out_hardware_changed = 0;
     }
     CaptureSettingsSnapshot previous =
         restore_on_frequency_failure ? *restore_on_frequency_failure : capture_settings_snapshot();
-    optimal_settings((int)center_freq_hz, demod.rate_in);
+    optimal_settings((int)center_freq_hz, rtl.demod.rate_in);
+    stream_sync_ingest_decimation();
     uint32_t capture_freq_hz = load_dongle_frequency();
     uint32_t capture_rate_hz = load_dongle_rate();
-    int rc = rtl_device_set_frequency(rtl_device_handle, capture_freq_hz);
+    int rc = rtl_device_set_frequency(rtl.device, capture_freq_hz);
     if (rc != 0) {
         restore_capture_settings(&previous);
         LOG_ERROR("Failed to apply RTL-SDR center frequency %u Hz (rc=%d).\n", capture_freq_hz, rc);
@@ -3662,10 +3886,10 @@ program_capture_frequency_and_rate(uint32_t center_freq_hz, const CaptureSetting
     if (out_hardware_changed) {
         *out_hardware_changed = 1;
     }
-    rc = rtl_device_set_sample_rate(rtl_device_handle, capture_rate_hz);
+    rc = rtl_device_set_sample_rate(rtl.device, capture_rate_hz);
     if (rc != 0) {
         LOG_ERROR("Failed to apply RTL-SDR sample rate %u Hz (rc=%d).\n", capture_rate_hz, rc);
-        int actual = rtl_device_get_sample_rate(rtl_device_handle);
+        int actual = rtl_device_get_sample_rate(rtl.device);
         if (actual > 0) {
             if ((uint32_t)actual != capture_rate_hz) {
                 (void)apply_actual_capture_rate(center_freq_hz, capture_freq_hz, capture_rate_hz, (uint32_t)actual);
@@ -3677,12 +3901,12 @@ program_capture_frequency_and_rate(uint32_t center_freq_hz, const CaptureSetting
         return rc;
     }
     /* Sync to actual device rate (USB may quantize). If it changed, update rate_out. */
-    int actual = rtl_device_get_sample_rate(rtl_device_handle);
+    int actual = rtl_device_get_sample_rate(rtl.device);
     if (actual > 0 && (uint32_t)actual != capture_rate_hz) {
         capture_rate_hz = apply_actual_capture_rate(center_freq_hz, capture_freq_hz, capture_rate_hz, (uint32_t)actual);
     }
     /* Use driver auto hardware bandwidth by default, or override via env */
-    (void)apply_capture_tuner_bandwidth(capture_rate_hz, g_stream ? g_stream->opts : NULL, 0);
+    (void)apply_capture_tuner_bandwidth(capture_rate_hz, rtl.internals ? rtl.internals->opts : NULL, 0);
     stream_refresh_watermark_for_current_rate();
     return 0;
 }
@@ -3745,14 +3969,15 @@ retune_mute_bytes_for_window(uint32_t sample_rate_hz, uint64_t mute_ms, uint64_t
 
 static int
 retune_mute_backend_is_buffered(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (stream_is_replay_active()) {
         return 1;
     }
-    if (g_stream && g_stream->opts) {
-        if (g_stream->opts->rtltcp_enabled) {
+    if (rtl.internals && rtl.internals->opts) {
+        if (rtl.internals->opts->rtltcp_enabled) {
             return 1;
         }
-        if (dsd_opts_audio_in_dev_is_soapy_spec(g_stream->opts->audio_in_dev)) {
+        if (dsd_opts_audio_in_dev_is_soapy_spec(rtl.internals->opts->audio_in_dev)) {
             return 1;
         }
     }
@@ -3761,21 +3986,23 @@ retune_mute_backend_is_buffered(void) {
 
 static int
 retune_mute_bytes_for_rate(uint32_t sample_rate_hz, int post_retune) {
+    dsd_rtl_stream& rtl = rtl_cur();
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     uint64_t mute_ms = retune_mute_window_ms(cfg ? cfg->retune_mute_ms : 0, cfg ? cfg->retune_mute_ms_is_set : 0,
                                              post_retune, retune_mute_backend_is_buffered());
-    uint64_t min_bytes = (ACTUAL_BUF_LENGTH > 0) ? (uint64_t)ACTUAL_BUF_LENGTH : (uint64_t)DEFAULT_BUF_LENGTH;
+    uint64_t min_bytes = (rtl.actual_buf_length > 0) ? (uint64_t)rtl.actual_buf_length : (uint64_t)DEFAULT_BUF_LENGTH;
     return retune_mute_bytes_for_window(sample_rate_hz, mute_ms, min_bytes);
 }
 
 static void
 controller_arm_retune_mute(const char* phase, int post_retune) {
+    dsd_rtl_stream& rtl = rtl_cur();
     uint32_t sample_rate_hz = load_dongle_rate();
-    if (!rtl_device_handle || sample_rate_hz == 0) {
+    if (!rtl.device || sample_rate_hz == 0) {
         return;
     }
     int mute_bytes = retune_mute_bytes_for_rate(sample_rate_hz, post_retune);
-    rtl_device_mute(rtl_device_handle, mute_bytes);
+    rtl_device_mute(rtl.device, mute_bytes);
     if (debug_cqpsk_enabled()) {
         DSD_FPRINTF(stderr, "[RETUNE-MUTE] phase=%s settle=%d rate=%u bytes=%d\n", phase ? phase : "unknown",
                     post_retune ? 1 : 0, sample_rate_hz, mute_bytes);
@@ -3784,19 +4011,21 @@ controller_arm_retune_mute(const char* phase, int post_retune) {
 
 static void
 controller_arm_post_retune_diagnostics(uint32_t center_freq_hz, DemodRetuneResetReason reason) {
-    uint32_t seq = g_retune_diag_seq.fetch_add(1, std::memory_order_acq_rel) + 1U;
-    g_retune_diag_freq_hz.store(center_freq_hz, std::memory_order_release);
-    g_retune_diag_reason.store((int)reason, std::memory_order_release);
-    g_retune_settle_seq.store(seq, std::memory_order_release);
-    g_retune_settle_blocks_remaining.store(kRetuneSettleMaxBlocks, std::memory_order_release);
-    g_retune_diag_blocks_remaining.store(debug_cqpsk_enabled() ? kRetuneDiagBlocks : 0, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    uint32_t seq = rtl.retune_diag_seq.fetch_add(1, std::memory_order_acq_rel) + 1U;
+    rtl.retune_diag_freq_hz.store(center_freq_hz, std::memory_order_release);
+    rtl.retune_diag_reason.store((int)reason, std::memory_order_release);
+    rtl.retune_settle_seq.store(seq, std::memory_order_release);
+    rtl.retune_settle_blocks_remaining.store(kRetuneSettleMaxBlocks, std::memory_order_release);
+    rtl.retune_diag_blocks_remaining.store(debug_cqpsk_enabled() ? kRetuneDiagBlocks : 0, std::memory_order_release);
 }
 
 static uint32_t
 rtl_stream_bump_output_generation(void) {
-    uint32_t next = g_rtl_output_generation.fetch_add(1, std::memory_order_acq_rel) + 1U;
+    dsd_rtl_stream& rtl = rtl_cur();
+    uint32_t next = rtl.output_generation.fetch_add(1, std::memory_order_acq_rel) + 1U;
     if (next == 0U) {
-        next = g_rtl_output_generation.fetch_add(1, std::memory_order_acq_rel) + 1U;
+        next = rtl.output_generation.fetch_add(1, std::memory_order_acq_rel) + 1U;
     }
     rtl_decode_health_reset();
     rtl_stream_invalidate_fsk_phase_cfo_snapshot();
@@ -3805,11 +4034,12 @@ rtl_stream_bump_output_generation(void) {
 
 static void
 rtl_stream_invalidate_fsk_phase_cfo_snapshot(void) {
-    g_fsk_phase_cfo_valid.store(0, std::memory_order_release);
+    rtl_cur().fsk_phase_cfo_valid.store(0, std::memory_order_release);
 }
 
 static void
 rtl_stream_publish_fsk_phase_cfo_snapshot(const struct demod_state* d) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!d || d->cqpsk_enable || d->output_kind != DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR || d->rate_out <= 0
         || !d->fsk_modem_state.have_prev) {
         rtl_stream_invalidate_fsk_phase_cfo_snapshot();
@@ -3828,21 +4058,22 @@ rtl_stream_publish_fsk_phase_cfo_snapshot(const struct demod_state* d) {
         return;
     }
 
-    g_fsk_phase_cfo_hz.store(cfo_hz, std::memory_order_relaxed);
-    g_fsk_phase_cfo_valid.store(1, std::memory_order_release);
+    rtl.fsk_phase_cfo_hz.store(cfo_hz, std::memory_order_relaxed);
+    rtl.fsk_phase_cfo_valid.store(1, std::memory_order_release);
 }
 
 static void
 rtl_stream_queue_fsk_modem_config(int symbol_rate_hz, int levels, int channel_profile) {
-    g_fsk_modem_config_symbol_rate_hz.store(symbol_rate_hz, std::memory_order_relaxed);
-    g_fsk_modem_config_levels.store(levels, std::memory_order_relaxed);
-    g_fsk_modem_config_channel_profile.store(channel_profile, std::memory_order_relaxed);
-    g_fsk_modem_config_pending.store(1, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.fsk_modem_config_symbol_rate_hz.store(symbol_rate_hz, std::memory_order_relaxed);
+    rtl.fsk_modem_config_levels.store(levels, std::memory_order_relaxed);
+    rtl.fsk_modem_config_channel_profile.store(channel_profile, std::memory_order_relaxed);
+    rtl.fsk_modem_config_pending.store(1, std::memory_order_release);
 }
 
 static void
 rtl_stream_queue_fsk_modem_reset(void) {
-    g_fsk_modem_reset_pending.store(1, std::memory_order_release);
+    rtl_cur().fsk_modem_reset_pending.store(1, std::memory_order_release);
 }
 
 static void
@@ -3856,16 +4087,17 @@ rtl_stream_reset_fsk_modem_on_demod_thread(struct demod_state* d) {
 
 static int
 rtl_stream_consume_fsk_modem_config_pending(struct demod_state* d) {
-    int pending = g_fsk_modem_config_pending.exchange(0, std::memory_order_acq_rel);
+    dsd_rtl_stream& rtl = rtl_cur();
+    int pending = rtl.fsk_modem_config_pending.exchange(0, std::memory_order_acq_rel);
     if (!pending || !d) {
         return 0;
     }
 
     dsd_fsk_modem_config cfg = {};
     cfg.sample_rate_hz = d->rate_out > 0 ? d->rate_out : d->rate_in;
-    cfg.symbol_rate_hz = g_fsk_modem_config_symbol_rate_hz.load(std::memory_order_relaxed);
-    cfg.levels = g_fsk_modem_config_levels.load(std::memory_order_relaxed);
-    cfg.channel_profile = g_fsk_modem_config_channel_profile.load(std::memory_order_relaxed);
+    cfg.symbol_rate_hz = rtl.fsk_modem_config_symbol_rate_hz.load(std::memory_order_relaxed);
+    cfg.levels = rtl.fsk_modem_config_levels.load(std::memory_order_relaxed);
+    cfg.channel_profile = rtl.fsk_modem_config_channel_profile.load(std::memory_order_relaxed);
     dsd_fsk_modem_configure(&d->fsk_modem_state, &cfg);
     rtl_stream_invalidate_fsk_phase_cfo_snapshot();
     return 1;
@@ -3873,7 +4105,7 @@ rtl_stream_consume_fsk_modem_config_pending(struct demod_state* d) {
 
 static int
 rtl_stream_consume_fsk_modem_reset_pending(struct demod_state* d) {
-    int pending = g_fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
+    int pending = rtl_cur().fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
     if (!pending || !d || d->output_kind != DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR) {
         return 0;
     }
@@ -3883,29 +4115,31 @@ rtl_stream_consume_fsk_modem_reset_pending(struct demod_state* d) {
 
 static int
 rtl_stream_consume_fsk_reacquire_pending(struct demod_state* d) {
-    int pending = g_fsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
+    dsd_rtl_stream& rtl = rtl_cur();
+    int pending = rtl.fsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
     if (!pending || !d || d->output_kind != DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR) {
         return 0;
     }
-    rtl_stream_clear_output_ring(g_stream && g_stream->output ? g_stream->output : &output, 1);
-    g_fsk_modem_reset_pending.store(0, std::memory_order_release);
+    rtl_stream_clear_output_ring(rtl.internals && rtl.internals->output ? rtl.internals->output : &rtl.output, 1);
+    rtl.fsk_modem_reset_pending.store(0, std::memory_order_release);
     rtl_stream_reset_fsk_modem_on_demod_thread(d);
     if (debug_sync_enabled()) {
         DSD_FPRINTF(stderr, "[FSKREACQ] consumed output_generation=%u\n",
-                    g_rtl_output_generation.load(std::memory_order_acquire));
+                    rtl.output_generation.load(std::memory_order_acquire));
     }
     return 1;
 }
 
 static int
 rtl_stream_consume_cqpsk_reacquire_pending(struct demod_state* d) {
-    int pending = g_cqpsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
+    dsd_rtl_stream& rtl = rtl_cur();
+    int pending = rtl.cqpsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
     if (!pending || !d || (d->output_kind != DSD_DEMOD_OUTPUT_SYMBOL_CQPSK && !d->cqpsk_enable)) {
         return 0;
     }
 
-    rtl_stream_clear_output_ring(g_stream && g_stream->output ? g_stream->output : &output, 1);
-    const uint32_t center_freq_hz = controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    rtl_stream_clear_output_ring(rtl.internals && rtl.internals->output ? rtl.internals->output : &rtl.output, 1);
+    const uint32_t center_freq_hz = rtl.controller.last_applied_freq_hz.load(std::memory_order_acquire);
     DemodRetuneResetPlan reset_plan = {DemodRetuneResetReason::CqpskReacquire,
                                        1.0f,
                                        false,
@@ -3916,10 +4150,10 @@ rtl_stream_consume_cqpsk_reacquire_pending(struct demod_state* d) {
                                        d->rate_out,
                                        d->rate_out};
     demod_reset_on_retune(d, reset_plan);
-    g_snr_qpsk_acc_reset.store(1, std::memory_order_release);
+    rtl.snr_qpsk_acc_reset.store(1, std::memory_order_release);
     if (debug_cqpsk_enabled()) {
         DSD_FPRINTF(stderr, "[CQPSKREACQ] consumed output_generation=%u\n",
-                    g_rtl_output_generation.load(std::memory_order_acquire));
+                    rtl.output_generation.load(std::memory_order_acquire));
     }
     return 1;
 }
@@ -3929,18 +4163,19 @@ controller_finalize_rate_chain(struct controller_state* s, const dsd_opts* opts,
                                int mark_reconfigure, DemodRetuneResetReason reset_reason,
                                uint32_t previous_center_freq_hz, int previous_rate_out_hz,
                                const RtlRetuneProfile* retune_profile) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s || center_freq_hz == 0) {
         return;
     }
     s->last_applied_freq_hz.store(center_freq_hz, std::memory_order_release);
-    rtl_demod_maybe_refresh_ted_sps_after_rate_change(&demod, opts, &output);
+    rtl_demod_maybe_refresh_ted_sps_after_rate_change(&rtl.demod, opts, &rtl.output);
     rtl_stream_apply_retune_profile(retune_profile, center_freq_hz);
-    rtl_demod_maybe_update_resampler_after_rate_change(&demod, &output, rtl_dsp_bw_hz);
+    rtl_demod_maybe_update_resampler_after_rate_change(&rtl.demod, &rtl.output, rtl.dsp_bw_hz);
     DemodRetuneResetPlan reset_plan = demod_retune_reset_plan(reset_reason, previous_center_freq_hz, center_freq_hz,
-                                                              previous_rate_out_hz, demod.rate_out);
-    demod_reset_on_retune(&demod, reset_plan);
+                                                              previous_rate_out_hz, rtl.demod.rate_out);
+    demod_reset_on_retune(&rtl.demod, reset_plan);
     if (mark_reconfigure) {
-        rtl_device_record_capture_reset(rtl_device_handle, center_freq_hz, load_dongle_frequency(), load_dongle_rate(),
+        rtl_device_record_capture_reset(rtl.device, center_freq_hz, load_dongle_frequency(), load_dongle_rate(),
                                         retune_reset_reason_name(reset_plan.reason));
     }
     /* Reconfigures invalidate after the configured output drain/clear policy runs. */
@@ -3964,21 +4199,22 @@ controller_finalize_reconfigure(struct controller_state* s, const dsd_opts* opts
 
 static inline void
 controller_enter_reconfigure_gate(struct controller_state* s) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s) {
         return;
     }
     s->retune_in_progress.store(1, std::memory_order_release);
-    rtl_stream_signal_output_waiters(g_stream && g_stream->output ? g_stream->output : &output);
+    rtl_stream_signal_output_waiters(rtl.internals && rtl.internals->output ? rtl.internals->output : &rtl.output);
     controller_wait_for_demod_idle(s);
-    g_cqpsk_reacquire_pending.store(0, std::memory_order_release);
-    rtl_stream_clear_output_ring(g_stream && g_stream->output ? g_stream->output : &output, 1);
-    g_retune_settle_blocks_remaining.store(0, std::memory_order_release);
-    g_retune_diag_blocks_remaining.store(0, std::memory_order_release);
+    rtl.cqpsk_reacquire_pending.store(0, std::memory_order_release);
+    rtl_stream_clear_output_ring(rtl.internals && rtl.internals->output ? rtl.internals->output : &rtl.output, 1);
+    rtl.retune_settle_blocks_remaining.store(0, std::memory_order_release);
+    rtl.retune_diag_blocks_remaining.store(0, std::memory_order_release);
 }
 
 static inline void
 controller_prepare_reconfigure_input(void) {
-    rtl_device_begin_capture_reconfigure(rtl_device_handle);
+    rtl_device_begin_capture_reconfigure(rtl_cur().device);
     controller_request_input_purge();
     controller_arm_retune_mute("pre", 0);
 }
@@ -4020,6 +4256,7 @@ controller_reconfigure_finalized_profile(const RtlRetuneProfile* retune_profile,
 static int
 controller_reconfigure_active_stream_locked(struct controller_state* s, uint32_t center_freq_hz,
                                             DemodRetuneResetReason reset_reason, int* out_reconfigured) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (out_reconfigured) {
         *out_reconfigured = 0;
     }
@@ -4027,25 +4264,25 @@ controller_reconfigure_active_stream_locked(struct controller_state* s, uint32_t
         return -1;
     }
     uint32_t previous_center_freq_hz = s->last_applied_freq_hz.load(std::memory_order_acquire);
-    int previous_rate_out_hz = demod.rate_out;
+    int previous_rate_out_hz = rtl.demod.rate_out;
     CaptureSettingsSnapshot previous_capture = capture_settings_snapshot_for_center(previous_center_freq_hz);
     controller_arm_retune_mute("program", 0);
     int hardware_changed = 0;
     int rc = program_capture_frequency_and_rate(center_freq_hz, &previous_capture, &hardware_changed);
     int ppm_changed = (reset_reason == DemodRetuneResetReason::PpmCorrection);
     if (!controller_reconfigure_requires_finalize(rc, hardware_changed, ppm_changed)) {
-        rtl_device_end_capture_reconfigure(rtl_device_handle);
+        rtl_device_end_capture_reconfigure(rtl.device);
         return rc;
     }
     uint32_t finalized_center_freq_hz =
         controller_reconfigure_finalized_center(center_freq_hz, previous_center_freq_hz, rc, hardware_changed);
     controller_arm_retune_mute("post", 1);
-    rtl_device_record_capture_retune(rtl_device_handle, finalized_center_freq_hz, load_dongle_frequency(),
+    rtl_device_record_capture_retune(rtl.device, finalized_center_freq_hz, load_dongle_frequency(),
                                      load_dongle_rate(), retune_reset_reason_name(reset_reason));
-    controller_finalize_reconfigure(s, g_stream ? g_stream->opts : NULL, finalized_center_freq_hz, reset_reason,
-                                    previous_center_freq_hz, previous_rate_out_hz, NULL);
+    controller_finalize_reconfigure(s, rtl.internals ? rtl.internals->opts : NULL, finalized_center_freq_hz,
+                                    reset_reason, previous_center_freq_hz, previous_rate_out_hz, NULL);
     controller_arm_retune_mute("post-reset", 1);
-    rtl_device_end_capture_reconfigure(rtl_device_handle);
+    rtl_device_end_capture_reconfigure(rtl.device);
     if (out_reconfigured) {
         *out_reconfigured = 1;
     }
@@ -4055,6 +4292,7 @@ controller_reconfigure_active_stream_locked(struct controller_state* s, uint32_t
 static int
 controller_apply_reconfigure(struct controller_state* s, uint32_t center_freq_hz, int ppm_error,
                              const RtlRetuneProfile* retune_profile, int* out_ppm_rc, int* out_reconfigured) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (out_reconfigured) {
         *out_reconfigured = 0;
     }
@@ -4063,7 +4301,7 @@ controller_apply_reconfigure(struct controller_state* s, uint32_t center_freq_hz
     }
     int prev_ppm = load_dongle_ppm_error();
     uint32_t previous_center_freq_hz = s->last_applied_freq_hz.load(std::memory_order_acquire);
-    int previous_rate_out_hz = demod.rate_out;
+    int previous_rate_out_hz = rtl.demod.rate_out;
     CaptureSettingsSnapshot previous_capture = capture_settings_snapshot_for_center(previous_center_freq_hz);
     controller_begin_reconfigure(s);
     int ppm_rc = 0;
@@ -4075,7 +4313,7 @@ controller_apply_reconfigure(struct controller_state* s, uint32_t center_freq_hz
     int ppm_changed = (ppm_rc == 0 && ppm_error != prev_ppm);
     if (!controller_reconfigure_requires_finalize(apply_rc, hardware_changed, ppm_changed)) {
         store_dongle_ppm_error_if_applied(ppm_rc, ppm_error);
-        rtl_device_end_capture_reconfigure(rtl_device_handle);
+        rtl_device_end_capture_reconfigure(rtl.device);
         controller_end_reconfigure(s);
         return apply_rc;
     }
@@ -4087,12 +4325,12 @@ controller_apply_reconfigure(struct controller_state* s, uint32_t center_freq_hz
     store_dongle_ppm_error_if_applied(ppm_rc, ppm_error);
     DemodRetuneResetReason reset_reason =
         ppm_changed ? DemodRetuneResetReason::PpmCorrection : DemodRetuneResetReason::FrequencyRetune;
-    rtl_device_record_capture_retune(rtl_device_handle, finalized_center_freq_hz, load_dongle_frequency(),
+    rtl_device_record_capture_retune(rtl.device, finalized_center_freq_hz, load_dongle_frequency(),
                                      load_dongle_rate(), retune_reset_reason_name(reset_reason));
-    controller_finalize_reconfigure(s, g_stream ? g_stream->opts : NULL, finalized_center_freq_hz, reset_reason,
-                                    previous_center_freq_hz, previous_rate_out_hz, finalized_profile);
+    controller_finalize_reconfigure(s, rtl.internals ? rtl.internals->opts : NULL, finalized_center_freq_hz,
+                                    reset_reason, previous_center_freq_hz, previous_rate_out_hz, finalized_profile);
     controller_arm_retune_mute("post-reset", 1);
-    rtl_device_end_capture_reconfigure(rtl_device_handle);
+    rtl_device_end_capture_reconfigure(rtl.device);
     controller_end_reconfigure(s);
     if (out_reconfigured) {
         *out_reconfigured = 1;
@@ -4102,9 +4340,10 @@ controller_apply_reconfigure(struct controller_state* s, uint32_t center_freq_hz
 
 static void
 replay_wait_for_input_purge_applied(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     uint64_t deadline_ns = dsd_time_monotonic_ns() + 100000000ULL;
-    while (g_ring_purge_pending.load(std::memory_order_acquire) && !dsd_exitflag_load()
-           && !(g_stream && g_stream->should_exit.load(std::memory_order_acquire))
+    while (rtl.ring_purge_pending.load(std::memory_order_acquire) && !dsd_exitflag_load()
+           && !(rtl.internals && rtl.internals->should_exit.load(std::memory_order_acquire))
            && dsd_time_monotonic_ns() < deadline_ns) {
         /* Replay callbacks run on the sole producer after the controller has
          * waited for demod processing to go idle. If the ring is already
@@ -4112,17 +4351,18 @@ replay_wait_for_input_purge_applied(void) {
          * reservation that can race this acknowledgement. Waking a consumer
          * blocked on an empty-ring predicate cannot make it observe the purge,
          * so complete it here instead of paying the full timeout every loop. */
-        if (input_ring_used(&input_ring) == 0U && g_ring_purge_pending.exchange(0, std::memory_order_acq_rel)) {
+        if (input_ring_used(&rtl.input_ring) == 0U && rtl.ring_purge_pending.exchange(0, std::memory_order_acq_rel)) {
             replay_note_input_purge_consumed();
             break;
         }
-        safe_cond_signal(&input_ring.ready, &input_ring.ready_m);
+        input_ring_signal_ready(&rtl.input_ring);
         dsd_sleep_ms(1);
     }
 }
 
 static void
 rtl_replay_on_retune_event(const dsd_iq_event* event, void* user) {
+    dsd_rtl_stream& rtl = rtl_cur();
     UNUSED(user);
     if (!event) {
         return;
@@ -4139,24 +4379,26 @@ rtl_replay_on_retune_event(const dsd_iq_event* event, void* user) {
      * EMA blends the two bands together first, because the generation the producer
      * compares against never moved. The RESET sibling below gets both through
      * drain_output_on_retune() and controller_finalize_reconfigure(). */
-    controller.last_applied_freq_hz.store(center_hz, std::memory_order_release);
+    rtl.controller.last_applied_freq_hz.store(center_hz, std::memory_order_release);
     rtl_wideband_spectrum_clear();
-    g_replay_event_last_frequency_hz.store(center_hz, std::memory_order_release);
-    g_replay_event_retune_count.fetch_add(1U, std::memory_order_acq_rel);
+    rtl.replay_event_last_frequency_hz.store(center_hz, std::memory_order_release);
+    rtl.replay_event_retune_count.fetch_add(1U, std::memory_order_acq_rel);
 }
 
 static void
 rtl_replay_on_mute_event(const dsd_iq_event* event, void* user) {
+    dsd_rtl_stream& rtl = rtl_cur();
     UNUSED(user);
     if (!event) {
         return;
     }
-    g_replay_event_last_mute_bytes.store(event->duration_bytes, std::memory_order_release);
-    g_replay_event_mute_count.fetch_add(1U, std::memory_order_acq_rel);
+    rtl.replay_event_last_mute_bytes.store(event->duration_bytes, std::memory_order_release);
+    rtl.replay_event_mute_count.fetch_add(1U, std::memory_order_acq_rel);
 }
 
 static void
 rtl_replay_on_reset_event(const dsd_iq_event* event, void* user) {
+    dsd_rtl_stream& rtl = rtl_cur();
     UNUSED(user);
     if (!event) {
         return;
@@ -4164,8 +4406,8 @@ rtl_replay_on_reset_event(const dsd_iq_event* event, void* user) {
     uint32_t center_hz = (event->center_frequency_hz > UINT32_MAX) ? UINT32_MAX : (uint32_t)event->center_frequency_hz;
     uint32_t capture_hz =
         (event->capture_center_frequency_hz > UINT32_MAX) ? UINT32_MAX : (uint32_t)event->capture_center_frequency_hz;
-    uint32_t previous_center_hz = controller.last_applied_freq_hz.load(std::memory_order_acquire);
-    int previous_rate_out_hz = demod.rate_out;
+    uint32_t previous_center_hz = rtl.controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    int previous_rate_out_hz = rtl.demod.rate_out;
     DemodRetuneResetReason reset_reason = retune_reset_reason_from_name(event->reason);
     /* Replay data before a RESET is already fully demodulated. Preserve that
      * ordered output before the reconfigure gate clears the ring; otherwise a
@@ -4174,19 +4416,20 @@ rtl_replay_on_reset_event(const dsd_iq_event* event, void* user) {
     drain_output_on_retune();
     store_dongle_frequency(capture_hz);
     store_dongle_rate(event->sample_rate_hz);
-    controller_enter_reconfigure_gate(&controller);
+    controller_enter_reconfigure_gate(&rtl.controller);
     controller_request_input_purge();
-    controller_finalize_reconfigure(&controller, g_stream ? g_stream->opts : NULL, center_hz, reset_reason,
-                                    previous_center_hz, previous_rate_out_hz, NULL);
-    controller_end_reconfigure(&controller);
+    controller_finalize_reconfigure(&rtl.controller, rtl.internals ? rtl.internals->opts : NULL, center_hz,
+                                    reset_reason, previous_center_hz, previous_rate_out_hz, NULL);
+    controller_end_reconfigure(&rtl.controller);
     replay_wait_for_input_purge_applied();
-    g_replay_event_last_reset_reason.store((int)reset_reason, std::memory_order_release);
-    g_replay_event_last_frequency_hz.store(center_hz, std::memory_order_release);
-    g_replay_event_reset_count.fetch_add(1U, std::memory_order_acq_rel);
+    rtl.replay_event_last_reset_reason.store((int)reset_reason, std::memory_order_release);
+    rtl.replay_event_last_frequency_hz.store(center_hz, std::memory_order_release);
+    rtl.replay_event_reset_count.fetch_add(1U, std::memory_order_acq_rel);
 }
 
 static void
 rtl_replay_on_loop_restart(const dsd_iq_replay_config* cfg, void* user) {
+    dsd_rtl_stream& rtl = rtl_cur();
     UNUSED(user);
     if (!cfg) {
         return;
@@ -4194,14 +4437,14 @@ rtl_replay_on_loop_restart(const dsd_iq_replay_config* cfg, void* user) {
     /* Rewind is an ordered replay boundary. Let the consumer take the final
      * output from this pass before restoring the capture's initial settings. */
     drain_output_on_retune();
-    controller_enter_reconfigure_gate(&controller);
+    controller_enter_reconfigure_gate(&rtl.controller);
     controller_request_input_purge();
-    (void)controller_apply_replay_settings(&controller, g_stream ? g_stream->opts : NULL, cfg);
-    controller_end_reconfigure(&controller);
+    (void)controller_apply_replay_settings(&rtl.controller, rtl.internals ? rtl.internals->opts : NULL, cfg);
+    controller_end_reconfigure(&rtl.controller);
     replay_wait_for_input_purge_applied();
-    g_replay_loop_restart_last_frequency_hz.store(controller.last_applied_freq_hz.load(std::memory_order_acquire),
+    rtl.replay_loop_restart_last_frequency_hz.store(rtl.controller.last_applied_freq_hz.load(std::memory_order_acquire),
                                                   std::memory_order_release);
-    g_replay_loop_restart_count.fetch_add(1U, std::memory_order_acq_rel);
+    rtl.replay_loop_restart_count.fetch_add(1U, std::memory_order_acq_rel);
 }
 
 /* Resampler and TED SPS helpers are implemented in rtl_demod_config.cpp. */
@@ -4218,6 +4461,7 @@ controller_apply_wb_frequency_offset(struct controller_state* s) {
 
 static void
 controller_apply_initial_offset_tuning(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     int want = 1;
     if (radio_source_is_rtltcp(opts)) {
         want = 0;
@@ -4226,17 +4470,17 @@ controller_apply_initial_offset_tuning(const dsd_opts* opts) {
     if (cfg && cfg->rtl_offset_tuning_is_set) {
         want = cfg->rtl_offset_tuning_enable ? 1 : 0;
     }
-    int r = rtl_device_set_offset_tuning_enabled(rtl_device_handle, want);
+    int r = rtl_device_set_offset_tuning_enabled(rtl.device, want);
     if (r == 0) {
-        dongle.offset_tuning = want ? 1 : 0;
+        rtl.dongle.offset_tuning = want ? 1 : 0;
     } else {
-        dongle.offset_tuning = 0;
+        rtl.dongle.offset_tuning = 0;
     }
 }
 
 static uint32_t
 controller_sync_initial_capture_rate(uint32_t center_freq_hz, uint32_t capture_freq_hz, uint32_t capture_rate_hz) {
-    int actual = rtl_device_get_sample_rate(rtl_device_handle);
+    int actual = rtl_device_get_sample_rate(rtl_cur().device);
     if (actual > 0 && (uint32_t)actual != capture_rate_hz) {
         return apply_actual_capture_rate(center_freq_hz, capture_freq_hz, capture_rate_hz, (uint32_t)actual);
     }
@@ -4245,17 +4489,19 @@ controller_sync_initial_capture_rate(uint32_t center_freq_hz, uint32_t capture_f
 
 static int
 controller_program_initial_capture_settings(const struct controller_state* s, const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     uint32_t capture_freq_hz = load_dongle_frequency();
     uint32_t capture_rate_hz = load_dongle_rate();
-    int rc = rtl_device_set_frequency(rtl_device_handle, capture_freq_hz);
+    int rc = rtl_device_set_frequency(rtl.device, capture_freq_hz);
     if (rc != 0) {
         LOG_ERROR("Failed to apply initial RTL-SDR center frequency %u Hz (rc=%d).\n", capture_freq_hz, rc);
         return rc;
     }
-    LOG_INFO("Oversampling input by: %ix.\n", (demod.downsample_passes > 0) ? (1 << demod.downsample_passes) : 1);
-    LOG_INFO("Oversampling output by: %ix.\n", demod.post_downsample);
-    LOG_INFO("Buffer size: %0.2fms\n", 1000 * 0.5 * (float)ACTUAL_BUF_LENGTH / (float)capture_rate_hz);
-    rc = rtl_device_set_sample_rate(rtl_device_handle, capture_rate_hz);
+    LOG_INFO("Oversampling input by: %ix.\n",
+             (rtl.demod.downsample_passes > 0) ? (1 << rtl.demod.downsample_passes) : 1);
+    LOG_INFO("Oversampling output by: %ix.\n", rtl.demod.post_downsample);
+    LOG_INFO("Buffer size: %0.2fms\n", 1000 * 0.5 * (float)rtl.actual_buf_length / (float)capture_rate_hz);
+    rc = rtl_device_set_sample_rate(rtl.device, capture_rate_hz);
     if (rc != 0) {
         LOG_ERROR("Failed to apply initial RTL-SDR sample rate %u Hz (rc=%d).\n", capture_rate_hz, rc);
         return rc;
@@ -4264,25 +4510,27 @@ controller_program_initial_capture_settings(const struct controller_state* s, co
     if (apply_capture_tuner_bandwidth(capture_rate_hz, opts, 1) != 0) {
         return -1;
     }
-    LOG_INFO("Demod output at %u Hz.\n", (unsigned int)demod.rate_out);
+    LOG_INFO("Demod output at %u Hz.\n", (unsigned int)rtl.demod.rate_out);
     return 0;
 }
 
 static int
 controller_apply_initial_settings(struct controller_state* s, const dsd_opts* opts) {
-    if (!s || !opts || s->freq_len <= 0 || !rtl_device_handle) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!s || !opts || s->freq_len <= 0 || !rtl.device) {
         return -1;
     }
 
     controller_apply_wb_frequency_offset(s);
 
-    optimal_settings(s->freqs[0], demod.rate_in);
-    if (dongle.direct_sampling) {
-        (void)rtl_device_set_direct_sampling(rtl_device_handle, dongle.direct_sampling);
+    optimal_settings(s->freqs[0], rtl.demod.rate_in);
+    if (rtl.dongle.direct_sampling) {
+        (void)rtl_device_set_direct_sampling(rtl.device, rtl.dongle.direct_sampling);
     }
     controller_apply_initial_offset_tuning(opts);
 
-    optimal_settings(s->freqs[0], demod.rate_in);
+    optimal_settings(s->freqs[0], rtl.demod.rate_in);
+    stream_sync_ingest_decimation();
     if (controller_program_initial_capture_settings(s, opts) != 0) {
         return -1;
     }
@@ -4294,6 +4542,7 @@ controller_apply_initial_settings(struct controller_state* s, const dsd_opts* op
 
 static int
 controller_apply_replay_settings(struct controller_state* s, const dsd_opts* opts, const dsd_iq_replay_config* cfg) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s || !opts || !cfg) {
         return -1;
     }
@@ -4321,15 +4570,15 @@ controller_apply_replay_settings(struct controller_state* s, const dsd_opts* opt
     uint32_t capture_freq_hz = (uint32_t)((cfg->capture_center_frequency_hz > 0) ? cfg->capture_center_frequency_hz
                                                                                  : cfg->center_frequency_hz);
     store_dongle_frequency(capture_freq_hz);
-    demod.downsample_passes = passes;
-    demod.post_downsample = (int)cfg->post_downsample;
-    demod.rate_in = (int)(cfg->sample_rate_hz / cfg->base_decimation);
-    if (demod.rate_in < 1) {
-        demod.rate_in = 1;
+    rtl.demod.downsample_passes = passes;
+    rtl.demod.post_downsample = (int)cfg->post_downsample;
+    rtl.demod.rate_in = (int)(cfg->sample_rate_hz / cfg->base_decimation);
+    if (rtl.demod.rate_in < 1) {
+        rtl.demod.rate_in = 1;
     }
-    demod.rate_out = (int)cfg->demod_rate_hz;
+    rtl.demod.rate_out = (int)cfg->demod_rate_hz;
     /* The capture file dictates the rate chain, exactly like a device with a fixed rate grid. */
-    demod.capture_rate_device_forced = 1;
+    rtl.demod.capture_rate_device_forced = 1;
 
     uint32_t center_hz =
         (uint32_t)((cfg->center_frequency_hz > 0) ? cfg->center_frequency_hz : cfg->capture_center_frequency_hz);
@@ -4376,6 +4625,7 @@ controller_clear_active_ppm_request(struct controller_state* s, int ppm_pending)
 
 static int
 controller_wait_for_retune_work(struct controller_state* s, ControllerRetuneWork* work) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s || !work) {
         return 0;
     }
@@ -4386,10 +4636,10 @@ controller_wait_for_retune_work(struct controller_state* s, ControllerRetuneWork
     dsd_mutex_lock(&s->hop_m);
     while (!s->manual_retune_pending.load(std::memory_order_acquire)
            && !s->ppm_change_pending.load(std::memory_order_acquire) && !dsd_exitflag_load()
-           && !(g_stream && g_stream->should_exit.load())) {
+           && !(rtl.internals && rtl.internals->should_exit.load())) {
         dsd_cond_wait(&s->hop, &s->hop_m);
     }
-    if (dsd_exitflag_load() || (g_stream && g_stream->should_exit.load())) {
+    if (dsd_exitflag_load() || (rtl.internals && rtl.internals->should_exit.load())) {
         dsd_mutex_unlock(&s->hop_m);
         return 0;
     }
@@ -4472,6 +4722,7 @@ controller_signal_manual_retune_complete(struct controller_state* s, int result)
 
 static void
 controller_gate_tune_timeout(struct controller_state* s, uint32_t request_id) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s || request_id == 0U) {
         return;
     }
@@ -4493,7 +4744,7 @@ controller_gate_tune_timeout(struct controller_state* s, uint32_t request_id) {
     if (gate_advanced) {
         rtl_stream_bump_output_generation();
     }
-    rtl_stream_signal_output_waiters(g_stream && g_stream->output ? g_stream->output : &output);
+    rtl_stream_signal_output_waiters(rtl.internals && rtl.internals->output ? rtl.internals->output : &rtl.output);
     while (s->live_output_read_active.load(std::memory_order_acquire)) {
         dsd_sleep_ms(1);
     }
@@ -4691,9 +4942,10 @@ static DSD_THREAD_RETURN_TYPE
     __stdcall
 #endif
     controller_thread_retune_loop(void* arg) {
+    dsd_rtl_stream& rtl = rtl_cur();
     struct controller_state* s = static_cast<controller_state*>(arg);
 
-    while (!dsd_exitflag_load() && !(g_stream && g_stream->should_exit.load())) {
+    while (!dsd_exitflag_load() && !(rtl.internals && rtl.internals->should_exit.load())) {
         ControllerRetuneWork work = {};
         if (!controller_wait_for_retune_work(s, &work)) {
             break;
@@ -4723,13 +4975,6 @@ static DSD_THREAD_RETURN_TYPE
 
 /* ---------------- Constellation capture (simple lock-free ring) ---------------- */
 
-static const int kConstMaxPairs = 8192;
-/* Relaxed atomics: single demod-thread writer, main-thread reader. Tearing
- * across samples is acceptable for display/estimation; atomics keep the
- * unsynchronized access well-defined. Relaxed ops compile to plain moves. */
-static std::atomic<float> g_const_xy[kConstMaxPairs * 2];
-static std::atomic<int> g_const_head{0}; /* pairs written [0..kConstMaxPairs-1], wraps */
-
 /**
  * @brief Clear the constellation ring buffer.
  *
@@ -4740,10 +4985,11 @@ static std::atomic<int> g_const_head{0}; /* pairs written [0..kConstMaxPairs-1],
  */
 static void
 constellation_ring_clear(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     for (int k = 0; k < kConstMaxPairs * 2; k++) {
-        g_const_xy[k].store(0.0f, std::memory_order_relaxed);
+        rtl.const_xy[k].store(0.0f, std::memory_order_relaxed);
     }
-    g_const_head.store(0, std::memory_order_relaxed);
+    rtl.const_head.store(0, std::memory_order_relaxed);
 }
 
 /* Forward decl for eye-ring append used in demod loop */
@@ -4752,6 +4998,7 @@ static inline void eye_ring_append_i_chan(const float* iq_interleaved, int len_i
 /* Append decimated I/Q samples from lowpassed[] after DSP. */
 static void
 constellation_ring_append(const float* iq, int len, int sps_hint) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!iq || len < 2) {
         return;
     }
@@ -4760,38 +5007,35 @@ constellation_ring_append(const float* iq, int len, int sps_hint) {
     for (int n = 0; n < N; n += stride) {
         float i = iq[(size_t)(n << 1) + 0];
         float q = iq[(size_t)(n << 1) + 1];
-        int h = g_const_head.load(std::memory_order_relaxed);
-        g_const_xy[(size_t)(h << 1) + 0].store(i, std::memory_order_relaxed);
-        g_const_xy[(size_t)(h << 1) + 1].store(q, std::memory_order_relaxed);
+        int h = rtl.const_head.load(std::memory_order_relaxed);
+        rtl.const_xy[(size_t)(h << 1) + 0].store(i, std::memory_order_relaxed);
+        rtl.const_xy[(size_t)(h << 1) + 1].store(q, std::memory_order_relaxed);
         h++;
         if (h >= kConstMaxPairs) {
             h = 0;
         }
-        g_const_head.store(h, std::memory_order_relaxed);
+        rtl.const_head.store(h, std::memory_order_relaxed);
     }
 }
 
 extern "C" int
 rtl_stream_constellation_get(float* out_xy, int max_points) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_xy || max_points <= 0) {
         return 0;
     }
-    int head = g_const_head.load(std::memory_order_relaxed); /* snapshot */
+    int head = rtl.const_head.load(std::memory_order_relaxed); /* snapshot */
     int n = (max_points < kConstMaxPairs) ? max_points : kConstMaxPairs;
     int start = head;
     for (int k = 0; k < n; k++) {
         int idx = (start + k) % kConstMaxPairs;
-        out_xy[(size_t)(k << 1) + 0] = g_const_xy[(size_t)(idx << 1) + 0].load(std::memory_order_relaxed);
-        out_xy[(size_t)(k << 1) + 1] = g_const_xy[(size_t)(idx << 1) + 1].load(std::memory_order_relaxed);
+        out_xy[(size_t)(k << 1) + 0] = rtl.const_xy[(size_t)(idx << 1) + 0].load(std::memory_order_relaxed);
+        out_xy[(size_t)(k << 1) + 1] = rtl.const_xy[(size_t)(idx << 1) + 1].load(std::memory_order_relaxed);
     }
     return n;
 }
 
 /* ---------------- Eye diagram capture (I-channel of complex baseband) ---------------- */
-static const int kEyeMax = 16384;
-/* Relaxed atomics for the same reason as the constellation ring above. */
-static std::atomic<float> g_eye_buf[kEyeMax];
-static std::atomic<int> g_eye_head{0}; /* samples written [0..kEyeMax-1], wraps */
 
 /**
  * @brief Clear the eye diagram ring buffer.
@@ -4801,46 +5045,49 @@ static std::atomic<int> g_eye_head{0}; /* samples written [0..kEyeMax-1], wraps
  */
 static void
 eye_ring_clear(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     for (int k = 0; k < kEyeMax; k++) {
-        g_eye_buf[k].store(0.0f, std::memory_order_relaxed);
+        rtl.eye_buf[k].store(0.0f, std::memory_order_relaxed);
     }
-    g_eye_head.store(0, std::memory_order_relaxed);
+    rtl.eye_head.store(0, std::memory_order_relaxed);
 }
 
 static inline void
 eye_ring_append_i_chan(const float* iq_interleaved, int len_interleaved) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!iq_interleaved || len_interleaved < 2) {
         return;
     }
     int N = len_interleaved >> 1; /* complex samples */
     for (int n = 0; n < N; n++) {
         float i = iq_interleaved[(size_t)(n << 1) + 0];
-        int h = g_eye_head.load(std::memory_order_relaxed);
-        g_eye_buf[h].store(i, std::memory_order_relaxed);
+        int h = rtl.eye_head.load(std::memory_order_relaxed);
+        rtl.eye_buf[h].store(i, std::memory_order_relaxed);
         h++;
         if (h >= kEyeMax) {
             h = 0;
         }
-        g_eye_head.store(h, std::memory_order_relaxed);
+        rtl.eye_head.store(h, std::memory_order_relaxed);
     }
 }
 
 extern "C" int
 rtl_stream_eye_get(float* out, int max_samples, int* out_sps) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (out_sps) {
         /* demod.ted_sps belongs to the demod thread; read the published
          * atomic mirror instead of the struct field to avoid a data race. */
-        *out_sps = g_pub_ted_sps.load(std::memory_order_relaxed);
+        *out_sps = rtl.pub_ted_sps.load(std::memory_order_relaxed);
     }
     if (!out || max_samples <= 0) {
         return 0;
     }
-    int head = g_eye_head.load(std::memory_order_relaxed);
+    int head = rtl.eye_head.load(std::memory_order_relaxed);
     int n = (max_samples < kEyeMax) ? max_samples : kEyeMax;
     int start = head;
     for (int k = 0; k < n; k++) {
         int idx = (start + k) % kEyeMax;
-        out[k] = g_eye_buf[idx].load(std::memory_order_relaxed);
+        out[k] = rtl.eye_buf[idx].load(std::memory_order_relaxed);
     }
     return n;
 }
@@ -5198,14 +5445,15 @@ rtl_stream_estimate_snr_gfsk_eye(void) {
  */
 static void
 dongle_init(struct dongle_state* s) {
+    dsd_rtl_stream& rtl = rtl_cur();
     s->freq.store(0, std::memory_order_relaxed);
-    s->rate.store((uint32_t)rtl_dsp_bw_hz, std::memory_order_relaxed);
+    s->rate.store((uint32_t)rtl.dsp_bw_hz, std::memory_order_relaxed);
     s->gain = AUTO_GAIN; // tenths of a dB
     s->ppm_error.store(0, std::memory_order_relaxed);
     s->mute = 0;
     s->direct_sampling = 0;
     s->offset_tuning = 0; //E4000 tuners only
-    s->demod_target = &demod;
+    s->demod_target = &rtl.demod;
 }
 
 /**
@@ -5215,7 +5463,7 @@ dongle_init(struct dongle_state* s) {
  */
 static void
 output_init(struct output_state* s) {
-    s->rate = rtl_dsp_bw_hz;
+    s->rate = rtl_cur().dsp_bw_hz;
     dsd_cond_init(&s->ready);
     dsd_cond_init(&s->space);
     dsd_mutex_init(&s->ready_m);
@@ -5231,11 +5479,12 @@ output_init(struct output_state* s) {
         }
         s->buffer = static_cast<float*>(mem_ptr);
     }
-    s->head.store(0);
-    s->tail.store(0);
+    s->reset();
     /* Metrics */
     s->write_timeouts.store(0);
     s->read_timeouts.store(0);
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    ring_wake_set_watermark(&s->wake, (cfg && cfg->output_wake_samples_is_set) ? (size_t)cfg->output_wake_samples : 1U);
 }
 
 /**
@@ -5318,17 +5567,18 @@ controller_cleanup(struct controller_state* s) {
  */
 static void
 setup_initial_freq_and_rate(dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (opts->rtlsdr_center_freq > 0) {
-        controller.freqs[controller.freq_len] = opts->rtlsdr_center_freq;
-        controller.freq_len++;
+        rtl.controller.freqs[rtl.controller.freq_len] = opts->rtlsdr_center_freq;
+        rtl.controller.freq_len++;
     }
     if (opts->rtlsdr_ppm_error != 0) {
         LOG_INFO("Requested RTL PPM Error Set to %d\n", opts->rtlsdr_ppm_error);
     }
-    dongle.dev_index = opts->rtl_dev_index;
-    LOG_INFO("Setting DSP baseband to %d Hz\n", rtl_dsp_bw_hz);
+    rtl.dongle.dev_index = opts->rtl_dev_index;
+    LOG_INFO("Setting DSP baseband to %d Hz\n", rtl.dsp_bw_hz);
     LOG_INFO("Setting RTL Power Squelch Level to %.1f dB\n", pwr_to_dB(opts->rtl_squelch_level));
-    port = 0;
+    rtl.udp_port = 0;
     if (opts->rtl_udp_port != 0) {
         int p = opts->rtl_udp_port;
         if (p < 0) {
@@ -5337,16 +5587,16 @@ setup_initial_freq_and_rate(dsd_opts* opts) {
         if (p > 65535) {
             p = 65535;
         }
-        port = (uint16_t)p;
+        rtl.udp_port = (uint16_t)p;
     }
     if (opts->rtl_udp_bindaddr[0] != '\0') {
-        DSD_SNPRINTF(udp_control_bindaddr, sizeof udp_control_bindaddr, "%s", opts->rtl_udp_bindaddr);
-        udp_control_bindaddr[sizeof udp_control_bindaddr - 1] = '\0';
+        DSD_SNPRINTF(rtl.udp_bindaddr, sizeof rtl.udp_bindaddr, "%s", opts->rtl_udp_bindaddr);
+        rtl.udp_bindaddr[sizeof rtl.udp_bindaddr - 1] = '\0';
     } else {
-        DSD_SNPRINTF(udp_control_bindaddr, sizeof udp_control_bindaddr, "%s", "127.0.0.1");
+        DSD_SNPRINTF(rtl.udp_bindaddr, sizeof rtl.udp_bindaddr, "%s", "127.0.0.1");
     }
     if (opts->rtl_gain_value > 0) {
-        dongle.gain = opts->rtl_gain_value * 10;
+        rtl.dongle.gain = opts->rtl_gain_value * 10;
     }
 }
 
@@ -5363,10 +5613,12 @@ setup_initial_freq_and_rate(dsd_opts* opts) {
  */
 static uint32_t
 schedule_manual_retune_on_controller(struct controller_state* s, uint32_t target_freq_hz, uint64_t caller_token = 0U) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s) {
         return 0U;
     }
-    if (s == &controller && g_stream && !g_stream->controller_thread_started.load(std::memory_order_acquire)) {
+    if (s == &rtl.controller && rtl.internals
+        && !rtl.internals->controller_thread_started.load(std::memory_order_acquire)) {
         return 0U;
     }
     dsd_mutex_lock(&s->hop_m);
@@ -5396,45 +5648,46 @@ schedule_manual_retune_on_controller(struct controller_state* s, uint32_t target
 
 static uint32_t
 schedule_manual_retune(uint32_t target_freq_hz) {
-    return schedule_manual_retune_on_controller(&controller, target_freq_hz);
+    return schedule_manual_retune_on_controller(&rtl_cur().controller, target_freq_hz);
 }
 
 static uint32_t
 schedule_manual_retune_tagged(uint32_t target_freq_hz, uint64_t caller_token) {
-    return schedule_manual_retune_on_controller(&controller, target_freq_hz, caller_token);
+    return schedule_manual_retune_on_controller(&rtl_cur().controller, target_freq_hz, caller_token);
 }
 
 static void
 sync_requested_ppm_to_controller(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return;
     }
     int applied_ppm = load_dongle_ppm_error();
-    dsd_mutex_lock(&controller.hop_m);
-    std::lock_guard<std::mutex> request_lock(g_requested_ppm_state_mutex);
+    dsd_mutex_lock(&rtl.controller.hop_m);
+    std::lock_guard<std::mutex> request_lock(rtl.requested_ppm_state_mutex);
     int requested_ppm = opts->rtlsdr_ppm_error;
-    uint32_t requested_ppm_request_id = controller.ppm_request_publish_seq.load(std::memory_order_relaxed);
+    uint32_t requested_ppm_request_id = rtl.controller.ppm_request_publish_seq.load(std::memory_order_relaxed);
     dsd::io::radio::RtlPpmControllerRequestState queued_request = {};
-    queued_request.pending = controller.ppm_change_pending.load(std::memory_order_acquire);
+    queued_request.pending = rtl.controller.ppm_change_pending.load(std::memory_order_acquire);
     if (queued_request.pending) {
-        queued_request.ppm = controller.pending_ppm_error.load(std::memory_order_acquire);
-        queued_request.request_id = controller.pending_ppm_request_seq.load(std::memory_order_acquire);
+        queued_request.ppm = rtl.controller.pending_ppm_error.load(std::memory_order_acquire);
+        queued_request.request_id = rtl.controller.pending_ppm_request_seq.load(std::memory_order_acquire);
     }
     dsd::io::radio::RtlPpmControllerRequestState active_request = {};
-    active_request.pending = controller.ppm_apply_in_progress.load(std::memory_order_acquire);
+    active_request.pending = rtl.controller.ppm_apply_in_progress.load(std::memory_order_acquire);
     if (active_request.pending) {
-        active_request.ppm = controller.active_ppm_error.load(std::memory_order_acquire);
-        active_request.request_id = controller.active_ppm_request_seq.load(std::memory_order_acquire);
+        active_request.ppm = rtl.controller.active_ppm_error.load(std::memory_order_acquire);
+        active_request.request_id = rtl.controller.active_ppm_request_seq.load(std::memory_order_acquire);
     }
     bool needs_schedule = dsd::io::radio::rtl_ppm_should_schedule_request(
         applied_ppm, requested_ppm, requested_ppm_request_id, queued_request, active_request);
     if (needs_schedule) {
-        controller.pending_ppm_error.store(requested_ppm, std::memory_order_release);
-        controller.pending_ppm_request_seq.store(requested_ppm_request_id, std::memory_order_release);
-        controller.ppm_change_pending.store(1, std::memory_order_release);
-        dsd_cond_signal(&controller.hop);
+        rtl.controller.pending_ppm_error.store(requested_ppm, std::memory_order_release);
+        rtl.controller.pending_ppm_request_seq.store(requested_ppm_request_id, std::memory_order_release);
+        rtl.controller.ppm_change_pending.store(1, std::memory_order_release);
+        dsd_cond_signal(&rtl.controller.hop);
     }
-    dsd_mutex_unlock(&controller.hop_m);
+    dsd_mutex_unlock(&rtl.controller.hop_m);
 }
 
 /**
@@ -5446,29 +5699,32 @@ sync_requested_ppm_to_controller(const dsd_opts* opts) {
  */
 static void
 start_threads_and_async(void) {
-    if (dsd_thread_create(&controller.thread, controller_thread_retune_loop, &controller) == 0) {
-        if (g_stream) {
-            g_stream->controller_thread_started.store(1, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (rtl_stream_thread_create(&rtl.controller.thread, controller_thread_retune_loop, &rtl.controller) == 0) {
+        if (rtl.internals) {
+            rtl.internals->controller_thread_started.store(1, std::memory_order_release);
         }
     }
-    if (dsd_thread_create(&demod.thread, demod_thread_fn, &demod) == 0) {
-        if (g_stream) {
-            g_stream->demod_thread_started.store(1, std::memory_order_release);
+    if (rtl_stream_thread_create(&rtl.demod.thread, demod_thread_fn, &rtl.demod) == 0) {
+        if (rtl.internals) {
+            rtl.internals->demod_thread_started.store(1, std::memory_order_release);
         }
     }
     LOG_INFO("Starting RTL async read...\n");
-    if (rtl_device_start_async(rtl_device_handle, (uint32_t)ACTUAL_BUF_LENGTH) == 0) {
-        if (g_stream) {
-            g_stream->async_started.store(1, std::memory_order_release);
+    if (rtl_device_start_async(rtl.device, (uint32_t)rtl.actual_buf_length) == 0) {
+        if (rtl.internals) {
+            rtl.internals->async_started.store(1, std::memory_order_release);
         }
     }
-    if (port != 0) {
-        g_udp_ctrl = udp_control_start_bound(udp_control_bindaddr, port, [](uint32_t new_freq_hz) {
+    /* The UDP callback carries no context and runs unbound, so it always
+     * retunes the default pipeline; other pipelines do not listen. */
+    if (rtl.udp_port != 0 && rtl_stream_on_default_pipeline()) {
+        rtl.udp_ctrl = udp_control_start_bound(rtl.udp_bindaddr, rtl.udp_port, [](uint32_t new_freq_hz) {
             /* Marshal onto controller thread: single programming path */
             schedule_manual_retune(new_freq_hz);
         });
-        if (!g_udp_ctrl) {
-            LOG_ERROR("Failed to start RTL UDP retune control on %s:%u\n", udp_control_bindaddr, (unsigned)port);
+        if (!rtl.udp_ctrl) {
+            LOG_ERROR("Failed to start RTL UDP retune control on %s:%u\n", rtl.udp_bindaddr, (unsigned)rtl.udp_port);
         }
     }
 }
@@ -5563,7 +5819,7 @@ stream_open_validate_capture_writer_request(const dsd_opts* opts, RadioSourceKin
     if (!opts || !native_format_out) {
         return -1;
     }
-    int native_format = rtl_device_get_native_sample_format(rtl_device_handle);
+    int native_format = rtl_device_get_native_sample_format(rtl_cur().device);
     if (native_format != DSD_IQ_FORMAT_CU8 && native_format != DSD_IQ_FORMAT_CF32) {
         LOG_ERROR("IQ capture unsupported for active backend format.\n");
         return -1;
@@ -5583,6 +5839,7 @@ stream_open_validate_capture_writer_request(const dsd_opts* opts, RadioSourceKin
 static int
 stream_open_fill_capture_writer_config(const dsd_opts* opts, RadioSourceKind source_kind, int native_format,
                                        dsd_iq_capture_config* cfg, char* err_buf, size_t err_buf_size) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts || !cfg || !err_buf || err_buf_size == 0) {
         return -1;
     }
@@ -5605,13 +5862,13 @@ stream_open_fill_capture_writer_config(const dsd_opts* opts, RadioSourceKind sou
     cfg->center_frequency_hz = (uint64_t)opts->rtlsdr_center_freq;
     cfg->capture_center_frequency_hz = (uint64_t)load_dongle_frequency();
     cfg->ppm = load_dongle_ppm_error();
-    cfg->tuner_gain_tenth_db = rtl_device_get_tuner_gain(rtl_device_handle);
+    cfg->tuner_gain_tenth_db = rtl_device_get_tuner_gain(rtl.device);
     cfg->rtl_dsp_bw_khz = opts->rtl_dsp_bw_khz;
-    cfg->base_decimation = (uint32_t)((demod.downsample_passes > 0) ? (1U << demod.downsample_passes) : 1U);
-    cfg->post_downsample = (uint32_t)((demod.post_downsample > 0) ? demod.post_downsample : 1);
-    cfg->demod_rate_hz = (uint32_t)demod.rate_out;
-    cfg->offset_tuning_enabled = dongle.offset_tuning ? 1 : 0;
-    cfg->fs4_shift_enabled = (!dongle.offset_tuning && !disable_fs4_shift) ? 1 : 0;
+    cfg->base_decimation = (uint32_t)((rtl.demod.downsample_passes > 0) ? (1U << rtl.demod.downsample_passes) : 1U);
+    cfg->post_downsample = (uint32_t)((rtl.demod.post_downsample > 0) ? rtl.demod.post_downsample : 1);
+    cfg->demod_rate_hz = (uint32_t)rtl.demod.rate_out;
+    cfg->offset_tuning_enabled = rtl.dongle.offset_tuning ? 1 : 0;
+    cfg->fs4_shift_enabled = (!rtl.dongle.offset_tuning && !disable_fs4_shift) ? 1 : 0;
     const dsdneoRuntimeConfig* runtime_config = dsd_neo_get_config();
     cfg->combine_rotate_enabled = runtime_config ? (runtime_config->combine_rot != 0) : 1;
     cfg->muted_bytes_excluded = 1;
@@ -5625,7 +5882,8 @@ stream_open_fill_capture_writer_config(const dsd_opts* opts, RadioSourceKind sou
 
 static int
 stream_open_capture_writer(const dsd_opts* opts, RadioSourceKind source_kind) {
-    if (!opts || !opts->iq_capture_requested || !rtl_device_handle) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!opts || !opts->iq_capture_requested || !rtl.device) {
         return 0;
     }
 
@@ -5648,84 +5906,87 @@ stream_open_capture_writer(const dsd_opts* opts, RadioSourceKind source_kind) {
         return -1;
     }
 
-    g_iq_capture_writer = writer;
-    rtl_device_set_iq_capture_writer(rtl_device_handle, writer);
+    rtl.iq_capture_writer = writer;
+    rtl_device_set_iq_capture_writer(rtl.device, writer);
     return 0;
 }
 
 static void
 stream_abort_capture_writer(void) {
-    if (!g_iq_capture_writer) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.iq_capture_writer) {
         return;
     }
-    if (rtl_device_handle) {
-        rtl_device_set_iq_capture_writer(rtl_device_handle, NULL);
+    if (rtl.device) {
+        rtl_device_set_iq_capture_writer(rtl.device, NULL);
     }
-    dsd_iq_capture_abort(g_iq_capture_writer);
-    g_iq_capture_writer = NULL;
+    dsd_iq_capture_abort(rtl.iq_capture_writer);
+    rtl.iq_capture_writer = NULL;
 }
 
 static void
 stream_close_capture_writer(void) {
-    if (!g_iq_capture_writer) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.iq_capture_writer) {
         return;
     }
-    if (rtl_device_handle) {
-        rtl_device_set_iq_capture_writer(rtl_device_handle, NULL);
+    if (rtl.device) {
+        rtl_device_set_iq_capture_writer(rtl.device, NULL);
     }
     dsd_iq_capture_final_stats stats = {};
-    stats.input_ring_drops = input_ring.producer_drops.load(std::memory_order_acquire);
-    stats.retune_count = rtl_device_get_capture_retune_count(rtl_device_handle);
-    dsd_iq_capture_close(g_iq_capture_writer, &stats);
-    g_iq_capture_writer = NULL;
+    stats.input_ring_drops = rtl.input_ring.producer_drops.load(std::memory_order_acquire);
+    stats.retune_count = rtl_device_get_capture_retune_count(rtl.device);
+    dsd_iq_capture_close(rtl.iq_capture_writer, &stats);
+    rtl.iq_capture_writer = NULL;
 }
 
 static int
 stream_prepare_internals(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return -1;
     }
 
-    if (g_stream) {
-        if (g_stream->replay_eof_sync_inited) {
-            (void)dsd_cond_destroy(&g_stream->replay_eof_cond);
-            (void)dsd_mutex_destroy(&g_stream->replay_eof_m);
+    if (rtl.internals) {
+        if (rtl.internals->replay_eof_sync_inited) {
+            (void)dsd_cond_destroy(&rtl.internals->replay_eof_cond);
+            (void)dsd_mutex_destroy(&rtl.internals->replay_eof_m);
         }
-        free(g_stream);
-        g_stream = NULL;
+        free(rtl.internals);
+        rtl.internals = NULL;
     }
 
-    g_stream = static_cast<struct RtlSdrInternals*>(calloc(1, sizeof(struct RtlSdrInternals)));
-    if (!g_stream) {
+    rtl.internals = static_cast<struct RtlSdrInternals*>(calloc(1, sizeof(struct RtlSdrInternals)));
+    if (!rtl.internals) {
         return -1;
     }
 
-    g_stream->device = rtl_device_handle;
-    g_stream->dongle = &dongle;
-    g_stream->demod = &demod;
-    g_stream->output = &output;
-    g_stream->controller = &controller;
-    g_stream->input_ring = &input_ring;
-    g_stream->udp_ctrl_ptr = &g_udp_ctrl;
-    g_stream->opts = opts;
-    g_stream->should_exit.store(0, std::memory_order_release);
-    g_stream->controller_thread_started.store(0, std::memory_order_release);
-    g_stream->demod_thread_started.store(0, std::memory_order_release);
-    g_stream->async_started.store(0, std::memory_order_release);
-
-    if (dsd_mutex_init(&g_stream->replay_eof_m) != 0) {
-        free(g_stream);
-        g_stream = NULL;
+    rtl.internals->device = rtl.device;
+    rtl.internals->dongle = &rtl.dongle;
+    rtl.internals->demod = &rtl.demod;
+    rtl.internals->output = &rtl.output;
+    rtl.internals->controller = &rtl.controller;
+    rtl.internals->input_ring = &rtl.input_ring;
+    rtl.internals->udp_ctrl_ptr = &rtl.udp_ctrl;
+    rtl.internals->opts = opts;
+    rtl.internals->should_exit.store(0, std::memory_order_release);
+    rtl.internals->controller_thread_started.store(0, std::memory_order_release);
+    rtl.internals->demod_thread_started.store(0, std::memory_order_release);
+    rtl.internals->async_started.store(0, std::memory_order_release);
+
+    if (dsd_mutex_init(&rtl.internals->replay_eof_m) != 0) {
+        free(rtl.internals);
+        rtl.internals = NULL;
         return -1;
     }
-    if (dsd_cond_init(&g_stream->replay_eof_cond) != 0) {
-        (void)dsd_mutex_destroy(&g_stream->replay_eof_m);
-        free(g_stream);
-        g_stream = NULL;
+    if (dsd_cond_init(&rtl.internals->replay_eof_cond) != 0) {
+        (void)dsd_mutex_destroy(&rtl.internals->replay_eof_m);
+        free(rtl.internals);
+        rtl.internals = NULL;
         return -1;
     }
-    g_stream->replay_eof_sync_inited = 1;
-    stream_reset_replay_eof_state(g_stream);
+    rtl.internals->replay_eof_sync_inited = 1;
+    stream_reset_replay_eof_state(rtl.internals);
 
     stream_refresh_watermark_for_current_rate();
 
@@ -5734,15 +5995,16 @@ stream_prepare_internals(const dsd_opts* opts) {
 
 static void
 stream_destroy_internals(void) {
-    if (!g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals) {
         return;
     }
-    if (g_stream->replay_eof_sync_inited) {
-        (void)dsd_cond_destroy(&g_stream->replay_eof_cond);
-        (void)dsd_mutex_destroy(&g_stream->replay_eof_m);
+    if (rtl.internals->replay_eof_sync_inited) {
+        (void)dsd_cond_destroy(&rtl.internals->replay_eof_cond);
+        (void)dsd_mutex_destroy(&rtl.internals->replay_eof_m);
     }
-    free(g_stream);
-    g_stream = NULL;
+    free(rtl.internals);
+    rtl.internals = NULL;
 }
 
 /* Forward decls for auto-PPM status helpers */
@@ -5792,21 +6054,22 @@ stream_open_prepare_replay_config(dsd_opts* opts, RadioSourceKind source_kind, d
 
 static void
 stream_open_reset_auto_ppm_state(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return;
     }
-    g_auto_ppm_controller.reset(load_dongle_ppm_error(), opts->rtlsdr_center_freq);
-    g_auto_ppm_enabled.store(0, std::memory_order_relaxed);
-    g_auto_ppm_locked.store(0, std::memory_order_relaxed);
-    g_auto_ppm_training.store(0, std::memory_order_relaxed);
-    g_auto_ppm_lock_ppm.store(0, std::memory_order_relaxed);
-    g_auto_ppm_lock_snr_db.store(-100.0, std::memory_order_relaxed);
-    g_auto_ppm_lock_df_hz.store(0.0, std::memory_order_relaxed);
-    g_auto_ppm_snr_db.store(-100.0, std::memory_order_relaxed);
-    g_auto_ppm_df_hz.store(0.0, std::memory_order_relaxed);
-    g_auto_ppm_est_ppm.store(0.0, std::memory_order_relaxed);
-    g_auto_ppm_last_dir.store(0, std::memory_order_relaxed);
-    g_auto_ppm_cooldown.store(0, std::memory_order_relaxed);
+    rtl.auto_ppm_controller.reset(load_dongle_ppm_error(), opts->rtlsdr_center_freq);
+    rtl.shared.auto_ppm_enabled.store(0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_locked.store(0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_training.store(0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_lock_ppm.store(0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_lock_snr_db.store(-100.0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_lock_df_hz.store(0.0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_snr_db.store(-100.0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_df_hz.store(0.0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_est_ppm.store(0.0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_last_dir.store(0, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_cooldown.store(0, std::memory_order_relaxed);
 }
 
 static void
@@ -5849,21 +6112,22 @@ stream_open_volume_multiplier(const dsd_opts* opts) {
 
 static int
 stream_open_init_pipeline(const dsd_opts* opts, int demod_base_rate_hz) {
-    dongle_init(&dongle);
-    rtl_demod_init_for_mode(&demod, &output, opts, demod_base_rate_hz);
-    output_init(&output);
-    if (!output.buffer) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    dongle_init(&rtl.dongle);
+    rtl_demod_init_for_mode(&rtl.demod, &rtl.output, opts, demod_base_rate_hz);
+    output_init(&rtl.output);
+    if (!rtl.output.buffer) {
         LOG_ERROR("Output ring buffer allocation failed.\n");
         return -1;
     }
-    if (input_ring_init(&input_ring, (size_t)(MAXIMUM_BUF_LENGTH * 8)) != 0) {
+    if (input_ring_init(&rtl.input_ring, (size_t)(MAXIMUM_BUF_LENGTH * 8)) != 0) {
         LOG_ERROR("Failed to initialize input ring buffer.\n");
         return -1;
     }
-    input_ring_enable_space_notify(&input_ring, 0);
-    controller_init(&controller);
-    rtl_demod_config_from_env_and_opts(&demod, opts);
-    rtl_demod_select_defaults_for_mode(&demod, opts, &output);
+    input_ring_enable_space_notify(&rtl.input_ring, 0);
+    controller_init(&rtl.controller);
+    rtl_demod_config_from_env_and_opts(&rtl.demod, opts);
+    rtl_demod_select_defaults_for_mode(&rtl.demod, opts, &rtl.output);
     if (stream_prepare_internals(opts) != 0) {
         LOG_ERROR("Failed to initialize RTL stream internals.\n");
         return -1;
@@ -5878,21 +6142,22 @@ stream_open_enable_default_autogain(const dsd_opts* opts) {
     }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     if (cfg && cfg->tuner_autogain_enable) {
-        g_tuner_autogain_on.store(1, std::memory_order_relaxed);
+        rtl_cur().shared.tuner_autogain_on.store(1, std::memory_order_relaxed);
     }
 }
 
 static int
 stream_open_validate_scan_inputs(void) {
-    if (controller.freq_len == 0) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (rtl.controller.freq_len == 0) {
         LOG_ERROR("Please specify a frequency.\n");
         return -1;
     }
-    if (controller.freq_len >= FREQUENCIES_LIMIT) {
+    if (rtl.controller.freq_len >= FREQUENCIES_LIMIT) {
         LOG_ERROR("Too many channels, maximum %i.\n", FREQUENCIES_LIMIT);
         return -1;
     }
-    if (controller.freq_len > 1 && demod.channel_squelch_level == 0.0f) {
+    if (rtl.controller.freq_len > 1 && rtl.demod.channel_squelch_level == 0.0f) {
         LOG_ERROR("Please specify a squelch level.  Required for scanning multiple frequencies.\n");
         return -1;
     }
@@ -5901,35 +6166,37 @@ stream_open_validate_scan_inputs(void) {
 
 static void
 stream_open_fill_replay_eof_state(struct rtl_replay_eof_state* eof_state) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!eof_state) {
         return;
     }
     *eof_state = {};
-    if (!g_stream) {
-        return;
-    }
-    eof_state->stream_exit_flag = &g_stream->should_exit;
-    eof_state->replay_input_eof = &g_stream->replay_input_eof;
-    eof_state->replay_input_drained = &g_stream->replay_input_drained;
-    eof_state->replay_demod_drained = &g_stream->replay_demod_drained;
-    eof_state->replay_output_drained = &g_stream->replay_output_drained;
-    eof_state->replay_forced_stop = &g_stream->replay_forced_stop;
-    eof_state->replay_last_submit_gen = &g_stream->replay_last_submit_gen;
-    eof_state->replay_last_submit_gen_at_eof = &g_stream->replay_last_submit_gen_at_eof;
-    eof_state->replay_last_consume_gen = &g_stream->replay_last_consume_gen;
-    eof_state->eof_m = &g_stream->replay_eof_m;
-    eof_state->eof_cond = &g_stream->replay_eof_cond;
+    if (!rtl.internals) {
+        return;
+    }
+    eof_state->stream_exit_flag = &rtl.internals->should_exit;
+    eof_state->replay_input_eof = &rtl.internals->replay_input_eof;
+    eof_state->replay_input_drained = &rtl.internals->replay_input_drained;
+    eof_state->replay_demod_drained = &rtl.internals->replay_demod_drained;
+    eof_state->replay_output_drained = &rtl.internals->replay_output_drained;
+    eof_state->replay_forced_stop = &rtl.internals->replay_forced_stop;
+    eof_state->replay_last_submit_gen = &rtl.internals->replay_last_submit_gen;
+    eof_state->replay_last_submit_gen_at_eof = &rtl.internals->replay_last_submit_gen_at_eof;
+    eof_state->replay_last_consume_gen = &rtl.internals->replay_last_consume_gen;
+    eof_state->eof_m = &rtl.internals->replay_eof_m;
+    eof_state->eof_cond = &rtl.internals->replay_eof_cond;
     eof_state->on_input_drained = rtl_replay_on_input_drained;
     eof_state->on_retune_event = rtl_replay_on_retune_event;
     eof_state->on_mute_event = rtl_replay_on_mute_event;
     eof_state->on_reset_event = rtl_replay_on_reset_event;
     eof_state->on_loop_restart = rtl_replay_on_loop_restart;
-    eof_state->eof_user = g_stream;
-    eof_state->event_user = g_stream;
+    eof_state->eof_user = rtl.internals;
+    eof_state->event_user = rtl.internals;
 }
 
 static int
 stream_open_open_device_rtltcp(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     int autotune = opts->rtltcp_autotune;
     if (!autotune) {
         const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
@@ -5937,39 +6204,41 @@ stream_open_open_device_rtltcp(const dsd_opts* opts) {
             autotune = 1;
         }
     }
-    rtl_device_handle = rtl_device_create_tcp(opts->rtltcp_hostname, opts->rtltcp_portno, &input_ring, autotune);
-    if (!rtl_device_handle) {
+    rtl.device = rtl_device_create_tcp(opts->rtltcp_hostname, opts->rtltcp_portno, &rtl.input_ring, autotune);
+    if (!rtl.device) {
         LOG_ERROR("Failed to connect rtl_tcp at %s:%d.\n", opts->rtltcp_hostname, opts->rtltcp_portno);
         return -1;
     }
     LOG_INFO("Using rtl_tcp source %s:%d.\n", opts->rtltcp_hostname, opts->rtltcp_portno);
-    rtl_device_print_offset_capability(rtl_device_handle);
+    rtl_device_print_offset_capability(rtl.device);
     return 0;
 }
 
 static int
 stream_open_open_device_replay(const dsd_iq_replay_config* replay_cfg, int replay_cfg_loaded) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!replay_cfg_loaded || !replay_cfg) {
         LOG_ERROR("IQ replay metadata is unavailable.\n");
         return -1;
     }
     struct rtl_replay_eof_state eof_state = {};
     stream_open_fill_replay_eof_state(&eof_state);
-    rtl_device_handle = rtl_device_create_iq_replay(replay_cfg, &input_ring, &eof_state);
-    if (!rtl_device_handle) {
+    rtl.device = rtl_device_create_iq_replay(replay_cfg, &rtl.input_ring, &eof_state);
+    if (!rtl.device) {
         LOG_ERROR("Failed to initialize IQ replay source.\n");
         return -1;
     }
     LOG_INFO("Using IQ replay source: %s.\n", replay_cfg->metadata_path);
-    rtl_device_print_offset_capability(rtl_device_handle);
+    rtl_device_print_offset_capability(rtl.device);
     return 0;
 }
 
 static int
 stream_open_open_device_soapy(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     const char* soapy_args = radio_source_soapy_args(opts);
-    rtl_device_handle = rtl_device_create_soapy(soapy_args, &input_ring);
-    if (!rtl_device_handle) {
+    rtl.device = rtl_device_create_soapy(soapy_args, &rtl.input_ring);
+    if (!rtl.device) {
         if (soapy_args[0] != '\0') {
             LOG_ERROR("Failed to open SoapySDR device with args: %s.\n", soapy_args);
         } else {
@@ -5982,7 +6251,7 @@ stream_open_open_device_soapy(const dsd_opts* opts) {
     } else {
         LOG_INFO("Using SoapySDR default source.\n");
     }
-    rtl_device_print_offset_capability(rtl_device_handle);
+    rtl_device_print_offset_capability(rtl.device);
     struct rtl_soapy_config soapy_cfg = {};
     soapy_cfg.profile = opts->soapy_profile;
     soapy_cfg.antenna = opts->soapy_antenna;
@@ -5991,12 +6260,12 @@ stream_open_open_device_soapy(const dsd_opts* opts) {
     soapy_cfg.gains = opts->soapy_gains;
     soapy_cfg.stream_format = opts->soapy_stream_format;
     soapy_cfg.bandwidth_hz = opts->soapy_bandwidth_hz;
-    soapy_cfg.center_freq_hz = (controller.freq_len > 0) ? controller.freqs[0] : 0U;
-    int soapy_cfg_rc = rtl_device_configure_soapy(rtl_device_handle, &soapy_cfg);
+    soapy_cfg.center_freq_hz = (rtl.controller.freq_len > 0) ? rtl.controller.freqs[0] : 0U;
+    int soapy_cfg_rc = rtl_device_configure_soapy(rtl.device, &soapy_cfg);
     if (soapy_cfg_rc != 0) {
         LOG_ERROR("Failed to apply SoapySDR profile/configuration (rc=%d).\n", soapy_cfg_rc);
-        rtl_device_destroy(rtl_device_handle);
-        rtl_device_handle = NULL;
+        rtl_device_destroy(rtl.device);
+        rtl.device = NULL;
         stream_destroy_internals();
         return -1;
     }
@@ -6005,19 +6274,21 @@ stream_open_open_device_soapy(const dsd_opts* opts) {
 
 static int
 stream_open_open_device_usb(void) {
-    rtl_device_handle = rtl_device_create(dongle.dev_index, &input_ring);
-    if (!rtl_device_handle) {
-        LOG_ERROR("Failed to open rtlsdr device %d.\n", dongle.dev_index);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.device = rtl_device_create(rtl.dongle.dev_index, &rtl.input_ring);
+    if (!rtl.device) {
+        LOG_ERROR("Failed to open rtlsdr device %d.\n", rtl.dongle.dev_index);
         return -1;
     }
-    LOG_INFO("Using RTLSDR Device Index: %d. \n", dongle.dev_index);
-    rtl_device_print_offset_capability(rtl_device_handle);
+    LOG_INFO("Using RTLSDR Device Index: %d. \n", rtl.dongle.dev_index);
+    rtl_device_print_offset_capability(rtl.device);
     return 0;
 }
 
 static int
 stream_open_open_device(RadioSourceKind source_kind, const dsd_opts* opts, const dsd_iq_replay_config* replay_cfg,
                         int replay_cfg_loaded) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return -1;
     }
@@ -6034,8 +6305,8 @@ stream_open_open_device(RadioSourceKind source_kind, const dsd_opts* opts, const
     if (rc != 0) {
         return rc;
     }
-    if (g_stream) {
-        g_stream->device = rtl_device_handle;
+    if (rtl.internals) {
+        rtl.internals->device = rtl.device;
     }
     return 0;
 }
@@ -6093,7 +6364,7 @@ stream_open_apply_if_gains_config(const char* gains) {
         }
         int gain_tenth = 0;
         stream_open_parse_if_gain_tenth_db(colon + 1, &gain_tenth);
-        int rc = rtl_device_set_if_gain(rtl_device_handle, stage, gain_tenth);
+        int rc = rtl_device_set_if_gain(rtl_cur().device, stage, gain_tenth);
         log_unsupported_control_if_needed("IF gain control", rc);
     }
 }
@@ -6103,36 +6374,38 @@ stream_open_apply_bias_tee(const dsd_opts* opts) {
     if (!opts || !opts->rtl_bias_tee) {
         return;
     }
-    int rc = rtl_device_set_bias_tee(rtl_device_handle, 1);
+    int rc = rtl_device_set_bias_tee(rtl_cur().device, 1);
     log_unsupported_control_if_needed("Bias tee control", rc);
 }
 
 static void
 stream_open_apply_direct_sampling(const dsdneoRuntimeConfig* cfg) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!cfg || !cfg->rtl_direct_is_set) {
         return;
     }
     int mode = cfg->rtl_direct_mode;
-    int rc = rtl_device_set_direct_sampling(rtl_device_handle, mode);
+    int rc = rtl_device_set_direct_sampling(rtl.device, mode);
     if (rc == 0) {
-        dongle.direct_sampling = mode;
+        rtl.dongle.direct_sampling = mode;
     } else {
-        dongle.direct_sampling = 0;
+        rtl.dongle.direct_sampling = 0;
         log_unsupported_control_if_needed("Direct sampling control", rc);
     }
 }
 
 static void
 stream_open_apply_offset_tuning(const dsdneoRuntimeConfig* cfg) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!cfg || !cfg->rtl_offset_tuning_is_set) {
         return;
     }
     int on = cfg->rtl_offset_tuning_enable ? 1 : 0;
-    int rc = rtl_device_set_offset_tuning_enabled(rtl_device_handle, on);
+    int rc = rtl_device_set_offset_tuning_enabled(rtl.device, on);
     if (rc == 0) {
-        dongle.offset_tuning = on ? 1 : 0;
+        rtl.dongle.offset_tuning = on ? 1 : 0;
     } else {
-        dongle.offset_tuning = 0;
+        rtl.dongle.offset_tuning = 0;
         log_unsupported_control_if_needed("Offset tuning control", rc);
     }
 }
@@ -6144,7 +6417,7 @@ stream_open_apply_xtal_control(const dsdneoRuntimeConfig* cfg) {
     }
     uint32_t rtl_xtal_hz = cfg->rtl_xtal_hz_is_set ? (uint32_t)cfg->rtl_xtal_hz : 0U;
     uint32_t tuner_xtal_hz = cfg->tuner_xtal_hz_is_set ? (uint32_t)cfg->tuner_xtal_hz : 0U;
-    int rc = rtl_device_set_xtal_freq(rtl_device_handle, rtl_xtal_hz, tuner_xtal_hz);
+    int rc = rtl_device_set_xtal_freq(rtl_cur().device, rtl_xtal_hz, tuner_xtal_hz);
     log_unsupported_control_if_needed("Xtal frequency control", rc);
 }
 
@@ -6154,7 +6427,7 @@ stream_open_apply_testmode(const dsdneoRuntimeConfig* cfg) {
         return;
     }
     int on = cfg->rtl_testmode_enable ? 1 : 0;
-    int rc = rtl_device_set_testmode(rtl_device_handle, on);
+    int rc = rtl_device_set_testmode(rtl_cur().device, on);
     log_unsupported_control_if_needed("Test mode control", rc);
 }
 
@@ -6176,14 +6449,15 @@ stream_open_apply_runtime_controls(const dsd_opts* opts) {
 
 static void
 stream_open_apply_deemphasis_from_config(void) {
-    if (!demod.deemph) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.demod.deemph) {
         return;
     }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     double tau_s = 75e-6;
     if (cfg && cfg->deemph_is_set) {
         if (cfg->deemph_mode == DSD_NEO_DEEMPH_OFF) {
-            demod.deemph = 0;
+            rtl.demod.deemph = 0;
         } else if (cfg->deemph_mode == DSD_NEO_DEEMPH_50) {
             tau_s = 50e-6;
         } else if (cfg->deemph_mode == DSD_NEO_DEEMPH_NFM) {
@@ -6192,10 +6466,10 @@ stream_open_apply_deemphasis_from_config(void) {
             tau_s = 75e-6;
         }
     }
-    if (!demod.deemph) {
+    if (!rtl.demod.deemph) {
         return;
     }
-    double Fs = (double)demod.rate_out;
+    double Fs = (double)rtl.demod.rate_out;
     if (Fs < 1.0) {
         Fs = 1.0;
     }
@@ -6207,15 +6481,16 @@ stream_open_apply_deemphasis_from_config(void) {
     } else if (coef_q15 > ((1 << 15) - 1)) {
         coef_q15 = ((1 << 15) - 1);
     }
-    demod.deemph_a = (float)((double)coef_q15 / (double)(1 << 15));
+    rtl.demod.deemph_a = (float)((double)coef_q15 / (double)(1 << 15));
 }
 
 static void
 stream_open_apply_audio_lpf_from_config(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    demod.audio_lpf_enable = 0;
-    demod.audio_lpf_alpha = 0;
-    demod.audio_lpf_state = 0;
+    rtl.demod.audio_lpf_enable = 0;
+    rtl.demod.audio_lpf_alpha = 0;
+    rtl.demod.audio_lpf_state = 0;
     if (!cfg || !cfg->audio_lpf_is_set || cfg->audio_lpf_disable || cfg->audio_lpf_cutoff_hz <= 0) {
         return;
     }
@@ -6223,7 +6498,7 @@ stream_open_apply_audio_lpf_from_config(void) {
     if (cutoff_hz < 100) {
         cutoff_hz = 100;
     }
-    double Fs = (double)demod.rate_out;
+    double Fs = (double)rtl.demod.rate_out;
     if (Fs < 1.0) {
         Fs = 1.0;
     }
@@ -6234,10 +6509,10 @@ stream_open_apply_audio_lpf_from_config(void) {
     if (a > 1.0) {
         a = 1.0;
     }
-    demod.audio_lpf_alpha = (float)a;
-    demod.audio_lpf_enable = 1;
+    rtl.demod.audio_lpf_alpha = (float)a;
+    rtl.demod.audio_lpf_enable = 1;
     const char* approx = dsd_unicode_or_ascii("≈", "~");
-    LOG_INFO("Audio LPF enabled: fc%s%d Hz, alpha=%.4f\n", approx, cutoff_hz, demod.audio_lpf_alpha);
+    LOG_INFO("Audio LPF enabled: fc%s%d Hz, alpha=%.4f\n", approx, cutoff_hz, rtl.demod.audio_lpf_alpha);
 }
 
 /**
@@ -6249,16 +6524,17 @@ stream_open_apply_audio_lpf_from_config(void) {
  */
 static int
 stream_open_validate_device_capture_rate(RadioSourceKind source_kind) {
-    if (source_kind == RADIO_SOURCE_IQ_REPLAY || !rtl_device_handle) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (source_kind == RADIO_SOURCE_IQ_REPLAY || !rtl.device) {
         return 0;
     }
-    int passes = rtl_downsample_passes_for_rate_in(demod.rate_in);
-    long long ideal = (long long)demod.rate_in * (1LL << passes);
+    int passes = rtl_downsample_passes_for_rate_in(rtl.demod.rate_in);
+    long long ideal = (long long)rtl.demod.rate_in * (1LL << passes);
     if (ideal <= 0 || ideal > (long long)UINT32_MAX) {
         return 0;
     }
     uint32_t deliverable_hz = 0U;
-    if (rtl_device_nearest_supported_rate(rtl_device_handle, (uint32_t)ideal, &deliverable_hz) != 0
+    if (rtl_device_nearest_supported_rate(rtl.device, (uint32_t)ideal, &deliverable_hz) != 0
         || deliverable_hz == 0U) {
         return 0;
     }
@@ -6273,8 +6549,9 @@ stream_open_validate_device_capture_rate(RadioSourceKind source_kind) {
 
 static void
 stream_open_note_ppm_capability(void) {
-    int supported = rtl_device_supports_ppm(rtl_device_handle) ? 1 : 0;
-    g_ppm_control_supported.store(supported, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    int supported = rtl_device_supports_ppm(rtl.device) ? 1 : 0;
+    rtl.ppm_control_supported.store(supported, std::memory_order_relaxed);
     if (!supported) {
         LOG_INFO("Device does not support frequency (PPM) correction; auto-PPM is disabled.\n");
     }
@@ -6282,11 +6559,12 @@ stream_open_note_ppm_capability(void) {
 
 static void
 stream_open_apply_requested_ppm(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return;
     }
     RtlRequestedPpmState initial_ppm_request = snapshot_requested_ppm_state(opts);
-    if (initial_ppm_request.ppm != 0 && !g_ppm_control_supported.load(std::memory_order_relaxed)) {
+    if (initial_ppm_request.ppm != 0 && !rtl.ppm_control_supported.load(std::memory_order_relaxed)) {
         LOG_INFO("Device does not support frequency (PPM) correction; configured ppm %d will have no effect.\n",
                  initial_ppm_request.ppm);
     }
@@ -6297,58 +6575,60 @@ stream_open_apply_requested_ppm(const dsd_opts* opts) {
         note_failed_ppm_request(initial_ppm_request.ppm, initial_ppm_request.request_id, load_dongle_ppm_error(),
                                 ppm_rc);
     }
-    g_auto_ppm_controller.reset(load_dongle_ppm_error(), opts->rtlsdr_center_freq);
+    rtl.auto_ppm_controller.reset(load_dongle_ppm_error(), opts->rtlsdr_center_freq);
 }
 
 static int
 stream_open_apply_controller_settings(RadioSourceKind source_kind, const dsd_opts* opts,
                                       const dsd_iq_replay_config* replay_cfg, int replay_cfg_loaded) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return -1;
     }
     if (source_kind == RADIO_SOURCE_IQ_REPLAY) {
-        if (!replay_cfg_loaded || controller_apply_replay_settings(&controller, opts, replay_cfg) != 0) {
+        if (!replay_cfg_loaded || controller_apply_replay_settings(&rtl.controller, opts, replay_cfg) != 0) {
             LOG_ERROR("Failed to apply replay stream settings.\n");
             return -1;
         }
-        input_ring_enable_space_notify(&input_ring, 1);
+        input_ring_enable_space_notify(&rtl.input_ring, 1);
         return 0;
     }
-    if (controller.freq_len == 0) {
-        controller.freqs[controller.freq_len] = 446000000;
-        controller.freq_len++;
+    if (rtl.controller.freq_len == 0) {
+        rtl.controller.freqs[rtl.controller.freq_len] = 446000000;
+        rtl.controller.freq_len++;
     }
-    if (controller_apply_initial_settings(&controller, opts) != 0) {
+    if (controller_apply_initial_settings(&rtl.controller, opts) != 0) {
         LOG_ERROR("Failed to apply initial tuner settings.\n");
         return -1;
     }
     stream_refresh_watermark_for_current_rate();
-    input_ring_enable_space_notify(&input_ring, 0);
+    input_ring_enable_space_notify(&rtl.input_ring, 0);
     return 0;
 }
 
 static void
 stream_open_configure_resampler_chain(void) {
-    const int digital_target_hz = rtl_demod_digital_resample_target_hz(&demod);
-    const bool digital_output =
-        (demod.output_kind == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK || demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR);
+    dsd_rtl_stream& rtl = rtl_cur();
+    const int digital_target_hz = rtl_demod_digital_resample_target_hz(&rtl.demod);
+    const bool digital_output = (rtl.demod.output_kind == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK
+                                 || rtl.demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR);
     if (digital_output && digital_target_hz <= 0) {
-        demod.resamp_enabled = 0;
-        demod.resamp_L = 1;
-        demod.resamp_M = 1;
-        demod.resamp_phase = 0;
+        rtl.demod.resamp_enabled = 0;
+        rtl.demod.resamp_L = 1;
+        rtl.demod.resamp_M = 1;
+        rtl.demod.resamp_phase = 0;
         return;
     }
-    if (demod.resamp_target_hz <= 0) {
-        demod.resamp_enabled = 0;
+    if (rtl.demod.resamp_target_hz <= 0) {
+        rtl.demod.resamp_enabled = 0;
         return;
     }
-    int target = demod.resamp_target_hz;
-    int inRate = demod.rate_out > 0 ? demod.rate_out : rtl_dsp_bw_hz;
+    int target = rtl.demod.resamp_target_hz;
+    int inRate = rtl.demod.rate_out > 0 ? rtl.demod.rate_out : rtl.dsp_bw_hz;
     if (target == inRate) {
-        demod.resamp_enabled = 0;
-        demod.resamp_L = 1;
-        demod.resamp_M = 1;
+        rtl.demod.resamp_enabled = 0;
+        rtl.demod.resamp_L = 1;
+        rtl.demod.resamp_M = 1;
         LOG_INFO("Resampler bypassed: input rate %d Hz matches target.\n", inRate);
         return;
     }
@@ -6364,36 +6644,39 @@ stream_open_configure_resampler_chain(void) {
     int scale = (L + M - 1) / M;
     if (scale > 12) {
         LOG_WARN("WARNING: Resampler ratio too large (L=%d,M=%d). Disabling resampler.\n", L, M);
-        demod.resamp_enabled = 0;
+        rtl.demod.resamp_enabled = 0;
         return;
     }
-    demod.resamp_enabled = 1;
-    resamp_design(&demod, L, M);
+    rtl.demod.resamp_enabled = 1;
+    resamp_design(&rtl.demod, L, M);
     LOG_INFO("Rational resampler configured: %d -> %d Hz (L=%d,M=%d).\n", inRate, target, L, M);
 }
 
 static void
 stream_open_update_output_rates(void) {
-    if (demod.resamp_enabled && demod.resamp_target_hz > 0) {
-        output.rate = demod.resamp_target_hz;
-        LOG_INFO("Output rate set to %d Hz via resampler.\n", output.rate);
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (rtl.demod.resamp_enabled && rtl.demod.resamp_target_hz > 0) {
+        rtl.output.rate = rtl.demod.resamp_target_hz;
+        LOG_INFO("Output rate set to %d Hz via resampler.\n", rtl.output.rate);
     } else {
-        output.rate = demod.rate_out;
+        rtl.output.rate = rtl.demod.rate_out;
     }
 }
 
 static void
 stream_open_log_rate_chain_summary(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     unsigned int capture_hz = load_dongle_rate();
-    int base_decim = (demod.downsample_passes > 0) ? (1 << demod.downsample_passes) : 1;
-    int post = (demod.post_downsample > 0) ? demod.post_downsample : 1;
-    unsigned int demod_hz = (unsigned int)demod.rate_out;
-    unsigned int out_hz =
-        demod.resamp_enabled && demod.resamp_target_hz > 0 ? (unsigned int)demod.resamp_target_hz : demod_hz;
-    if (demod.resamp_enabled) {
+    int base_decim = (rtl.demod.downsample_passes > 0) ? (1 << rtl.demod.downsample_passes) : 1;
+    int post = (rtl.demod.post_downsample > 0) ? rtl.demod.post_downsample : 1;
+    unsigned int demod_hz = (unsigned int)rtl.demod.rate_out;
+    unsigned int out_hz = rtl.demod.resamp_enabled && rtl.demod.resamp_target_hz > 0
+                              ? (unsigned int)rtl.demod.resamp_target_hz
+                              : demod_hz;
+    if (rtl.demod.resamp_enabled) {
         LOG_INFO("Rate chain: capture=%u Hz, base_decim=%d, post=%d -> demod=%u Hz; resampler L/M=%d/%d -> output=%u "
                  "Hz.\n",
-                 capture_hz, base_decim, post, demod_hz, demod.resamp_L, demod.resamp_M, out_hz);
+                 capture_hz, base_decim, post, demod_hz, rtl.demod.resamp_L, rtl.demod.resamp_M, out_hz);
     } else {
         LOG_INFO("Rate chain: capture=%u Hz, base_decim=%d, post=%d -> demod=%u Hz; resampler bypassed -> output=%u "
                  "Hz.\n",
@@ -6436,38 +6719,32 @@ stream_open_rtltcp_desired_prebuffer(uint32_t sample_rate_hz, int pre_ms) {
 
 static void
 stream_open_rtltcp_resize_ring_if_needed(size_t min_capacity, int pre_ms) {
-    if (min_capacity <= input_ring.capacity) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (min_capacity <= rtl.input_ring.capacity) {
         return;
     }
-    float* nb = static_cast<float*>(dsd_neo_aligned_malloc(min_capacity * sizeof(float)));
-    if (!nb) {
+    const double elem_bytes = (double)input_ring_elem_bytes(&rtl.input_ring);
+    if (input_ring_resize(&rtl.input_ring, min_capacity, rtl.input_ring.format) != 0) {
         LOG_WARN("WARNING: rtltcp: allocation for %zu samples (%.2f MiB) failed; using existing ring (%zu).\n",
-                 min_capacity, (double)min_capacity * sizeof(float) / (1024.0 * 1024.0), input_ring.capacity);
+                 min_capacity, (double)min_capacity * elem_bytes / (1024.0 * 1024.0), rtl.input_ring.capacity);
         return;
     }
-    if (input_ring.buffer) {
-        dsd_neo_aligned_free(input_ring.buffer);
-    }
-    input_ring.buffer = nb;
-    input_ring.capacity = min_capacity;
-    input_ring.head.store(0);
-    input_ring.tail.store(0);
-    LOG_INFO("rtltcp resized input ring to %zu samples (%.2f MiB) for ~%d ms prebuffer.\n", input_ring.capacity,
-             (double)input_ring.capacity * sizeof(float) / (1024.0 * 1024.0), pre_ms);
+    LOG_INFO("rtltcp resized input ring to %zu samples (%.2f MiB) for ~%d ms prebuffer.\n", rtl.input_ring.capacity,
+             (double)rtl.input_ring.capacity * elem_bytes / (1024.0 * 1024.0), pre_ms);
 }
 
 static size_t
 stream_open_rtltcp_target_prebuffer(size_t desired_prebuf) {
     size_t target = desired_prebuf;
     target = std::max(target, (size_t)16384U);
-    target = std::min(target, input_ring.capacity / 2U);
+    target = std::min(target, rtl_cur().input_ring.capacity / 2U);
     return target;
 }
 
 static void
 stream_open_rtltcp_wait_for_prebuffer(size_t target) {
     int waited_ms = 0;
-    while (!dsd_exitflag_load() && input_ring_used(&input_ring) < target && waited_ms < 2000) {
+    while (!dsd_exitflag_load() && input_ring_used(&rtl_cur().input_ring) < target && waited_ms < 2000) {
         dsd_sleep_ms(2);
         waited_ms += 2;
     }
@@ -6475,6 +6752,7 @@ stream_open_rtltcp_wait_for_prebuffer(size_t target) {
 
 static int
 stream_open_start_rtltcp_pipeline(const dsd_opts* opts) {
+    dsd_rtl_stream& rtl = rtl_cur();
     UNUSED(opts);
     int pre_ms = stream_open_rtltcp_prebuffer_ms();
 
@@ -6488,28 +6766,29 @@ stream_open_start_rtltcp_pipeline(const dsd_opts* opts) {
     LOG_INFO("rtltcp prebuffer target: %zu samples (%.3f s at %u Hz).\n", target, target_sec, (unsigned)sample_rate_hz);
 
     LOG_INFO("Starting RTL async read (rtltcp prebuffer %d ms)...\n", pre_ms);
-    if (rtl_device_start_async(rtl_device_handle, (uint32_t)ACTUAL_BUF_LENGTH) != 0) {
+    if (rtl_device_start_async(rtl.device, (uint32_t)rtl.actual_buf_length) != 0) {
         LOG_ERROR("Failed to start rtl_tcp async reader.\n");
         return -1;
     }
-    if (g_stream) {
-        g_stream->async_started.store(1, std::memory_order_release);
+    if (rtl.internals) {
+        rtl.internals->async_started.store(1, std::memory_order_release);
     }
 
     stream_open_rtltcp_wait_for_prebuffer(target);
-    LOG_INFO("rtltcp prebuffer filled: %zu/%zu samples in ring.\n", input_ring_used(&input_ring), target);
+    LOG_INFO("rtltcp prebuffer filled: %zu/%zu samples in ring.\n", input_ring_used(&rtl.input_ring), target);
 
-    if (dsd_thread_create(&controller.thread, controller_thread_retune_loop, &controller) == 0 && g_stream) {
-        g_stream->controller_thread_started.store(1, std::memory_order_release);
+    if (rtl_stream_thread_create(&rtl.controller.thread, controller_thread_retune_loop, &rtl.controller) == 0
+        && rtl.internals) {
+        rtl.internals->controller_thread_started.store(1, std::memory_order_release);
     }
-    if (dsd_thread_create(&demod.thread, demod_thread_fn, &demod) == 0 && g_stream) {
-        g_stream->demod_thread_started.store(1, std::memory_order_release);
+    if (rtl_stream_thread_create(&rtl.demod.thread, demod_thread_fn, &rtl.demod) == 0 && rtl.internals) {
+        rtl.internals->demod_thread_started.store(1, std::memory_order_release);
     }
-    if (port != 0) {
-        g_udp_ctrl = udp_control_start_bound(udp_control_bindaddr, port,
+    if (rtl.udp_port != 0 && rtl_stream_on_default_pipeline()) {
+        rtl.udp_ctrl = udp_control_start_bound(rtl.udp_bindaddr, rtl.udp_port,
                                              [](uint32_t new_freq_hz) { schedule_manual_retune(new_freq_hz); });
-        if (!g_udp_ctrl) {
-            LOG_ERROR("Failed to start RTL UDP retune control on %s:%u\n", udp_control_bindaddr, (unsigned)port);
+        if (!rtl.udp_ctrl) {
+            LOG_ERROR("Failed to start RTL UDP retune control on %s:%u\n", rtl.udp_bindaddr, (unsigned)rtl.udp_port);
         }
     }
     return 0;
@@ -6517,29 +6796,30 @@ stream_open_start_rtltcp_pipeline(const dsd_opts* opts) {
 
 static int
 stream_open_start_replay_pipeline(void) {
-    if (dsd_thread_create(&demod.thread, demod_thread_fn, &demod) != 0) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (rtl_stream_thread_create(&rtl.demod.thread, demod_thread_fn, &rtl.demod) != 0) {
         LOG_ERROR("Failed to start replay demod thread.\n");
         return -1;
     }
-    if (g_stream) {
-        g_stream->demod_thread_started.store(1, std::memory_order_release);
+    if (rtl.internals) {
+        rtl.internals->demod_thread_started.store(1, std::memory_order_release);
     }
     LOG_INFO("Starting IQ replay reader...\n");
-    if (rtl_device_start_async(rtl_device_handle, (uint32_t)ACTUAL_BUF_LENGTH) != 0) {
+    if (rtl_device_start_async(rtl.device, (uint32_t)rtl.actual_buf_length) != 0) {
         LOG_ERROR("Failed to start replay reader thread.\n");
-        if (g_stream) {
-            g_stream->should_exit.store(1, std::memory_order_release);
+        if (rtl.internals) {
+            rtl.internals->should_exit.store(1, std::memory_order_release);
         }
-        safe_cond_signal(&input_ring.ready, &input_ring.ready_m);
-        safe_cond_signal(&output.ready, &output.ready_m);
-        dsd_thread_join(demod.thread);
-        if (g_stream) {
-            g_stream->demod_thread_started.store(0, std::memory_order_release);
+        input_ring_signal_ready(&rtl.input_ring);
+        ring_signal_ready(&rtl.output);
+        dsd_thread_join(rtl.demod.thread);
+        if (rtl.internals) {
+            rtl.internals->demod_thread_started.store(0, std::memory_order_release);
         }
         return -1;
     }
-    if (g_stream) {
-        g_stream->async_started.store(1, std::memory_order_release);
+    if (rtl.internals) {
+        rtl.internals->async_started.store(1, std::memory_order_release);
     }
     return 0;
 }
@@ -6569,44 +6849,75 @@ stream_open_validate_source_selection(dsd_opts* opts, RadioSourceKind source_kin
     return 0;
 }
 
+/**
+ * @brief Switch the input ring to native CU8/CS16 storage when
+ * `DSD_NEO_INPUT_RING_COMPACT` asks for it and the backend can produce it.
+ *
+ * Runs after the device opens and before any capture thread starts. Capacity
+ * stays the same in samples, so only the ring's memory shrinks.
+ */
+static void
+stream_open_select_input_ring_format(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg || !cfg->input_ring_compact) {
+        return;
+    }
+    int format = rtl_device_get_compact_ring_format(rtl.device);
+    if (format == 0) {
+        LOG_INFO("Compact input ring not available for this source; keeping float storage.\n");
+        return;
+    }
+    input_ring_set_widen_kernels(widen_u8_to_f32_bias127, widen_s16_to_f32);
+    if (input_ring_resize(&rtl.input_ring, rtl.input_ring.capacity, (dsd_iq_sample_format)format) != 0) {
+        LOG_WARN("WARNING: compact input ring allocation failed; keeping float storage.\n");
+        return;
+    }
+    LOG_INFO("Input ring stores %s samples (%zu samples, %.2f MiB).\n",
+             dsd_iq_sample_format_name((dsd_iq_sample_format)format), rtl.input_ring.capacity,
+             (double)(rtl.input_ring.capacity * input_ring_elem_bytes(&rtl.input_ring)) / (1024.0 * 1024.0));
+}
+
 static int
 stream_open_configure_pipeline_state(dsd_opts* opts, RadioSourceKind source_kind,
                                      const dsd_iq_replay_config* replay_cfg, int replay_cfg_loaded) {
+    dsd_rtl_stream& rtl = rtl_cur();
     stream_open_reset_auto_ppm_state(opts);
 
-    rtl_dsp_bw_hz = opts->rtl_dsp_bw_khz * 1000;
+    rtl.dsp_bw_hz = opts->rtl_dsp_bw_khz * 1000;
     stream_open_warn_low_dsp_bw(opts);
-    volume_multiplier = stream_open_volume_multiplier(opts);
-    if (stream_open_init_pipeline(opts, rtl_dsp_bw_hz) != 0) {
+    rtl.volume_multiplier = stream_open_volume_multiplier(opts);
+    if (stream_open_init_pipeline(opts, rtl.dsp_bw_hz) != 0) {
         return -1;
     }
     stream_open_enable_default_autogain(opts);
     setup_initial_freq_and_rate(opts);
-    if (!output.rate) {
-        output.rate = demod.rate_out;
+    if (!rtl.output.rate) {
+        rtl.output.rate = rtl.demod.rate_out;
     }
     if (stream_open_validate_scan_inputs() != 0) {
         return -1;
     }
-    if (controller.freq_len > 1) {
-        demod.terminate_on_squelch = 0;
+    if (rtl.controller.freq_len > 1) {
+        rtl.demod.terminate_on_squelch = 0;
     }
 
-    ACTUAL_BUF_LENGTH = lcm_post[demod.post_downsample] * DEFAULT_BUF_LENGTH;
-    dongle.buf_len = (uint32_t)ACTUAL_BUF_LENGTH;
+    rtl.actual_buf_length = lcm_post[rtl.demod.post_downsample] * DEFAULT_BUF_LENGTH;
+    rtl.dongle.buf_len = (uint32_t)rtl.actual_buf_length;
     if (stream_open_open_device(source_kind, opts, replay_cfg, replay_cfg_loaded) != 0) {
         return -1;
     }
     if (stream_open_validate_device_capture_rate(source_kind) != 0) {
         return -1;
     }
+    stream_open_select_input_ring_format();
     stream_open_apply_runtime_controls(opts);
     stream_open_apply_deemphasis_from_config();
     stream_open_apply_audio_lpf_from_config();
 
-    int gain_rc = rtl_device_set_gain(rtl_device_handle, dongle.gain);
+    int gain_rc = rtl_device_set_gain(rtl.device, rtl.dongle.gain);
     log_unsupported_control_if_needed("Gain control", gain_rc);
-    if (dongle.gain == AUTO_GAIN) {
+    if (rtl.dongle.gain == AUTO_GAIN) {
         LOG_INFO("Setting RTL Autogain. \n");
     }
     stream_open_note_ppm_capability();
@@ -6616,7 +6927,12 @@ stream_open_configure_pipeline_state(dsd_opts* opts, RadioSourceKind source_kind
         return -1;
     }
     stream_open_configure_resampler_chain();
-    rtl_demod_maybe_refresh_ted_sps_after_rate_change(&demod, opts, &output);
+    /* Two USB transfers per block covers the ring's bursty reads at this decimation. */
+    if (demod_buffers_reserve(&rtl.demod, 2 * rtl.actual_buf_length) != 0) {
+        LOG_ERROR("Failed to allocate demodulator work buffers.\n");
+        return -1;
+    }
+    rtl_demod_maybe_refresh_ted_sps_after_rate_change(&rtl.demod, opts, &rtl.output);
     stream_open_update_output_rates();
     stream_open_log_rate_chain_summary();
     return 0;
@@ -6625,7 +6941,7 @@ stream_open_configure_pipeline_state(dsd_opts* opts, RadioSourceKind source_kind
 static int
 stream_open_start_io_pipeline(const dsd_opts* opts, RadioSourceKind source_kind) {
     if (source_kind != RADIO_SOURCE_IQ_REPLAY) {
-        (void)rtl_device_reset_buffer(rtl_device_handle);
+        (void)rtl_device_reset_buffer(rtl_cur().device);
         if (stream_open_capture_writer(opts, source_kind) != 0) {
             stream_abort_capture_writer();
             return -1;
@@ -6706,56 +7022,57 @@ dsd_rtl_stream_open(dsd_opts* opts) {
  */
 extern "C" int
 dsd_rtl_stream_soft_stop(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     LOG_INFO("soft stopping...\n");
     ControllerRetuneCancellation cancelled_retune = {};
     rtl_stream_bump_output_generation();
-    if (g_stream) {
-        g_stream->replay_forced_stop.store(1, std::memory_order_release);
-        g_stream->should_exit.store(1, std::memory_order_release);
-        if (g_stream->opts) {
-            dsd_opts* mutable_opts = const_cast<dsd_opts*>(g_stream->opts);
+    if (rtl.internals) {
+        rtl.internals->replay_forced_stop.store(1, std::memory_order_release);
+        rtl.internals->should_exit.store(1, std::memory_order_release);
+        if (rtl.internals->opts) {
+            dsd_opts* mutable_opts = const_cast<dsd_opts*>(rtl.internals->opts);
             mutable_opts->iq_replay_active = 0;
         }
     }
-    if (g_stream) {
-        cancelled_retune = controller_detach_queued_manual_retune(&controller);
-        controller_wake_retune_waiters(&controller);
+    if (rtl.internals) {
+        cancelled_retune = controller_detach_queued_manual_retune(&rtl.controller);
+        controller_wake_retune_waiters(&rtl.controller);
     }
-    if (g_udp_ctrl) {
-        udp_control_stop(g_udp_ctrl);
-        g_udp_ctrl = NULL;
+    if (rtl.udp_ctrl) {
+        udp_control_stop(rtl.udp_ctrl);
+        rtl.udp_ctrl = NULL;
     }
-    safe_cond_signal(&input_ring.ready, &input_ring.ready_m);
-    safe_cond_signal(&controller.hop, &controller.hop_m);
-    if (g_stream && g_stream->replay_eof_sync_inited) {
-        dsd_mutex_lock(&g_stream->replay_eof_m);
-        dsd_cond_broadcast(&g_stream->replay_eof_cond);
-        dsd_mutex_unlock(&g_stream->replay_eof_m);
+    input_ring_signal_ready(&rtl.input_ring);
+    safe_cond_signal(&rtl.controller.hop, &rtl.controller.hop_m);
+    if (rtl.internals && rtl.internals->replay_eof_sync_inited) {
+        dsd_mutex_lock(&rtl.internals->replay_eof_m);
+        dsd_cond_broadcast(&rtl.internals->replay_eof_cond);
+        dsd_mutex_unlock(&rtl.internals->replay_eof_m);
     }
-    rtl_device_stop_async(rtl_device_handle);
+    rtl_device_stop_async(rtl.device);
     /* Wake any demod waits on both ready and space condition variables */
-    safe_cond_signal(&demod.ready, &demod.ready_m);
-    safe_cond_signal(&output.space, &output.ready_m);
-    if (g_stream && g_stream->demod_thread_started.load(std::memory_order_acquire)) {
-        dsd_thread_join(demod.thread);
-        g_stream->demod_thread_started.store(0, std::memory_order_release);
+    safe_cond_signal(&rtl.demod.ready, &rtl.demod.ready_m);
+    safe_cond_signal(&rtl.output.space, &rtl.output.ready_m);
+    if (rtl.internals && rtl.internals->demod_thread_started.load(std::memory_order_acquire)) {
+        dsd_thread_join(rtl.demod.thread);
+        rtl.internals->demod_thread_started.store(0, std::memory_order_release);
     }
     /* Wake any consumers blocked on output.ready to finish */
-    safe_cond_signal(&output.ready, &output.ready_m);
-    if (g_stream && g_stream->controller_thread_started.load(std::memory_order_acquire)) {
-        dsd_thread_join(controller.thread);
-        g_stream->controller_thread_started.store(0, std::memory_order_release);
+    ring_signal_ready(&rtl.output);
+    if (rtl.internals && rtl.internals->controller_thread_started.load(std::memory_order_acquire)) {
+        dsd_thread_join(rtl.controller.thread);
+        rtl.internals->controller_thread_started.store(0, std::memory_order_release);
     }
-    controller_finish_cancelled_manual_retune(&controller, &cancelled_retune);
+    controller_finish_cancelled_manual_retune(&rtl.controller, &cancelled_retune);
     stream_close_capture_writer();
 
-    rtl_demod_cleanup(&demod);
-    output_cleanup(&output);
-    controller_cleanup(&controller);
+    rtl_demod_cleanup(&rtl.demod);
+    output_cleanup(&rtl.output);
+    controller_cleanup(&rtl.controller);
 
-    input_ring_destroy(&input_ring);
-    rtl_device_destroy(rtl_device_handle);
-    rtl_device_handle = NULL;
+    input_ring_destroy(&rtl.input_ring);
+    rtl_device_destroy(rtl.device);
+    rtl.device = NULL;
     rtl_perf_shutdown();
     stream_destroy_internals();
     return 0;
@@ -6769,28 +7086,29 @@ auto_ppm_now_ms(void) {
 
 static double
 auto_ppm_pick_demod_snr_db(uint64_t now_ms) {
+    dsd_rtl_stream& rtl = rtl_cur();
     const long long fresh_ms = 800;
     double gate_snr_db = -100.0;
 
-    long long c4_ms = g_snr_c4fm_last_ms.load(std::memory_order_relaxed);
-    int c4_src = g_snr_c4fm_src.load(std::memory_order_relaxed);
+    long long c4_ms = rtl.snr_c4fm_last_ms.load(std::memory_order_relaxed);
+    int c4_src = rtl.snr_c4fm_src.load(std::memory_order_relaxed);
     if (c4_src == 1 && (long long)now_ms - c4_ms <= fresh_ms) {
-        gate_snr_db = g_snr_c4fm_db.load(std::memory_order_relaxed);
+        gate_snr_db = rtl.shared.snr_c4fm_db.load(std::memory_order_relaxed);
     }
 
-    long long qp_ms = g_snr_qpsk_last_ms.load(std::memory_order_relaxed);
-    int qp_src = g_snr_qpsk_src.load(std::memory_order_relaxed);
+    long long qp_ms = rtl.snr_qpsk_last_ms.load(std::memory_order_relaxed);
+    int qp_src = rtl.snr_qpsk_src.load(std::memory_order_relaxed);
     if (qp_src == 1 && (long long)now_ms - qp_ms <= fresh_ms) {
-        double snr = g_snr_qpsk_db.load(std::memory_order_relaxed);
+        double snr = rtl.shared.snr_qpsk_db.load(std::memory_order_relaxed);
         if (snr > gate_snr_db) {
             gate_snr_db = snr;
         }
     }
 
-    long long gf_ms = g_snr_gfsk_last_ms.load(std::memory_order_relaxed);
-    int gf_src = g_snr_gfsk_src.load(std::memory_order_relaxed);
+    long long gf_ms = rtl.snr_gfsk_last_ms.load(std::memory_order_relaxed);
+    int gf_src = rtl.snr_gfsk_src.load(std::memory_order_relaxed);
     if (gf_src == 1 && (long long)now_ms - gf_ms <= fresh_ms) {
-        double snr = g_snr_gfsk_db.load(std::memory_order_relaxed);
+        double snr = rtl.shared.snr_gfsk_db.load(std::memory_order_relaxed);
         if (snr > gate_snr_db) {
             gate_snr_db = snr;
         }
@@ -6801,12 +7119,13 @@ auto_ppm_pick_demod_snr_db(uint64_t now_ms) {
 
 static int
 auto_ppm_effective_enabled(const dsd_opts* opts) {
-    if (!g_ppm_control_supported.load(std::memory_order_relaxed)) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.ppm_control_supported.load(std::memory_order_relaxed)) {
         return 0;
     }
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
     int enabled = (cfg && cfg->auto_ppm_enable) ? 1 : 0;
-    int user = g_auto_ppm_user_en.load(std::memory_order_relaxed);
+    int user = rtl.shared.auto_ppm_user_en.load(std::memory_order_relaxed);
     if (user == 0) {
         return 0;
     }
@@ -6837,10 +7156,11 @@ auto_ppm_make_config(const dsd_opts* opts) {
 
 static int
 auto_ppm_fsk_phase_cfo_hz(double* out_cfo_hz) {
-    if (!out_cfo_hz || !g_fsk_phase_cfo_valid.load(std::memory_order_acquire)) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!out_cfo_hz || !rtl.fsk_phase_cfo_valid.load(std::memory_order_acquire)) {
         return 0;
     }
-    double cfo_hz = g_fsk_phase_cfo_hz.load(std::memory_order_relaxed);
+    double cfo_hz = rtl.fsk_phase_cfo_hz.load(std::memory_order_relaxed);
     if (!std::isfinite(cfo_hz)) {
         return 0;
     }
@@ -6860,21 +7180,23 @@ auto_ppm_should_freeze_retunes(void) {
 
 static void
 auto_ppm_publish_status(int enabled, const dsd::io::radio::RtlAutoPpmUpdate& update) {
-    g_auto_ppm_enabled.store(enabled, std::memory_order_relaxed);
-    g_auto_ppm_snr_db.store(update.snr_db, std::memory_order_relaxed);
-    g_auto_ppm_df_hz.store(update.df_hz, std::memory_order_relaxed);
-    g_auto_ppm_est_ppm.store(update.est_ppm, std::memory_order_relaxed);
-    g_auto_ppm_last_dir.store(update.last_dir, std::memory_order_relaxed);
-    g_auto_ppm_cooldown.store(update.cooldown_ticks, std::memory_order_relaxed);
-    g_auto_ppm_training.store(update.training, std::memory_order_relaxed);
-    g_auto_ppm_locked.store(update.locked, std::memory_order_relaxed);
-    g_auto_ppm_lock_ppm.store(update.lock_ppm, std::memory_order_relaxed);
-    g_auto_ppm_lock_snr_db.store(update.lock_snr_db, std::memory_order_relaxed);
-    g_auto_ppm_lock_df_hz.store(update.lock_df_hz, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.shared.auto_ppm_enabled.store(enabled, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_snr_db.store(update.snr_db, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_df_hz.store(update.df_hz, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_est_ppm.store(update.est_ppm, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_last_dir.store(update.last_dir, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_cooldown.store(update.cooldown_ticks, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_training.store(update.training, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_locked.store(update.locked, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_lock_ppm.store(update.lock_ppm, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_lock_snr_db.store(update.lock_snr_db, std::memory_order_relaxed);
+    rtl.shared.auto_ppm_lock_df_hz.store(update.lock_df_hz, std::memory_order_relaxed);
 }
 
 static void
 auto_ppm_maybe_adjust(dsd_opts* opts, const dsd_state* state) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!opts) {
         return;
     }
@@ -6882,13 +7204,13 @@ auto_ppm_maybe_adjust(dsd_opts* opts, const dsd_state* state) {
     int enabled = auto_ppm_effective_enabled(opts);
     int applied_ppm = load_dongle_ppm_error();
     uint64_t now_ms = auto_ppm_now_ms();
-    uint32_t applied_freq_hz = controller.last_applied_freq_hz.load(std::memory_order_acquire);
-    double spec_snr_db = g_spec_snr_db.load(std::memory_order_relaxed);
+    uint32_t applied_freq_hz = rtl.controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    double spec_snr_db = rtl.shared.spec_snr_db.load(std::memory_order_relaxed);
     dsd::io::radio::RtlAutoPpmConfig config = auto_ppm_make_config(opts);
 
     dsd::io::radio::RtlAutoPpmSignalMetrics metrics = {};
     /* Decode-thread path (rtl_stream_read_live): use the published mirror. */
-    metrics.cqpsk_enable = g_pub_cqpsk_enable.load(std::memory_order_relaxed);
+    metrics.cqpsk_enable = rtl.pub_cqpsk_enable.load(std::memory_order_relaxed);
     metrics.tracking_enable = metrics.cqpsk_enable;
     metrics.carrier_lock = rtl_stream_get_carrier_lock();
     metrics.nco_cfo_hz = rtl_stream_get_cfo_hz();
@@ -6897,7 +7219,7 @@ auto_ppm_maybe_adjust(dsd_opts* opts, const dsd_state* state) {
         metrics.tracking_enable = 1;
         metrics.phase_cfo_hz = fsk_phase_cfo_hz;
     } else {
-        metrics.phase_cfo_hz = g_resid_cfo_phase_hz.load(std::memory_order_relaxed);
+        metrics.phase_cfo_hz = rtl.shared.resid_cfo_phase_hz.load(std::memory_order_relaxed);
     }
 
     dsd::io::radio::RtlAutoPpmInputs inputs = {};
@@ -6912,7 +7234,7 @@ auto_ppm_maybe_adjust(dsd_opts* opts, const dsd_state* state) {
     inputs.controller_queued_request = controller_requests.queued_request;
     inputs.controller_active_request = controller_requests.active_request;
     inputs.tuned_freq_hz = applied_freq_hz;
-    inputs.signal_power_db = g_spec_peak_db.load(std::memory_order_relaxed);
+    inputs.signal_power_db = rtl.shared.spec_peak_db.load(std::memory_order_relaxed);
     inputs.gate_snr_db = auto_ppm_pick_demod_snr_db(now_ms);
     inputs.spec_snr_db = spec_snr_db;
     inputs.estimate = dsd::io::radio::rtl_auto_ppm_select_estimate(metrics);
@@ -6925,7 +7247,7 @@ auto_ppm_maybe_adjust(dsd_opts* opts, const dsd_state* state) {
         return;
     }
 
-    dsd::io::radio::RtlAutoPpmUpdate update = g_auto_ppm_controller.update(config, inputs);
+    dsd::io::radio::RtlAutoPpmUpdate update = rtl.auto_ppm_controller.update(config, inputs);
     auto_ppm_publish_status(enabled, update);
     if (update.apply_ppm) {
         LOG_INFO("AUTO-PPM: src=%d pwr=%.1f dB snr=%.1f dB df=%.1f Hz ppm %d->%d\n",
@@ -6937,37 +7259,40 @@ auto_ppm_maybe_adjust(dsd_opts* opts, const dsd_state* state) {
 
 static int
 rtl_stream_replay_should_exit_now(int replay_active) {
-    if (!g_stream || !g_stream->should_exit.load(std::memory_order_acquire)) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals || !rtl.internals->should_exit.load(std::memory_order_acquire)) {
         return 0;
     }
     if (!replay_active) {
         return 1;
     }
-    int replay_input_eof = g_stream->replay_input_eof.load(std::memory_order_acquire);
-    int replay_forced_stop = g_stream->replay_forced_stop.load(std::memory_order_acquire);
-    int replay_output_drained = g_stream->replay_output_drained.load(std::memory_order_acquire);
+    int replay_input_eof = rtl.internals->replay_input_eof.load(std::memory_order_acquire);
+    int replay_forced_stop = rtl.internals->replay_forced_stop.load(std::memory_order_acquire);
+    int replay_output_drained = rtl.internals->replay_output_drained.load(std::memory_order_acquire);
     return (!replay_input_eof || replay_forced_stop || replay_output_drained) ? 1 : 0;
 }
 
 static void
 rtl_stream_replay_mark_output_drained(void) {
-    if (!g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals) {
         return;
     }
-    g_stream->replay_output_drained.store(1, std::memory_order_release);
-    g_stream->should_exit.store(1, std::memory_order_release);
-    safe_cond_signal(&input_ring.ready, &input_ring.ready_m);
-    safe_cond_signal(&output.ready, &output.ready_m);
-    if (g_stream->replay_eof_sync_inited) {
-        dsd_mutex_lock(&g_stream->replay_eof_m);
-        dsd_cond_broadcast(&g_stream->replay_eof_cond);
-        dsd_mutex_unlock(&g_stream->replay_eof_m);
+    rtl.internals->replay_output_drained.store(1, std::memory_order_release);
+    rtl.internals->should_exit.store(1, std::memory_order_release);
+    input_ring_signal_ready(&rtl.input_ring);
+    ring_signal_ready(&rtl.output);
+    if (rtl.internals->replay_eof_sync_inited) {
+        dsd_mutex_lock(&rtl.internals->replay_eof_m);
+        dsd_cond_broadcast(&rtl.internals->replay_eof_cond);
+        dsd_mutex_unlock(&rtl.internals->replay_eof_m);
     }
 }
 
 static int
 rtl_stream_read_live_available(struct controller_state* s, struct output_state* outp, float* out, size_t count,
                                int* out_gated) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!s || !outp || !out_gated) {
         return -1;
     }
@@ -6978,10 +7303,10 @@ rtl_stream_read_live_available(struct controller_state* s, struct output_state*
     }
 
     s->live_output_read_active.fetch_add(1, std::memory_order_acq_rel);
-    uint32_t generation_before = g_rtl_output_generation.load(std::memory_order_acquire);
+    uint32_t generation_before = rtl.output_generation.load(std::memory_order_acquire);
     *out_gated = s->timeout_gate_request_id.load(std::memory_order_acquire) != 0U;
     int got = *out_gated ? 0 : ring_read_available(outp, out, count);
-    uint32_t generation_after = g_rtl_output_generation.load(std::memory_order_acquire);
+    uint32_t generation_after = rtl.output_generation.load(std::memory_order_acquire);
     *out_gated = s->timeout_gate_request_id.load(std::memory_order_acquire) != 0U;
     if (*out_gated || generation_after != generation_before) {
         got = 0;
@@ -6991,7 +7316,7 @@ rtl_stream_read_live_available(struct controller_state* s, struct output_state*
      * before observing the reader count reach zero. Reject that handoff here;
      * the orchestrator also validates this generation after the call returns. */
     *out_gated = s->timeout_gate_request_id.load(std::memory_order_acquire) != 0U;
-    generation_after = g_rtl_output_generation.load(std::memory_order_acquire);
+    generation_after = rtl.output_generation.load(std::memory_order_acquire);
     if (*out_gated || generation_after != generation_before) {
         got = 0;
     }
@@ -7000,32 +7325,31 @@ rtl_stream_read_live_available(struct controller_state* s, struct output_state*
 
 static int
 rtl_stream_read_live_samples(float* out, size_t count) {
+    dsd_rtl_stream& rtl = rtl_cur();
     for (;;) {
-        if (!output.buffer || dsd_exitflag_load()
-            || (g_stream && g_stream->should_exit.load(std::memory_order_acquire))) {
+        if (!rtl.output.buffer || dsd_exitflag_load()
+            || (rtl.internals && rtl.internals->should_exit.load(std::memory_order_acquire))) {
             return -1;
         }
 
         int gated = 0;
-        int got = rtl_stream_read_live_available(&controller, &output, out, count, &gated);
+        int got = rtl_stream_read_live_available(&rtl.controller, &rtl.output, out, count, &gated);
         if (got != 0) {
             return got;
         }
 
         if (gated) {
-            dsd_mutex_lock(&controller.retune_done_m);
-            if (controller.timeout_gate_request_id.load(std::memory_order_acquire) != 0U) {
-                (void)dsd_cond_timedwait(&controller.retune_done_cond, &controller.retune_done_m, 10);
+            dsd_mutex_lock(&rtl.controller.retune_done_m);
+            if (rtl.controller.timeout_gate_request_id.load(std::memory_order_acquire) != 0U) {
+                (void)dsd_cond_timedwait(&rtl.controller.retune_done_cond, &rtl.controller.retune_done_m, 10);
             }
-            dsd_mutex_unlock(&controller.retune_done_m);
+            dsd_mutex_unlock(&rtl.controller.retune_done_m);
             continue;
         }
 
-        dsd_mutex_lock(&output.ready_m);
-        int wait_rc = dsd_cond_timedwait(&output.ready, &output.ready_m, 10);
-        dsd_mutex_unlock(&output.ready_m);
+        int wait_rc = ring_wait_ready(&rtl.output, RING_WAKE_IDLE_TIMEOUT_MS);
         if (wait_rc != 0) {
-            output.read_timeouts.fetch_add(1, std::memory_order_relaxed);
+            rtl.output.read_timeouts.fetch_add(1, std::memory_order_relaxed);
         }
     }
 }
@@ -7050,37 +7374,36 @@ rtl_stream_read_live(float* out, size_t count, dsd_opts* opts, const dsd_state*
 
 static int
 rtl_stream_read_replay(float* out, size_t count) {
+    dsd_rtl_stream& rtl = rtl_cur();
     for (;;) {
-        if (!output.buffer || !g_stream) {
+        if (!rtl.output.buffer || !rtl.internals) {
             return -1;
         }
-        if (g_stream->replay_forced_stop.load(std::memory_order_acquire) || dsd_exitflag_load()) {
+        if (rtl.internals->replay_forced_stop.load(std::memory_order_acquire) || dsd_exitflag_load()) {
             return -1;
         }
-        size_t used = ring_used(&output);
+        size_t used = ring_used(&rtl.output);
         if (used > 0) {
             size_t want = (count < used) ? count : used;
             int perf_on = rtl_perf_enabled();
             uint64_t perf_read_start_ns = perf_on ? dsd_time_monotonic_ns() : 0ULL;
-            int got = ring_read_batch(&output, out, want);
+            int got = ring_read_batch(&rtl.output, out, want);
             if (got <= 0) {
                 return -1;
             }
             if (perf_on) {
                 rtl_perf_record_consumer_read(dsd_time_monotonic_ns() - perf_read_start_ns, (size_t)got);
             }
-            if (g_stream->replay_demod_drained.load(std::memory_order_acquire) && ring_used(&output) == 0U) {
+            if (rtl.internals->replay_demod_drained.load(std::memory_order_acquire) && ring_used(&rtl.output) == 0U) {
                 rtl_stream_replay_mark_output_drained();
             }
             return got;
         }
-        if (g_stream->replay_demod_drained.load(std::memory_order_acquire)) {
+        if (rtl.internals->replay_demod_drained.load(std::memory_order_acquire)) {
             rtl_stream_replay_mark_output_drained();
             return -1;
         }
-        dsd_mutex_lock(&output.ready_m);
-        (void)dsd_cond_timedwait(&output.ready, &output.ready_m, 10);
-        dsd_mutex_unlock(&output.ready_m);
+        (void)ring_wait_ready(&rtl.output, RING_WAKE_IDLE_TIMEOUT_MS);
     }
 }
 
@@ -7099,7 +7422,7 @@ dsd_rtl_stream_read(float* out, size_t count, dsd_opts* opts, const dsd_state* s
     if (count == 0) {
         return 0;
     }
-    if (!output.buffer) {
+    if (!rtl_cur().output.buffer) {
         return -1;
     }
     int replay_active = stream_is_replay_active();
@@ -7148,13 +7471,14 @@ rtl_stream_get_requested_ppm(const dsd_opts* opts) {
  */
 extern "C" unsigned int
 dsd_rtl_stream_output_rate(void) {
-    return (unsigned int)output.rate;
+    return (unsigned int)rtl_cur().output.rate;
 }
 
 /* Helper for generic rings to observe RTL stream shutdown without using exitflag */
 extern "C" int
 dsd_rtl_stream_should_exit(void) {
-    return (g_stream && g_stream->should_exit.load()) ? 1 : 0;
+    dsd_rtl_stream& rtl = rtl_cur();
+    return (rtl.internals && rtl.internals->should_exit.load()) ? 1 : 0;
 }
 
 /**
@@ -7167,13 +7491,14 @@ dsd_rtl_stream_should_exit(void) {
 extern "C" int
 dsd_rtl_stream_cqpsk_timing_bias(void) {
     /* demod.ted_state belongs to the demod thread; read the per-block mirror. */
-    return g_pub_ted_bias_q14.load(std::memory_order_relaxed);
+    return rtl_cur().pub_ted_bias_q14.load(std::memory_order_relaxed);
 }
 
 /* Demod-thread only: mirrors demod.ted_state.e_ema for the timing-bias hook. */
 static void
 rtl_stream_publish_ted_bias(void) {
-    const float bias_scaled = demod.ted_state.e_ema * 16384.0f; /* Q14 scale */
+    dsd_rtl_stream& rtl = rtl_cur();
+    const float bias_scaled = rtl.demod.ted_state.e_ema * 16384.0f; /* Q14 scale */
     int bias_q14;
     if (bias_scaled > (float)INT_MAX) {
         bias_q14 = INT_MAX;
@@ -7182,7 +7507,7 @@ rtl_stream_publish_ted_bias(void) {
     } else {
         bias_q14 = (int)lrintf(bias_scaled);
     }
-    g_pub_ted_bias_q14.store(bias_q14, std::memory_order_relaxed);
+    rtl.pub_ted_bias_q14.store(bias_q14, std::memory_order_relaxed);
 }
 
 #if defined(DSD_NEO_ENABLE_INTERNAL_TEST_HOOKS)
@@ -7195,14 +7520,15 @@ rtl_stream_test_publish_demod_snapshot(void) {
 
 static void
 rtl_stream_publish_demod_profile_snapshot(void) {
-    g_pub_cqpsk_enable.store(demod.cqpsk_enable ? 1 : 0, std::memory_order_relaxed);
-    g_pub_output_kind.store(demod.output_kind, std::memory_order_relaxed);
-    g_pub_symbol_rate.store(demod.symbol_rate_hz, std::memory_order_relaxed);
-    g_pub_symbol_levels.store(demod.symbol_levels, std::memory_order_relaxed);
-    g_pub_channel_profile.store(demod.channel_lpf_profile, std::memory_order_relaxed);
-    g_pub_ted_sps.store(demod.ted_sps, std::memory_order_relaxed);
-    g_pub_ted_sps_override.store(demod.ted_sps_override, std::memory_order_relaxed);
-    g_pub_rate_out.store(demod.rate_out, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.pub_cqpsk_enable.store(rtl.demod.cqpsk_enable ? 1 : 0, std::memory_order_relaxed);
+    rtl.pub_output_kind.store(rtl.demod.output_kind, std::memory_order_relaxed);
+    rtl.pub_symbol_rate.store(rtl.demod.symbol_rate_hz, std::memory_order_relaxed);
+    rtl.pub_symbol_levels.store(rtl.demod.symbol_levels, std::memory_order_relaxed);
+    rtl.pub_channel_profile.store(rtl.demod.channel_lpf_profile, std::memory_order_relaxed);
+    rtl.pub_ted_sps.store(rtl.demod.ted_sps, std::memory_order_relaxed);
+    rtl.pub_ted_sps_override.store(rtl.demod.ted_sps_override, std::memory_order_relaxed);
+    rtl.pub_rate_out.store(rtl.demod.rate_out, std::memory_order_relaxed);
 }
 
 /* The getters below read the published mirrors rather than demod fields: the
@@ -7210,17 +7536,17 @@ rtl_stream_publish_demod_profile_snapshot(void) {
 
 extern "C" int
 rtl_stream_get_ted_sps(void) {
-    return g_pub_ted_sps.load(std::memory_order_relaxed);
+    return rtl_cur().pub_ted_sps.load(std::memory_order_relaxed);
 }
 
 extern "C" int
 rtl_stream_get_ted_sps_override(void) {
-    return g_pub_ted_sps_override.load(std::memory_order_relaxed);
+    return rtl_cur().pub_ted_sps_override.load(std::memory_order_relaxed);
 }
 
 extern "C" int
 rtl_stream_get_output_kind(void) {
-    return g_pub_output_kind.load(std::memory_order_relaxed);
+    return rtl_cur().pub_output_kind.load(std::memory_order_relaxed);
 }
 
 extern "C" int
@@ -7230,56 +7556,58 @@ rtl_stream_is_active(void) {
 
 extern "C" uint32_t
 rtl_stream_output_generation(void) {
-    return g_rtl_output_generation.load(std::memory_order_acquire);
+    return rtl_cur().output_generation.load(std::memory_order_acquire);
 }
 
 extern "C" int
 rtl_stream_get_symbol_profile_full(int* out_symbol_rate_hz, int* out_levels, int* out_channel_profile) {
+    dsd_rtl_stream& rtl = rtl_cur();
     /* The three mirrors are read independently, so a caller racing a profile
      * change can observe a mixed rate/levels/channel combination for one
      * block. Fine for display/telemetry; do not branch on the combination as
      * a consistent set. */
     if (out_symbol_rate_hz) {
-        *out_symbol_rate_hz = g_pub_symbol_rate.load(std::memory_order_relaxed);
+        *out_symbol_rate_hz = rtl.pub_symbol_rate.load(std::memory_order_relaxed);
     }
     if (out_levels) {
-        *out_levels = g_pub_symbol_levels.load(std::memory_order_relaxed);
+        *out_levels = rtl.pub_symbol_levels.load(std::memory_order_relaxed);
     }
     if (out_channel_profile) {
-        *out_channel_profile = g_pub_channel_profile.load(std::memory_order_relaxed);
+        *out_channel_profile = rtl.pub_channel_profile.load(std::memory_order_relaxed);
     }
     return 0;
 }
 
 extern "C" int
 rtl_stream_set_symbol_profile(int symbol_rate_hz, int levels, int channel_profile) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (symbol_rate_hz <= 0) {
         return -1;
     }
     if (levels != 2 && levels != 4) {
         return -1;
     }
-    int next_channel_profile = demod.channel_lpf_profile;
+    int next_channel_profile = rtl.demod.channel_lpf_profile;
     if (channel_profile >= DSD_CH_LPF_PROFILE_WIDE && channel_profile <= DSD_CH_LPF_PROFILE_P25_CQPSK) {
         next_channel_profile = channel_profile;
     }
-    int changed = (demod.symbol_rate_hz != symbol_rate_hz || demod.symbol_levels != levels
-                   || demod.channel_lpf_profile != next_channel_profile);
-    demod.symbol_rate_hz = symbol_rate_hz;
-    demod.symbol_levels = levels;
-    demod.channel_lpf_profile = next_channel_profile;
-    if (demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR && demod.rate_out > 0) {
-        int sps = (demod.rate_out + (symbol_rate_hz / 2)) / symbol_rate_hz;
+    int changed = (rtl.demod.symbol_rate_hz != symbol_rate_hz || rtl.demod.symbol_levels != levels
+                   || rtl.demod.channel_lpf_profile != next_channel_profile);
+    rtl.demod.symbol_rate_hz = symbol_rate_hz;
+    rtl.demod.symbol_levels = levels;
+    rtl.demod.channel_lpf_profile = next_channel_profile;
+    if (rtl.demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR && rtl.demod.rate_out > 0) {
+        int sps = (rtl.demod.rate_out + (symbol_rate_hz / 2)) / symbol_rate_hz;
         if (sps < 1) {
             sps = 1;
         } else if (sps > 64) {
             sps = 64;
         }
-        demod.ted_sps = sps;
+        rtl.demod.ted_sps = sps;
     }
-    rtl_stream_queue_fsk_modem_config(demod.symbol_rate_hz, demod.symbol_levels, demod.channel_lpf_profile);
+    rtl_stream_queue_fsk_modem_config(rtl.demod.symbol_rate_hz, rtl.demod.symbol_levels, rtl.demod.channel_lpf_profile);
     if (changed) {
-        demod.costas_reset_pending = 1;
+        rtl.demod.costas_reset_pending = 1;
         rtl_stream_invalidate_fsk_phase_cfo_snapshot();
     }
     rtl_stream_publish_demod_profile_snapshot();
@@ -7288,34 +7616,37 @@ rtl_stream_set_symbol_profile(int symbol_rate_hz, int levels, int channel_profil
 
 extern "C" int
 rtl_stream_request_fsk_reacquire(void) {
-    if (demod.output_kind != DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (rtl.demod.output_kind != DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR) {
         return 0;
     }
-    g_fsk_reacquire_pending.store(1, std::memory_order_release);
+    rtl.fsk_reacquire_pending.store(1, std::memory_order_release);
     if (debug_sync_enabled()) {
         DSD_FPRINTF(stderr, "[FSKREACQ] requested output_generation=%u\n",
-                    g_rtl_output_generation.load(std::memory_order_acquire));
+                    rtl.output_generation.load(std::memory_order_acquire));
     }
     return 1;
 }
 
 extern "C" int
 rtl_stream_request_cqpsk_reacquire(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     /* Main-thread hook: use the published mirrors, not demod fields. */
-    if (g_pub_output_kind.load(std::memory_order_relaxed) != DSD_DEMOD_OUTPUT_SYMBOL_CQPSK
-        && !g_pub_cqpsk_enable.load(std::memory_order_relaxed)) {
+    if (rtl.pub_output_kind.load(std::memory_order_relaxed) != DSD_DEMOD_OUTPUT_SYMBOL_CQPSK
+        && !rtl.pub_cqpsk_enable.load(std::memory_order_relaxed)) {
         return 0;
     }
-    g_cqpsk_reacquire_pending.store(1, std::memory_order_release);
+    rtl.cqpsk_reacquire_pending.store(1, std::memory_order_release);
     if (debug_cqpsk_enabled()) {
         DSD_FPRINTF(stderr, "[CQPSKREACQ] requested output_generation=%u\n",
-                    g_rtl_output_generation.load(std::memory_order_acquire));
+                    rtl.output_generation.load(std::memory_order_acquire));
     }
     return 1;
 }
 
 extern "C" void
 rtl_stream_set_ted_sps(int sps) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (sps < 2) {
         sps = 2;
     }
@@ -7344,21 +7675,22 @@ rtl_stream_set_ted_sps(int sps) {
     /* Debug: log set_ted_sps call */
     {
         if (debug_cqpsk_enabled()) {
-            DSD_FPRINTF(stderr, "[SET_TED_SPS] sps=%d current_ted_sps=%d will_set_pending=%d\n", sps, demod.ted_sps,
-                        (sps != demod.ted_sps) ? 1 : 0);
+            DSD_FPRINTF(stderr, "[SET_TED_SPS] sps=%d current_ted_sps=%d will_set_pending=%d\n", sps, rtl.demod.ted_sps,
+                        (sps != rtl.demod.ted_sps) ? 1 : 0);
         }
     }
-    if (sps != demod.ted_sps) {
-        demod.costas_reset_pending = 1;
+    if (sps != rtl.demod.ted_sps) {
+        rtl.demod.costas_reset_pending = 1;
     }
-    demod.ted_sps_override = sps;
-    if (demod.cqpsk_enable) {
-        demod.channel_lpf_profile = DSD_CH_LPF_PROFILE_P25_CQPSK;
+    rtl.demod.ted_sps_override = sps;
+    if (rtl.demod.cqpsk_enable) {
+        rtl.demod.channel_lpf_profile = DSD_CH_LPF_PROFILE_P25_CQPSK;
     }
-    if (demod.rate_out > 0) {
-        int sym_rate = (demod.rate_out + (sps / 2)) / sps;
+    if (rtl.demod.rate_out > 0) {
+        int sym_rate = (rtl.demod.rate_out + (sps / 2)) / sps;
         if (sym_rate > 0) {
-            (void)rtl_stream_set_symbol_profile(sym_rate, demod.symbol_levels == 2 ? 2 : 4, demod.channel_lpf_profile);
+            (void)rtl_stream_set_symbol_profile(sym_rate, rtl.demod.symbol_levels == 2 ? 2 : 4,
+                                                rtl.demod.channel_lpf_profile);
         }
     }
     rtl_stream_publish_demod_profile_snapshot();
@@ -7366,12 +7698,14 @@ rtl_stream_set_ted_sps(int sps) {
 
 extern "C" void
 rtl_stream_clear_ted_sps_override(void) {
-    demod.ted_sps_override = 0;
-    g_pub_ted_sps_override.store(0, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.demod.ted_sps_override = 0;
+    rtl.pub_ted_sps_override.store(0, std::memory_order_relaxed);
 }
 
 extern "C" void
 rtl_stream_set_ted_sps_no_override(int sps) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (sps < 2) {
         sps = 2;
     }
@@ -7382,7 +7716,7 @@ rtl_stream_set_ted_sps_no_override(int sps) {
     {
         if (debug_cqpsk_enabled()) {
             DSD_FPRINTF(stderr, "[SET_TED_SPS_NO_OVERRIDE] sps=%d current_ted_sps=%d will_reset=%d\n", sps,
-                        demod.ted_sps, (sps != demod.ted_sps) ? 1 : 0);
+                        rtl.demod.ted_sps, (sps != rtl.demod.ted_sps) ? 1 : 0);
         }
     }
     /* Reset Costas loop IMMEDIATELY when SPS changes, not via pending flag.
@@ -7393,24 +7727,25 @@ rtl_stream_set_ted_sps_no_override(int sps) {
      * error (the Costas freq in rad/symbol represents different Hz at different symbol rates).
      *
      */
-    if (sps != demod.ted_sps) {
-        demod.costas_state.freq = 0.0f;
-        demod.costas_state.phase = 0.0f;
-        demod.costas_state.error = 0.0f;
-        demod.costas_state.error_smooth = 0.0f;
-        demod.costas_err_avg_q14 = 0;
-        demod.costas_err_raw_avg_q14 = 0;
-        demod.costas_conf_avg_q14 = 0;
-        demod.costas_zero_conf_pct = 0;
-    }
-    demod.ted_sps = sps;
-    if (demod.cqpsk_enable) {
-        demod.channel_lpf_profile = DSD_CH_LPF_PROFILE_P25_CQPSK;
-    }
-    if (demod.rate_out > 0) {
-        int sym_rate = (demod.rate_out + (sps / 2)) / sps;
+    if (sps != rtl.demod.ted_sps) {
+        rtl.demod.costas_state.freq = 0.0f;
+        rtl.demod.costas_state.phase = 0.0f;
+        rtl.demod.costas_state.error = 0.0f;
+        rtl.demod.costas_state.error_smooth = 0.0f;
+        rtl.demod.costas_err_avg_q14 = 0;
+        rtl.demod.costas_err_raw_avg_q14 = 0;
+        rtl.demod.costas_conf_avg_q14 = 0;
+        rtl.demod.costas_zero_conf_pct = 0;
+    }
+    rtl.demod.ted_sps = sps;
+    if (rtl.demod.cqpsk_enable) {
+        rtl.demod.channel_lpf_profile = DSD_CH_LPF_PROFILE_P25_CQPSK;
+    }
+    if (rtl.demod.rate_out > 0) {
+        int sym_rate = (rtl.demod.rate_out + (sps / 2)) / sps;
         if (sym_rate > 0) {
-            (void)rtl_stream_set_symbol_profile(sym_rate, demod.symbol_levels == 2 ? 2 : 4, demod.channel_lpf_profile);
+            (void)rtl_stream_set_symbol_profile(sym_rate, rtl.demod.symbol_levels == 2 ? 2 : 4,
+                                                rtl.demod.channel_lpf_profile);
         }
     }
     rtl_stream_publish_demod_profile_snapshot();
@@ -7420,59 +7755,64 @@ rtl_stream_set_ted_sps_no_override(int sps) {
 
 extern "C" void
 rtl_stream_set_ted_gain(float gain) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (gain < 0.01f) {
         gain = 0.01f;
     }
     if (gain > 0.5f) {
         gain = 0.5f;
     }
-    demod.ted_gain = gain;
-    demod.ted_gain_is_set = 1;
-    demod.ted_effective_gain = gain;
+    rtl.demod.ted_gain = gain;
+    rtl.demod.ted_gain_is_set = 1;
+    rtl.demod.ted_effective_gain = gain;
 }
 
 extern "C" float
 rtl_stream_get_ted_gain(void) {
-    return demod.ted_gain;
+    return rtl_cur().demod.ted_gain;
 }
 
 static inline int
 rtl_stream_fsk_direct_output_active(void) {
-    return demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
+    return rtl_cur().demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
 }
 
 static inline int
 rtl_stream_cqpsk_symbol_output_active(void) {
-    return demod.output_kind == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK || demod.cqpsk_enable;
+    dsd_rtl_stream& rtl = rtl_cur();
+    return rtl.demod.output_kind == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK || rtl.demod.cqpsk_enable;
 }
 
 static void
 rtl_stream_reset_ted_runtime_state(void) {
-    ted_init_state(&demod.ted_state);
-    demod.ted_mu = 0.0f;
+    dsd_rtl_stream& rtl = rtl_cur();
+    ted_init_state(&rtl.demod.ted_state);
+    rtl.demod.ted_mu = 0.0f;
 }
 
 static void
 rtl_stream_apply_symbol_timing_mode(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (rtl_stream_fsk_direct_output_active()) {
-        if (demod.ted_enabled) {
-            demod.ted_enabled = 0;
+        if (rtl.demod.ted_enabled) {
+            rtl.demod.ted_enabled = 0;
             rtl_stream_reset_ted_runtime_state();
         }
         return;
     }
 
     if (rtl_stream_cqpsk_symbol_output_active()) {
-        demod.ted_enabled = 1;
+        rtl.demod.ted_enabled = 1;
     }
 }
 
 extern "C" int
 rtl_stream_get_iq_dc(int* out_shift_k) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (out_shift_k) {
-        *out_shift_k = demod.iq_dc_shift;
+        *out_shift_k = rtl.demod.iq_dc_shift;
     }
-    return demod.iq_dc_block_enable ? 1 : 0;
+    return rtl.demod.iq_dc_block_enable ? 1 : 0;
 }
 
 static int
@@ -7488,33 +7828,35 @@ iq_dc_clamp_shift_k(int shift_k) {
 
 static void
 iq_dc_precharge(void) {
-    if (!demod.lowpassed || demod.lp_len < 2) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.demod.lowpassed || rtl.demod.lp_len < 2) {
         return;
     }
-    const int pairs = demod.lp_len >> 1;
+    const int pairs = rtl.demod.lp_len >> 1;
     double sumI = 0.0;
     double sumQ = 0.0;
     for (int n = 0; n < pairs; n++) {
-        sumI += (double)demod.lowpassed[(size_t)(n << 1) + 0];
-        sumQ += (double)demod.lowpassed[(size_t)(n << 1) + 1];
+        sumI += (double)rtl.demod.lowpassed[(size_t)(n << 1) + 0];
+        sumQ += (double)rtl.demod.lowpassed[(size_t)(n << 1) + 1];
     }
     float meanI = (pairs > 0) ? (float)(sumI / (double)pairs) : 0.0f;
     float meanQ = (pairs > 0) ? (float)(sumQ / (double)pairs) : 0.0f;
-    demod.iq_dc_avg_r = meanI;
-    demod.iq_dc_avg_i = meanQ;
+    rtl.demod.iq_dc_avg_r = meanI;
+    rtl.demod.iq_dc_avg_i = meanQ;
 }
 
 extern "C" void
 rtl_stream_set_iq_dc(int enable, int shift_k) {
-    int was = demod.iq_dc_block_enable ? 1 : 0;
+    dsd_rtl_stream& rtl = rtl_cur();
+    int was = rtl.demod.iq_dc_block_enable ? 1 : 0;
     if (enable >= 0) {
-        demod.iq_dc_block_enable = enable ? 1 : 0;
+        rtl.demod.iq_dc_block_enable = enable ? 1 : 0;
     }
     if (shift_k >= 0) {
-        demod.iq_dc_shift = iq_dc_clamp_shift_k(shift_k);
+        rtl.demod.iq_dc_shift = iq_dc_clamp_shift_k(shift_k);
     }
     /* If enabling now, precharge DC estimate to the current block mean. */
-    if (!was && demod.iq_dc_block_enable) {
+    if (!was && rtl.demod.iq_dc_block_enable) {
         iq_dc_precharge();
     }
 }
@@ -7528,57 +7870,60 @@ rtl_stream_set_iq_dc(int enable, int shift_k) {
 extern "C" void
 rtl_stream_p25p2_err_update(int slot, int facch_ok_delta, int facch_err_delta, int sacch_ok_delta, int sacch_err_delta,
                             int voice_err_delta) {
+    dsd_rtl_stream& rtl = rtl_cur();
     (void)slot;
     if (!rtl_decode_health_prepare_update()) {
         return;
     }
     int changed = 0;
     if (facch_ok_delta > 0) {
-        g_decode_p25p2_facch_ok.fetch_add((unsigned int)facch_ok_delta, std::memory_order_relaxed);
+        rtl.decode_p25p2_facch_ok.fetch_add((unsigned int)facch_ok_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (facch_err_delta > 0) {
-        g_decode_p25p2_facch_err.fetch_add((unsigned int)facch_err_delta, std::memory_order_relaxed);
+        rtl.decode_p25p2_facch_err.fetch_add((unsigned int)facch_err_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (sacch_ok_delta > 0) {
-        g_decode_p25p2_sacch_ok.fetch_add((unsigned int)sacch_ok_delta, std::memory_order_relaxed);
+        rtl.decode_p25p2_sacch_ok.fetch_add((unsigned int)sacch_ok_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (sacch_err_delta > 0) {
-        g_decode_p25p2_sacch_err.fetch_add((unsigned int)sacch_err_delta, std::memory_order_relaxed);
+        rtl.decode_p25p2_sacch_err.fetch_add((unsigned int)sacch_err_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (voice_err_delta > 0) {
-        g_decode_p25p2_voice_err.fetch_add((unsigned int)voice_err_delta, std::memory_order_relaxed);
+        rtl.decode_p25p2_voice_err.fetch_add((unsigned int)voice_err_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (changed) {
-        g_decode_health_valid.store(1, std::memory_order_release);
+        rtl.decode_health_valid.store(1, std::memory_order_release);
     }
 }
 
 extern "C" void
 rtl_stream_p25p1_ber_update(int fec_ok_delta, int fec_err_delta) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!rtl_decode_health_prepare_update()) {
         return;
     }
     int changed = 0;
     if (fec_ok_delta > 0) {
-        g_decode_p25p1_fec_ok.fetch_add((unsigned int)fec_ok_delta, std::memory_order_relaxed);
+        rtl.decode_p25p1_fec_ok.fetch_add((unsigned int)fec_ok_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (fec_err_delta > 0) {
-        g_decode_p25p1_fec_err.fetch_add((unsigned int)fec_err_delta, std::memory_order_relaxed);
+        rtl.decode_p25p1_fec_err.fetch_add((unsigned int)fec_err_delta, std::memory_order_relaxed);
         changed = 1;
     }
     if (changed) {
-        g_decode_health_valid.store(1, std::memory_order_release);
+        rtl.decode_health_valid.store(1, std::memory_order_release);
     }
 }
 
 extern "C" int
 rtl_stream_get_input_level(dsd_input_level_snapshot* out) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out) {
         return -1;
     }
@@ -7587,14 +7932,14 @@ rtl_stream_get_input_level(dsd_input_level_snapshot* out) {
         rtl_stream_input_level_reset();
         return 0;
     }
-    if (g_input_level_valid.load(std::memory_order_acquire)) {
-        out->status = (dsd_input_level_status)g_input_level_status.load(std::memory_order_relaxed);
-        out->source = (dsd_input_level_source)g_input_level_source.load(std::memory_order_relaxed);
-        out->rms_dbfs = g_input_level_rms_dbfs.load(std::memory_order_relaxed);
-        out->peak_dbfs = g_input_level_peak_dbfs.load(std::memory_order_relaxed);
-        out->clip_pct = g_input_level_clip_pct.load(std::memory_order_relaxed);
-        out->sample_count = g_input_level_sample_count.load(std::memory_order_relaxed);
-        out->updated = (time_t)g_input_level_updated.load(std::memory_order_relaxed);
+    if (rtl.input_level_valid.load(std::memory_order_acquire)) {
+        out->status = (dsd_input_level_status)rtl.input_level_status.load(std::memory_order_relaxed);
+        out->source = (dsd_input_level_source)rtl.input_level_source.load(std::memory_order_relaxed);
+        out->rms_dbfs = rtl.input_level_rms_dbfs.load(std::memory_order_relaxed);
+        out->peak_dbfs = rtl.input_level_peak_dbfs.load(std::memory_order_relaxed);
+        out->clip_pct = rtl.input_level_clip_pct.load(std::memory_order_relaxed);
+        out->sample_count = rtl.input_level_sample_count.load(std::memory_order_relaxed);
+        out->updated = (time_t)rtl.input_level_updated.load(std::memory_order_relaxed);
         return 0;
     }
     return 0;
@@ -7602,103 +7947,110 @@ rtl_stream_get_input_level(dsd_input_level_snapshot* out) {
 
 extern "C" int
 rtl_stream_get_decode_health(rtl_stream_decode_health* out) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out) {
         return -1;
     }
     *out = rtl_stream_decode_health{};
-    uint32_t current_generation = g_rtl_output_generation.load(std::memory_order_acquire);
-    uint32_t snapshot_generation = g_decode_health_generation.load(std::memory_order_acquire);
+    uint32_t current_generation = rtl.output_generation.load(std::memory_order_acquire);
+    uint32_t snapshot_generation = rtl.decode_health_generation.load(std::memory_order_acquire);
     out->generation = current_generation;
     if (!rtl_stream_context_active()) {
         return 0;
     }
-    if (!g_decode_health_valid.load(std::memory_order_acquire) || snapshot_generation != current_generation) {
+    if (!rtl.decode_health_valid.load(std::memory_order_acquire) || snapshot_generation != current_generation) {
         return 0;
     }
     out->valid = 1;
-    out->p25p1_fec_ok = g_decode_p25p1_fec_ok.load(std::memory_order_relaxed);
-    out->p25p1_fec_err = g_decode_p25p1_fec_err.load(std::memory_order_relaxed);
-    out->p25p2_facch_ok = g_decode_p25p2_facch_ok.load(std::memory_order_relaxed);
-    out->p25p2_facch_err = g_decode_p25p2_facch_err.load(std::memory_order_relaxed);
-    out->p25p2_sacch_ok = g_decode_p25p2_sacch_ok.load(std::memory_order_relaxed);
-    out->p25p2_sacch_err = g_decode_p25p2_sacch_err.load(std::memory_order_relaxed);
-    out->p25p2_voice_err = g_decode_p25p2_voice_err.load(std::memory_order_relaxed);
+    out->p25p1_fec_ok = rtl.decode_p25p1_fec_ok.load(std::memory_order_relaxed);
+    out->p25p1_fec_err = rtl.decode_p25p1_fec_err.load(std::memory_order_relaxed);
+    out->p25p2_facch_ok = rtl.decode_p25p2_facch_ok.load(std::memory_order_relaxed);
+    out->p25p2_facch_err = rtl.decode_p25p2_facch_err.load(std::memory_order_relaxed);
+    out->p25p2_sacch_ok = rtl.decode_p25p2_sacch_ok.load(std::memory_order_relaxed);
+    out->p25p2_sacch_err = rtl.decode_p25p2_sacch_err.load(std::memory_order_relaxed);
+    out->p25p2_voice_err = rtl.decode_p25p2_voice_err.load(std::memory_order_relaxed);
     return 0;
 }
 
 /* Toggle generic IQ balance prefilter */
 extern "C" void
 rtl_stream_toggle_iq_balance(int onoff) {
-    demod.iqbal_enable = onoff ? 1 : 0;
+    rtl_cur().demod.iqbal_enable = onoff ? 1 : 0;
 }
 
 extern "C" int
 rtl_stream_get_iq_balance(void) {
-    return demod.iqbal_enable ? 1 : 0;
+    return rtl_cur().demod.iqbal_enable ? 1 : 0;
 }
 
 static void
 rtl_stream_enable_cqpsk_mode(void) {
-    demod.output_kind = DSD_DEMOD_OUTPUT_SYMBOL_CQPSK;
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.demod.output_kind = DSD_DEMOD_OUTPUT_SYMBOL_CQPSK;
     rtl_stream_invalidate_fsk_phase_cfo_snapshot();
-    demod.symbol_levels = 4;
-    demod.ted_enabled = 1;
-    demod.mode_demod = &qpsk_differential_demod;
-    demod.cqpsk_diff_prev_r = 1.0f;
-    demod.cqpsk_diff_prev_j = 0.0f;
-    demod.channel_lpf_profile = DSD_CH_LPF_PROFILE_P25_CQPSK;
+    rtl.demod.symbol_levels = 4;
+    rtl.demod.ted_enabled = 1;
+    rtl.demod.mode_demod = &qpsk_differential_demod;
+    rtl.demod.cqpsk_diff_prev_r = 1.0f;
+    rtl.demod.cqpsk_diff_prev_j = 0.0f;
+    rtl.demod.channel_lpf_profile = DSD_CH_LPF_PROFILE_P25_CQPSK;
 }
 
 static void
 rtl_stream_disable_cqpsk_mode(void) {
-    demod.mode_demod = &dsd_fm_demod;
-    if (demod.channel_lpf_profile == DSD_CH_LPF_PROFILE_P25_CQPSK) {
-        demod.channel_lpf_profile = rtl_stream_fsk_channel_profile_for_current_mode();
-    }
-    if (g_stream && dsd_opts_has_digital_decode_mode(g_stream->opts) && radio_source_is_rtl_family(g_stream->opts)) {
-        demod.output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.demod.mode_demod = &dsd_fm_demod;
+    if (rtl.demod.channel_lpf_profile == DSD_CH_LPF_PROFILE_P25_CQPSK) {
+        rtl.demod.channel_lpf_profile = rtl_stream_fsk_channel_profile_for_current_mode();
+    }
+    if (rtl.internals && dsd_opts_has_digital_decode_mode(rtl.internals->opts)
+        && radio_source_is_rtl_family(rtl.internals->opts)) {
+        rtl.demod.output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
     } else {
-        demod.output_kind = DSD_DEMOD_OUTPUT_AUDIO_MONITOR;
+        rtl.demod.output_kind = DSD_DEMOD_OUTPUT_AUDIO_MONITOR;
         rtl_stream_invalidate_fsk_phase_cfo_snapshot();
     }
 }
 
 static void
 rtl_stream_clear_output_for_demod_family_switch(void) {
-    struct output_state* outp = &output;
-    if (g_stream && g_stream->output) {
-        outp = g_stream->output;
+    dsd_rtl_stream& rtl = rtl_cur();
+    struct output_state* outp = &rtl.output;
+    if (rtl.internals && rtl.internals->output) {
+        outp = rtl.internals->output;
     }
     rtl_stream_clear_output_ring(outp, 1);
-    if (demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR) {
+    if (rtl.demod.output_kind == DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR) {
         rtl_stream_queue_fsk_modem_reset();
     }
 }
 
 static int
 rtl_stream_enter_demod_family_switch_gate(void) {
-    if (!g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals) {
         return 0;
     }
     int expected = 0;
-    if (!controller.retune_in_progress.compare_exchange_strong(expected, 1, std::memory_order_acq_rel,
+    if (!rtl.controller.retune_in_progress.compare_exchange_strong(expected, 1, std::memory_order_acq_rel,
                                                                std::memory_order_acquire)) {
-        controller_wait_for_demod_idle(&controller);
+        controller_wait_for_demod_idle(&rtl.controller);
         return 0;
     }
-    rtl_stream_signal_output_waiters(g_stream && g_stream->output ? g_stream->output : &output);
-    controller_wait_for_demod_idle(&controller);
+    rtl_stream_signal_output_waiters(rtl.internals && rtl.internals->output ? rtl.internals->output : &rtl.output);
+    controller_wait_for_demod_idle(&rtl.controller);
     return 1;
 }
 
 static void
 rtl_stream_leave_demod_family_switch_gate(int gate_armed) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!gate_armed) {
         return;
     }
-    controller.retune_in_progress.store(0, std::memory_order_release);
-    if (input_ring.buffer && input_ring.capacity > 0U) {
-        safe_cond_signal(&input_ring.ready, &input_ring.ready_m);
+    rtl.controller.retune_in_progress.store(0, std::memory_order_release);
+    if (rtl.input_ring.storage && rtl.input_ring.capacity > 0U) {
+        input_ring_signal_ready(&rtl.input_ring);
     }
 }
 
@@ -7706,14 +8058,15 @@ rtl_stream_leave_demod_family_switch_gate(int gate_armed) {
  * Callers must either hold the gate or run on the demod thread. */
 static void
 rtl_stream_apply_cqpsk_toggle(int onoff) {
-    int was = demod.cqpsk_enable ? 1 : 0;
+    dsd_rtl_stream& rtl = rtl_cur();
+    int was = rtl.demod.cqpsk_enable ? 1 : 0;
     int next = onoff ? 1 : 0;
     /* Only store when the value changes: the demod thread reads cqpsk_enable
      * concurrently, so even a same-value store outside the gate is a race. */
     if (next != was) {
-        demod.cqpsk_enable = next;
+        rtl.demod.cqpsk_enable = next;
     }
-    if (demod.cqpsk_enable) {
+    if (rtl.demod.cqpsk_enable) {
         rtl_stream_enable_cqpsk_mode();
     } else {
         rtl_stream_disable_cqpsk_mode();
@@ -7721,8 +8074,8 @@ rtl_stream_apply_cqpsk_toggle(int onoff) {
     rtl_stream_apply_symbol_timing_mode();
     /* If the demod family changed, request a Costas reset on the next retune.
      * This keeps loop state consistent when switching between FM and CQPSK paths. */
-    if (demod.cqpsk_enable != was) {
-        demod.costas_reset_pending = 1;
+    if (rtl.demod.cqpsk_enable != was) {
+        rtl.demod.costas_reset_pending = 1;
         rtl_stream_clear_output_for_demod_family_switch();
     }
 }
@@ -7741,21 +8094,12 @@ rtl_stream_toggle_cqpsk(int onoff) {
 /* ---------------- Deferred demod-profile application ----------------
  * The frame-sync/metrics path requests demod profile changes from the decode
  * thread while the demod thread is running. Writing demod state from that
- * thread races with the pipeline, so requests are queued here and applied by
+ * thread races with the pipeline, so requests are queued on the pipeline and applied by
  * the demod thread between blocks (rtl_stream_consume_demod_profile_request),
  * like the other *_pending consumes. The mutex keeps each request's parameter
  * set consistent even if a new request lands mid-consume; the atomic pending
  * flag lets the demod thread skip the lock on the (common) no-request path.
  * A newer request overwrites an unconsumed older one: last-writer-wins. */
-static std::mutex g_profile_req_m;
-static std::atomic<int> g_profile_req_pending{0};
-/* Guarded by g_profile_req_m: */
-static int g_profile_req_cqpsk = -1;   /* -1 = leave unchanged */
-static int g_profile_req_sym_rate = 0; /* <=0 = leave symbol profile unchanged */
-static int g_profile_req_levels = 0;
-static int g_profile_req_chan = -1;
-static int g_profile_req_ted_sps = -1; /* <0 = leave timing untouched, 0 = clear override only */
-static int g_profile_req_ted_sps_is_override = 0;
 
 /* Shared application order for both the immediate and the deferred path.
  * use_gate selects the gated public toggle (callers outside the demod
@@ -7792,17 +8136,18 @@ rtl_stream_apply_demod_profile_params(int cqpsk, int sym_rate, int levels, int c
 extern "C" int
 rtl_stream_request_demod_profile(int cqpsk_enable, int symbol_rate_hz, int levels, int channel_profile, int ted_sps,
                                  int ted_sps_is_override) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (symbol_rate_hz > 0 && levels != 2 && levels != 4) {
         return -1;
     }
     if (ted_sps_is_override && ted_sps <= 0) {
         return -1;
     }
-    if (!g_stream) {
+    if (!rtl.internals) {
         /* No pipeline running: there is no demod thread to race with (or to
          * consume a queued request), so apply immediately.
          *
-         * Ordering assumption: g_stream transitions happen on the thread that
+         * Ordering assumption: internals transitions happen on the thread that
          * owns stream open/close, and requesters only run either before open,
          * after close, or from threads the running pipeline itself services.
          * A request racing the open/close transition is not supported; a
@@ -7812,20 +8157,21 @@ rtl_stream_request_demod_profile(int cqpsk_enable, int symbol_rate_hz, int level
                                               ted_sps_is_override, 1);
         return 0;
     }
-    std::lock_guard<std::mutex> lock(g_profile_req_m);
-    g_profile_req_cqpsk = cqpsk_enable;
-    g_profile_req_sym_rate = symbol_rate_hz;
-    g_profile_req_levels = levels;
-    g_profile_req_chan = channel_profile;
-    g_profile_req_ted_sps = ted_sps;
-    g_profile_req_ted_sps_is_override = ted_sps_is_override ? 1 : 0;
-    g_profile_req_pending.store(1, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(rtl.profile_req_m);
+    rtl.profile_req_cqpsk = cqpsk_enable;
+    rtl.profile_req_sym_rate = symbol_rate_hz;
+    rtl.profile_req_levels = levels;
+    rtl.profile_req_chan = channel_profile;
+    rtl.profile_req_ted_sps = ted_sps;
+    rtl.profile_req_ted_sps_is_override = ted_sps_is_override ? 1 : 0;
+    rtl.profile_req_pending.store(1, std::memory_order_release);
     return 0;
 }
 
 static void
 rtl_stream_consume_demod_profile_request(void) {
-    if (!g_profile_req_pending.load(std::memory_order_acquire)) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.profile_req_pending.load(std::memory_order_acquire)) {
         return;
     }
     int cqpsk;
@@ -7835,14 +8181,14 @@ rtl_stream_consume_demod_profile_request(void) {
     int ted_sps;
     int ted_sps_is_override;
     {
-        std::lock_guard<std::mutex> lock(g_profile_req_m);
-        g_profile_req_pending.store(0, std::memory_order_relaxed);
-        cqpsk = g_profile_req_cqpsk;
-        sym_rate = g_profile_req_sym_rate;
-        levels = g_profile_req_levels;
-        chan = g_profile_req_chan;
-        ted_sps = g_profile_req_ted_sps;
-        ted_sps_is_override = g_profile_req_ted_sps_is_override;
+        std::lock_guard<std::mutex> lock(rtl.profile_req_m);
+        rtl.profile_req_pending.store(0, std::memory_order_relaxed);
+        cqpsk = rtl.profile_req_cqpsk;
+        sym_rate = rtl.profile_req_sym_rate;
+        levels = rtl.profile_req_levels;
+        chan = rtl.profile_req_chan;
+        ted_sps = rtl.profile_req_ted_sps;
+        ted_sps_is_override = rtl.profile_req_ted_sps_is_override;
     }
     rtl_stream_apply_demod_profile_params(cqpsk, sym_rate, levels, chan, ted_sps, ted_sps_is_override, 0);
 }
@@ -7853,8 +8199,9 @@ rtl_stream_consume_demod_profile_request(void) {
  * when the demod thread consumes its first block. */
 static void
 rtl_stream_clear_demod_profile_request(void) {
-    std::lock_guard<std::mutex> lock(g_profile_req_m);
-    g_profile_req_pending.store(0, std::memory_order_relaxed);
+    dsd_rtl_stream& rtl = rtl_cur();
+    std::lock_guard<std::mutex> lock(rtl.profile_req_m);
+    rtl.profile_req_pending.store(0, std::memory_order_relaxed);
 }
 
 static int
@@ -7903,22 +8250,23 @@ rtl_stream_retune_profile_matches_target(const RtlRetuneProfile* profile, uint32
 
 static int
 rtl_stream_take_pending_retune_profile(RtlRetuneProfile* out_profile, uint32_t request_id, uint32_t target_freq_hz) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_profile) {
         return 0;
     }
-    std::lock_guard<std::mutex> lock(g_pending_retune_profile_mutex);
-    if (!rtl_stream_retune_profile_matches_target(&g_pending_retune_profile, target_freq_hz)) {
+    std::lock_guard<std::mutex> lock(rtl.pending_retune_profile_mutex);
+    if (!rtl_stream_retune_profile_matches_target(&rtl.pending_retune_profile, target_freq_hz)) {
         return 0;
     }
 
     rtl_stream_clear_retune_profile(out_profile);
-    *out_profile = g_pending_retune_profile;
+    *out_profile = rtl.pending_retune_profile;
     out_profile->active = 1;
     out_profile->request_id = request_id;
     if (out_profile->target_freq_hz == 0U) {
         out_profile->target_freq_hz = target_freq_hz;
     }
-    rtl_stream_clear_retune_profile(&g_pending_retune_profile);
+    rtl_stream_clear_retune_profile(&rtl.pending_retune_profile);
     return 1;
 }
 
@@ -7926,6 +8274,7 @@ static void
 rtl_stream_store_pending_retune_profile(uint32_t target_freq_hz, int cqpsk_enable, int symbol_rate_hz, int levels,
                                         int channel_profile, int ted_sps, int persist_ted_override,
                                         const rtl_stream_retune_gain_profile* gain_profile) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (levels != 2 && levels != 4) {
         levels = 4;
     }
@@ -7944,8 +8293,8 @@ rtl_stream_store_pending_retune_profile(uint32_t target_freq_hz, int cqpsk_enabl
     rtl_stream_copy_retune_gain_profile(&profile, gain_profile);
     profile.target_freq_hz = target_freq_hz;
 
-    std::lock_guard<std::mutex> lock(g_pending_retune_profile_mutex);
-    g_pending_retune_profile = profile;
+    std::lock_guard<std::mutex> lock(rtl.pending_retune_profile_mutex);
+    rtl.pending_retune_profile = profile;
 }
 
 extern "C" void
@@ -7959,32 +8308,35 @@ rtl_stream_prepare_retune_profile_for_target_with_gain(uint32_t target_freq_hz,
 
 extern "C" void
 rtl_stream_clear_pending_retune_profile(void) {
-    std::lock_guard<std::mutex> lock(g_pending_retune_profile_mutex);
-    rtl_stream_clear_retune_profile(&g_pending_retune_profile);
+    dsd_rtl_stream& rtl = rtl_cur();
+    std::lock_guard<std::mutex> lock(rtl.pending_retune_profile_mutex);
+    rtl_stream_clear_retune_profile(&rtl.pending_retune_profile);
 }
 
 static void
 rtl_stream_restore_retune_autogain(const RtlRetuneProfile* profile) {
     if (profile && profile->tuner_autogain_is_set) {
-        g_tuner_autogain_on.store(profile->tuner_autogain_on ? 1 : 0, std::memory_order_relaxed);
+        rtl_cur().shared.tuner_autogain_on.store(profile->tuner_autogain_on ? 1 : 0, std::memory_order_relaxed);
     }
 }
 
 static int
 rtl_stream_apply_auto_retune_gain(void) {
-    int rc = rtl_device_set_gain(rtl_device_handle, AUTO_GAIN);
+    dsd_rtl_stream& rtl = rtl_cur();
+    int rc = rtl_device_set_gain(rtl.device, AUTO_GAIN);
     if (rc == 0) {
-        dongle.gain = AUTO_GAIN;
+        rtl.dongle.gain = AUTO_GAIN;
     }
     return rc;
 }
 
 static int
 rtl_stream_apply_manual_retune_gain(int tuner_gain_tenth_db) {
-    int rc = rtl_device_set_gain_nearest(rtl_device_handle, tuner_gain_tenth_db);
+    dsd_rtl_stream& rtl = rtl_cur();
+    int rc = rtl_device_set_gain_nearest(rtl.device, tuner_gain_tenth_db);
     if (rc == 0) {
-        int applied = rtl_device_get_tuner_gain(rtl_device_handle);
-        dongle.gain = applied >= 0 ? applied : tuner_gain_tenth_db;
+        int applied = rtl_device_get_tuner_gain(rtl.device);
+        rtl.dongle.gain = applied >= 0 ? applied : tuner_gain_tenth_db;
     }
     return rc;
 }
@@ -8012,6 +8364,7 @@ rtl_stream_apply_retune_gain_profile(const RtlRetuneProfile* profile) {
 
 static void
 rtl_stream_apply_retune_profile(const RtlRetuneProfile* profile, uint32_t center_freq_hz) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!profile || !profile->active) {
         return;
     }
@@ -8040,11 +8393,11 @@ rtl_stream_apply_retune_profile(const RtlRetuneProfile* profile, uint32_t center
         return;
     }
     ted_sps = rtl_stream_clamp_retune_ted_sps(ted_sps);
-    if (ted_sps != demod.ted_sps) {
-        demod.costas_reset_pending = 1;
+    if (ted_sps != rtl.demod.ted_sps) {
+        rtl.demod.costas_reset_pending = 1;
     }
-    demod.ted_sps = ted_sps;
-    demod.ted_sps_override = profile->ted_override ? ted_sps : 0;
+    rtl.demod.ted_sps = ted_sps;
+    rtl.demod.ted_sps_override = profile->ted_override ? ted_sps : 0;
 }
 
 extern "C" void
@@ -8056,9 +8409,10 @@ rtl_stream_apply_pending_retune_profile_for_target(uint32_t target_freq_hz) {
 
 extern "C" int
 rtl_stream_get_cqpsk_status(int* cqpsk_enable, int* cqpsk_timing_active) {
+    dsd_rtl_stream& rtl = rtl_cur();
     /* Main-thread hook: use the published mirrors, not demod fields. */
-    int cqpsk = (g_pub_cqpsk_enable.load(std::memory_order_relaxed)
-                 || g_pub_output_kind.load(std::memory_order_relaxed) == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK)
+    int cqpsk = (rtl.pub_cqpsk_enable.load(std::memory_order_relaxed)
+                 || rtl.pub_output_kind.load(std::memory_order_relaxed) == DSD_DEMOD_OUTPUT_SYMBOL_CQPSK)
                     ? 1
                     : 0;
     if (cqpsk_enable) {
@@ -8083,14 +8437,15 @@ rtl_stream_get_cqpsk_status(int* cqpsk_enable, int* cqpsk_timing_active) {
  */
 static const char*
 rtl_stream_backend_name(void) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (stream_is_replay_active()) {
         return "iq-replay";
     }
-    if (g_stream && g_stream->opts) {
-        if (g_stream->opts->rtltcp_enabled) {
+    if (rtl.internals && rtl.internals->opts) {
+        if (rtl.internals->opts->rtltcp_enabled) {
             return "rtl_tcp";
         }
-        if (dsd_opts_audio_in_dev_is_soapy_spec(g_stream->opts->audio_in_dev)) {
+        if (dsd_opts_audio_in_dev_is_soapy_spec(rtl.internals->opts->audio_in_dev)) {
             return "soapy";
         }
     }
@@ -8099,7 +8454,7 @@ rtl_stream_backend_name(void) {
 
 static void
 rtl_stream_log_tune_warning(uint32_t requested_freq, const char* reason) {
-    uint32_t current_freq = controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    uint32_t current_freq = rtl_cur().controller.last_applied_freq_hz.load(std::memory_order_acquire);
     if (current_freq == 0U) {
         current_freq = load_dongle_frequency();
     }
@@ -8118,12 +8473,13 @@ rtl_stream_tune_apply_completion_result(int rc, int completion, uint32_t request
 
 static int
 rtl_stream_tune_wait_for_completion(uint32_t request_id, uint32_t requested_freq) {
+    dsd_rtl_stream& rtl = rtl_cur();
     int rc = RTL_STREAM_TUNE_OK;
     int completion = RTL_STREAM_TUNE_OK;
     const uint64_t deadline_ns = dsd_time_monotonic_ns() + 500000000ULL;
-    dsd_mutex_lock(&controller.retune_done_m);
-    while (controller.retune_complete_id.load(std::memory_order_acquire) < request_id) {
-        if (dsd_exitflag_load() || (g_stream && g_stream->should_exit.load(std::memory_order_acquire))) {
+    dsd_mutex_lock(&rtl.controller.retune_done_m);
+    while (rtl.controller.retune_complete_id.load(std::memory_order_acquire) < request_id) {
+        if (dsd_exitflag_load() || (rtl.internals && rtl.internals->should_exit.load(std::memory_order_acquire))) {
             rtl_stream_log_tune_warning(requested_freq, "shutdown");
             rc = RTL_STREAM_TUNE_FAILED;
             break;
@@ -8131,7 +8487,7 @@ rtl_stream_tune_wait_for_completion(uint32_t request_id, uint32_t requested_freq
         uint64_t now_ns = dsd_time_monotonic_ns();
         if (now_ns >= deadline_ns) {
             rtl_stream_log_tune_warning(requested_freq, "timeout");
-            controller_gate_tune_timeout(&controller, request_id);
+            controller_gate_tune_timeout(&rtl.controller, request_id);
             rc = RTL_STREAM_TUNE_TIMEOUT;
             break;
         }
@@ -8140,17 +8496,17 @@ rtl_stream_tune_wait_for_completion(uint32_t request_id, uint32_t requested_freq
         if (wait_ms <= 0) {
             wait_ms = 1;
         }
-        int wait_rc = dsd_cond_timedwait(&controller.retune_done_cond, &controller.retune_done_m, wait_ms);
+        int wait_rc = dsd_cond_timedwait(&rtl.controller.retune_done_cond, &rtl.controller.retune_done_m, wait_ms);
         if (wait_rc != 0) {
             continue;
         }
     }
     if (rc == RTL_STREAM_TUNE_OK
-        && !controller_load_retune_completion_result_locked(&controller, request_id, &completion)) {
+        && !controller_load_retune_completion_result_locked(&rtl.controller, request_id, &completion)) {
         rtl_stream_log_tune_warning(requested_freq, "completion_missing");
         rc = RTL_STREAM_TUNE_FAILED;
     }
-    dsd_mutex_unlock(&controller.retune_done_m);
+    dsd_mutex_unlock(&rtl.controller.retune_done_m);
     return rtl_stream_tune_apply_completion_result(rc, completion, requested_freq);
 }
 
@@ -8167,7 +8523,7 @@ rtl_stream_store_capture_frequency_for_center(uint32_t center_freq_hz) {
 
 static void
 rtl_stream_tune_reconcile_applied_frequency(dsd_opts* opts, uint32_t requested_freq, const char* reason) {
-    uint32_t applied_freq = controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    uint32_t applied_freq = rtl_cur().controller.last_applied_freq_hz.load(std::memory_order_acquire);
     if (applied_freq == 0 || applied_freq == requested_freq) {
         return;
     }
@@ -8273,7 +8629,8 @@ dsd_rtl_stream_register_tune_completion_callback(rtl_stream_tune_completion_call
 #if defined(DSD_NEO_ENABLE_INTERNAL_TEST_HOOKS)
 extern "C" int
 dsd_rtl_stream_test_request_retune(long int frequency, int timeout_ms) {
-    if (!g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.internals) {
         return -2;
     }
     if (stream_is_replay_active()) {
@@ -8290,67 +8647,68 @@ dsd_rtl_stream_test_request_retune(long int frequency, int timeout_ms) {
     }
 
     int remaining_ms = timeout_ms;
-    dsd_mutex_lock(&controller.retune_done_m);
-    while (controller.retune_complete_id.load(std::memory_order_acquire) < request_id) {
+    dsd_mutex_lock(&rtl.controller.retune_done_m);
+    while (rtl.controller.retune_complete_id.load(std::memory_order_acquire) < request_id) {
         if (remaining_ms <= 0) {
-            dsd_mutex_unlock(&controller.retune_done_m);
+            dsd_mutex_unlock(&rtl.controller.retune_done_m);
             return -2;
         }
         int wait_slice_ms = (remaining_ms > 50) ? 50 : remaining_ms;
-        int wait_rc = dsd_cond_timedwait(&controller.retune_done_cond, &controller.retune_done_m, wait_slice_ms);
+        int wait_rc =
+            dsd_cond_timedwait(&rtl.controller.retune_done_cond, &rtl.controller.retune_done_m, wait_slice_ms);
         remaining_ms -= wait_slice_ms;
         if (wait_rc != 0) {
-            dsd_mutex_unlock(&controller.retune_done_m);
+            dsd_mutex_unlock(&rtl.controller.retune_done_m);
             return -2;
         }
-        if (dsd_exitflag_load() || (g_stream && g_stream->should_exit.load(std::memory_order_acquire))) {
-            dsd_mutex_unlock(&controller.retune_done_m);
+        if (dsd_exitflag_load() || (rtl.internals && rtl.internals->should_exit.load(std::memory_order_acquire))) {
+            dsd_mutex_unlock(&rtl.controller.retune_done_m);
             return -2;
         }
     }
-    dsd_mutex_unlock(&controller.retune_done_m);
+    dsd_mutex_unlock(&rtl.controller.retune_done_m);
     return 0;
 }
 
 extern "C" int
 rtl_stream_test_prepare_reconfigure_input(size_t queued_samples, size_t* out_used_after,
                                           uint32_t* out_generation_before, uint32_t* out_generation_after) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_used_after || !out_generation_before || !out_generation_after) {
         return -1;
     }
 
     int initialized_output = 0;
-    if (!output.buffer) {
-        output_init(&output);
+    if (!rtl.output.buffer) {
+        output_init(&rtl.output);
         initialized_output = 1;
     }
-    if (!output.buffer || output.capacity == 0U) {
+    if (!rtl.output.buffer || rtl.output.capacity == 0U) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -2;
     }
-    if (queued_samples >= output.capacity) {
+    if (queued_samples >= rtl.output.capacity) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -3;
     }
 
-    ring_clear(&output);
-    output.tail.store(0);
-    output.head.store(queued_samples);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
 
     *out_generation_before = rtl_stream_output_generation();
-    controller_enter_reconfigure_gate(&controller);
+    controller_enter_reconfigure_gate(&rtl.controller);
     controller_prepare_reconfigure_input();
-    controller_end_reconfigure(&controller);
+    controller_end_reconfigure(&rtl.controller);
     *out_generation_after = rtl_stream_output_generation();
-    *out_used_after = ring_used(&output);
+    *out_used_after = ring_used(&rtl.output);
 
-    ring_clear(&output);
+    ring_clear(&rtl.output);
     if (initialized_output) {
-        output_cleanup(&output);
+        output_cleanup(&rtl.output);
     }
     return 0;
 }
@@ -8358,41 +8716,41 @@ rtl_stream_test_prepare_reconfigure_input(size_t queued_samples, size_t* out_use
 extern "C" int
 rtl_stream_test_retune_output_pending(size_t queued_samples, int cached_symbols, size_t* out_ring_pending,
                                       int* out_cache_pending, int* out_drained) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_ring_pending || !out_cache_pending || !out_drained || cached_symbols < 0) {
         return -1;
     }
 
     int initialized_output = 0;
-    if (!output.buffer) {
-        output_init(&output);
+    if (!rtl.output.buffer) {
+        output_init(&rtl.output);
         initialized_output = 1;
     }
-    if (!output.buffer || output.capacity == 0U) {
+    if (!rtl.output.buffer || rtl.output.capacity == 0U) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -2;
     }
-    if (queued_samples >= output.capacity) {
+    if (queued_samples >= rtl.output.capacity) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -3;
     }
 
-    ring_clear(&output);
-    output.tail.store(0);
-    output.head.store(queued_samples);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(cached_symbols);
 
-    retune_output_pending(&output, out_ring_pending, out_cache_pending);
-    *out_drained = retune_output_drained(&output);
+    retune_output_pending(&rtl.output, out_ring_pending, out_cache_pending);
+    *out_drained = retune_output_drained(&rtl.output);
 
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
-    ring_clear(&output);
+    ring_clear(&rtl.output);
     if (initialized_output) {
-        output_cleanup(&output);
+        output_cleanup(&rtl.output);
     }
     return 0;
 }
@@ -8401,32 +8759,32 @@ extern "C" int
 rtl_stream_test_tune_result_output_drain(int tune_result, size_t queued_samples, int cached_symbols,
                                          size_t* out_used_after, int* out_cache_pending_after,
                                          uint32_t* out_generation_before, uint32_t* out_generation_after) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_used_after || !out_cache_pending_after || !out_generation_before || !out_generation_after
         || cached_symbols < 0) {
         return -1;
     }
 
     int initialized_output = 0;
-    if (!output.buffer) {
-        output_init(&output);
+    if (!rtl.output.buffer) {
+        output_init(&rtl.output);
         initialized_output = 1;
     }
-    if (!output.buffer || output.capacity == 0U) {
+    if (!rtl.output.buffer || rtl.output.capacity == 0U) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -2;
     }
-    if (queued_samples >= output.capacity) {
+    if (queued_samples >= rtl.output.capacity) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -3;
     }
 
-    ring_clear(&output);
-    output.tail.store(0);
-    output.head.store(queued_samples);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(cached_symbols);
 
@@ -8436,13 +8794,13 @@ rtl_stream_test_tune_result_output_drain(int tune_result, size_t queued_samples,
      * terminal completion for the queued request. */
     (void)tune_result;
     *out_generation_after = rtl_stream_output_generation();
-    *out_used_after = ring_used(&output);
+    *out_used_after = ring_used(&rtl.output);
     *out_cache_pending_after = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
 
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
-    ring_clear(&output);
+    ring_clear(&rtl.output);
     if (initialized_output) {
-        output_cleanup(&output);
+        output_cleanup(&rtl.output);
     }
     return 0;
 }
@@ -8468,8 +8826,7 @@ rtl_stream_test_tune_timeout_read_gate(size_t queued_samples, int* out_read_whil
 
     controller_state test_controller = {};
     controller_init(&test_controller);
-    test_output.tail.store(0U, std::memory_order_release);
-    test_output.head.store(queued_samples, std::memory_order_release);
+    test_output.reset(queued_samples);
 
     *out_generation_before = rtl_stream_output_generation();
     controller_gate_tune_timeout(&test_controller, 1U);
@@ -8484,8 +8841,7 @@ rtl_stream_test_tune_timeout_read_gate(size_t queued_samples, int* out_read_whil
      * cleared the pre-apply output boundary. Model fresh output produced after
      * that recovery rather than exposing the pre-timeout samples. */
     ring_clear(&test_output);
-    test_output.tail.store(0U, std::memory_order_release);
-    test_output.head.store(1U, std::memory_order_release);
+    test_output.reset(1U);
     int gated_after_failure = 0;
     *out_read_after_failed_completion =
         rtl_stream_read_live_available(&test_controller, &test_output, &sample, 1U, &gated_after_failure);
@@ -8494,8 +8850,7 @@ rtl_stream_test_tune_timeout_read_gate(size_t queued_samples, int* out_read_whil
      * controller boundary reopens reads for replacement output. */
     controller_gate_tune_timeout(&test_controller, 2U);
     ring_clear(&test_output);
-    test_output.tail.store(0U, std::memory_order_release);
-    test_output.head.store(1U, std::memory_order_release);
+    test_output.reset(1U);
     controller_signal_manual_retune_complete(&test_controller, RTL_STREAM_TUNE_OK);
     int gated_after_recovery = 0;
     *out_read_after_recovery =
@@ -8520,33 +8875,34 @@ dsd_rtl_stream_test_manual_retune_completion_result(int retune_rc, int reconfigu
 extern "C" int
 dsd_rtl_stream_test_tune_failure_reconciles_applied(uint32_t requested_freq_hz, uint32_t applied_freq_hz,
                                                     long int* out_opts_freq, uint32_t* out_capture_freq_hz) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_opts_freq || !out_capture_freq_hz) {
         return -1;
     }
 
-    uint32_t outer_applied_freq_hz = controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    uint32_t outer_applied_freq_hz = rtl.controller.last_applied_freq_hz.load(std::memory_order_acquire);
     CaptureSettingsSnapshot outer = capture_settings_snapshot();
-    int outer_offset_tuning = dongle.offset_tuning;
-    int outer_edge = controller.edge;
+    int outer_offset_tuning = rtl.dongle.offset_tuning;
+    int outer_edge = rtl.controller.edge;
     int outer_disable_fs4_shift = disable_fs4_shift;
-    int outer_rate_in = demod.rate_in;
+    int outer_rate_in = rtl.demod.rate_in;
 
     dsd_opts* opts = static_cast<dsd_opts*>(calloc(1, sizeof(*opts)));
     if (!opts) {
         restore_capture_settings(&outer);
-        dongle.offset_tuning = outer_offset_tuning;
-        controller.edge = outer_edge;
+        rtl.dongle.offset_tuning = outer_offset_tuning;
+        rtl.controller.edge = outer_edge;
         disable_fs4_shift = outer_disable_fs4_shift;
-        demod.rate_in = outer_rate_in;
-        controller.last_applied_freq_hz.store(outer_applied_freq_hz, std::memory_order_release);
+        rtl.demod.rate_in = outer_rate_in;
+        rtl.controller.last_applied_freq_hz.store(outer_applied_freq_hz, std::memory_order_release);
         return -2;
     }
     opts->rtlsdr_center_freq = (long int)requested_freq_hz;
-    controller.last_applied_freq_hz.store(applied_freq_hz, std::memory_order_release);
-    dongle.offset_tuning = 0;
-    controller.edge = 0;
+    rtl.controller.last_applied_freq_hz.store(applied_freq_hz, std::memory_order_release);
+    rtl.dongle.offset_tuning = 0;
+    rtl.controller.edge = 0;
     disable_fs4_shift = 0;
-    demod.rate_in = 48000;
+    rtl.demod.rate_in = 48000;
     store_dongle_rate(960000U);
     store_dongle_frequency(requested_freq_hz);
 
@@ -8556,11 +8912,11 @@ dsd_rtl_stream_test_tune_failure_reconciles_applied(uint32_t requested_freq_hz,
     free(opts);
 
     restore_capture_settings(&outer);
-    dongle.offset_tuning = outer_offset_tuning;
-    controller.edge = outer_edge;
+    rtl.dongle.offset_tuning = outer_offset_tuning;
+    rtl.controller.edge = outer_edge;
     disable_fs4_shift = outer_disable_fs4_shift;
-    demod.rate_in = outer_rate_in;
-    controller.last_applied_freq_hz.store(outer_applied_freq_hz, std::memory_order_release);
+    rtl.demod.rate_in = outer_rate_in;
+    rtl.controller.last_applied_freq_hz.store(outer_applied_freq_hz, std::memory_order_release);
     return 0;
 }
 
@@ -8568,47 +8924,48 @@ extern "C" int
 dsd_rtl_stream_test_capture_settings_failure_restore(uint32_t* out_full_freq_hz, uint32_t* out_full_rate_hz,
                                                      int* out_full_rate_out_hz, uint32_t* out_partial_freq_hz,
                                                      uint32_t* out_partial_rate_hz, int* out_partial_rate_out_hz) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_full_freq_hz || !out_full_rate_hz || !out_full_rate_out_hz || !out_partial_freq_hz || !out_partial_rate_hz
         || !out_partial_rate_out_hz) {
         return -1;
     }
 
     CaptureSettingsSnapshot outer = capture_settings_snapshot();
-    int outer_rate_in = demod.rate_in;
-    int outer_post_downsample = demod.post_downsample;
-    int outer_offset_tuning = dongle.offset_tuning;
-    int outer_edge = controller.edge;
+    int outer_rate_in = rtl.demod.rate_in;
+    int outer_post_downsample = rtl.demod.post_downsample;
+    int outer_offset_tuning = rtl.dongle.offset_tuning;
+    int outer_edge = rtl.controller.edge;
     int outer_disable_fs4_shift = disable_fs4_shift;
 
-    demod.rate_in = 48000;
-    demod.post_downsample = 1;
-    demod.downsample_passes = 0;
-    demod.output_scale = 0.5f;
-    demod.rate_out = 48000;
-    dongle.offset_tuning = 1;
-    controller.edge = 0;
+    rtl.demod.rate_in = 48000;
+    rtl.demod.post_downsample = 1;
+    rtl.demod.downsample_passes = 0;
+    rtl.demod.output_scale = 0.5f;
+    rtl.demod.rate_out = 48000;
+    rtl.dongle.offset_tuning = 1;
+    rtl.controller.edge = 0;
     disable_fs4_shift = 1;
     store_dongle_frequency(855000000U);
     store_dongle_rate(960000U);
 
     CaptureSettingsSnapshot before = capture_settings_snapshot_for_center(851000000U);
-    optimal_settings(855000000, demod.rate_in);
+    optimal_settings(855000000, rtl.demod.rate_in);
     restore_capture_settings(&before);
     *out_full_freq_hz = load_dongle_frequency();
     *out_full_rate_hz = load_dongle_rate();
-    *out_full_rate_out_hz = demod.rate_out;
+    *out_full_rate_out_hz = rtl.demod.rate_out;
 
-    optimal_settings(855000000, demod.rate_in);
+    optimal_settings(855000000, rtl.demod.rate_in);
     restore_capture_rate_settings(&before);
     *out_partial_freq_hz = load_dongle_frequency();
     *out_partial_rate_hz = load_dongle_rate();
-    *out_partial_rate_out_hz = demod.rate_out;
+    *out_partial_rate_out_hz = rtl.demod.rate_out;
 
     restore_capture_settings(&outer);
-    demod.rate_in = outer_rate_in;
-    demod.post_downsample = outer_post_downsample;
-    dongle.offset_tuning = outer_offset_tuning;
-    controller.edge = outer_edge;
+    rtl.demod.rate_in = outer_rate_in;
+    rtl.demod.post_downsample = outer_post_downsample;
+    rtl.dongle.offset_tuning = outer_offset_tuning;
+    rtl.controller.edge = outer_edge;
     disable_fs4_shift = outer_disable_fs4_shift;
     return 0;
 }
@@ -8663,47 +9020,47 @@ extern "C" int
 rtl_stream_test_clear_output(size_t queued_samples, int cached_symbols, size_t* out_used_after,
                              int* out_cache_pending_after, uint32_t* out_generation_before,
                              uint32_t* out_generation_after) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_used_after || !out_cache_pending_after || !out_generation_before || !out_generation_after
         || cached_symbols < 0) {
         return -1;
     }
 
     int initialized_output = 0;
-    if (!output.buffer) {
-        output_init(&output);
+    if (!rtl.output.buffer) {
+        output_init(&rtl.output);
         initialized_output = 1;
     }
-    if (!output.buffer || output.capacity == 0U) {
+    if (!rtl.output.buffer || rtl.output.capacity == 0U) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -2;
     }
-    if (queued_samples >= output.capacity) {
+    if (queued_samples >= rtl.output.capacity) {
         if (initialized_output) {
-            output_cleanup(&output);
+            output_cleanup(&rtl.output);
         }
         return -3;
     }
 
-    ring_clear(&output);
-    output.tail.store(0);
-    output.head.store(queued_samples);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(cached_symbols);
-    int prev_reset_pending = g_fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
+    int prev_reset_pending = rtl.fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
 
     *out_generation_before = rtl_stream_output_generation();
     dsd_rtl_stream_clear_output();
     *out_generation_after = rtl_stream_output_generation();
-    *out_used_after = ring_used(&output);
+    *out_used_after = ring_used(&rtl.output);
     *out_cache_pending_after = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
 
-    ring_clear(&output);
+    ring_clear(&rtl.output);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
-    g_fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
+    rtl.fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
     if (initialized_output) {
-        output_cleanup(&output);
+        output_cleanup(&rtl.output);
     }
     return 0;
 }
@@ -8711,6 +9068,7 @@ rtl_stream_test_clear_output(size_t queued_samples, int cached_symbols, size_t*
 extern "C" int
 rtl_stream_test_clear_output_fsk_reset(size_t queued_samples, int* out_have_prev_after_clear, int* out_consumed_reset,
                                        int* out_have_prev_after_consume) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_have_prev_after_clear || !out_consumed_reset || !out_have_prev_after_consume) {
         return -1;
     }
@@ -8722,24 +9080,23 @@ rtl_stream_test_clear_output_fsk_reset(size_t queued_samples, int* out_have_prev
         return prepare_rc;
     }
 
-    int prev_output_kind = demod.output_kind;
-    dsd_fsk_modem_state prev_modem = demod.fsk_modem_state;
-    int prev_reset_pending = g_fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
-    demod.output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
-    demod.fsk_modem_state.have_prev = 1;
+    int prev_output_kind = rtl.demod.output_kind;
+    dsd_fsk_modem_state prev_modem = rtl.demod.fsk_modem_state;
+    int prev_reset_pending = rtl.fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
+    rtl.demod.output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
+    rtl.demod.fsk_modem_state.have_prev = 1;
 
-    ring_clear(&output);
-    output.tail.store(0);
-    output.head.store(queued_samples);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
 
     dsd_rtl_stream_clear_output();
-    *out_have_prev_after_clear = demod.fsk_modem_state.have_prev;
-    *out_consumed_reset = rtl_stream_consume_fsk_modem_reset_pending(&demod);
-    *out_have_prev_after_consume = demod.fsk_modem_state.have_prev;
+    *out_have_prev_after_clear = rtl.demod.fsk_modem_state.have_prev;
+    *out_consumed_reset = rtl_stream_consume_fsk_modem_reset_pending(&rtl.demod);
+    *out_have_prev_after_consume = rtl.demod.fsk_modem_state.have_prev;
 
-    demod.output_kind = prev_output_kind;
-    demod.fsk_modem_state = prev_modem;
-    g_fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
+    rtl.demod.output_kind = prev_output_kind;
+    rtl.demod.fsk_modem_state = prev_modem;
+    rtl.fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
     fsk_reacquire_test_reset_output_state();
     fsk_reacquire_test_cleanup_output_ring(initialized_output);
     return 0;
@@ -8769,102 +9126,106 @@ struct CqpskToggleTestSnapshot {
 
 static void
 cqpsk_toggle_test_save(CqpskToggleTestSnapshot* s) {
-    s->cqpsk = demod.cqpsk_enable;
-    s->output_kind = demod.output_kind;
-    s->symbol_rate_hz = demod.symbol_rate_hz;
-    s->symbol_levels = demod.symbol_levels;
-    s->ted_enabled = demod.ted_enabled;
-    s->channel_lpf_profile = demod.channel_lpf_profile;
-    s->costas_reset_pending = demod.costas_reset_pending;
-    s->mode_demod = demod.mode_demod;
-    s->cqpsk_diff_prev_r = demod.cqpsk_diff_prev_r;
-    s->cqpsk_diff_prev_j = demod.cqpsk_diff_prev_j;
-    s->modem = demod.fsk_modem_state;
-    s->stream = g_stream;
-    s->retune_in_progress = controller.retune_in_progress.exchange(0, std::memory_order_acq_rel);
-    s->reset_pending = g_fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
+    dsd_rtl_stream& rtl = rtl_cur();
+    s->cqpsk = rtl.demod.cqpsk_enable;
+    s->output_kind = rtl.demod.output_kind;
+    s->symbol_rate_hz = rtl.demod.symbol_rate_hz;
+    s->symbol_levels = rtl.demod.symbol_levels;
+    s->ted_enabled = rtl.demod.ted_enabled;
+    s->channel_lpf_profile = rtl.demod.channel_lpf_profile;
+    s->costas_reset_pending = rtl.demod.costas_reset_pending;
+    s->mode_demod = rtl.demod.mode_demod;
+    s->cqpsk_diff_prev_r = rtl.demod.cqpsk_diff_prev_r;
+    s->cqpsk_diff_prev_j = rtl.demod.cqpsk_diff_prev_j;
+    s->modem = rtl.demod.fsk_modem_state;
+    s->stream = rtl.internals;
+    s->retune_in_progress = rtl.controller.retune_in_progress.exchange(0, std::memory_order_acq_rel);
+    s->reset_pending = rtl.fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
     s->cache_pending = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
-    s->output_head = output.head.load(std::memory_order_acquire);
-    s->output_tail = output.tail.load(std::memory_order_acquire);
+    s->output_head = rtl.output.head.load(std::memory_order_acquire);
+    s->output_tail = rtl.output.tail.load(std::memory_order_acquire);
 }
 
 static void
 cqpsk_toggle_test_restore(const CqpskToggleTestSnapshot* s, int initialized_output) {
-    demod.cqpsk_enable = s->cqpsk;
-    demod.output_kind = s->output_kind;
-    demod.symbol_rate_hz = s->symbol_rate_hz;
-    demod.symbol_levels = s->symbol_levels;
-    demod.ted_enabled = s->ted_enabled;
-    demod.channel_lpf_profile = s->channel_lpf_profile;
-    demod.costas_reset_pending = s->costas_reset_pending;
-    demod.mode_demod = s->mode_demod;
-    demod.cqpsk_diff_prev_r = s->cqpsk_diff_prev_r;
-    demod.cqpsk_diff_prev_j = s->cqpsk_diff_prev_j;
-    demod.fsk_modem_state = s->modem;
-    g_stream = s->stream;
-    controller.retune_in_progress.store(s->retune_in_progress, std::memory_order_release);
-    g_fsk_modem_reset_pending.store(s->reset_pending, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.demod.cqpsk_enable = s->cqpsk;
+    rtl.demod.output_kind = s->output_kind;
+    rtl.demod.symbol_rate_hz = s->symbol_rate_hz;
+    rtl.demod.symbol_levels = s->symbol_levels;
+    rtl.demod.ted_enabled = s->ted_enabled;
+    rtl.demod.channel_lpf_profile = s->channel_lpf_profile;
+    rtl.demod.costas_reset_pending = s->costas_reset_pending;
+    rtl.demod.mode_demod = s->mode_demod;
+    rtl.demod.cqpsk_diff_prev_r = s->cqpsk_diff_prev_r;
+    rtl.demod.cqpsk_diff_prev_j = s->cqpsk_diff_prev_j;
+    rtl.demod.fsk_modem_state = s->modem;
+    rtl.internals = s->stream;
+    rtl.controller.retune_in_progress.store(s->retune_in_progress, std::memory_order_release);
+    rtl.fsk_modem_reset_pending.store(s->reset_pending, std::memory_order_release);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(s->cache_pending);
     if (initialized_output) {
-        ring_clear(&output);
+        ring_clear(&rtl.output);
     } else {
-        output.head.store(s->output_head, std::memory_order_release);
-        output.tail.store(s->output_tail, std::memory_order_release);
+        rtl.output.reset(s->output_head, s->output_tail);
     }
 }
 
 static void
 cqpsk_toggle_test_configure_stream(int active_rtl_digital) {
+    dsd_rtl_stream& rtl = rtl_cur();
     static dsd_opts test_opts;
     DSD_MEMSET(&test_opts, 0, sizeof(test_opts));
     if (!active_rtl_digital) {
-        g_stream = NULL;
+        rtl.internals = NULL;
         return;
     }
     test_opts.frame_p25p1 = 1;
-    g_cqpsk_toggle_test_stream.output = &output;
+    g_cqpsk_toggle_test_stream.output = &rtl.output;
     g_cqpsk_toggle_test_stream.opts = &test_opts;
     g_cqpsk_toggle_test_stream.should_exit.store(0, std::memory_order_release);
     g_cqpsk_toggle_test_stream.async_started.store(0, std::memory_order_release);
     g_cqpsk_toggle_test_stream.demod_thread_started.store(0, std::memory_order_release);
     g_cqpsk_toggle_test_stream.controller_thread_started.store(0, std::memory_order_release);
-    g_stream = &g_cqpsk_toggle_test_stream;
+    rtl.internals = &g_cqpsk_toggle_test_stream;
 }
 
 static void
 cqpsk_toggle_test_configure_demod(int start_cqpsk) {
-    demod.cqpsk_enable = start_cqpsk ? 1 : 0;
-    demod.output_kind = start_cqpsk ? DSD_DEMOD_OUTPUT_SYMBOL_CQPSK : DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
-    demod.symbol_rate_hz = 4800;
-    demod.symbol_levels = 4;
-    demod.ted_enabled = start_cqpsk ? 1 : 0;
-    demod.channel_lpf_profile = start_cqpsk ? DSD_CH_LPF_PROFILE_P25_CQPSK : DSD_CH_LPF_PROFILE_P25_C4FM;
-    demod.costas_reset_pending = 0;
-    demod.mode_demod = start_cqpsk ? &qpsk_differential_demod : &dsd_fm_demod;
-    demod.cqpsk_diff_prev_r = start_cqpsk ? 0.25f : 1.0f;
-    demod.cqpsk_diff_prev_j = start_cqpsk ? -0.25f : 0.0f;
-    demod.fsk_modem_state.have_prev = 1;
+    dsd_rtl_stream& rtl = rtl_cur();
+    rtl.demod.cqpsk_enable = start_cqpsk ? 1 : 0;
+    rtl.demod.output_kind = start_cqpsk ? DSD_DEMOD_OUTPUT_SYMBOL_CQPSK : DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
+    rtl.demod.symbol_rate_hz = 4800;
+    rtl.demod.symbol_levels = 4;
+    rtl.demod.ted_enabled = start_cqpsk ? 1 : 0;
+    rtl.demod.channel_lpf_profile = start_cqpsk ? DSD_CH_LPF_PROFILE_P25_CQPSK : DSD_CH_LPF_PROFILE_P25_C4FM;
+    rtl.demod.costas_reset_pending = 0;
+    rtl.demod.mode_demod = start_cqpsk ? &qpsk_differential_demod : &dsd_fm_demod;
+    rtl.demod.cqpsk_diff_prev_r = start_cqpsk ? 0.25f : 1.0f;
+    rtl.demod.cqpsk_diff_prev_j = start_cqpsk ? -0.25f : 0.0f;
+    rtl.demod.fsk_modem_state.have_prev = 1;
 }
 
 static void
 cqpsk_toggle_test_seed_output(size_t queued_samples, int cached_symbols) {
-    ring_clear(&output);
-    output.tail.store(0, std::memory_order_release);
-    output.head.store(queued_samples, std::memory_order_release);
+    dsd_rtl_stream& rtl = rtl_cur();
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(cached_symbols);
 }
 
 static void
 cqpsk_toggle_test_collect(rtl_stream_test_cqpsk_toggle_result* out_result) {
+    dsd_rtl_stream& rtl = rtl_cur();
     out_result->generation_after = rtl_stream_output_generation();
-    out_result->used_after = ring_used(&output);
+    out_result->used_after = ring_used(&rtl.output);
     out_result->cache_pending_after = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
-    out_result->output_kind_after = demod.output_kind;
-    out_result->fsk_reset_pending_after_toggle = g_fsk_modem_reset_pending.load(std::memory_order_acquire);
-    out_result->reset_consumed = rtl_stream_consume_fsk_modem_reset_pending(&demod);
-    out_result->have_prev_after_consume = demod.fsk_modem_state.have_prev;
+    out_result->output_kind_after = rtl.demod.output_kind;
+    out_result->fsk_reset_pending_after_toggle = rtl.fsk_modem_reset_pending.load(std::memory_order_acquire);
+    out_result->reset_consumed = rtl_stream_consume_fsk_modem_reset_pending(&rtl.demod);
+    out_result->have_prev_after_consume = rtl.demod.fsk_modem_state.have_prev;
 }
 
 extern "C" int
@@ -8901,38 +9262,39 @@ rtl_stream_test_cqpsk_toggle_output_clear(int start_cqpsk, int target_cqpsk, int
 extern "C" int
 rtl_stream_test_fsk_cfo_snapshot(double dc_rad_per_sample, int rate_out_hz, double* out_cfo_hz,
                                  int* out_after_generation_bump_available, int* out_after_reset_available) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_cfo_hz || !out_after_generation_bump_available || !out_after_reset_available) {
         return -1;
     }
 
-    int prev_cqpsk = demod.cqpsk_enable;
-    int prev_output_kind = demod.output_kind;
-    int prev_rate_out = demod.rate_out;
-    dsd_fsk_modem_state prev_modem = demod.fsk_modem_state;
-    int prev_reset_pending = g_fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
+    int prev_cqpsk = rtl.demod.cqpsk_enable;
+    int prev_output_kind = rtl.demod.output_kind;
+    int prev_rate_out = rtl.demod.rate_out;
+    dsd_fsk_modem_state prev_modem = rtl.demod.fsk_modem_state;
+    int prev_reset_pending = rtl.fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
 
-    demod.cqpsk_enable = 0;
-    demod.output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
-    demod.rate_out = rate_out_hz;
-    demod.fsk_modem_state.have_prev = 1;
-    demod.fsk_modem_state.dc_est = (float)dc_rad_per_sample;
-    rtl_stream_publish_fsk_phase_cfo_snapshot(&demod);
+    rtl.demod.cqpsk_enable = 0;
+    rtl.demod.output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
+    rtl.demod.rate_out = rate_out_hz;
+    rtl.demod.fsk_modem_state.have_prev = 1;
+    rtl.demod.fsk_modem_state.dc_est = (float)dc_rad_per_sample;
+    rtl_stream_publish_fsk_phase_cfo_snapshot(&rtl.demod);
 
     int available_before = auto_ppm_fsk_phase_cfo_hz(out_cfo_hz);
     double after_generation_bump_cfo_hz = 0.0;
     (void)rtl_stream_bump_output_generation();
     *out_after_generation_bump_available = auto_ppm_fsk_phase_cfo_hz(&after_generation_bump_cfo_hz);
-    rtl_stream_publish_fsk_phase_cfo_snapshot(&demod);
+    rtl_stream_publish_fsk_phase_cfo_snapshot(&rtl.demod);
     rtl_stream_queue_fsk_modem_reset();
-    (void)rtl_stream_consume_fsk_modem_reset_pending(&demod);
+    (void)rtl_stream_consume_fsk_modem_reset_pending(&rtl.demod);
     double after_reset_cfo_hz = 0.0;
     *out_after_reset_available = auto_ppm_fsk_phase_cfo_hz(&after_reset_cfo_hz);
 
-    demod.cqpsk_enable = prev_cqpsk;
-    demod.output_kind = prev_output_kind;
-    demod.rate_out = prev_rate_out;
-    demod.fsk_modem_state = prev_modem;
-    g_fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
+    rtl.demod.cqpsk_enable = prev_cqpsk;
+    rtl.demod.output_kind = prev_output_kind;
+    rtl.demod.rate_out = prev_rate_out;
+    rtl.demod.fsk_modem_state = prev_modem;
+    rtl.fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
     rtl_stream_invalidate_fsk_phase_cfo_snapshot();
     return available_before ? 0 : -2;
 }
@@ -8951,6 +9313,7 @@ rtl_stream_test_fsk_snr_sps(int rate_out_hz, int symbol_rate_hz, int stale_ted_s
 extern "C" int
 rtl_stream_test_direct_output_rate_after_open_update(int output_kind, int rate_out_hz, int resamp_target_hz,
                                                      unsigned int* out_rate_hz, int* out_resamp_enabled) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_rate_hz || !out_resamp_enabled) {
         return -1;
     }
@@ -8958,37 +9321,37 @@ rtl_stream_test_direct_output_rate_after_open_update(int output_kind, int rate_o
         return -2;
     }
 
-    int prev_output_kind = demod.output_kind;
-    int prev_rate_out = demod.rate_out;
-    int prev_resamp_target_hz = demod.resamp_target_hz;
-    int prev_resamp_enabled = demod.resamp_enabled;
-    int prev_resamp_l = demod.resamp_L;
-    int prev_resamp_m = demod.resamp_M;
-    int prev_resamp_phase = demod.resamp_phase;
-    unsigned int prev_output_rate = output.rate;
-
-    demod.output_kind = output_kind;
-    demod.rate_out = rate_out_hz;
-    demod.resamp_target_hz = resamp_target_hz;
-    demod.resamp_enabled = 0;
-    demod.resamp_L = 1;
-    demod.resamp_M = 1;
-    demod.resamp_phase = 0;
-    output.rate = 0U;
+    int prev_output_kind = rtl.demod.output_kind;
+    int prev_rate_out = rtl.demod.rate_out;
+    int prev_resamp_target_hz = rtl.demod.resamp_target_hz;
+    int prev_resamp_enabled = rtl.demod.resamp_enabled;
+    int prev_resamp_l = rtl.demod.resamp_L;
+    int prev_resamp_m = rtl.demod.resamp_M;
+    int prev_resamp_phase = rtl.demod.resamp_phase;
+    unsigned int prev_output_rate = rtl.output.rate;
+
+    rtl.demod.output_kind = output_kind;
+    rtl.demod.rate_out = rate_out_hz;
+    rtl.demod.resamp_target_hz = resamp_target_hz;
+    rtl.demod.resamp_enabled = 0;
+    rtl.demod.resamp_L = 1;
+    rtl.demod.resamp_M = 1;
+    rtl.demod.resamp_phase = 0;
+    rtl.output.rate = 0U;
 
     stream_open_configure_resampler_chain();
     stream_open_update_output_rates();
-    *out_rate_hz = output.rate;
-    *out_resamp_enabled = demod.resamp_enabled;
-
-    demod.output_kind = prev_output_kind;
-    demod.rate_out = prev_rate_out;
-    demod.resamp_target_hz = prev_resamp_target_hz;
-    demod.resamp_enabled = prev_resamp_enabled;
-    demod.resamp_L = prev_resamp_l;
-    demod.resamp_M = prev_resamp_m;
-    demod.resamp_phase = prev_resamp_phase;
-    output.rate = prev_output_rate;
+    *out_rate_hz = rtl.output.rate;
+    *out_resamp_enabled = rtl.demod.resamp_enabled;
+
+    rtl.demod.output_kind = prev_output_kind;
+    rtl.demod.rate_out = prev_rate_out;
+    rtl.demod.resamp_target_hz = prev_resamp_target_hz;
+    rtl.demod.resamp_enabled = prev_resamp_enabled;
+    rtl.demod.resamp_L = prev_resamp_l;
+    rtl.demod.resamp_M = prev_resamp_m;
+    rtl.demod.resamp_phase = prev_resamp_phase;
+    rtl.output.rate = prev_output_rate;
     return 0;
 }
 
@@ -9001,50 +9364,51 @@ extern "C" int
 rtl_stream_test_digital_resample_chain(int output_kind, int rate_out_hz, int resamp_target_hz, int symbol_rate_hz,
                                        int digital_resample_mode, int capture_rate_device_forced,
                                        unsigned int* out_rate_hz, int* out_resamp_enabled) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_rate_hz || !out_resamp_enabled) {
         return -1;
     }
 
-    const int prev_output_kind = demod.output_kind;
-    const int prev_rate_out = demod.rate_out;
-    const int prev_resamp_target_hz = demod.resamp_target_hz;
-    const int prev_resamp_enabled = demod.resamp_enabled;
-    const int prev_resamp_l = demod.resamp_L;
-    const int prev_resamp_m = demod.resamp_M;
-    const int prev_resamp_phase = demod.resamp_phase;
-    const int prev_symbol_rate = demod.symbol_rate_hz;
-    const int prev_mode = demod.digital_resample_mode;
-    const int prev_forced = demod.capture_rate_device_forced;
-    const unsigned int prev_output_rate = output.rate;
-
-    demod.output_kind = (dsd_demod_output_kind)output_kind;
-    demod.rate_out = rate_out_hz;
-    demod.resamp_target_hz = resamp_target_hz;
-    demod.symbol_rate_hz = symbol_rate_hz;
-    demod.digital_resample_mode = digital_resample_mode;
-    demod.capture_rate_device_forced = capture_rate_device_forced;
-    demod.resamp_enabled = 0;
-    demod.resamp_L = 1;
-    demod.resamp_M = 1;
-    demod.resamp_phase = 0;
-    output.rate = 0U;
+    const int prev_output_kind = rtl.demod.output_kind;
+    const int prev_rate_out = rtl.demod.rate_out;
+    const int prev_resamp_target_hz = rtl.demod.resamp_target_hz;
+    const int prev_resamp_enabled = rtl.demod.resamp_enabled;
+    const int prev_resamp_l = rtl.demod.resamp_L;
+    const int prev_resamp_m = rtl.demod.resamp_M;
+    const int prev_resamp_phase = rtl.demod.resamp_phase;
+    const int prev_symbol_rate = rtl.demod.symbol_rate_hz;
+    const int prev_mode = rtl.demod.digital_resample_mode;
+    const int prev_forced = rtl.demod.capture_rate_device_forced;
+    const unsigned int prev_output_rate = rtl.output.rate;
+
+    rtl.demod.output_kind = (dsd_demod_output_kind)output_kind;
+    rtl.demod.rate_out = rate_out_hz;
+    rtl.demod.resamp_target_hz = resamp_target_hz;
+    rtl.demod.symbol_rate_hz = symbol_rate_hz;
+    rtl.demod.digital_resample_mode = digital_resample_mode;
+    rtl.demod.capture_rate_device_forced = capture_rate_device_forced;
+    rtl.demod.resamp_enabled = 0;
+    rtl.demod.resamp_L = 1;
+    rtl.demod.resamp_M = 1;
+    rtl.demod.resamp_phase = 0;
+    rtl.output.rate = 0U;
 
     stream_open_configure_resampler_chain();
     stream_open_update_output_rates();
-    *out_rate_hz = output.rate;
-    *out_resamp_enabled = demod.resamp_enabled;
-
-    demod.output_kind = (dsd_demod_output_kind)prev_output_kind;
-    demod.rate_out = prev_rate_out;
-    demod.resamp_target_hz = prev_resamp_target_hz;
-    demod.resamp_enabled = prev_resamp_enabled;
-    demod.resamp_L = prev_resamp_l;
-    demod.resamp_M = prev_resamp_m;
-    demod.resamp_phase = prev_resamp_phase;
-    demod.symbol_rate_hz = prev_symbol_rate;
-    demod.digital_resample_mode = prev_mode;
-    demod.capture_rate_device_forced = prev_forced;
-    output.rate = prev_output_rate;
+    *out_rate_hz = rtl.output.rate;
+    *out_resamp_enabled = rtl.demod.resamp_enabled;
+
+    rtl.demod.output_kind = (dsd_demod_output_kind)prev_output_kind;
+    rtl.demod.rate_out = prev_rate_out;
+    rtl.demod.resamp_target_hz = prev_resamp_target_hz;
+    rtl.demod.resamp_enabled = prev_resamp_enabled;
+    rtl.demod.resamp_L = prev_resamp_l;
+    rtl.demod.resamp_M = prev_resamp_m;
+    rtl.demod.resamp_phase = prev_resamp_phase;
+    rtl.demod.symbol_rate_hz = prev_symbol_rate;
+    rtl.demod.digital_resample_mode = prev_mode;
+    rtl.demod.capture_rate_device_forced = prev_forced;
+    rtl.output.rate = prev_output_rate;
     return 0;
 }
 
@@ -9117,6 +9481,7 @@ extern "C" int
 rtl_stream_test_source_policy_matrix(int* out_kind, int* out_rtltcp, int* out_soapy, int* out_replay, int* out_family,
                                      size_t count, char* out_names, size_t names_size, char* out_soapy_args,
                                      size_t args_size) {
+    dsd_rtl_stream& rtl = rtl_cur();
     RtlSourcePolicyMatrixOut out = {out_kind, out_rtltcp, out_soapy, out_replay, out_family, out_names, names_size};
     if (!rtl_test_source_policy_args_valid(&out, count, out_soapy_args, args_size)) {
         return -1;
@@ -9126,13 +9491,13 @@ rtl_stream_test_source_policy_matrix(int* out_kind, int* out_rtltcp, int* out_so
         NULL,   "", "rtltcp", "rtltcp:127.0.0.1:1234", "soapy", "soapy:driver=rtlsdr", "iqreplay:/tmp/capture.iq.json",
         "rtl:0"};
 
-    struct RtlSdrInternals* prev_stream = g_stream;
+    struct RtlSdrInternals* prev_stream = rtl.internals;
     static RtlSdrInternals test_stream;
     DSD_MEMSET(&test_stream, 0, sizeof(test_stream));
     static dsd_opts opts;
     DSD_MEMSET(&opts, 0, sizeof(opts));
     test_stream.opts = &opts;
-    g_stream = &test_stream;
+    rtl.internals = &test_stream;
 
     out_names[0] = '\0';
     for (size_t i = 0U; i < sizeof specs / sizeof specs[0]; i++) {
@@ -9140,7 +9505,7 @@ rtl_stream_test_source_policy_matrix(int* out_kind, int* out_rtltcp, int* out_so
     }
     rtl_test_write_soapy_args(out_soapy_args, args_size);
 
-    g_stream = prev_stream;
+    rtl.internals = prev_stream;
     return 0;
 }
 
@@ -9203,6 +9568,7 @@ rtl_stream_test_mode_policy_matrix(int* out_values, size_t count) {
 
 extern "C" int
 rtl_stream_test_fsk_profile_policy_matrix(int* out_profiles, size_t count) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_profiles || count < 21U) {
         return -1;
     }
@@ -9249,52 +9615,53 @@ rtl_stream_test_fsk_profile_policy_matrix(int* out_profiles, size_t count) {
     out_profiles[16] = rtl_stream_fsk_profile_for_symbol_rate(4800, 4);
     out_profiles[17] = rtl_stream_fsk_profile_for_symbol_rate(1200, 4);
 
-    struct RtlSdrInternals* prev_stream = g_stream;
+    struct RtlSdrInternals* prev_stream = rtl.internals;
     static RtlSdrInternals test_stream;
     DSD_MEMSET(&test_stream, 0, sizeof(test_stream));
-    int prev_symbol_rate = demod.symbol_rate_hz;
-    int prev_symbol_levels = demod.symbol_levels;
+    int prev_symbol_rate = rtl.demod.symbol_rate_hz;
+    int prev_symbol_levels = rtl.demod.symbol_levels;
 
     DSD_MEMSET(&opts, 0, sizeof(opts));
     opts.frame_provoice = 1;
     test_stream.opts = &opts;
-    g_stream = &test_stream;
-    demod.symbol_rate_hz = 9600;
-    demod.symbol_levels = 4;
+    rtl.internals = &test_stream;
+    rtl.demod.symbol_rate_hz = 9600;
+    rtl.demod.symbol_levels = 4;
     out_profiles[18] = rtl_stream_fsk_channel_profile_for_current_mode();
 
-    g_stream = NULL;
-    demod.symbol_rate_hz = 4800;
-    demod.symbol_levels = 2;
+    rtl.internals = NULL;
+    rtl.demod.symbol_rate_hz = 4800;
+    rtl.demod.symbol_levels = 2;
     out_profiles[19] = rtl_stream_fsk_channel_profile_for_current_mode();
-    demod.symbol_rate_hz = 0;
-    demod.symbol_levels = 0;
+    rtl.demod.symbol_rate_hz = 0;
+    rtl.demod.symbol_levels = 0;
     out_profiles[20] = rtl_stream_fsk_channel_profile_for_current_mode();
 
-    demod.symbol_rate_hz = prev_symbol_rate;
-    demod.symbol_levels = prev_symbol_levels;
-    g_stream = prev_stream;
+    rtl.demod.symbol_rate_hz = prev_symbol_rate;
+    rtl.demod.symbol_levels = prev_symbol_levels;
+    rtl.internals = prev_stream;
     return 0;
 }
 
 static void
 fsk_reacquire_test_cleanup_output_ring(int initialized_output) {
     if (initialized_output) {
-        output_cleanup(&output);
+        output_cleanup(&rtl_cur().output);
     }
 }
 
 static int
 fsk_reacquire_test_prepare_output_ring(size_t queued_samples, int* initialized_output) {
+    dsd_rtl_stream& rtl = rtl_cur();
     *initialized_output = 0;
-    if (!output.buffer) {
-        output_init(&output);
+    if (!rtl.output.buffer) {
+        output_init(&rtl.output);
         *initialized_output = 1;
     }
-    if (!output.buffer || output.capacity == 0U) {
+    if (!rtl.output.buffer || rtl.output.capacity == 0U) {
         return -2;
     }
-    if (queued_samples >= output.capacity) {
+    if (queued_samples >= rtl.output.capacity) {
         return -3;
     }
     return 0;
@@ -9302,13 +9669,13 @@ fsk_reacquire_test_prepare_output_ring(size_t queued_samples, int* initialized_o
 
 static void
 fsk_reacquire_test_reset_output_state(void) {
-    ring_clear(&output);
+    ring_clear(&rtl_cur().output);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
 }
 
 static int
 fsk_reacquire_test_request_state_valid(size_t queued_samples, int cached_symbols, uint32_t generation_before) {
-    size_t used_after_request = ring_used(&output);
+    size_t used_after_request = ring_used(&rtl_cur().output);
     int cache_after_request = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
     uint32_t generation_after_request = rtl_stream_output_generation();
     return (used_after_request == queued_samples && cache_after_request == cached_symbols
@@ -9321,6 +9688,7 @@ extern "C" int
 rtl_stream_test_fsk_reacquire(int output_kind, size_t queued_samples, int cached_symbols, size_t* out_used_after,
                               int* out_cache_pending_after, uint32_t* out_generation_before,
                               uint32_t* out_generation_after, int* out_request_rc, int* out_consumed) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_used_after || !out_cache_pending_after || !out_generation_before || !out_generation_after
         || !out_request_rc || !out_consumed || cached_symbols < 0) {
         return -1;
@@ -9333,16 +9701,15 @@ rtl_stream_test_fsk_reacquire(int output_kind, size_t queued_samples, int cached
         return prepare_rc;
     }
 
-    int prev_output_kind = demod.output_kind;
-    dsd_fsk_modem_state prev_modem = demod.fsk_modem_state;
-    demod.output_kind = output_kind;
-    demod.fsk_modem_state.have_prev = 1;
-    int prev_reacquire_pending = g_fsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
-    int prev_reset_pending = g_fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
+    int prev_output_kind = rtl.demod.output_kind;
+    dsd_fsk_modem_state prev_modem = rtl.demod.fsk_modem_state;
+    rtl.demod.output_kind = output_kind;
+    rtl.demod.fsk_modem_state.have_prev = 1;
+    int prev_reacquire_pending = rtl.fsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
+    int prev_reset_pending = rtl.fsk_modem_reset_pending.exchange(0, std::memory_order_acq_rel);
 
-    ring_clear(&output);
-    output.tail.store(0);
-    output.head.store(queued_samples);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(cached_symbols);
 
@@ -9350,23 +9717,23 @@ rtl_stream_test_fsk_reacquire(int output_kind, size_t queued_samples, int cached
     *out_request_rc = rtl_stream_request_fsk_reacquire();
     if (*out_request_rc > 0
         && !fsk_reacquire_test_request_state_valid(queued_samples, cached_symbols, *out_generation_before)) {
-        demod.output_kind = prev_output_kind;
-        demod.fsk_modem_state = prev_modem;
-        g_fsk_reacquire_pending.store(prev_reacquire_pending, std::memory_order_release);
-        g_fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
+        rtl.demod.output_kind = prev_output_kind;
+        rtl.demod.fsk_modem_state = prev_modem;
+        rtl.fsk_reacquire_pending.store(prev_reacquire_pending, std::memory_order_release);
+        rtl.fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
         fsk_reacquire_test_reset_output_state();
         fsk_reacquire_test_cleanup_output_ring(initialized_output);
         return -5;
     }
-    *out_consumed = rtl_stream_consume_fsk_reacquire_pending(&demod);
+    *out_consumed = rtl_stream_consume_fsk_reacquire_pending(&rtl.demod);
     *out_generation_after = rtl_stream_output_generation();
-    *out_used_after = ring_used(&output);
+    *out_used_after = ring_used(&rtl.output);
     *out_cache_pending_after = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
 
-    demod.output_kind = prev_output_kind;
-    demod.fsk_modem_state = prev_modem;
-    g_fsk_reacquire_pending.store(prev_reacquire_pending, std::memory_order_release);
-    g_fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
+    rtl.demod.output_kind = prev_output_kind;
+    rtl.demod.fsk_modem_state = prev_modem;
+    rtl.fsk_reacquire_pending.store(prev_reacquire_pending, std::memory_order_release);
+    rtl.fsk_modem_reset_pending.store(prev_reset_pending, std::memory_order_release);
     fsk_reacquire_test_reset_output_state();
     fsk_reacquire_test_cleanup_output_ring(initialized_output);
     return 0;
@@ -9409,7 +9776,7 @@ static void
 cqpsk_reacquire_test_capture_result(const struct demod_state* test_demod,
                                     rtl_stream_test_cqpsk_reacquire_result* out_result) {
     out_result->generation_after = rtl_stream_output_generation();
-    out_result->used_after = ring_used(&output);
+    out_result->used_after = ring_used(&rtl_cur().output);
     out_result->cache_pending_after = dsd_rtl_stream_metrics_hook_symbol_cache_pending();
     out_result->fll_freq_after = test_demod->fll_band_edge_state.freq;
     out_result->fll_phase_after = test_demod->fll_band_edge_state.phase;
@@ -9437,6 +9804,7 @@ cqpsk_reacquire_test_capture_result(const struct demod_state* test_demod,
 extern "C" int
 rtl_stream_test_cqpsk_reacquire(int active_cqpsk, int symbol_rate_hz, int ted_sps, size_t queued_samples,
                                 int cached_symbols, rtl_stream_test_cqpsk_reacquire_result* out_result) {
+    dsd_rtl_stream& rtl = rtl_cur();
     if (!out_result || symbol_rate_hz <= 0 || ted_sps < 2 || cached_symbols < 0) {
         return -1;
     }
@@ -9452,18 +9820,17 @@ rtl_stream_test_cqpsk_reacquire(int active_cqpsk, int symbol_rate_hz, int ted_sp
     static struct demod_state test_demod;
     cqpsk_reacquire_test_init_demod(&test_demod, active_cqpsk, symbol_rate_hz, ted_sps);
 
-    const int prev_output_kind = demod.output_kind;
-    const int prev_cqpsk = demod.cqpsk_enable;
-    struct RtlSdrInternals* prev_stream = g_stream;
-    const int prev_pending = g_cqpsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
-    demod.output_kind = test_demod.output_kind;
-    demod.cqpsk_enable = test_demod.cqpsk_enable;
+    const int prev_output_kind = rtl.demod.output_kind;
+    const int prev_cqpsk = rtl.demod.cqpsk_enable;
+    struct RtlSdrInternals* prev_stream = rtl.internals;
+    const int prev_pending = rtl.cqpsk_reacquire_pending.exchange(0, std::memory_order_acq_rel);
+    rtl.demod.output_kind = test_demod.output_kind;
+    rtl.demod.cqpsk_enable = test_demod.cqpsk_enable;
     rtl_stream_publish_demod_profile_snapshot();
-    g_stream = NULL;
+    rtl.internals = NULL;
 
-    ring_clear(&output);
-    output.tail.store(0, std::memory_order_release);
-    output.head.store(queued_samples, std::memory_order_release);
+    ring_clear(&rtl.output);
+    rtl.output.reset(queued_samples);
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
     dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(cached_symbols);
 
@@ -9474,11 +9841,11 @@ rtl_stream_test_cqpsk_reacquire(int active_cqpsk, int symbol_rate_hz, int ted_sp
     out_result->second_request_rc = rtl_stream_request_cqpsk_reacquire();
     if (out_result->request_rc > 0
         && !fsk_reacquire_test_request_state_valid(queued_samples, cached_symbols, out_result->generation_before)) {
-        demod.output_kind = prev_output_kind;
-        demod.cqpsk_enable = prev_cqpsk;
+        rtl.demod.output_kind = prev_output_kind;
+        rtl.demod.cqpsk_enable = prev_cqpsk;
         rtl_stream_publish_demod_profile_snapshot();
-        g_stream = prev_stream;
-        g_cqpsk_reacquire_pending.store(prev_pending, std::memory_order_release);
+        rtl.internals = prev_stream;
+        rtl.cqpsk_reacquire_pending.store(prev_pending, std::memory_order_release);
         fsk_reacquire_test_reset_output_state();
         fsk_reacquire_test_cleanup_output_ring(initialized_output);
         return -5;
@@ -9488,11 +9855,11 @@ rtl_stream_test_cqpsk_reacquire(int active_cqpsk, int symbol_rate_hz, int ted_sp
     out_result->second_consumed = rtl_stream_consume_cqpsk_reacquire_pending(&test_demod);
     cqpsk_reacquire_test_capture_result(&test_demod, out_result);
 
-    demod.output_kind = prev_output_kind;
-    demod.cqpsk_enable = prev_cqpsk;
+    rtl.demod.output_kind = prev_output_kind;
+    rtl.demod.cqpsk_enable = prev_cqpsk;
     rtl_stream_publish_demod_profile_snapshot();
-    g_stream = prev_stream;
-    g_cqpsk_reacquire_pending.store(prev_pending, std::memory_order_release);
+    rtl.internals = prev_stream;
+    rtl.cqpsk_reacquire_pending.store(prev_pending, std::memory_order_release);
     fsk_reacquire_test_reset_output_state();
     fsk_reacquire_test_cleanup_output_ring(initialized_output);
     return 0;
@@ -9563,11 +9930,12 @@ rtl_stream_test_fll_retune_cache_round_trip(rtl_stream_test_fll_retune_cache_res
 
 extern "C" int
 dsd_rtl_stream_test_retune_without_controller_rejected(void) {
-    RtlSdrInternals* previous_stream = g_stream;
+    dsd_rtl_stream& rtl = rtl_cur();
+    RtlSdrInternals* previous_stream = rtl.internals;
     g_cqpsk_toggle_test_stream.controller_thread_started.store(0, std::memory_order_release);
-    g_stream = &g_cqpsk_toggle_test_stream;
-    uint32_t request_id = schedule_manual_retune_on_controller(&controller, 855000000U);
-    g_stream = previous_stream;
+    rtl.internals = &g_cqpsk_toggle_test_stream;
+    uint32_t request_id = schedule_manual_retune_on_controller(&rtl.controller, 855000000U);
+    rtl.internals = previous_stream;
     return request_id == 0U ? 1 : 0;
 }
 
@@ -9775,30 +10143,32 @@ rtl_stream_test_retune_profile_gain_binding(int* out_gain_is_set, int* out_gain_
 
 extern "C" int
 dsd_rtl_stream_test_get_replay_state(rtl_stream_test_replay_state* out_state) {
-    if (!out_state || !g_stream) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!out_state || !rtl.internals) {
         return -1;
     }
 
-    out_state->replay_input_eof = g_stream->replay_input_eof.load(std::memory_order_acquire);
-    out_state->replay_input_drained = g_stream->replay_input_drained.load(std::memory_order_acquire);
-    out_state->replay_demod_drained = g_stream->replay_demod_drained.load(std::memory_order_acquire);
-    out_state->replay_output_drained = g_stream->replay_output_drained.load(std::memory_order_acquire);
-    out_state->replay_forced_stop = g_stream->replay_forced_stop.load(std::memory_order_acquire);
-    out_state->should_exit = g_stream->should_exit.load(std::memory_order_acquire);
-    out_state->replay_last_submit_gen = g_stream->replay_last_submit_gen.load(std::memory_order_acquire);
-    out_state->replay_last_submit_gen_at_eof = g_stream->replay_last_submit_gen_at_eof.load(std::memory_order_acquire);
-    out_state->replay_last_consume_gen = g_stream->replay_last_consume_gen.load(std::memory_order_acquire);
-    out_state->input_ring_used = input_ring_used(&input_ring);
-    out_state->output_ring_used = ring_used(&output);
-    out_state->replay_event_retune_count = g_replay_event_retune_count.load(std::memory_order_acquire);
-    out_state->replay_event_mute_count = g_replay_event_mute_count.load(std::memory_order_acquire);
-    out_state->replay_event_reset_count = g_replay_event_reset_count.load(std::memory_order_acquire);
-    out_state->replay_event_last_frequency_hz = g_replay_event_last_frequency_hz.load(std::memory_order_acquire);
-    out_state->replay_event_last_mute_bytes = g_replay_event_last_mute_bytes.load(std::memory_order_acquire);
-    out_state->replay_event_last_reset_reason = g_replay_event_last_reset_reason.load(std::memory_order_acquire);
-    out_state->replay_loop_restart_count = g_replay_loop_restart_count.load(std::memory_order_acquire);
+    out_state->replay_input_eof = rtl.internals->replay_input_eof.load(std::memory_order_acquire);
+    out_state->replay_input_drained = rtl.internals->replay_input_drained.load(std::memory_order_acquire);
+    out_state->replay_demod_drained = rtl.internals->replay_demod_drained.load(std::memory_order_acquire);
+    out_state->replay_output_drained = rtl.internals->replay_output_drained.load(std::memory_order_acquire);
+    out_state->replay_forced_stop = rtl.internals->replay_forced_stop.load(std::memory_order_acquire);
+    out_state->should_exit = rtl.internals->should_exit.load(std::memory_order_acquire);
+    out_state->replay_last_submit_gen = rtl.internals->replay_last_submit_gen.load(std::memory_order_acquire);
+    out_state->replay_last_submit_gen_at_eof =
+        rtl.internals->replay_last_submit_gen_at_eof.load(std::memory_order_acquire);
+    out_state->replay_last_consume_gen = rtl.internals->replay_last_consume_gen.load(std::memory_order_acquire);
+    out_state->input_ring_used = input_ring_used(&rtl.input_ring);
+    out_state->output_ring_used = ring_used(&rtl.output);
+    out_state->replay_event_retune_count = rtl.replay_event_retune_count.load(std::memory_order_acquire);
+    out_state->replay_event_mute_count = rtl.replay_event_mute_count.load(std::memory_order_acquire);
+    out_state->replay_event_reset_count = rtl.replay_event_reset_count.load(std::memory_order_acquire);
+    out_state->replay_event_last_frequency_hz = rtl.replay_event_last_frequency_hz.load(std::memory_order_acquire);
+    out_state->replay_event_last_mute_bytes = rtl.replay_event_last_mute_bytes.load(std::memory_order_acquire);
+    out_state->replay_event_last_reset_reason = rtl.replay_event_last_reset_reason.load(std::memory_order_acquire);
+    out_state->replay_loop_restart_count = rtl.replay_loop_restart_count.load(std::memory_order_acquire);
     out_state->replay_loop_restart_last_frequency_hz =
-        g_replay_loop_restart_last_frequency_hz.load(std::memory_order_acquire);
+        rtl.replay_loop_restart_last_frequency_hz.load(std::memory_order_acquire);
     return 0;
 }
 
@@ -9814,7 +10184,7 @@ rtl_stream_get_last_applied_freq(uint32_t* out_freq_hz) {
     if (!out_freq_hz) {
         return -1;
     }
-    *out_freq_hz = controller.last_applied_freq_hz.load(std::memory_order_acquire);
+    *out_freq_hz = rtl_cur().controller.last_applied_freq_hz.load(std::memory_order_acquire);
     return 0;
 }
 
@@ -9828,7 +10198,7 @@ extern "C" double
 dsd_rtl_stream_return_pwr(void) {
     /* demod.channel_pwr belongs to the demod thread; read the published
      * atomic mirror instead of the struct field to avoid a data race. */
-    return (double)g_channel_pwr.load(std::memory_order_relaxed);
+    return (double)rtl_cur().shared.channel_pwr.load(std::memory_order_relaxed);
 }
 
 /**
@@ -9836,7 +10206,7 @@ dsd_rtl_stream_return_pwr(void) {
  */
 extern "C" void
 rtl_stream_set_channel_squelch(float level) {
-    demod.channel_squelch_level = level;
+    rtl_cur().demod.channel_squelch_level = level;
 }
 
 /**
@@ -9849,8 +10219,8 @@ rtl_stream_signal_output_waiters(struct output_state* outp) {
     }
     dsd_mutex_lock(&outp->ready_m);
     dsd_cond_broadcast(&outp->space);
-    dsd_cond_broadcast(&outp->ready);
     dsd_mutex_unlock(&outp->ready_m);
+    ring_signal_ready(outp);
 }
 
 static void
@@ -9870,9 +10240,10 @@ rtl_stream_clear_output_ring(struct output_state* outp, int bump_generation) {
 
 extern "C" void
 dsd_rtl_stream_clear_output(void) {
-    struct output_state* outp = &output;
-    if (g_stream && g_stream->output) {
-        outp = g_stream->output;
+    dsd_rtl_stream& rtl = rtl_cur();
+    struct output_state* outp = &rtl.output;
+    if (rtl.internals && rtl.internals->output) {
+        outp = rtl.internals->output;
     }
     rtl_stream_clear_output_ring(outp, 1);
     rtl_stream_queue_fsk_modem_reset();
@@ -9880,8 +10251,9 @@ dsd_rtl_stream_clear_output(void) {
 
 extern "C" int
 rtl_stream_set_rtltcp_autotune(int onoff) {
-    if (!rtl_device_handle) {
+    dsd_rtl_stream& rtl = rtl_cur();
+    if (!rtl.device) {
         return -1;
     }
-    return rtl_device_set_tcp_autotune(rtl_device_handle, onoff ? 1 : 0);
+    return rtl_device_set_tcp_autotune(rtl.device, onoff ? 1 : 0);
 }
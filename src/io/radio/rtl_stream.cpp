@@ -7,7 +7,7 @@
  * @file
  * @brief RAII orchestrator for RTL-SDR stream lifecycle and control.
  *
- * Manages the global radio backend's start/stop, tuning, reads, and error
+ * Manages a radio pipeline's start/stop, tuning, reads, and error
  * propagation behind the public context API.
  */
 
@@ -30,6 +30,7 @@ int dsd_rtl_stream_tune_tagged(dsd_opts* opts, long int frequency, uint64_t requ
 int dsd_rtl_stream_soft_stop(void);
 void dsd_rtl_stream_register_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* caller_opts);
 void dsd_rtl_stream_unregister_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* caller_opts);
+dsd_rtl_stream* dsd_rtl_stream_bind(dsd_rtl_stream* stream);
 }
 
 namespace {
@@ -53,7 +54,13 @@ copy_opts(const dsd_opts* src) {
 }
 } // namespace
 
-RtlSdrOrchestrator::RtlSdrOrchestrator(dsd_opts& opts) : opts_(copy_opts(&opts)), caller_opts_(&opts), started_(false) {
+RtlPipelineScope::RtlPipelineScope(dsd_rtl_stream* pipeline) : prev_(dsd_rtl_stream_bind(pipeline)) {}
+
+RtlPipelineScope::~RtlPipelineScope() { dsd_rtl_stream_bind(prev_); }
+
+RtlSdrOrchestrator::RtlSdrOrchestrator(dsd_opts& opts, dsd_rtl_stream* pipeline)
+    : opts_(copy_opts(&opts)), caller_opts_(&opts), pipeline_(pipeline), started_(false) {
+    RtlPipelineScope scope(pipeline_);
     if (opts_) {
         dsd_rtl_stream_register_requested_ppm_opts(opts_, &opts);
     }
@@ -64,6 +71,7 @@ RtlSdrOrchestrator::RtlSdrOrchestrator(dsd_opts& opts) : opts_(copy_opts(&opts))
  */
 RtlSdrOrchestrator::~RtlSdrOrchestrator() {
     stop();
+    RtlPipelineScope scope(pipeline_);
     if (opts_) {
         dsd_rtl_stream_unregister_requested_ppm_opts(opts_, caller_opts_);
         free(opts_);
@@ -83,6 +91,7 @@ RtlSdrOrchestrator::start() {
     if (!opts_) {
         return -1;
     }
+    RtlPipelineScope scope(pipeline_);
     int r = dsd_rtl_stream_open(opts_);
     if (r < 0) {
         return r;
@@ -100,6 +109,7 @@ RtlSdrOrchestrator::stop() {
     if (!started_) {
         return 0;
     }
+    RtlPipelineScope scope(pipeline_);
     /*
      * Use the soft-stop path to avoid touching the global exitflag.
      * The ncurses menu restarts/destroys RTL streams as part of reconfiguring
@@ -123,6 +133,7 @@ RtlSdrOrchestrator::tune(uint32_t center_freq_hz) {
     if (!started_) {
         return -1;
     }
+    RtlPipelineScope scope(pipeline_);
     if (!opts_) {
         return -2;
     }
@@ -138,6 +149,7 @@ RtlSdrOrchestrator::tune_tagged(uint32_t center_freq_hz, uint64_t request_id) {
     if (!started_) {
         return -1;
     }
+    RtlPipelineScope scope(pipeline_);
     if (!opts_) {
         return -2;
     }
@@ -159,6 +171,7 @@ RtlSdrOrchestrator::read(float* out, size_t count, int& out_got) {
     if (!started_) {
         return -1;
     }
+    RtlPipelineScope scope(pipeline_);
     if (!opts_) {
         return -2;
     }
@@ -44,6 +44,19 @@ struct RtlSdrContext {
  */
 extern "C" int
 rtl_stream_create(dsd_opts* opts, RtlSdrContext** out_ctx) {
+    return rtl_stream_create_on(NULL, opts, out_ctx);
+}
+
+/**
+ * @brief Create a stream context that runs on @p pipeline.
+ *
+ * @param pipeline Pipeline from dsd_rtl_stream_create(), or NULL for the default.
+ * @param opts Mutable caller-owned decoder options. Must not be NULL.
+ * @param out_ctx [out] On success, receives an opaque context pointer.
+ * @return 0 on success; otherwise <0 on error.
+ */
+extern "C" int
+rtl_stream_create_on(dsd_rtl_stream* pipeline, dsd_opts* opts, RtlSdrContext** out_ctx) {
     if (!out_ctx || !opts) {
         return -1;
     }
@@ -51,7 +64,7 @@ rtl_stream_create(dsd_opts* opts, RtlSdrContext** out_ctx) {
     if (!*out_ctx) {
         return -1;
     }
-    (*out_ctx)->stream = new (std::nothrow) RtlSdrOrchestrator(*opts);
+    (*out_ctx)->stream = new (std::nothrow) RtlSdrOrchestrator(*opts, pipeline);
     if (!(*out_ctx)->stream) {
         free(*out_ctx);
         *out_ctx = NULL;
@@ -168,6 +181,7 @@ rtl_stream_output_rate(const RtlSdrContext* ctx) {
     if (!ctx || !ctx->stream) {
         return 0U;
     }
+    RtlPipelineScope scope(ctx->stream->pipeline());
     return dsd_rtl_stream_output_rate();
 }
 
@@ -176,17 +190,23 @@ rtl_stream_output_rate(const RtlSdrContext* ctx) {
  *
  * The computation uses a small fixed sample window for efficiency.
  *
- * @param ctx Stream context (unused).
+ * @param ctx Stream context; NULL reads the calling thread's pipeline.
  * @return Mean power value (approximate RMS squared, normalized).
  */
 extern "C" double
 rtl_stream_return_pwr(const RtlSdrContext* ctx) {
-    (void)ctx;
+    if (!ctx || !ctx->stream) {
+        return dsd_rtl_stream_return_pwr();
+    }
+    RtlPipelineScope scope(ctx->stream->pipeline());
     return dsd_rtl_stream_return_pwr();
 }
 
 extern "C" int
 rtl_stream_cqpsk_timing_bias(const RtlSdrContext* ctx) {
-    (void)ctx;
+    if (!ctx || !ctx->stream) {
+        return dsd_rtl_stream_cqpsk_timing_bias();
+    }
+    RtlPipelineScope scope(ctx->stream->pipeline());
     return dsd_rtl_stream_cqpsk_timing_bias();
 }
@@ -7,10 +7,9 @@
  * @file
  * @brief Cross-thread atomic mirrors of demod-thread state.
  *
- * Kept separate from rtl_stream_shared.hpp so translation units whose
- * functions take a local `demod` parameter (rtl_demod_config.cpp) can declare
- * the mirrors without pulling in the `demod` global and shadowing it. Keep
- * this header private to src/io/radio/.
+ * Kept separate from rtl_stream_shared.hpp so translation units that only
+ * reset a mirror (rtl_demod_config.cpp) do not pull in the whole per-pipeline
+ * shared block. Keep this header private to src/io/radio/.
  */
 
 #ifndef DSD_NEO_SRC_IO_RADIO_RTL_STREAM_MIRRORS_HPP_
@@ -18,8 +17,8 @@
 
 #include <atomic>
 
-/* Mirror of demod.channel_pwr: written by the demod thread after each block,
- * read by the main thread via dsd_rtl_stream_return_pwr(). */
-extern std::atomic<float> g_channel_pwr;
+/* Mirror of demod.channel_pwr for the calling thread's pipeline: written by its
+ * demod thread after each block, read via dsd_rtl_stream_return_pwr(). */
+std::atomic<float>& rtl_stream_channel_pwr(void);
 
 #endif /* DSD_NEO_SRC_IO_RADIO_RTL_STREAM_MIRRORS_HPP_ */
@@ -7,8 +7,11 @@
  * @file
  * @brief Internal cross-translation-unit RTL stream state declarations.
  *
- * These symbols are intentionally shared between rtl_sdr_fm.cpp and
- * rtl_metrics.cpp. Keep this header private to src/io/radio/.
+ * The per-pipeline state that rtl_sdr_fm.cpp, rtl_metrics.cpp and
+ * rtl_device.cpp all touch. Every dsd_rtl_stream owns one RtlStreamShared;
+ * code reaches the one for the pipeline it is running on through
+ * rtl_stream_shared(), which follows the calling thread's binding (see
+ * dsd_rtl_stream_bind()). Keep this header private to src/io/radio/.
  */
 
 #ifndef DSD_NEO_SRC_IO_RADIO_RTL_STREAM_SHARED_HPP_
@@ -17,33 +20,97 @@
 #include <atomic>
 #include <dsd-neo/core/input_level.h>
 #include <dsd-neo/dsp/demod_state.h>
+#include <dsd-neo/platform/threading.h>
 
+#include "rtl_fft_cache.h"
 #include "rtl_stream_mirrors.hpp"
 
-extern demod_state demod;
-
-extern std::atomic<double> g_snr_c4fm_db;
-extern std::atomic<double> g_snr_qpsk_db;
-extern std::atomic<double> g_snr_gfsk_db;
-
-extern std::atomic<int> g_tuner_autogain_on;
-
-extern std::atomic<int> g_auto_ppm_enabled;
-extern std::atomic<int> g_auto_ppm_user_en;
-extern std::atomic<int> g_auto_ppm_locked;
-extern std::atomic<int> g_auto_ppm_training;
-extern std::atomic<int> g_auto_ppm_lock_ppm;
-extern std::atomic<double> g_auto_ppm_lock_snr_db;
-extern std::atomic<double> g_auto_ppm_lock_df_hz;
-extern std::atomic<double> g_auto_ppm_snr_db;
-extern std::atomic<double> g_auto_ppm_df_hz;
-extern std::atomic<double> g_auto_ppm_est_ppm;
-extern std::atomic<int> g_auto_ppm_last_dir;
-extern std::atomic<int> g_auto_ppm_cooldown;
-
-extern std::atomic<double> g_spec_peak_db;
-extern std::atomic<double> g_spec_snr_db;
-extern std::atomic<double> g_resid_cfo_phase_hz;
+/** Largest post-demod spectrum FFT (power of two). */
+static constexpr int kRtlSpecMaxN = 1024;
+
+/**
+ * @brief Metrics and diagnostics one radio pipeline publishes.
+ *
+ * Written by that pipeline's own threads and read by getters on any thread;
+ * two pipelines in one process never see each other's numbers.
+ */
+struct RtlStreamShared {
+    std::atomic<float> channel_pwr{0.0f};
+
+    std::atomic<double> snr_c4fm_db{-100.0};
+    std::atomic<double> snr_qpsk_db{-100.0};
+    std::atomic<double> snr_gfsk_db{-100.0};
+
+    /* Supervisory tuner autogain gate (0/1), controlled via env/UI. */
+    std::atomic<int> tuner_autogain_on{0};
+
+    /* Auto-PPM status. */
+    std::atomic<int> auto_ppm_enabled{0};
+    /* User override for auto-PPM: -1 = follow env/opts; 0 = force off; 1 = force on. */
+    std::atomic<int> auto_ppm_user_en{-1};
+    std::atomic<int> auto_ppm_locked{0};
+    std::atomic<int> auto_ppm_training{0};
+    std::atomic<int> auto_ppm_lock_ppm{0};
+    std::atomic<double> auto_ppm_lock_snr_db{-100.0};
+    std::atomic<double> auto_ppm_lock_df_hz{0.0};
+    std::atomic<double> auto_ppm_snr_db{-100.0};
+    std::atomic<double> auto_ppm_df_hz{0.0};
+    std::atomic<double> auto_ppm_est_ppm{0.0};
+    std::atomic<int> auto_ppm_last_dir{0};
+    std::atomic<int> auto_ppm_cooldown{0};
+
+    /* Post-demod spectrum snapshot (rtl_metrics.cpp). */
+    float spec_db[kRtlSpecMaxN] = {};
+    std::atomic<int> spec_rate_hz{0};
+    std::atomic<int> spec_ready{0};
+    std::atomic<int> spec_N{256};
+    std::atomic<double> spec_peak_db{-100.0};
+    std::atomic<double> spec_snr_db{-100.0};
+    /* This tap's own caches, separate from the wideband tap's: the two analyse
+     * different sizes, so one shared cache would rebuild on every call. */
+    dsd_io::FftSetupCache spec_fft_setup;
+    dsd_io::HannWindowCache<kRtlSpecMaxN> spec_hann;
+
+    /* Carrier diagnostics (updated alongside spectrum). */
+    std::atomic<double> cfo_nco_hz{0.0};
+    std::atomic<double> resid_cfo_phase_hz{0.0};
+    std::atomic<int> carrier_lock{0};
+    std::atomic<int> nco_q15{0};
+    std::atomic<int> demod_rate_hz{0};
+    std::atomic<int> costas_err_avg_q14{0};
+    std::atomic<int> costas_err_raw_avg_q14{0};
+    std::atomic<int> costas_conf_avg_q14{0};
+    std::atomic<int> costas_zero_conf_pct{0};
+    std::atomic<double> fll_band_edge_freq_rad{0.0}; /* FLL band-edge NCO freq (rad/sample) */
+
+    /* CQPSK loop-lock heuristic history (demod thread only). */
+    int lock_prev_valid = 0;
+    float lock_prev_total_freq_rad = 0.0f;
+    int lock_freq_stable_blocks = 0;
+};
+
+/** @brief Shared block of the pipeline the calling thread is bound to. */
+RtlStreamShared& rtl_stream_shared(void);
+
+/** @brief Demodulator of the pipeline the calling thread is bound to. */
+demod_state& rtl_stream_demod(void);
+
+/**
+ * @brief Whether the calling thread is bound to the default pipeline.
+ *
+ * The process-wide taps (wideband spectrum, channelizer) follow the default
+ * pipeline only, so a second pipeline in the same process does not interleave
+ * its blocks into them.
+ */
+int rtl_stream_on_default_pipeline(void);
+
+/**
+ * @brief dsd_thread_create() for a thread that works for the caller's pipeline.
+ *
+ * The new thread starts bound to the same dsd_rtl_stream as the calling thread.
+ * Use it for every capture/controller/demod thread a stream starts.
+ */
+int rtl_stream_thread_create(dsd_thread_t* thread, dsd_thread_fn fn, void* arg);
 
 void rtl_stream_input_level_publish(const dsd_input_level_snapshot* snapshot);
 void rtl_stream_input_level_reset(void);
@@ -6,6 +6,13 @@
 /*
  * dmr_34_viterbi.c
  * Normative DMR 3/4 decoder (hard-decision Viterbi).
+ *
+ * Every decoder here is table driven: per trellis step the cost of each of the
+ * 16 possible received symbols is computed once, and the 64 branch costs are
+ * gathered from it through a fixed (state, next state) -> symbol table. The
+ * single-survivor decoders then run the eight next states as one vector of
+ * 16-bit metrics (SSE2 or NEON); the top-K list decoder stays scalar but reads
+ * the same cost rows instead of re-deriving them per candidate.
  */
 
 #include <stddef.h>
@@ -17,10 +24,22 @@
 #include <dsd-neo/protocol/dmr/r34_viterbi.h>
 #include "dmr_r34_internal.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define R34_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define R34_NEON 1
+#include <arm_neon.h>
+#endif
+
 enum { R34_T = 49, R34_S = 8, R34_K = 32 };
 
 static const int R34_INF = 1000000000;
 
+/* Unreached state in the 16-bit survivor metrics. Reachable metrics stay far
+ * below it: at most 4 * 255 per step over 49 steps. */
+static const uint16_t R34_INF16 = 0xFFFFU;
+
 typedef struct {
     int metric;
     uint8_t state;
@@ -91,26 +110,6 @@ r34_prepare_reliability_weights(const uint8_t* reliab98, uint8_t rhi[R34_T], uin
     r34_set_uniform_reliability(rhi, rlo, 1);
 }
 
-static void
-r34_metric_reset_1d(int metric[R34_S]) {
-    for (int s = 0; s < R34_S; s++) {
-        metric[s] = R34_INF;
-    }
-}
-
-static void
-r34_metric_copy_1d(int dst[R34_S], const int src[R34_S]) {
-    for (int s = 0; s < R34_S; s++) {
-        dst[s] = src[s];
-    }
-}
-
-static void
-r34_metric_init_1d(int metric[R34_S]) {
-    r34_metric_reset_1d(metric);
-    metric[0] = 0;
-}
-
 static void
 r34_metric_reset_2d(int metric[R34_S][R34_K]) {
     for (int s = 0; s < R34_S; s++) {
@@ -201,55 +200,115 @@ r34_unweighted_list_cost(uint8_t expect_nib, uint8_t obs_nib) {
     return 0;
 }
 
+/* Hard cost of each possible transmitted point against the received one. */
 static void
-r34_run_viterbi_hard(const uint8_t obs_point[R34_T], int metric_prev[R34_S], uint8_t backptr[R34_T][R34_S]) {
-    int metric_curr[R34_S];
+r34_point_costs(const uint8_t obs_point[R34_T], uint16_t sym_cost[R34_T][16]) {
+    for (int t = 0; t < R34_T; t++) {
+        for (int p = 0; p < 16; p++) {
+            sym_cost[t][p] = (uint16_t)dsd_popcount64((uint64_t)((p ^ obs_point[t]) & 0x0F));
+        }
+    }
+}
 
-    r34_metric_init_1d(metric_prev);
+/* Reliability-weighted cost of each possible transmitted nibble. */
+static void
+r34_nibble_costs(const uint8_t nibs[R34_T], const uint8_t rhi[R34_T], const uint8_t rlo[R34_T], int weighted,
+                 uint16_t sym_cost[R34_T][16]) {
     for (int t = 0; t < R34_T; t++) {
-        r34_metric_reset_1d(metric_curr);
-        for (int ps = 0; ps < R34_S; ps++) {
-            if (metric_prev[ps] >= R34_INF) {
-                continue;
-            }
-            for (int ns = 0; ns < R34_S; ns++) {
-                uint8_t expect = dsd_trellis34_fsm[ps * 8 + ns];
-                int distance = dsd_popcount64((uint64_t)((expect ^ obs_point[t]) & 0x0FU));
-                int m = metric_prev[ps] + distance;
-                if (m < metric_curr[ns]) {
-                    metric_curr[ns] = m;
-                    backptr[t][ns] = (uint8_t)ps;
-                }
-            }
+        for (int e = 0; e < 16; e++) {
+            sym_cost[t][e] = (uint16_t)(weighted ? r34_weighted_nibble_cost((uint8_t)e, nibs[t], rhi[t], rlo[t])
+                                                 : r34_unweighted_list_cost((uint8_t)e, nibs[t]));
         }
-        r34_metric_copy_1d(metric_prev, metric_curr);
     }
 }
 
 static void
-r34_run_viterbi_soft(const uint8_t nibs[R34_T], const uint8_t rhi[R34_T], const uint8_t rlo[R34_T],
-                     int metric_prev[R34_S], uint8_t backptr[R34_T][R34_S]) {
-    int metric_curr[R34_S];
+r34_gather_branch_costs(uint8_t sym_tbl[R34_S][R34_S], const uint16_t sym_cost[16],
+                        uint16_t cost[R34_S][R34_S]) {
+    for (int ps = 0; ps < R34_S; ps++) {
+        for (int ns = 0; ns < R34_S; ns++) {
+            cost[ps][ns] = sym_cost[sym_tbl[ps][ns]];
+        }
+    }
+}
 
-    r34_metric_init_1d(metric_prev);
-    for (int t = 0; t < R34_T; t++) {
-        r34_metric_reset_1d(metric_curr);
-        for (int ps = 0; ps < R34_S; ps++) {
-            if (metric_prev[ps] >= R34_INF) {
-                continue;
-            }
-            for (int ns = 0; ns < R34_S; ns++) {
-                uint8_t expect_point = dsd_trellis34_fsm[ps * 8 + ns];
-                uint8_t expect_nib = dsd_trellis34_inverse_constellation[expect_point];
-                int cost = r34_weighted_nibble_cost(expect_nib, nibs[t], rhi[t], rlo[t]);
-                int m = metric_prev[ps] + cost;
-                if (m < metric_curr[ns]) {
-                    metric_curr[ns] = m;
-                    backptr[t][ns] = (uint8_t)ps;
-                }
+/*
+ * One add-compare-select step over all eight next states. A predecessor only
+ * replaces the survivor on a strictly smaller metric, so ties keep the lowest
+ * previous state, as the original nested loops did.
+ */
+#if defined(R34_SSE2)
+// NOLINTBEGIN(portability-simd-intrinsics)
+static void
+r34_acs_step(const uint16_t prev[R34_S], uint16_t curr[R34_S], uint8_t backptr[R34_S],
+             uint16_t cost[R34_S][R34_S]) {
+    /* SSE2 has no unsigned 16-bit compare; bias both sides into signed range. */
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    __m128i best = _mm_set1_epi16((short)R34_INF16);
+    __m128i from = _mm_setzero_si128();
+    for (int ps = 0; ps < R34_S; ps++) {
+        const __m128i row = _mm_loadu_si128((const __m128i*)(const void*)cost[ps]);
+        const __m128i m = _mm_adds_epu16(_mm_set1_epi16((short)prev[ps]), row);
+        const __m128i better = _mm_cmplt_epi16(_mm_xor_si128(m, bias), _mm_xor_si128(best, bias));
+        best = _mm_or_si128(_mm_and_si128(better, m), _mm_andnot_si128(better, best));
+        from = _mm_or_si128(_mm_and_si128(better, _mm_set1_epi16((short)ps)), _mm_andnot_si128(better, from));
+    }
+    _mm_storeu_si128((__m128i*)(void*)curr, best);
+    _mm_storel_epi64((__m128i*)(void*)backptr, _mm_packus_epi16(from, from));
+}
+// NOLINTEND(portability-simd-intrinsics)
+#elif defined(R34_NEON)
+// NOLINTBEGIN(portability-simd-intrinsics)
+static void
+r34_acs_step(const uint16_t prev[R34_S], uint16_t curr[R34_S], uint8_t backptr[R34_S],
+             uint16_t cost[R34_S][R34_S]) {
+    uint16x8_t best = vdupq_n_u16(R34_INF16);
+    uint16x8_t from = vdupq_n_u16(0);
+    for (int ps = 0; ps < R34_S; ps++) {
+        const uint16x8_t m = vqaddq_u16(vdupq_n_u16(prev[ps]), vld1q_u16(cost[ps]));
+        const uint16x8_t better = vcltq_u16(m, best);
+        best = vbslq_u16(better, m, best);
+        from = vbslq_u16(better, vdupq_n_u16((uint16_t)ps), from);
+    }
+    vst1q_u16(curr, best);
+    vst1_u8(backptr, vmovn_u16(from));
+}
+// NOLINTEND(portability-simd-intrinsics)
+#else
+static void
+r34_acs_step(const uint16_t prev[R34_S], uint16_t curr[R34_S], uint8_t backptr[R34_S],
+             uint16_t cost[R34_S][R34_S]) {
+    for (int ns = 0; ns < R34_S; ns++) {
+        curr[ns] = R34_INF16;
+        backptr[ns] = 0;
+    }
+    for (int ps = 0; ps < R34_S; ps++) {
+        if (prev[ps] == R34_INF16) {
+            continue;
+        }
+        for (int ns = 0; ns < R34_S; ns++) {
+            const uint16_t m = (uint16_t)(prev[ps] + cost[ps][ns]);
+            if (m < curr[ns]) {
+                curr[ns] = m;
+                backptr[ns] = (uint8_t)ps;
             }
         }
-        r34_metric_copy_1d(metric_prev, metric_curr);
+    }
+}
+#endif
+
+static void
+r34_run_viterbi_table(uint8_t sym_tbl[R34_S][R34_S], uint16_t sym_cost[R34_T][16],
+                      uint8_t backptr[R34_T][R34_S]) {
+    uint16_t metric[2][R34_S];
+    uint16_t cost[R34_S][R34_S];
+    for (int s = 0; s < R34_S; s++) {
+        metric[0][s] = R34_INF16;
+    }
+    metric[0][0] = 0;
+    for (int t = 0; t < R34_T; t++) {
+        r34_gather_branch_costs(sym_tbl, sym_cost[t], cost);
+        r34_acs_step(metric[t & 1], metric[(t + 1) & 1], backptr[t], cost);
     }
 }
 
@@ -263,9 +322,21 @@ r34_precompute_expect_nibbles(uint8_t expect_nib_tbl[R34_S][R34_S]) {
     }
 }
 
+static void
+r34_fsm_table(uint8_t sym_tbl[R34_S][R34_S]) {
+    for (int ps = 0; ps < R34_S; ps++) {
+        for (int ns = 0; ns < R34_S; ns++) {
+            sym_tbl[ps][ns] = dsd_trellis34_fsm[ps * 8 + ns];
+        }
+    }
+}
+
 static void
 r34_insert_topk(int metric_curr[R34_S][R34_K], uint8_t back_state_t[R34_S][R34_K], uint8_t back_rank_t[R34_S][R34_K],
                 int ns, int m, int ps, int pr) {
+    if (m > metric_curr[ns][R34_K - 1]) {
+        return;
+    }
     for (int rr = 0; rr < R34_K; rr++) {
         if (m <= metric_curr[ns][rr]) {
             for (int sh = R34_K - 1; sh > rr; sh--) {
@@ -283,34 +354,43 @@ r34_insert_topk(int metric_curr[R34_S][R34_K], uint8_t back_state_t[R34_S][R34_K
 
 static void
 r34_viterbi_step_list(int metric_prev[R34_S][R34_K], int metric_curr[R34_S][R34_K], uint8_t back_state_t[R34_S][R34_K],
-                      uint8_t back_rank_t[R34_S][R34_K], uint8_t expect_nib_tbl[R34_S][R34_S], uint8_t obs_nib,
-                      uint8_t rhi, uint8_t rlo, int weighted) {
+                      uint8_t back_rank_t[R34_S][R34_K], uint16_t cost[R34_S][R34_S]) {
+    /* Each survivor list is sorted, so once a predecessor rank misses a next
+     * state's full list, every later rank of that predecessor misses it too. */
     for (int ps = 0; ps < R34_S; ps++) {
-        for (int pr = 0; pr < R34_K; pr++) {
+        unsigned int open = (1U << R34_S) - 1U;
+        for (int pr = 0; pr < R34_K && open != 0U; pr++) {
             int m0 = metric_prev[ps][pr];
             if (m0 >= R34_INF) {
-                continue;
+                break;
             }
             for (int ns = 0; ns < R34_S; ns++) {
-                int cost = weighted ? r34_weighted_nibble_cost(expect_nib_tbl[ps][ns], obs_nib, rhi, rlo)
-                                    : r34_unweighted_list_cost(expect_nib_tbl[ps][ns], obs_nib);
-                r34_insert_topk(metric_curr, back_state_t, back_rank_t, ns, m0 + cost, ps, pr);
+                if ((open & (1U << ns)) == 0U) {
+                    continue;
+                }
+                const int m = m0 + cost[ps][ns];
+                if (m > metric_curr[ns][R34_K - 1]) {
+                    open &= ~(1U << ns);
+                    continue;
+                }
+                r34_insert_topk(metric_curr, back_state_t, back_rank_t, ns, m, ps, pr);
             }
         }
     }
 }
 
 static void
-r34_run_viterbi_list(uint8_t nibs[R34_T], uint8_t rhi[R34_T], uint8_t rlo[R34_T], uint8_t expect_nib_tbl[R34_S][R34_S],
-                     int weighted, int metric_prev[R34_S][R34_K], int metric_curr[R34_S][R34_K],
-                     uint8_t back_state[R34_T][R34_S][R34_K], uint8_t back_rank[R34_T][R34_S][R34_K]) {
+r34_run_viterbi_list(uint8_t expect_nib_tbl[R34_S][R34_S], uint16_t sym_cost[R34_T][16], int metric_prev[R34_S][R34_K],
+                     int metric_curr[R34_S][R34_K], uint8_t back_state[R34_T][R34_S][R34_K],
+                     uint8_t back_rank[R34_T][R34_S][R34_K]) {
+    uint16_t cost[R34_S][R34_S];
     r34_metric_init_2d(metric_prev);
     for (int t = 0; t < R34_T; t++) {
         r34_metric_reset_2d(metric_curr);
         DSD_MEMSET(back_state[t], 0, sizeof(back_state[t]));
         DSD_MEMSET(back_rank[t], 0, sizeof(back_rank[t]));
-        r34_viterbi_step_list(metric_prev, metric_curr, back_state[t], back_rank[t], expect_nib_tbl, nibs[t], rhi[t],
-                              rlo[t], weighted);
+        r34_gather_branch_costs(expect_nib_tbl, sym_cost[t], cost);
+        r34_viterbi_step_list(metric_prev, metric_curr, back_state[t], back_rank[t], cost);
         r34_metric_copy_2d(metric_prev, metric_curr);
     }
 }
@@ -369,13 +449,16 @@ dmr_r34_viterbi_decode(const uint8_t* dibits98, uint8_t out_bytes18[18]) {
 
     uint8_t nibs[R34_T];
     uint8_t obs_point[R34_T];
-    int metric_prev[R34_S];
+    uint8_t fsm_tbl[R34_S][R34_S];
+    uint16_t sym_cost[R34_T][16];
     uint8_t backptr[R34_T][R34_S];
     uint8_t states[R34_T];
 
     r34_prepare_nibbles(dibits98, nibs);
     r34_map_nibbles_to_points(nibs, obs_point);
-    r34_run_viterbi_hard(obs_point, metric_prev, backptr);
+    r34_fsm_table(fsm_tbl);
+    r34_point_costs(obs_point, sym_cost);
+    r34_run_viterbi_table(fsm_tbl, sym_cost, backptr);
 
     r34_traceback_states(backptr, 0, states);
     r34_pack_states_to_bytes(states, out_bytes18);
@@ -393,13 +476,16 @@ dmr_r34_viterbi_decode_soft(const uint8_t* dibits98, const uint8_t* reliab98, ui
     uint8_t nibs[R34_T];
     uint8_t rhi[R34_T];
     uint8_t rlo[R34_T];
-    int metric_prev[R34_S];
+    uint8_t expect_nib_tbl[R34_S][R34_S];
+    uint16_t sym_cost[R34_T][16];
     uint8_t backptr[R34_T][R34_S];
     uint8_t states[R34_T];
 
     r34_prepare_nibbles(dibits98, nibs);
     r34_prepare_reliability_weights(reliab98, rhi, rlo, 1);
-    r34_run_viterbi_soft(nibs, rhi, rlo, metric_prev, backptr);
+    r34_precompute_expect_nibbles(expect_nib_tbl);
+    r34_nibble_costs(nibs, rhi, rlo, 1, sym_cost);
+    r34_run_viterbi_table(expect_nib_tbl, sym_cost, backptr);
 
     r34_traceback_states(backptr, 0, states);
     r34_pack_states_to_bytes(states, out_bytes18);
@@ -454,6 +540,7 @@ dmr_r34_viterbi_decode_list(const uint8_t* dibits98, const uint8_t* reliab98, dm
     uint8_t rhi[R34_T];
     uint8_t rlo[R34_T];
     uint8_t expect_nib_tbl[R34_S][R34_S];
+    uint16_t sym_cost[R34_T][16];
     int metric_prev[R34_S][R34_K];
     int metric_curr[R34_S][R34_K];
     uint8_t back_state[R34_T][R34_S][R34_K];
@@ -465,7 +552,8 @@ dmr_r34_viterbi_decode_list(const uint8_t* dibits98, const uint8_t* reliab98, dm
     r34_prepare_nibbles(dibits98, nibs);
     r34_prepare_reliability_weights(reliab98, rhi, rlo, weighted);
     r34_precompute_expect_nibbles(expect_nib_tbl);
-    r34_run_viterbi_list(nibs, rhi, rlo, expect_nib_tbl, weighted, metric_prev, metric_curr, back_state, back_rank);
+    r34_nibble_costs(nibs, rhi, rlo, weighted, sym_cost);
+    r34_run_viterbi_list(expect_nib_tbl, sym_cost, metric_prev, metric_curr, back_state, back_rank);
 
     idx_n = r34_collect_final_indices(metric_prev, idx);
     r34_sort_indices_by_metric(idx, idx_n);
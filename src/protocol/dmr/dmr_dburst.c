@@ -55,7 +55,6 @@ typedef struct {
     uint8_t blockcounter;
     uint8_t confdatabits[250];
 
-    uint8_t bptc_deinterleaved[196];
     uint8_t bptc_data_bits[96];
     uint8_t bptc_data_bytes[12];
 
@@ -326,8 +325,7 @@ dmr_dburst_handle_bptc(dmr_data_burst_ctx* ctx) {
     ctx->crc_computed = 0;
     ctx->irrecoverable_errors = 0;
 
-    BPTCDeInterleaveDMRData(ctx->info, ctx->bptc_deinterleaved);
-    ctx->irrecoverable_errors = BPTC_196x96_Extract_Data(ctx->bptc_deinterleaved, ctx->bptc_data_bits, ctx->r);
+    ctx->irrecoverable_errors = BPTC_196x96_Decode(ctx->info, ctx->bptc_data_bits, ctx->r);
     ctx->bptc_reserved_bits = (ctx->r[0] & 0x01) | ((ctx->r[1] << 1) & 0x02) | ((ctx->r[2] << 2) & 0x04);
 
     dmr_dburst_unpack_bptc_bytes(ctx);
@@ -445,14 +445,16 @@ dmrMSData(dsd_opts* opts, dsd_state* state) {
         state->dmr_stereo_reliab[i] = soft_p != NULL ? soft_p[i].reliability : 200U;
     }
 
+    int tail_dibits[54];
+    dsd_dibit_soft_t tail_soft[54];
+    (void)getDibitSoftBlock(opts, state, tail_dibits, tail_soft, 54);
     for (i = 0; i < 54; i++) {
-        dsd_dibit_soft_t soft;
-        dibit = getDibitSoft(opts, state, &soft);
+        dibit = tail_dibits[i];
         if (opts->inverted_dmr == 1) {
             dibit = (dibit ^ 2) & 3;
         }
         state->dmr_stereo_payload[i + 90] = dibit;
-        state->dmr_stereo_reliab[i + 90] = soft.reliability;
+        state->dmr_stereo_reliab[i + 90] = tail_soft[i].reliability;
     }
 
     DSD_FPRINTF(stderr, "%s ", timestr);
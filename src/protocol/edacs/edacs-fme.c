@@ -39,6 +39,7 @@
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/core/talkgroup_policy.h>
 #include <dsd-neo/core/time_format.h>
+#include <dsd-neo/core/wav_writer.h>
 #include <dsd-neo/dsp/frame_sync.h>
 #include <dsd-neo/platform/audio.h>
 #include <dsd-neo/platform/file_compat.h>
@@ -72,6 +73,9 @@ edacs_write_wav_short_block(SNDFILE* file, const short* samples, sf_count_t samp
     if (file == NULL || samples == NULL || sample_count <= 0) {
         return;
     }
+    if (dsd_wav_writer_active() && dsd_wav_writer_write(file, samples, (int64_t)sample_count, context) >= 0) {
+        return;
+    }
     sf_count_t written = sf_write_short(file, samples, sample_count);
     if (written != sample_count) {
         LOG_WARN("%s: wrote %lld/%lld samples to WAV output", context, (long long)written, (long long)sample_count);
@@ -231,19 +235,22 @@ edacs_fill_analog_block_udp(dsd_opts* opts, dsd_state* state, short* block) {
 #ifdef USE_RADIO
 static int
 edacs_fill_analog_block_rtl(dsd_opts* opts, dsd_state* state, short* block) {
-    float rtl_sample = 0.0f;
-    for (int i = 0; i < 960; i++) {
+    float span[960];
+    int filled = 0;
+    while (filled < 960) {
         if (!state->rtl_ctx) {
             dsd_request_shutdown(opts, state);
             return 0;
         }
         int got = 0;
-        if (dsd_rtl_stream_io_hook_read(state, &rtl_sample, 1, &got) < 0 || got != 1) {
+        if (dsd_rtl_stream_io_hook_read_block(state, span + filled, (size_t)(960 - filled), &got) < 0 || got <= 0) {
             dsd_request_shutdown(opts, state);
             return 0;
         }
-        rtl_sample *= opts->rtl_volume_multiplier;
-        block[i] = clip_float_to_short(rtl_sample);
+        filled += got;
+    }
+    for (int i = 0; i < 960; i++) {
+        block[i] = clip_float_to_short(span[i] * opts->rtl_volume_multiplier);
     }
     return 1;
 }
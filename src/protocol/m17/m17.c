@@ -23,6 +23,7 @@
 #include <dsd-neo/core/power.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/core/wav_writer.h>
 #include <dsd-neo/crypto/aes.h>
 #include <dsd-neo/crypto/ecdsa.h>
 #include <dsd-neo/fec/viterbi.h>
@@ -72,8 +73,9 @@ static void M17logLSFTrailer(const dsd_state* state, const struct m17_lsf_result
 static int m17_can_matches_state(const dsd_state* state);
 static int m17_load_aes_key(const dsd_state* state, uint8_t subtype, uint8_t key[32]);
 
+/* Write on this thread; for handles the background WAV writer never owns. */
 static void
-m17_write_wav_short_block(SNDFILE* file, const short* samples, sf_count_t sample_count, const char* context) {
+m17_write_wav_short_block_inline(SNDFILE* file, const short* samples, sf_count_t sample_count, const char* context) {
     if (file == NULL || samples == NULL || sample_count <= 0) {
         return;
     }
@@ -83,6 +85,19 @@ m17_write_wav_short_block(SNDFILE* file, const short* samples, sf_count_t sample
     }
 }
 
+#ifdef USE_CODEC2
+static void
+m17_write_wav_short_block(SNDFILE* file, const short* samples, sf_count_t sample_count, const char* context) {
+    if (file == NULL || samples == NULL || sample_count <= 0) {
+        return;
+    }
+    if (dsd_wav_writer_active() && dsd_wav_writer_write(file, samples, (int64_t)sample_count, context) >= 0) {
+        return;
+    }
+    m17_write_wav_short_block_inline(file, samples, sample_count, context);
+}
+#endif
+
 #define M17_BASEBAND_SAMPLES ((size_t)M17_FRAME_SYMBOLS * (size_t)M17_RECOMMENDED_UPSAMPLE_FACTOR)
 #define M17_BASEBAND_BYTES   (M17_BASEBAND_SAMPLES * sizeof(short))
 
@@ -1564,8 +1579,10 @@ m17_monitor_baseband_if_enabled(dsd_opts* opts, dsd_state* state, const short* b
 
 static void
 m17_write_baseband_wav_if_enabled(const dsd_opts* opts, const short* baseband) {
+    /* The raw capture is written and synced here, never through the background WAV writer. */
     if (opts->wav_out_raw != NULL) {
-        m17_write_wav_short_block(opts->wav_out_raw, baseband, (sf_count_t)M17_BASEBAND_SAMPLES, "M17 raw WAV");
+        m17_write_wav_short_block_inline(opts->wav_out_raw, baseband, (sf_count_t)M17_BASEBAND_SAMPLES,
+                                         "M17 raw WAV");
         sf_write_sync(opts->wav_out_raw);
     }
 }
@@ -1886,17 +1903,28 @@ static int
 m17_str_read_block_rtl(dsd_opts* opts, dsd_state* state, size_t nsam, int dec, float* sample, short* out,
                        int clip_output) {
 #ifdef USE_RADIO
+    float span[DSD_RTL_SYMBOL_CACHE_CAP];
+    int span_len = 0;
+    int span_pos = 0;
     for (size_t i = 0; i < nsam; i++) {
         for (int j = 0; j < dec; j++) {
-            if (!state->rtl_ctx) {
-                dsd_request_shutdown(opts, state);
-                return M17_STR_READ_STOP;
-            }
-            int got = 0;
-            if (dsd_rtl_stream_io_hook_read(state, sample, 1, &got) < 0 || got != 1) {
-                dsd_request_shutdown(opts, state);
-                return M17_STR_READ_STOP;
+            if (span_pos >= span_len) {
+                if (!state->rtl_ctx) {
+                    dsd_request_shutdown(opts, state);
+                    return M17_STR_READ_STOP;
+                }
+                /* Never pull past the last sample this block consumes. */
+                size_t want = (nsam - i) * (size_t)dec - (size_t)j;
+                if (want > DSD_RTL_SYMBOL_CACHE_CAP) {
+                    want = DSD_RTL_SYMBOL_CACHE_CAP;
+                }
+                if (dsd_rtl_stream_io_hook_read_block(state, span, want, &span_len) < 0 || span_len <= 0) {
+                    dsd_request_shutdown(opts, state);
+                    return M17_STR_READ_STOP;
+                }
+                span_pos = 0;
             }
+            *sample = span[span_pos++];
         }
         *sample *= opts->rtl_volume_multiplier;
         out[i] = clip_output ? m17_clip_float_to_short(*sample) : (short)*sample;
@@ -25,7 +25,9 @@
 
 /* Include ------------------------------------------------------------------*/
 
+#include <dsd-neo/fec/viterbi_k5.h>
 #include <dsd-neo/protocol/nxdn/nxdn_convolution.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include "dsd-neo/core/safe_api.h"
@@ -35,130 +37,89 @@ static const uint8_t CNXDNConvolution_BIT_MASK_TABLE[8] = {0x80U, 0x40U, 0x20U,
 #define WRITE_BIT1(p, i, b)                                                                                            \
     ((p)[(i) >> 3] = (b) ? (((p)[(i) >> 3]) | CNXDNConvolution_BIT_MASK_TABLE[(i) & 7])                                \
                          : (((p)[(i) >> 3]) & ~CNXDNConvolution_BIT_MASK_TABLE[(i) & 7]))
-#define READ_BIT1(p, i) (((p)[(i) >> 3]) & CNXDNConvolution_BIT_MASK_TABLE[(i) & 7])
 
-static const uint8_t CNXDNConvolution_BRANCH_TABLE1[8] = {0U, 0U, 0U, 0U, 2U, 2U, 2U, 2U};
-static const uint8_t CNXDNConvolution_BRANCH_TABLE2[8] = {0U, 2U, 2U, 0U, 0U, 2U, 2U, 0U};
+static const unsigned int CNXDNConvolution_M = 4U;
 
-static const unsigned int CNXDNConvolution_NUM_OF_STATES_D2 = 8U;
-static const uint32_t CNXDNConvolution_M = 4U;
-static const unsigned int CNXDNConvolution_K = 5U;
+/* Soft metrics scale reliability (0..255) by 1/128, so a full mismatch costs twice M. */
+static const unsigned int CNXDNConvolution_SOFT_SCALE = 128U;
+static const unsigned int CNXDNConvolution_SOFT_M = (4U * 256U) / 128U;
 
-//NOTE:
-static uint16_t m_metrics1[16];
-static uint16_t m_metrics2[16];
-static uint64_t m_decisions[8 * 300];
-static uint16_t* m_oldMetrics = NULL;
-static uint16_t* m_newMetrics = NULL;
-static uint64_t* m_dp = NULL;
+/* Trellis behind the process-wide CNXDNConvolution_* calls. */
+static dsd_viterbi_k5 m_trellis;
 
 /* Functions ----------------------------------------------------------------*/
 
 void
-CNXDNConvolution_decode(uint8_t s0, uint8_t s1) {
-    *m_dp = 0U;
-
-    for (uint8_t i = 0U; i < CNXDNConvolution_NUM_OF_STATES_D2; i++) {
-        uint8_t j = i * 2U;
-        uint16_t metric = abs(CNXDNConvolution_BRANCH_TABLE1[i] - s0) + abs(CNXDNConvolution_BRANCH_TABLE2[i] - s1);
-
-        uint16_t m0 = m_oldMetrics[i] + metric;
-        uint16_t m1 = m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + (CNXDNConvolution_M - metric);
-        uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
-        m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
-
-        m0 = m_oldMetrics[i] + (CNXDNConvolution_M - metric);
-        m1 = m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + metric;
-        uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
-        m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
-
-        *m_dp |= ((uint64_t)(decision1) << (j + 1U)) | ((uint64_t)(decision0) << (j + 0U));
-    }
-
-    ++m_dp;
-
-    uint16_t* tmp = m_oldMetrics;
-    m_oldMetrics = m_newMetrics;
-    m_newMetrics = tmp;
+CNXDNConvolution_start_ctx(dsd_viterbi_k5* v) {
+    dsd_viterbi_k5_reset(v, CNXDNConvolution_M);
 }
 
 void
-CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits) {
-
-    uint32_t state = 0U;
-    while (nBits-- > 0) {
-        --m_dp;
-
-        uint32_t i = state >> (9 - CNXDNConvolution_K);
-        uint8_t bit = (uint8_t)(*m_dp >> i) & 1;
-        state = (bit << 7) | (state >> 1);
-
-        WRITE_BIT1(out, nBits, bit != 0U);
+CNXDNConvolution_decode_ctx(dsd_viterbi_k5* v, uint8_t s0, uint8_t s1) {
+    uint32_t bm[4];
+    for (unsigned int p = 0U; p < 4U; p++) {
+        bm[p] = (uint32_t)(abs((int)((p & 2U) ? 2U : 0U) - (int)s0) + abs((int)((p & 1U) ? 2U : 0U) - (int)s1));
     }
-}
-
-void
-CNXDNConvolution_start(void) {
-
-    m_oldMetrics = m_metrics1;
-    m_newMetrics = m_metrics2;
-    m_dp = m_decisions;
-}
-
-void
-CNXDNConvolution_init(void) {
-    DSD_MEMSET(m_metrics1, 0x0, sizeof(m_metrics1));
-    DSD_MEMSET(m_metrics2, 0x0, sizeof(m_metrics2));
-    DSD_MEMSET(m_decisions, 0x0, sizeof(m_decisions));
+    v->branch_full = CNXDNConvolution_M;
+    (void)dsd_viterbi_k5_step(v, bm);
 }
 
 /*
- * Soft-decision variant of CNXDNConvolution_decode.
+ * Soft-decision variant of CNXDNConvolution_decode_ctx.
  * s0, s1: observed soft values (0..2 range, as in hard version)
  * r0, r1: reliability weights (0..255, higher = more confident)
  *
  * The branch metric is scaled by reliability. Low reliability reduces
  * the penalty for mismatches, allowing the Viterbi to favor paths
- * through more reliable symbols.
+ * through more reliable symbols. Metrics past the full mismatch cost are
+ * clamped by the trellis, which keeps the complementary branch from
+ * underflowing.
  */
 void
-CNXDNConvolution_decode_soft(uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1) {
-    /* Scale factor: hard metric uses 0,2 range, scale reliability from 0-255 to 0-128 */
-    const uint32_t scale = 128;
-    const uint32_t full_metric = (CNXDNConvolution_M * 256U) / scale; /* 8 with current constants */
-
-    *m_dp = 0U;
-
-    for (uint8_t i = 0U; i < CNXDNConvolution_NUM_OF_STATES_D2; i++) {
-        uint8_t j = i * 2U;
-
-        /* Weighted branch metric: difference * reliability / scale */
-        uint32_t diff0 = (uint32_t)abs((int)CNXDNConvolution_BRANCH_TABLE1[i] - (int)s0);
-        uint32_t diff1 = (uint32_t)abs((int)CNXDNConvolution_BRANCH_TABLE2[i] - (int)s1);
-        uint32_t metric = ((diff0 * r0) + (diff1 * r1)) / scale;
+CNXDNConvolution_decode_soft_ctx(dsd_viterbi_k5* v, uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1) {
+    uint32_t bm[4];
+    for (unsigned int p = 0U; p < 4U; p++) {
+        const uint32_t diff0 = (uint32_t)abs((int)((p & 2U) ? 2U : 0U) - (int)s0);
+        const uint32_t diff1 = (uint32_t)abs((int)((p & 1U) ? 2U : 0U) - (int)s1);
+        bm[p] = ((diff0 * r0) + (diff1 * r1)) / CNXDNConvolution_SOFT_SCALE;
+    }
+    v->branch_full = CNXDNConvolution_SOFT_M;
+    (void)dsd_viterbi_k5_step(v, bm);
+}
 
-        /* Keep branch metric within the decoder's expected [0..M] domain.
-         * This also prevents unsigned underflow in the complementary metric. */
-        if (metric > full_metric) {
-            metric = full_metric;
-        }
+void
+CNXDNConvolution_chainback_ctx(const dsd_viterbi_k5* v, unsigned char* out, unsigned int nBits) {
+    uint8_t bits[DSD_VITERBI_K5_MAX_STEPS];
+    const size_t n = dsd_viterbi_k5_traceback(v, bits, nBits);
+    for (size_t j = 0; j < n; j++) {
+        WRITE_BIT1(out, ((size_t)nBits - n) + j, bits[j] != 0U);
+    }
+}
 
-        uint32_t m0 = m_oldMetrics[i] + metric;
-        uint32_t m1 = m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + (full_metric - metric);
-        uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
-        m_newMetrics[j + 0U] = (uint16_t)(decision0 != 0U ? m1 : m0);
+void
+CNXDNConvolution_decode(uint8_t s0, uint8_t s1) {
+    CNXDNConvolution_decode_ctx(&m_trellis, s0, s1);
+}
 
-        m0 = m_oldMetrics[i] + (full_metric - metric);
-        m1 = m_oldMetrics[i + CNXDNConvolution_NUM_OF_STATES_D2] + metric;
-        uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
-        m_newMetrics[j + 1U] = (uint16_t)(decision1 != 0U ? m1 : m0);
+void
+CNXDNConvolution_decode_soft(uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1) {
+    CNXDNConvolution_decode_soft_ctx(&m_trellis, s0, s1, r0, r1);
+}
 
-        *m_dp |= ((uint64_t)(decision1) << (j + 1U)) | ((uint64_t)(decision0) << (j + 0U));
-    }
+void
+CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits) {
+    CNXDNConvolution_chainback_ctx(&m_trellis, out, nBits);
+    /* Consume the traced steps, as the old decision pointer walk did. */
+    m_trellis.steps -= (nBits < m_trellis.steps) ? nBits : m_trellis.steps;
+}
 
-    ++m_dp;
+void
+CNXDNConvolution_start(void) {
+    CNXDNConvolution_start_ctx(&m_trellis);
+}
 
-    uint16_t* tmp = m_oldMetrics;
-    m_oldMetrics = m_newMetrics;
-    m_newMetrics = tmp;
+void
+CNXDNConvolution_init(void) {
+    CNXDNConvolution_start_ctx(&m_trellis);
+    DSD_MEMSET(m_trellis.decisions, 0x0, sizeof(m_trellis.decisions));
 }
@@ -31,6 +31,7 @@
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/core/synctype_ids.h>
 #include <dsd-neo/fec/trellis.h>
+#include <dsd-neo/fec/viterbi_k5.h>
 #include <dsd-neo/protocol/nxdn/nxdn.h>
 #include <dsd-neo/protocol/nxdn/nxdn_alias_decode.h>
 #include <dsd-neo/protocol/nxdn/nxdn_const.h>
@@ -184,15 +185,16 @@ nxdn_depuncture_12_group_rel(const uint8_t* deperm, const uint8_t* deperm_rel, s
 static void
 nxdn_conv_decode_soft(const uint8_t* depunc, const uint8_t* depunc_rel, size_t depunc_len, uint8_t* m_data,
                       int chainback_bits) {
-    CNXDNConvolution_start();
+    dsd_viterbi_k5 trellis;
+    CNXDNConvolution_start_ctx(&trellis);
     for (size_t i = 0; i < depunc_len / 2U; i++) {
         const uint8_t s0 = depunc[i * 2U] << 1;
         const uint8_t s1 = depunc[(i * 2U) + 1U] << 1;
         const uint8_t r0 = depunc_rel[i * 2U];
         const uint8_t r1 = depunc_rel[(i * 2U) + 1U];
-        CNXDNConvolution_decode_soft(s0, s1, r0, r1);
+        CNXDNConvolution_decode_soft_ctx(&trellis, s0, s1, r0, r1);
     }
-    CNXDNConvolution_chainback(m_data, chainback_bits);
+    CNXDNConvolution_chainback_ctx(&trellis, m_data, chainback_bits);
 }
 
 static void
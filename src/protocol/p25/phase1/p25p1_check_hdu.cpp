@@ -5,7 +5,6 @@
 #include <dsd-neo/protocol/p25/p25p1_soft.h>
 #include <stdint.h>
 #include <string.h>
-#include "dsd-neo/core/safe_api.h"
 
 static DSDGolay24 golay24;
 
@@ -53,6 +52,15 @@ check_and_fix_redsolomon_36_20_17_soft(char* data, const char* parity, const int
     return rs->decode_soft(data, parity, erasures, n_erasures);
 }
 
+int
+check_and_fix_redsolomon_36_20_17_ranked(char* data, const char* parity, const int* erasures, int n_ranked) {
+    const DSDReedSolomon_36_20_17* rs = reed_solomon_36_20_17_instance();
+    if (rs == nullptr) {
+        return 1;
+    }
+    return rs->decode_soft_ranked(data, parity, erasures, n_ranked);
+}
+
 int
 p25p1_rs_36_20_17_soft_reliability(char* data, const char* parity, const uint8_t* data_reliab,
                                    const uint8_t* parity_reliab) {
@@ -62,16 +70,5 @@ p25p1_rs_36_20_17_soft_reliability(char* data, const char* parity, const uint8_t
 
     int erasures[16];
     int n_ranked = p25p1_build_rs_ranked_erasures(data_reliab, 20, parity_reliab, 16, 8, erasures, 16);
-    char original_data[20 * 6];
-    DSD_MEMCPY(original_data, data, sizeof(original_data));
-
-    for (int n = 1; n <= n_ranked; n++) {
-        char candidate_data[20 * 6];
-        DSD_MEMCPY(candidate_data, original_data, sizeof(candidate_data));
-        if (check_and_fix_redsolomon_36_20_17_soft(candidate_data, parity, erasures, n) == 0) {
-            DSD_MEMCPY(data, candidate_data, sizeof(candidate_data));
-            return 0;
-        }
-    }
-    return 1;
+    return check_and_fix_redsolomon_36_20_17_ranked(data, parity, erasures, n_ranked);
 }
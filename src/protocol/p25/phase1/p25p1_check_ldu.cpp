@@ -4,7 +4,6 @@
 #include <dsd-neo/protocol/p25/p25p1_soft.h>
 #include <stdint.h>
 #include <string.h>
-#include "dsd-neo/core/safe_api.h"
 
 namespace {
 
@@ -52,6 +51,15 @@ check_and_fix_reedsolomon_24_12_13_soft(char* data, const char* parity, const in
     return rs->decode_soft(data, parity, erasures, n_erasures);
 }
 
+int
+check_and_fix_reedsolomon_24_12_13_ranked(char* data, const char* parity, const int* erasures, int n_ranked) {
+    const DSDReedSolomon_24_12_13* rs = reed_solomon_24_12_13_instance();
+    if (rs == nullptr) {
+        return 1;
+    }
+    return rs->decode_soft_ranked(data, parity, erasures, n_ranked);
+}
+
 int
 check_and_fix_reedsolomon_24_16_9(char* data, const char* parity) {
     const DSDReedSolomon_24_16_9* rs = reed_solomon_24_16_9_instance();
@@ -70,6 +78,15 @@ check_and_fix_reedsolomon_24_16_9_soft(char* data, const char* parity, const int
     return rs->decode_soft(data, parity, erasures, n_erasures);
 }
 
+int
+check_and_fix_reedsolomon_24_16_9_ranked(char* data, const char* parity, const int* erasures, int n_ranked) {
+    const DSDReedSolomon_24_16_9* rs = reed_solomon_24_16_9_instance();
+    if (rs == nullptr) {
+        return 1;
+    }
+    return rs->decode_soft_ranked(data, parity, erasures, n_ranked);
+}
+
 int
 p25p1_rs_24_16_9_soft_reliability(char* data, const char* parity, const uint8_t* data_reliab,
                                   const uint8_t* parity_reliab) {
@@ -79,16 +96,5 @@ p25p1_rs_24_16_9_soft_reliability(char* data, const char* parity, const uint8_t*
 
     int erasures[8];
     int n_ranked = p25p1_build_rs_ranked_erasures(data_reliab, 16, parity_reliab, 8, 4, erasures, 8);
-    char original_data[16 * 6];
-    DSD_MEMCPY(original_data, data, sizeof(original_data));
-
-    for (int n = 1; n <= n_ranked; n++) {
-        char candidate_data[16 * 6];
-        DSD_MEMCPY(candidate_data, original_data, sizeof(candidate_data));
-        if (check_and_fix_reedsolomon_24_16_9_soft(candidate_data, parity, erasures, n) == 0) {
-            DSD_MEMCPY(data, candidate_data, sizeof(candidate_data));
-            return 0;
-        }
-    }
-    return 1;
+    return check_and_fix_reedsolomon_24_16_9_ranked(data, parity, erasures, n_ranked);
 }
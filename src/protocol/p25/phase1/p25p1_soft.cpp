@@ -205,12 +205,36 @@ find_k_least_reliable(const int* reliab, int n, int k, int* out_indices) {
     }
 }
 
+/* Pack ten Hamming(10,6,3) bits, first bit most significant; -1 if any is not 0/1. */
+static int
+hamming_pack_word(const char* bits) {
+    unsigned int word = 0;
+    for (int i = 0; i < 10; i++) {
+        if (bits[i] != 0 && bits[i] != 1) {
+            return -1;
+        }
+        word = (word << 1) | (unsigned int)bits[i];
+    }
+    return (int)word;
+}
+
 static void
-hamming_encode_parity(const char data[6], char parity[4]) {
-    parity[0] = data[0] ^ data[1] ^ data[2] ^ data[5];
-    parity[1] = data[0] ^ data[1] ^ data[3] ^ data[5];
-    parity[2] = data[0] ^ data[2] ^ data[3] ^ data[4];
-    parity[3] = data[1] ^ data[2] ^ data[3] ^ data[4];
+hamming_unpack_word(unsigned int word, char* bits) {
+    for (int i = 0; i < 10; i++) {
+        bits[i] = (char)((word >> (9 - i)) & 1U);
+    }
+}
+
+/* Reliability cost of the bits that differ between two packed words. */
+static int
+hamming_flip_penalty(unsigned int diff, const int* reliab) {
+    int penalty = 0;
+    for (int i = 0; i < 10; i++) {
+        if ((diff >> (9 - i)) & 1U) {
+            penalty += clamp_reliability(reliab[i]);
+        }
+    }
+    return penalty;
 }
 
 /* Compute penalty for flipping bits: confident bits are expensive to flip. */
@@ -253,25 +277,24 @@ struct P25P1SoftHammingState {
 
 static void
 p25p1_hamming_seed_from_hard(const char* bits, const int* reliab, P25P1SoftHammingState* st) {
-    char hex[6], parity[4];
-    DSD_MEMCPY(hex, bits, 6);
-    DSD_MEMCPY(parity, bits + 6, 4);
-
-    int hard_result = hamming_10_6_3_decode(hex, parity);
+    const int word = hamming_pack_word(bits);
+    unsigned int data = 0;
+    if (word < 0) {
+        return;
+    }
+    int hard_result = hamming_10_6_3_decode_word((unsigned int)word, &data);
     if (hard_result != 0 && hard_result != 1) {
         return;
     }
 
-    char hard_parity[4];
-    DSD_MEMCPY(st->hard_candidate, hex, 6);
-    hamming_encode_parity(hex, hard_parity);
-    DSD_MEMCPY(st->hard_candidate + 6, hard_parity, 4);
+    const unsigned int hard_word = hamming_10_6_3_encode_word(data);
+    hamming_unpack_word(hard_word, st->hard_candidate);
 
     st->hard_valid = 1;
     st->hard_corrected = (hard_result == 1);
-    st->hard_penalty = compute_penalty(bits, st->hard_candidate, reliab, 10);
+    st->hard_penalty = hamming_flip_penalty(hard_word ^ (unsigned int)word, reliab);
     st->best_penalty = st->hard_penalty;
-    st->best_flips = count_differences(bits, st->hard_candidate, 10);
+    st->best_flips = dsd_popcount64(hard_word ^ (unsigned int)word);
     DSD_MEMCPY(st->best_candidate, st->hard_candidate, 10);
     st->found_valid = 1;
 }
@@ -279,26 +302,29 @@ p25p1_hamming_seed_from_hard(const char* bits, const int* reliab, P25P1SoftHammi
 static void
 p25p1_hamming_search_masked_candidates(const char* bits, const int* reliab, const int* least_rel,
                                        P25P1SoftHammingState* st) {
+    const int word = hamming_pack_word(bits);
+    if (word < 0) {
+        return;
+    }
     for (int mask = 0; mask < 32; mask++) {
-        char candidate[10];
-        DSD_MEMCPY(candidate, bits, 10);
-
+        unsigned int flips = 0;
         int num_flips = 0;
         for (int b = 0; b < 5; b++) {
             if (mask & (1 << b)) {
-                candidate[least_rel[b]] ^= 1;
+                flips ^= 1U << (9 - least_rel[b]);
                 num_flips++;
             }
         }
-        if (num_flips > 2 || hamming_10_6_3_decode(candidate, candidate + 6) != 0) {
+        const unsigned int candidate = (unsigned int)word ^ flips;
+        if (num_flips > 2 || hamming_10_6_3_decode_word(candidate, nullptr) != 0) {
             continue;
         }
 
-        int penalty = compute_penalty(bits, candidate, reliab, 10);
+        int penalty = hamming_flip_penalty(flips, reliab);
         if (penalty < st->best_penalty || (penalty == st->best_penalty && num_flips < st->best_flips)) {
             st->best_penalty = penalty;
             st->best_flips = num_flips;
-            DSD_MEMCPY(st->best_candidate, candidate, 10);
+            hamming_unpack_word(candidate, st->best_candidate);
             st->found_valid = 1;
         }
     }
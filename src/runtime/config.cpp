@@ -126,6 +126,11 @@ config_snapshot_equals_block_a(const dsdneoRuntimeConfig& lhs, const dsdneoRunti
     CONFIG_EQ_FIELD(cpu_dongle);
     CONFIG_EQ_FIELD(cpu_demod_is_set);
     CONFIG_EQ_FIELD(cpu_demod);
+    CONFIG_EQ_FIELD(rt_prio_dsp_is_set);
+    CONFIG_EQ_FIELD(rt_prio_dsp);
+    CONFIG_EQ_FIELD(cpu_dsp_is_set);
+    CONFIG_EQ_FIELD(cpu_dsp);
+    CONFIG_EQ_FIELD(cpu_dsp_count);
     return true;
 }
 
@@ -268,8 +273,22 @@ config_snapshot_equals_block_d(const dsdneoRuntimeConfig& lhs, const dsdneoRunti
     CONFIG_EQ_FIELD(audio_lpf_cutoff_hz);
     CONFIG_EQ_FIELD(mt_is_set);
     CONFIG_EQ_FIELD(mt_enable);
+    CONFIG_EQ_FIELD(mt_workers_is_set);
+    CONFIG_EQ_FIELD(mt_workers);
+    CONFIG_EQ_FIELD(demod_pipeline_is_set);
+    CONFIG_EQ_FIELD(demod_pipeline_enable);
+    CONFIG_EQ_FIELD(vocoder_thread_is_set);
+    CONFIG_EQ_FIELD(vocoder_thread_enable);
+    CONFIG_EQ_FIELD(audio_graph_is_set);
+    CONFIG_EQ_FIELD(audio_graph_enable);
+    CONFIG_EQ_FIELD(wav_async_is_set);
+    CONFIG_EQ_FIELD(wav_async_enable);
     CONFIG_EQ_FIELD(combine_rot_is_set);
     CONFIG_EQ_FIELD(combine_rot);
+    CONFIG_EQ_FIELD(ingest_hb_is_set);
+    CONFIG_EQ_FIELD(ingest_hb);
+    CONFIG_EQ_FIELD(input_ring_compact_is_set);
+    CONFIG_EQ_FIELD(input_ring_compact);
     CONFIG_EQ_FIELD(fs4_shift_disable_is_set);
     CONFIG_EQ_FIELD(fs4_shift_disable);
     CONFIG_EQ_FIELD(output_clear_on_retune_is_set);
@@ -278,10 +297,14 @@ config_snapshot_equals_block_d(const dsdneoRuntimeConfig& lhs, const dsdneoRunti
     CONFIG_EQ_FIELD(retune_drain_ms);
     CONFIG_EQ_FIELD(retune_mute_ms_is_set);
     CONFIG_EQ_FIELD(retune_mute_ms);
+    CONFIG_EQ_FIELD(output_wake_samples_is_set);
+    CONFIG_EQ_FIELD(output_wake_samples);
     CONFIG_EQ_FIELD(tcpin_backoff_ms_is_set);
     CONFIG_EQ_FIELD(tcpin_backoff_ms);
     CONFIG_EQ_FIELD(window_freeze_is_set);
     CONFIG_EQ_FIELD(window_freeze);
+    CONFIG_EQ_FIELD(sync_race_is_set);
+    CONFIG_EQ_FIELD(sync_race_enable);
     CONFIG_EQ_FIELD(pdu_json_is_set);
     CONFIG_EQ_FIELD(pdu_json_enable);
     CONFIG_EQ_FIELD(snr_sql_is_set);
@@ -407,6 +430,34 @@ env_parse_int_strict(const char* v, int* out) {
     return 1;
 }
 
+/* "N" or "N-M" (inclusive) CPU list; stores the first CPU and the span. */
+static int
+env_parse_cpu_range(const char* v, int* first, int* count) {
+    if (!env_is_set(v) || !first || !count) {
+        return 0;
+    }
+    errno = 0;
+    char* end = NULL;
+    long lo = strtol(v, &end, 10);
+    if (end == v || errno == ERANGE || lo < 0 || lo > 4096) {
+        return 0;
+    }
+    long hi = lo;
+    if (*end == '-') {
+        const char* rest = end + 1;
+        hi = strtol(rest, &end, 10);
+        if (end == rest || errno == ERANGE || hi < lo || hi > 4096) {
+            return 0;
+        }
+    }
+    if (*end != '\0') {
+        return 0;
+    }
+    *first = (int)lo;
+    *count = (int)(hi - lo + 1);
+    return 1;
+}
+
 static int
 env_parse_long_strict(const char* v, long* out) {
     if (!env_is_set(v) || !out) {
@@ -609,6 +660,12 @@ config_init_realtime_and_cpu(dsdneoRuntimeConfig& c) {
 
     const char* cpum = getenv("DSD_NEO_CPU_DEMOD");
     c.cpu_demod_is_set = env_parse_int_range(cpum, 0, 4096, &c.cpu_demod);
+
+    const char* rpx = getenv("DSD_NEO_RT_PRIO_DSP");
+    c.rt_prio_dsp_is_set = env_parse_int_range(rpx, 1, 99, &c.rt_prio_dsp);
+
+    const char* cpux = getenv("DSD_NEO_CPU_DSP");
+    c.cpu_dsp_is_set = env_parse_cpu_range(cpux, &c.cpu_dsp, &c.cpu_dsp_count);
 }
 
 static void
@@ -1110,6 +1167,25 @@ config_init_mt_and_retune(dsdneoRuntimeConfig& c) {
     c.mt_is_set = env_is_set(mt);
     c.mt_enable = (c.mt_is_set && mt[0] == '1') ? 1 : 0;
 
+    const char* mt_workers = getenv("DSD_NEO_MT_WORKERS");
+    c.mt_workers_is_set = env_parse_int_range(mt_workers, 1, 64, &c.mt_workers);
+
+    const char* demod_pipeline = getenv("DSD_NEO_DEMOD_PIPELINE");
+    c.demod_pipeline_is_set = env_is_set(demod_pipeline);
+    c.demod_pipeline_enable = (c.demod_pipeline_is_set && !env_is_falsey(demod_pipeline)) ? 1 : 0;
+
+    const char* vocoder_thread = getenv("DSD_NEO_VOCODER_THREAD");
+    c.vocoder_thread_is_set = env_is_set(vocoder_thread);
+    c.vocoder_thread_enable = (c.vocoder_thread_is_set && !env_is_falsey(vocoder_thread)) ? 1 : 0;
+
+    const char* audio_graph = getenv("DSD_NEO_AUDIO_GRAPH");
+    c.audio_graph_is_set = env_is_set(audio_graph);
+    c.audio_graph_enable = (c.audio_graph_is_set && !env_is_falsey(audio_graph)) ? 1 : 0;
+
+    const char* wav_async = getenv("DSD_NEO_WAV_ASYNC");
+    c.wav_async_is_set = env_is_set(wav_async);
+    c.wav_async_enable = (c.wav_async_is_set && !env_is_falsey(wav_async)) ? 1 : 0;
+
     /* Select the current combined CU8 transform or its supported two-pass equivalent. */
     const char* combine_rot = getenv("DSD_NEO_COMBINE_ROT");
     c.combine_rot_is_set = env_is_set(combine_rot);
@@ -1118,6 +1194,22 @@ config_init_mt_and_retune(dsdneoRuntimeConfig& c) {
         c.combine_rot = env_parse_int_strict(combine_rot, &value) ? (value != 0) : 0;
     }
 
+    /* Fuse the first half-band decimator into the USB ingest callback. */
+    const char* ingest_hb = getenv("DSD_NEO_INGEST_HB");
+    c.ingest_hb_is_set = env_is_set(ingest_hb);
+    if (c.ingest_hb_is_set) {
+        int value = 0;
+        c.ingest_hb = env_parse_int_strict(ingest_hb, &value) ? (value != 0) : 0;
+    }
+
+    /* Keep native capture samples in the input ring; widen on the demod thread. */
+    const char* ring_compact = getenv("DSD_NEO_INPUT_RING_COMPACT");
+    c.input_ring_compact_is_set = env_is_set(ring_compact);
+    if (c.input_ring_compact_is_set) {
+        int value = 0;
+        c.input_ring_compact = env_parse_int_strict(ring_compact, &value) ? (value != 0) : 0;
+    }
+
     /* Disable fs/4 capture shift */
     const char* dfs4 = getenv("DSD_NEO_DISABLE_FS4_SHIFT");
     c.fs4_shift_disable_is_set = env_is_set(dfs4);
@@ -1150,6 +1242,18 @@ config_init_mt_and_retune(dsdneoRuntimeConfig& c) {
             c.retune_mute_ms = v;
         }
     }
+
+    /* Output ring wake watermark (samples) */
+    const char* ows = getenv("DSD_NEO_OUTPUT_WAKE_SAMPLES");
+    c.output_wake_samples_is_set = 0;
+    c.output_wake_samples = 1;
+    if (env_is_set(ows)) {
+        int v = 0;
+        if (env_parse_int_strict(ows, &v) && v >= 1 && v <= 16384) {
+            c.output_wake_samples_is_set = 1;
+            c.output_wake_samples = v;
+        }
+    }
 }
 
 static void
@@ -1176,6 +1280,11 @@ config_init_tcpin_window_pdu_snr(dsdneoRuntimeConfig& c) {
         c.window_freeze = 0;
     }
 
+    /* Parallel SPS/modulation hypotheses during acquisition */
+    const char* sr = getenv("DSD_NEO_SYNC_RACE");
+    c.sync_race_is_set = env_is_set(sr);
+    c.sync_race_enable = (c.sync_race_is_set && !env_is_falsey(sr)) ? 1 : 0;
+
     /* Optional JSON emitter for P25 PDUs */
     const char* pj = getenv("DSD_NEO_PDU_JSON");
     c.pdu_json_is_set = env_is_set(pj);
@@ -9,12 +9,22 @@
 #include <dsd-neo/runtime/exitflag.h>
 #include <dsd-neo/runtime/input_ring.h>
 #include <dsd-neo/runtime/mem.h>
+#include <dsd-neo/runtime/ring_wake.h>
 #include "dsd-neo/core/safe_api.h"
 
 #ifdef USE_RADIO
 extern "C" int dsd_rtl_stream_should_exit(void);
 #endif
 
+static std::atomic<input_ring_widen_u8_fn> g_input_ring_widen_u8{nullptr};
+static std::atomic<input_ring_widen_s16_fn> g_input_ring_widen_s16{nullptr};
+
+void
+input_ring_set_widen_kernels(input_ring_widen_u8_fn u8_fn, input_ring_widen_s16_fn s16_fn) {
+    g_input_ring_widen_u8.store(u8_fn, std::memory_order_release);
+    g_input_ring_widen_s16.store(s16_fn, std::memory_order_release);
+}
+
 int
 input_ring_init(struct input_ring_state* r, size_t capacity) {
     if (!r || capacity == 0) {
@@ -49,10 +59,11 @@ input_ring_init(struct input_ring_state* r, size_t capacity) {
         return -1;
     }
 
+    r->storage = mem_ptr;
     r->buffer = static_cast<float*>(mem_ptr);
+    r->format = DSD_IQ_FORMAT_CF32;
     r->capacity = capacity;
-    r->head.store(0, std::memory_order_relaxed);
-    r->tail.store(0, std::memory_order_relaxed);
+    r->reset();
     r->space_notify_enabled.store(0, std::memory_order_relaxed);
     r->producer_drops.store(0, std::memory_order_relaxed);
     r->read_timeouts.store(0, std::memory_order_relaxed);
@@ -70,19 +81,45 @@ input_ring_destroy(struct input_ring_state* r) {
         (void)dsd_mutex_destroy(&r->ready_m);
         (void)dsd_cond_destroy(&r->ready);
     }
-    if (r->buffer) {
-        dsd_neo_aligned_free(r->buffer);
-        r->buffer = NULL;
+    if (r->storage) {
+        dsd_neo_aligned_free(r->storage);
     }
+    r->storage = NULL;
+    r->buffer = NULL;
+    r->format = DSD_IQ_FORMAT_CF32;
     r->capacity = 0;
-    r->head.store(0, std::memory_order_relaxed);
-    r->tail.store(0, std::memory_order_relaxed);
+    r->reset();
     r->space_notify_enabled.store(0, std::memory_order_relaxed);
     r->producer_drops.store(0, std::memory_order_relaxed);
     r->read_timeouts.store(0, std::memory_order_relaxed);
     r->discard_generation.store(0, std::memory_order_relaxed);
 }
 
+int
+input_ring_resize(struct input_ring_state* r, size_t capacity, dsd_iq_sample_format format) {
+    if (!r || capacity == 0 || r->capacity == 0) {
+        return -1;
+    }
+    if (format != DSD_IQ_FORMAT_CF32 && format != DSD_IQ_FORMAT_CU8 && format != DSD_IQ_FORMAT_CS16) {
+        return -1;
+    }
+    struct input_ring_state probe;
+    probe.format = format;
+    void* mem_ptr = dsd_neo_aligned_malloc(capacity * input_ring_elem_bytes(&probe));
+    if (!mem_ptr) {
+        return -1;
+    }
+    if (r->storage) {
+        dsd_neo_aligned_free(r->storage);
+    }
+    r->storage = mem_ptr;
+    r->format = format;
+    r->buffer = (format == DSD_IQ_FORMAT_CF32) ? static_cast<float*>(mem_ptr) : NULL;
+    r->capacity = capacity;
+    r->reset();
+    return 0;
+}
+
 void
 input_ring_enable_space_notify(struct input_ring_state* r, int enabled) {
     if (!r) {
@@ -91,6 +128,14 @@ input_ring_enable_space_notify(struct input_ring_state* r, int enabled) {
     r->space_notify_enabled.store(enabled ? 1 : 0, std::memory_order_relaxed);
 }
 
+void
+input_ring_set_wake_watermark(struct input_ring_state* r, size_t level) {
+    if (!r) {
+        return;
+    }
+    ring_wake_set_watermark(&r->wake, level);
+}
+
 /**
  * @brief Reserve writable regions in the input ring buffer.
  *
@@ -104,34 +149,31 @@ input_ring_enable_space_notify(struct input_ring_state* r, int enabled) {
  */
 int
 input_ring_reserve(struct input_ring_state* r, size_t min_needed, float** p1, size_t* n1, float** p2, size_t* n2) {
-    size_t free_sp = input_ring_free(r);
-    /* Producer must never advance consumer tail; if full, grant nothing */
-    /* Provide up to min(free_sp, min_needed) across at most two regions */
-    size_t grant = (min_needed < free_sp) ? min_needed : free_sp;
-    size_t h = r->head.load();
-
-    *p1 = NULL;
-    *n1 = 0;
-    *p2 = NULL;
-    *n2 = 0;
-
-    if (grant == 0) {
+    if (input_ring_is_compact(r)) {
+        *p1 = NULL;
+        *n1 = 0;
+        *p2 = NULL;
+        *n2 = 0;
         return 0;
     }
+    /* Producer must never advance consumer tail; if full, grant nothing */
+    return (int)r->write_reserve(min_needed, p1, n1, p2, n2);
+}
 
-    /* First region: from head to end of buffer */
-    *p1 = r->buffer + h;
-    size_t to_end = r->capacity - h;
-    if (to_end >= grant) {
-        *n1 = grant;
-        return (int)grant;
+static inline void*
+input_ring_storage_at(const struct input_ring_state* r, size_t index) {
+    if (!input_ring_is_compact(r)) {
+        return r->buffer + index;
     }
-    *n1 = to_end;
-
-    /* Second region: wrap around to beginning */
-    *p2 = r->buffer;
-    *n2 = grant - to_end;
+    return static_cast<unsigned char*>(r->storage) + index * input_ring_elem_bytes(r);
+}
 
+int
+input_ring_reserve_raw(struct input_ring_state* r, size_t min_needed, void** p1, size_t* n1, void** p2, size_t* n2) {
+    size_t start = 0;
+    size_t grant = r->write_reserve_index(min_needed, &start, n1, n2);
+    *p1 = (*n1 > 0) ? input_ring_storage_at(r, start) : NULL;
+    *p2 = (*n2 > 0) ? input_ring_storage_at(r, 0) : NULL;
     return (int)grant;
 }
 
@@ -146,18 +188,9 @@ input_ring_commit(struct input_ring_state* r, size_t produced) {
     if (produced == 0) {
         return;
     }
-    int need_signal = input_ring_is_empty(r);
-    size_t h = r->head.load();
-    h += produced;
-    if (h >= r->capacity) {
-        h -= r->capacity;
-    }
-    r->head.store(h);
-    if (need_signal) {
-        dsd_mutex_lock(&r->ready_m);
-        dsd_cond_signal(&r->ready);
-        dsd_mutex_unlock(&r->ready_m);
-    }
+    r->write_commit(produced);
+    /* One atomic load unless the consumer is actually asleep. */
+    ring_wake_notify(&r->wake, &r->ready, &r->ready_m, input_ring_used(r));
 }
 
 static int
@@ -168,9 +201,12 @@ input_ring_wait_for_data(struct input_ring_state* r) {
             return -1;
         }
 #endif
-        dsd_mutex_lock(&r->ready_m);
-        int ret = dsd_cond_timedwait(&r->ready, &r->ready_m, 10); /* 10ms */
-        dsd_mutex_unlock(&r->ready_m);
+        uint32_t token = ring_wake_prepare(&r->wake);
+        if (!input_ring_is_empty(r)) {
+            ring_wake_cancel(&r->wake);
+            break;
+        }
+        int ret = ring_wake_wait(&r->wake, &r->ready, &r->ready_m, token, RING_WAKE_IDLE_TIMEOUT_MS);
         if (ret != 0) {
             if (dsd_exitflag_load()) {
                 return -1;
@@ -188,10 +224,88 @@ input_ring_wait_for_data(struct input_ring_state* r) {
     return 0;
 }
 
+static void
+input_ring_widen_span(const struct input_ring_state* r, size_t index, float* out, size_t count) {
+    if (r->format == DSD_IQ_FORMAT_CU8) {
+        const unsigned char* src = static_cast<const unsigned char*>(input_ring_storage_at(r, index));
+        input_ring_widen_u8_fn fn = g_input_ring_widen_u8.load(std::memory_order_acquire);
+        if (fn) {
+            for (size_t done = 0; done < count;) {
+                size_t chunk = count - done;
+                if (chunk > UINT32_MAX) {
+                    chunk = UINT32_MAX;
+                }
+                fn(src + done, out + done, (uint32_t)chunk);
+                done += chunk;
+            }
+            return;
+        }
+        const float inv = 1.0f / 127.5f;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = ((float)src[i] - 127.5f) * inv;
+        }
+    } else if (r->format == DSD_IQ_FORMAT_CS16) {
+        const int16_t* src = static_cast<const int16_t*>(input_ring_storage_at(r, index));
+        input_ring_widen_s16_fn fn = g_input_ring_widen_s16.load(std::memory_order_acquire);
+        if (fn) {
+            for (size_t done = 0; done < count;) {
+                size_t chunk = count - done;
+                if (chunk > UINT32_MAX) {
+                    chunk = UINT32_MAX;
+                }
+                fn(src + done, out + done, (uint32_t)chunk);
+                done += chunk;
+            }
+            return;
+        }
+        const float scale = 1.0f / 32768.0f;
+        for (size_t i = 0; i < count; i++) {
+            out[i] = (float)src[i] * scale;
+        }
+    } else {
+        DSD_MEMCPY(out, input_ring_storage_at(r, index), count * sizeof(float));
+    }
+}
+
+static void
+input_ring_notify_space(struct input_ring_state* r) {
+    if (r->space_notify_enabled.load(std::memory_order_relaxed)) {
+        dsd_mutex_lock(&r->ready_m);
+        dsd_cond_signal(&r->space);
+        dsd_mutex_unlock(&r->ready_m);
+    }
+}
+
+int
+input_ring_read_convert(struct input_ring_state* r, float* out, size_t max_count) {
+    if (!r || !out) {
+        return -1;
+    }
+    if (max_count == 0) {
+        return 0;
+    }
+    if (input_ring_wait_for_data(r) != 0) {
+        return -1;
+    }
+
+    size_t start = 0;
+    size_t n1 = 0;
+    size_t n2 = 0;
+    size_t got = r->read_reserve_index(max_count, &start, &n1, &n2);
+    input_ring_widen_span(r, start, out, n1);
+    if (n2 > 0) {
+        input_ring_widen_span(r, 0, out + n1, n2);
+    }
+    r->read_commit(got);
+    input_ring_notify_space(r);
+    return (int)got;
+}
+
 /**
  * @brief Read up to max_count samples from the input ring, blocking until data is available.
  *
  * Returns -1 when an exit condition is observed while waiting for data.
+ * Compact rings are widened to float on the way out.
  *
  * @param r         Input ring buffer state.
  * @param out       Destination buffer for samples.
@@ -203,33 +317,7 @@ input_ring_read_block(struct input_ring_state* r, float* out, size_t max_count)
     if (max_count == 0) {
         return 0;
     }
-    if (input_ring_wait_for_data(r) != 0) {
-        return -1;
-    }
-
-    size_t available = input_ring_used(r);
-    size_t read_now = (max_count < available) ? max_count : available;
-    size_t t = r->tail.load();
-    size_t first = r->capacity - t;
-    if (first >= read_now) {
-        DSD_MEMCPY(out, r->buffer + t, read_now * sizeof(float));
-        t += read_now;
-        if (t >= r->capacity) {
-            t = 0;
-        }
-    } else {
-        DSD_MEMCPY(out, r->buffer + t, first * sizeof(float));
-        DSD_MEMCPY(out + first, r->buffer, (read_now - first) * sizeof(float));
-        t = read_now - first;
-    }
-    r->tail.store(t);
-    if (r->space_notify_enabled.load(std::memory_order_relaxed)) {
-        dsd_mutex_lock(&r->ready_m);
-        dsd_cond_signal(&r->space);
-        dsd_mutex_unlock(&r->ready_m);
-    }
-
-    return (int)read_now;
+    return input_ring_read_convert(r, out, max_count);
 }
 
 int
@@ -241,6 +329,9 @@ input_ring_read_reserve(struct input_ring_state* r, size_t max_count, float** p1
     *n1 = 0;
     *p2 = NULL;
     *n2 = 0;
+    if (input_ring_is_compact(r)) {
+        return -1;
+    }
     if (max_count == 0) {
         return 0;
     }
@@ -249,21 +340,7 @@ input_ring_read_reserve(struct input_ring_state* r, size_t max_count, float** p1
         return -1;
     }
 
-    size_t available = input_ring_used(r);
-    size_t reserve_now = (max_count < available) ? max_count : available;
-    size_t t = r->tail.load();
-    size_t first = r->capacity - t;
-    if (first >= reserve_now) {
-        *p1 = r->buffer + t;
-        *n1 = reserve_now;
-    } else {
-        *p1 = r->buffer + t;
-        *n1 = first;
-        *p2 = r->buffer;
-        *n2 = reserve_now - first;
-    }
-
-    return (int)reserve_now;
+    return (int)r->read_reserve(max_count, p1, n1, p2, n2);
 }
 
 void
@@ -272,19 +349,10 @@ input_ring_read_commit(struct input_ring_state* r, size_t consumed) {
         return;
     }
 
-    size_t available = input_ring_used(r);
+    size_t available = r->read_space(consumed);
     if (consumed > available) {
         consumed = available;
     }
-    size_t t = r->tail.load();
-    t += consumed;
-    while (t >= r->capacity) {
-        t -= r->capacity;
-    }
-    r->tail.store(t);
-    if (r->space_notify_enabled.load(std::memory_order_relaxed)) {
-        dsd_mutex_lock(&r->ready_m);
-        dsd_cond_signal(&r->space);
-        dsd_mutex_unlock(&r->ready_m);
-    }
+    r->read_commit(consumed);
+    input_ring_notify_space(r);
 }
@@ -676,7 +676,7 @@ dsd_rdio_finalize_meta_file(FILE* fp, const char* temp_meta_path, const char* ou
 }
 
 static int
-dsd_rdio_write_trunk_recorder_meta(const dsd_opts* opts, const Event_History_I* event_struct, const char* wav_path,
+dsd_rdio_write_trunk_recorder_meta(const dsd_opts* opts, const Event_History* event, const char* wav_path,
                                    char* out_meta_path, size_t out_meta_path_size) {
     if (!opts || !wav_path || wav_path[0] == '\0') {
         return -1;
@@ -687,7 +687,6 @@ dsd_rdio_write_trunk_recorder_meta(const dsd_opts* opts, const Event_History_I*
         return -1;
     }
 
-    const Event_History* event = event_struct ? &event_struct->Event_History_Items[0] : NULL;
     dsd_rdio_meta_fields fields;
     dsd_rdio_meta_fields_from_event(event, &fields);
     if (fields.talkgroup == 0U) {
@@ -923,6 +922,11 @@ dsd_rdio_mode_to_string(int mode) {
 
 int
 dsd_rdio_export_call(const dsd_opts* opts, const Event_History_I* event_struct, const char* wav_path) {
+    return dsd_rdio_export_event(opts, event_struct ? &event_struct->Event_History_Items[0] : NULL, wav_path);
+}
+
+int
+dsd_rdio_export_event(const dsd_opts* opts, const Event_History* event, const char* wav_path) {
     if (!opts || !wav_path || wav_path[0] == '\0') {
         return -1;
     }
@@ -937,7 +941,7 @@ dsd_rdio_export_call(const dsd_opts* opts, const Event_History_I* event_struct,
     }
 
     char meta_path[DSD_RDIO_PATH_MAX];
-    if (dsd_rdio_write_trunk_recorder_meta(opts, event_struct, wav_path, meta_path, sizeof(meta_path)) != 0) {
+    if (dsd_rdio_write_trunk_recorder_meta(opts, event, wav_path, meta_path, sizeof(meta_path)) != 0) {
         return -1;
     }
 
@@ -27,9 +27,7 @@ ring_read_batch(struct output_state* o, float* out, size_t max_count) {
         if (!o->buffer) {
             return -1;
         }
-        dsd_mutex_lock(&o->ready_m);
-        int ret = dsd_cond_timedwait(&o->ready, &o->ready_m, 10);
-        dsd_mutex_unlock(&o->ready_m);
+        int ret = ring_wait_ready(o, RING_WAKE_IDLE_TIMEOUT_MS);
         if (ret != 0) {
             if (dsd_exitflag_load() || !o->buffer) {
                 return -1;
@@ -38,15 +36,7 @@ ring_read_batch(struct output_state* o, float* out, size_t max_count) {
         }
     }
 
-    size_t used = ring_used(o);
-    size_t read_count = (used < max_count) ? used : max_count;
-    size_t t = o->tail.load();
-    size_t to_end = o->capacity - t;
-    size_t first = (read_count < to_end) ? read_count : to_end;
-    DSD_MEMCPY(out, o->buffer + t, first * sizeof(float));
-    DSD_MEMCPY(out + first, o->buffer, (read_count - first) * sizeof(float));
-    t = (t + read_count) % o->capacity;
-    o->tail.store(t);
+    size_t read_count = o->read(out, max_count);
     dsd_mutex_lock(&o->ready_m);
     dsd_cond_signal(&o->space);
     dsd_mutex_unlock(&o->ready_m);
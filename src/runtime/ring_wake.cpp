@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/**
+ * @file
+ * @brief Futex/condvar consumer wakeups for the sample rings.
+ *
+ * Ordering: the producer publishes its head index and then loads `waiters`;
+ * the consumer increments `waiters` and then re-reads the head. Both sides use
+ * sequentially consistent operations, so at least one of them sees the other
+ * and a wakeup cannot be lost between the consumer's check and its sleep.
+ */
+
+#include <atomic>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/runtime/ring_wake.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define RING_WAKE_HAVE_FUTEX 1
+#else
+#define RING_WAKE_HAVE_FUTEX 0
+#endif
+
+#if RING_WAKE_HAVE_FUTEX
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit integer");
+
+static uint32_t*
+ring_wake_futex_word(struct ring_wake* w) {
+    return reinterpret_cast<uint32_t*>(&w->seq);
+}
+#endif
+
+static void
+ring_wake_deliver(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex, int broadcast_cond) {
+    w->seq.fetch_add(1U);
+#if RING_WAKE_HAVE_FUTEX
+    (void)syscall(SYS_futex, ring_wake_futex_word(w), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    if (!broadcast_cond) {
+        return;
+    }
+#else
+    (void)broadcast_cond;
+#endif
+    if (cond && mutex) {
+        dsd_mutex_lock(mutex);
+        dsd_cond_broadcast(cond);
+        dsd_mutex_unlock(mutex);
+    }
+}
+
+void
+ring_wake_set_watermark(struct ring_wake* w, size_t level) {
+    if (!w) {
+        return;
+    }
+    w->watermark.store(level > 0U ? level : 1U, std::memory_order_relaxed);
+}
+
+void
+ring_wake_notify(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex, size_t ready) {
+    if (!w || w->waiters.load() == 0) {
+        return;
+    }
+    size_t level = w->watermark.load(std::memory_order_relaxed);
+    if (ready < (level > 0U ? level : 1U)) {
+        return;
+    }
+    ring_wake_deliver(w, cond, mutex, 0);
+}
+
+void
+ring_wake_signal(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex) {
+    if (!w) {
+        return;
+    }
+    /* Also broadcast the condvar on the futex path: a few waiters (replay
+     * pacing, drain loops) still sleep on the ring's condvar directly. */
+    ring_wake_deliver(w, cond, mutex, 1);
+}
+
+uint32_t
+ring_wake_prepare(struct ring_wake* w) {
+    uint32_t token = w->seq.load();
+    w->waiters.fetch_add(1);
+    return token;
+}
+
+void
+ring_wake_cancel(struct ring_wake* w) {
+    w->waiters.fetch_sub(1);
+}
+
+int
+ring_wake_wait(struct ring_wake* w, dsd_cond_t* cond, dsd_mutex_t* mutex, uint32_t token, unsigned int timeout_ms) {
+    int timed_out = 0;
+#if RING_WAKE_HAVE_FUTEX
+    (void)cond;
+    (void)mutex;
+    struct timespec ts;
+    ts.tv_sec = (time_t)(timeout_ms / 1000U);
+    ts.tv_nsec = (long)(timeout_ms % 1000U) * 1000000L;
+    if (w->seq.load() == token) {
+        long rc = syscall(SYS_futex, ring_wake_futex_word(w), FUTEX_WAIT_PRIVATE, token, &ts, NULL, 0);
+        timed_out = (rc != 0 && errno == ETIMEDOUT) ? 1 : 0;
+    }
+#else
+    dsd_mutex_lock(mutex);
+    while (w->seq.load() == token) {
+        if (dsd_cond_timedwait(cond, mutex, timeout_ms) != 0) {
+            timed_out = (w->seq.load() == token) ? 1 : 0;
+            break;
+        }
+    }
+    dsd_mutex_unlock(mutex);
+#endif
+    w->waiters.fetch_sub(1);
+    return timed_out;
+}
@@ -48,14 +48,22 @@ resolve_role_rt_priority(const dsdneoRuntimeConfig* cfg, const char* role) {
     if (strcmp(role, "DEMOD") == 0 && cfg->rt_prio_demod_is_set) {
         return cfg->rt_prio_demod;
     }
+    if (strcmp(role, "DSP") == 0 && cfg->rt_prio_dsp_is_set) {
+        return cfg->rt_prio_dsp;
+    }
     return 0;
 }
 
 static int
-resolve_role_cpu_affinity(const dsdneoRuntimeConfig* cfg, const char* role) {
+resolve_role_cpu_affinity_indexed(const dsdneoRuntimeConfig* cfg, const char* role, int index) {
     if (!cfg || !role) {
         return -1;
     }
+    /* Pool roles spread their workers across a CPU range. */
+    if (strcmp(role, "DSP") == 0 && cfg->cpu_dsp_is_set) {
+        int span = (cfg->cpu_dsp_count > 0) ? cfg->cpu_dsp_count : 1;
+        return cfg->cpu_dsp + ((index > 0) ? index : 0) % span;
+    }
     if (strcmp(role, "USB") == 0 && cfg->cpu_usb_is_set) {
         return cfg->cpu_usb;
     }
@@ -81,7 +89,12 @@ dsd_neo_rt_sched_test_resolve_role_rt_priority(const dsdneoRuntimeConfig* cfg, c
 
 int
 dsd_neo_rt_sched_test_resolve_role_cpu_affinity(const dsdneoRuntimeConfig* cfg, const char* role) {
-    return resolve_role_cpu_affinity(cfg, role);
+    return resolve_role_cpu_affinity_indexed(cfg, role, 0);
+}
+
+int
+dsd_neo_rt_sched_test_resolve_role_cpu_affinity_indexed(const dsdneoRuntimeConfig* cfg, const char* role, int index) {
+    return resolve_role_cpu_affinity_indexed(cfg, role, index);
 }
 #endif
 
@@ -97,6 +110,20 @@ dsd_neo_rt_sched_test_resolve_role_cpu_affinity(const dsdneoRuntimeConfig* cfg,
  */
 void
 maybe_set_thread_realtime_and_affinity(const char* role) {
+    maybe_set_worker_realtime_and_affinity(role, 0);
+}
+
+/**
+ * @brief Per-worker variant of maybe_set_thread_realtime_and_affinity().
+ *
+ * Roles with a CPU range (`DSD_NEO_CPU_DSP=N-M`) pin worker `index` to
+ * `N + index % (M - N + 1)`; single-CPU roles ignore the index.
+ *
+ * @param role Optional role label (e.g. "DSP").
+ * @param index Zero-based worker index within the role.
+ */
+void
+maybe_set_worker_realtime_and_affinity(const char* role, int index) {
     const dsdneoRuntimeConfig* cfg = runtime_config_ready();
     const char* label = role_or_default(role);
     if (!cfg || !cfg->rt_sched_enable) {
@@ -113,7 +140,7 @@ maybe_set_thread_realtime_and_affinity(const char* role) {
         LOG_INFO("%s thread realtime priority set to %d.\n", label, priority);
     }
 
-    int cpu = resolve_role_cpu_affinity(cfg, role);
+    int cpu = resolve_role_cpu_affinity_indexed(cfg, role, index);
     if (cpu >= 0) {
         if (dsd_thread_set_affinity(cpu) != 0) {
             int err = errno;
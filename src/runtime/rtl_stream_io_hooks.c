@@ -5,7 +5,9 @@
 
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/runtime/rtl_stream_io_hooks.h>
+#include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "dsd-neo/core/state_fwd.h"
 
@@ -32,6 +34,43 @@ dsd_rtl_stream_io_hook_read(dsd_state* state, float* out, size_t count, int* out
     return g_rtl_stream_io_hooks.read((void*)state->rtl_ctx, out, count, out_got_ptr);
 }
 
+int
+dsd_rtl_stream_io_hook_read_block(dsd_state* state, float* out, size_t count, int* out_got) {
+    int got_tmp = 0;
+    int* out_got_ptr = out_got ? out_got : &got_tmp;
+    *out_got_ptr = 0;
+
+    if (!state || !out || count == 0) {
+        return -1;
+    }
+
+    /* getSymbol() may have pulled a span ahead into the symbol cache; hand those
+     * samples out first so a block reader never skips or reorders the stream. */
+    int pending = state->rtl_symbol_cache_len - state->rtl_symbol_cache_pos;
+    if (pending > 0) {
+        if (dsd_rtl_stream_metrics_hook_stream_generation() == state->rtl_symbol_cache_generation) {
+            size_t take = (count < (size_t)pending) ? count : (size_t)pending;
+            for (size_t i = 0; i < take; i++) {
+                out[i] = state->rtl_symbol_cache[state->rtl_symbol_cache_pos + (int)i];
+            }
+            state->rtl_symbol_cache_pos += (int)take;
+            pending -= (int)take;
+            *out_got_ptr = (int)take;
+        } else {
+            state->rtl_symbol_cache_pos = 0;
+            state->rtl_symbol_cache_len = 0;
+            pending = 0;
+        }
+        dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(pending - state->rtl_symbol_cache_published_pending);
+        state->rtl_symbol_cache_published_pending = pending;
+        if (*out_got_ptr > 0) {
+            return 0;
+        }
+    }
+
+    return dsd_rtl_stream_io_hook_read(state, out, count, out_got_ptr);
+}
+
 double
 dsd_rtl_stream_io_hook_return_pwr(const dsd_state* state) {
     if (!state || !state->rtl_ctx) {
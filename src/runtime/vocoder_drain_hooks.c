@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+#include <dsd-neo/runtime/vocoder_drain_hooks.h>
+
+#include "dsd-neo/core/opts_fwd.h"
+#include "dsd-neo/core/state_fwd.h"
+
+static dsd_vocoder_drain_hooks g_vocoder_drain_hooks = {0};
+
+void
+dsd_vocoder_drain_hooks_set(dsd_vocoder_drain_hooks hooks) {
+    g_vocoder_drain_hooks = hooks;
+}
+
+int
+dsd_vocoder_drain_hook_pending(const dsd_state* state, int slot) {
+    if (g_vocoder_drain_hooks.pending) {
+        return g_vocoder_drain_hooks.pending(state, slot);
+    }
+    return 0;
+}
+
+void
+dsd_vocoder_drain_hook_drain(dsd_opts* opts, dsd_state* state, int slot) {
+    if (g_vocoder_drain_hooks.drain) {
+        g_vocoder_drain_hooks.drain(opts, state, slot);
+    }
+}
@@ -5,227 +5,400 @@
 
 /**
  * @file
- * @brief Minimal 2-thread worker pool for intra-block demodulation tasks.
+ * @brief Shared work-stealing DSP task pool.
  *
- * Provides a tiny env-gated pool (set `DSD_NEO_MT=1`) addressed by `demod_state*`.
- * Used to run up to two inner-loop tasks in parallel per processing block.
+ * One pool serves the whole process (`DSD_NEO_MT=1`). Every owner that
+ * acquires it (each demodulator pipeline, decoder-side users) shares the same
+ * bounded set of workers, so N dongles no longer mean N pairs of threads.
+ *
+ * Each worker owns a deque. Tasks submitted from outside the pool are dealt
+ * round-robin onto the deques; tasks submitted from a worker go onto its own
+ * deque. A worker pops its own deque from the back (most recent, cache-warm)
+ * and steals from the front of the others when it runs dry. The deques are
+ * short and touched a few times per block, so each is guarded by its own
+ * mutex rather than a lock-free Chase-Lev structure.
+ *
+ * Sleep/wake: `queued` counts tasks not yet taken and is raised before a task
+ * becomes visible. Idle workers re-check it under the pool lock before
+ * sleeping and submitters take that lock to signal, so a wakeup cannot be
+ * lost. Fork-join groups count down `pending`; the last task broadcasts
+ * `done_cv`.
  */
 
+#include <atomic>
+#include <deque>
 #include <dsd-neo/platform/threading.h>
 #include <dsd-neo/runtime/config.h>
+#include <dsd-neo/runtime/rt_sched.h>
 #include <dsd-neo/runtime/worker_pool.h>
 #include <mutex>
 #include <new>
 #include <stdio.h>
-#include <stdlib.h>
-#include <unordered_map>
-#include <utility>
+#include <thread>
+#include <unordered_set>
 #include "dsd-neo/core/safe_api.h"
 #include "dsd-neo/platform/platform.h"
 
 namespace {
 
-/* Opaque handle keyed off demod_state* to avoid depending on its layout here */
-struct WorkerCtx;
+constexpr int kPoolMaxWorkers = 64;
+
+struct PoolGroup {
+    std::atomic<int> pending{0};
+};
 
-struct WorkerArg {
-    WorkerCtx* ctx = nullptr;
-    int id = 0;
+struct PoolTask {
+    demod_mt_task task;
+    PoolGroup* group;
 };
 
-struct WorkerCtx {
-    bool enabled = false;
-    dsd_thread_t threads[2] = {};
-    WorkerArg* args = nullptr;
+struct Pool;
+
+struct alignas(64) PoolWorker {
+    Pool* pool = nullptr;
+    int index = 0;
+    dsd_thread_t thread = {};
     dsd_mutex_t lock = {};
-    dsd_cond_t cv = {};
-    dsd_cond_t done_cv = {};
-    bool should_exit = false;
-    int epoch = 0;
-    int completed_in_epoch = 0;
-    int posted_count = 0;
+    std::deque<PoolTask> tasks;
+};
 
-    demod_mt_task tasks[2] = {};
+struct Pool {
+    int nworkers = 0;
+    PoolWorker* workers = nullptr;
+    std::atomic<int> queued{0};
+    std::atomic<unsigned> next_worker{0U};
+    dsd_mutex_t lock = {};
+    dsd_cond_t work_cv = {};
+    dsd_cond_t done_cv = {};
+    int started = 0;          /* threads to join */
+    int sleepers = 0;         /* guarded by lock */
+    bool should_exit = false; /* guarded by lock */
 };
 
-std::unordered_map<const void*, WorkerCtx*> g_ctx_map;
-std::mutex g_ctx_mu;
+std::atomic<Pool*> g_pool{nullptr};
+std::unordered_set<const void*> g_pool_owners;
+std::mutex g_pool_mu;
+
+/* The worker the calling thread is, if any. */
+thread_local PoolWorker* t_pool_worker = nullptr;
 
 } // namespace
 
-static WorkerCtx*
-get_ctx(const void* key) {
-    std::lock_guard<std::mutex> lg(g_ctx_mu);
-    auto it = g_ctx_map.find(key);
-    return (it == g_ctx_map.end()) ? nullptr : it->second;
+static int
+pool_enabled(void) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (!cfg) {
+        dsd_neo_config_init();
+        cfg = dsd_neo_get_config();
+    }
+    return (cfg && cfg->mt_is_set && cfg->mt_enable) ? 1 : 0;
+}
+
+/* DSD_NEO_MT_WORKERS, else half the host's hardware threads within [2, 8]. */
+static int
+pool_worker_count(void) {
+    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
+    if (cfg && cfg->mt_workers_is_set && cfg->mt_workers > 0) {
+        return (cfg->mt_workers < kPoolMaxWorkers) ? cfg->mt_workers : kPoolMaxWorkers;
+    }
+    int n = (int)(std::thread::hardware_concurrency() / 2U);
+    if (n < 2) {
+        n = 2;
+    }
+    return (n > 8) ? 8 : n;
+}
+
+static int
+pool_take(Pool* pool, int self, PoolTask* out) {
+    const int n = pool->nworkers;
+    if (self >= 0) {
+        PoolWorker& w = pool->workers[self];
+        dsd_mutex_lock(&w.lock);
+        if (!w.tasks.empty()) {
+            *out = w.tasks.back();
+            w.tasks.pop_back();
+            dsd_mutex_unlock(&w.lock);
+            pool->queued.fetch_sub(1);
+            return 1;
+        }
+        dsd_mutex_unlock(&w.lock);
+    }
+    const int base = (self >= 0) ? self : 0;
+    for (int k = 1; k <= n; k++) {
+        const int victim = (base + k) % n;
+        if (victim == self) {
+            continue;
+        }
+        PoolWorker& v = pool->workers[victim];
+        dsd_mutex_lock(&v.lock);
+        if (!v.tasks.empty()) {
+            *out = v.tasks.front();
+            v.tasks.pop_front();
+            dsd_mutex_unlock(&v.lock);
+            pool->queued.fetch_sub(1);
+            return 1;
+        }
+        dsd_mutex_unlock(&v.lock);
+    }
+    return 0;
+}
+
+static void
+pool_execute(Pool* pool, const PoolTask& t) {
+    t.task.run(t.task.arg);
+    if (t.group && t.group->pending.fetch_sub(1) == 1) {
+        dsd_mutex_lock(&pool->lock);
+        dsd_cond_broadcast(&pool->done_cv);
+        dsd_mutex_unlock(&pool->lock);
+    }
 }
 
 static void
-set_ctx(const void* key, WorkerCtx* ctx) {
-    std::lock_guard<std::mutex> lg(g_ctx_mu);
-    if (ctx) {
-        g_ctx_map[key] = ctx;
-    } else {
-        g_ctx_map.erase(key);
+pool_submit(Pool* pool, const demod_mt_task* tasks, int count, PoolGroup* group) {
+    int pushed = 0;
+    PoolWorker* self = (t_pool_worker && t_pool_worker->pool == pool) ? t_pool_worker : nullptr;
+    for (int i = 0; i < count; i++) {
+        if (!tasks[i].run) {
+            continue;
+        }
+        PoolWorker& w = self ? *self : pool->workers[pool->next_worker.fetch_add(1U) % (unsigned)pool->nworkers];
+        pool->queued.fetch_add(1);
+        dsd_mutex_lock(&w.lock);
+        w.tasks.push_back(PoolTask{tasks[i], group});
+        dsd_mutex_unlock(&w.lock);
+        pushed++;
     }
+    if (pushed == 0) {
+        return;
+    }
+    dsd_mutex_lock(&pool->lock);
+    if (pool->sleepers > 0) {
+        if (pushed > 1) {
+            dsd_cond_broadcast(&pool->work_cv);
+        } else {
+            dsd_cond_signal(&pool->work_cv);
+        }
+    }
+    dsd_mutex_unlock(&pool->lock);
 }
 
 static DSD_THREAD_RETURN_TYPE
 #if DSD_PLATFORM_WIN_NATIVE
     __stdcall
 #endif
-    demod_mt_worker(void* arg) {
-    WorkerArg* wa = static_cast<WorkerArg*>(arg);
-    WorkerCtx* ctx = wa->ctx;
-    const int id = wa->id;
-    int local_epoch = 0;
+    dsp_pool_worker(void* arg) {
+    PoolWorker* self = static_cast<PoolWorker*>(arg);
+    Pool* pool = self->pool;
+    t_pool_worker = self;
+    maybe_set_worker_realtime_and_affinity("DSP", self->index);
     for (;;) {
-        dsd_mutex_lock(&ctx->lock);
-        while (!ctx->should_exit && ctx->epoch == local_epoch) {
-            dsd_cond_wait(&ctx->cv, &ctx->lock);
+        PoolTask t;
+        if (pool_take(pool, self->index, &t)) {
+            pool_execute(pool, t);
+            continue;
         }
-        if (ctx->should_exit) {
-            dsd_mutex_unlock(&ctx->lock);
-            break;
+        dsd_mutex_lock(&pool->lock);
+        while (pool->queued.load() <= 0 && !pool->should_exit) {
+            pool->sleepers++;
+            dsd_cond_wait(&pool->work_cv, &pool->lock);
+            pool->sleepers--;
         }
-        local_epoch = ctx->epoch;
-        void (*fn)(void*) = nullptr;
-        void* fn_arg = nullptr;
-        bool assigned = id < ctx->posted_count;
-        if (assigned) {
-            fn = ctx->tasks[id].run;
-            fn_arg = ctx->tasks[id].arg;
+        /* Drain detached posts before leaving. */
+        bool done = pool->should_exit && pool->queued.load() <= 0;
+        dsd_mutex_unlock(&pool->lock);
+        if (done) {
+            break;
         }
-        dsd_mutex_unlock(&ctx->lock);
-        if (fn) {
-            fn(fn_arg);
+    }
+    t_pool_worker = nullptr;
+    DSD_THREAD_RETURN;
+}
+
+static void
+pool_shutdown(Pool* pool) {
+    dsd_mutex_lock(&pool->lock);
+    pool->should_exit = true;
+    dsd_cond_broadcast(&pool->work_cv);
+    dsd_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->started; i++) {
+        dsd_thread_join(pool->workers[i].thread);
+    }
+    for (int i = 0; i < pool->nworkers; i++) {
+        dsd_mutex_destroy(&pool->workers[i].lock);
+    }
+    dsd_cond_destroy(&pool->done_cv);
+    dsd_cond_destroy(&pool->work_cv);
+    dsd_mutex_destroy(&pool->lock);
+    delete[] pool->workers;
+    delete pool;
+}
+
+static Pool*
+pool_start(int nworkers) {
+    Pool* pool = new (std::nothrow) Pool;
+    if (!pool) {
+        return nullptr;
+    }
+    pool->workers = new (std::nothrow) PoolWorker[nworkers];
+    if (!pool->workers) {
+        DSD_FPRINTF(stderr, "Failed to allocate DSP worker pool\n");
+        delete pool;
+        return nullptr;
+    }
+    dsd_mutex_init(&pool->lock);
+    dsd_cond_init(&pool->work_cv);
+    dsd_cond_init(&pool->done_cv);
+    for (int i = 0; i < nworkers; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        dsd_mutex_init(&pool->workers[i].lock);
+    }
+    pool->nworkers = nworkers;
+    for (int i = 0; i < nworkers; i++) {
+        if (dsd_thread_create(&pool->workers[i].thread, dsp_pool_worker, static_cast<void*>(&pool->workers[i])) != 0) {
+            DSD_FPRINTF(stderr, "Failed to start DSP worker %d of %d\n", i + 1, nworkers);
+            pool_shutdown(pool);
+            return nullptr;
         }
-        dsd_mutex_lock(&ctx->lock);
-        if (assigned) {
-            ctx->completed_in_epoch++;
-            if (ctx->completed_in_epoch >= ctx->posted_count) {
-                dsd_cond_signal(&ctx->done_cv);
-            }
+        pool->started++;
+    }
+    return pool;
+}
+
+int
+dsp_pool_acquire(const void* owner) {
+    if (!owner || !pool_enabled()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lg(g_pool_mu);
+    Pool* pool = g_pool.load(std::memory_order_relaxed);
+    if (!pool) {
+        pool = pool_start(pool_worker_count());
+        if (!pool) {
+            return 0;
         }
-        dsd_mutex_unlock(&ctx->lock);
+        g_pool.store(pool, std::memory_order_release);
+        DSD_FPRINTF(stderr, "Intra-block multithreading enabled (DSD_NEO_MT=1), shared DSP workers: %d.\n",
+                    pool->nworkers);
     }
-    DSD_THREAD_RETURN;
+    g_pool_owners.insert(owner);
+    return pool->nworkers;
 }
 
-/**
- * @brief Initialize the minimal worker pool when `DSD_NEO_MT=1`.
- *
- * Safe to call multiple times per demodulator instance.
- * @param s Demodulator state used as a key for the worker context.
- * @note No-op when multithreading is disabled via environment.
- */
 void
-demod_mt_init(struct demod_state* s) {
-    const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
-    if (!cfg) {
-        dsd_neo_config_init();
-        cfg = dsd_neo_get_config();
+dsp_pool_release(const void* owner) {
+    std::lock_guard<std::mutex> lg(g_pool_mu);
+    if (g_pool_owners.erase(owner) == 0 || !g_pool_owners.empty()) {
+        return;
     }
-    bool enable = (cfg && cfg->mt_is_set && cfg->mt_enable) ? true : false;
-    if (!enable) {
-        // No context needed if disabled
-        set_ctx(static_cast<const void*>(s), nullptr);
+    Pool* pool = g_pool.exchange(nullptr, std::memory_order_acq_rel);
+    if (pool) {
+        pool_shutdown(pool);
+    }
+}
+
+int
+dsp_pool_size(void) {
+    Pool* pool = g_pool.load(std::memory_order_acquire);
+    return pool ? pool->nworkers : 0;
+}
+
+void
+dsp_pool_run(const demod_mt_task* tasks, int count) {
+    if (!tasks || count <= 0) {
+        return;
+    }
+    Pool* pool = g_pool.load(std::memory_order_acquire);
+    if (!pool) {
+        for (int i = 0; i < count; i++) {
+            if (tasks[i].run) {
+                tasks[i].run(tasks[i].arg);
+            }
+        }
         return;
     }
-    WorkerCtx* ctx = get_ctx(static_cast<const void*>(s));
-    if (ctx) {
-        return; // already initialized
+    PoolGroup group;
+    int live = 0;
+    for (int i = 0; i < count; i++) {
+        live += tasks[i].run ? 1 : 0;
+    }
+    if (live == 0) {
+        return;
     }
-    ctx = new (std::nothrow) WorkerCtx;
-    if (!ctx) {
+    group.pending.store(live);
+    pool_submit(pool, tasks, count, &group);
+
+    PoolWorker* self = (t_pool_worker && t_pool_worker->pool == pool) ? t_pool_worker : nullptr;
+    if (!self) {
+        dsd_mutex_lock(&pool->lock);
+        while (group.pending.load() > 0) {
+            dsd_cond_wait(&pool->done_cv, &pool->lock);
+        }
+        dsd_mutex_unlock(&pool->lock);
         return;
     }
-    ctx->enabled = true;
-    ctx->should_exit = false;
-    ctx->epoch = 0;
-    ctx->completed_in_epoch = 0;
-    ctx->posted_count = 0;
-    dsd_mutex_init(&ctx->lock);
-    dsd_cond_init(&ctx->cv);
-    dsd_cond_init(&ctx->done_cv);
-    ctx->args = static_cast<WorkerArg*>(calloc(2, sizeof(WorkerArg)));
-    if (ctx->args == NULL) {
-        DSD_FPRINTF(stderr, "Failed to allocate worker thread arguments\n");
-        dsd_mutex_destroy(&ctx->lock);
-        dsd_cond_destroy(&ctx->cv);
-        dsd_cond_destroy(&ctx->done_cv);
-        delete ctx;
+    /* Nested fork-join: keep the worker busy instead of parking it. */
+    while (group.pending.load() > 0) {
+        PoolTask t;
+        if (pool_take(pool, self->index, &t)) {
+            pool_execute(pool, t);
+            continue;
+        }
+        dsd_mutex_lock(&pool->lock);
+        if (group.pending.load() > 0) {
+            (void)dsd_cond_timedwait(&pool->done_cv, &pool->lock, 1U);
+        }
+        dsd_mutex_unlock(&pool->lock);
+    }
+}
+
+void
+dsp_pool_post(demod_mt_task task) {
+    if (!task.run) {
         return;
     }
-    for (int i = 0; i < 2; i++) {
-        ctx->args[i].ctx = ctx;
-        ctx->args[i].id = i;
-        dsd_thread_create(&ctx->threads[i], demod_mt_worker, static_cast<void*>(&ctx->args[i]));
+    Pool* pool = g_pool.load(std::memory_order_acquire);
+    if (!pool) {
+        task.run(task.arg);
+        return;
     }
-    set_ctx(static_cast<const void*>(s), ctx);
-    DSD_FPRINTF(stderr, "Intra-block multithreading enabled (DSD_NEO_MT=1), workers: 2.\n");
+    pool_submit(pool, &task, 1, nullptr);
+}
+
+/**
+ * @brief Attach a demodulator to the shared pool when `DSD_NEO_MT=1`.
+ *
+ * Safe to call multiple times per demodulator instance.
+ * @param s Demodulator state used as the pool owner.
+ * @note No-op when multithreading is disabled via environment.
+ */
+void
+demod_mt_init(struct demod_state* s) {
+    (void)dsp_pool_acquire(static_cast<const void*>(s));
 }
 
 /**
- * @brief Tear down worker threads created by `demod_mt_init`.
+ * @brief Detach a demodulator from the shared pool.
  *
- * @param s Demodulator state used as a key for the worker context.
+ * @param s Demodulator state used as the pool owner.
  * @note Safe no-op if the pool was never enabled/initialized.
  */
 void
 demod_mt_destroy(struct demod_state* s) {
-    WorkerCtx* ctx = get_ctx(static_cast<const void*>(s));
-    if (!ctx || !ctx->enabled) {
-        set_ctx(static_cast<const void*>(s), nullptr);
-        return;
-    }
-    dsd_mutex_lock(&ctx->lock);
-    ctx->should_exit = true;
-    dsd_cond_broadcast(&ctx->cv);
-    dsd_mutex_unlock(&ctx->lock);
-    for (int i = 0; i < 2; i++) {
-        dsd_thread_join(ctx->threads[i]);
-    }
-    dsd_cond_destroy(&ctx->done_cv);
-    dsd_cond_destroy(&ctx->cv);
-    dsd_mutex_destroy(&ctx->lock);
-    free(ctx->args);
-    ctx->args = nullptr;
-    delete ctx;
-    set_ctx(static_cast<const void*>(s), nullptr);
+    dsp_pool_release(static_cast<const void*>(s));
 }
 
 /**
- * @brief Post up to two tasks and wait for completion.
+ * @brief Run up to two tasks on the shared pool and wait for completion.
  *
  * Runs synchronously in the caller thread when the pool is disabled.
- * @param s Demodulator state key for the worker context.
- * @param f0 Function pointer for the first task (may be NULL).
- * @param a0 Argument for the first task.
- * @param f1 Function pointer for the second task (may be NULL).
- * @param a1 Argument for the second task.
+ * @param s Demodulator state (kept for API compatibility).
+ * @param task0 First task (`run` may be NULL).
+ * @param task1 Second task (`run` may be NULL).
  */
 void
 demod_mt_run_two_impl(struct demod_state* s, demod_mt_task task0, demod_mt_task task1) {
-    WorkerCtx* ctx = get_ctx(static_cast<const void*>(s));
-    if (!ctx || !ctx->enabled) {
-        if (task0.run) {
-            task0.run(task0.arg);
-        }
-        if (task1.run) {
-            task1.run(task1.arg);
-        }
-        return;
-    }
-    dsd_mutex_lock(&ctx->lock);
-    ctx->tasks[0] = task0;
-    ctx->tasks[1] = task1;
-    ctx->posted_count = (task1.run != NULL) ? 2 : 1;
-    ctx->completed_in_epoch = 0;
-    ctx->epoch++;
-    dsd_cond_broadcast(&ctx->cv);
-    while (ctx->completed_in_epoch < ctx->posted_count) {
-        dsd_cond_wait(&ctx->done_cv, &ctx->lock);
-    }
-    dsd_mutex_unlock(&ctx->lock);
+    (void)s;
+    const demod_mt_task tasks[2] = {task0, task1};
+    dsp_pool_run(tasks, 2);
 }
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * dsd_bitvec must agree bit for bit with the char-per-bit loops it replaces:
+ * packing, octet conversion (including the pack_ambe()/unpack_ambe() layout),
+ * field extract/insert across the word boundary, and keystream XOR at
+ * arbitrary bit offsets with a zero tail past the keystream buffer.
+ */
+
+#include <dsd-neo/core/bit_packing.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+
+static int g_failures = 0;
+static uint32_t g_rng = 0x13579BDFu;
+
+static uint32_t
+next_rand(void) {
+    g_rng = (g_rng * 1664525u) + 1013904223u;
+    return g_rng >> 8;
+}
+
+static void
+expect_true(const char* tag, int cond) {
+    if (!cond) {
+        DSD_FPRINTF(stderr, "%s: failed\n", tag);
+        g_failures++;
+    }
+}
+
+static void
+random_bits(char* bits, uint32_t len) {
+    for (uint32_t i = 0U; i < len; i++) {
+        bits[i] = (char)(next_rand() & 1U);
+    }
+}
+
+static int
+ref_ks_bit(const uint8_t* ks, size_t ks_bytes, size_t pos) {
+    return ((pos >> 3U) < ks_bytes) ? ((ks[pos >> 3U] >> (7U - (pos & 7U))) & 1U) : 0;
+}
+
+static void
+test_bits_round_trip(void) {
+    static const uint32_t lens[] = {0U, 1U, 7U, 8U, 49U, 63U, 64U, 65U, 72U, 88U, 128U};
+    for (size_t n = 0U; n < sizeof(lens) / sizeof(lens[0]); n++) {
+        char in[128];
+        char out[128];
+        random_bits(in, lens[n]);
+        dsd_bitvec v;
+        dsd_bitvec_from_bits(&v, in, lens[n]);
+        expect_true("round trip length", v.len == lens[n]);
+        DSD_MEMSET(out, 7, sizeof(out));
+        dsd_bitvec_to_bits(&v, out);
+        expect_true("round trip bits", memcmp(in, out, lens[n]) == 0);
+        expect_true("round trip leaves the tail", lens[n] == 128U || out[lens[n]] == 7);
+        for (uint32_t i = 0U; i < lens[n]; i++) {
+            expect_true("get single bit", dsd_bitvec_get(&v, i, 1U) == (uint64_t)in[i]);
+        }
+        expect_true("tail reads zero", dsd_bitvec_get(&v, lens[n], 1U) == 0U);
+    }
+
+    /* Only the low bit of each element counts, as in the pack/unpack helpers. */
+    char noisy[16];
+    for (int i = 0; i < 16; i++) {
+        noisy[i] = (char)(0x10 | (i & 1));
+    }
+    dsd_bitvec v;
+    dsd_bitvec_from_bits(&v, noisy, 16U);
+    expect_true("low bit only", dsd_bitvec_get(&v, 0U, 16U) == 0x5555U);
+}
+
+static void
+test_octets_match_pack_ambe_layout(void) {
+    for (int trial = 0; trial < 64; trial++) {
+        char bits[49];
+        random_bits(bits, 49U);
+        uint8_t want[7] = {0};
+        for (int i = 0; i < 49; i++) {
+            want[i / 8] = (uint8_t)((want[i / 8] << 1) | (uint8_t)bits[i]);
+        }
+        want[6] = (uint8_t)(want[6] << 7);
+
+        dsd_bitvec v;
+        uint8_t got[8];
+        DSD_MEMSET(got, 0xA5, sizeof(got));
+        dsd_bitvec_from_bits(&v, bits, 49U);
+        expect_true("octet count", dsd_bitvec_to_octets(&v, got, sizeof(got)) == 7U);
+        expect_true("octets", memcmp(got, want, sizeof(want)) == 0);
+        expect_true("octets stop at len", got[7] == 0xA5);
+
+        uint8_t packed[7] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+        pack_ambe(bits, packed, 49);
+        expect_true("pack_ambe", memcmp(packed, want, sizeof(want)) == 0);
+
+        char unpacked[49];
+        unpack_ambe(want, unpacked);
+        expect_true("unpack_ambe", memcmp(unpacked, bits, sizeof(bits)) == 0);
+
+        /* Octets past len are ignored when loading. */
+        uint8_t dirty[7];
+        DSD_MEMCPY(dirty, want, sizeof(dirty));
+        dirty[6] |= 0x7FU;
+        dsd_bitvec_from_octets(&v, dirty, 49U);
+        expect_true("from octets trims", dsd_bitvec_get(&v, 48U, 16U) == (uint64_t)bits[48] << 15);
+    }
+}
+
+static void
+test_set_across_words(void) {
+    for (int trial = 0; trial < 500; trial++) {
+        char bits[88];
+        random_bits(bits, 88U);
+        dsd_bitvec v;
+        dsd_bitvec_from_bits(&v, bits, 88U);
+        const uint32_t width = 1U + (next_rand() % 64U);
+        const uint32_t pos = next_rand() % 100U;
+        const uint64_t value = ((uint64_t)next_rand() << 40) ^ ((uint64_t)next_rand() << 16) ^ next_rand();
+        dsd_bitvec_set(&v, pos, width, value);
+        for (uint32_t i = 0U; i < width && pos + i < 88U; i++) {
+            bits[pos + i] = (char)((value >> (width - 1U - i)) & 1U);
+        }
+        char got[88];
+        dsd_bitvec_to_bits(&v, got);
+        expect_true("set", memcmp(got, bits, sizeof(bits)) == 0);
+        expect_true("set keeps the tail clear", dsd_bitvec_get(&v, 88U, 40U) == 0U);
+        if (pos + width <= 88U) {
+            const uint64_t mask = (width == 64U) ? ~0ULL : ((1ULL << width) - 1U);
+            expect_true("get after set", dsd_bitvec_get(&v, pos, width) == (value & mask));
+        }
+    }
+}
+
+static void
+test_xor_octets_offsets(void) {
+    uint8_t ks[24];
+    for (size_t i = 0U; i < sizeof(ks); i++) {
+        ks[i] = (uint8_t)next_rand();
+    }
+    for (size_t offset = 0U; offset < 8U * sizeof(ks) + 16U; offset += 3U) {
+        char bits[88];
+        char want[88];
+        random_bits(bits, 88U);
+        for (size_t i = 0U; i < 88U; i++) {
+            want[i] = (char)(bits[i] ^ ref_ks_bit(ks, sizeof(ks), offset + i));
+        }
+        dsd_bitvec v;
+        dsd_bitvec_from_bits(&v, bits, 88U);
+        dsd_bitvec_xor_octets(&v, ks, sizeof(ks), offset);
+        char got[88];
+        dsd_bitvec_to_bits(&v, got);
+        expect_true("xor octets", memcmp(got, want, sizeof(want)) == 0);
+        expect_true("xor octets keeps the tail clear", dsd_bitvec_get(&v, 88U, 40U) == 0U);
+    }
+
+    dsd_bitvec a;
+    dsd_bitvec b;
+    char x[49];
+    char y[49];
+    random_bits(x, 49U);
+    random_bits(y, 49U);
+    dsd_bitvec_from_bits(&a, x, 49U);
+    dsd_bitvec_from_bits(&b, y, 49U);
+    dsd_bitvec_xor(&a, &b);
+    for (uint32_t i = 0U; i < 49U; i++) {
+        expect_true("xor", dsd_bitvec_get(&a, i, 1U) == (uint64_t)(x[i] ^ y[i]));
+    }
+}
+
+int
+main(void) {
+    test_bits_round_trip();
+    test_octets_match_pack_ambe_layout();
+    test_set_across_words();
+    test_xor_octets_offsets();
+
+    if (g_failures != 0) {
+        DSD_FPRINTF(stderr, "BIT_PACKING_BITVEC: %d failure(s)\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
@@ -26,6 +26,7 @@
 #include "core/audio/dsd_audio_internal.h"
 #include "dsd-neo/core/audio.h"
 #include "dsd-neo/core/audio_filters.h"
+#include "dsd-neo/core/audio_graph.h"
 #include "dsd-neo/core/file_io.h"
 #include "dsd-neo/core/opts_fwd.h"
 #include "dsd-neo/core/safe_api.h"
@@ -34,6 +35,7 @@
 #include "dsd-neo/platform/audio.h"
 #include "dsd-neo/platform/file_compat.h"
 #include "dsd-neo/runtime/log.h"
+#include "dsd-neo/runtime/config.h"
 #include "dsd-neo/runtime/p25_p2_audio_ring.h"
 #include "dsd-neo/runtime/udp_audio_hooks.h"
 
@@ -177,6 +179,17 @@ audio_mono_to_stereo_f32(const float* in, float* out, size_t n) {
     }
 }
 
+void
+audio_f32_to_s16(const float* in, size_t n, short* out) {
+    if (!in || !out) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        const float v = in[i] * 32768.0f;
+        out[i] = (short)(v > 32767.0f ? 32767.0f : (v < -32768.0f ? -32768.0f : v));
+    }
+}
+
 void
 audio_mix_interleave_stereo_f32(const float* left, const float* right, size_t n, int encL, int encR,
                                 float* stereo_out) {
@@ -281,6 +294,57 @@ dsd_write(int fd, const void* buf, size_t count) {
     return (ssize_t)count;
 }
 
+/* DSD_NEO_AUDIO_GRAPH stays off here: the mixers take their direct output paths. */
+const dsdneoRuntimeConfig*
+dsd_neo_get_config(void) {
+    return NULL;
+}
+
+void
+dsd_audio_output_lock(void) {}
+
+void
+dsd_audio_output_unlock(void) {}
+
+dsd_audio_graph*
+dsd_audio_graph_create(const dsd_audio_graph_config* cfg) {
+    (void)cfg;
+    return NULL;
+}
+
+void
+dsd_audio_graph_destroy(dsd_audio_graph* g) {
+    (void)g;
+}
+
+int
+dsd_audio_graph_submit(dsd_audio_graph* g, uint64_t key, const float block[DSD_AUDIO_GRAPH_BLOCK]) {
+    (void)g;
+    (void)key;
+    (void)block;
+    return -1;
+}
+
+void
+dsd_audio_graph_close_stream(dsd_audio_graph* g, uint64_t key) {
+    (void)g;
+    (void)key;
+}
+
+void
+dsd_audio_stream_params_default(dsd_audio_stream_params* params) {
+    DSD_MEMSET(params, 0, sizeof(*params));
+    params->gain = 1.0f;
+}
+
+int
+dsd_audio_graph_open_stream(dsd_audio_graph* g, uint64_t key, const dsd_audio_stream_params* params) {
+    (void)g;
+    (void)key;
+    (void)params;
+    return -1;
+}
+
 int
 dsd_dmr_missing_alg_key_can_decrypt(const dsd_state* state, int slot) {
     (void)state;
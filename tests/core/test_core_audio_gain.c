@@ -396,51 +396,63 @@ test_audio_mix_helpers_apply_channel_gates(void) {
 }
 
 static int
-test_upsample_repeats_into_selected_slot_buffer(void) {
-    static dsd_state state;
-    DSD_MEMSET(&state, 0, sizeof(state));
-
-    static float left[6];
-    static float right[6];
-    for (int i = 0; i < 6; i++) {
-        left[i] = -1.0f;
-        right[i] = -2.0f;
-    }
-    state.audio_out_float_buf_p = left;
-    state.audio_out_float_buf_pR = right;
-    upsample(&state, 1.25f);
-
+test_upsample_block_interpolates_with_history(void) {
+    static float hist[DSD_UPSAMPLE_PHASE_TAPS - 1];
+    static float in[160];
+    static float out[960];
     int rc = 0;
-    for (int i = 0; i < 6; i++) {
+
+    /* Each branch has unity DC gain: a constant settles to itself once the window is full. */
+    DSD_MEMSET(hist, 0, sizeof(hist));
+    for (int i = 0; i < 160; i++) {
+        in[i] = 1000.0f;
+    }
+    upsample_block(hist, in, 160, out);
+    for (int i = (DSD_UPSAMPLE_PHASE_TAPS - 1) * DSD_UPSAMPLE_FACTOR; i < 960; i++) {
         char label[64];
-        DSD_SNPRINTF(label, sizeof label, "upsample left repeat %d", i);
-        rc |= expect_float_close(label, left[i], 1.25f, 1e-6f);
-        DSD_SNPRINTF(label, sizeof label, "upsample right unchanged %d", i);
-        rc |= expect_float_close(label, right[i], -2.0f, 1e-6f);
+        DSD_SNPRINTF(label, sizeof label, "upsample dc %d", i);
+        if (expect_float_close(label, out[i], 1000.0f, 0.05f)) {
+            rc = 1;
+            break;
+        }
     }
 
-    DSD_MEMSET(&state, 0, sizeof(state));
-    for (int i = 0; i < 6; i++) {
-        left[i] = -1.0f;
-        right[i] = -2.0f;
+    /* A 1 kHz tone comes out as the same tone at 48 kHz, 47.5 output samples late. */
+    DSD_MEMSET(hist, 0, sizeof(hist));
+    for (int i = 0; i < 160; i++) {
+        in[i] = 1000.0f * sinf(2.0f * 3.14159265f * 1000.0f * (float)i / 8000.0f);
     }
-    state.audio_out_float_buf_p = left;
-    state.audio_out_float_buf_pR = right;
-    state.dmr_stereo = 1;
-    state.currentslot = 1;
-    upsample(&state, -0.5f);
-
-    for (int i = 0; i < 6; i++) {
+    upsample_block(hist, in, 160, out);
+    for (int i = 120; i < 960; i++) {
+        const float want = 1000.0f * sinf(2.0f * 3.14159265f * 1000.0f * ((float)i - 47.5f) / 48000.0f);
         char label[64];
-        DSD_SNPRINTF(label, sizeof label, "upsample stereo left unchanged %d", i);
-        rc |= expect_float_close(label, left[i], -1.0f, 1e-6f);
-        DSD_SNPRINTF(label, sizeof label, "upsample stereo right repeat %d", i);
-        rc |= expect_float_close(label, right[i], -0.5f, 1e-6f);
+        DSD_SNPRINTF(label, sizeof label, "upsample tone %d", i);
+        if (expect_float_close(label, out[i], want, 10.0f)) {
+            rc = 1;
+            break;
+        }
     }
 
-    upsample(NULL, 9.0f);
-    state.audio_out_float_buf_pR = NULL;
-    upsample(&state, 9.0f);
+    /* Two half blocks with the carried history match one whole block. */
+    static float hist_split[DSD_UPSAMPLE_PHASE_TAPS - 1];
+    static float out_split[960];
+    DSD_MEMSET(hist, 0, sizeof(hist));
+    DSD_MEMSET(hist_split, 0, sizeof(hist_split));
+    upsample_block(hist, in, 160, out);
+    upsample_block(hist_split, in, 80, out_split);
+    upsample_block(hist_split, in + 80, 80, out_split + 480);
+    for (int i = 0; i < 960; i++) {
+        if (expect_float_close("upsample split block", out_split[i], out[i], 1e-3f)) {
+            rc = 1;
+            break;
+        }
+    }
+    for (int i = 0; i < DSD_UPSAMPLE_PHASE_TAPS - 1; i++) {
+        rc |= expect_float_close("upsample split history", hist_split[i], hist[i], 0.0f);
+    }
+
+    upsample_block(NULL, in, 160, out);
+    upsample_block(hist, in, 0, out);
     return rc;
 }
 
@@ -678,20 +690,18 @@ test_process_audio_upsampled_left_clamps_and_tracks_output(void) {
     state.audio_out_float_buf = out_float;
     state.audio_out_buf_p = state.audio_out_buf;
     state.audio_out_float_buf_p = state.audio_out_float_buf;
-    state.audio_out_temp_buf[0] = 40000.0f;
-    state.audio_out_temp_buf[1] = -40000.0f;
-    state.audio_out_temp_buf[2] = 123.0f;
+    for (int i = 0; i < 160; i++) {
+        state.audio_out_temp_buf[i] = 40000.0f;
+    }
 
     processAudio(&opts, &state);
 
     int rc = 0;
-    rc |= expect_int_eq("left upsample clamp positive first", out[0], 32767);
-    rc |= expect_int_eq("left upsample clamp positive repeat", out[5], 32767);
-    rc |= expect_int_eq("left upsample clamp negative first", out[6], -32768);
-    rc |= expect_int_eq("left upsample clamp negative repeat", out[11], -32768);
-    rc |= expect_int_eq("left upsample repeated sample", out[12], 123);
-    rc |= expect_int_eq("left upsample mirror positive", state.s_lu[0], 32767);
-    rc |= expect_int_eq("left upsample mirror negative", state.s_lu[6], -32768);
+    rc |= expect_int_eq("left upsample clamp settled", out[480], 32767);
+    rc |= expect_int_eq("left upsample clamp last", out[959], 32767);
+    rc |= expect_float_close("left upsample float clamped in place", out_float[959], 32767.0f, 0.0f);
+    rc |= expect_int_eq("left upsample mirror settled", state.s_lu[480], 32767);
+    rc |= expect_int_eq("left upsample mirror first", state.s_lu[0], out[0]);
     rc |= expect_int_eq("left upsample index", state.audio_out_idx, 960);
     rc |= expect_int_eq("left upsample long index", state.audio_out_idx2, 960);
     rc |= expect_true("left upsample output pointer advanced", state.audio_out_buf_p == state.audio_out_buf + 960);
@@ -720,20 +730,18 @@ test_process_audio_upsampled_right_clamps_and_tracks_output(void) {
     state.audio_out_float_bufR = out_float;
     state.audio_out_buf_pR = state.audio_out_bufR;
     state.audio_out_float_buf_pR = state.audio_out_float_bufR;
-    state.audio_out_temp_bufR[0] = 50000.0f;
-    state.audio_out_temp_bufR[1] = -50000.0f;
-    state.audio_out_temp_bufR[2] = -321.0f;
+    for (int i = 0; i < 160; i++) {
+        state.audio_out_temp_bufR[i] = -50000.0f;
+    }
 
     processAudioR(&opts, &state);
 
     int rc = 0;
-    rc |= expect_int_eq("right upsample clamp positive first", out[0], 32767);
-    rc |= expect_int_eq("right upsample clamp positive repeat", out[5], 32767);
-    rc |= expect_int_eq("right upsample clamp negative first", out[6], -32768);
-    rc |= expect_int_eq("right upsample clamp negative repeat", out[11], -32768);
-    rc |= expect_int_eq("right upsample repeated sample", out[12], -321);
-    rc |= expect_int_eq("right upsample mirror positive", state.s_ru[0], 32767);
-    rc |= expect_int_eq("right upsample mirror negative", state.s_ru[6], -32768);
+    rc |= expect_int_eq("right upsample clamp settled", out[480], -32768);
+    rc |= expect_int_eq("right upsample clamp last", out[959], -32768);
+    rc |= expect_float_close("right upsample float clamped in place", out_float[959], -32768.0f, 0.0f);
+    rc |= expect_int_eq("right upsample mirror settled", state.s_ru[480], -32768);
+    rc |= expect_int_eq("right upsample mirror first", state.s_ru[0], out[0]);
     rc |= expect_int_eq("right upsample index", state.audio_out_idxR, 960);
     rc |= expect_int_eq("right upsample long index", state.audio_out_idx2R, 960);
     rc |= expect_true("right upsample output pointer advanced", state.audio_out_buf_pR == state.audio_out_bufR + 960);
@@ -1201,7 +1209,7 @@ main(void) {
     rc |= test_audio_apply_gain_f32_multiplies_block();
     rc |= test_audio_mono_to_stereo_duplicates_samples();
     rc |= test_audio_mix_helpers_apply_channel_gates();
-    rc |= test_upsample_repeats_into_selected_slot_buffer();
+    rc |= test_upsample_block_interpolates_with_history();
     rc |= test_manual_and_float_autogain_helpers();
     rc |= test_agf_scales_nonzero_float_block_and_updates_slot_gain();
     rc |= test_process_audio_native_left_clamps_and_tracks_output();
@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit test: audio graph streams prebuffer to the jitter depth, mix with
+ * their gain/pan (clipped), feed their own sinks, play out what they queued
+ * after close or idle, count underruns, hold the producer instead of dropping
+ * when a jitter buffer is full, and the file sink writes 16-bit little-endian
+ * PCM.
+ */
+
+#include <dsd-neo/core/audio_graph.h>
+#include <dsd-neo/platform/file_compat.h>
+#include <dsd-neo/platform/timing.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+#include "test_support.h"
+
+enum { CAPTURE_BLOCKS = 64, THREADED_BLOCKS = DSD_AUDIO_GRAPH_QUEUE_BLOCKS + 4 };
+
+typedef struct {
+    float samples[CAPTURE_BLOCKS][2 * DSD_AUDIO_GRAPH_BLOCK];
+    int channels[CAPTURE_BLOCKS];
+    int blocks;
+    int closed;
+} capture_sink;
+
+static void
+capture_write(void* ctx, const float* samples, size_t frames, int channels) {
+    capture_sink* cap = (capture_sink*)ctx;
+    if (cap->blocks < CAPTURE_BLOCKS) {
+        DSD_MEMCPY(cap->samples[cap->blocks], samples, frames * (size_t)channels * sizeof(float));
+        cap->channels[cap->blocks] = channels;
+    }
+    cap->blocks++;
+}
+
+static void
+capture_close(void* ctx) {
+    ((capture_sink*)ctx)->closed++;
+}
+
+static dsd_audio_sink
+capture_as_sink(capture_sink* cap) {
+    dsd_audio_sink sink;
+    sink.write = capture_write;
+    sink.close = capture_close;
+    sink.ctx = cap;
+    return sink;
+}
+
+static dsd_audio_graph*
+make_graph(capture_sink* master, int channels, int jitter, int idle) {
+    dsd_audio_graph_config cfg;
+    DSD_MEMSET(&cfg, 0, sizeof(cfg));
+    cfg.channels = channels;
+    cfg.sample_rate = 8000;
+    cfg.jitter_blocks = jitter;
+    cfg.idle_blocks = idle;
+    cfg.threaded = 0;
+    cfg.master = capture_as_sink(master);
+    return dsd_audio_graph_create(&cfg);
+}
+
+static void
+fill_block(float block[DSD_AUDIO_GRAPH_BLOCK], float value) {
+    for (int i = 0; i < DSD_AUDIO_GRAPH_BLOCK; i++) {
+        block[i] = value;
+    }
+}
+
+static int
+expect_samples(const char* label, const float* got, size_t n, float want) {
+    for (size_t i = 0; i < n; i++) {
+        if (fabsf(got[i] - want) > 1e-6f) {
+            DSD_FPRINTF(stderr, "FAIL: %s sample %zu: %f (want %f)\n", label, i, (double)got[i], (double)want);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int
+expect_int(const char* label, long long got, long long want) {
+    if (got != want) {
+        DSD_FPRINTF(stderr, "FAIL: %s: %lld (want %lld)\n", label, got, want);
+        return 0;
+    }
+    return 1;
+}
+
+/* Nothing plays until the jitter buffer holds three blocks; then one block per period, in order. */
+static int
+test_prebuffer_and_order(void) {
+    static capture_sink master;
+    DSD_MEMSET(&master, 0, sizeof(master));
+    dsd_audio_graph* g = make_graph(&master, 1, 3, 0);
+    if (!g) {
+        DSD_FPRINTF(stderr, "FAIL: graph create\n");
+        return 0;
+    }
+    float block[DSD_AUDIO_GRAPH_BLOCK];
+    int ok = 1;
+    for (int i = 0; i < 2; i++) {
+        fill_block(block, 0.1f * (float)(i + 1));
+        ok &= expect_int("submit", dsd_audio_graph_submit(g, 7U, block), 0);
+        ok &= expect_int("prebuffer mix", dsd_audio_graph_mix_block(g), 0);
+    }
+    ok &= expect_int("prebuffer output", master.blocks, 0);
+    fill_block(block, 0.3f);
+    ok &= expect_int("submit", dsd_audio_graph_submit(g, 7U, block), 0);
+    for (int i = 0; i < 3; i++) {
+        ok &= expect_int("playing mix", dsd_audio_graph_mix_block(g), 1);
+    }
+    ok &= expect_int("played blocks", master.blocks, 3);
+    for (int i = 0; i < 3 && ok; i++) {
+        ok &= expect_int("master channels", master.channels[i], 1);
+        ok &= expect_samples("in order", master.samples[i], DSD_AUDIO_GRAPH_BLOCK, 0.1f * (float)(i + 1));
+    }
+
+    /* Running dry is one underrun; the stream then buffers again. */
+    ok &= expect_int("dry mix", dsd_audio_graph_mix_block(g), 0);
+    fill_block(block, 0.5f);
+    ok &= expect_int("submit", dsd_audio_graph_submit(g, 7U, block), 0);
+    ok &= expect_int("rebuffer mix", dsd_audio_graph_mix_block(g), 0);
+
+    dsd_audio_graph_stats stats;
+    dsd_audio_graph_get_stats(g, &stats);
+    ok &= expect_int("underruns", (long long)stats.underruns, 1);
+    ok &= expect_int("mixed blocks", (long long)stats.mixed_blocks, 3);
+    ok &= expect_int("open streams", stats.open_streams, 1);
+    dsd_audio_graph_destroy(g);
+    ok &= expect_int("master closed", master.closed, 1);
+    return ok;
+}
+
+/* Two streams sum with their gains, pan splits the stereo mix, the sum clips, and a stream sink gets post-gain mono. */
+static int
+test_mix_gain_pan_and_sinks(void) {
+    static capture_sink master;
+    static capture_sink left_sink;
+    DSD_MEMSET(&master, 0, sizeof(master));
+    DSD_MEMSET(&left_sink, 0, sizeof(left_sink));
+    dsd_audio_graph* g = make_graph(&master, 2, 1, 0);
+    if (!g) {
+        DSD_FPRINTF(stderr, "FAIL: stereo graph create\n");
+        return 0;
+    }
+    dsd_audio_stream_params params;
+    dsd_audio_stream_params_default(&params);
+    params.gain = 0.5f;
+    params.pan = -1.0f;
+    params.sink = capture_as_sink(&left_sink);
+    int ok = expect_int("open left", dsd_audio_graph_open_stream(g, 1U, &params), 0);
+    dsd_audio_stream_params_default(&params);
+    params.pan = 0.5f;
+    ok &= expect_int("open right", dsd_audio_graph_open_stream(g, 2U, &params), 0);
+
+    float block[DSD_AUDIO_GRAPH_BLOCK];
+    fill_block(block, 0.4f);
+    ok &= expect_int("submit left", dsd_audio_graph_submit(g, 1U, block), 0);
+    fill_block(block, 0.2f);
+    ok &= expect_int("submit right", dsd_audio_graph_submit(g, 2U, block), 0);
+    ok &= expect_int("two streams", dsd_audio_graph_mix_block(g), 2);
+
+    /* L = 0.4*0.5 + 0.2*0.5, R = 0.2*1.0. */
+    float want[2 * DSD_AUDIO_GRAPH_BLOCK];
+    for (int i = 0; i < DSD_AUDIO_GRAPH_BLOCK; i++) {
+        want[2 * i] = 0.3f;
+        want[2 * i + 1] = 0.2f;
+    }
+    ok &= expect_int("master channels", master.channels[0], 2);
+    for (int i = 0; i < 2 * DSD_AUDIO_GRAPH_BLOCK && ok; i++) {
+        ok &= expect_samples("stereo mix", &master.samples[0][i], 1U, want[i]);
+    }
+    ok &= expect_int("stream sink blocks", left_sink.blocks, 1);
+    ok &= expect_int("stream sink channels", left_sink.channels[0], 1);
+    ok &= expect_samples("stream sink", left_sink.samples[0], DSD_AUDIO_GRAPH_BLOCK, 0.2f);
+
+    /* Reopening updates the gain; a sink passed with it is closed unused. */
+    static capture_sink spare;
+    DSD_MEMSET(&spare, 0, sizeof(spare));
+    dsd_audio_stream_params_default(&params);
+    params.gain = 4.0f;
+    params.pan = -1.0f;
+    params.sink = capture_as_sink(&spare);
+    ok &= expect_int("reopen", dsd_audio_graph_open_stream(g, 1U, &params), 0);
+    ok &= expect_int("spare sink closed", spare.closed, 1);
+    fill_block(block, 0.5f);
+    ok &= expect_int("submit loud", dsd_audio_graph_submit(g, 1U, block), 0);
+    fill_block(block, -0.9f);
+    ok &= expect_int("submit negative", dsd_audio_graph_submit(g, 2U, block), 0);
+    ok &= expect_int("two streams", dsd_audio_graph_mix_block(g), 2);
+    for (int i = 0; i < DSD_AUDIO_GRAPH_BLOCK && ok; i++) {
+        ok &= expect_samples("clipped left", &master.samples[1][2 * i], 1U, 1.0f);
+        ok &= expect_samples("right", &master.samples[1][2 * i + 1], 1U, -0.9f);
+    }
+    ok &= expect_samples("stream sink unclipped", left_sink.samples[1], DSD_AUDIO_GRAPH_BLOCK, 2.0f);
+
+    dsd_audio_graph_destroy(g);
+    ok &= expect_int("stream sink closed", left_sink.closed, 1);
+    return ok;
+}
+
+/* A closed stream plays out its queue (even below the jitter depth), then frees its slot and sink. */
+static int
+test_close_drains_then_retires(void) {
+    static capture_sink master;
+    static capture_sink stream_sink;
+    DSD_MEMSET(&master, 0, sizeof(master));
+    DSD_MEMSET(&stream_sink, 0, sizeof(stream_sink));
+    dsd_audio_graph* g = make_graph(&master, 1, 3, 0);
+    if (!g) {
+        DSD_FPRINTF(stderr, "FAIL: graph create\n");
+        return 0;
+    }
+    dsd_audio_stream_params params;
+    dsd_audio_stream_params_default(&params);
+    params.sink = capture_as_sink(&stream_sink);
+    int ok = expect_int("open", dsd_audio_graph_open_stream(g, 9U, &params), 0);
+    float block[DSD_AUDIO_GRAPH_BLOCK];
+    fill_block(block, 0.25f);
+    ok &= expect_int("submit", dsd_audio_graph_submit(g, 9U, block), 0);
+    ok &= expect_int("submit", dsd_audio_graph_submit(g, 9U, block), 0);
+    dsd_audio_graph_close_stream(g, 9U);
+    dsd_audio_graph_close_stream(g, 1234U);
+
+    ok &= expect_int("drain 1", dsd_audio_graph_mix_block(g), 1);
+    ok &= expect_int("drain 2", dsd_audio_graph_mix_block(g), 1);
+    dsd_audio_graph_stats stats;
+    dsd_audio_graph_get_stats(g, &stats);
+    ok &= expect_int("still draining", stats.open_streams, 1);
+    ok &= expect_int("drained", dsd_audio_graph_mix_block(g), 0);
+    dsd_audio_graph_get_stats(g, &stats);
+    ok &= expect_int("retired", stats.open_streams, 0);
+    ok &= expect_int("no underrun on drain", (long long)stats.underruns, 0);
+    ok &= expect_int("stream sink blocks", stream_sink.blocks, 2);
+    ok &= expect_int("stream sink closed", stream_sink.closed, 1);
+
+    /* The same key starts over with an empty queue and a fresh prebuffer. */
+    ok &= expect_int("submit after retire", dsd_audio_graph_submit(g, 9U, block), 0);
+    ok &= expect_int("rebuffer", dsd_audio_graph_mix_block(g), 0);
+    dsd_audio_graph_destroy(g);
+    return ok;
+}
+
+/* A full jitter buffer mixes a period to make room; a silent stream goes idle and frees its slot. */
+static int
+test_overflow_and_idle(void) {
+    static capture_sink master;
+    DSD_MEMSET(&master, 0, sizeof(master));
+    dsd_audio_graph* g = make_graph(&master, 1, 2, 4);
+    if (!g) {
+        DSD_FPRINTF(stderr, "FAIL: graph create\n");
+        return 0;
+    }
+    float block[DSD_AUDIO_GRAPH_BLOCK];
+    fill_block(block, 0.0f);
+    int ok = 1;
+    for (int i = 0; i < DSD_AUDIO_GRAPH_QUEUE_BLOCKS - 1; i++) {
+        ok &= expect_int("fill", dsd_audio_graph_submit(g, 3U, block), 0);
+    }
+    ok &= expect_int("full", dsd_audio_graph_submit(g, 3U, block), 0);
+    dsd_audio_graph_stats stats;
+    dsd_audio_graph_get_stats(g, &stats);
+    ok &= expect_int("full waits", (long long)stats.full_waits, 1);
+    ok &= expect_int("mixed to make room", (long long)stats.mixed_blocks, 1);
+
+    /* Play the queue out, then stay quiet past the idle limit. */
+    for (int i = 0; i < DSD_AUDIO_GRAPH_QUEUE_BLOCKS + 4; i++) {
+        (void)dsd_audio_graph_mix_block(g);
+    }
+    ok &= expect_int("other stream", dsd_audio_graph_submit(g, 4U, block), 0);
+    ok &= expect_int("idle retire", dsd_audio_graph_mix_block(g), 0);
+    dsd_audio_graph_get_stats(g, &stats);
+    ok &= expect_int("only the new stream", stats.open_streams, 1);
+
+    /* Every slot in use: the next key is refused. */
+    for (uint64_t key = 100U; key < 100U + DSD_AUDIO_GRAPH_MAX_STREAMS - 1U; key++) {
+        ok &= expect_int("claim", dsd_audio_graph_open_stream(g, key, NULL), 0);
+    }
+    ok &= expect_int("no free slot", dsd_audio_graph_open_stream(g, 999U, NULL), -1);
+    ok &= expect_int("no free slot submit", dsd_audio_graph_submit(g, 999U, block), -1);
+    dsd_audio_graph_destroy(g);
+    return ok;
+}
+
+static int
+test_file_sink(void) {
+    char path[DSD_TEST_PATH_MAX];
+    int fd = dsd_test_mkstemp(path, sizeof(path), "dsdneo_audio_graph");
+    if (fd < 0) {
+        DSD_FPRINTF(stderr, "FAIL: mkstemp\n");
+        return 0;
+    }
+    (void)dsd_close(fd);
+    dsd_audio_sink sink;
+    if (dsd_audio_sink_open_file(&sink, path) != 0) {
+        DSD_FPRINTF(stderr, "FAIL: file sink open\n");
+        (void)remove(path);
+        return 0;
+    }
+    const float samples[4] = {0.5f, -0.5f, 2.0f, -1.0f};
+    sink.write(sink.ctx, samples, 2U, 2);
+    sink.close(sink.ctx);
+
+    unsigned char got[16];
+    size_t n = 0;
+    FILE* fp = fopen(path, "rb");
+    if (fp) {
+        n = fread(got, 1, sizeof(got), fp);
+        fclose(fp);
+    }
+    (void)remove(path);
+    const unsigned char want[8] = {0x00, 0x40, 0x00, 0xC0, 0xFF, 0x7F, 0x00, 0x80};
+    int ok = expect_int("file bytes", (long long)n, (long long)sizeof(want));
+    if (ok && memcmp(got, want, sizeof(want)) != 0) {
+        DSD_FPRINTF(stderr, "FAIL: file sink bytes\n");
+        ok = 0;
+    }
+    dsd_audio_sink empty;
+    ok &= expect_int("bad path", dsd_audio_sink_open_file(&empty, NULL), -1);
+    ok &= (empty.write == NULL && empty.close == NULL);
+    return ok;
+}
+
+/* The mixer thread paces itself, holds a producer that overruns the jitter buffer and plays everything queued. */
+static int
+test_threaded_mixer(void) {
+    static capture_sink master;
+    DSD_MEMSET(&master, 0, sizeof(master));
+    dsd_audio_graph_config cfg;
+    DSD_MEMSET(&cfg, 0, sizeof(cfg));
+    cfg.channels = 1;
+    cfg.sample_rate = 8000;
+    cfg.jitter_blocks = 2;
+    cfg.threaded = 1;
+    cfg.master = capture_as_sink(&master);
+    dsd_audio_graph* g = dsd_audio_graph_create(&cfg);
+    if (!g) {
+        DSD_FPRINTF(stderr, "FAIL: threaded graph create\n");
+        return 0;
+    }
+    float block[DSD_AUDIO_GRAPH_BLOCK];
+    fill_block(block, 0.125f);
+    int ok = 1;
+    for (int i = 0; i < THREADED_BLOCKS; i++) {
+        ok &= expect_int("threaded submit", dsd_audio_graph_submit(g, 5U, block), 0);
+    }
+    dsd_audio_graph_close_stream(g, 5U);
+    dsd_audio_graph_stats stats;
+    for (int waited = 0; waited < 200; waited++) {
+        dsd_audio_graph_get_stats(g, &stats);
+        if (stats.open_streams == 0) {
+            break;
+        }
+        dsd_sleep_ms(10);
+    }
+    ok &= expect_int("threaded retired", stats.open_streams, 0);
+    ok &= expect_int("threaded blocks", (long long)stats.mixed_blocks, THREADED_BLOCKS);
+    ok &= (stats.full_waits > 0U);
+    dsd_audio_graph_destroy(g);
+    ok &= expect_int("threaded master blocks", master.blocks, THREADED_BLOCKS);
+    ok &= expect_samples("threaded output", master.samples[3], DSD_AUDIO_GRAPH_BLOCK, 0.125f);
+    return ok;
+}
+
+int
+main(void) {
+    int ok = 1;
+    ok &= test_prebuffer_and_order();
+    ok &= test_mix_gain_pan_and_sinks();
+    ok &= test_close_drains_then_retires();
+    ok &= test_overflow_and_idle();
+    ok &= test_file_sink();
+    ok &= test_threaded_mixer();
+    ok &= expect_int("bad config", dsd_audio_graph_create(NULL) == NULL, 1);
+    return ok ? 0 : 1;
+}
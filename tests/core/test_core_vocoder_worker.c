@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit test: the vocoder lanes hand back every frame DSD_VOCODER_WORKER_LAG
+ * exchanges late, in order, with exactly the PCM/status/result a direct
+ * mbelib call on a private parameter history would produce, and with the
+ * metadata it was posted with. Lanes stay independent, erasures keep their
+ * place, a call's last frames are still returned -- by the next exchange or by
+ * draining the lane when the call ends -- and resets drop the pending frames.
+ */
+
+#include <dsd-neo/core/vocoder_worker.h>
+#include <mbelib-neo/mbelib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+
+enum { FRAMES = 64 };
+
+typedef struct {
+    int ret;
+    mbe_process_result result;
+    dsd_vocoder_frame_meta meta;
+    float pcm[160];
+    int empty; /* lane held no frame: the caller's post_flags come back */
+} expected_frame;
+
+/* Reference history plus the frames the lane should still be holding, oldest at head. */
+typedef struct {
+    mbe_parms cur;
+    mbe_parms prev;
+    mbe_parms prev_enhanced;
+    expected_frame pending[DSD_VOCODER_WORKER_LAG];
+    int head;
+} ref_lane;
+
+static uint32_t g_rng = 0x70C0DE21u;
+
+static uint32_t
+next_rand(void) {
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return g_rng >> 8;
+}
+
+
+/* A random frame of @p kind tagged through its result and metadata. */
+static void
+random_frame(dsd_vocoder_frame_meta* meta, mbe_process_result* result, int kind, int tag) {
+    DSD_MEMSET(meta, 0, sizeof(*meta));
+    meta->kind = kind;
+    const int nbits = (kind == DSD_VOCODER_FRAME_IMBE4400) ? 88 : (kind == DSD_VOCODER_FRAME_AMBE2450) ? 49 : 0;
+    for (int i = 0; i < nbits; i++) {
+        meta->bits[i] = (char)(next_rand() & 1U);
+    }
+    meta->decode_errors = tag;
+    meta->post_flags = (unsigned int)tag * 3U;
+    DSD_MEMSET(result, 0, sizeof(*result));
+    result->total_errors = tag;
+    result->c0_errors = tag & 3;
+    result->flags = MBE_PROCESS_FLAG_C0_VALID;
+}
+
+/* What the synchronous path yields for one frame. */
+static void
+ref_synthesize(ref_lane* r, const dsd_vocoder_frame_meta* meta, const mbe_process_result* in, expected_frame* out) {
+    out->result = *in;
+    out->meta = *meta;
+    out->empty = 0;
+    if (meta->kind == DSD_VOCODER_FRAME_AMBE2450) {
+        out->ret = mbe_processAmbe2450Dataf(out->pcm, &out->result, meta->bits, &r->cur, &r->prev, &r->prev_enhanced);
+    } else if (meta->kind == DSD_VOCODER_FRAME_IMBE4400) {
+        out->ret = mbe_processImbe4400Dataf(out->pcm, &out->result, meta->bits, &r->cur, &r->prev, &r->prev_enhanced);
+    } else {
+        mbe_synthesizeSilencef(out->pcm);
+        out->ret = MBE_STATUS_INVALID_BITS;
+    }
+}
+
+/* A lane with no earlier frame: silence returned as an erasure. */
+static void
+expect_silence(expected_frame* out) {
+    mbe_synthesizeSilencef(out->pcm);
+    DSD_MEMSET(&out->result, 0, sizeof(out->result));
+    DSD_MEMSET(&out->meta, 0, sizeof(out->meta));
+    out->meta.kind = DSD_VOCODER_FRAME_ERASURE;
+    out->ret = MBE_STATUS_INVALID_BITS;
+    out->empty = 1;
+}
+
+/* Fresh history and an empty lane. */
+static void
+ref_lane_reset(ref_lane* r) {
+    mbe_initMbeParms(&r->cur, &r->prev, &r->prev_enhanced);
+    for (int i = 0; i < DSD_VOCODER_WORKER_LAG; i++) {
+        expect_silence(&r->pending[i]);
+    }
+    r->head = 0;
+}
+
+static int
+check_frame(const char* label, int index, int ret, const mbe_process_result* result,
+            const dsd_vocoder_frame_meta* meta, const float* pcm, const expected_frame* want) {
+    if (ret != want->ret || memcmp(result, &want->result, sizeof(*result)) != 0
+        || memcmp(pcm, want->pcm, sizeof(want->pcm)) != 0) {
+        DSD_FPRINTF(stderr, "FAIL: %s frame %d: ret %d (want %d), total_errors %d (want %d)\n", label, index, ret,
+                    want->ret, result->total_errors, want->result.total_errors);
+        return 0;
+    }
+    if (memcmp(meta, &want->meta, sizeof(*meta)) != 0) {
+        DSD_FPRINTF(stderr, "FAIL: %s frame %d: meta kind %d tag %d (want kind %d tag %d)\n", label, index, meta->kind,
+                    meta->decode_errors, want->meta.kind, want->meta.decode_errors);
+        return 0;
+    }
+    return 1;
+}
+
+/* Post a frame and check what comes back; the frame's own outcome joins the lane's pending frames. */
+static int
+exchange_and_check(dsd_vocoder_worker* w, ref_lane* ref, const char* label, int index, int lane, int kind, int tag) {
+    dsd_vocoder_frame_meta meta;
+    mbe_process_result result;
+    random_frame(&meta, &result, kind, tag);
+
+    expected_frame want = ref->pending[ref->head];
+    if (want.empty) {
+        want.meta.post_flags = meta.post_flags;
+    }
+    ref_synthesize(ref, &meta, &result, &ref->pending[ref->head]);
+    ref->head = (ref->head + 1) % DSD_VOCODER_WORKER_LAG;
+
+    float pcm[160];
+    const int ret = dsd_vocoder_worker_exchange(w, lane, &meta, &result, pcm);
+    return check_frame(label, index, ret, &result, &meta, pcm, &want);
+}
+
+/* Two interleaved lanes of mixed AMBE, IMBE and erasures against per-lane references. */
+static int
+test_matches_direct_synthesis(int threaded) {
+    const char* label = threaded ? "threaded" : "inline";
+    dsd_vocoder_worker* w = dsd_vocoder_worker_create(threaded);
+    if (!w) {
+        DSD_FPRINTF(stderr, "FAIL: %s worker create\n", label);
+        return 0;
+    }
+    ref_lane ref[DSD_VOCODER_WORKER_LANES];
+    for (int lane = 0; lane < DSD_VOCODER_WORKER_LANES; lane++) {
+        ref_lane_reset(&ref[lane]);
+    }
+
+    int ok = 1;
+    for (int i = 0; i < FRAMES && ok; i++) {
+        const int lane = (int)(next_rand() & 1U);
+        const uint32_t pick = next_rand() % 7U;
+        const int kind = (pick == 0U)   ? DSD_VOCODER_FRAME_ERASURE
+                         : (pick == 1U) ? DSD_VOCODER_FRAME_IMBE4400
+                                        : DSD_VOCODER_FRAME_AMBE2450;
+        ok &= exchange_and_check(w, &ref[lane], label, i, lane, kind, i + 1);
+    }
+    dsd_vocoder_worker_destroy(w);
+    return ok;
+}
+
+static int
+test_call_end_and_reset(void) {
+    dsd_vocoder_worker* w = dsd_vocoder_worker_create(1);
+    if (!w) {
+        DSD_FPRINTF(stderr, "FAIL: worker create\n");
+        return 0;
+    }
+    ref_lane ref[DSD_VOCODER_WORKER_LANES];
+    for (int lane = 0; lane < DSD_VOCODER_WORKER_LANES; lane++) {
+        ref_lane_reset(&ref[lane]);
+    }
+    const int ambe = DSD_VOCODER_FRAME_AMBE2450;
+    int ok = 1;
+
+    /* The lane fills for DSD_VOCODER_WORKER_LAG frames, then each frame yields the one that many posts back. */
+    int tag = 100;
+    for (int i = 0; i < DSD_VOCODER_WORKER_LAG + 2; i++, tag++) {
+        ok &= exchange_and_check(w, &ref[0], "call", tag, 0, ambe, tag);
+    }
+
+    /* The next call's first frames still collect the last call's frames, with their own metadata. */
+    ok &= exchange_and_check(w, &ref[0], "next call", tag, 0, ambe, tag);
+    tag++;
+
+    /* Reset drops the queued frames and restarts the history. */
+    dsd_vocoder_worker_reset_lane(w, 0);
+    ref_lane_reset(&ref[0]);
+    for (int i = 0; i < DSD_VOCODER_WORKER_LAG + 1; i++, tag++) {
+        ok &= exchange_and_check(w, &ref[0], "after reset", tag, 0, ambe, tag);
+    }
+
+    /* The untouched lane never saw a frame. */
+    ok &= exchange_and_check(w, &ref[1], "other lane", tag, 1, ambe, tag);
+    tag++;
+
+    dsd_vocoder_frame_meta meta;
+    mbe_process_result result;
+    float pcm[160];
+    random_frame(&meta, &result, ambe, tag);
+    ok &= (dsd_vocoder_worker_exchange(w, 2, &meta, &result, pcm) == MBE_STATUS_INVALID_ARGUMENT);
+    dsd_vocoder_worker_destroy(w);
+    return ok;
+}
+
+/* Ending a call collects its queued frames in order; the next call then starts on an empty lane. */
+static int
+test_call_end_drain(int threaded) {
+    const char* label = threaded ? "threaded drain" : "inline drain";
+    dsd_vocoder_worker* w = dsd_vocoder_worker_create(threaded);
+    if (!w) {
+        DSD_FPRINTF(stderr, "FAIL: %s worker create\n", label);
+        return 0;
+    }
+    ref_lane ref;
+    ref_lane_reset(&ref);
+    const int ambe = DSD_VOCODER_FRAME_AMBE2450;
+    int ok = 1;
+
+    int tag = 200;
+    for (int i = 0; i < DSD_VOCODER_WORKER_LAG + 2; i++, tag++) {
+        ok &= exchange_and_check(w, &ref, label, tag, 0, ambe, tag);
+    }
+    if (dsd_vocoder_worker_pending(w, 0) != DSD_VOCODER_WORKER_LAG || dsd_vocoder_worker_pending(w, 1) != 0) {
+        DSD_FPRINTF(stderr, "FAIL: %s pending %d/%d before call end\n", label, dsd_vocoder_worker_pending(w, 0),
+                    dsd_vocoder_worker_pending(w, 1));
+        ok = 0;
+    }
+
+    /* The call ends: its tail frames come out oldest first, each with the metadata it was posted with. */
+    dsd_vocoder_frame_meta meta;
+    mbe_process_result result;
+    float pcm[160];
+    for (int i = 0; i < DSD_VOCODER_WORKER_LAG; i++) {
+        DSD_MEMSET(&meta, 0, sizeof(meta));
+        DSD_MEMSET(&result, 0, sizeof(result));
+        const int ret = dsd_vocoder_worker_collect(w, 0, &meta, &result, pcm);
+        ok &= check_frame(label, i, ret, &result, &meta, pcm, &ref.pending[ref.head]);
+        expect_silence(&ref.pending[ref.head]);
+        ref.head = (ref.head + 1) % DSD_VOCODER_WORKER_LAG;
+    }
+    if (dsd_vocoder_worker_pending(w, 0) != 0
+        || dsd_vocoder_worker_collect(w, 0, &meta, &result, pcm) != MBE_STATUS_INVALID_ARGUMENT) {
+        DSD_FPRINTF(stderr, "FAIL: %s lane not empty after drain\n", label);
+        ok = 0;
+    }
+
+    /* The next call's first frame collects nothing from the ended call. */
+    ok &= exchange_and_check(w, &ref, label, tag, 0, ambe, tag);
+    ok &= (dsd_vocoder_worker_pending(w, 2) == 0);
+    ok &= (dsd_vocoder_worker_collect(w, 2, &meta, &result, pcm) == MBE_STATUS_INVALID_ARGUMENT);
+    dsd_vocoder_worker_destroy(w);
+    return ok;
+}
+
+int
+main(void) {
+    int ok = 1;
+    ok &= test_matches_direct_synthesis(1);
+    ok &= test_matches_direct_synthesis(0);
+    ok &= test_call_end_and_reset();
+    ok &= test_call_end_drain(1);
+    ok &= test_call_end_drain(0);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit test: the WAV writer batches each handle's samples into few
+ * sf_write_short() calls in submission order, closes a handle only after its
+ * writes, finalizes (renames and exports) the recording from a snapshot taken
+ * at submission, drops and counts samples once the queue is full, and makes
+ * finalize requests wait for room instead.
+ *
+ * sf_write_short, sf_close and dsd_rdio_export_event are wrapped at link time.
+ */
+
+#include <dsd-neo/core/opts.h>
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/wav_writer.h>
+#include <dsd-neo/platform/atomic_compat.h>
+#include <dsd-neo/platform/threading.h>
+#include <dsd-neo/platform/timing.h>
+#include <sndfile.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if DSD_PLATFORM_WIN_NATIVE
+#include <direct.h>
+#else
+#include <unistd.h>
+#endif
+#include "dsd-neo/core/safe_api.h"
+#include "dsd-neo/platform/platform.h"
+#include "test_support.h"
+
+enum { MAX_CALLS = 256, MAX_SAMPLES = 300000 };
+
+typedef struct {
+    SNDFILE* file;
+    int closed;
+    int count;
+} io_call;
+
+static char g_handle_a;
+static char g_handle_b;
+#define FILE_A ((SNDFILE*)(void*)&g_handle_a)
+#define FILE_B ((SNDFILE*)(void*)&g_handle_b)
+
+static io_call g_calls[MAX_CALLS];
+static int g_call_count = 0;
+static short g_samples_a[MAX_SAMPLES];
+static int g_samples_a_len = 0;
+static short g_samples_b[MAX_SAMPLES];
+static int g_samples_b_len = 0;
+static atomic_int g_block_writes = 0;
+static atomic_int g_in_write = 0;
+
+static int g_export_calls = 0;
+static int g_export_system_id = 0;
+static uint32_t g_export_target = 0;
+static char g_export_path[2048];
+
+static Event_History g_event;
+
+sf_count_t __wrap_sf_write_short(SNDFILE* file, const short* ptr, sf_count_t items);
+int __wrap_sf_close(SNDFILE* file);
+int __wrap_dsd_rdio_export_event(const dsd_opts* opts, const Event_History* event, const char* wav_path);
+
+sf_count_t
+__wrap_sf_write_short(SNDFILE* file, const short* ptr, sf_count_t items) {
+    atomic_store(&g_in_write, 1);
+    while (atomic_load(&g_block_writes)) {
+        dsd_sleep_ms(1U);
+    }
+    short* dst = (file == FILE_A) ? g_samples_a : g_samples_b;
+    int* len = (file == FILE_A) ? &g_samples_a_len : &g_samples_b_len;
+    if (*len + (int)items <= MAX_SAMPLES) {
+        DSD_MEMCPY(dst + *len, ptr, (size_t)items * sizeof(short));
+        *len += (int)items;
+    }
+    if (g_call_count < MAX_CALLS) {
+        g_calls[g_call_count].file = file;
+        g_calls[g_call_count].closed = 0;
+        g_calls[g_call_count].count = (int)items;
+        g_call_count++;
+    }
+    return items;
+}
+
+int
+__wrap_sf_close(SNDFILE* file) {
+    if (g_call_count < MAX_CALLS) {
+        g_calls[g_call_count].file = file;
+        g_calls[g_call_count].closed = 1;
+        g_calls[g_call_count].count = 0;
+        g_call_count++;
+    }
+    return 0;
+}
+
+int
+__wrap_dsd_rdio_export_event(const dsd_opts* opts, const Event_History* event, const char* wav_path) {
+    g_export_calls++;
+    g_export_system_id = opts ? opts->rdio_system_id : -1;
+    g_export_target = event ? event->target_id : 0U;
+    DSD_SNPRINTF(g_export_path, sizeof(g_export_path), "%s", wav_path ? wav_path : "");
+    return 0;
+}
+
+static void
+reset_capture(void) {
+    g_call_count = 0;
+    g_samples_a_len = 0;
+    g_samples_b_len = 0;
+    g_export_calls = 0;
+    g_export_path[0] = '\0';
+}
+
+static int
+expect_true(const char* label, int cond) {
+    if (!cond) {
+        DSD_FPRINTF(stderr, "FAIL: %s\n", label);
+        return 0;
+    }
+    return 1;
+}
+
+static int
+counted_run(const short* samples, int len, int start) {
+    for (int i = 0; i < len; i++) {
+        if (samples[i] != (short)((start + i) & 0x7FFF)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Calls on @p file before its close, or -1 when it was not closed exactly once, last. */
+static int
+writes_before_close(SNDFILE* file) {
+    int writes = 0;
+    int closes = 0;
+    for (int i = 0; i < g_call_count; i++) {
+        if (g_calls[i].file != file) {
+            continue;
+        }
+        if (closes > 0) {
+            return -1;
+        }
+        if (g_calls[i].closed) {
+            closes++;
+        } else {
+            writes++;
+        }
+    }
+    return closes == 1 ? writes : -1;
+}
+
+static int
+remove_dir(const char* path) {
+#if DSD_PLATFORM_WIN_NATIVE
+    return _rmdir(path);
+#else
+    return rmdir(path);
+#endif
+}
+
+static int
+file_exists(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return 0;
+    }
+    fclose(fp);
+    return 1;
+}
+
+static int
+test_batches_and_finalizes(void) {
+    reset_capture();
+    char dir[1024];
+    char temp_path[1024];
+    if (!dsd_test_mkdtemp(dir, sizeof(dir), "dsdneo_wav_writer")
+        || dsd_test_path_join(temp_path, sizeof(temp_path), dir, "TEMP_call") != 0) {
+        DSD_FPRINTF(stderr, "FAIL: temp dir\n");
+        return 0;
+    }
+    FILE* fp = fopen(temp_path, "wb");
+    if (!fp) {
+        DSD_FPRINTF(stderr, "FAIL: create %s\n", temp_path);
+        return 0;
+    }
+    char body[100];
+    DSD_MEMSET(body, 0, sizeof(body));
+    fwrite(body, 1, sizeof(body), fp);
+    fclose(fp);
+
+    short block[160];
+    int next = 0;
+    int ok = 1;
+    for (int i = 0; i < 64; i++) {
+        for (int k = 0; k < 160; k++) {
+            block[k] = (short)((next + k) & 0x7FFF);
+        }
+        next += 160;
+        ok &= expect_true("write A queued", dsd_wav_writer_write(FILE_A, block, 160, "test A") == 0);
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int k = 0; k < 160; k++) {
+            block[k] = (short)((i * 160 + k) & 0x7FFF);
+        }
+        ok &= expect_true("write B queued", dsd_wav_writer_write(FILE_B, block, 160, "test B") == 0);
+    }
+
+    DSD_MEMSET(&g_event, 0, sizeof(g_event));
+    g_event.target_id = 1234U;
+    g_event.source_id = 77U;
+    dsd_opts* opts = (dsd_opts*)calloc(1, sizeof(dsd_opts));
+    if (!opts) {
+        return 0;
+    }
+    opts->rdio_mode = 1;
+    opts->rdio_system_id = 9;
+    ok &= expect_true("finalize A queued", dsd_wav_writer_finalize(FILE_A, opts, temp_path, dir, &g_event, 1) == 0);
+    /* The writer works from what was current at submission. */
+    opts->rdio_system_id = 5;
+    g_event.target_id = 1U;
+    ok &= expect_true("close B queued", dsd_wav_writer_finalize(FILE_B, NULL, NULL, NULL, NULL, 0) == 0);
+    dsd_wav_writer_drain();
+
+    dsd_wav_writer_stats st;
+    dsd_wav_writer_get_stats(&st);
+    ok &= expect_true("A samples in order", g_samples_a_len == 64 * 160 && counted_run(g_samples_a, 64 * 160, 0));
+    ok &= expect_true("B samples in order", g_samples_b_len == 3 * 160 && counted_run(g_samples_b, 3 * 160, 0));
+    ok &= expect_true("A batched into 3 writes then closed", writes_before_close(FILE_A) == 3);
+    ok &= expect_true("B batched into 1 write then closed", writes_before_close(FILE_B) == 1);
+    ok &= expect_true("stats", st.queued_samples == 67U * 160U && st.written_samples == 67U * 160U
+                                   && st.batches == 4U && st.finalized == 2U && st.dropped_samples == 0U
+                                   && st.depth == 0U && st.backpressure_waits == 0U);
+    ok &= expect_true("exported once from the snapshot",
+                      g_export_calls == 1 && g_export_system_id == 9 && g_export_target == 1234U);
+    const char* suffix = "_GROUP_TGT_1234_SRC_77.wav";
+    size_t plen = strlen(g_export_path);
+    ok &= expect_true("renamed from event",
+                      plen > strlen(suffix) && strcmp(g_export_path + plen - strlen(suffix), suffix) == 0);
+    ok &= expect_true("final file present", file_exists(g_export_path));
+    ok &= expect_true("temp file gone", !file_exists(temp_path));
+
+    (void)remove(g_export_path);
+    (void)remove(temp_path);
+    (void)remove_dir(dir);
+    free(opts);
+    dsd_wav_writer_shutdown();
+    return ok;
+}
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    close_a_thread(void* arg) {
+    int* rc = (int*)arg;
+    *rc = dsd_wav_writer_finalize(FILE_A, NULL, NULL, NULL, NULL, 0);
+    DSD_THREAD_RETURN;
+}
+
+static int
+wait_for(int (*cond)(void)) {
+    for (int i = 0; i < 5000; i++) {
+        if (cond()) {
+            return 1;
+        }
+        dsd_sleep_ms(1U);
+    }
+    return 0;
+}
+
+static int
+writer_in_write(void) {
+    return atomic_load(&g_in_write) != 0;
+}
+
+static int
+close_is_waiting(void) {
+    dsd_wav_writer_stats st;
+    dsd_wav_writer_get_stats(&st);
+    return st.backpressure_waits == 1U;
+}
+
+static int
+test_drops_writes_and_backpressures_close(void) {
+    reset_capture();
+    static short batch[DSD_WAV_WRITER_BATCH_SAMPLES];
+    int next = 0;
+    int ok = 1;
+
+    /* The first full batch goes to the writer and stalls there. */
+    atomic_store(&g_block_writes, 1);
+    atomic_store(&g_in_write, 0);
+    for (int b = 0; b <= (int)DSD_WAV_WRITER_QUEUE_MAX; b++) {
+        for (int k = 0; k < DSD_WAV_WRITER_BATCH_SAMPLES; k++) {
+            batch[k] = (short)((next + k) & 0x7FFF);
+        }
+        next += DSD_WAV_WRITER_BATCH_SAMPLES;
+        ok &= expect_true("batch queued", dsd_wav_writer_write(FILE_A, batch, DSD_WAV_WRITER_BATCH_SAMPLES, "t") == 0);
+        if (b == 0) {
+            ok &= expect_true("writer picked up the first batch", wait_for(writer_in_write));
+        }
+    }
+    ok &= expect_true("full queue drops", dsd_wav_writer_write(FILE_A, batch, 160, "t") == 1);
+
+    dsd_wav_writer_stats st;
+    dsd_wav_writer_get_stats(&st);
+    ok &= expect_true("drop counted", st.dropped_samples == 160U && st.depth == DSD_WAV_WRITER_QUEUE_MAX);
+
+    int close_rc = -2;
+    dsd_thread_t t;
+    if (dsd_thread_create(&t, close_a_thread, &close_rc) != 0) {
+        atomic_store(&g_block_writes, 0);
+        DSD_FPRINTF(stderr, "FAIL: thread create\n");
+        return 0;
+    }
+    ok &= expect_true("close waits for room", wait_for(close_is_waiting));
+    atomic_store(&g_block_writes, 0);
+    (void)dsd_thread_join(t);
+    dsd_wav_writer_drain();
+
+    dsd_wav_writer_get_stats(&st);
+    const int total = ((int)DSD_WAV_WRITER_QUEUE_MAX + 1) * DSD_WAV_WRITER_BATCH_SAMPLES;
+    ok &= expect_true("close queued", close_rc == 0);
+    ok &= expect_true("kept samples in order", g_samples_a_len == total && counted_run(g_samples_a, total, 0));
+    ok &= expect_true("closed after every write", writes_before_close(FILE_A) == (int)DSD_WAV_WRITER_QUEUE_MAX + 1);
+    ok &= expect_true("stats after release", st.written_samples == (uint64_t)total && st.finalized == 1U
+                                                 && st.dropped_samples == 160U && st.backpressure_waits == 1U);
+    dsd_wav_writer_shutdown();
+    return ok;
+}
+
+static int
+test_shutdown_flushes_partial_batch(void) {
+    reset_capture();
+    short block[100];
+    for (int k = 0; k < 100; k++) {
+        block[k] = (short)k;
+    }
+    int ok = expect_true("partial queued", dsd_wav_writer_write(FILE_B, block, 100, "t") == 0);
+    dsd_wav_writer_shutdown();
+    ok &= expect_true("partial written on shutdown", g_samples_b_len == 100 && counted_run(g_samples_b, 100, 0));
+    ok &= expect_true("invalid args ignored", dsd_wav_writer_write(NULL, block, 100, "t") == 0
+                                                  && dsd_wav_writer_finalize(NULL, NULL, "", NULL, NULL, 0) == 0);
+    dsd_wav_writer_shutdown();
+    return ok;
+}
+
+int
+main(void) {
+    int ok = 1;
+    ok &= test_batches_and_finalizes();
+    ok &= test_drops_writes_and_backpressures_close();
+    ok &= test_shutdown_flushes_partial_batch();
+    return ok ? 0 : 1;
+}
@@ -5,6 +5,7 @@
 
 #include <dsd-neo/core/dibit.h>
 #include <dsd-neo/core/state.h>
+#include <dsd-neo/dsp/symbol.h>
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #include <stdint.h>
@@ -27,6 +28,21 @@ getSymbol(dsd_opts* opts, dsd_state* state, int have_sync) {
     return 0.0f;
 }
 
+void
+// NOLINTNEXTLINE(misc-use-internal-linkage)
+getSymbolBlock(dsd_opts* opts, dsd_state* state, int have_sync, float* out, int count, dsd_symbol_sink_fn sink,
+               void* user) {
+    for (int k = 0; k < count; k++) {
+        const float symbol = getSymbol(opts, state, have_sync);
+        if (out != NULL) {
+            out[k] = symbol;
+        }
+        if (sink != NULL) {
+            sink(opts, state, symbol, user);
+        }
+    }
+}
+
 uint64_t
 // NOLINTNEXTLINE(misc-use-internal-linkage)
 dsd_time_monotonic_ns(void) {
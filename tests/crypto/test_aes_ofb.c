@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "aes_internal.h"
 #include "dsd-neo/core/safe_api.h"
 
 static int
@@ -212,6 +213,160 @@ test_aes128_ctr_xcrypt_counter_wrap(void) {
     return 0;
 }
 
+static void
+fill_pattern(uint8_t* buf, size_t len, uint32_t seed) {
+    uint32_t x = seed * 2654435761U + 1U;
+    for (size_t i = 0; i < len; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (uint8_t)x;
+    }
+}
+
+static int
+test_aes_backends_match_portable(void) {
+    const dsd_aes_backend* backends[4];
+    const int count = dsd_aes_available_backends(backends, 4);
+    const dsd_aes_key_size sizes[3] = {DSD_AES_KEY_128, DSD_AES_KEY_192, DSD_AES_KEY_256};
+    // Block counts and byte lengths cover the 4-block pipelines, their tails and partial CTR blocks.
+    const int block_counts[5] = {1, 3, 4, 7, 9};
+    const size_t ctr_lens[5] = {1U, 15U, 64U, 81U, 143U};
+
+    if (count < 1 || backends[0] != &dsd_aes_backend_portable) {
+        DSD_FPRINTF(stderr, "AES backends: portable backend missing\n");
+        return 1;
+    }
+    for (int b = 1; b < count; b++) {
+        for (int k = 0; k < 3; k++) {
+            uint8_t key[32];
+            uint8_t iv[16];
+            dsd_aes_key_ctx ctx;
+            fill_pattern(key, sizeof(key), (uint32_t)(b * 16 + k));
+            fill_pattern(iv, sizeof(iv), (uint32_t)(b * 16 + k + 100));
+            if (k == 0) {
+                DSD_MEMSET(iv + 12, 0xFF, 4); // exercise the counter carry
+            }
+            if (dsd_aes_key_ctx_init(&ctx, key, sizes[k]) != 0) {
+                DSD_FPRINTF(stderr, "AES backends: key ctx init failed\n");
+                return 1;
+            }
+            for (int n = 0; n < 5; n++) {
+                uint8_t ref[144];
+                uint8_t got[144];
+                uint8_t in[144];
+                const int nblocks = block_counts[n];
+                const size_t bytes = (size_t)nblocks * 16U;
+                fill_pattern(in, sizeof(in), (uint32_t)(n + 7));
+
+                dsd_aes_backend_portable.ofb(&ctx, iv, ref, nblocks);
+                backends[b]->ofb(&ctx, iv, got, nblocks);
+                if (memcmp(ref, got, bytes) != 0) {
+                    DSD_FPRINTF(stderr, "AES backend %s: OFB mismatch (key %d, %d blocks)\n", backends[b]->name, k,
+                                nblocks);
+                    return 1;
+                }
+
+                dsd_aes_backend_portable.ecb_decrypt(&ctx, in, ref, nblocks);
+                DSD_MEMCPY(got, in, bytes);
+                backends[b]->ecb_decrypt(&ctx, got, got, nblocks);
+                if (memcmp(ref, got, bytes) != 0) {
+                    DSD_FPRINTF(stderr, "AES backend %s: ECB mismatch (key %d, %d blocks)\n", backends[b]->name, k,
+                                nblocks);
+                    return 1;
+                }
+
+                const size_t len = ctr_lens[n];
+                DSD_MEMCPY(ref, in, len);
+                DSD_MEMCPY(got, in, len);
+                dsd_aes_backend_portable.ctr(&ctx, iv, ref, len);
+                backends[b]->ctr(&ctx, iv, got, len);
+                if (memcmp(ref, got, len) != 0) {
+                    DSD_FPRINTF(stderr, "AES backend %s: CTR mismatch (key %d, %zu bytes)\n", backends[b]->name, k,
+                                len);
+                    return 1;
+                }
+            }
+            dsd_aes_key_ctx_clear(&ctx);
+        }
+    }
+    return 0;
+}
+
+static int
+test_aes_key_cache(void) {
+    const uint8_t iv[16] = {0};
+    uint8_t first_key[16];
+    uint8_t expect[16];
+    uint8_t out[16];
+    dsd_aes_key_ctx ctx;
+
+    fill_pattern(first_key, sizeof(first_key), 500U);
+    if (dsd_aes_key_ctx_init(&ctx, first_key, DSD_AES_KEY_128) != 0) {
+        DSD_FPRINTF(stderr, "AES key cache: key ctx init failed\n");
+        return 1;
+    }
+    dsd_aes_backend_portable.ofb(&ctx, iv, expect, 1);
+
+    const dsd_aes_key_ctx* a = dsd_aes_key_ctx_cached(first_key, DSD_AES_KEY_128);
+    const dsd_aes_key_ctx* b = dsd_aes_key_ctx_cached(first_key, DSD_AES_KEY_128);
+    if (a == NULL || a != b || memcmp(a, &ctx, sizeof(ctx)) != 0) {
+        DSD_FPRINTF(stderr, "AES key cache: repeated lookup did not hit\n");
+        return 1;
+    }
+    // The same bytes as a longer key are a different schedule.
+    uint8_t long_key[32] = {0};
+    DSD_MEMCPY(long_key, first_key, sizeof(first_key));
+    if (dsd_aes_key_ctx_cached(long_key, DSD_AES_KEY_256) == a) {
+        DSD_FPRINTF(stderr, "AES key cache: key size not part of the lookup\n");
+        return 1;
+    }
+
+    // Cycle through more keys than the cache holds; every result must stay correct.
+    for (uint32_t i = 0; i < 40U; i++) {
+        uint8_t key[16];
+        uint8_t want[16];
+        fill_pattern(key, sizeof(key), 600U + (i % 20U));
+        (void)dsd_aes_key_ctx_init(&ctx, key, DSD_AES_KEY_128);
+        dsd_aes_backend_portable.ofb(&ctx, iv, want, 1);
+        aes_ofb_keystream_output(iv, key, out, DSD_AES_KEY_128, 1);
+        if (memcmp(out, want, sizeof(out)) != 0) {
+            DSD_FPRINTF(stderr, "AES key cache: wrong keystream after eviction (%u)\n", (unsigned)i);
+            return 1;
+        }
+    }
+    aes_ofb_keystream_output(iv, first_key, out, DSD_AES_KEY_128, 1);
+    if (memcmp(out, expect, sizeof(out)) != 0) {
+        DSD_FPRINTF(stderr, "AES key cache: evicted key re-expanded wrongly\n");
+        return 1;
+    }
+
+    // A flush wipes the schedules in place; the next lookup expands the key again.
+    const dsd_aes_key_ctx* before_flush = dsd_aes_key_ctx_cached(first_key, DSD_AES_KEY_128);
+    dsd_aes_key_cache_flush();
+    if (before_flush->rounds != 0 || before_flush->round_keys[0][0] != 0U) {
+        DSD_FPRINTF(stderr, "AES key cache: flush left a schedule behind\n");
+        return 1;
+    }
+    aes_ofb_keystream_output(iv, first_key, out, DSD_AES_KEY_128, 1);
+    if (memcmp(out, expect, sizeof(out)) != 0) {
+        DSD_FPRINTF(stderr, "AES key cache: wrong keystream after flush\n");
+        return 1;
+    }
+
+    if (dsd_aes_key_ctx_init(&ctx, first_key, (dsd_aes_key_size)3) != -1 || ctx.rounds != 0
+        || dsd_aes_key_ctx_cached(first_key, (dsd_aes_key_size)3) != NULL) {
+        DSD_FPRINTF(stderr, "AES key cache: invalid key size accepted\n");
+        return 1;
+    }
+    dsd_aes_key_ctx_clear(&ctx);
+    if (dsd_aes_backend_name() == NULL) {
+        DSD_FPRINTF(stderr, "AES key cache: no backend name\n");
+        return 1;
+    }
+    return 0;
+}
+
 int
 main(void) {
     int rc = 0;
@@ -225,8 +380,10 @@ main(void) {
     rc |= test_aes_ecb_in_place_multiblock();
     rc |= test_aes128_ctr_xcrypt_nist_vector();
     rc |= test_aes128_ctr_xcrypt_counter_wrap();
+    rc |= test_aes_backends_match_portable();
+    rc |= test_aes_key_cache();
     if (rc == 0) {
-        DSD_FPRINTF(stderr, "AES tests: OK\n");
+        DSD_FPRINTF(stderr, "AES tests: OK (%s)\n", dsd_aes_backend_name());
     }
     return rc;
 }
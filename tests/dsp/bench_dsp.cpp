@@ -38,6 +38,7 @@
 #include <dsd-neo/runtime/mem.h>
 #include <dsd-neo/runtime/ring.h>
 #include <stdint.h>
+#include <thread>
 #include <vector>
 #include "dsd-neo/core/safe_api.h"
 
@@ -89,6 +90,10 @@ struct DemodHolder {
     DemodHolder() : s((demod_state*)dsd_neo_aligned_malloc(sizeof(demod_state))) {
         if (s) {
             DSD_MEMSET(s, 0, sizeof(*s));
+            if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+                dsd_neo_aligned_free(s);
+                s = NULL;
+            }
         }
     }
 
@@ -109,6 +114,7 @@ struct DemodHolder {
         if (s->resamp_hist) {
             dsd_neo_aligned_free(s->resamp_hist);
         }
+        demod_buffers_release(s);
         dsd_neo_aligned_free(s);
     }
 
@@ -366,6 +372,42 @@ run_case(const BenchOptions& opts, const char* name, const char* item_unit, doub
     return 1;
 }
 
+struct InputRingFeed {
+    input_ring_state* ring;
+    const float* src;
+    size_t total;
+    size_t block;
+};
+
+/* Producer half of the cross-thread case: reserve/commit blocks, spinning while full. */
+DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    input_ring_feed_thread(void* arg) {
+    InputRingFeed* feed = static_cast<InputRingFeed*>(arg);
+    size_t sent = 0U;
+    while (sent < feed->total) {
+        size_t want = std::min(feed->block, feed->total - sent);
+        float* p1 = NULL;
+        float* p2 = NULL;
+        size_t n1 = 0U;
+        size_t n2 = 0U;
+        int grant = input_ring_reserve(feed->ring, want, &p1, &n1, &p2, &n2);
+        if (grant <= 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        DSD_MEMCPY(p1, feed->src + sent, n1 * sizeof(float));
+        if (n2 > 0U) {
+            DSD_MEMCPY(p2, feed->src + sent + n1, n2 * sizeof(float));
+        }
+        input_ring_commit(feed->ring, (size_t)grant);
+        sent += (size_t)grant;
+    }
+    DSD_THREAD_RETURN;
+}
+
 static int
 bench_input_ring(const BenchOptions& opts) {
     int ran = 0;
@@ -381,8 +423,7 @@ bench_input_ring(const BenchOptions& opts) {
     }
 
     ran += run_case(opts, "input_ring_read_block", "sample", (double)kBlock, [&]() -> float {
-        ring.tail.store(0U);
-        ring.head.store(0U);
+        ring.reset();
         float* p1 = NULL;
         float* p2 = NULL;
         size_t n1 = 0U;
@@ -398,8 +439,7 @@ bench_input_ring(const BenchOptions& opts) {
     });
 
     ran += run_case(opts, "input_ring_read_reserve", "sample", (double)kBlock, [&]() -> float {
-        ring.tail.store(0U);
-        ring.head.store(0U);
+        ring.reset();
         float* write_p1 = NULL;
         float* write_p2 = NULL;
         size_t write_n1 = 0U;
@@ -424,6 +464,40 @@ bench_input_ring(const BenchOptions& opts) {
     });
 
     input_ring_destroy(&ring);
+
+    /* Producer and consumer on separate threads, so the index handoff crosses cores. */
+    constexpr size_t kStreamTotal = 65536;
+    constexpr size_t kStreamBlock = 4096;
+    std::vector<float> stream_in(kStreamTotal);
+    fill_noise(&stream_in, 0x89abu);
+    input_ring_state stream_ring;
+    if (input_ring_init(&stream_ring, (4U * kStreamBlock) + 1U) != 0) {
+        DSD_FPRINTF(stderr, "input_ring_init failed\n");
+        return ran;
+    }
+
+    ran += run_case(opts, "input_ring_cross_thread", "sample", (double)kStreamTotal, [&]() -> float {
+        stream_ring.reset();
+        InputRingFeed feed = {&stream_ring, stream_in.data(), kStreamTotal, kStreamBlock};
+        dsd_thread_t thread;
+        if (dsd_thread_create(&thread, input_ring_feed_thread, &feed) != 0) {
+            return -1.0f;
+        }
+        size_t total = 0U;
+        float acc = 0.0f;
+        while (total < kStreamTotal) {
+            int got = input_ring_read_block(&stream_ring, out.data(), kBlock);
+            if (got <= 0) {
+                break;
+            }
+            acc += out[(size_t)got - 1U];
+            total += (size_t)got;
+        }
+        (void)dsd_thread_join(thread);
+        return acc + (float)total;
+    });
+
+    input_ring_destroy(&stream_ring);
     return ran;
 }
 
@@ -446,15 +520,13 @@ bench_output_ring(const BenchOptions& opts) {
     dsd_cond_init(&ring.ready);
     dsd_cond_init(&ring.space);
     dsd_mutex_init(&ring.ready_m);
-    ring.head.store(0);
-    ring.tail.store(0);
+    ring.reset();
     ring.write_timeouts.store(0);
     ring.read_timeouts.store(0);
 
     ran += run_case(opts, "output_ring_read_batch", "sample", (double)kBlock, [&]() -> float {
-        ring_clear(&ring);
         DSD_MEMCPY(ring.buffer, in.data(), kBlock * sizeof(float));
-        ring.head.store(kBlock);
+        ring.reset(kBlock);
         int got = ring_read_batch(&ring, out.data(), kBlock);
         return out[0] + out[(got > 0) ? (size_t)got - 1U : 0U] + (float)got;
     });
@@ -489,6 +561,40 @@ bench_u8_widen(const BenchOptions& opts) {
         return out[0] + out[kBytes - 1] + (float)combined_phase;
     });
 
+    /* Two-pass baseline for the fused kernel: full-rate floats round-trip through memory. */
+    std::vector<float> decim(kBytes / 2U);
+    std::vector<float> hist_i(30, 0.0f);
+    std::vector<float> hist_q(30, 0.0f);
+    BenchMeta hb31_meta;
+    hb31_meta.tap_count = 31;
+    hb31_meta.variant = "two_pass";
+    uint32_t two_pass_phase = 0;
+    ran += run_case(
+        opts, "widen_rotate90_then_hb31_decim2", "byte", (double)kBytes,
+        [&]() -> float {
+            two_pass_phase = widen_rotate90_u8_to_f32_bias127_phase(in.data(), out.data(), kBytes, two_pass_phase);
+            int got = simd_hb_decim2_complex(out.data(), (int)kBytes, decim.data(), hist_i.data(), hist_q.data(),
+                                             hb31_q15_taps, 31);
+            return decim[0] + decim[(got > 0) ? got - 1 : 0] + (float)got;
+        },
+        &hb31_meta);
+
+    dsd_neo_widen_hb_state hb_state;
+    widen_hb_decim2_state_reset(&hb_state);
+    BenchMeta fused_meta;
+    fused_meta.tap_count = 31;
+    fused_meta.variant = "fused";
+    uint32_t fused_phase = 0;
+    ran += run_case(
+        opts, "widen_rotate90_hb31_decim2_fused", "byte", (double)kBytes,
+        [&]() -> float {
+            uint32_t got = 0;
+            fused_phase = widen_hb_decim2_u8_to_f32_bias127(in.data(), decim.data(), kBytes, fused_phase, 1,
+                                                            &hb_state, NULL, &got);
+            return decim[0] + decim[(got > 0) ? 2U * got - 1U : 0] + (float)got;
+        },
+        &fused_meta);
+
     return ran;
 }
 
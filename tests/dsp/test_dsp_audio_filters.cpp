@@ -79,6 +79,12 @@ test_sps_filter_wrappers(void) {
     return rc;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 int
 main(void) {
     // Allocate demod_state on heap
@@ -87,6 +93,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
 
     // Test audio_lpf_filter on step input
     {
@@ -101,13 +111,13 @@ main(void) {
         audio_lpf_filter(s);
         if (!monotonic_nondecreasing(s->result, s->result_len)) {
             DSD_FPRINTF(stderr, "audio_lpf_filter: not monotonic nondecreasing on step\n");
-            free(s);
+            free_state(s);
             return 1;
         }
         // Final value should approach target (allow some residual)
         if (!(s->result[N - 1] >= 0.9f && s->result[N - 1] <= 1.0f)) {
             DSD_FPRINTF(stderr, "audio_lpf_filter: final=%f not near 1.0\n", s->result[N - 1]);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
@@ -125,23 +135,23 @@ main(void) {
         for (int i = 1; i < N; i++) {
             if (s->result[i] > s->result[i - 1]) {
                 DSD_FPRINTF(stderr, "dc_block_filter: sequence increased at %d\n", i);
-                free(s);
+                free_state(s);
                 return 1;
             }
         }
         float last = s->result[N - 1];
         if (last >= 0.5f) {
             DSD_FPRINTF(stderr, "dc_block_filter: insufficient reduction (last=%f)\n", last);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
 
     if (test_sps_filter_wrappers() != 0) {
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
@@ -71,6 +71,7 @@ free_demod_state(demod_state* d) {
     }
     dsd_neo_aligned_free(d->post_polydecim_taps);
     dsd_neo_aligned_free(d->post_polydecim_hist);
+    demod_buffers_release(d);
     free(d);
 }
 
@@ -94,6 +95,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(d1, 0, sizeof(*d1));
+    if (demod_buffers_reserve(d1, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free_demod_state(d1);
+        return 1;
+    }
     for (int i = 0; i < N; i++) {
         d1->input_cb_buf[i] = iq_pass[(size_t)i];
     }
@@ -119,6 +124,11 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(d2, 0, sizeof(*d2));
+    if (demod_buffers_reserve(d2, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free_demod_state(d1);
+        free_demod_state(d2);
+        return 1;
+    }
     for (int i = 0; i < N; i++) {
         d2->input_cb_buf[i] = iq_stop[(size_t)i];
     }
@@ -34,12 +34,22 @@ alloc_state(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
     if (s) {
         DSD_MEMSET(s, 0, sizeof(*s));
+        if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+            free(s);
+            return NULL;
+        }
         /* Initialize TED state */
         ted_init_state(&s->ted_state);
     }
     return s;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 static void
 run_cqpsk_chain(demod_state* s) {
     if (!s || !s->cqpsk_enable) {
@@ -103,7 +113,7 @@ test_basic_passthrough(void) {
     if (out_pairs < 1) {
         DSD_FPRINTF(stderr, "BASIC: no output symbols produced (lp_len=%d)\n", s->lp_len);
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -111,7 +121,7 @@ test_basic_passthrough(void) {
     if (!s->costas_state.initialized) {
         DSD_FPRINTF(stderr, "BASIC: Costas loop not initialized\n");
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -126,12 +136,12 @@ test_basic_passthrough(void) {
     if (avg_mag < 0.01f || avg_mag > 5.0f) {
         DSD_FPRINTF(stderr, "BASIC: output magnitude out of range (avg_mag=%f)\n", avg_mag);
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
     free(buf);
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -193,7 +203,7 @@ test_cfo_tracking(void) {
     }
 
     free(buf);
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -224,12 +234,12 @@ test_disabled_when_not_cqpsk(void) {
     for (int i = 0; i < 100; i++) {
         if (buf[i] < ref[i] || ref[i] < buf[i]) {
             DSD_FPRINTF(stderr, "DISABLED: buffer modified when cqpsk_enable=0\n");
-            free(s);
+            free_state(s);
             return 1;
         }
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -277,7 +287,7 @@ test_diff_phasor_correctness(void) {
     float ang0 = atan2f(buf[1], buf[0]);
     if (fabsf(ang0) > 0.1f) {
         DSD_FPRINTF(stderr, "DIFF: sample 0 angle wrong (ang=%f, expected ~0)\n", ang0);
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -286,11 +296,11 @@ test_diff_phasor_correctness(void) {
     float target1 = 1.5708f; /* pi/2 */
     if (fabsf(ang1 - target1) > 0.1f) {
         DSD_FPRINTF(stderr, "DIFF: sample 1 angle wrong (ang=%f, expected ~90°)\n", ang1);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -338,7 +348,7 @@ test_costas_normalizes_reliable_magnitude(void) {
         float mag = sqrtf(I * I + Q * Q);
         if (fabsf(mag - target) > 0.0001f) {
             DSD_FPRINTF(stderr, "COSTAS NORM: sample %d magnitude %f expected %f\n", k, mag, target);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
@@ -346,11 +356,11 @@ test_costas_normalizes_reliable_magnitude(void) {
     float ang1 = atan2f(buf[3], buf[2]);
     if (fabsf(ang1 - 1.5708f) > 0.1f) {
         DSD_FPRINTF(stderr, "COSTAS NORM: sample 1 phase changed unexpectedly (ang=%f)\n", ang1);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -388,7 +398,7 @@ test_costas_deep_fade_does_not_boost_or_train(void) {
         float mag = sqrtf(I * I + Q * Q);
         if (mag > 0.05f) {
             DSD_FPRINTF(stderr, "COSTAS FADE: sample %d magnitude %f was boosted\n", k, mag);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
@@ -397,18 +407,18 @@ test_costas_deep_fade_does_not_boost_or_train(void) {
         || fabsf(s->costas_state.error_smooth) > 1.0e-7f) {
         DSD_FPRINTF(stderr, "COSTAS FADE: loop trained on deep fade phase=%f freq=%f smooth=%f\n",
                     s->costas_state.phase, s->costas_state.freq, s->costas_state.error_smooth);
-        free(s);
+        free_state(s);
         return 1;
     }
     if (s->costas_err_avg_q14 != 0 || s->costas_err_raw_avg_q14 != 0 || s->costas_conf_avg_q14 != 0
         || s->costas_zero_conf_pct != 100) {
         DSD_FPRINTF(stderr, "COSTAS FADE: metrics smooth=%d raw=%d conf=%d zero=%d\n", s->costas_err_avg_q14,
                     s->costas_err_raw_avg_q14, s->costas_conf_avg_q14, s->costas_zero_conf_pct);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -438,7 +448,7 @@ run_single_costas_update(float mag, float* out_freq) {
     if (out_freq) {
         *out_freq = s->costas_state.freq;
     }
-    free(s);
+    free_state(s);
     return phase;
 }
 
@@ -513,7 +523,7 @@ test_costas_smooths_error_step(void) {
         DSD_FPRINTF(stderr, "COSTAS SMOOTH: err=%f smooth=%f freq=%f phase=%f expected err=%f freq=%f phase=%f\n",
                     s->costas_state.error, s->costas_state.error_smooth, s->costas_state.freq, s->costas_state.phase,
                     expected_error, expected_freq, expected_phase);
-        free(s);
+        free_state(s);
         return 1;
     }
     int expected_raw_q14 = (int)lrintf(fabsf(raw_error) * 16384.0f);
@@ -523,11 +533,11 @@ test_costas_smooths_error_step(void) {
         DSD_FPRINTF(stderr, "COSTAS SMOOTH: metrics smooth=%d raw=%d conf=%d zero=%d expected smooth=%d raw=%d\n",
                     s->costas_err_avg_q14, s->costas_err_raw_avg_q14, s->costas_conf_avg_q14, s->costas_zero_conf_pct,
                     expected_smooth_q14, expected_raw_q14);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -576,11 +586,11 @@ test_costas_adapts_smoothing_for_phase_kick(void) {
                     "COSTAS ADAPT: err=%f smooth=%f freq=%f phase=%f expected err=%f freq=%f phase=%f fixed=%f\n",
                     s->costas_state.error, s->costas_state.error_smooth, s->costas_state.freq, s->costas_state.phase,
                     expected_error, expected_freq, expected_phase, fixed_error);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -625,7 +635,7 @@ test_ted_initialization(void) {
     if (s->ted_state.omega != 0.0f) {
         DSD_FPRINTF(stderr, "TED: omega should start at 0 before call\n");
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -635,19 +645,19 @@ test_ted_initialization(void) {
     if (s->ted_state.omega < 1.0f) {
         DSD_FPRINTF(stderr, "TED: omega not initialized after call (omega=%f)\n", s->ted_state.omega);
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
     if (s->ted_state.twice_sps < 2) {
         DSD_FPRINTF(stderr, "TED: twice_sps not initialized (twice_sps=%d)\n", s->ted_state.twice_sps);
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
     free(buf);
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -695,12 +705,12 @@ test_gardner_omega_absolute_clamp_p25p2(void) {
     if (omega_delta > 0.0021f) {
         DSD_FPRINTF(stderr, "GARDNER: omega delta %f exceeds OP25 absolute clamp\n", omega_delta);
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
     free(buf);
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -743,12 +753,12 @@ expect_p25p2_tracking_gain_after_lock(const char* label, float ted_gain, int ted
     if (fabsf(s->ted_effective_gain - expected_gain) > 0.0001f) {
         DSD_FPRINTF(stderr, "%s: got effective TED gain %.6f want %.6f\n", label, s->ted_effective_gain, expected_gain);
         free(buf);
-        free(s);
+        free_state(s);
         return 1;
     }
 
     free(buf);
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -793,11 +803,11 @@ test_diff_phasor_short_block_preserves_state(void) {
     if (buf[0] != 0.25f || buf[1] != -0.5f || s->cqpsk_diff_prev_r != 0.4f || s->cqpsk_diff_prev_j != -0.7f) {
         DSD_FPRINTF(stderr, "DIFF GUARD: short block changed buf=(%f,%f) prev=(%f,%f)\n", buf[0], buf[1],
                     s->cqpsk_diff_prev_r, s->cqpsk_diff_prev_j);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -829,7 +839,7 @@ test_costas_clamps_initial_phase_and_frequency(void) {
         || !std::isfinite(buf[0]) || !std::isfinite(buf[1])) {
         DSD_FPRINTF(stderr, "COSTAS CLAMP: high clamp phase=%f freq=%f out=(%f,%f)\n", s->costas_state.phase,
                     s->costas_state.freq, buf[0], buf[1]);
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -843,11 +853,11 @@ test_costas_clamps_initial_phase_and_frequency(void) {
 
     if (fabsf(s->costas_state.phase + (float)(M_PI / 2.0)) > 0.001f || s->costas_state.freq != -1.0f) {
         DSD_FPRINTF(stderr, "COSTAS CLAMP: low clamp phase=%f freq=%f\n", s->costas_state.phase, s->costas_state.freq);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -881,11 +891,11 @@ test_costas_nonfinite_sample_is_rejected(void) {
         DSD_FPRINTF(stderr, "COSTAS NONFINITE: out=(%f,%f) err=%f smooth=%f conf=%d zero=%d\n", buf[0], buf[1],
                     s->costas_state.error, s->costas_state.error_smooth, s->costas_conf_avg_q14,
                     s->costas_zero_conf_pct);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -915,11 +925,11 @@ test_gardner_oversized_sps_disables_output(void) {
     if (s->lp_len != 0 || s->ted_state.twice_sps != 0 || s->ted_state.omega_mid != 200.0f) {
         DSD_FPRINTF(stderr, "GARDNER OVERSIZE: lp_len=%d twice_sps=%d omega_mid=%f\n", s->lp_len,
                     s->ted_state.twice_sps, s->ted_state.omega_mid);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
@@ -957,16 +967,16 @@ test_fll_band_edge_processes_block(void) {
         DSD_FPRINTF(stderr, "FLL PROCESS: initialized=%d sps=%d taps=%d delay=%d/%d phase=%f freq=%f min=%f max=%f\n",
                     f->initialized, f->sps, f->n_taps, f->delay_idx, expected_delay, f->phase, f->freq, f->min_freq,
                     f->max_freq);
-        free(s);
+        free_state(s);
         return 1;
     }
     if (f->delay_r[0] == 0.0f && f->delay_i[0] == 0.0f) {
         DSD_FPRINTF(stderr, "FLL PROCESS: delay line was not populated\n");
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
 
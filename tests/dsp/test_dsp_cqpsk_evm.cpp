@@ -170,6 +170,10 @@ make_state(int sps) {
         return nullptr;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return nullptr;
+    }
     ted_init_state(&s->ted_state);
 
     s->rate_in = kRateHz;
@@ -234,6 +238,7 @@ run_chain_evm(const Waveform& wf, int sps, double* evm_out, int* symbols_out) {
         }
     }
 
+    demod_buffers_release(s);
     free(s);
     if (n_meas <= 0 || ref_acc <= 0.0) {
         return 1;
@@ -9,6 +9,7 @@
 #include <cstdlib>
 #include <dsd-neo/dsp/demod_pipeline.h>
 #include <dsd-neo/dsp/demod_state.h>
+#include <dsd-neo/dsp/resampler.h>
 #include <stdio.h>
 #include "dsd-neo/core/safe_api.h"
 
@@ -27,6 +28,12 @@ monotonic_nondecreasing(const float* x, int n) {
     return 1;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 static double
 channel_lpf_tone_gain(demod_state* s, int profile, double tone_hz) {
     const int sample_rate = 48000;
@@ -34,7 +41,11 @@ channel_lpf_tone_gain(demod_state* s, int profile, double tone_hz) {
     const float amp = 0.75f;
     const double two_pi = 6.28318530717958647692;
 
+    demod_buffers_release(s);
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        return 0.0;
+    }
     s->rate_in = sample_rate;
     s->rate_out = sample_rate;
     s->rate_out2 = 0;
@@ -130,6 +141,44 @@ test_channel_lpf_protected_edge(void) {
     return 1;
 }
 
+/*
+ * Work buffers follow the configured block length and the resampler ratio,
+ * and a re-size keeps `lowpassed` on the new arena.
+ */
+static int
+test_work_buffer_arena(void) {
+    demod_state* s = (demod_state*)malloc(sizeof(demod_state));
+    if (!s) {
+        return 0;
+    }
+    DSD_MEMSET(s, 0, sizeof(*s));
+    int ok = demod_buffers_reserve(s, 1000) == 0 && s->work_len >= 1000 && s->resamp_outbuf == NULL
+             && s->lowpassed == s->input_cb_buf && s->result == s->input_cb_buf + s->work_len;
+
+    s->resamp_enabled = 1;
+    s->resamp_L = 5;
+    s->resamp_M = 2;
+    ok = ok && demod_buffers_reserve(s, 4000) == 0 && s->work_len >= 4000 && s->lowpassed == s->input_cb_buf
+         && s->resamp_outbuf != NULL && s->resamp_out_len >= resamp_output_capacity(s, s->work_len);
+    if (ok) {
+        s->input_cb_buf[s->work_len - 1] = 1.0f;
+        s->hb_workbuf[s->work_len - 1] = 1.0f;
+        s->resamp_outbuf[s->resamp_out_len - 1] = 1.0f;
+    }
+
+    s->resamp_enabled = 0;
+    ok = ok && demod_buffers_reserve(s, 4000) == 0 && s->resamp_outbuf == NULL && s->resamp_out_len == 0;
+    ok = ok && demod_buffers_reserve(s, 0) != 0 && s->work_len >= 4000;
+
+    demod_buffers_release(s);
+    ok = ok && s->work_len == 0 && s->input_cb_buf == NULL && s->lowpassed == NULL;
+    free(s);
+    if (!ok) {
+        DSD_FPRINTF(stderr, "demod work buffers: reserve/re-size/release mismatch\n");
+    }
+    return ok;
+}
+
 int
 main(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
@@ -137,12 +186,16 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
-
-    if (!test_channel_lpf_protected_edge()) {
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
         free(s);
         return 1;
     }
 
+    if (!test_channel_lpf_protected_edge() || !test_work_buffer_arena()) {
+        free_state(s);
+        return 1;
+    }
+
     // deemph_filter: step response
     {
         const int N = 64;
@@ -155,12 +208,12 @@ main(void) {
         deemph_filter(s);
         if (!monotonic_nondecreasing(s->result, N)) {
             DSD_FPRINTF(stderr, "deemph_filter: non-monotonic step response\n");
-            free(s);
+            free_state(s);
             return 1;
         }
         if (!approx_eq(s->result[N - 1], 1.0f, 1e-4f)) {
             DSD_FPRINTF(stderr, "deemph_filter: final=%f not near 1.0\n", s->result[N - 1]);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
@@ -179,13 +232,13 @@ main(void) {
         low_pass_real(s);
         if (s->result_len != N / 2) {
             DSD_FPRINTF(stderr, "low_pass_real: result_len=%d want %d\n", s->result_len, N / 2);
-            free(s);
+            free_state(s);
             return 1;
         }
         for (int i = 0; i < s->result_len; i++) {
             if (!approx_eq(s->result[i], 0.5f, 1e-4f)) {
                 DSD_FPRINTF(stderr, "low_pass_real: out[%d]=%f not ~0.5\n", i, s->result[i]);
-                free(s);
+                free_state(s);
                 return 1;
             }
         }
@@ -203,7 +256,7 @@ main(void) {
         dsd_fm_demod(s);
         if (s->result_len != 3) {
             DSD_FPRINTF(stderr, "dsd_fm_demod: result_len=%d want 3\n", s->result_len);
-            free(s);
+            free_state(s);
             return 1;
         }
         /* With the first sample seeded from history the delta is zero, and
@@ -211,24 +264,24 @@ main(void) {
         const float pi_2 = 1.5707963f;
         if (fabsf(s->result[0]) > 0.01f) {
             DSD_FPRINTF(stderr, "dsd_fm_demod: result[0]=%f want ~0\n", s->result[0]);
-            free(s);
+            free_state(s);
             return 1;
         }
         for (int i = 1; i < s->result_len; i++) {
             float expect = pi_2;
             if (fabsf(s->result[i] - expect) > 0.01f) {
                 DSD_FPRINTF(stderr, "dsd_fm_demod: result[%d]=%f want ~%f\n", i, s->result[i], expect);
-                free(s);
+                free_state(s);
                 return 1;
             }
         }
     }
 
     if (check_channel_lpf_protected_edges(s) != 0) {
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
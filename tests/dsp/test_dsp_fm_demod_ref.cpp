@@ -12,6 +12,12 @@
 #include <stdio.h>
 #include "dsd-neo/core/safe_api.h"
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 int
 main(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
@@ -19,6 +25,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
 
     // Build a complex tone that advances by constant phase per sample
     const int N = 256; // complex pairs
@@ -48,13 +58,13 @@ main(void) {
     float expect_rad = (float)atan2(im, re);
     if (s->result_len != N) {
         DSD_FPRINTF(stderr, "FM demod ref: result_len=%d want %d\n", s->result_len, N);
-        free(s);
+        free_state(s);
         return 1;
     }
     // First sample seeds history; steady-state starts at index 1
     if (fabsf(s->result[0]) > 1e-3f) {
         DSD_FPRINTF(stderr, "FM demod ref: result[0]=%f want 0\n", s->result[0]);
-        free(s);
+        free_state(s);
         return 1;
     }
     for (int i = 1; i < s->result_len; i++) {
@@ -62,12 +72,17 @@ main(void) {
         float d = fabsf(v - expect_rad);
         if (d > 0.01f) { // allow small tolerance for native float output
             DSD_FPRINTF(stderr, "FM demod ref: result[%d]=%f expect~%f\n", i, v, expect_rad);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
 
+    demod_buffers_release(s);
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
     const double small_dphi = 0.08;
     for (int k = 0; k < N; k++) {
         double th = k * small_dphi;
@@ -91,11 +106,11 @@ main(void) {
         float d = fabsf(v - expect_rad);
         if (d > 1e-4f) {
             DSD_FPRINTF(stderr, "FM demod small-angle: result[%d]=%f expect~%f\n", i, v, expect_rad);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
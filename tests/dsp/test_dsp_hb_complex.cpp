@@ -20,6 +20,12 @@ approx_eq(float a, float b, float tol) {
     return d <= tol;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 int
 main(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
@@ -27,6 +33,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
 
     // Prepare constant DC complex input
     const int pairs = 128;
@@ -48,7 +58,7 @@ main(void) {
     // Expect 2:1 complex decimation (elements halved)
     if (s->result_len != pairs) {
         DSD_FPRINTF(stderr, "HB complex: result_len=%d want %d\n", s->result_len, pairs);
-        free(s);
+        free_state(s);
         return 1;
     }
     // After warmup (~HB_TAPS), DC should be preserved within a few LSBs
@@ -57,11 +67,11 @@ main(void) {
         float Q = s->result[(size_t)(2 * k) + 1];
         if (!approx_eq(I, 0.25f, 1e-3f) || !approx_eq(Q, -0.125f, 1e-3f)) {
             DSD_FPRINTF(stderr, "HB complex: sample %d=(%f,%f) deviates from DC\n", k, I, Q);
-            free(s);
+            free_state(s);
             return 1;
         }
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
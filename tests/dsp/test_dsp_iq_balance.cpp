@@ -31,6 +31,12 @@ impropriety_ratio(const float* x, int pairs) {
     return num / p2;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 int
 main(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
@@ -38,6 +44,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
 
     const int pairs = 512;
     static float buf[(size_t)pairs * 2];
@@ -61,7 +71,7 @@ main(void) {
     double pre = impropriety_ratio(buf, pairs);
     if (pre < 0.01) {
         DSD_FPRINTF(stderr, "IQBAL test: pre impropriety unexpectedly small %.4f\n", pre);
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -80,10 +90,10 @@ main(void) {
     double post = impropriety_ratio(s->lowpassed, s->lp_len / 2);
     if (!(post < pre)) {
         DSD_FPRINTF(stderr, "IQBAL test: post impropriety %.4f not reduced from %.4f\n", post, pre);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
@@ -22,6 +22,12 @@ mean_of(const float* x, int n, int step) {
     return (cnt > 0.0) ? acc / cnt : 0.0;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 int
 main(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
@@ -29,6 +35,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
 
     const int pairs = 256;
     static float in[(size_t)pairs * 2];
@@ -57,15 +67,15 @@ main(void) {
 
     if (!(pre_I > 0.09 && pre_Q < -0.04)) {
         DSD_FPRINTF(stderr, "IQ DC pre means unexpected: I=%.2f Q=%.2f\n", pre_I, pre_Q);
-        free(s);
+        free_state(s);
         return 1;
     }
     if (!(post_I > -0.005 && post_I < 0.005 && post_Q > -0.005 && post_Q < 0.005)) {
         DSD_FPRINTF(stderr, "IQ DC block insufficient: post I=%.2f Q=%.2f\n", post_I, post_Q);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
@@ -11,6 +11,7 @@
  * - Complex symmetric FIR filter (channel LPF)
  * - Complex half-band decimator
  * - Real half-band decimator
+ * - Real polyphase interpolator
  *
  * Covers edge cases: small blocks, odd lengths, history continuity, alignment.
  */
@@ -36,6 +37,8 @@ extern "C" int simd_hb_decim2_complex_sse2(const float* in, int in_len, float* o
                                            const float* taps, int taps_len);
 extern "C" int simd_hb_decim2_real_sse2(const float* in, int in_len, float* out, float* hist, const float* taps,
                                         int taps_len);
+extern "C" int simd_fir_interp_real_sse2(const float* in, int in_len, float* out, float* hist,
+                                          const float* phase_taps, int phases, int phase_len);
 #if defined(DSD_NEO_TEST_HAVE_AVX2_IMPL)
 extern "C" void simd_fir_complex_apply_avx2(const float* in, int in_len, float* out, float* hist_i, float* hist_q,
                                             const float* taps, int taps_len);
@@ -43,6 +46,8 @@ extern "C" int simd_hb_decim2_complex_avx2(const float* in, int in_len, float* o
                                            const float* taps, int taps_len);
 extern "C" int simd_hb_decim2_real_avx2(const float* in, int in_len, float* out, float* hist, const float* taps,
                                         int taps_len);
+extern "C" int simd_fir_interp_real_avx2(const float* in, int in_len, float* out, float* hist,
+                                          const float* phase_taps, int phases, int phase_len);
 #endif
 #endif
 
@@ -53,6 +58,8 @@ extern "C" int simd_hb_decim2_complex_neon(const float* in, int in_len, float* o
                                            const float* taps, int taps_len);
 extern "C" int simd_hb_decim2_real_neon(const float* in, int in_len, float* out, float* hist, const float* taps,
                                         int taps_len);
+extern "C" int simd_fir_interp_real_neon(const float* in, int in_len, float* out, float* hist,
+                                          const float* phase_taps, int phases, int phase_len);
 #endif
 
 static const float kTolerance = 1e-5f;
@@ -91,6 +98,7 @@ randf() {
 using complex_fir_backend_fn = void (*)(const float*, int, float*, float*, float*, const float*, int);
 using complex_hb_backend_fn = int (*)(const float*, int, float*, float*, float*, const float*, int);
 using real_hb_backend_fn = int (*)(const float*, int, float*, float*, const float*, int);
+using interp_real_backend_fn = int (*)(const float*, int, float*, float*, const float*, int, int);
 
 static int
 test_direct_complex_fir_backend(const char* name, complex_fir_backend_fn fn) {
@@ -1189,6 +1197,71 @@ test_public_scalar_fallback_edges() {
     return 0;
 }
 
+/*
+ * Polyphase interpolator backends against the scalar reference: full vector
+ * blocks, vector-plus-tail blocks, blocks shorter than the history, and the
+ * history carried between them.
+ */
+static int
+test_interp_real_backend(const char* name, interp_real_backend_fn fn) {
+    std::printf("Testing real polyphase interpolator (%s)...\n", name);
+
+    const int shapes[][2] = {{6, 16}, {6, 5}, {3, 1}};
+    const int blocks[] = {160, 13, 3, 64};
+    for (const auto& shape : shapes) {
+        const int phases = shape[0];
+        const int phase_len = shape[1];
+        const int hist_len = phase_len - 1;
+        std::vector<float> taps((size_t)phases * (size_t)phase_len);
+        for (float& t : taps) {
+            t = randf();
+        }
+        std::vector<float> hist_simd((size_t)hist_len + 1U);
+        std::vector<float> hist_ref((size_t)hist_len + 1U);
+        for (int k = 0; k < hist_len; k++) {
+            hist_simd[(size_t)k] = hist_ref[(size_t)k] = randf();
+        }
+
+        for (int in_len : blocks) {
+            std::vector<float> in((size_t)in_len);
+            for (float& x : in) {
+                x = randf();
+            }
+            const size_t out_len = (size_t)in_len * (size_t)phases;
+            std::vector<float> out_simd(out_len);
+            std::vector<float> out_ref(out_len);
+
+            int len_simd = fn(in.data(), in_len, out_simd.data(), hist_simd.data(), taps.data(), phases, phase_len);
+            int len_ref = simd_fir_interp_real_scalar(in.data(), in_len, out_ref.data(), hist_ref.data(), taps.data(),
+                                                      phases, phase_len);
+
+            if (len_simd != len_ref || len_ref != (int)out_len) {
+                DSD_FPRINTF(stderr, "  FAIL: %dx%d block %d length %d (want %d)\n", phases, phase_len, in_len,
+                            len_simd, len_ref);
+                return 1;
+            }
+            if (!arrays_close(out_simd.data(), out_ref.data(), (int)out_len, kTolerance)
+                || !arrays_close(hist_simd.data(), hist_ref.data(), hist_len, kTolerance)) {
+                DSD_FPRINTF(stderr, "  FAIL: %dx%d block %d mismatch\n", phases, phase_len, in_len);
+                return 1;
+            }
+        }
+    }
+
+    float in[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float out[4] = {7.0f, 7.0f, 7.0f, 7.0f};
+    float hist[4] = {};
+    const float taps[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    if (fn(in, 4, out, hist, taps, 0, 4) != 0 || fn(in, 4, out, hist, taps, 1, 0) != 0
+        || fn(in, 0, out, hist, taps, 1, 4) != 0 || out[0] != 7.0f) {
+        DSD_FPRINTF(stderr, "  FAIL: Invalid interpolator arguments touched the output\n");
+        return 1;
+    }
+
+    std::printf("  PASS\n");
+    return 0;
+}
+
 int
 main(void) {
     std::printf("SIMD FIR implementation: %s\n\n", simd_fir_get_impl_name());
@@ -1216,6 +1289,7 @@ main(void) {
     failures += test_complex_short_block_history();
     failures += test_zero_output_history_updates();
     failures += test_public_scalar_fallback_edges();
+    failures += test_interp_real_backend("dispatch", simd_fir_interp_real);
 
 #if defined(__x86_64__) || defined(_M_X64)
     failures += test_direct_complex_fir_backend("sse2", simd_fir_complex_apply_sse2);
@@ -1226,6 +1300,7 @@ main(void) {
     failures += test_direct_backend_invalid_guards("sse2", simd_fir_complex_apply_sse2, simd_hb_decim2_complex_sse2,
                                                    simd_hb_decim2_real_sse2);
     failures += test_direct_fixed_hb_kernels("sse2", simd_hb_decim2_complex_sse2, 7);
+    failures += test_interp_real_backend("sse2", simd_fir_interp_real_sse2);
 #if defined(DSD_NEO_TEST_HAVE_AVX2_IMPL)
     if (dsd_neo_cpu_has_avx2_with_os_support()) {
         failures += test_direct_complex_fir_backend("avx2", simd_fir_complex_apply_avx2);
@@ -1236,6 +1311,7 @@ main(void) {
         failures += test_direct_backend_invalid_guards("avx2", simd_fir_complex_apply_avx2, simd_hb_decim2_complex_avx2,
                                                        simd_hb_decim2_real_avx2);
         failures += test_direct_fixed_hb_kernels("avx2", simd_hb_decim2_complex_avx2, 15);
+        failures += test_interp_real_backend("avx2", simd_fir_interp_real_avx2);
     } else {
         std::printf("Skipping direct AVX2 backend tests: CPU/OS AVX2+FMA support unavailable\n");
     }
@@ -1251,6 +1327,7 @@ main(void) {
     failures += test_direct_backend_invalid_guards("neon", simd_fir_complex_apply_neon, simd_hb_decim2_complex_neon,
                                                    simd_hb_decim2_real_neon);
     failures += test_direct_fixed_hb_kernels("neon", simd_hb_decim2_complex_neon, 7);
+    failures += test_interp_real_backend("neon", simd_fir_interp_real_neon);
 #endif
 
     if (failures > 0) {
@@ -3,8 +3,9 @@
  * Copyright (C) 2025 by arancormonk <180709949+arancormonk@users.noreply.github.com>
  */
 
-/* Focused unit test for SIMD u8->float widening and 90° rotate+widen. */
+/* Focused unit test for SIMD u8->float widening, 90° rotate+widen, and the fused half-band path. */
 
+#include <dsd-neo/dsp/halfband.h>
 #include <dsd-neo/dsp/simd_widen.h>
 #include <math.h>
 #include <stdint.h>
@@ -14,6 +15,8 @@
 #include "io/radio/rtl_capture_phase.h"
 
 #if defined(__x86_64__) || defined(_M_X64)
+extern "C" void widen_u8_to_f32_bias127_sse2(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void widen_s16_to_f32_sse2(const int16_t* src, float* dst, uint32_t len);
 extern "C" void widen_u8_to_f32_bias127_moments_sse2(const unsigned char* src, float* dst, uint32_t len,
                                                      dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_sse2(const unsigned char* src, float* dst, uint32_t len,
@@ -21,17 +24,23 @@ extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_sse2(const unsigned c
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_sse2(const unsigned char* src, float* dst,
                                                                         uint32_t len, uint32_t phase,
                                                                         dsd_input_level_cu8_moments* moments);
+extern "C" void hb31_decim2_iq_sse2(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 #if defined(DSD_NEO_TEST_HAVE_AVX2_IMPL)
 #include "dsp/simd_x86_cpu.h"
+extern "C" void widen_u8_to_f32_bias127_avx2(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void widen_s16_to_f32_avx2(const int16_t* src, float* dst, uint32_t len);
 extern "C" void widen_u8_to_f32_bias127_moments_avx2(const unsigned char* src, float* dst, uint32_t len,
                                                      dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_avx2(const unsigned char* src, float* dst,
                                                                         uint32_t len, uint32_t phase,
                                                                         dsd_input_level_cu8_moments* moments);
+extern "C" void hb31_decim2_iq_avx2(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 #endif
 #endif
 
 #if defined(__aarch64__) || defined(__arm64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+extern "C" void widen_u8_to_f32_bias127_neon(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void widen_s16_to_f32_neon(const int16_t* src, float* dst, uint32_t len);
 extern "C" void widen_u8_to_f32_bias127_moments_neon(const unsigned char* src, float* dst, uint32_t len,
                                                      dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_neon(const unsigned char* src, float* dst, uint32_t len,
@@ -39,8 +48,12 @@ extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_neon(const unsigned c
 extern "C" uint32_t widen_rotate90_u8_to_f32_bias127_phase_moments_neon(const unsigned char* src, float* dst,
                                                                         uint32_t len, uint32_t phase,
                                                                         dsd_input_level_cu8_moments* moments);
+extern "C" void hb31_decim2_iq_neon(const float* x, uint32_t out_pairs, const float* taps, float* dst);
 #endif
 
+extern "C" void dsd_test_hb31_decim2_iq_scalar(const float* x, uint32_t out_pairs, const float* taps, float* dst);
+extern "C" void dsd_test_widen_u8_to_f32_bias127_scalar(const unsigned char* src, float* dst, uint32_t len);
+extern "C" void dsd_test_widen_s16_to_f32_scalar(const int16_t* src, float* dst, uint32_t len);
 extern "C" void dsd_test_widen_u8_to_f32_bias127_moments_scalar(const unsigned char* src, float* dst, uint32_t len,
                                                                 dsd_input_level_cu8_moments* moments);
 extern "C" uint32_t dsd_test_widen_rotate90_u8_to_f32_bias127_phase_scalar(const unsigned char* src, float* dst,
@@ -137,6 +150,38 @@ seed_moments(dsd_input_level_cu8_moments* moments) {
     (void)dsd_input_level_cu8_moments_accumulate(moments, seed, sizeof(seed));
 }
 
+typedef void (*widen_u8_backend_fn)(const unsigned char*, float*, uint32_t);
+typedef void (*widen_s16_backend_fn)(const int16_t*, float*, uint32_t);
+
+/* Odd lengths cover the scalar tail after the vector body. */
+static int
+test_plain_widen_backends(const char* name, widen_u8_backend_fn u8_fn, widen_s16_backend_fn s16_fn) {
+    unsigned char src_u8[301];
+    int16_t src_s16[301];
+    float dst[301] = {0};
+    float ref[301] = {0};
+    for (unsigned int i = 0U; i < 301U; i++) {
+        src_u8[i] = (unsigned char)((i * 37U) & 0xFFU);
+        src_s16[i] = (int16_t)((int)((i * 7919U) & 0xFFFFU) - 32768);
+    }
+    src_s16[0] = INT16_MIN;
+    src_s16[1] = INT16_MAX;
+
+    dsd_test_widen_u8_to_f32_bias127_scalar(src_u8, ref, 301U);
+    u8_fn(src_u8, dst, 301U);
+    if (!arrays_close(dst, ref, 301, 1e-6f)) {
+        DSD_FPRINTF(stderr, "%s u8 widen: mismatch\n", name);
+        return 1;
+    }
+    dsd_test_widen_s16_to_f32_scalar(src_s16, ref, 301U);
+    s16_fn(src_s16, dst, 301U);
+    if (!arrays_close(dst, ref, 301, 0.0f)) {
+        DSD_FPRINTF(stderr, "%s s16 widen: mismatch\n", name);
+        return 1;
+    }
+    return 0;
+}
+
 static int
 test_plain_moments_backend(const char* name, widen_moments_backend_fn fn) {
     unsigned char src[256];
@@ -270,6 +315,123 @@ test_rotate_widen_backend(const char* name, widen_backend_fn fn) {
     return 0;
 }
 
+using hb31_kernel_fn = void (*)(const float*, uint32_t, const float*, float*);
+
+static unsigned int
+lcg_next(unsigned int* state) {
+    *state = *state * 1103515245U + 12345U;
+    return (*state >> 16) & 0x7fffU;
+}
+
+/* An ISA kernel must match the scalar kernel, including the odd-count tail. */
+static int
+test_hb31_kernel_backend(const char* name, hb31_kernel_fn fn) {
+    enum { kOut = 37, kInPairs = 2 * kOut + 30 + 1 };
+    float x[2 * kInPairs];
+    float ref[2 * kOut] = {0};
+    float got[2 * kOut] = {0};
+    unsigned int seed = 7U;
+    for (int i = 0; i < 2 * kInPairs; i++) {
+        x[i] = (float)lcg_next(&seed) / 16384.0f - 1.0f;
+    }
+    dsd_test_hb31_decim2_iq_scalar(x, kOut, hb31_q15_taps, ref);
+    fn(x, kOut, hb31_q15_taps, got);
+    if (!arrays_close(got, ref, 2 * kOut, 1e-6f)) {
+        DSD_FPRINTF(stderr, "%s half-band kernel: mismatch\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * The fused path equals rotate+widen followed by a 31-tap direct-form
+ * decimator over the stream prefixed with 15 zero pairs, and gives the same
+ * output and phase however the bytes are split across calls.
+ */
+static int
+test_fused_widen_hb(void) {
+    enum { kPairs = 2600 };
+    static unsigned char src[2 * kPairs];
+    static float wide[2 * (kPairs + 15)];
+    static float ref[kPairs];
+    static float full[kPairs];
+    static float split[kPairs];
+    unsigned int seed = 11U;
+    for (int i = 0; i < 2 * kPairs; i++) {
+        src[i] = (unsigned char)(lcg_next(&seed) & 0xffU);
+    }
+
+    DSD_MEMSET(wide, 0, sizeof(wide));
+    const uint32_t ref_phase =
+        dsd_test_widen_rotate90_u8_to_f32_bias127_phase_scalar(src, wide + 30, 2U * kPairs, 1U);
+    dsd_neo_widen_hb_state st;
+    widen_hb_decim2_state_reset(&st);
+    const uint32_t expect_out = widen_hb_decim2_out_pairs(&st, kPairs);
+    if (expect_out != (kPairs - 16U) / 2U + 1U || widen_hb_decim2_in_pairs(&st, expect_out) != 2U * expect_out + 14U) {
+        DSD_FPRINTF(stderr, "fused widen+hb sizing: out=%u\n", expect_out);
+        return 1;
+    }
+    for (uint32_t n = 0; n < expect_out; n++) {
+        double acc_i = 0.0;
+        double acc_q = 0.0;
+        for (uint32_t k = 0; k < 31U; k++) {
+            acc_i += (double)hb31_q15_taps[k] * (double)wide[2U * (2U * n + k)];
+            acc_q += (double)hb31_q15_taps[k] * (double)wide[2U * (2U * n + k) + 1U];
+        }
+        ref[2U * n] = (float)acc_i;
+        ref[2U * n + 1U] = (float)acc_q;
+    }
+
+    dsd_input_level_cu8_moments moments;
+    dsd_input_level_cu8_moments expected;
+    dsd_input_level_cu8_moments_reset(&moments);
+    dsd_input_level_cu8_moments_reset(&expected);
+    (void)dsd_input_level_cu8_moments_accumulate(&expected, src, sizeof(src));
+    uint32_t got = 0U;
+    uint32_t phase = widen_hb_decim2_u8_to_f32_bias127(src, full, 2U * kPairs, 1U, 1, &st, &moments, &got);
+    if (phase != ref_phase || got != expect_out || !arrays_close(full, ref, 2 * (int)got, 1e-5f)
+        || !moments_equal(&moments, &expected)) {
+        DSD_FPRINTF(stderr, "fused widen+hb one-shot: mismatch (got=%u)\n", got);
+        return 1;
+    }
+
+    /* Irregular chunks, including ones shorter than the filter latency. */
+    const uint32_t chunks[] = {2U, 6U, 30U, 4U, 2050U, 2U, 1200U, 18U};
+    widen_hb_decim2_state_reset(&st);
+    phase = 1U;
+    uint32_t in_off = 0U;
+    uint32_t out_off = 0U;
+    uint32_t c = 0U;
+    while (in_off < 2U * kPairs) {
+        uint32_t len = chunks[c++ % (sizeof(chunks) / sizeof(chunks[0]))];
+        if (len > 2U * kPairs - in_off) {
+            len = 2U * kPairs - in_off;
+        }
+        const uint32_t predicted = widen_hb_decim2_out_pairs(&st, len / 2U);
+        phase = widen_hb_decim2_u8_to_f32_bias127(src + in_off, split + 2U * out_off, len, phase, 1, &st, NULL, &got);
+        if (got != predicted) {
+            DSD_FPRINTF(stderr, "fused widen+hb chunk count: got=%u predicted=%u\n", got, predicted);
+            return 1;
+        }
+        in_off += len;
+        out_off += got;
+    }
+    if (phase != ref_phase || out_off != expect_out || !arrays_close(split, full, 2 * (int)out_off, 1e-6f)) {
+        DSD_FPRINTF(stderr, "fused widen+hb chunked: mismatch (out=%u)\n", out_off);
+        return 1;
+    }
+
+    /* Exactly widen_hb_decim2_in_pairs() input pairs yield the requested outputs. */
+    widen_hb_decim2_state_reset(&st);
+    const uint32_t need = widen_hb_decim2_in_pairs(&st, 5U);
+    (void)widen_hb_decim2_u8_to_f32_bias127(src, split, 2U * need, 0U, 0, &st, NULL, &got);
+    if (got != 5U || widen_hb_decim2_out_pairs(&st, 1U) != 0U) {
+        DSD_FPRINTF(stderr, "fused widen+hb in_pairs: got=%u\n", got);
+        return 1;
+    }
+    return 0;
+}
+
 int
 main(void) {
     /*
@@ -438,6 +600,26 @@ main(void) {
     }
 #endif
 
+    if (test_plain_widen_backends("SIMD widen dispatch", widen_u8_to_f32_bias127, widen_s16_to_f32) != 0) {
+        return 1;
+    }
+#if defined(__x86_64__) || defined(_M_X64)
+    if (test_plain_widen_backends("SIMD widen SSE2", widen_u8_to_f32_bias127_sse2, widen_s16_to_f32_sse2) != 0) {
+        return 1;
+    }
+#if defined(DSD_NEO_TEST_HAVE_AVX2_IMPL)
+    if (dsd_neo_cpu_has_avx2_with_os_support()
+        && test_plain_widen_backends("SIMD widen AVX2", widen_u8_to_f32_bias127_avx2, widen_s16_to_f32_avx2) != 0) {
+        return 1;
+    }
+#endif
+#endif
+#if defined(__aarch64__) || defined(__arm64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+    if (test_plain_widen_backends("SIMD widen NEON", widen_u8_to_f32_bias127_neon, widen_s16_to_f32_neon) != 0) {
+        return 1;
+    }
+#endif
+
     if (test_plain_moments_backend("SIMD widen+moments scalar", dsd_test_widen_u8_to_f32_bias127_moments_scalar) != 0
         || test_rotated_moments_backend("SIMD rotate+widen+moments scalar",
                                         dsd_test_widen_rotate90_u8_to_f32_bias127_phase_moments_scalar)
@@ -449,7 +631,19 @@ main(void) {
         return 1;
     }
 
+    if (test_fused_widen_hb() != 0) {
+        return 1;
+    }
+
 #if defined(__x86_64__) || defined(_M_X64)
+    if (test_hb31_kernel_backend("SSE2", hb31_decim2_iq_sse2) != 0) {
+        return 1;
+    }
+#if defined(DSD_NEO_TEST_HAVE_AVX2_IMPL)
+    if (dsd_neo_cpu_has_avx2_with_os_support() && test_hb31_kernel_backend("AVX2", hb31_decim2_iq_avx2) != 0) {
+        return 1;
+    }
+#endif
     if (test_plain_moments_backend("SIMD widen+moments SSE2", widen_u8_to_f32_bias127_moments_sse2) != 0
         || test_rotated_moments_backend("SIMD rotate+widen+moments SSE2",
                                         widen_rotate90_u8_to_f32_bias127_phase_moments_sse2)
@@ -468,6 +662,9 @@ main(void) {
 #endif
 
 #if defined(__aarch64__) || defined(__arm64) || defined(_M_ARM64) || defined(_M_ARM64EC)
+    if (test_hb31_kernel_backend("NEON", hb31_decim2_iq_neon) != 0) {
+        return 1;
+    }
     if (test_plain_moments_backend("SIMD widen+moments NEON", widen_u8_to_f32_bias127_moments_neon) != 0
         || test_rotated_moments_backend("SIMD rotate+widen+moments NEON",
                                         widen_rotate90_u8_to_f32_bias127_phase_moments_neon)
@@ -23,6 +23,12 @@ all_zero(const float* x, int n) {
     return 1;
 }
 
+static void
+free_state(demod_state* s) {
+    demod_buffers_release(s);
+    free(s);
+}
+
 int
 main(void) {
     demod_state* s = (demod_state*)malloc(sizeof(demod_state));
@@ -30,6 +36,10 @@ main(void) {
         return 1;
     }
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        free(s);
+        return 1;
+    }
 
     const int pairs = 200;
     static float buf[(size_t)pairs * 2];
@@ -49,20 +59,20 @@ main(void) {
     full_demod(s);
     if (!s->channel_squelched) {
         DSD_FPRINTF(stderr, "squelch: below threshold but channel_squelched not set\n");
-        free(s);
+        free_state(s);
         return 1;
     }
     // With continuous flow model, result_len should be > 0 (pipeline continues with zeros)
     if (s->result_len <= 0) {
         DSD_FPRINTF(stderr, "squelch: below threshold but result_len=%d (expected >0 for continuous flow)\n",
                     s->result_len);
-        free(s);
+        free_state(s);
         return 1;
     }
     // Verify output is all zeros when squelched
     if (!all_zero(s->result, s->result_len)) {
         DSD_FPRINTF(stderr, "squelch: below threshold but result contains non-zero samples\n");
-        free(s);
+        free_state(s);
         return 1;
     }
 
@@ -81,10 +91,10 @@ main(void) {
     if (s->channel_squelched) {
         DSD_FPRINTF(stderr, "squelch: above threshold but channel_squelched is set (pwr=%.6f, thr=%.6f)\n",
                     s->channel_pwr, s->channel_squelch_level);
-        free(s);
+        free_state(s);
         return 1;
     }
 
-    free(s);
+    free_state(s);
     return 0;
 }
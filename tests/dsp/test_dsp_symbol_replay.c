@@ -22,10 +22,12 @@
 #include <dsd-neo/platform/file_compat.h>
 #include <dsd-neo/platform/sockets.h>
 #include <dsd-neo/runtime/exitflag.h>
+#include <dsd-neo/runtime/net_audio_input_hooks.h>
 #include <dsd-neo/runtime/shutdown.h>
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "dsd-neo/core/opts_fwd.h"
 #include "dsd-neo/core/safe_api.h"
@@ -546,6 +548,113 @@ test_symbol_helper_rtl_cache_and_center_contract(void) {
 #endif
 }
 
+
+enum { BLOCK_TEST_SPS = 10, BLOCK_TEST_SYMBOLS = 400 };
+
+static uint32_t g_block_test_index;
+
+/* Four-level symbols with sloped, noisy edges so the jitter tracker sees crossings off center. */
+static int
+block_test_udp_read_sample(dsd_opts* opts, int16_t* out) {
+    static const int levels[4] = {3000, 9000, -3000, -9000};
+    (void)opts;
+    const uint32_t sym = g_block_test_index / BLOCK_TEST_SPS;
+    const int k = (int)(g_block_test_index % BLOCK_TEST_SPS);
+    g_block_test_index++;
+    const uint32_t rng = sym * 2654435761u + 12345u;
+    *out = (int16_t)(levels[(rng >> 20) & 3u] + (k - BLOCK_TEST_SPS / 2) * 40 + (int)((rng >> (k + 4)) & 255u));
+    return 1;
+}
+
+static void
+init_block_test_fixture(dsd_opts* opts, dsd_state* state, float* history) {
+    DSD_MEMSET(opts, 0, sizeof(*opts));
+    DSD_MEMSET(state, 0, sizeof(*state));
+    opts->audio_in_type = AUDIO_IN_UDP;
+    opts->wav_sample_rate = 48000;
+    opts->input_volume_multiplier = 1;
+    opts->use_cosine_filter = 1;
+    state->samplesPerSymbol = BLOCK_TEST_SPS;
+    state->symbolCenter = 4;
+    state->rf_mod = 0;
+    state->jitter = -1;
+    state->lastsynctype = DSD_SYNC_DMR_BS_DATA_POS;
+    state->max = 9000.0f;
+    state->min = -9000.0f;
+    state->maxref = 7200.0f;
+    state->minref = -7200.0f;
+    state->symbol_history = history;
+    state->symbol_history_size = 64;
+    g_block_test_index = 0;
+    exitflag = 0;
+    init_rrc_filter_memory();
+}
+
+typedef struct {
+    float symbols[BLOCK_TEST_SYMBOLS];
+    int jitter[BLOCK_TEST_SYMBOLS];
+    int count;
+} block_test_trace;
+
+static void
+block_test_sink(dsd_opts* opts, dsd_state* state, float symbol, void* user) {
+    (void)opts;
+    block_test_trace* trace = (block_test_trace*)user;
+    trace->symbols[trace->count] = symbol;
+    trace->jitter[trace->count] = state->jitter;
+    trace->count++;
+}
+
+static void
+test_symbol_block_matches_per_symbol_calls(void) {
+    dsd_net_audio_input_hooks hooks;
+    DSD_MEMSET(&hooks, 0, sizeof(hooks));
+    hooks.udp_read_sample = block_test_udp_read_sample;
+    dsd_net_audio_input_hooks_set(hooks);
+
+    for (int have_sync = 0; have_sync <= 1; have_sync++) {
+        static dsd_opts opts;
+        static dsd_state state;
+        static float history[64];
+        static block_test_trace single;
+        static block_test_trace block;
+        static float out[BLOCK_TEST_SYMBOLS];
+
+        DSD_MEMSET(&single, 0, sizeof(single));
+        init_block_test_fixture(&opts, &state, history);
+        for (int k = 0; k < BLOCK_TEST_SYMBOLS; k++) {
+            block_test_sink(&opts, &state, getSymbol(&opts, &state, have_sync), &single);
+        }
+        const int single_center = state.symbolCenter;
+
+        /* Uneven block sizes so a block boundary lands inside every timing pattern. */
+        DSD_MEMSET(&block, 0, sizeof(block));
+        init_block_test_fixture(&opts, &state, history);
+        int done = 0;
+        for (int size = 1; done < BLOCK_TEST_SYMBOLS; size = (size * 7) % 61 + 1) {
+            int n = (BLOCK_TEST_SYMBOLS - done < size) ? BLOCK_TEST_SYMBOLS - done : size;
+            getSymbolBlock(&opts, &state, have_sync, out + done, n, block_test_sink, &block);
+            done += n;
+        }
+
+        int crossings = 0;
+        for (int k = 0; k < BLOCK_TEST_SYMBOLS; k++) {
+            crossings += single.jitter[k] >= 0;
+        }
+        assert(crossings > 0);
+        assert(single.symbols[BLOCK_TEST_SYMBOLS - 1] != 0.0f);
+        assert(block.count == BLOCK_TEST_SYMBOLS);
+        assert(state.symbolcnt == BLOCK_TEST_SYMBOLS);
+        assert(state.symbolCenter == single_center);
+        assert(memcmp(out, single.symbols, sizeof(out)) == 0);
+        assert(memcmp(block.symbols, single.symbols, sizeof(out)) == 0);
+        assert(memcmp(block.jitter, single.jitter, sizeof(block.jitter)) == 0);
+    }
+
+    DSD_MEMSET(&hooks, 0, sizeof(hooks));
+    dsd_net_audio_input_hooks_set(hooks);
+}
+
 int
 main(void) {
     exitflag = 0;
@@ -561,6 +670,7 @@ main(void) {
     test_symbol_helper_analog_i16_conversion_contract();
     test_symbol_matched_filter_uses_active_nxdn_variant();
     test_symbol_helper_rtl_cache_and_center_contract();
+    test_symbol_block_matches_per_symbol_calls();
     return 0;
 }
 
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit test: the packed frame-sync correlator agrees with the character
+ * comparisons it replaced (strcmp/strncmp, the per-dibit Hamming loops, the
+ * CQPSK remap search and the rotated-map window check) on random streams.
+ */
+
+#include <dsd-neo/core/p25_cqpsk_dibit.h>
+#include <dsd-neo/core/sync_patterns.h>
+#include <dsd-neo/dsp/sync_hamming.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+#include "frame_sync_corr.h"
+
+static uint32_t g_rng = 0x1234567u;
+
+static uint32_t
+next_rand(void) {
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return g_rng >> 8;
+}
+
+static int
+expect_int_eq(const char* label, int step, int actual, int expected) {
+    if (actual != expected) {
+        DSD_FPRINTF(stderr, "FAIL: %s at step %d: got %d expected %d\n", label, step, actual, expected);
+        return 0;
+    }
+    return 1;
+}
+
+/* The old rotated-map test: every raw dibit corrects to the expected one. */
+static int
+ref_cqpsk_map_match(const char* window, const char* expected, uint8_t map_idx) {
+    for (size_t i = 0; i < strlen(expected); i++) {
+        if (window[i] < '0' || window[i] > '3') {
+            return 0;
+        }
+        if ((char)('0' + dsd_p25_cqpsk_correct_dibit(map_idx, (uint8_t)(window[i] - '0'))) != expected[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int
+main(void) {
+    static const char* const patterns[] = {P25P1_SYNC, INV_P25P1_SYNC, DMR_BS_DATA_SYNC, FUSION_SYNC, P25P2_SYNC,
+                                           DPMR_FRAME_SYNC_2, M17_PRE, NXDN_FSW, PROVOICE_SYNC, EDACS_SYNC};
+    static const uint8_t maps[] = {DSD_P25_CQPSK_DIBIT_MAP_X2400, DSD_P25_CQPSK_DIBIT_MAP_N1200,
+                                   DSD_P25_CQPSK_DIBIT_MAP_P1200};
+    const int pattern_count = (int)(sizeof(patterns) / sizeof(patterns[0]));
+    frame_sync_corr_pattern packed[sizeof(patterns) / sizeof(patterns[0])];
+    frame_sync_corr_pattern prefix16;
+    frame_sync_corr_pattern p25_norm;
+    frame_sync_corr_pattern p25_inv;
+    frame_sync_corr_pattern rotated[3];
+    int ok = 1;
+
+    for (int p = 0; p < pattern_count; p++) {
+        ok &= expect_int_eq("pack", p,
+                            frame_sync_corr_pattern_init(&packed[p], patterns[p], (int)strlen(patterns[p]), NULL), 0);
+    }
+    ok &= expect_int_eq("pack prefix", 0, frame_sync_corr_pattern_init(&prefix16, PROVOICE_CONV_SHORT, 32, NULL), 0);
+    ok &= expect_int_eq("pack p25", 0, frame_sync_corr_pattern_init(&p25_norm, P25P1_SYNC, 24, NULL), 0);
+    ok &= expect_int_eq("pack p25 inv", 0, frame_sync_corr_pattern_init(&p25_inv, INV_P25P1_SYNC, 24, NULL), 0);
+    for (int m = 0; m < 3; m++) {
+        uint8_t raw_for[4];
+        for (uint8_t d = 0; d < 4u; d++) {
+            raw_for[d] = dsd_p25_cqpsk_raw_dibit_for_corrected(maps[m], d);
+        }
+        ok &= expect_int_eq("pack rotated", m, frame_sync_corr_pattern_init(&rotated[m], P25P1_SYNC, 24, raw_for), 0);
+    }
+    ok &= expect_int_eq("reject bad char", 0, frame_sync_corr_pattern_init(&prefix16, "0124", 4, NULL), -1);
+    ok &= expect_int_eq("reject long text", 0, frame_sync_corr_pattern_init(&prefix16, "0123", 3, NULL), -1);
+    ok &= expect_int_eq("reprefix", 0, frame_sync_corr_pattern_init(&prefix16, PROVOICE_CONV_SHORT, 32, NULL), 0);
+
+    frame_sync_corr corr;
+    frame_sync_corr_reset(&corr);
+    char history[4096 + 64];
+    const int steps = 4096;
+    for (int step = 0; step < steps && ok; step++) {
+        /* Mostly random, with planted syncs and the odd invalid symbol. */
+        const uint32_t r = next_rand();
+        if ((r & 1023u) == 7u && step >= 48) {
+            const char* plant = patterns[(r >> 10) % (uint32_t)pattern_count];
+            size_t n = strlen(plant);
+            for (size_t i = 0; i < n; i++) {
+                history[step] = plant[i];
+                frame_sync_corr_push(&corr, plant[i]);
+                if (i + 1 < n) {
+                    step++;
+                }
+            }
+        } else {
+            char c = ((r & 255u) == 3u) ? 'x' : (char)('0' + ((r >> 12) & 3u));
+            history[step] = c;
+            frame_sync_corr_push(&corr, c);
+        }
+        history[step + 1] = '\0';
+
+        for (int p = 0; p < pattern_count; p++) {
+            const int len = (int)strlen(patterns[p]);
+            if (step + 1 < len) {
+                ok &= expect_int_eq("ready", step, frame_sync_corr_match(&corr, &packed[p]), 0);
+                continue;
+            }
+            const char* window = history + step + 1 - len;
+            ok &= expect_int_eq("hamming", step, frame_sync_corr_hamming(&corr, &packed[p]),
+                                dsd_sync_hamming_distance(window, patterns[p], len));
+            ok &= expect_int_eq("match", step, frame_sync_corr_match(&corr, &packed[p]),
+                                strcmp(window, patterns[p]) == 0);
+        }
+        if (step + 1 >= 32) {
+            const char* window32 = history + step + 1 - 32;
+            ok &= expect_int_eq("prefix match", step, frame_sync_corr_match(&corr, &prefix16),
+                                strncmp(window32, PROVOICE_CONV_SHORT, 16) == 0);
+        }
+        if (step + 1 >= 24) {
+            const char* window24 = history + step + 1 - 24;
+            int has_bad = 0;
+            for (int k = 0; k < 24; k++) {
+                has_bad |= (window24[k] < '0' || window24[k] > '3');
+            }
+            if (!has_bad) {
+                ok &= expect_int_eq("qpsk remaps", step, frame_sync_corr_qpsk_hamming(&corr, &p25_norm, &p25_inv),
+                                    dsd_qpsk_sync_hamming_with_remaps(window24, P25P1_SYNC, INV_P25P1_SYNC, 24));
+            }
+            for (int m = 0; m < 3; m++) {
+                ok &= expect_int_eq("rotated map", step, frame_sync_corr_match(&corr, &rotated[m]),
+                                    ref_cqpsk_map_match(window24, P25P1_SYNC, maps[m]));
+            }
+        }
+    }
+
+    /* A window that corrects to P25 under each rotation must match that map. */
+    for (int m = 0; m < 3 && ok; m++) {
+        frame_sync_corr_reset(&corr);
+        for (int k = 0; k < 24; k++) {
+            uint8_t raw = dsd_p25_cqpsk_raw_dibit_for_corrected(maps[m], (uint8_t)(P25P1_SYNC[k] - '0'));
+            frame_sync_corr_push(&corr, (char)('0' + raw));
+        }
+        ok &= expect_int_eq("planted rotation", m, frame_sync_corr_match(&corr, &rotated[m]), 1);
+    }
+
+    return ok ? 0 : 1;
+}
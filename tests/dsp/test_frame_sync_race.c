@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit test: the acquisition race names the lane whose timing and sync pattern
+ * match the raw sample stream on two successive frames, at an arbitrary
+ * sampling phase and DC offset. A lone match, matches further apart than the
+ * confirmation window and random symbols do not name a winner, and each
+ * state races on its own.
+ */
+
+#include <dsd-neo/core/state.h>
+#include <dsd-neo/core/state_ext.h>
+#include <dsd-neo/core/sync_patterns.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+#include "frame_sync_race.h"
+
+static uint32_t g_rng = 0x2468ace1u;
+
+static uint32_t
+next_rand(void) {
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return g_rng >> 8;
+}
+
+static int
+expect_int_eq(const char* label, int actual, int expected) {
+    if (actual != expected) {
+        DSD_FPRINTF(stderr, "FAIL: %s: got %d expected %d\n", label, actual, expected);
+        return 0;
+    }
+    return 1;
+}
+
+/* One outer symbol held for sps samples, with a little noise on top of a DC offset. */
+static void
+feed_symbol(frame_sync_race* race, char symbol, int sps, float dc) {
+    const float level = (symbol == '1') ? 1.0f : -1.0f;
+    for (int k = 0; k < sps; k++) {
+        const float noise = ((float)(next_rand() & 1023u) / 1023.0f - 0.5f) * 0.4f;
+        frame_sync_race_feed(race, level + dc + noise);
+    }
+}
+
+static void
+feed_random(frame_sync_race* race, int symbols, int sps, float dc) {
+    for (int i = 0; i < symbols; i++) {
+        feed_symbol(race, (next_rand() & 1u) ? '1' : '3', sps, dc);
+    }
+}
+
+static void
+feed_sync(frame_sync_race* race, const char* sync, int sps, float dc) {
+    for (size_t i = 0; i < strlen(sync); i++) {
+        feed_symbol(race, sync[i], sps, dc);
+    }
+}
+
+/* Tap one sync through a state's race at two samples per symbol. */
+static void
+tap_sync(dsd_state* state, const char* sync) {
+    for (size_t i = 0; i < strlen(sync); i++) {
+        for (int k = 0; k < 2; k++) {
+            frame_sync_race_tap(state, sync[i] == '1' ? 1.0f : -1.0f);
+        }
+    }
+}
+
+static void
+add_race_lanes(frame_sync_race* race) {
+    static const char* const p25p1[] = {P25P1_SYNC, INV_P25P1_SYNC};
+    static const char* const p25p2[] = {P25P2_SYNC, INV_P25P2_SYNC};
+    static const char* const dstar[] = {DSTAR_SYNC, INV_DSTAR_SYNC};
+    frame_sync_race_reset(race);
+    (void)frame_sync_race_add_lane(race, 0, 10, p25p1, 2);
+    (void)frame_sync_race_add_lane(race, 3, 8, p25p2, 2);
+    (void)frame_sync_race_add_lane(race, 4, 20, dstar, 2);
+}
+
+int
+main(void) {
+    static frame_sync_race race;
+    int ok = 1;
+
+    /* Lane admission. */
+    static const char* const short_only[] = {NXDN_FSW, M17_PRE_LSF};
+    static const char* const inner[] = {DMR_BS_DATA_SYNC, "01230123012301230123"};
+    static const char* const p25[] = {P25P1_SYNC};
+    frame_sync_race_reset(&race);
+    ok &= expect_int_eq("short patterns", frame_sync_race_add_lane(&race, 1, 10, short_only, 2), -1);
+    ok &= expect_int_eq("sps too low", frame_sync_race_add_lane(&race, 1, 1, p25, 1), -1);
+    ok &= expect_int_eq("sps too high", frame_sync_race_add_lane(&race, 1, FRAME_SYNC_RACE_MAX_SPS + 1, p25, 1), -1);
+    ok &= expect_int_eq("inner symbols skipped", frame_sync_race_add_lane(&race, 1, 10, inner, 2), 0);
+    ok &= expect_int_eq("inner lane pattern count", race.lanes[0].pattern_count, 1);
+    ok &= expect_int_eq("lane count", race.lane_count, 1);
+
+    /* Each lane wins on its own timing once the next frame's sync confirms it, at every phase offset. */
+    static const struct {
+        const char* sync;
+        int sps;
+        int profile;
+    } cases[] = {{P25P2_SYNC, 8, 3}, {INV_P25P1_SYNC, 10, 0}, {DSTAR_SYNC, 20, 4}};
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]) && ok; c++) {
+        for (int offset = 0; offset < cases[c].sps && ok; offset += 3) {
+            add_race_lanes(&race);
+            for (int k = 0; k < offset; k++) {
+                frame_sync_race_feed(&race, 0.3f);
+            }
+            feed_random(&race, 400, cases[c].sps, 0.3f);
+            ok &= expect_int_eq("no early winner", race.winner, -1);
+            feed_sync(&race, cases[c].sync, cases[c].sps, 0.3f);
+            ok &= expect_int_eq("lone sync", race.winner, -1);
+            feed_random(&race, 300, cases[c].sps, 0.3f);
+            feed_sync(&race, cases[c].sync, cases[c].sps, 0.3f);
+            ok &= expect_int_eq("winner", race.winner, cases[c].profile);
+        }
+    }
+
+    /* A second sync after the confirmation window has closed only opens a new one. */
+    add_race_lanes(&race);
+    feed_random(&race, 100, 8, 0.0f);
+    feed_sync(&race, P25P2_SYNC, 8, 0.0f);
+    feed_random(&race, FRAME_SYNC_RACE_CONFIRM_SYMBOLS, 8, 0.0f);
+    feed_sync(&race, P25P2_SYNC, 8, 0.0f);
+    ok &= expect_int_eq("expired window", race.winner, -1);
+    feed_random(&race, 500, 8, 0.0f);
+    feed_sync(&race, P25P2_SYNC, 8, 0.0f);
+    ok &= expect_int_eq("reopened window", race.winner, 3);
+
+    /* Random symbols at a rate no lane races on do not trigger a switch. */
+    add_race_lanes(&race);
+    feed_random(&race, 20000, 5, -0.2f);
+    ok &= expect_int_eq("noise winner", race.winner, -1);
+
+    /* A state's race only listens while armed, and two states do not share one. */
+    static dsd_state state_a;
+    static dsd_state state_b;
+    static const char* const p25p2[] = {P25P2_SYNC};
+    ok &= expect_int_eq("peek before use", frame_sync_race_peek(&state_a) == NULL, 1);
+    frame_sync_race_tap(&state_a, 1.0f);
+    frame_sync_race* race_a = frame_sync_race_for_state(&state_a);
+    frame_sync_race* race_b = frame_sync_race_for_state(&state_b);
+    if (!race_a || !race_b || race_a == race_b || frame_sync_race_peek(&state_a) != race_a) {
+        DSD_FPRINTF(stderr, "FAIL: per-state races\n");
+        return 1;
+    }
+    ok &= expect_int_eq("state lane", frame_sync_race_add_lane(race_a, 3, 2, p25p2, 1), 0);
+    ok &= expect_int_eq("other state lane", frame_sync_race_add_lane(race_b, 3, 2, p25p2, 1), 0);
+    tap_sync(&state_a, P25P2_SYNC);
+    tap_sync(&state_a, P25P2_SYNC);
+    ok &= expect_int_eq("disarmed tap", race_a->winner, -1);
+    frame_sync_race_set_armed(&state_a, 1);
+    frame_sync_race_set_armed(&state_b, 1);
+    tap_sync(&state_a, P25P2_SYNC);
+    tap_sync(&state_a, P25P2_SYNC);
+    ok &= expect_int_eq("armed tap", race_a->winner, 3);
+    ok &= expect_int_eq("untouched state", race_b->winner, -1);
+    frame_sync_race_set_armed(&state_a, 0);
+    dsd_state_ext_free_all(&state_a);
+    dsd_state_ext_free_all(&state_b);
+    ok &= expect_int_eq("freed with state", frame_sync_race_peek(&state_a) == NULL, 1);
+
+    return ok ? 0 : 1;
+}
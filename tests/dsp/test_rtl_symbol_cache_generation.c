@@ -504,6 +504,35 @@ main(void) {
     assert(getSymbol(&opts, &state, 1) == 4100.0f);
     assert(g_cleanup_calls == 0);
 
+    /*
+     * Audio-monitor output shares the span cache: a symbol's worth of samples
+     * costs one read per span, and a block reader picks up where getSymbol()
+     * stopped instead of skipping the samples still held in the cache.
+     */
+    reset_stream_fixture();
+    reset_decoder_fixture(&opts, &state, &fake_rtl_context);
+    g_output_kind = RTL_STREAM_OUTPUT_AUDIO_MONITOR;
+    g_read_base = 6000.0f;
+    g_read_base_step = 4.0f;
+    opts.rtl_volume_multiplier = 1;
+    state.rf_mod = 0;
+    state.samplesPerSymbol = 10;
+    state.symbolCenter = 4;
+    (void)getSymbol(&opts, &state, 1);
+    assert(g_read_calls == 3);
+    assert(dsd_rtl_stream_metrics_hook_symbol_cache_pending() == 2);
+    float tail[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    int tail_got = 0;
+    assert(dsd_rtl_stream_io_hook_read_block(&state, tail, 4U, &tail_got) == 0);
+    assert(tail_got == 2);
+    assert(tail[0] == 6010.0f && tail[1] == 6011.0f);
+    assert(dsd_rtl_stream_metrics_hook_symbol_cache_pending() == 0);
+    assert(g_read_calls == 3);
+    g_stream_generation++;
+    (void)getSymbol(&opts, &state, 1);
+    assert(g_read_calls == 6);
+    assert(g_cleanup_calls == 0);
+
     /*
      * Read failures should surface as the existing empty-symbol path, trigger
      * the cleanup hook once, and leave global hooks reset for later tests.
@@ -19,9 +19,13 @@ namespace {
 
 constexpr float kPi = 3.14159265358979323846f;
 
-static void
+static int
 reset_demod(demod_state* s) {
+    demod_buffers_release(s);
     DSD_MEMSET(s, 0, sizeof(*s));
+    if (demod_buffers_reserve(s, DEMOD_DEFAULT_WORK_LENGTH) != 0) {
+        return -1;
+    }
     s->rate_in = 48000;
     s->rate_out = 48000;
     s->rate_out2 = 12000;
@@ -33,6 +37,7 @@ reset_demod(demod_state* s) {
     s->mode_demod = &dsd_fm_demod;
     s->lowpassed = s->input_cb_buf;
     s->channel_lpf_enable = 0;
+    return 0;
 }
 
 static void
@@ -60,7 +65,9 @@ check_fsk_discriminator_output_contract(demod_state* s) {
     static const float levels[] = {-3.0f, -1.0f, 1.0f, 3.0f};
     float expected[SYMBOLS];
 
-    reset_demod(s);
+    if (reset_demod(s) != 0) {
+        return 1;
+    }
     s->output_kind = DSD_DEMOD_OUTPUT_FSK_DISCRIMINATOR;
     s->symbol_rate_hz = 4800;
     s->symbol_levels = 4;
@@ -145,7 +152,9 @@ check_cqpsk_symbol_output_contract(demod_state* s) {
     static const float expected_cycle[] = {-3.0f, -1.0f, 1.0f, 3.0f};
     float expected[SYMBOLS];
 
-    reset_demod(s);
+    if (reset_demod(s) != 0) {
+        return 1;
+    }
     s->output_kind = DSD_DEMOD_OUTPUT_SYMBOL_CQPSK;
     s->cqpsk_enable = 1;
     s->symbol_rate_hz = 4800;
@@ -179,7 +188,9 @@ static int
 check_cqpsk_phase_extractor_accuracy(demod_state* s) {
     enum : unsigned short { SAMPLES = 721 };
 
-    reset_demod(s);
+    if (reset_demod(s) != 0) {
+        return 1;
+    }
     s->lowpassed = s->input_cb_buf;
     s->lp_len = SAMPLES * 2;
 
@@ -213,7 +224,9 @@ static int
 check_cqpsk_squelch_emits_zero_symbols(demod_state* s) {
     enum : unsigned short { PAIRS = 20, SPS = 7 };
 
-    reset_demod(s);
+    if (reset_demod(s) != 0) {
+        return 1;
+    }
     s->output_kind = DSD_DEMOD_OUTPUT_SYMBOL_CQPSK;
     s->cqpsk_enable = 1;
     s->ted_sps = SPS;
@@ -252,6 +265,7 @@ main(void) {
     if (!s) {
         return 1;
     }
+    DSD_MEMSET(s, 0, sizeof(*s));
 
     int rc = 0;
     rc |= check_fsk_discriminator_output_contract(s);
@@ -259,6 +273,7 @@ main(void) {
     rc |= check_cqpsk_phase_extractor_accuracy(s);
     rc |= check_cqpsk_squelch_emits_zero_symbols(s);
 
+    demod_buffers_release(s);
     std::free(s);
     return rc;
 }
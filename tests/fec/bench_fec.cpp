@@ -0,0 +1,991 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Opt-in microbenchmark and BER sweep for the FEC decoders.
+ *
+ * Every case decodes a fixed pool of random codewords sent through a binary
+ * symmetric channel at one bit error rate, so ns/codeword and the
+ * corrected/failed/miscorrected rates come from the same inputs. Erasure and
+ * soft variants additionally mark the symbols (or dibits) that took a flip.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dsd-neo/fec/BCH_63_16.hpp>
+#include <dsd-neo/fec/Golay24.hpp>
+#include <dsd-neo/fec/ReedSolomon.hpp>
+#include <dsd-neo/fec/block_codes.h>
+#include <dsd-neo/fec/bptc.h>
+#include <dsd-neo/fec/ez.h>
+#include <dsd-neo/fec/rs_12_9.h>
+#include <dsd-neo/fec/trellis34.h>
+#include <dsd-neo/fec/viterbi_k5.h>
+#include <dsd-neo/platform/posix_compat.h>
+#include <dsd-neo/protocol/dmr/r34_viterbi.h>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+#include "dsd-neo/core/safe_api.h"
+#include "ezpwd/rs"
+
+namespace {
+
+volatile double g_bench_sink = 0.0;
+
+enum class OutputFormat : uint8_t { Text, Csv };
+
+struct BenchOptions {
+    int iterations = 20;
+    int warmup = 2;
+    int repeat = 1;
+    const char* case_filter = NULL;
+    OutputFormat format = OutputFormat::Text;
+    int list_cases = 0;
+};
+
+struct BenchStats {
+    double min_ns_per_call = 0.0;
+    double mean_ns_per_call = 0.0;
+    double median_ns_per_call = 0.0;
+    double median_ns_per_item = 0.0;
+    double items_per_second = 0.0;
+    double checksum = 0.0;
+};
+
+/* Codewords per call; also the sample the rates are measured on. */
+constexpr int kPoolSize = 256;
+
+/* BER sweep in percent; cases are named <codec>_berNN. */
+constexpr int k_ber_percent[] = {0, 1, 2, 5, 10};
+
+class Rng {
+  public:
+    explicit Rng(uint32_t seed) : state_(seed) {}
+
+    uint32_t
+    next() {
+        state_ = (state_ * 1664525U) + 1013904223U;
+        return state_ >> 8;
+    }
+
+    /* True with probability p, to 24-bit resolution. */
+    bool
+    chance(double p) {
+        return (double)next() < p * 16777216.0;
+    }
+
+  private:
+    uint32_t state_;
+};
+
+/* One received codeword and what was sent. */
+struct Slot {
+    std::vector<uint8_t> rx;     // received bits, or dibits for the trellis codec
+    std::vector<uint8_t> reliab; // per-dibit reliability for the soft trellis decoder
+    std::vector<int> erasures;   // flipped symbols, ascending, for the erasure variants
+    std::vector<uint8_t> want;   // transmitted data in the codec's output layout
+    uint64_t word = 0;           // rx packed first-bit-most-significant, for word decoders
+};
+
+class Codec {
+  public:
+    virtual ~Codec() = default;
+
+    /* Random data and its codeword as 0/1 channel bits. */
+    virtual void encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const = 0;
+
+    /* Derive decoder-specific inputs from rx and the per-bit flip mask. */
+    virtual void
+    finish(Slot& slot, const std::vector<uint8_t>& flipped) const {
+        (void)slot;
+        (void)flipped;
+    }
+
+    /* Decode one slot into out; nonzero when the decoder reports failure. */
+    virtual int decode(const Slot& slot, std::vector<uint8_t>& out) const = 0;
+};
+
+void
+random_bits(Rng& rng, uint8_t* bits, int count) {
+    for (int i = 0; i < count; i++) {
+        bits[i] = (uint8_t)(rng.next() & 1U);
+    }
+}
+
+void
+word_to_bits(uint64_t word, int count, std::vector<uint8_t>& bits) {
+    bits.resize((size_t)count);
+    for (int i = 0; i < count; i++) {
+        bits[(size_t)i] = (uint8_t)((word >> (count - 1 - i)) & 1U);
+    }
+}
+
+uint64_t
+bits_to_word(const uint8_t* bits, int count) {
+    uint64_t word = 0;
+    for (int i = 0; i < count; i++) {
+        word = (word << 1) | (uint64_t)(bits[i] & 1U);
+    }
+    return word;
+}
+
+/* Marks each group of symbol_bits bits that took a flip, up to max_erasures. */
+void
+flipped_symbols(const std::vector<uint8_t>& flipped, int first_bit, int symbols, int symbol_bits, int position_base,
+                int max_erasures, std::vector<int>& erasures) {
+    for (int s = 0; s < symbols && (int)erasures.size() < max_erasures; s++) {
+        for (int b = 0; b < symbol_bits; b++) {
+            if (flipped[(size_t)(first_bit + (s * symbol_bits) + b)]) {
+                erasures.push_back(position_base + s);
+                break;
+            }
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Packed-word decoders                                                                           */
+/* ---------------------------------------------------------------------------------------------- */
+
+class PackedWordCodec : public Codec {
+  public:
+    explicit PackedWordCodec(int bits) : bits_(bits) {}
+
+    void
+    finish(Slot& slot, const std::vector<uint8_t>& flipped) const override {
+        (void)flipped;
+        slot.word = bits_to_word(slot.rx.data(), bits_);
+    }
+
+  protected:
+    static void
+    store_u16(unsigned int value, std::vector<uint8_t>& out) {
+        out.resize(2);
+        out[0] = (uint8_t)(value >> 8);
+        out[1] = (uint8_t)value;
+    }
+
+    int bits_;
+};
+
+class Golay24Codec : public PackedWordCodec {
+  public:
+    Golay24Codec() : PackedWordCodec(24) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        const unsigned int value = rng.next() & 0xFFFU;
+        word_to_bits(Golay24::encode(value), 24, tx);
+        store_u16(value, data);
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        unsigned int cw = (unsigned int)slot.word;
+        int errs = 0;
+        const int rc = Golay24::decode(&errs, &cw);
+        store_u16(cw & 0xFFFU, out);
+        return rc;
+    }
+};
+
+class Hamming1063Codec : public PackedWordCodec {
+  public:
+    Hamming1063Codec() : PackedWordCodec(10) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        const unsigned int value = rng.next() & 0x3FU;
+        word_to_bits(hamming_10_6_3_encode_word(value), 10, tx);
+        store_u16(value, data);
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        unsigned int value = 0;
+        const int rc = hamming_10_6_3_decode_word((unsigned int)slot.word, &value);
+        store_u16(value, out);
+        return rc == 2 ? 1 : 0;
+    }
+};
+
+class Bch6316Codec : public PackedWordCodec {
+  public:
+    Bch6316Codec() : PackedWordCodec(63) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        const uint16_t value = (uint16_t)rng.next();
+        word_to_bits(BCH_63_16_11::encode_word(value), 63, tx);
+        store_u16(value, data);
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        uint16_t value = 0;
+        const BCH_63_16_Result result = bch_.decode_word(slot.word, &value);
+        store_u16(value, out);
+        return result.success ? 0 : 1;
+    }
+
+  private:
+    BCH_63_16_11 bch_;
+};
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Bit-array block codes from fec.c and BPTC(196,96)                                              */
+/* ---------------------------------------------------------------------------------------------- */
+
+typedef bool (*BitDecodeFn)(uint8_t* bits, uint8_t* data);
+
+bool
+decode_hamming_7_4(uint8_t* bits, uint8_t* data) {
+    const bool ok = Hamming_7_4_decode(bits);
+    DSD_MEMCPY(data, bits, 4);
+    return ok;
+}
+
+bool
+decode_hamming_13_9(uint8_t* bits, uint8_t* data) {
+    return Hamming_13_9_decode(bits, data, 1);
+}
+
+bool
+decode_hamming_15_11(uint8_t* bits, uint8_t* data) {
+    return Hamming_15_11_decode(bits, data, 1);
+}
+
+bool
+decode_hamming_16_11_4(uint8_t* bits, uint8_t* data) {
+    return Hamming_16_11_4_decode(bits, data, 1);
+}
+
+bool
+decode_golay_20_8(uint8_t* bits, uint8_t* data) {
+    const bool ok = Golay_20_8_decode(bits);
+    DSD_MEMCPY(data, bits, 8);
+    return ok;
+}
+
+bool
+decode_golay_24_12(uint8_t* bits, uint8_t* data) {
+    const bool ok = Golay_24_12_decode(bits);
+    DSD_MEMCPY(data, bits, 12);
+    return ok;
+}
+
+bool
+decode_qr_16_7_6(uint8_t* bits, uint8_t* data) {
+    const bool ok = QR_16_7_6_decode(bits);
+    DSD_MEMCPY(data, bits, 7);
+    return ok;
+}
+
+/*
+ * Systematic encoder for a data-first bit-array code, learned from its decoder:
+ * the parity of each unit data vector is the one completion the decoder accepts
+ * without touching a bit. Codewords are then XORs of those columns.
+ */
+class SystematicEncoder {
+  public:
+    SystematicEncoder(BitDecodeFn decode, int n, int k) : n_(n), k_(k), columns_((size_t)k) {
+        std::vector<uint8_t> word((size_t)n);
+        std::vector<uint8_t> trial((size_t)n);
+        std::vector<uint8_t> data((size_t)k);
+        for (int i = 0; i < k; i++) {
+            for (uint32_t p = 0; p < (1U << (n - k)); p++) {
+                std::fill(word.begin(), word.end(), 0);
+                word[(size_t)i] = 1;
+                for (int b = 0; b < n - k; b++) {
+                    word[(size_t)(k + b)] = (uint8_t)((p >> (n - k - 1 - b)) & 1U);
+                }
+                trial = word;
+                if (decode(trial.data(), data.data()) && trial == word) {
+                    columns_[(size_t)i] = p;
+                    break;
+                }
+            }
+        }
+    }
+
+    void
+    encode(const uint8_t* data, uint8_t* codeword) const {
+        uint32_t parity = 0;
+        for (int i = 0; i < k_; i++) {
+            codeword[i] = data[i];
+            if (data[i]) {
+                parity ^= columns_[(size_t)i];
+            }
+        }
+        for (int b = 0; b < n_ - k_; b++) {
+            codeword[k_ + b] = (uint8_t)((parity >> (n_ - k_ - 1 - b)) & 1U);
+        }
+    }
+
+  private:
+    int n_;
+    int k_;
+    std::vector<uint32_t> columns_;
+};
+
+class BitBlockCodec : public Codec {
+  public:
+    BitBlockCodec(BitDecodeFn decode, int n, int k) : decode_(decode), n_(n), k_(k), encoder_(decode, n, k) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        data.resize((size_t)k_);
+        tx.resize((size_t)n_);
+        random_bits(rng, data.data(), k_);
+        encoder_.encode(data.data(), tx.data());
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        uint8_t bits[32];
+        DSD_MEMCPY(bits, slot.rx.data(), (size_t)n_);
+        out.resize((size_t)k_);
+        return decode_(bits, out.data()) ? 0 : 1;
+    }
+
+  private:
+    BitDecodeFn decode_;
+    int n_;
+    int k_;
+    SystematicEncoder encoder_;
+};
+
+class Bptc19696Codec : public Codec {
+  public:
+    Bptc19696Codec() : rows_(decode_hamming_15_11, 15, 11), cols_(decode_hamming_13_9, 13, 9) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        uint8_t matrix[13][15];
+        DSD_MEMSET(matrix, 0, sizeof(matrix));
+        data.resize(96);
+        random_bits(rng, data.data(), 96);
+        /* Row 0 starts with the three reserved R bits, left zero. */
+        int k = 0;
+        for (int j = 3; j < 11; j++) {
+            matrix[0][j] = data[(size_t)k++];
+        }
+        for (int i = 1; i < 9; i++) {
+            for (int j = 0; j < 11; j++) {
+                matrix[i][j] = data[(size_t)k++];
+            }
+        }
+        for (int i = 0; i < 9; i++) {
+            rows_.encode(matrix[i], matrix[i]);
+        }
+        for (int j = 0; j < 15; j++) {
+            uint8_t column[13];
+            for (int i = 0; i < 9; i++) {
+                column[i] = matrix[i][j];
+            }
+            cols_.encode(column, column);
+            for (int i = 9; i < 13; i++) {
+                matrix[i][j] = column[i];
+            }
+        }
+        tx.assign(196, 0);
+        for (int i = 0; i < 13; i++) {
+            for (int j = 0; j < 15; j++) {
+                tx[(size_t)(1 + (i * 15) + j)] = matrix[i][j];
+            }
+        }
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        uint8_t bits[196];
+        uint8_t r_bits[3];
+        DSD_MEMCPY(bits, slot.rx.data(), sizeof(bits));
+        out.resize(96);
+        return BPTC_196x96_Extract_Data(bits, out.data(), r_bits) != 0U ? 1 : 0;
+    }
+
+  private:
+    SystematicEncoder rows_;
+    SystematicEncoder cols_;
+};
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Reed-Solomon codes                                                                             */
+/* ---------------------------------------------------------------------------------------------- */
+
+/* RS(12,9) over GF(256), encoded by solving the syndrome equations for the three parity bytes. */
+class Rs129Codec : public Codec {
+  public:
+    Rs129Codec() {
+        /* Column b of the GF(2) map from parity bits to syndrome bits. */
+        uint32_t columns[24];
+        for (int b = 0; b < 24; b++) {
+            rs_12_9_codeword_t cw;
+            DSD_MEMSET(&cw, 0, sizeof(cw));
+            cw.data[9 + (b / 8)] = (uint8_t)(0x80U >> (b % 8));
+            columns[b] = syndrome_bits(cw);
+        }
+        /* Invert it by Gauss-Jordan elimination on [M | I]. */
+        uint32_t rows[24];
+        uint32_t inverse[24];
+        for (int r = 0; r < 24; r++) {
+            rows[r] = 0;
+            inverse[r] = 1U << r;
+            for (int b = 0; b < 24; b++) {
+                rows[r] |= ((columns[b] >> r) & 1U) << b;
+            }
+        }
+        for (int c = 0; c < 24; c++) {
+            int pivot = c;
+            while (pivot < 24 && ((rows[pivot] >> c) & 1U) == 0U) {
+                pivot++;
+            }
+            if (pivot == 24) {
+                continue;
+            }
+            std::swap(rows[c], rows[pivot]);
+            std::swap(inverse[c], inverse[pivot]);
+            for (int r = 0; r < 24; r++) {
+                if (r != c && ((rows[r] >> c) & 1U) != 0U) {
+                    rows[r] ^= rows[c];
+                    inverse[r] ^= inverse[c];
+                }
+            }
+        }
+        DSD_MEMCPY(solve_, inverse, sizeof(solve_));
+    }
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        rs_12_9_codeword_t cw;
+        DSD_MEMSET(&cw, 0, sizeof(cw));
+        for (int i = 0; i < 9; i++) {
+            cw.data[i] = (uint8_t)rng.next();
+        }
+        const uint32_t syndrome = syndrome_bits(cw);
+        for (int b = 0; b < 24; b++) {
+            if ((dsd_popcount64(solve_[b] & syndrome) & 1) != 0) {
+                cw.data[9 + (b / 8)] |= (uint8_t)(0x80U >> (b % 8));
+            }
+        }
+        data.assign(cw.data, cw.data + 9);
+        tx.resize(96);
+        for (int i = 0; i < 96; i++) {
+            tx[(size_t)i] = (uint8_t)((cw.data[i / 8] >> (7 - (i % 8))) & 1U);
+        }
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        rs_12_9_codeword_t cw;
+        for (int i = 0; i < 12; i++) {
+            cw.data[i] = (uint8_t)bits_to_word(&slot.rx[(size_t)(i * 8)], 8);
+        }
+        rs_12_9_poly_t syndrome;
+        rs_12_9_calc_syndrome(&cw, &syndrome);
+        int rc = 0;
+        if (rs_12_9_check_syndrome(&syndrome) != 0) {
+            uint8_t errors = 0;
+            rc = rs_12_9_correct_errors(&cw, &syndrome, &errors)
+                 == RS_12_9_CORRECT_ERRORS_RESULT_ERRORS_CANT_BE_CORRECTED;
+        }
+        out.assign(cw.data, cw.data + 9);
+        return rc;
+    }
+
+  private:
+    static uint32_t
+    syndrome_bits(const rs_12_9_codeword_t& cw) {
+        rs_12_9_poly_t syndrome;
+        rs_12_9_calc_syndrome(&cw, &syndrome);
+        return (uint32_t)syndrome.data[0] | ((uint32_t)syndrome.data[1] << 8) | ((uint32_t)syndrome.data[2] << 16);
+    }
+
+    uint32_t solve_[24];
+};
+
+/*
+ * P25 RS(24,12,13), RS(24,16,9) and RS(36,20,17) through the DSD adapters. Channel
+ * bits are the data symbols then the parity symbols, six bits each.
+ */
+template <class RS>
+class P25RsCodec : public Codec {
+  public:
+    P25RsCodec(int data_symbols, int parity_symbols, bool erasures)
+        : data_symbols_(data_symbols), parity_symbols_(parity_symbols), erasures_(erasures) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        int input[63];
+        int output[63];
+        int parity_positions[16];
+        DSD_MEMSET(input, 0, sizeof(input));
+        for (int i = 0; i < data_symbols_; i++) {
+            input[parity_symbols_ + i] = (int)(rng.next() & 0x3FU);
+        }
+        for (int i = 0; i < parity_symbols_; i++) {
+            parity_positions[i] = i;
+        }
+        (void)rs_.decode_with_erasures(input, output, parity_positions, parity_symbols_);
+        const int total = data_symbols_ + parity_symbols_;
+        tx.resize((size_t)total * 6U);
+        for (int s = 0; s < total; s++) {
+            const int value = (s < data_symbols_) ? output[parity_symbols_ + s] : output[s - data_symbols_];
+            for (int b = 0; b < 6; b++) {
+                tx[(size_t)((s * 6) + b)] = (uint8_t)((value >> (5 - b)) & 1);
+            }
+        }
+        data.assign(tx.begin(), tx.begin() + (data_symbols_ * 6));
+    }
+
+    void
+    finish(Slot& slot, const std::vector<uint8_t>& flipped) const override {
+        if (!erasures_) {
+            return;
+        }
+        /* Parity symbols occupy RS positions 0.., data follows. */
+        flipped_symbols(flipped, data_symbols_ * 6, parity_symbols_, 6, 0, parity_symbols_, slot.erasures);
+        flipped_symbols(flipped, 0, data_symbols_, 6, parity_symbols_, parity_symbols_, slot.erasures);
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        char data[20 * 6];
+        char parity[16 * 6];
+        for (int i = 0; i < data_symbols_ * 6; i++) {
+            data[i] = (char)slot.rx[(size_t)i];
+        }
+        for (int i = 0; i < parity_symbols_ * 6; i++) {
+            parity[i] = (char)slot.rx[(size_t)((data_symbols_ * 6) + i)];
+        }
+        int rc;
+        if (erasures_ && !slot.erasures.empty()) {
+            rc = rs_.decode_soft_ranked(data, parity, slot.erasures.data(), (int)slot.erasures.size());
+        } else {
+            rc = rs_.decode(data, parity);
+        }
+        out.assign(data, data + (data_symbols_ * 6));
+        return rc;
+    }
+
+  private:
+    RS rs_;
+    int data_symbols_;
+    int parity_symbols_;
+    bool erasures_;
+};
+
+/* P25 Phase 2 ESS: RS(44,16,29) shortened from ezpwd RS<63,35>, through ez_rs28_ess(). */
+class EzEssCodec : public Codec {
+  public:
+    explicit EzEssCodec(bool erasures) : erasures_(erasures) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        std::vector<uint8_t> payload(16);
+        std::vector<uint8_t> parity;
+        for (int i = 0; i < 16; i++) {
+            payload[(size_t)i] = (uint8_t)(rng.next() & 0x3FU);
+        }
+        (void)rs_.encode(payload, parity);
+        tx.resize(44U * 6U);
+        for (int s = 0; s < 44; s++) {
+            const uint8_t value = (s < 16) ? payload[(size_t)s] : parity[(size_t)(s - 16)];
+            for (int b = 0; b < 6; b++) {
+                tx[(size_t)((s * 6) + b)] = (uint8_t)((value >> (5 - b)) & 1U);
+            }
+        }
+        data.assign(tx.begin(), tx.begin() + 96);
+    }
+
+    void
+    finish(Slot& slot, const std::vector<uint8_t>& flipped) const override {
+        if (erasures_) {
+            flipped_symbols(flipped, 0, 44, 6, 0, 28, slot.erasures);
+        }
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        int payload[96];
+        int parity[168];
+        for (int i = 0; i < 96; i++) {
+            payload[i] = slot.rx[(size_t)i];
+        }
+        for (int i = 0; i < 168; i++) {
+            parity[i] = slot.rx[(size_t)(96 + i)];
+        }
+        const int* erasures = slot.erasures.empty() ? NULL : slot.erasures.data();
+        const int ec = ez_rs28_ess(payload, parity, erasures, (int)slot.erasures.size());
+        out.resize(96);
+        for (int i = 0; i < 96; i++) {
+            out[(size_t)i] = (uint8_t)payload[i];
+        }
+        return ec < 0 ? 1 : 0;
+    }
+
+  private:
+    ezpwd::RS<63, 35> rs_;
+    bool erasures_;
+};
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Convolutional and trellis codes                                                                */
+/* ---------------------------------------------------------------------------------------------- */
+
+/* K=5 rate 1/2 (M17 polynomials 0x19/0x17) with hard 0/0xFFFF soft values. */
+class ViterbiK5Codec : public Codec {
+  public:
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        data.resize((size_t)kMessageBits);
+        random_bits(rng, data.data(), kMessageBits);
+        tx.resize((size_t)(kMessageBits + 4) * 2U);
+        unsigned int reg = 0U;
+        for (int i = 0; i < kMessageBits + 4; i++) {
+            reg = ((reg << 1) | (i < kMessageBits ? data[(size_t)i] : 0U)) & 0x1FU;
+            tx[(size_t)(2 * i)] = (uint8_t)(dsd_popcount64(reg & 0x19U) & 1);
+            tx[(size_t)((2 * i) + 1)] = (uint8_t)(dsd_popcount64(reg & 0x17U) & 1);
+        }
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        dsd_viterbi_k5 v;
+        dsd_viterbi_k5_reset(&v, 0x1FFFE);
+        for (size_t i = 0; i + 1 < slot.rx.size(); i += 2) {
+            /* Hard decisions make each branch metric 0, 0xFFFF or 0x1FFFE. */
+            const unsigned int sym = ((unsigned int)slot.rx[i] << 1) | slot.rx[i + 1];
+            uint32_t bm[4];
+            for (unsigned int p = 0; p < 4U; p++) {
+                bm[p] = 0xFFFFU * (uint32_t)dsd_popcount64(p ^ sym);
+            }
+            (void)dsd_viterbi_k5_step(&v, bm);
+        }
+        out.resize((size_t)kMessageBits);
+        return dsd_viterbi_k5_traceback(&v, out.data(), (size_t)kMessageBits) == (size_t)kMessageBits ? 0 : 1;
+    }
+
+  private:
+    enum { kMessageBits = 200 };
+};
+
+/* DMR rate 3/4 trellis; the soft variant marks dibits that took a flip as unreliable. */
+class DmrR34Codec : public Codec {
+  public:
+    explicit DmrR34Codec(bool soft) : soft_(soft) {}
+
+    void
+    encode(Rng& rng, std::vector<uint8_t>& tx, std::vector<uint8_t>& data) const override {
+        data.resize(18);
+        for (int i = 0; i < 18; i++) {
+            data[(size_t)i] = (uint8_t)rng.next();
+        }
+        uint8_t states[49];
+        for (int g = 0; g < 6; g++) {
+            const uint32_t temp = ((uint32_t)data[(size_t)(g * 3)] << 16) | ((uint32_t)data[(size_t)(g * 3) + 1] << 8)
+                                  | data[(size_t)(g * 3) + 2];
+            for (int k = 0; k < 8; k++) {
+                states[(g * 8) + k] = (uint8_t)((temp >> (21 - (3 * k))) & 7U);
+            }
+        }
+        states[48] = 0;
+        uint8_t dei[98];
+        unsigned int prev = 0;
+        for (int t = 0; t < 49; t++) {
+            const uint8_t nib = dsd_trellis34_inverse_constellation[dsd_trellis34_fsm[(prev * 8U) + states[t]]];
+            dei[2 * t] = (uint8_t)(nib >> 2);
+            dei[(2 * t) + 1] = (uint8_t)(nib & 3U);
+            prev = states[t];
+        }
+        /* Two channel bits per interleaved dibit. */
+        tx.resize(196);
+        for (int i = 0; i < 98; i++) {
+            const uint8_t dibit = dei[dsd_trellis_interleave_98[i]];
+            tx[(size_t)(2 * i)] = (uint8_t)(dibit >> 1);
+            tx[(size_t)((2 * i) + 1)] = (uint8_t)(dibit & 1U);
+        }
+    }
+
+    void
+    finish(Slot& slot, const std::vector<uint8_t>& flipped) const override {
+        std::vector<uint8_t> dibits(98);
+        slot.reliab.resize(98);
+        for (int i = 0; i < 98; i++) {
+            dibits[(size_t)i] = (uint8_t)((slot.rx[(size_t)(2 * i)] << 1) | slot.rx[(size_t)((2 * i) + 1)]);
+            const bool hit = flipped[(size_t)(2 * i)] || flipped[(size_t)((2 * i) + 1)];
+            slot.reliab[(size_t)i] = hit ? 24U : 224U;
+        }
+        slot.rx.swap(dibits);
+    }
+
+    int
+    decode(const Slot& slot, std::vector<uint8_t>& out) const override {
+        out.resize(18);
+        if (soft_) {
+            return dmr_r34_viterbi_decode_soft(slot.rx.data(), slot.reliab.data(), out.data()) != 0;
+        }
+        return dmr_r34_viterbi_decode(slot.rx.data(), out.data()) != 0;
+    }
+
+  private:
+    bool soft_;
+};
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Harness                                                                                        */
+/* ---------------------------------------------------------------------------------------------- */
+
+struct CodecEntry {
+    const char* name;
+    const char* variant;
+    std::shared_ptr<Codec> codec;
+};
+
+struct Rates {
+    double corrected = 0.0;
+    double failed = 0.0;
+    double miscorrected = 0.0;
+};
+
+static void
+print_usage(const char* argv0) {
+    std::printf("Usage: %s [--iters N] [--warmup N] [--repeat N] [--case NAME] [--format text|csv] [--list]\n", argv0);
+}
+
+static int
+parse_positive_int(const char* value, int fallback) {
+    if (value == NULL) {
+        return fallback;
+    }
+    char* end = NULL;
+    long parsed = std::strtol(value, &end, 10);
+    if (end == value || *end != '\0' || parsed <= 0 || parsed > INT32_MAX) {
+        return fallback;
+    }
+    return (int)parsed;
+}
+
+static int
+parse_non_negative_int(const char* value, int fallback) {
+    if (value == NULL) {
+        return fallback;
+    }
+    char* end = NULL;
+    long parsed = std::strtol(value, &end, 10);
+    if (end == value || *end != '\0' || parsed < 0 || parsed > INT32_MAX) {
+        return fallback;
+    }
+    return (int)parsed;
+}
+
+static BenchOptions
+parse_options(int argc, char** argv) {
+    BenchOptions opts;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+            opts.iterations = parse_positive_int(argv[++i], opts.iterations);
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            opts.warmup = parse_non_negative_int(argv[++i], opts.warmup);
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            opts.repeat = parse_positive_int(argv[++i], opts.repeat);
+        } else if (std::strcmp(argv[i], "--case") == 0 && i + 1 < argc) {
+            opts.case_filter = argv[++i];
+            if (std::strcmp(opts.case_filter, "all") == 0) {
+                opts.case_filter = NULL;
+            }
+        } else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char* format = argv[++i];
+            opts.format = (std::strcmp(format, "csv") == 0) ? OutputFormat::Csv : OutputFormat::Text;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            opts.list_cases = 1;
+        } else if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            print_usage(argv[0]);
+            std::exit(0);
+        }
+    }
+    return opts;
+}
+
+static double
+median_of(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2U;
+    if ((values.size() & 1U) != 0U) {
+        return values[middle];
+    }
+    return 0.5 * (values[middle - 1U] + values[middle]);
+}
+
+static std::vector<Slot>
+build_pool(const Codec& codec, int ber_percent, uint32_t seed) {
+    Rng rng(seed);
+    const double ber = (double)ber_percent / 100.0;
+    std::vector<Slot> pool((size_t)kPoolSize);
+    std::vector<uint8_t> tx;
+    std::vector<uint8_t> flipped;
+    for (Slot& slot : pool) {
+        codec.encode(rng, tx, slot.want);
+        flipped.assign(tx.size(), 0);
+        slot.rx = tx;
+        for (size_t i = 0; i < tx.size(); i++) {
+            if (rng.chance(ber)) {
+                flipped[i] = 1;
+                slot.rx[i] ^= 1U;
+            }
+        }
+        codec.finish(slot, flipped);
+    }
+    return pool;
+}
+
+static double
+decode_pool(const Codec& codec, const std::vector<Slot>& pool, std::vector<uint8_t>& out, Rates* rates) {
+    double checksum = 0.0;
+    for (const Slot& slot : pool) {
+        const int rc = codec.decode(slot, out);
+        checksum += (double)rc;
+        for (size_t i = 0; i < out.size(); i++) {
+            checksum += (double)out[i] * (double)((i & 7U) + 1U);
+        }
+        if (rates != NULL) {
+            if (rc != 0) {
+                rates->failed += 1.0;
+            } else if (out == slot.want) {
+                rates->corrected += 1.0;
+            } else {
+                rates->miscorrected += 1.0;
+            }
+        }
+    }
+    return checksum;
+}
+
+static void
+print_result(const BenchOptions& opts, const char* name, const char* variant, int ber_percent, const BenchStats& stats,
+             const Rates& rates) {
+    if (opts.format == OutputFormat::Csv) {
+        std::printf("%s,%d,%d,%d,%d,codeword,%.3f,%.3f,%.3f,%.6f,%.3f,%.9e,%s,%.3f,%.6f,%.6f,%.6f\n", name, opts.repeat,
+                    opts.iterations, opts.warmup, kPoolSize, stats.median_ns_per_call, stats.min_ns_per_call,
+                    stats.mean_ns_per_call, stats.median_ns_per_item, stats.items_per_second, stats.checksum, variant,
+                    (double)ber_percent / 100.0, rates.corrected, rates.failed, rates.miscorrected);
+        return;
+    }
+    std::printf("%-28s median=%10.2f ns/codeword min=%9.2f us/call corrected=%6.2f%% failed=%6.2f%% "
+                "miscorrected=%6.2f%%\n",
+                name, stats.median_ns_per_item, stats.min_ns_per_call / 1000.0, 100.0 * rates.corrected,
+                100.0 * rates.failed, 100.0 * rates.miscorrected);
+}
+
+static int
+run_case(const BenchOptions& opts, const CodecEntry& entry, int ber_percent) {
+    char name[64];
+    DSD_SNPRINTF(name, sizeof(name), "%s_ber%02d", entry.name, ber_percent);
+    if (opts.case_filter != NULL && std::strcmp(opts.case_filter, name) != 0) {
+        return 0;
+    }
+    if (opts.list_cases) {
+        std::printf("%s\n", name);
+        return 1;
+    }
+
+    const std::vector<Slot> pool = build_pool(*entry.codec, ber_percent, 0x5EEDF00DU + (uint32_t)ber_percent);
+    std::vector<uint8_t> out;
+    Rates rates;
+    double checksum = decode_pool(*entry.codec, pool, out, &rates);
+    rates.corrected /= (double)kPoolSize;
+    rates.failed /= (double)kPoolSize;
+    rates.miscorrected /= (double)kPoolSize;
+
+    std::vector<double> ns_per_call;
+    ns_per_call.reserve((size_t)opts.repeat);
+    for (int repeat = 0; repeat < opts.repeat; repeat++) {
+        for (int i = 0; i < opts.warmup; i++) {
+            checksum += decode_pool(*entry.codec, pool, out, NULL);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < opts.iterations; i++) {
+            checksum += decode_pool(*entry.codec, pool, out, NULL);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double elapsed_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        ns_per_call.push_back(elapsed_ns / (double)opts.iterations);
+    }
+
+    BenchStats stats;
+    stats.checksum = checksum;
+    stats.min_ns_per_call = *std::min_element(ns_per_call.begin(), ns_per_call.end());
+    for (double value : ns_per_call) {
+        stats.mean_ns_per_call += value;
+    }
+    stats.mean_ns_per_call /= (double)ns_per_call.size();
+    stats.median_ns_per_call = median_of(ns_per_call);
+    stats.median_ns_per_item = stats.median_ns_per_call / (double)kPoolSize;
+    stats.items_per_second = 1000000000.0 / stats.median_ns_per_item;
+
+    g_bench_sink += checksum;
+    print_result(opts, name, entry.variant, ber_percent, stats, rates);
+    return 1;
+}
+
+} // namespace
+
+int
+main(int argc, char** argv) {
+    BenchOptions opts = parse_options(argc, argv);
+    InitAllFecFunction();
+
+    const CodecEntry codecs[] = {
+        {"golay24", "hard", std::make_shared<Golay24Codec>()},
+        {"golay_24_12", "hard", std::make_shared<BitBlockCodec>(decode_golay_24_12, 24, 12)},
+        {"golay_20_8", "hard", std::make_shared<BitBlockCodec>(decode_golay_20_8, 20, 8)},
+        {"qr_16_7_6", "hard", std::make_shared<BitBlockCodec>(decode_qr_16_7_6, 16, 7)},
+        {"hamming_7_4", "hard", std::make_shared<BitBlockCodec>(decode_hamming_7_4, 7, 4)},
+        {"hamming_10_6_3", "hard", std::make_shared<Hamming1063Codec>()},
+        {"hamming_13_9", "hard", std::make_shared<BitBlockCodec>(decode_hamming_13_9, 13, 9)},
+        {"hamming_15_11", "hard", std::make_shared<BitBlockCodec>(decode_hamming_15_11, 15, 11)},
+        {"hamming_16_11_4", "hard", std::make_shared<BitBlockCodec>(decode_hamming_16_11_4, 16, 11)},
+        {"bch_63_16", "hard", std::make_shared<Bch6316Codec>()},
+        {"bptc_196_96", "hard", std::make_shared<Bptc19696Codec>()},
+        {"rs_12_9", "hard", std::make_shared<Rs129Codec>()},
+        {"rs_24_12_13", "hard", std::make_shared<P25RsCodec<DSDReedSolomon_24_12_13>>(12, 12, false)},
+        {"rs_24_12_13_erasure", "erasure", std::make_shared<P25RsCodec<DSDReedSolomon_24_12_13>>(12, 12, true)},
+        {"rs_24_16_9", "hard", std::make_shared<P25RsCodec<DSDReedSolomon_24_16_9>>(16, 8, false)},
+        {"rs_24_16_9_erasure", "erasure", std::make_shared<P25RsCodec<DSDReedSolomon_24_16_9>>(16, 8, true)},
+        {"rs_36_20_17", "hard", std::make_shared<P25RsCodec<DSDReedSolomon_36_20_17>>(20, 16, false)},
+        {"rs_36_20_17_erasure", "erasure", std::make_shared<P25RsCodec<DSDReedSolomon_36_20_17>>(20, 16, true)},
+        {"ez_rs28_ess", "hard", std::make_shared<EzEssCodec>(false)},
+        {"ez_rs28_ess_erasure", "erasure", std::make_shared<EzEssCodec>(true)},
+        {"viterbi_k5", "hard", std::make_shared<ViterbiK5Codec>()},
+        {"dmr_r34_hard", "hard", std::make_shared<DmrR34Codec>(false)},
+        {"dmr_r34_soft", "soft", std::make_shared<DmrR34Codec>(true)},
+    };
+
+    if (opts.format == OutputFormat::Text && !opts.list_cases) {
+        std::printf("DSD-neo FEC benchmark\n");
+        std::printf("iterations=%d warmup=%d repeat=%d codewords/call=%d\n\n", opts.iterations, opts.warmup,
+                    opts.repeat, kPoolSize);
+    } else if (opts.format == OutputFormat::Csv && !opts.list_cases) {
+        std::printf("case,repeat,iterations,warmup,work_items,item_unit,median_ns_per_call,min_ns_per_call,"
+                    "mean_ns_per_call,median_ns_per_item,items_per_second,checksum,variant,ber,corrected_rate,"
+                    "failed_rate,miscorrected_rate\n");
+    }
+
+    int ran = 0;
+    for (const CodecEntry& entry : codecs) {
+        for (int ber_percent : k_ber_percent) {
+            ran += run_case(opts, entry, ber_percent);
+        }
+    }
+    if (ran == 0) {
+        DSD_FPRINTF(stderr, "No benchmark case matched. Use --list to see available cases.\n");
+        return 2;
+    }
+    return (g_bench_sink == -1.0) ? 1 : 0;
+}
@@ -14,6 +14,7 @@
 #include <cstdio>
 #include <cstring>
 #include <dsd-neo/fec/BCH_63_16.hpp>
+#include <stdint.h>
 #include "dsd-neo/core/safe_api.h"
 #include "p25_nid_generator.hpp"
 
@@ -243,6 +244,68 @@ test_gf_field_properties(void) {
     return 0;
 }
 
+/**
+ * @brief The packed API encodes like the reference generator matrix and
+ *        decodes exactly like the char-per-bit adapter, including failures.
+ */
+static int
+test_packed_matches_char_api(void) {
+    BCH_63_16_11 bch;
+    unsigned int rng = 0x1234567u;
+
+    for (int trial = 0; trial < 2000; trial++) {
+        rng = rng * 1103515245u + 12345u;
+        const uint16_t data = (uint16_t)(rng >> 8);
+        char info[16];
+        char codeword[63];
+        for (int i = 0; i < 16; i++) {
+            info[i] = (char)((data >> (15 - i)) & 1U);
+        }
+        p25_test_generate_nid_codeword(info, codeword);
+
+        uint64_t packed = BCH_63_16_11::encode_word(data);
+        for (int i = 0; i < 63; i++) {
+            if (((packed >> (62 - i)) & 1U) != (uint64_t)codeword[i]) {
+                DSD_FPRINTF(stderr, "test_packed_matches_char_api: encode_word(0x%04X) bit %d differs\n", data, i);
+                return 1;
+            }
+        }
+
+        // 0-15 errors, so both correctable and failing words are covered.
+        const int errors = trial % 16;
+        for (int e = 0; e < errors; e++) {
+            rng = rng * 1103515245u + 12345u;
+            const int pos = (int)((rng >> 8) % 63u);
+            codeword[pos] ^= 1;
+            packed ^= (uint64_t)1 << (62 - pos);
+        }
+
+        char decoded[16] = {0};
+        uint16_t packed_data = 0;
+        const BCH_63_16_Result char_result = bch.decode_with_result(codeword, decoded);
+        const BCH_63_16_Result packed_result = bch.decode_word(packed, &packed_data);
+        if (char_result.success != packed_result.success || char_result.error_count != packed_result.error_count) {
+            DSD_FPRINTF(stderr, "test_packed_matches_char_api: trial %d result differs\n", trial);
+            return 1;
+        }
+        if (!packed_result.success) {
+            continue;
+        }
+        for (int i = 0; i < 16; i++) {
+            if (decoded[i] != (char)((packed_data >> (15 - i)) & 1U)) {
+                DSD_FPRINTF(stderr, "test_packed_matches_char_api: trial %d data differs\n", trial);
+                return 1;
+            }
+        }
+        if (errors <= 11 && packed_data != data) {
+            DSD_FPRINTF(stderr, "test_packed_matches_char_api: trial %d miscorrected %d errors\n", trial, errors);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 int
 main(void) {
     int rc = 0;
@@ -251,6 +314,7 @@ main(void) {
     rc |= test_decode_no_errors();
     rc |= test_decode_failure_12_errors();
     rc |= test_gf_field_properties();
+    rc |= test_packed_matches_char_api();
     if (rc == 0) {
         std::printf("BCH(63,16,11) decoder unit tests passed.\n");
     }
@@ -188,6 +188,41 @@ test_golay_qr(void) {
     return 0;
 }
 
+/* Packed Hamming(10,6,3) must agree with the char-per-bit adapter on every word. */
+static int
+test_hamming_10_6_3_packed(void) {
+    for (unsigned int data = 0; data < 64U; data++) {
+        const unsigned int codeword = hamming_10_6_3_encode_word(data);
+        unsigned int fixed = 0xFFU;
+        assert((codeword >> 4) == data);
+        assert(hamming_10_6_3_decode_word(codeword, &fixed) == 0);
+        assert(fixed == data);
+        for (int bit = 4; bit < 10; bit++) {
+            assert(hamming_10_6_3_decode_word(codeword ^ (1U << bit), &fixed) == 1);
+            assert(fixed == data);
+        }
+    }
+    for (unsigned int word = 0; word < 1024U; word++) {
+        char data[6];
+        char parity[4];
+        for (int i = 0; i < 6; i++) {
+            data[i] = (char)((word >> (9 - i)) & 1U);
+        }
+        for (int i = 0; i < 4; i++) {
+            parity[i] = (char)((word >> (3 - i)) & 1U);
+        }
+        unsigned int fixed = 0;
+        const int packed = hamming_10_6_3_decode_word(word, &fixed);
+        assert(hamming_10_6_3_decode(data, parity) == packed);
+        unsigned int adapted = 0;
+        for (int i = 0; i < 6; i++) {
+            adapted = (adapted << 1) | (unsigned int)data[i];
+        }
+        assert(adapted == fixed);
+    }
+    return 0;
+}
+
 static int
 test_isch_soft_lookup(void) {
     const uint64_t isch0 = 0x184229d461ULL;
@@ -272,6 +307,9 @@ main(void) {
     if (test_golay_qr() != 0) {
         return 1;
     }
+    if (test_hamming_10_6_3_packed() != 0) {
+        return 1;
+    }
     if (test_isch_soft_lookup() != 0) {
         return 1;
     }
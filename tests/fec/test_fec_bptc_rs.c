@@ -12,6 +12,7 @@
 #include <dsd-neo/fec/rs_12_9.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include "dsd-neo/core/safe_api.h"
 
 /* Fixed DMR BPTC(196,96) reference codeword. Bit 0 is the reserved bit; the
@@ -189,6 +190,96 @@ test_bptc_196x96_deinterleave(void) {
     return 0;
 }
 
+/* The bit-per-byte row/column decoder the packed matrix replaced; a line that
+ * fails to decode is left as received. */
+static uint32_t
+ref_bptc_196x96_pass(uint8_t m[13][15], int count) {
+    uint32_t errors = 0;
+    for (int i = 0; i < 9; i++) {
+        uint8_t line[15];
+        uint8_t fixed[11];
+        DSD_MEMCPY(line, m[i], sizeof(line));
+        DSD_MEMCPY(fixed, m[i], sizeof(fixed));
+        if (!Hamming_15_11_decode(line, fixed, 1)) {
+            errors++;
+        }
+        DSD_MEMCPY(m[i], fixed, sizeof(fixed));
+    }
+    for (int j = 0; j < 15; j++) {
+        uint8_t col[13];
+        uint8_t fixed[9];
+        for (int i = 0; i < 13; i++) {
+            col[i] = m[i][j];
+        }
+        DSD_MEMCPY(fixed, col, sizeof(fixed));
+        if (!Hamming_13_9_decode(col, fixed, 1)) {
+            errors++;
+        }
+        for (int i = 0; i < 9; i++) {
+            m[i][j] = fixed[i];
+        }
+    }
+    return count ? errors : 0U;
+}
+
+static uint32_t
+ref_bptc_196x96(const uint8_t in[196], uint8_t out[96], uint8_t r[3]) {
+    uint8_t m[13][15];
+    for (int k = 1; k < 196; k++) {
+        m[(k - 1) / 15][(k - 1) % 15] = in[k] & 1U;
+    }
+    (void)ref_bptc_196x96_pass(m, 0);
+    const uint32_t errors = ref_bptc_196x96_pass(m, 1);
+    int k = 0;
+    for (int j = 3; j < 11; j++) {
+        out[k++] = m[0][j];
+    }
+    for (int i = 1; i < 9; i++) {
+        for (int j = 0; j < 11; j++) {
+            out[k++] = m[i][j];
+        }
+    }
+    r[0] = m[0][2];
+    r[1] = m[0][1];
+    r[2] = m[0][0];
+    return errors;
+}
+
+static int
+test_bptc_196x96_packed_matches_reference(void) {
+    InitAllFecFunction();
+    uint32_t rng = 0xB97C1960u;
+    for (int trial = 0; trial < 4000; trial++) {
+        uint8_t word[196];
+        DSD_MEMCPY(word, k_bptc_196_codeword, sizeof(word));
+        /* 0 to 15 flips, enough to hit uncorrectable columns and miscorrections. */
+        rng = (rng * 1664525u) + 1013904223u;
+        const int flips = (int)((rng >> 24) % 16u);
+        for (int f = 0; f < flips; f++) {
+            rng = (rng * 1664525u) + 1013904223u;
+            word[1 + ((rng >> 8) % 195u)] ^= 1U;
+        }
+        uint8_t want[96];
+        uint8_t want_r[3];
+        uint8_t got[96];
+        uint8_t got_r[3];
+        const uint32_t want_irr = ref_bptc_196x96(word, want, want_r);
+        assert(BPTC_196x96_Extract_Data(word, got, got_r) == want_irr);
+        assert(memcmp(got, want, sizeof(want)) == 0);
+        assert(memcmp(got_r, want_r, sizeof(want_r)) == 0);
+
+        /* The fused entry point reads the same block from its interleaved form. */
+        uint8_t interleaved[196];
+        for (int i = 0; i < 196; i++) {
+            interleaved[i] = word[BPTCDeInterleavingIndex[i]];
+        }
+        assert(BPTC_196x96_Decode(interleaved, got, got_r) == want_irr);
+        assert(memcmp(got, want, sizeof(want)) == 0);
+        assert(memcmp(got_r, want_r, sizeof(want_r)) == 0);
+    }
+    return 0;
+}
+
 static int
 test_rs_12_9(void) {
     rs_12_9_codeword_t cw = {{3, 20, 37, 54, 71, 88, 105, 122, 139, 208, 63, 250}};
@@ -230,6 +321,9 @@ main(void) {
     if (test_bptc_196x96_deinterleave() != 0) {
         return 1;
     }
+    if (test_bptc_196x96_packed_matches_reference() != 0) {
+        return 1;
+    }
     if (test_rs_12_9() != 0) {
         return 1;
     }
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * The table-driven Golay(24,12) decoder must return the same codeword, error
+ * count and status as the bit-serial trial-flip corrector it replaced, for
+ * every syndrome and both overall parities.
+ */
+
+#include <cstdio>
+#include <dsd-neo/fec/Golay24.hpp>
+#include <stdint.h>
+#include "dsd-neo/core/safe_api.h"
+
+namespace {
+
+unsigned int
+ref_syndrome(unsigned int cw) {
+    cw &= 0x7fffffU;
+    for (int i = 1; i <= 12; i++) {
+        if (cw & 1U) {
+            cw ^= 0xAE3U;
+        }
+        cw >>= 1;
+    }
+    return (cw << 12);
+}
+
+unsigned int
+ref_rotate_left(unsigned int cw, int n) {
+    for (int i = 0; i < n; i++) {
+        cw = (cw & 0x400000U) ? ((cw << 1) | 1U) : (cw << 1);
+    }
+    return cw & 0x7fffffU;
+}
+
+unsigned int
+ref_rotate_right(unsigned int cw, int n) {
+    for (int i = 0; i < n; i++) {
+        cw = (cw & 1U) ? ((cw >> 1) | 0x400000U) : (cw >> 1);
+    }
+    return cw & 0x7fffffU;
+}
+
+/* The original corrector: rotation search, then single trial flips. */
+unsigned int
+ref_correct(unsigned int cw, int* errs) {
+    const unsigned int saved = cw;
+    unsigned int mask = 1U;
+    int w = 3;
+    *errs = 0;
+    for (int j = -1; j < 23; j++) {
+        if (j != -1) {
+            if (j > 0) {
+                mask += mask;
+            }
+            cw = saved ^ mask;
+            w = 2;
+        }
+        unsigned int s = ref_syndrome(cw);
+        if (!s) {
+            return cw;
+        }
+        for (int i = 0; i < 23; i++) {
+            *errs = dsd_popcount64(s & 0x7fffffU);
+            if (*errs <= w) {
+                return ref_rotate_right(cw ^ s, i);
+            }
+            cw = ref_rotate_left(cw, 1);
+            s = ref_syndrome(cw);
+        }
+    }
+    return saved;
+}
+
+int
+ref_parity(unsigned int cw) {
+    return dsd_popcount64(cw & 0xffffffU) & 1;
+}
+
+int
+ref_decode(int* errs, unsigned int* cw) {
+    const unsigned int parity_bit = *cw & 0x800000U;
+    *cw = ref_correct(*cw & ~0x800000U, errs) | parity_bit;
+    return ref_parity(*cw);
+}
+
+} // namespace
+
+int
+main(void) {
+    uint32_t rng = 0xC0DE5EEDu;
+    int failures = 0;
+    for (unsigned int data = 0; data < 4096U; data++) {
+        const unsigned int check = ref_syndrome(data) | data;
+        const unsigned int want = ref_parity(check) ? (check ^ 0x800000U) : check;
+        if (Golay24::encode(data) != want) {
+            DSD_FPRINTF(stderr, "FAIL: encode(0x%03X)\n", data);
+            failures++;
+        }
+    }
+    /* Every 11-bit syndrome with a spread of codewords and both parity bits. */
+    for (unsigned int syn = 0; syn < 2048U && failures < 10; syn++) {
+        for (int k = 0; k < 8; k++) {
+            rng = rng * 1664525u + 1013904223u;
+            const unsigned int word = (Golay24::encode(rng >> 12) ^ (syn << 12)) ^ ((rng & 1U) << 23);
+            unsigned int got = word;
+            unsigned int want = word;
+            int got_errs = -1;
+            int want_errs = -1;
+            const int got_rc = Golay24::decode(&got_errs, &got);
+            const int want_rc = ref_decode(&want_errs, &want);
+            if (got != want || got_errs != want_errs || got_rc != want_rc) {
+                DSD_FPRINTF(stderr, "FAIL: decode(0x%06X): got %06X/%d/%d want %06X/%d/%d\n", word, got, got_errs,
+                            got_rc, want, want_errs, want_rc);
+                failures++;
+            }
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Unit test: the K=5 Viterbi engine matches the scalar libM17 trellis it
+ * replaced (decisions and path metrics, ties included), corrects channel
+ * errors on an encoded message, and keeps interleaved contexts independent.
+ */
+
+#include <dsd-neo/fec/viterbi_k5.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+
+static uint32_t g_rng = 0x5eed1234u;
+
+static uint32_t
+next_rand(void) {
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return g_rng >> 8;
+}
+
+static int
+expect_u32(const char* label, int index, uint32_t got, uint32_t want) {
+    if (got != want) {
+        DSD_FPRINTF(stderr, "FAIL: %s[%d]: got %u want %u\n", label, index, (unsigned)got, (unsigned)want);
+        return 0;
+    }
+    return 1;
+}
+
+static uint32_t
+abs_diff(uint32_t a, uint32_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+/* The scalar add-compare-select from the original viterbi_decode_bit(). */
+static uint16_t
+ref_step(uint32_t metrics[16], uint16_t s0, uint16_t s1) {
+    static const uint16_t cost0[] = {0, 0, 0, 0, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF};
+    static const uint16_t cost1[] = {0, 0xFFFF, 0xFFFF, 0, 0, 0xFFFF, 0xFFFF, 0};
+    uint32_t next[16];
+    uint16_t history = 0;
+    for (int i = 0; i < 8; i++) {
+        const uint32_t metric = abs_diff(cost0[i], s0) + abs_diff(cost1[i], s1);
+        const uint32_t m0 = metrics[i] + metric;
+        const uint32_t m1 = metrics[i + 8] + (0x1FFFE - metric);
+        const uint32_t m2 = metrics[i] + (0x1FFFE - metric);
+        const uint32_t m3 = metrics[i + 8] + metric;
+        if (m0 >= m1) {
+            history |= (uint16_t)(1U << (2 * i));
+            next[2 * i] = m1;
+        } else {
+            next[2 * i] = m0;
+        }
+        if (m2 >= m3) {
+            history |= (uint16_t)(1U << ((2 * i) + 1));
+            next[(2 * i) + 1] = m3;
+        } else {
+            next[(2 * i) + 1] = m2;
+        }
+    }
+    DSD_MEMCPY(metrics, next, sizeof(next));
+    return history;
+}
+
+static void
+soft_step(dsd_viterbi_k5* v, uint16_t s0, uint16_t s1) {
+    uint32_t bm[4];
+    for (unsigned int p = 0; p < 4U; p++) {
+        bm[p] = abs_diff((p & 2U) ? 0xFFFFU : 0U, s0) + abs_diff((p & 1U) ? 0xFFFFU : 0U, s1);
+    }
+    (void)dsd_viterbi_k5_step(v, bm);
+}
+
+static uint16_t
+random_soft(void) {
+    /* Mostly the three values that produce metric ties, plus some noise. */
+    static const uint16_t k_levels[] = {0x0000, 0x7FFF, 0xFFFF};
+    const uint32_t r = next_rand();
+    return ((r & 3u) == 3u) ? (uint16_t)(r >> 4) : k_levels[(r >> 2) % 3u];
+}
+
+static int
+test_matches_reference(void) {
+    int ok = 1;
+    for (int trial = 0; trial < 64 && ok; trial++) {
+        const int steps = 1 + (int)(next_rand() % 244u);
+        uint32_t ref[16] = {0};
+        dsd_viterbi_k5 v;
+        dsd_viterbi_k5_reset(&v, 0x1FFFE);
+        for (int k = 0; k < steps && ok; k++) {
+            const uint16_t s0 = random_soft();
+            const uint16_t s1 = random_soft();
+            const uint16_t want = ref_step(ref, s0, s1);
+            soft_step(&v, s0, s1);
+            ok &= expect_u32("decisions", k, v.decisions[k], want);
+            for (int s = 0; s < 16; s++) {
+                ok &= expect_u32("metrics", s, v.metrics[s], ref[s]);
+            }
+        }
+    }
+    return ok;
+}
+
+static int
+parity5(unsigned int v) {
+    v &= 0x1FU;
+    v ^= v >> 4;
+    v ^= v >> 2;
+    v ^= v >> 1;
+    return (int)(v & 1U);
+}
+
+/* Encode msg plus four flush bits into soft pairs, flipping each listed coded bit. */
+static int
+encode_soft(const uint8_t* msg, int bits, uint16_t* soft, const int* flips, int flip_count) {
+    unsigned int reg = 0U;
+    int n = 0;
+    for (int i = 0; i < bits + 4; i++) {
+        reg = ((reg << 1) | (i < bits ? msg[i] : 0U)) & 0x1FU;
+        soft[n++] = parity5(reg & 0x19U) ? 0xFFFF : 0x0000;
+        soft[n++] = parity5(reg & 0x17U) ? 0xFFFF : 0x0000;
+    }
+    for (int f = 0; f < flip_count; f++) {
+        soft[flips[f]] ^= 0xFFFF;
+    }
+    return n;
+}
+
+static int
+test_corrects_errors(void) {
+    enum { MSG_BITS = 200 };
+    uint8_t msg[MSG_BITS];
+    uint16_t soft[(MSG_BITS + 4) * 2];
+    uint8_t bits[MSG_BITS];
+    int ok = 1;
+    for (int i = 0; i < MSG_BITS; i++) {
+        msg[i] = (uint8_t)(next_rand() & 1u);
+    }
+    /* Isolated errors well beyond the code's free distance apart. */
+    static const int flips[] = {3, 40, 41, 97, 150, 222, 301, 360, 402};
+    const int n = encode_soft(msg, MSG_BITS, soft, flips, (int)(sizeof(flips) / sizeof(flips[0])));
+
+    dsd_viterbi_k5 v;
+    dsd_viterbi_k5_reset(&v, 0x1FFFE);
+    for (int i = 0; i + 1 < n; i += 2) {
+        soft_step(&v, soft[i], soft[i + 1]);
+    }
+    ok &= expect_u32("traced bits", 0, (uint32_t)dsd_viterbi_k5_traceback(&v, bits, MSG_BITS), MSG_BITS);
+    for (int i = 0; i < MSG_BITS; i++) {
+        ok &= expect_u32("decoded", i, bits[i], msg[i]);
+    }
+    ok &= expect_u32("best metric", 0, dsd_viterbi_k5_best_metric(&v), 9U * 0xFFFFU);
+    return ok;
+}
+
+static int
+test_contexts_are_independent(void) {
+    enum { PAIRS = 150 };
+    uint16_t a[PAIRS * 2];
+    uint16_t b[PAIRS * 2];
+    for (int i = 0; i < PAIRS * 2; i++) {
+        a[i] = random_soft();
+        b[i] = random_soft();
+    }
+    dsd_viterbi_k5 solo;
+    dsd_viterbi_k5 va;
+    dsd_viterbi_k5 vb;
+    dsd_viterbi_k5_reset(&solo, 0x1FFFE);
+    dsd_viterbi_k5_reset(&va, 0x1FFFE);
+    dsd_viterbi_k5_reset(&vb, 0x1FFFE);
+    for (int i = 0; i < PAIRS; i++) {
+        soft_step(&solo, a[2 * i], a[(2 * i) + 1]);
+        soft_step(&va, a[2 * i], a[(2 * i) + 1]);
+        soft_step(&vb, b[2 * i], b[(2 * i) + 1]);
+    }
+    int ok = expect_u32("interleaved decisions", 0,
+                        (uint32_t)memcmp(solo.decisions, va.decisions, sizeof(uint16_t) * PAIRS), 0U);
+    ok &= expect_u32("interleaved metric", 0, dsd_viterbi_k5_best_metric(&va), dsd_viterbi_k5_best_metric(&solo));
+
+    /* Steps past the decision buffer are refused without touching the trellis. */
+    dsd_viterbi_k5_reset(&va, 4);
+    const uint32_t bm[4] = {0, 2, 2, 4};
+    for (int i = 0; i < DSD_VITERBI_K5_MAX_STEPS; i++) {
+        ok &= expect_u32("step", i, (uint32_t)dsd_viterbi_k5_step(&va, bm), 0U);
+    }
+    ok &= expect_u32("overflow step", 0, (uint32_t)dsd_viterbi_k5_step(&va, bm), (uint32_t)-1);
+    return ok;
+}
+
+int
+main(void) {
+    int ok = 1;
+    ok &= test_matches_reference();
+    ok &= test_corrects_errors();
+    ok &= test_contexts_are_independent();
+    return ok ? 0 : 1;
+}
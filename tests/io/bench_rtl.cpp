@@ -25,12 +25,15 @@
 #include <dsd-neo/core/input_level.h>
 #include <dsd-neo/dsp/simd_widen.h>
 #include <dsd-neo/io/rtl_metrics.h>
+#include <dsd-neo/io/rtl_stream_c.h>
 #include <dsd-neo/platform/threading.h>
 #include <dsd-neo/runtime/input_ring.h>
 #include <dsd-neo/runtime/ring.h>
 #include <stdint.h>
+#include <thread>
 #include <vector>
 #include "dsd-neo/core/safe_api.h"
+#include "rtl_channelizer.h"
 
 namespace {
 
@@ -221,8 +224,7 @@ fill_rotating_iq(std::vector<float>* v, float step) {
 
 static void
 reset_ring_at(input_ring_state* ring, size_t index) {
-    ring->tail.store(index);
-    ring->head.store(index);
+    ring->reset(index, index);
 }
 
 static uint32_t
@@ -424,6 +426,67 @@ bench_rtl_metrics(const BenchOptions& opts) {
     return ran;
 }
 
+static int
+bench_rtl_channelizer(const BenchOptions& opts) {
+    int ran = 0;
+    /* One demod block at 2.4 MS/s split on the 12.5 kHz raster (M = 192),
+     * extracting a control channel plus three grants. */
+    constexpr int kChannels = 192;
+    constexpr int kPairs = 16384;
+    std::vector<float> iq(2U * kPairs);
+    fill_rotating_iq(&iq, 0.013f);
+    dsd_io::PolyphaseChannelizer bank;
+    if (!bank.configure(kChannels, 16)) {
+        return ran;
+    }
+    const int channels[4] = {160, 1, 20, 56};
+    const int out_pairs = kPairs / bank.decimation() + 1;
+    std::vector<float> out[4];
+    float* outs[4];
+    for (int i = 0; i < 4; i++) {
+        out[i].assign(2U * (size_t)out_pairs, 0.0f);
+        outs[i] = out[i].data();
+    }
+
+    ran += run_case(opts, "rtl_channelizer_m192_4ch", "sample", (double)kPairs, [&]() -> float {
+        int got = bank.process(iq.data(), kPairs, channels, 4, outs, out_pairs);
+        float acc = 0.0f;
+        for (int i = 0; i < 4; i++) {
+            acc += (got > 0) ? out[i][2U * (size_t)got - 1U] : 0.0f;
+        }
+        return acc;
+    });
+    return ran;
+}
+
+struct OutputRingFeed {
+    output_state* ring;
+    const float* src;
+    size_t total;
+    size_t block;
+};
+
+/* Demod-side half of the cross-thread case: bulk writes plus the consumer wake. */
+DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    output_ring_feed_thread(void* arg) {
+    OutputRingFeed* feed = static_cast<OutputRingFeed*>(arg);
+    size_t sent = 0U;
+    while (sent < feed->total) {
+        size_t want = std::min(feed->block, feed->total - sent);
+        size_t wrote = feed->ring->write(feed->src + sent, want);
+        if (wrote == 0U) {
+            std::this_thread::yield();
+            continue;
+        }
+        ring_notify_ready(feed->ring);
+        sent += wrote;
+    }
+    DSD_THREAD_RETURN;
+}
+
 static int
 bench_rtl_output(const BenchOptions& opts) {
     int ran = 0;
@@ -445,19 +508,58 @@ bench_rtl_output(const BenchOptions& opts) {
     dsd_cond_init(&ring.ready);
     dsd_cond_init(&ring.space);
     dsd_mutex_init(&ring.ready_m);
-    ring.head.store(0);
-    ring.tail.store(0);
+    ring.reset();
     ring.write_timeouts.store(0);
     ring.read_timeouts.store(0);
 
     ran += run_case(opts, "rtl_symbol_output_read_batch_512", "sample", (double)kBlock, [&]() -> float {
-        ring_clear(&ring);
         DSD_MEMCPY(ring.buffer, in.data(), kBlock * sizeof(float));
-        ring.head.store(kBlock);
+        ring.reset(kBlock);
         int got = ring_read_batch(&ring, out.data(), kBlock);
         return out[0] + out[(got > 0) ? (size_t)got - 1U : 0U] + (float)got;
     });
 
+    /* Symbol-rate blocks from a producer thread into the 512-sample reads getSymbol() uses. */
+    constexpr size_t kStreamTotal = 65536;
+    constexpr size_t kStreamBlock = 960;
+    std::vector<float> stream_in(kStreamTotal);
+    for (size_t i = 0; i < kStreamTotal; i++) {
+        stream_in[i] = in[i % kBlock];
+    }
+    output_state stream_ring = {};
+    stream_ring.rate = 48000;
+    stream_ring.capacity = (4U * kStreamBlock) + 1U;
+    stream_ring.buffer = (float*)std::calloc(stream_ring.capacity, sizeof(float));
+    if (stream_ring.buffer) {
+        dsd_cond_init(&stream_ring.ready);
+        dsd_cond_init(&stream_ring.space);
+        dsd_mutex_init(&stream_ring.ready_m);
+        ran += run_case(opts, "rtl_output_ring_cross_thread", "sample", (double)kStreamTotal, [&]() -> float {
+            ring_clear(&stream_ring);
+            OutputRingFeed feed = {&stream_ring, stream_in.data(), kStreamTotal, kStreamBlock};
+            dsd_thread_t thread;
+            if (dsd_thread_create(&thread, output_ring_feed_thread, &feed) != 0) {
+                return -1.0f;
+            }
+            size_t total = 0U;
+            float acc = 0.0f;
+            while (total < kStreamTotal) {
+                int got = ring_read_batch(&stream_ring, out.data(), kBlock);
+                if (got <= 0) {
+                    break;
+                }
+                acc += out[(size_t)got - 1U];
+                total += (size_t)got;
+            }
+            (void)dsd_thread_join(thread);
+            return acc + (float)total;
+        });
+        dsd_mutex_destroy(&stream_ring.ready_m);
+        dsd_cond_destroy(&stream_ring.ready);
+        dsd_cond_destroy(&stream_ring.space);
+        std::free(stream_ring.buffer);
+    }
+
     dsd_mutex_destroy(&ring.ready_m);
     dsd_cond_destroy(&ring.ready);
     dsd_cond_destroy(&ring.space);
@@ -478,6 +580,7 @@ main(int argc, char** argv) {
     int ran = 0;
     ran += bench_rtl_ingest(opts);
     ran += bench_rtl_metrics(opts);
+    ran += bench_rtl_channelizer(opts);
     ran += bench_rtl_output(opts);
 
     if (!opts.list_cases && ran == 0) {
@@ -17,12 +17,12 @@
 #include <stdint.h>
 #include "dsd-neo/core/opts_fwd.h"
 #include "dsd-neo/core/safe_api.h"
+#include "rtl_stream_shared.hpp"
 #include "rtl_stream_test_support.h"
 
-extern demod_state demod;
-extern std::atomic<double> g_snr_c4fm_db;
-extern std::atomic<double> g_snr_gfsk_db;
-extern std::atomic<double> g_snr_qpsk_db;
+/* The test drives the default pipeline from the main thread. */
+static demod_state& demod = rtl_stream_demod();
+static RtlStreamShared& shared = rtl_stream_shared();
 
 static int
 is_fsk_output_kind(int kind) {
@@ -397,7 +397,7 @@ expect_rtl_metrics_do_not_nudge_cqpsk_bandedge(void) {
     demod.ted_state.lock_accum = 32.0f;
 
     const float want = demod.fll_band_edge_state.freq;
-    g_snr_qpsk_db.store(30.0, std::memory_order_relaxed);
+    shared.snr_qpsk_db.store(30.0, std::memory_order_relaxed);
 
     static float iq[2048];
     const float kTwoPi = 6.28318530717958647692f;
@@ -410,7 +410,7 @@ expect_rtl_metrics_do_not_nudge_cqpsk_bandedge(void) {
     }
 
     rtl_metrics_update_spectrum_from_iq(iq, 2048, 48000);
-    g_snr_qpsk_db.store(-100.0, std::memory_order_relaxed);
+    shared.snr_qpsk_db.store(-100.0, std::memory_order_relaxed);
 
     if (fabsf(demod.fll_band_edge_state.freq - want) > 1e-7f) {
         DSD_FPRINTF(stderr, "RTL metrics nudged CQPSK band-edge freq=%f want=%f\n", demod.fll_band_edge_state.freq,
@@ -493,15 +493,15 @@ expect_rtl_metrics_exports_and_toggles(void) {
         rc = 1;
     }
 
-    g_snr_c4fm_db.store(11.25, std::memory_order_relaxed);
-    g_snr_qpsk_db.store(12.50, std::memory_order_relaxed);
-    g_snr_gfsk_db.store(13.75, std::memory_order_relaxed);
+    shared.snr_c4fm_db.store(11.25, std::memory_order_relaxed);
+    shared.snr_qpsk_db.store(12.50, std::memory_order_relaxed);
+    shared.snr_gfsk_db.store(13.75, std::memory_order_relaxed);
     rc |= expect_double_near("RTL C4FM SNR export", rtl_stream_get_snr_c4fm(), 11.25, 1e-9);
     rc |= expect_double_near("RTL CQPSK SNR export", rtl_stream_get_snr_cqpsk(), 12.50, 1e-9);
     rc |= expect_double_near("RTL GFSK SNR export", rtl_stream_get_snr_gfsk(), 13.75, 1e-9);
-    g_snr_c4fm_db.store(-100.0, std::memory_order_relaxed);
-    g_snr_qpsk_db.store(-100.0, std::memory_order_relaxed);
-    g_snr_gfsk_db.store(-100.0, std::memory_order_relaxed);
+    shared.snr_c4fm_db.store(-100.0, std::memory_order_relaxed);
+    shared.snr_qpsk_db.store(-100.0, std::memory_order_relaxed);
+    shared.snr_gfsk_db.store(-100.0, std::memory_order_relaxed);
 
     // User-facing tuner toggles should round-trip through the public control wrappers.
     rtl_stream_set_tuner_autogain(1);
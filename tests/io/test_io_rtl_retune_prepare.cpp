@@ -7,7 +7,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <dsd-neo/core/constants.h>
 #include <dsd-neo/core/input_level.h>
+#include <dsd-neo/dsp/simd_widen.h>
 #include <dsd-neo/io/iq_types.h>
 #include <dsd-neo/io/rtl_stream_c.h>
 #include "dsd-neo/core/safe_api.h"
@@ -40,6 +42,13 @@ extern "C" int rtl_device_test_u8_full_ring_drop(size_t* out_used, uint64_t* out
                                                  int* out_phase, int* out_status);
 extern "C" int rtl_device_test_u8_generation_stale_drop(uint64_t* out_drops, int* out_phase, int* out_dev_carry_valid,
                                                         int* out_local_carry_valid, int* out_status);
+extern "C" int rtl_device_test_u8_ingest_decim(const unsigned char* input, size_t input_bytes, size_t split,
+                                               size_t ring_cap, float* out, size_t out_cap, size_t* out_used,
+                                               uint64_t* out_drops, int* out_phase);
+extern "C" int rtl_device_test_u8_compact_ring(const unsigned char* input, size_t input_bytes, size_t split,
+                                               size_t ring_cap, int compact, float* out, size_t out_cap,
+                                               size_t* out_used, uint64_t* out_drops, int* out_phase,
+                                               int* out_decim_rc);
 extern "C" int rtl_device_test_u8_moment_accounting(dsd_input_level_cu8_moments* out, size_t out_count);
 extern "C" int rtl_device_test_replay_input_level_snapshot(int format, int backend, const char* capture_stage,
                                                            size_t raw_bytes, size_t scratch_cap_f32, int* out_rc,
@@ -882,6 +891,92 @@ main(void) {
     failed |= expect_int_eq("u8 stale-generation clears device carry", stale_dev_carry_valid, 0);
     failed |= expect_int_eq("u8 stale-generation clears local carry", stale_local_carry_valid, 0);
 
+    /*
+     * Capture-side decimation: the ring holds exactly what the fused kernel
+     * produces for the whole stream, even across an odd callback split, and a
+     * full ring drops the rest while the fs/4 phase keeps counting pairs.
+     */
+    {
+        unsigned char decim_in[602];
+        for (size_t i = 0; i < sizeof(decim_in); i++) {
+            decim_in[i] = (unsigned char)((i * 73U + 19U) & 0xffU);
+        }
+        float decim_ref[302] = {};
+        float decim_out[302] = {};
+        dsd_neo_widen_hb_state hb;
+        widen_hb_decim2_state_reset(&hb);
+        uint32_t ref_pairs = 0U;
+        (void)widen_hb_decim2_u8_to_f32_bias127(decim_in, decim_ref, sizeof(decim_in), 0U, 1, &hb, NULL, &ref_pairs);
+        size_t decim_used = 0U;
+        uint64_t decim_drops = 0U;
+        int decim_phase = -1;
+        rc = rtl_device_test_u8_ingest_decim(decim_in, sizeof(decim_in), 101U, 1024U, decim_out, 302U, &decim_used,
+                                             &decim_drops, &decim_phase);
+        failed |= expect_int_eq("ingest decim helper rc", rc, 0);
+        failed |= expect_size_eq("ingest decim output count", decim_used, (size_t)ref_pairs * 2U);
+        failed |= expect_size_eq("ingest decim no drops", (size_t)decim_drops, 0U);
+        failed |= expect_int_eq("ingest decim phase", decim_phase, 1);
+        int decim_match = 1;
+        for (size_t i = 0; i < decim_used && i < 302U; i++) {
+            if (std::fabs(decim_out[i] - decim_ref[i]) > 1e-6f) {
+                decim_match = 0;
+            }
+        }
+        failed |= expect_int_eq("ingest decim matches fused kernel", decim_match, 1);
+
+        rc = rtl_device_test_u8_ingest_decim(decim_in, sizeof(decim_in), 101U, 33U, decim_out, 302U, &decim_used,
+                                             &decim_drops, &decim_phase);
+        failed |= expect_int_eq("ingest decim full-ring helper rc", rc, 0);
+        failed |= expect_size_eq("ingest decim full-ring keeps ring capacity", decim_used, 32U);
+        failed |= expect_int_eq("ingest decim full-ring drops", decim_drops > 0U ? 1 : 0, 1);
+        failed |= expect_int_eq("ingest decim full-ring phase", decim_phase, 1);
+        decim_match = 1;
+        for (size_t i = 0; i < decim_used && i < 302U; i++) {
+            if (std::fabs(decim_out[i] - decim_ref[i]) > 1e-6f) {
+                decim_match = 0;
+            }
+        }
+        failed |= expect_int_eq("ingest decim full-ring prefix matches", decim_match, 1);
+    }
+
+    /*
+     * Compact CU8 ring: byte-domain fs/4 rotation plus the consumer widen must
+     * reproduce the float ring bit for bit, drop the same elements when full,
+     * and refuse capture-side decimation.
+     */
+    {
+        unsigned char compact_in[601];
+        for (size_t i = 0; i < sizeof(compact_in); i++) {
+            compact_in[i] = (unsigned char)((i * 151U + 7U) & 0xffU);
+        }
+        const size_t caps[2] = {1024U, 129U};
+        for (size_t c = 0; c < 2U; c++) {
+            float ref[600] = {};
+            float got[600] = {};
+            size_t ref_used = 0U;
+            size_t got_used = 0U;
+            uint64_t ref_drops = 0U;
+            uint64_t got_drops = 0U;
+            int ref_phase = -1;
+            int got_phase = -1;
+            int ref_decim_rc = -1;
+            int got_decim_rc = -1;
+            rc = rtl_device_test_u8_compact_ring(compact_in, sizeof(compact_in), 77U, caps[c], 0, ref, 600U, &ref_used,
+                                                 &ref_drops, &ref_phase, &ref_decim_rc);
+            failed |= expect_int_eq("float ring helper rc", rc, 0);
+            rc = rtl_device_test_u8_compact_ring(compact_in, sizeof(compact_in), 77U, caps[c], 1, got, 600U, &got_used,
+                                                 &got_drops, &got_phase, &got_decim_rc);
+            failed |= expect_int_eq("compact ring helper rc", rc, 0);
+            failed |= expect_size_eq("compact ring sample count", got_used, ref_used);
+            failed |= expect_size_eq("compact ring drops", (size_t)got_drops, (size_t)ref_drops);
+            failed |= expect_int_eq("compact ring phase", got_phase, ref_phase);
+            failed |= expect_int_eq("float ring allows ingest decim", ref_decim_rc, 0);
+            failed |= expect_int_eq("compact ring refuses ingest decim", got_decim_rc, DSD_ERR_NOT_SUPPORTED);
+            failed |= expect_int_eq("compact ring matches float ring",
+                                    std::memcmp(got, ref, sizeof(float) * (got_used < 600U ? got_used : 600U)), 0);
+        }
+    }
+
     dsd_input_level_cu8_moments path_moments[9] = {};
     rc = rtl_device_test_u8_moment_accounting(path_moments, sizeof(path_moments) / sizeof(path_moments[0]));
     failed |= expect_int_eq("u8 moment accounting helper rc", rc, 0);
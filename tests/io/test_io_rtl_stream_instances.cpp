@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * Regression test: pipelines from dsd_rtl_stream_create() keep their own
+ * demodulator and published state apart from each other and from the default
+ * pipeline, dsd_rtl_stream_bind() steers the context-less calls, and threads a
+ * pipeline starts inherit the starter's binding.
+ */
+
+// LLVM 22/GCC 16 misclassifies these runtime test oracles as compile-time assertions.
+// NOLINTBEGIN(cert-dcl03-c,misc-static-assert)
+
+#include <cassert>
+#include <cstdio>
+#include <dsd-neo/core/safe_api.h>
+#include <dsd-neo/dsp/demod_state.h>
+#include <dsd-neo/io/rtl_stream_c.h>
+#include <dsd-neo/platform/threading.h>
+
+#include "rtl_stream_shared.hpp"
+
+namespace {
+
+struct ThreadProbe {
+    const demod_state* demod;
+    int on_default;
+};
+
+DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    probe_thread(void* arg) {
+    ThreadProbe* probe = static_cast<ThreadProbe*>(arg);
+    probe->demod = &rtl_stream_demod();
+    probe->on_default = rtl_stream_on_default_pipeline();
+    DSD_THREAD_RETURN;
+}
+
+void
+test_pipelines_are_distinct(dsd_rtl_stream* a, dsd_rtl_stream* b) {
+    const demod_state* def_demod = &rtl_stream_demod();
+    assert(rtl_stream_on_default_pipeline() == 1);
+
+    assert(dsd_rtl_stream_bind(a) == nullptr);
+    const demod_state* a_demod = &rtl_stream_demod();
+    assert(rtl_stream_on_default_pipeline() == 0);
+    assert(dsd_rtl_stream_bind(b) == a);
+    const demod_state* b_demod = &rtl_stream_demod();
+    assert(dsd_rtl_stream_bind(nullptr) == b);
+
+    assert(a_demod != def_demod && b_demod != def_demod && a_demod != b_demod);
+    assert(&rtl_stream_demod() == def_demod);
+}
+
+void
+test_published_state_stays_per_pipeline(dsd_rtl_stream* a, dsd_rtl_stream* b) {
+    int def_rate = 0;
+    int def_levels = 0;
+    assert(rtl_stream_get_symbol_profile_full(&def_rate, &def_levels, nullptr) == 0);
+
+    (void)dsd_rtl_stream_bind(a);
+    assert(rtl_stream_set_symbol_profile(2400, 2, -1) == 0);
+    rtl_stream_shared().snr_c4fm_db.store(17.5, std::memory_order_relaxed);
+    int rate = 0;
+    int levels = 0;
+    assert(rtl_stream_get_symbol_profile_full(&rate, &levels, nullptr) == 0);
+    assert(rate == 2400 && levels == 2);
+
+    (void)dsd_rtl_stream_bind(b);
+    assert(rtl_stream_get_symbol_profile_full(&rate, &levels, nullptr) == 0);
+    assert(rate == def_rate && levels == def_levels);
+    assert(rtl_stream_shared().snr_c4fm_db.load(std::memory_order_relaxed) == -100.0);
+
+    (void)dsd_rtl_stream_bind(nullptr);
+    assert(rtl_stream_get_symbol_profile_full(&rate, &levels, nullptr) == 0);
+    assert(rate == def_rate && levels == def_levels);
+    assert(rtl_stream_shared().snr_c4fm_db.load(std::memory_order_relaxed) == -100.0);
+}
+
+void
+test_threads_inherit_the_binding(dsd_rtl_stream* a) {
+    (void)dsd_rtl_stream_bind(a);
+    const demod_state* a_demod = &rtl_stream_demod();
+    ThreadProbe probe = {nullptr, -1};
+    dsd_thread_t thread;
+    assert(rtl_stream_thread_create(&thread, probe_thread, &probe) == 0);
+    assert(dsd_thread_join(thread) == 0);
+    assert(probe.demod == a_demod);
+    assert(probe.on_default == 0);
+
+    (void)dsd_rtl_stream_bind(nullptr);
+    probe = {nullptr, -1};
+    assert(rtl_stream_thread_create(&thread, probe_thread, &probe) == 0);
+    assert(dsd_thread_join(thread) == 0);
+    assert(probe.demod == &rtl_stream_demod());
+    assert(probe.on_default == 1);
+}
+
+void
+test_destroy_unbinds(void) {
+    dsd_rtl_stream* c = dsd_rtl_stream_create();
+    assert(c != nullptr);
+    (void)dsd_rtl_stream_bind(c);
+    dsd_rtl_stream_destroy(c);
+    assert(rtl_stream_on_default_pipeline() == 1);
+    dsd_rtl_stream_destroy(nullptr);
+}
+
+} // namespace
+
+int
+main(void) {
+    dsd_rtl_stream* a = dsd_rtl_stream_create();
+    dsd_rtl_stream* b = dsd_rtl_stream_create();
+    assert(a != nullptr && b != nullptr && a != b);
+
+    test_pipelines_are_distinct(a, b);
+    test_published_state_stays_per_pipeline(a, b);
+    test_threads_inherit_the_binding(a);
+    test_destroy_unbinds();
+
+    dsd_rtl_stream_destroy(a);
+    dsd_rtl_stream_destroy(b);
+    (void)DSD_FPRINTF(stdout, "IO_RTL_STREAM_INSTANCES: ok\n");
+    return 0;
+}
+
+// NOLINTEND(cert-dcl03-c,misc-static-assert)
@@ -35,9 +35,17 @@ struct StubState {
     long int last_tune_hz;
     uint64_t last_tune_request_id;
     size_t last_read_count;
+    /* Pipeline the calling thread was bound to when each backend call ran. */
+    dsd_rtl_stream* open_pipeline;
+    dsd_rtl_stream* tune_pipeline;
+    dsd_rtl_stream* read_pipeline;
+    dsd_rtl_stream* stop_pipeline;
+    dsd_rtl_stream* register_pipeline;
+    dsd_rtl_stream* unregister_pipeline;
 };
 
 static StubState g_stub;
+static thread_local dsd_rtl_stream* g_bound_pipeline = nullptr;
 
 static void
 reset_stubs(void) {
@@ -86,6 +94,7 @@ extern "C" int
 dsd_rtl_stream_open(dsd_opts* opts) {
     g_stub.open_calls++;
     g_stub.last_open_opts = opts;
+    g_stub.open_pipeline = g_bound_pipeline;
     return g_stub.open_rc;
 }
 
@@ -95,6 +104,7 @@ dsd_rtl_stream_read(float* out, size_t count, dsd_opts* opts, const dsd_state* s
     (void)state;
     g_stub.read_calls++;
     g_stub.last_open_opts = opts;
+    g_stub.read_pipeline = g_bound_pipeline;
     g_stub.last_read_count = count;
     if (g_stub.invalidate_first_read && g_stub.read_calls == 1) {
         g_stub.output_generation++;
@@ -111,6 +121,7 @@ extern "C" int
 dsd_rtl_stream_tune(dsd_opts* opts, long int frequency) {
     g_stub.tune_calls++;
     g_stub.last_open_opts = opts;
+    g_stub.tune_pipeline = g_bound_pipeline;
     g_stub.last_tune_hz = frequency;
     return g_stub.tune_rc;
 }
@@ -127,12 +138,14 @@ dsd_rtl_stream_tune_tagged(dsd_opts* opts, long int frequency, uint64_t request_
 extern "C" int
 dsd_rtl_stream_soft_stop(void) {
     g_stub.soft_stop_calls++;
+    g_stub.stop_pipeline = g_bound_pipeline;
     return 0;
 }
 
 extern "C" void
 dsd_rtl_stream_register_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* caller_opts) {
     g_stub.register_calls++;
+    g_stub.register_pipeline = g_bound_pipeline;
     g_stub.last_registered_active = active_opts;
     g_stub.last_registered_caller = caller_opts;
 }
@@ -140,10 +153,18 @@ dsd_rtl_stream_register_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* call
 extern "C" void
 dsd_rtl_stream_unregister_requested_ppm_opts(dsd_opts* active_opts, dsd_opts* caller_opts) {
     g_stub.unregister_calls++;
+    g_stub.unregister_pipeline = g_bound_pipeline;
     g_stub.last_unregistered_active = active_opts;
     g_stub.last_unregistered_caller = caller_opts;
 }
 
+extern "C" dsd_rtl_stream*
+dsd_rtl_stream_bind(dsd_rtl_stream* stream) {
+    dsd_rtl_stream* prev = g_bound_pipeline;
+    g_bound_pipeline = stream;
+    return prev;
+}
+
 static int
 test_constructor_snapshots_and_registers_opts(void) {
     reset_stubs();
@@ -256,6 +277,46 @@ test_tune_and_read_error_propagation(void) {
     return rc;
 }
 
+static int
+test_calls_run_on_the_orchestrator_pipeline(void) {
+    reset_stubs();
+    std::unique_ptr<dsd_opts> opts = make_opts();
+    /* Only its address matters to the stubbed backend. */
+    alignas(16) static unsigned char storage[16];
+    dsd_rtl_stream* pipeline = reinterpret_cast<dsd_rtl_stream*>(storage);
+    alignas(16) static unsigned char caller_storage[16];
+    dsd_rtl_stream* caller_binding = reinterpret_cast<dsd_rtl_stream*>(caller_storage);
+
+    int rc = 0;
+    (void)dsd_rtl_stream_bind(caller_binding);
+    {
+        RtlSdrOrchestrator stream(*opts, pipeline);
+        rc |= expect_ptr_eq("orchestrator reports its pipeline", stream.pipeline(), pipeline);
+        rc |= expect_ptr_eq("register runs on the pipeline", g_stub.register_pipeline, pipeline);
+        rc |= expect_int_eq("start succeeds", stream.start(), 0);
+        rc |= expect_ptr_eq("open runs on the pipeline", g_stub.open_pipeline, pipeline);
+        rc |= expect_int_eq("tune succeeds", stream.tune(851025000U), 0);
+        rc |= expect_ptr_eq("tune runs on the pipeline", g_stub.tune_pipeline, pipeline);
+        float samples[4] = {};
+        int got = 0;
+        rc |= expect_int_eq("read succeeds", stream.read(samples, 4U, got), 0);
+        rc |= expect_ptr_eq("read runs on the pipeline", g_stub.read_pipeline, pipeline);
+        rc |= expect_ptr_eq("caller binding restored between calls", g_bound_pipeline, caller_binding);
+    }
+    rc |= expect_ptr_eq("stop runs on the pipeline", g_stub.stop_pipeline, pipeline);
+    rc |= expect_ptr_eq("unregister runs on the pipeline", g_stub.unregister_pipeline, pipeline);
+    rc |= expect_ptr_eq("caller binding restored after destruction", g_bound_pipeline, caller_binding);
+
+    /* A default-pipeline orchestrator runs on the default even from a bound thread. */
+    {
+        RtlSdrOrchestrator stream(*opts);
+        rc |= expect_int_eq("default start succeeds", stream.start(), 0);
+        rc |= expect_ptr_eq("default open runs unbound", g_stub.open_pipeline, nullptr);
+    }
+    (void)dsd_rtl_stream_bind(nullptr);
+    return rc;
+}
+
 int
 main(void) {
     int rc = 0;
@@ -263,5 +324,6 @@ main(void) {
     rc |= test_start_stop_and_destructor_lifecycle();
     rc |= test_start_failure_and_prestart_errors();
     rc |= test_tune_and_read_error_propagation();
+    rc |= test_calls_run_on_the_orchestrator_pipeline();
     return rc ? 1 : 0;
 }
@@ -117,18 +117,9 @@ ComputeAndCorrectFullLinkControlCrc(uint8_t* bytes, uint32_t* computed, uint32_t
     return 1;
 }
 
-void
-// NOLINTNEXTLINE(misc-use-internal-linkage)
-BPTCDeInterleaveDMRData(const uint8_t* input, uint8_t* output) {
-    (void)input;
-    if (output != NULL) {
-        DSD_MEMSET(output, 0, 196U);
-    }
-}
-
 uint32_t
 // NOLINTNEXTLINE(misc-use-internal-linkage)
-BPTC_196x96_Extract_Data(uint8_t input[196], uint8_t output[96], uint8_t reserved[3]) {
+BPTC_196x96_Decode(const uint8_t input[196], uint8_t output[96], uint8_t reserved[3]) {
     (void)input;
     if (output != NULL) {
         DSD_MEMCPY(output, g_bptc_bits, 96U);
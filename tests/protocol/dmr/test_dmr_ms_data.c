@@ -117,6 +117,18 @@ getDibitSoft(dsd_opts* opts, dsd_state* state, dsd_dibit_soft_t* out_soft) {
     return dibit;
 }
 
+int
+// NOLINTNEXTLINE(misc-use-internal-linkage)
+getDibitSoftBlock(dsd_opts* opts, dsd_state* state, int* dibits, dsd_dibit_soft_t* soft, int count) {
+    for (int k = 0; k < count; k++) {
+        const int dibit = getDibitSoft(opts, state, soft != NULL ? &soft[k] : NULL);
+        if (dibits != NULL) {
+            dibits[k] = dibit;
+        }
+    }
+    return count;
+}
+
 void
 // NOLINTNEXTLINE(misc-use-internal-linkage)
 skipDibit(dsd_opts* opts, dsd_state* state, int count) {
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/*
+ * Copyright (C) 2026 by arancormonk <180709949+arancormonk@users.noreply.github.com>
+ */
+
+/*
+ * The table-driven/SIMD rate 3/4 decoders must pick exactly the survivors of
+ * the original nested-loop Viterbi, including on tie-heavy inputs where the
+ * lowest previous state has to win.
+ */
+
+#include <dsd-neo/fec/trellis34.h>
+#include <dsd-neo/protocol/dmr/r34_viterbi.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "dsd-neo/core/safe_api.h"
+
+enum { REF_T = 49, REF_S = 8 };
+
+static uint32_t g_rng = 0x0BADCAFEu;
+
+static uint32_t
+next_rand(void) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return g_rng >> 8;
+}
+
+static int
+ref_popcount4(unsigned int v) {
+    return (int)((v & 1U) + ((v >> 1) & 1U) + ((v >> 2) & 1U) + ((v >> 3) & 1U));
+}
+
+/* The pre-vectorization decoder: hard (reliab == NULL) or weighted. */
+static void
+ref_decode(const uint8_t dibits98[98], const uint8_t* reliab98, uint8_t out[18]) {
+    uint8_t dei[98];
+    uint8_t rdei[98];
+    for (int i = 0; i < 98; i++) {
+        dei[dsd_trellis_interleave_98[i]] = (uint8_t)(dibits98[i] & 3U);
+        rdei[dsd_trellis_interleave_98[i]] = reliab98 ? reliab98[i] : 1U;
+    }
+    int metric[REF_S];
+    uint8_t backptr[REF_T][REF_S];
+    for (int s = 0; s < REF_S; s++) {
+        metric[s] = 1000000000;
+    }
+    metric[0] = 0;
+    for (int t = 0; t < REF_T; t++) {
+        const uint8_t nib = (uint8_t)((dei[2 * t] << 2) | dei[(2 * t) + 1]);
+        const uint8_t point = dsd_trellis34_constellation[nib];
+        int next[REF_S];
+        for (int s = 0; s < REF_S; s++) {
+            next[s] = 1000000000;
+        }
+        for (int ps = 0; ps < REF_S; ps++) {
+            if (metric[ps] >= 1000000000) {
+                continue;
+            }
+            for (int ns = 0; ns < REF_S; ns++) {
+                const uint8_t expect = dsd_trellis34_fsm[(ps * 8) + ns];
+                int cost;
+                if (reliab98) {
+                    const unsigned int x = dsd_trellis34_inverse_constellation[expect] ^ nib;
+                    cost = (ref_popcount4(x >> 2) * rdei[2 * t]) + (ref_popcount4(x & 3U) * rdei[(2 * t) + 1]);
+                } else {
+                    cost = ref_popcount4((unsigned int)(expect ^ point) & 0x0FU);
+                }
+                if (metric[ps] + cost < next[ns]) {
+                    next[ns] = metric[ps] + cost;
+                    backptr[t][ns] = (uint8_t)ps;
+                }
+            }
+        }
+        DSD_MEMCPY(metric, next, sizeof(metric));
+    }
+    uint8_t states[REF_T];
+    int s = 0;
+    for (int t = REF_T - 1; t >= 0; t--) {
+        states[t] = (uint8_t)s;
+        s = backptr[t][s];
+    }
+    for (int g = 0; g < 6; g++) {
+        uint32_t temp = 0;
+        for (int k = 0; k < 8; k++) {
+            temp = (temp << 3) | states[(g * 8) + k];
+        }
+        out[(g * 3) + 0] = (uint8_t)(temp >> 16);
+        out[(g * 3) + 1] = (uint8_t)(temp >> 8);
+        out[(g * 3) + 2] = (uint8_t)temp;
+    }
+}
+
+static int
+expect_bytes(const char* label, int trial, const uint8_t got[18], const uint8_t want[18]) {
+    if (memcmp(got, want, 18) != 0) {
+        DSD_FPRINTF(stderr, "FAIL: %s trial %d differs from the reference decoder\n", label, trial);
+        return 0;
+    }
+    return 1;
+}
+
+int
+main(void) {
+    int ok = 1;
+    for (int trial = 0; trial < 2000 && ok; trial++) {
+        uint8_t dibits[98];
+        uint8_t reliab[98];
+        for (int i = 0; i < 98; i++) {
+            dibits[i] = (uint8_t)(next_rand() & 3U);
+            /* A third of the trials use two reliability levels to force metric ties. */
+            reliab[i] = (trial % 3 == 0) ? (uint8_t)((next_rand() & 1U) ? 255U : 0U) : (uint8_t)next_rand();
+        }
+        uint8_t want[18];
+        uint8_t got[18];
+
+        ref_decode(dibits, NULL, want);
+        ok &= (dmr_r34_viterbi_decode(dibits, got) == 0);
+        ok &= expect_bytes("hard", trial, got, want);
+
+        ref_decode(dibits, reliab, want);
+        ok &= (dmr_r34_viterbi_decode_soft(dibits, reliab, got) == 0);
+        ok &= expect_bytes("soft", trial, got, want);
+    }
+    return ok ? 0 : 1;
+}
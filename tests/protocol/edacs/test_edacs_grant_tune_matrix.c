@@ -89,6 +89,7 @@ static int g_close_wav_count = 0;
 static int g_open_wav_count = 0;
 #ifdef USE_RADIO
 static int g_rtl_read_count = 0;
+static int g_rtl_sample_count = 0;
 static int g_rtl_return_pwr_count = 0;
 static int g_rtl_fail_at = -1;
 #endif
@@ -279,11 +280,15 @@ edacs_fake_rtl_read(void* rtl_ctx, float* out, size_t count, int* out_got) {
     if (out_got != NULL) {
         *out_got = 0;
     }
-    if (out == NULL || out_got == NULL || count != 1U || (g_rtl_fail_at >= 0 && index == g_rtl_fail_at)) {
+    if (out == NULL || out_got == NULL || count == 0U || (g_rtl_fail_at >= 0 && index == g_rtl_fail_at)) {
         return -1;
     }
-    out[0] = 100.0f + (float)index;
-    *out_got = 1;
+    /* Short reads, like a ring that only has part of a block ready. */
+    size_t n = count < 64U ? count : 64U;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = 100.0f + (float)g_rtl_sample_count++;
+    }
+    *out_got = (int)n;
     return 0;
 }
 
@@ -317,6 +322,7 @@ edacs_reset_audio_hook_state(void) {
     dsd_udp_audio_hooks_set((dsd_udp_audio_hooks){0});
 #ifdef USE_RADIO
     g_rtl_read_count = 0;
+    g_rtl_sample_count = 0;
     g_rtl_return_pwr_count = 0;
     g_rtl_fail_at = -1;
     dsd_rtl_stream_io_hooks_set((dsd_rtl_stream_io_hooks){0});
@@ -1316,7 +1322,8 @@ edacs_run_analog_loop_helper_cases(void) {
     pwr = -1.0;
     rc |= edacs_expect(edacs_collect_analog_triplet(&opts, &state, analog1, analog2, analog3, &pwr) == 1,
                        "analog-helpers", "rtl-collect", "RTL triplet collection succeeded");
-    rc |= edacs_expect(g_rtl_read_count == 2880, "analog-helpers", "rtl-collect", "RTL read exactly three blocks");
+    rc |= edacs_expect(g_rtl_sample_count == 2880 && g_rtl_read_count == 45, "analog-helpers", "rtl-collect",
+                       "RTL read exactly three blocks in spans");
     rc |= edacs_expect(g_rtl_return_pwr_count == 1 && pwr == 77.25, "analog-helpers", "rtl-collect",
                        "RTL collection used squelch power hook");
     rc |= edacs_expect(analog1[0] == 200 && analog2[0] == 2120 && analog3[959] == 5958, "analog-helpers", "rtl-collect",
@@ -15,6 +15,7 @@
 #include <dsd-neo/core/state_ext.h>
 #include <dsd-neo/core/state_fwd.h>
 #include <dsd-neo/core/synctype_ids.h>
+#include <dsd-neo/fec/viterbi_k5.h>
 #include <dsd-neo/protocol/nxdn/nxdn_deperm.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -32,18 +33,14 @@ static int g_alias_reset_calls;
 /* Link stubs for the message-type reset checks in this combined NXDN test. */
 void
 // NOLINTNEXTLINE(misc-use-internal-linkage)
-CNXDNConvolution_start(void) {}
-
-void
-// NOLINTNEXTLINE(misc-use-internal-linkage)
-CNXDNConvolution_decode(uint8_t s0, uint8_t s1) {
-    (void)s0;
-    (void)s1;
+CNXDNConvolution_start_ctx(dsd_viterbi_k5* v) {
+    (void)v;
 }
 
 void
 // NOLINTNEXTLINE(misc-use-internal-linkage)
-CNXDNConvolution_decode_soft(uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1) {
+CNXDNConvolution_decode_soft_ctx(dsd_viterbi_k5* v, uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1) {
+    (void)v;
     (void)s0;
     (void)s1;
     (void)r0;
@@ -52,7 +49,8 @@ CNXDNConvolution_decode_soft(uint8_t s0, uint8_t s1, uint8_t r0, uint8_t r1) {
 
 void
 // NOLINTNEXTLINE(misc-use-internal-linkage)
-CNXDNConvolution_chainback(unsigned char* out, unsigned int nBits) {
+CNXDNConvolution_chainback_ctx(const dsd_viterbi_k5* v, unsigned char* out, unsigned int nBits) {
+    (void)v;
     (void)nBits;
     if (out != NULL) {
         DSD_MEMSET(out, 0, 32U);
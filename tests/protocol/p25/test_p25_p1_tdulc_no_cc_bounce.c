@@ -156,6 +156,16 @@ check_and_fix_reedsolomon_24_12_13_soft(char* data, char* parity, const int* era
     return 1;
 }
 
+int
+// NOLINTNEXTLINE(misc-use-internal-linkage)
+check_and_fix_reedsolomon_24_12_13_ranked(char* data, const char* parity, const int* erasures, int n_ranked) {
+    (void)data;
+    (void)parity;
+    (void)erasures;
+    (void)n_ranked;
+    return 1;
+}
+
 int
 getDibitSoft(dsd_opts* opts, dsd_state* state, dsd_dibit_soft_t* out_soft) {
     (void)opts;
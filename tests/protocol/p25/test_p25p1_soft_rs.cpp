@@ -502,6 +502,90 @@ test_ldu2_ranked_reliability_null_guards(void) {
     return 0;
 }
 
+typedef int (*rs_soft_fn)(char* data, const char* parity, const int* erasures, int n_erasures);
+
+/* The one-pass ranked decoders must agree with trying each erasure prefix through the _soft API. */
+static int
+expect_ranked_matches_prefixes(const char* name, rs_soft_fn soft, rs_soft_fn ranked, const char* clean_data,
+                               const char* clean_parity, int data_symbols, int parity_symbols) {
+    uint32_t rng = 0x2545F491u;
+    int failures = 0;
+    for (int trial = 0; trial < 400 && failures == 0; trial++) {
+        char data[20 * 6];
+        char parity[16 * 6];
+        int erasures[16];
+        int errors[24];
+        const int total = data_symbols + parity_symbols;
+        DSD_MEMCPY(data, clean_data, (size_t)data_symbols * 6U);
+        DSD_MEMCPY(parity, clean_parity, (size_t)parity_symbols * 6U);
+
+        rng = (rng * 1664525u) + 1013904223u;
+        const int n_errors = (int)((rng >> 8) % (uint32_t)(parity_symbols + 3));
+        for (int i = 0; i < n_errors; i++) {
+            rng = (rng * 1664525u) + 1013904223u;
+            errors[i] = (int)((rng >> 8) % (uint32_t)total);
+            const int mask = 1 + (int)((rng >> 20) % 63u);
+            if (errors[i] < parity_symbols) {
+                corrupt_symbol(parity, errors[i], mask);
+            } else {
+                corrupt_symbol(data, errors[i] - parity_symbols, mask);
+            }
+        }
+        /* Mostly true error positions, some random ones, occasionally a repeat. */
+        rng = (rng * 1664525u) + 1013904223u;
+        const int n_ranked = (int)((rng >> 8) % (uint32_t)(parity_symbols + 1));
+        for (int i = 0; i < n_ranked; i++) {
+            rng = (rng * 1664525u) + 1013904223u;
+            if (n_errors > 0 && ((rng >> 4) & 3u) != 0u) {
+                erasures[i] = errors[(rng >> 8) % (uint32_t)n_errors];
+            } else {
+                erasures[i] = (int)((rng >> 8) % (uint32_t)total);
+            }
+        }
+
+        char want[20 * 6];
+        int want_rc = 1;
+        DSD_MEMCPY(want, data, sizeof(want));
+        for (int n = 1; n <= n_ranked && want_rc != 0; n++) {
+            char candidate[20 * 6];
+            DSD_MEMCPY(candidate, data, sizeof(candidate));
+            if (soft(candidate, parity, erasures, n) == 0) {
+                DSD_MEMCPY(want, candidate, sizeof(candidate));
+                want_rc = 0;
+            }
+        }
+        char got[20 * 6];
+        DSD_MEMCPY(got, data, sizeof(got));
+        const int got_rc = ranked(got, parity, erasures, n_ranked);
+        if (got_rc != want_rc || std::memcmp(got, want, (size_t)data_symbols * 6U) != 0) {
+            DSD_FPRINTF(stderr, "%s ranked trial %d: rc %d, per-prefix rc %d\n", name, trial, got_rc, want_rc);
+            failures++;
+        }
+    }
+    return failures != 0;
+}
+
+static int
+test_ranked_matches_per_prefix_soft(void) {
+    char data[20 * 6];
+    char parity[16 * 6];
+    int rc = 0;
+
+    fill_data(data, 20, 3);
+    load_symbols(parity, k_rs36_seed3_parity, 16);
+    rc |= expect_ranked_matches_prefixes("hdu", check_and_fix_redsolomon_36_20_17_soft,
+                                         check_and_fix_redsolomon_36_20_17_ranked, data, parity, 20, 16);
+    fill_data(data, 12, 11);
+    load_symbols(parity, k_rs24_12_seed11_parity, 12);
+    rc |= expect_ranked_matches_prefixes("ldu1", check_and_fix_reedsolomon_24_12_13_soft,
+                                         check_and_fix_reedsolomon_24_12_13_ranked, data, parity, 12, 12);
+    fill_data(data, 16, 23);
+    load_symbols(parity, k_rs24_16_seed23_parity, 8);
+    rc |= expect_ranked_matches_prefixes("ldu2", check_and_fix_reedsolomon_24_16_9_soft,
+                                         check_and_fix_reedsolomon_24_16_9_ranked, data, parity, 16, 8);
+    return rc;
+}
+
 int
 main(void) {
     int rc = 0;
@@ -517,6 +601,7 @@ main(void) {
     rc |= test_ldu2_soft_rs_mixed_errors_and_erasures();
     rc |= test_ldu2_ranked_reliability_above_threshold();
     rc |= test_ldu2_ranked_reliability_null_guards();
+    rc |= test_ranked_matches_per_prefix_soft();
     if (rc == 0) {
         DSD_FPRINTF(stderr, "PASSED: P25P1 soft RS tests passed\n");
     }
@@ -78,6 +78,7 @@ unset_all_runtime_env(void) {
      * assertions depend on execution order.
      */
     const char* vars[] = {
+        "DSD_NEO_AUDIO_GRAPH",
         "DSD_NEO_AUDIO_LPF",
         "DSD_NEO_AUTO_PPM",
         "DSD_NEO_AUTO_PPM_FREEZE",
@@ -94,6 +95,7 @@ unset_all_runtime_env(void) {
         "DSD_NEO_COSTAS_DAMPING",
         "DSD_NEO_CPU_DEMOD",
         "DSD_NEO_CPU_DONGLE",
+        "DSD_NEO_CPU_DSP",
         "DSD_NEO_CPU_USB",
         "DSD_NEO_CQPSK",
         "DSD_NEO_CQPSK_SYNC_INV",
@@ -101,6 +103,7 @@ unset_all_runtime_env(void) {
         "DSD_NEO_DEBUG_CQPSK",
         "DSD_NEO_DEBUG_SYNC",
         "DSD_NEO_DEEMPH",
+        "DSD_NEO_DEMOD_PIPELINE",
         "DSD_NEO_DISABLE_FS4_SHIFT",
         "DSD_NEO_DMR_GRANT_TIMEOUT",
         "DSD_NEO_DMR_HANGTIME",
@@ -116,8 +119,10 @@ unset_all_runtime_env(void) {
         "DSD_NEO_IQ_DC_BLOCK",
         "DSD_NEO_IQ_DC_SHIFT",
         "DSD_NEO_MT",
+        "DSD_NEO_MT_WORKERS",
         "DSD_NEO_NO_BOOTSTRAP",
         "DSD_NEO_OUTPUT_CLEAR_ON_RETUNE",
+        "DSD_NEO_OUTPUT_WAKE_SAMPLES",
         "DSD_NEO_P25_AFC_STATUS_GATE",
         "DSD_NEO_P25_CC_GRACE",
         "DSD_NEO_P25_FORCE_RELEASE_EXTRA",
@@ -152,9 +157,11 @@ unset_all_runtime_env(void) {
         "DSD_NEO_RTL_XTAL_HZ",
         "DSD_NEO_RT_PRIO_DEMOD",
         "DSD_NEO_RT_PRIO_DONGLE",
+        "DSD_NEO_RT_PRIO_DSP",
         "DSD_NEO_RT_PRIO_USB",
         "DSD_NEO_RT_SCHED",
         "DSD_NEO_SNR_SQL_DB",
+        "DSD_NEO_SYNC_RACE",
         "DSD_NEO_SYNC_WARMSTART",
         "DSD_NEO_TCP_AUTOTUNE",
         "DSD_NEO_TCP_BUFSZ",
@@ -175,6 +182,8 @@ unset_all_runtime_env(void) {
         "DSD_NEO_TUNER_AUTOGAIN_UP_STEP_DB",
         "DSD_NEO_TUNER_BW_HZ",
         "DSD_NEO_TUNER_XTAL_HZ",
+        "DSD_NEO_VOCODER_THREAD",
+        "DSD_NEO_WAV_ASYNC",
         "DSD_NEO_WINDOW_FREEZE",
         NULL,
     };
@@ -713,6 +722,8 @@ test_rt_sched_affinity_env(void) {
     setenv("DSD_NEO_CPU_USB", "1", 1);
     setenv("DSD_NEO_CPU_DONGLE", "2", 1);
     setenv("DSD_NEO_CPU_DEMOD", "3", 1);
+    setenv("DSD_NEO_RT_PRIO_DSP", "70", 1);
+    setenv("DSD_NEO_CPU_DSP", "4-7", 1);
     dsd_neo_config_init();
 
     const dsdneoRuntimeConfig* cfg = dsd_neo_get_config();
@@ -776,6 +787,26 @@ test_rt_sched_affinity_env(void) {
     if (rc != 0) {
         return rc;
     }
+    rc = expect_int_eq(cfg->rt_prio_dsp_is_set, 1, 965, "rt_prio_dsp_is_set");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->rt_prio_dsp, 70, 966, "rt_prio_dsp");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->cpu_dsp_is_set, 1, 967, "cpu_dsp_is_set");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->cpu_dsp, 4, 968, "cpu_dsp");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->cpu_dsp_count, 4, 969, "cpu_dsp_count");
+    if (rc != 0) {
+        return rc;
+    }
 
     setenv("DSD_NEO_RT_SCHED", "0", 1);
     dsd_neo_config_init();
@@ -801,6 +832,22 @@ test_rt_sched_affinity_env(void) {
         return rc;
     }
 
+    setenv("DSD_NEO_CPU_DSP", "5", 1);
+    dsd_neo_config_init();
+    cfg = dsd_neo_get_config();
+    rc = expect_int_eq(cfg->cpu_dsp_count, 1, 973, "cpu_dsp_count (single)");
+    if (rc != 0) {
+        return rc;
+    }
+
+    setenv("DSD_NEO_CPU_DSP", "7-4", 1);
+    dsd_neo_config_init();
+    cfg = dsd_neo_get_config();
+    rc = expect_int_eq(cfg->cpu_dsp_is_set, 0, 974, "cpu_dsp_is_set (reversed range)");
+    if (rc != 0) {
+        return rc;
+    }
+
     unsetenv("DSD_NEO_RT_SCHED");
     unsetenv("DSD_NEO_RT_PRIO_USB");
     unsetenv("DSD_NEO_RT_PRIO_DONGLE");
@@ -808,6 +855,8 @@ test_rt_sched_affinity_env(void) {
     unsetenv("DSD_NEO_CPU_USB");
     unsetenv("DSD_NEO_CPU_DONGLE");
     unsetenv("DSD_NEO_CPU_DEMOD");
+    unsetenv("DSD_NEO_RT_PRIO_DSP");
+    unsetenv("DSD_NEO_CPU_DSP");
     return 0;
 }
 
@@ -975,6 +1024,10 @@ test_compat_runtime_switches(void) {
     rc |= expect_int_eq(cfg->sync_warmstart_enable, 1, 1052, "sync warm-start default enabled");
     rc |= expect_int_eq(cfg->combine_rot_is_set, 0, 1053, "combine rotation default source");
     rc |= expect_int_eq(cfg->combine_rot, 1, 1054, "combine rotation default enabled");
+    rc |= expect_int_eq(cfg->ingest_hb_is_set, 0, 1055, "ingest half-band default source");
+    rc |= expect_int_eq(cfg->ingest_hb, 0, 1056, "ingest half-band default disabled");
+    rc |= expect_int_eq(cfg->input_ring_compact_is_set, 0, 1057, "compact input ring default source");
+    rc |= expect_int_eq(cfg->input_ring_compact, 0, 1058, "compact input ring default disabled");
     if (rc != 0) {
         return rc;
     }
@@ -993,13 +1046,21 @@ test_compat_runtime_switches(void) {
 
     setenv("DSD_NEO_SYNC_WARMSTART", "1", 1);
     setenv("DSD_NEO_COMBINE_ROT", "1", 1);
+    setenv("DSD_NEO_INGEST_HB", "1", 1);
+    setenv("DSD_NEO_INPUT_RING_COMPACT", "1", 1);
     dsd_neo_config_init();
     cfg = dsd_neo_get_config();
     rc = expect_int_eq(cfg->sync_warmstart_enable, 1, 1070, "sync warm-start enabled");
     rc |= expect_int_eq(cfg->combine_rot, 1, 1071, "combine rotation enabled");
+    rc |= expect_int_eq(cfg->ingest_hb_is_set, 1, 1072, "ingest half-band source");
+    rc |= expect_int_eq(cfg->ingest_hb, 1, 1073, "ingest half-band enabled");
+    rc |= expect_int_eq(cfg->input_ring_compact_is_set, 1, 1074, "compact input ring source");
+    rc |= expect_int_eq(cfg->input_ring_compact, 1, 1075, "compact input ring enabled");
 
     unsetenv("DSD_NEO_SYNC_WARMSTART");
     unsetenv("DSD_NEO_COMBINE_ROT");
+    unsetenv("DSD_NEO_INGEST_HB");
+    unsetenv("DSD_NEO_INPUT_RING_COMPACT");
     return rc;
 }
 
@@ -1912,11 +1973,18 @@ test_dsp_misc_env(void) {
     setenv("DSD_NEO_DEEMPH", "75", 1);
     setenv("DSD_NEO_AUDIO_LPF", "5000", 1);
     setenv("DSD_NEO_MT", "1", 1);
+    setenv("DSD_NEO_MT_WORKERS", "6", 1);
+    setenv("DSD_NEO_DEMOD_PIPELINE", "1", 1);
+    setenv("DSD_NEO_VOCODER_THREAD", "1", 1);
+    setenv("DSD_NEO_AUDIO_GRAPH", "1", 1);
+    setenv("DSD_NEO_WAV_ASYNC", "1", 1);
     setenv("DSD_NEO_DISABLE_FS4_SHIFT", "1", 1);
     setenv("DSD_NEO_OUTPUT_CLEAR_ON_RETUNE", "1", 1);
     setenv("DSD_NEO_RETUNE_DRAIN_MS", "100", 1);
     setenv("DSD_NEO_RETUNE_MUTE_MS", "180", 1);
+    setenv("DSD_NEO_OUTPUT_WAKE_SAMPLES", "480", 1);
     setenv("DSD_NEO_WINDOW_FREEZE", "1", 1);
+    setenv("DSD_NEO_SYNC_RACE", "1", 1);
     setenv("DSD_NEO_PDU_JSON", "1", 1);
     setenv("DSD_NEO_SNR_SQL_DB", "15", 1);
     setenv("DSD_NEO_IQ_DC_BLOCK", "1", 1);
@@ -1997,6 +2065,30 @@ test_dsp_misc_env(void) {
     if (rc != 0) {
         return rc;
     }
+    rc = expect_int_eq(cfg->mt_workers_is_set, 1, 1572, "mt_workers_is_set");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->mt_workers, 6, 1573, "mt_workers");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->demod_pipeline_enable, 1, 1574, "demod_pipeline_enable");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->vocoder_thread_enable, 1, 1575, "vocoder_thread_enable");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->audio_graph_enable, 1, 1576, "audio_graph_enable");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->wav_async_enable, 1, 1577, "wav_async_enable");
+    if (rc != 0) {
+        return rc;
+    }
 
     rc = expect_int_eq(cfg->fs4_shift_disable_is_set, 1, 1580, "fs4_shift_disable_is_set");
     if (rc != 0) {
@@ -2030,6 +2122,14 @@ test_dsp_misc_env(void) {
     if (rc != 0) {
         return rc;
     }
+    rc = expect_int_eq(cfg->output_wake_samples_is_set, 1, 1588, "output_wake_samples_is_set");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->output_wake_samples, 480, 1589, "output_wake_samples");
+    if (rc != 0) {
+        return rc;
+    }
 
     rc = expect_int_eq(cfg->window_freeze_is_set, 1, 1590, "window_freeze_is_set");
     if (rc != 0) {
@@ -2039,6 +2139,14 @@ test_dsp_misc_env(void) {
     if (rc != 0) {
         return rc;
     }
+    rc = expect_int_eq(cfg->sync_race_is_set, 1, 1596, "sync_race_is_set");
+    if (rc != 0) {
+        return rc;
+    }
+    rc = expect_int_eq(cfg->sync_race_enable, 1, 1597, "sync_race_enable");
+    if (rc != 0) {
+        return rc;
+    }
     rc = expect_int_eq(cfg->pdu_json_is_set, 1, 1592, "pdu_json_is_set");
     if (rc != 0) {
         return rc;
@@ -2094,11 +2202,18 @@ test_dsp_misc_env(void) {
     unsetenv("DSD_NEO_DEEMPH");
     unsetenv("DSD_NEO_AUDIO_LPF");
     unsetenv("DSD_NEO_MT");
+    unsetenv("DSD_NEO_MT_WORKERS");
+    unsetenv("DSD_NEO_DEMOD_PIPELINE");
+    unsetenv("DSD_NEO_VOCODER_THREAD");
+    unsetenv("DSD_NEO_AUDIO_GRAPH");
+    unsetenv("DSD_NEO_WAV_ASYNC");
     unsetenv("DSD_NEO_DISABLE_FS4_SHIFT");
     unsetenv("DSD_NEO_OUTPUT_CLEAR_ON_RETUNE");
     unsetenv("DSD_NEO_RETUNE_DRAIN_MS");
     unsetenv("DSD_NEO_RETUNE_MUTE_MS");
+    unsetenv("DSD_NEO_OUTPUT_WAKE_SAMPLES");
     unsetenv("DSD_NEO_WINDOW_FREEZE");
+    unsetenv("DSD_NEO_SYNC_RACE");
     unsetenv("DSD_NEO_PDU_JSON");
     unsetenv("DSD_NEO_SNR_SQL_DB");
     unsetenv("DSD_NEO_IQ_DC_BLOCK");
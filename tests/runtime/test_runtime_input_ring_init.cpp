@@ -76,18 +76,14 @@ test_guard_and_wrap_contracts(void) {
 
     input_ring_commit(&ring, 0U);
     rc |= expect_size("commit zero keeps empty", input_ring_used(&ring), 0U);
-    ring.head.store(6U);
-    ring.tail.store(4U);
+    ring.reset(6U, 4U);
     rc |= expect_int("reserve wrap", input_ring_reserve(&ring, 4U, &p1, &n1, &p2, &n2), 4);
     rc |= expect_int("reserve wrap p1", p1 == ring.buffer + 6U, 1);
     rc |= expect_size("reserve wrap n1", n1, 2U);
     rc |= expect_int("reserve wrap p2", p2 == ring.buffer, 1);
     rc |= expect_size("reserve wrap n2", n2, 2U);
 
-    ring.tail.store(0U);
-    ring.head.store(0U);
-    ring.head.store(6U);
-    ring.tail.store(5U);
+    ring.reset(6U, 5U);
     p1 = NULL;
     p2 = NULL;
     n1 = 0U;
@@ -100,19 +96,16 @@ test_guard_and_wrap_contracts(void) {
     input_ring_commit(&ring, 2U);
     rc |= expect_size("commit exact end wraps head", ring.head.load(), 0U);
 
-    ring.tail.store(0U);
-    ring.head.store(0U);
+    ring.reset();
     ring.buffer[6] = 40.0f;
     ring.buffer[7] = 41.0f;
-    ring.head.store(0U);
-    ring.tail.store(6U);
+    ring.reset(0U, 6U);
     rc |= expect_int("read block exact end", input_ring_read_block(&ring, out, 2U), 2);
     rc |= expect_float("read block exact end out[0]", out[0], 40.0f);
     rc |= expect_float("read block exact end out[1]", out[1], 41.0f);
     rc |= expect_size("read block exact end wraps tail", ring.tail.load(), 0U);
 
-    ring.tail.store(0U);
-    ring.head.store(0U);
+    ring.reset();
     rc |= expect_int("read block zero", input_ring_read_block(&ring, out, 0U), 0);
     exitflag = 1U;
     rc |= expect_int("read block exit", input_ring_read_block(&ring, out, 1U), -1);
@@ -166,11 +159,88 @@ test_guard_and_wrap_contracts(void) {
     return rc;
 }
 
+/*
+ * Compact rings keep element-based accounting and widen on read, including
+ * across the wrap point; the float-only span APIs refuse them.
+ */
+static int
+test_compact_storage(void) {
+    int rc = 0;
+    struct input_ring_state ring;
+    DSD_MEMSET(&ring, 0, sizeof(ring));
+    rc |= expect_int("resize uninitialized", input_ring_resize(&ring, 8U, DSD_IQ_FORMAT_CS16), -1);
+    rc |= expect_int("compact init", input_ring_init(&ring, 8U), 0);
+    rc |= expect_int("resize bad format", input_ring_resize(&ring, 8U, DSD_IQ_FORMAT_UNKNOWN), -1);
+    rc |= expect_int("resize cs16", input_ring_resize(&ring, 8U, DSD_IQ_FORMAT_CS16), 0);
+    rc |= expect_int("cs16 is compact", input_ring_is_compact(&ring), 1);
+    rc |= expect_size("cs16 element bytes", input_ring_elem_bytes(&ring), 2U);
+    rc |= expect_size("cs16 free", input_ring_free(&ring), 7U);
+
+    float* fp1 = NULL;
+    float* fp2 = NULL;
+    size_t n1 = 0U;
+    size_t n2 = 0U;
+    rc |= expect_int("float reserve on compact ring", input_ring_reserve(&ring, 2U, &fp1, &n1, &fp2, &n2), 0);
+    rc |= expect_int("float read reserve on compact ring", input_ring_read_reserve(&ring, 2U, &fp1, &n1, &fp2, &n2),
+                     -1);
+
+    const int16_t first[6] = {0, 16384, -16384, -32768, 32767, 8192};
+    void* p1 = NULL;
+    void* p2 = NULL;
+    rc |= expect_int("cs16 reserve six", input_ring_reserve_raw(&ring, 6U, &p1, &n1, &p2, &n2), 6);
+    if (p1 && n1 == 6U) {
+        DSD_MEMCPY(p1, first, sizeof first);
+    }
+    input_ring_commit(&ring, 6U);
+    float out[8] = {0.0f};
+    rc |= expect_int("cs16 read four", input_ring_read_convert(&ring, out, 4U), 4);
+    rc |= expect_float("cs16 out[1]", out[1], 0.5f);
+    rc |= expect_float("cs16 out[3]", out[3], -1.0f);
+
+    const int16_t second[5] = {-8192, 1, 2, 3, 4};
+    rc |= expect_int("cs16 reserve wrapped", input_ring_reserve_raw(&ring, 5U, &p1, &n1, &p2, &n2), 5);
+    rc |= expect_size("cs16 wrapped n1", n1, 2U);
+    rc |= expect_size("cs16 wrapped n2", n2, 3U);
+    if (p1 && p2 && n1 == 2U && n2 == 3U) {
+        DSD_MEMCPY(p1, second, n1 * sizeof(int16_t));
+        DSD_MEMCPY(p2, second + n1, n2 * sizeof(int16_t));
+    }
+    uint64_t generation = input_ring_discard_generation(&ring);
+    rc |= expect_int("cs16 generation current", input_ring_discard_generation_matches(&ring, generation), 1);
+    input_ring_commit(&ring, 5U);
+    rc |= expect_size("cs16 used in elements", input_ring_used(&ring), 7U);
+    rc |= expect_int("cs16 read across wrap", input_ring_read_convert(&ring, out, 8U), 7);
+    rc |= expect_float("cs16 wrap out[0]", out[0], 32767.0f / 32768.0f);
+    rc |= expect_float("cs16 wrap out[2]", out[2], -0.25f);
+    rc |= expect_float("cs16 wrap out[6]", out[6], 4.0f / 32768.0f);
+
+    rc |= expect_int("resize cu8", input_ring_resize(&ring, 4U, DSD_IQ_FORMAT_CU8), 0);
+    rc |= expect_size("cu8 element bytes", input_ring_elem_bytes(&ring), 1U);
+    rc |= expect_size("cu8 resize empties ring", input_ring_used(&ring), 0U);
+    const uint8_t bytes[3] = {0U, 255U, 128U};
+    rc |= expect_int("cu8 reserve three", input_ring_reserve_raw(&ring, 8U, &p1, &n1, &p2, &n2), 3);
+    if (p1 && n1 == 3U) {
+        DSD_MEMCPY(p1, bytes, sizeof bytes);
+    }
+    input_ring_commit(&ring, 3U);
+    rc |= expect_int("cu8 read block widens", input_ring_read_block(&ring, out, 8U), 3);
+    rc |= expect_float("cu8 out[0]", out[0], -1.0f);
+    rc |= expect_float("cu8 out[1]", out[1], 1.0f);
+    rc |= expect_float("cu8 out[2]", out[2], 0.5f / 127.5f);
+
+    rc |= expect_int("resize back to float", input_ring_resize(&ring, 8U, DSD_IQ_FORMAT_CF32), 0);
+    rc |= expect_int("float is not compact", input_ring_is_compact(&ring), 0);
+    rc |= expect_int("float reserve after resize", input_ring_reserve(&ring, 2U, &fp1, &n1, &fp2, &n2), 2);
+    input_ring_destroy(&ring);
+    return rc;
+}
+
 int
 main(void) {
     int rc = 0;
 
     rc |= test_guard_and_wrap_contracts();
+    rc |= test_compact_storage();
 
     rc |= expect_int("init(NULL, 8)", input_ring_init(NULL, 8), -1);
 
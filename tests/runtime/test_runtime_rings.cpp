@@ -6,6 +6,7 @@
 #include <atomic>
 #include <cmath>
 #include <dsd-neo/platform/threading.h>
+#include <dsd-neo/platform/timing.h>
 #include <dsd-neo/runtime/ring.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -14,6 +15,150 @@
 
 extern "C" volatile uint8_t exitflag;
 
+struct BlockedRead {
+    struct output_state* ring;
+    float out[4];
+    int count;
+};
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    blocked_read_thread(void* arg) {
+    BlockedRead* read = static_cast<BlockedRead*>(arg);
+    read->count = ring_read_batch(read->ring, read->out, 4U);
+    DSD_THREAD_RETURN;
+}
+
+/* Start a reader on the empty ring and wait until it is asleep in ring_wake_wait(). */
+static int
+start_blocked_read(dsd_thread_t* thread, BlockedRead* read) {
+    if (dsd_thread_create(thread, blocked_read_thread, read) != 0) {
+        return -1;
+    }
+    while (read->ring->wake.waiters.load() == 0) {
+        dsd_sleep_ms(1);
+    }
+    return 0;
+}
+
+static void
+publish_one(struct output_state* ring, float value) {
+    (void)ring->write(&value, 1U);
+    ring_notify_ready(ring);
+}
+
+/*
+ * A write must wake a reader sleeping on the empty ring right away, and a
+ * write below the wake watermark must leave it asleep until its idle timeout.
+ */
+static int
+test_event_driven_wakeups(struct output_state* ring) {
+    ring_clear(ring);
+    ring->read_timeouts.store(0U);
+    BlockedRead read = {ring, {0}, 0};
+    dsd_thread_t thread;
+    if (start_blocked_read(&thread, &read) != 0) {
+        return -1;
+    }
+    publish_one(ring, 7.0f);
+    (void)dsd_thread_join(thread);
+    if (read.count != 1 || read.out[0] != 7.0f || ring->read_timeouts.load() != 0U) {
+        DSD_FPRINTF(stderr, "output ring wake: count=%d timeouts=%llu\n", read.count,
+                    (unsigned long long)ring->read_timeouts.load());
+        return -1;
+    }
+
+    ring_wake_set_watermark(&ring->wake, 4U);
+    read = {ring, {0}, 0};
+    if (start_blocked_read(&thread, &read) != 0) {
+        return -1;
+    }
+    publish_one(ring, 8.0f);
+    (void)dsd_thread_join(thread);
+    ring_wake_set_watermark(&ring->wake, 1U);
+    if (read.count != 1 || read.out[0] != 8.0f || ring->read_timeouts.load() != 1U) {
+        DSD_FPRINTF(stderr, "output ring watermark: count=%d timeouts=%llu\n", read.count,
+                    (unsigned long long)ring->read_timeouts.load());
+        return -1;
+    }
+    return 0;
+}
+
+struct SpscProducer {
+    struct output_state* ring;
+    uint32_t count;
+};
+
+static DSD_THREAD_RETURN_TYPE
+#if DSD_PLATFORM_WIN_NATIVE
+    __stdcall
+#endif
+    spsc_producer_thread(void* arg) {
+    SpscProducer* p = static_cast<SpscProducer*>(arg);
+    float chunk[37];
+    uint32_t next = 0U;
+    while (next < p->count) {
+        size_t n = 0U;
+        while (n < 37U && next + n < p->count) {
+            chunk[n] = (float)(next + n);
+            n++;
+        }
+        size_t done = 0U;
+        while (done < n) {
+            done += p->ring->write(chunk + done, n - done);
+        }
+        next += (uint32_t)n;
+    }
+    DSD_THREAD_RETURN;
+}
+
+/*
+ * The index core keeps producer and consumer state on separate cache lines,
+ * moves every element across threads in order through the cached indices,
+ * and re-reads both indices after a reset from outside either side.
+ */
+static int
+test_spsc_core(struct output_state* ring) {
+    const char* head_addr = reinterpret_cast<const char*>(&ring->head);
+    const char* tail_addr = reinterpret_cast<const char*>(&ring->tail);
+    if (tail_addr - head_addr < DSD_SPSC_CACHE_LINE) {
+        DSD_FPRINTF(stderr, "spsc head/tail share a cache line\n");
+        return -1;
+    }
+
+    ring_clear(ring);
+    SpscProducer producer = {ring, 20000U};
+    dsd_thread_t thread;
+    if (dsd_thread_create(&thread, spsc_producer_thread, &producer) != 0) {
+        return -1;
+    }
+    uint32_t expect = 0U;
+    float chunk[5];
+    while (expect < producer.count) {
+        size_t got = ring->read(chunk, 5U);
+        for (size_t i = 0; i < got; i++) {
+            if (chunk[i] != (float)expect) {
+                DSD_FPRINTF(stderr, "spsc order: got %f want %u\n", (double)chunk[i], expect);
+                (void)dsd_thread_join(thread);
+                return -1;
+            }
+            expect++;
+        }
+    }
+    (void)dsd_thread_join(thread);
+
+    /* Both caches are warm; a reset must not leave either side on stale indices. */
+    ring->reset(3U, 1U);
+    if (ring->read_space(0U) != 2U || ring->write_space(0U) != ring->capacity - 3U) {
+        DSD_FPRINTF(stderr, "spsc reset: read=%zu write=%zu\n", ring->read_space(0U), ring->write_space(0U));
+        return -1;
+    }
+    ring_clear(ring);
+    return 0;
+}
+
 static int
 init_output_ring(struct output_state* ring, size_t capacity) {
     DSD_MEMSET(ring, 0, sizeof *ring);
@@ -48,8 +193,7 @@ main(void) {
         return 1;
     }
 
-    ring.tail.store(6U);
-    ring.head.store(4U);
+    ring.reset(4U, 6U);
     ring.buffer[6] = 10.0f;
     ring.buffer[7] = 20.0f;
     ring.buffer[0] = 30.0f;
@@ -71,6 +215,11 @@ main(void) {
         return 1;
     }
 
+    if (test_spsc_core(&ring) != 0 || test_event_driven_wakeups(&ring) != 0) {
+        destroy_output_ring(&ring);
+        return 1;
+    }
+
     exitflag = 1U;
     count = ring_read_batch(&ring, out, 1U);
     exitflag = 0U;
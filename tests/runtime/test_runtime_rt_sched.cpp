@@ -20,6 +20,8 @@
 const char* dsd_neo_rt_sched_test_role_or_default(const char* role);
 int dsd_neo_rt_sched_test_resolve_role_rt_priority(const dsdneoRuntimeConfig* cfg, const char* role);
 int dsd_neo_rt_sched_test_resolve_role_cpu_affinity(const dsdneoRuntimeConfig* cfg, const char* role);
+int dsd_neo_rt_sched_test_resolve_role_cpu_affinity_indexed(const dsdneoRuntimeConfig* cfg, const char* role,
+                                                            int index);
 
 static dsdneoRuntimeConfig g_config;
 static const dsdneoRuntimeConfig* g_config_ptr = &g_config;
@@ -102,6 +104,11 @@ enable_config(void) {
     g_config.cpu_dongle = 2;
     g_config.cpu_demod_is_set = 1;
     g_config.cpu_demod = 3;
+    g_config.rt_prio_dsp_is_set = 1;
+    g_config.rt_prio_dsp = 70;
+    g_config.cpu_dsp_is_set = 1;
+    g_config.cpu_dsp = 4;
+    g_config.cpu_dsp_count = 3;
 }
 
 static void
@@ -124,6 +131,13 @@ test_role_resolvers(void) {
     assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity(&g_config, "DONGLE") == 2);
     assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity(&g_config, "DEMOD") == 3);
     assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity(&g_config, "OTHER") == -1);
+
+    /* DSP pool workers wrap around the configured CPU range. */
+    assert(dsd_neo_rt_sched_test_resolve_role_rt_priority(&g_config, "DSP") == 70);
+    assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity(&g_config, "DSP") == 4);
+    assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity_indexed(&g_config, "DSP", 2) == 6);
+    assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity_indexed(&g_config, "DSP", 3) == 4);
+    assert(dsd_neo_rt_sched_test_resolve_role_cpu_affinity_indexed(&g_config, "DEMOD", 5) == 3);
 }
 
 static void
@@ -178,6 +192,14 @@ test_public_call_success_and_failure_paths(void) {
     assert(g_rt_calls == 1);
     assert(g_last_priority == 0);
     assert(g_affinity_calls == 0);
+
+    reset_state();
+    enable_config();
+    maybe_set_worker_realtime_and_affinity("DSP", 4);
+    assert(g_rt_calls == 1);
+    assert(g_last_priority == 70);
+    assert(g_affinity_calls == 1);
+    assert(g_last_cpu == 5);
 }
 
 int
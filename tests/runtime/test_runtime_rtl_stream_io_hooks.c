@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <dsd-neo/core/state.h>
 #include <dsd-neo/runtime/rtl_stream_io_hooks.h>
+#include <dsd-neo/runtime/rtl_stream_metrics_hooks.h>
 #include <stdlib.h>
 
 #include "dsd-neo/core/state_ext.h"
@@ -86,6 +87,41 @@ main(void) {
     assert(g_return_pwr_calls == 1);
     assert(g_last_rtl_ctx == (const void*)state->rtl_ctx);
 
+    /* Block reads drain what getSymbol() already cached before touching the stream. */
+    float span[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    state->rtl_symbol_cache[0] = 1.0f;
+    state->rtl_symbol_cache[1] = 2.0f;
+    state->rtl_symbol_cache[2] = 3.0f;
+    state->rtl_symbol_cache_pos = 1;
+    state->rtl_symbol_cache_len = 3;
+    state->rtl_symbol_cache_generation = dsd_rtl_stream_metrics_hook_stream_generation();
+    state->rtl_symbol_cache_published_pending = 2;
+    dsd_rtl_stream_metrics_hook_symbol_cache_pending_reset();
+    dsd_rtl_stream_metrics_hook_symbol_cache_pending_delta(2);
+    got = 0;
+    assert(dsd_rtl_stream_io_hook_read_block(state, span, 4, &got) == 0);
+    assert(got == 2);
+    assert(span[0] == 2.0f && span[1] == 3.0f);
+    assert(g_read_calls == 1);
+    assert(state->rtl_symbol_cache_pos == state->rtl_symbol_cache_len);
+    assert(dsd_rtl_stream_metrics_hook_symbol_cache_pending() == 0);
+
+    got = 0;
+    assert(dsd_rtl_stream_io_hook_read_block(state, span, 4, &got) == 0);
+    assert(got == 1 && span[0] == 42.0f);
+    assert(g_read_calls == 2);
+
+    /* A cache filled under an older stream generation is dropped, not served. */
+    state->rtl_symbol_cache_pos = 0;
+    state->rtl_symbol_cache_len = 3;
+    state->rtl_symbol_cache_generation = dsd_rtl_stream_metrics_hook_stream_generation() + 1U;
+    got = 0;
+    assert(dsd_rtl_stream_io_hook_read_block(state, span, 4, &got) == 0);
+    assert(got == 1 && span[0] == 42.0f);
+    assert(g_read_calls == 3);
+    assert(state->rtl_symbol_cache_len == 0);
+    assert(dsd_rtl_stream_io_hook_read_block(state, NULL, 4, &got) == -1);
+
     dsd_state_ext_free_all(state);
     free(state);
     return 0;
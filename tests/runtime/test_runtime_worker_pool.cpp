@@ -12,6 +12,7 @@
 #include <cassert>
 #include <dsd-neo/runtime/config.h>
 #include <dsd-neo/runtime/worker_pool.h>
+#include <dsd-neo/platform/timing.h>
 #include <pthread.h>
 #include <stdlib.h>
 
@@ -102,10 +103,83 @@ test_enabled_mode_runs_and_tears_down(void) {
     assert(pthread_equal(task1_thread, caller) != 0);
 }
 
+struct NestedArg {
+    std::atomic<int>* counter;
+};
+
+static void
+add_one(void* arg) {
+    static_cast<std::atomic<int>*>(arg)->fetch_add(1, std::memory_order_relaxed);
+}
+
+/* Fork-join from inside a pool task must not deadlock even when every worker does it. */
+static void
+nested_fan_out(void* arg) {
+    NestedArg* nested = static_cast<NestedArg*>(arg);
+    demod_mt_task inner[4];
+    for (int i = 0; i < 4; i++) {
+        inner[i] = demod_mt_task{add_one, nested->counter};
+    }
+    dsp_pool_run(inner, 4);
+}
+
+static void
+test_shared_pool_owners_and_nesting(void) {
+    int owner_a = 0;
+    int owner_b = 0;
+    std::atomic<int> counter{0};
+
+    setenv("DSD_NEO_MT_WORKERS", "3", 1);
+    set_mt_config("1");
+    assert(dsp_pool_size() == 0);
+    assert(dsp_pool_acquire(&owner_a) == 3);
+    assert(dsp_pool_acquire(&owner_b) == 3);
+    assert(dsp_pool_acquire(&owner_b) == 3);
+    assert(dsp_pool_size() == 3);
+
+    /* More tasks than workers, with NULL entries skipped. */
+    demod_mt_task tasks[17];
+    for (int i = 0; i < 16; i++) {
+        tasks[i] = demod_mt_task{add_one, &counter};
+    }
+    tasks[16] = demod_mt_task{nullptr, nullptr};
+    dsp_pool_run(tasks, 17);
+    assert(counter.load() == 16);
+
+    NestedArg nested{&counter};
+    demod_mt_task outer[6];
+    for (int i = 0; i < 6; i++) {
+        outer[i] = demod_mt_task{nested_fan_out, &nested};
+    }
+    dsp_pool_run(outer, 6);
+    assert(counter.load() == 16 + 24);
+
+    /* Detached posts complete without a join. */
+    for (int i = 0; i < 8; i++) {
+        dsp_pool_post(demod_mt_task{add_one, &counter});
+    }
+    for (int spins = 0; spins < 5000 && counter.load() != 48; spins++) {
+        dsd_sleep_ms(1);
+    }
+    assert(counter.load() == 48);
+
+    /* The pool outlives any one owner. */
+    dsp_pool_release(&owner_a);
+    dsp_pool_release(&owner_a);
+    assert(dsp_pool_size() == 3);
+    dsp_pool_release(&owner_b);
+    assert(dsp_pool_size() == 0);
+
+    dsp_pool_post(demod_mt_task{add_one, &counter});
+    assert(counter.load() == 49);
+    unsetenv("DSD_NEO_MT_WORKERS");
+}
+
 int
 main(void) {
     test_disabled_mode_runs_synchronously();
     test_enabled_mode_runs_and_tears_down();
+    test_shared_pool_owners_and_nesting();
     unsetenv("DSD_NEO_MT");
     dsd_neo_config_init();
     return 0;